@@ -39,6 +39,16 @@ extern "C" {
 #define EB_INVALID_PICTURE   0xFF
 
 #define EB_SEGMENT_BLOCK_SIZE 64
+
+/* Layout of the input planes when zeroCopyInput is set, in samples. Every
+ * plane is surrounded by EB_ZERO_COPY_PADDING samples (halved along each
+ * subsampled chroma direction) that the encoder writes, and the first padded
+ * sample is EB_ZERO_COPY_ALIGNMENT byte aligned. */
+#define EB_ZERO_COPY_PADDING        68
+#define EB_ZERO_COPY_ALIGNMENT      32
+#define EB_ZERO_COPY_LUMA_STRIDE(sourceWidth) \
+    ((((sourceWidth) + 7) & ~7) + 2 * EB_ZERO_COPY_PADDING)
+
     typedef struct
     {
         uint8_t ovFlags;
@@ -109,6 +119,27 @@ extern "C" {
         void*    pApplicationPrivate;
     } EB_COMPONENTTYPE;
 
+    /* Complexity of one picture as measured by the first rate control pass.
+     * The distortions cover the LCUs that lie fully inside the picture. */
+    typedef struct EB_H265_RC_STATS
+    {
+        uint64_t pictureNumber;
+
+        // Sum of the 16x16 motion estimation SADs (inter SAD), 0 for I pictures
+        uint64_t meDistortion;
+        // Sum of the best open loop intra search costs (intra SAD)
+        uint64_t oisDistortion;
+
+        uint32_t fullLcuCount;
+        uint8_t  sliceType;
+        uint8_t  temporalLayerIndex;
+        uint8_t  sceneChangeFlag;
+        uint8_t  reserved;
+
+        // Bits the rate control tables predict for the picture at each picture QP
+        uint32_t predictedBits[52];
+    } EB_H265_RC_STATS;
+
     typedef enum EB_ERRORTYPE
     {
         EB_ErrorNone =                      0,
@@ -128,6 +159,92 @@ extern "C" {
 
 #define EB_BUFFERFLAG_EOS 0x00000001
 
+/* Pipeline stages of the encoder, in the order a picture goes through them. */
+typedef enum EB_ENC_STAGE
+{
+    EB_ENC_STAGE_RESOURCE_COORDINATION = 0,
+    EB_ENC_STAGE_PICTURE_ANALYSIS,
+    EB_ENC_STAGE_PICTURE_DECISION,
+    EB_ENC_STAGE_MOTION_ESTIMATION,
+    EB_ENC_STAGE_INITIAL_RATE_CONTROL,
+    EB_ENC_STAGE_SOURCE_BASED_OPERATIONS,
+    EB_ENC_STAGE_PICTURE_MANAGER,
+    EB_ENC_STAGE_RATE_CONTROL,
+    EB_ENC_STAGE_MODE_DECISION_CONFIGURATION,
+    EB_ENC_STAGE_ENC_DEC,
+    EB_ENC_STAGE_ENTROPY_CODING,
+    EB_ENC_STAGE_PACKETIZATION,
+    EB_ENC_STAGE_COUNT
+} EB_ENC_STAGE;
+
+#define EB_ENC_LATENCY_BIN_COUNT 16
+#define EB_ENC_NUMA_NODE_COUNT   8
+
+typedef struct EB_H265_ENC_STAGE_STATS
+{
+    uint32_t threadCount;
+
+    // Tasks waiting in the input queue of the stage
+    uint32_t queueDepth;
+
+    // Tasks taken by the threads of the stage, and the microseconds they
+    // spent on them, summed over the threads. A task is counted once the
+    // thread is done with it. stallTimeUs is the part of the task spent
+    // waiting for a free buffer of a later stage, it is not in busyTimeUs.
+    uint64_t taskCount;
+    uint64_t busyTimeUs;
+    uint64_t stallTimeUs;
+} EB_H265_ENC_STAGE_STATS;
+
+typedef struct EB_H265_ENC_NUMA_STATS
+{
+    uint32_t nodeId;
+
+    // Bytes of the input and reference pictures placed on the node
+    uint64_t placedBytes;
+
+    // Motion estimation and EncDec segments whose rows are on the node, and
+    // those of them that ran on a processor of another node because the
+    // thread could not be moved
+    uint64_t segmentCount;
+    uint64_t remoteSegmentCount;
+
+    // Times a thread moved onto the processors of the node. A thread moves
+    // only when its next segment has its rows on another node.
+    uint64_t migrationCount;
+} EB_H265_ENC_NUMA_STATS;
+
+/* Snapshot of the encoder pipeline, see EbH265GetStats. The counters are
+ * kept by the encoder threads without synchronization, so the fields may
+ * be a few tasks apart from each other. */
+typedef struct EB_H265_ENC_STATS
+{
+    // Microseconds since EbInitEncoder returned, busyTimeUs / (elapsedTimeUs *
+    // threadCount) is the load of a stage
+    uint64_t elapsedTimeUs;
+
+    EB_H265_ENC_STAGE_STATS stage[EB_ENC_STAGE_COUNT];
+
+    // Packets waiting for EbH265GetPacket
+    uint32_t outputQueueDepth;
+
+    // Pictures handed over by resource coordination and put out by packetization
+    uint64_t picturesIn;
+    uint64_t picturesOut;
+    uint64_t picturesInFlight;
+
+    // Latency from resource coordination to packetization. Bin 0 counts the
+    // pictures under 1 ms, bin i > 0 those in [2^(i-1), 2^i) ms, the last bin
+    // also those above.
+    uint64_t latencyHistogram[EB_ENC_LATENCY_BIN_COUNT];
+    uint64_t latencySumMs;
+    uint64_t latencyMaxMs;
+
+    // Nodes the pictures are split over with NumaPartition, 0 when off
+    uint32_t numaNodeCount;
+    EB_H265_ENC_NUMA_STATS numaNode[EB_ENC_NUMA_NODE_COUNT];
+} EB_H265_ENC_STATS;
+
 typedef struct EB_SEI_MESSAGE
 {
     uint32_t  payloadSize;
@@ -360,6 +477,14 @@ typedef struct EB_H265_ENC_CONFIGURATION
     uint8_t                 tileRowCount;
     uint8_t                 tileSliceMode;
 
+    /* Enable wavefront parallel processing (entropy_coding_sync_enabled_flag).
+     * Each LCU row is coded as a separate substream that inherits its CABAC
+     * contexts from the second LCU of the row above, so several rows can be
+     * entropy coded at the same time. Only available with a single tile.
+     *
+     * Default is 0. */
+    uint8_t                 enableWppFlag;
+
     // Deblock Filter
 
     /* Flag to disable the Deblocking Loop Filtering.
@@ -417,6 +542,9 @@ typedef struct EB_H265_ENC_CONFIGURATION
      *
      * 0 = Constant QP.
      * 1 = Variable BitRate.
+     * 2 = Constant Rate Factor, constant quality around crf. Pictures and LCUs
+     *     referenced more than average over the lookahead get a lower QP,
+     *     the others a higher one.
      *
      * Default is 0. */
     uint32_t                rateControlMode;
@@ -439,6 +567,12 @@ typedef struct EB_H265_ENC_CONFIGURATION
      * Default is 7000000. */
     uint32_t                targetBitRate;
 
+    /* Constant rate factor [0 - 51], the base QP when rate control mode is set
+     * to 2. Lower values give a higher quality.
+     *
+     * Default is 28. */
+    uint32_t                crf;
+
     /* Maxium QP value allowed for rate control use, only apllicable when rate
      * control mode is set to 1. It has to be greater or equal to minQpAllowed.
      *
@@ -542,6 +676,7 @@ typedef struct EB_H265_ENC_CONFIGURATION
 
     // VBV Parameters
     /* Sets the maximum rate the VBV buffer should be assumed to refill at
+     * Used by VBR, and by CRF as a cap that only raises the picture QP.
      * 
      * Default is 0. */
     uint32_t                vbvMaxrate;
@@ -592,15 +727,76 @@ typedef struct EB_H265_ENC_CONFIGURATION
      * Default is -1. */
     int32_t                 targetSocket;
 
+    /* Split the LCU rows of every picture in one band per socket when the
+     * threads run on both sockets. The rows of the input and reference
+     * pictures of a band are placed on the memory node of its socket, and the
+     * motion estimation and EncDec segments of a band run on its socket. Only
+     * applicable to Linux, ignored when TargetSocket or LogicalProcessors are
+     * set.
+     *
+     * Default is 0. */
+    uint8_t                 numaPartition;
+
+    /* Back the reference, PA reference and input picture buffers with 2MB
+     * pages to cut the DTLB misses of motion estimation and compensation.
+     * Only applicable to Linux.
+     *
+     * 0 = OFF.
+     * 1 = Transparent huge pages (madvise).
+     * 2 = Explicit huge pages (MAP_HUGETLB, from /proc/sys/vm/nr_hugepages),
+     *     transparent ones once the reserved pages run out.
+     *
+     * Default is 0. */
+    uint8_t                 hugePages;
+
+    /* Upper bound, in MB, of the input, parent picture control set, reference and
+     * PA reference picture pools. When the pools sized from the prediction
+     * structure and lookahead do not fit, the latency is lowered first, then the
+     * lookahead distance, then the pools are cut down to the pictures the
+     * prediction structure needs.
+     *
+     * 0 = no budget.
+     *
+     * Default is 0. */
+    uint32_t                memoryBudgetMB;
+
+    /* Hand the objects between the encoder stages through lock-free ring
+     * buffers rather than through mutex protected queues.
+     *
+     * 0 = mutex protected queues.
+     * 1 = lock-free ring buffers.
+     *
+     * Default is the LOCK_FREE_FIFO build option, ON. */
+    uint8_t                 lockFreeFifo;
+
     /* Flag to enable threads to real time priority. Running with sudo privilege
      * utilizes full resource. Only applicable to Linux.
      *
      * Default is 1. */
     uint8_t                 switchThreadsToRtPriority;
 
-    /* The total number of working threads to create. */
+    /* The total number of working threads to create.
+     *
+     * 0 = AUTO, EB_THREAD_COUNT_FACTOR threads per core available to the
+     * encoder, at least EB_THREAD_COUNT_MIN_CORE. The cores available take
+     * the affinity mask and the cgroup CPU quota of the process into account,
+     * and at most that many threads of the parallel stages run at a time.
+     *
+     * Default is 0. */
     uint32_t                threadCount;
 
+    /* How the run time balancing of the parallel stages (picture analysis,
+     * motion estimation, source based operations, mode decision
+     * configuration, EncDec and entropy coding) shares the cores when the
+     * stages ask for more threads than there are cores.
+     *
+     * 0 = every stage is scaled down in proportion to its demand.
+     * 1 = the later stages, which work on the older pictures in flight, get
+     * their demand first; every stage keeps at least one thread.
+     *
+     * Default is 0. */
+    uint8_t                 stagePriority;
+
     // ASM Type
     
     /* Assembly instruction set used by encoder.
@@ -635,6 +831,16 @@ typedef struct EB_H265_ENC_CONFIGURATION
     * Default is 1. */
     uint8_t                 unrestrictedMotionVector;
 
+    /* Allow a picture to start Mode Decision / Encode-Decode as soon as the
+     * LCU rows of its references covering its motion vector range are
+     * reconstructed, filtered and padded, instead of waiting for the whole
+     * reference picture. Motion vectors are restricted to a fixed number of
+     * LCU rows below the current one. Requires unrestrictedMotionVector = 0
+     * and the low delay P prediction structure.
+     *
+     * Default is 0. */
+    uint8_t                 subPictureReference;
+
     // Debug tools
 
     /* Output reconstructed yuv used for debug purposes. The value is set through 
@@ -662,8 +868,88 @@ typedef struct EB_H265_ENC_CONFIGURATION
     * Default is 0. */
     uint32_t                segmentOvEnabled;
 
+    // Zero-copy input
+
+    /* Reference the planes passed to EbH265EncSendPicture instead of copying
+     * them. Only 8-bit input is supported. The planes must follow the
+     * EB_ZERO_COPY_* layout. luma, cb and cr point at the first visible sample,
+     * yStride is EB_ZERO_COPY_LUMA_STRIDE(sourceWidth), and cbStride and
+     * crStride are that stride divided by the horizontal chroma subsampling.
+     * The encoder fills the padding and may filter the planes in place. The
+     * buffer header and its planes belong to the encoder until they are
+     * handed to inputReleaseCallback.
+     *
+     * Default is 0. */
+    uint8_t                 zeroCopyInput;
+
+    /* Called from an encoder thread with the EB_BUFFERHEADERTYPE passed to
+     * EbH265EncSendPicture once the encoder no longer references its planes.
+     * Required when zeroCopyInput is set. */
+    void                  (*inputReleaseCallback)(EB_BUFFERHEADERTYPE *pBuffer);
+
+    // Output buffer allocator
+
+    /* Allocates the bitstream buffers of the output pool. The encoder writes
+     * every picture straight into them, so the pBuffer of a packet returned by
+     * EbH265GetPacket is memory from this allocator until the packet goes back
+     * through EbH265ReleaseOutBuffer. Called from EbInitEncoder with the size of
+     * one buffer; outputStreamFree is called for each buffer at
+     * EbDeinitEncoder. Set both or neither.
+     *
+     * Default is NULL, the encoder allocates the buffers. */
+    uint8_t*              (*outputStreamAlloc)(uint32_t size);
+    void                  (*outputStreamFree)(uint8_t *pBuffer);
+
+    // Two-pass rate control
+
+    /* Rate control pass, only applicable when rateControlMode is set to 1.
+     *
+     * 0 = Single pass.
+     * 1 = First pass, runs the analysis at the fastest encMode and hands the
+     *     statistics of every picture to rcStatsCallback. The pictures are not
+     *     encoded, every output packet is empty.
+     * 2 = Second pass, spreads targetBitRate over the title following the
+     *     first pass statistics in rcStatsIn.
+     *
+     * Default is 0. */
+    uint32_t                rcPass;
+
+    /* Called in the first pass from an encoder thread with the statistics of
+     * each picture, in display order. pAppData is the pointer passed to
+     * EbInitHandle. Required when rcPass is 1. */
+    void                  (*rcStatsCallback)(void *pAppData, const EB_H265_RC_STATS *stats);
+
+    /* First pass statistics of the whole title in display order, required when
+     * rcPass is 2. EbInitEncoder reads them; the array can be freed once it
+     * returns. */
+    const EB_H265_RC_STATS *rcStatsIn;
+    uint32_t                rcStatsInCount;
+
 } EB_H265_ENC_CONFIGURATION;
 
+/* Parameters of EbH265EncUpdateParameter, updateFlags selects the ones applied */
+#define EB_ENC_UPDATE_TARGET_BIT_RATE   (1 << 0)
+#define EB_ENC_UPDATE_VBV               (1 << 1)
+#define EB_ENC_UPDATE_QP_RANGE          (1 << 2)
+#define EB_ENC_UPDATE_ENC_MODE          (1 << 3)
+#define EB_ENC_UPDATE_FORCE_IDR         (1 << 4)
+
+typedef struct EB_H265_ENC_UPDATE
+{
+    uint32_t                updateFlags;
+
+    // Rate control mode 1 only, in bits per second
+    uint32_t                targetBitRate;
+    uint32_t                vbvMaxrate;
+    uint32_t                vbvBufsize;
+
+    uint32_t                maxQpAllowed;
+    uint32_t                minQpAllowed;
+
+    // [0 - the most efficient preset supported at the encoded resolution]
+    uint8_t                 encMode;
+} EB_H265_ENC_UPDATE;
+
 
 // API calls:
 
@@ -724,6 +1010,8 @@ EB_API EB_ERRORTYPE EbH265EncSendPicture(
     EB_BUFFERHEADERTYPE        *pBuffer);
 
 /* STEP 5: Receive packet.
+ * The packet is the encoder output buffer itself, no copy is made. It stays
+ * valid until it is returned with EbH265ReleaseOutBuffer.
  *
  * Parameter:
  * @ *h265EncComponent  Encoder handler.
@@ -750,6 +1038,34 @@ EB_API EB_ERRORTYPE EbH265GetRecon(
     EB_COMPONENTTYPE           *h265EncComponent,
     EB_BUFFERHEADERTYPE        *pBuffer);
 
+/* OPTIONAL: Get the pipeline statistics: the load and queue depth of every
+ * stage, the pictures in flight and the latency histogram. Can be called from
+ * any thread between EbInitEncoder and EbDeinitEncoder, it takes no lock.
+ *
+ * Parameter:
+ * @ *h265EncComponent  Encoder handler.
+ * @ *statsPtr          Statistics to fill. */
+EB_API EB_ERRORTYPE EbH265GetStats(
+    EB_COMPONENTTYPE           *h265EncComponent,
+    EB_H265_ENC_STATS          *statsPtr);
+
+/* OPTIONAL: Change the bit rate, the VBV, the QP range or the preset, or
+ * request an IDR, without re-initializing the encoder. Can be called from
+ * any thread between EbInitEncoder and EbDeinitEncoder. The new values apply
+ * from the next picture sent with EbH265EncSendPicture; pictures already sent
+ * are encoded with the old ones. The parameters of the last 64 calls are kept
+ * for the pictures still waiting in the input queue, older pictures get those
+ * of the last call. With hrdFlag, a bit rate or VBV change also starts a new
+ * coded video sequence with an IDR so the SPS can carry the new HRD
+ * parameters. Nothing is changed when EB_ErrorBadParameter is returned.
+ *
+ * Parameter:
+ * @ *h265EncComponent  Encoder handler.
+ * @ *updatePtr         Parameters to apply, see EB_H265_ENC_UPDATE. */
+EB_API EB_ERRORTYPE EbH265EncUpdateParameter(
+    EB_COMPONENTTYPE           *h265EncComponent,
+    EB_H265_ENC_UPDATE         *updatePtr);
+
 /* STEP 6: Deinitialize encoder library.
  *
  * Parameter:
@@ -13,6 +13,10 @@
 #include "EbApiVersion.h"
 #include "EbAppInputy4m.h"
 
+#ifndef LOCK_FREE_FIFO
+#define LOCK_FREE_FIFO 1 // Set by the LOCK_FREE_FIFO CMake option
+#endif
+
 #ifdef _WIN32
 #else
 #include <unistd.h>
@@ -43,6 +47,7 @@
 #define TILE_ROW_COUNT_TOKEN            "-tile_row_cnt"
 #define TILE_COL_COUNT_TOKEN            "-tile_col_cnt"
 #define TILE_SLICE_MODE_TOKEN           "-tile_slice_mode"
+#define WPP_ENABLE_TOKEN                "-wpp"
 #define TUNE_TOKEN                      "-tune"
 #define FRAME_RATE_TOKEN                "-fps"
 #define FRAME_RATE_NUMERATOR_TOKEN      "-fps-num"
@@ -87,6 +92,7 @@
 #define NALU_FILE_TOKEN                 "-nalu-file"
 #define RATE_CONTROL_ENABLE_TOKEN       "-rc"
 #define TARGET_BIT_RATE_TOKEN           "-tbr"
+#define CRF_TOKEN                       "-crf"
 #define VBV_MAX_RATE_TOKEN              "-vbv-maxrate"
 #define VBV_BUFFER_SIZE_TOKEN           "-vbv-bufsize"
 #define VBV_BUFFER_INIT_TOKEN           "-vbv-init"
@@ -95,6 +101,11 @@
 #define MIN_QP_TOKEN                    "-min-qp"
 #define TEMPORAL_ID					    "-temporal-id" // no Eval
 #define LOOK_AHEAD_DIST_TOKEN           "-lad"
+#define RC_PASS_TOKEN                   "-pass"
+#define RC_STATS_FILE_TOKEN             "-stats"
+#define UPDATE_FRAME_TOKEN              "-update-frame"
+#define UPDATE_TARGET_BIT_RATE_TOKEN    "-update-tbr"
+#define UPDATE_ENC_MODE_TOKEN           "-update-encMode"
 #define SCENE_CHANGE_DETECTION_TOKEN    "-scd"
 #define INJECTOR_TOKEN                  "-inj"  // no Eval
 #define INJECTOR_FRAMERATE_TOKEN        "-inj-frm-rt" // no Eval
@@ -102,10 +113,17 @@
 #define ASM_TYPE_TOKEN				    "-asm" // no Eval
 #define THREAD_MGMNT                    "-lp"
 #define TARGET_SOCKET                   "-ss"
+#define NUMA_PARTITION_TOKEN            "-numa"
+#define HUGE_PAGES_TOKEN                "-huge-pages"
+#define MEMORY_BUDGET_TOKEN             "-memory-budget"
 #define THREAD_COUNT                    "-thread-count"
+#define STAGE_PRIORITY_TOKEN            "-stage-priority"
+#define LOCK_FREE_FIFO_TOKEN            "-lock-free-fifo"
 #define SWITCHTHREADSTOREALTIME_TOKEN   "-rt"
 #define FPSINVPS_TOKEN                  "-fpsinvps"
 #define UNRESTRICTED_MOTION_VECTOR      "-umv"
+#define SUB_PICTURE_REFERENCE_TOKEN     "-sub-pic-ref"
+#define ZERO_COPY_INPUT_TOKEN           "-zero-copy"
 #define CONFIG_FILE_COMMENT_CHAR        '#'
 #define CONFIG_FILE_NEWLINE_CHAR        '\n'
 #define CONFIG_FILE_RETURN_CHAR         '\r'
@@ -218,15 +236,26 @@ static void SetCfgUseQpFile                     (const char *value, EbConfig_t *
 static void SetCfgTileColumnCount               (const char *value, EbConfig_t *cfg) { cfg->tileColumnCount                 = (EB_BOOL)strtol(value, NULL, 0); };
 static void SetCfgTileRowCount                  (const char *value, EbConfig_t *cfg) { cfg->tileRowCount                    = (EB_BOOL)strtol(value, NULL, 0); };
 static void SetCfgTileSliceMode                 (const char *value, EbConfig_t *cfg) { cfg->tileSliceMode                   = (EB_BOOL)strtol(value, NULL, 0); };
+static void SetEnableWppFlag                    (const char *value, EbConfig_t *cfg) {cfg->enableWppFlag                    = (EB_BOOL)strtoul(value, NULL, 0);};
 static void SetDisableDlfFlag                   (const char *value, EbConfig_t *cfg) {cfg->disableDlfFlag                   = (EB_BOOL)strtoul(value, NULL, 0);};
 static void SetEnableSaoFlag                    (const char *value, EbConfig_t *cfg) {cfg->enableSaoFlag                    = (EB_BOOL)strtoul(value, NULL, 0);};
 static void SetEnableHmeFlag                    (const char *value, EbConfig_t *cfg) {cfg->enableHmeFlag                    = (EB_BOOL)strtoul(value, NULL, 0);};
 static void SetSceneChangeDetection             (const char *value, EbConfig_t *cfg) {cfg->sceneChangeDetection             = strtoul(value, NULL, 0);};
 static void SetLookAheadDistance                (const char *value, EbConfig_t *cfg) {cfg->lookAheadDistance                = strtoul(value, NULL, 0);};
 static void SetRateControlMode                  (const char *value, EbConfig_t *cfg) {cfg->rateControlMode                  = strtoul(value, NULL, 0);};
+static void SetRcPass                           (const char *value, EbConfig_t *cfg) {cfg->rcPass                           = strtoul(value, NULL, 0);};
+static void SetCfgRcStatsFile                   (const char *value, EbConfig_t *cfg)
+{
+    // Opened once the pass is known, see OpenRcStatsFile
+    EB_STRCPY(cfg->rcStatsFileName, EB_STRLEN(value, MAX_STRING_LENGTH) + 1, value);
+};
 static void SetTargetBitRate                    (const char *value, EbConfig_t *cfg) {cfg->targetBitRate                    = strtoul(value, NULL, 0);};
+static void SetCrf                              (const char *value, EbConfig_t *cfg) {cfg->crf                              = strtoul(value, NULL, 0);};
 static void SetMaxQpAllowed                     (const char *value, EbConfig_t *cfg) {cfg->maxQpAllowed                     = strtoul(value, NULL, 0);};
 static void SetMinQpAllowed                     (const char *value, EbConfig_t *cfg) {cfg->minQpAllowed                     = strtoul(value, NULL, 0);};
+static void SetUpdateFrame                      (const char *value, EbConfig_t *cfg) {cfg->updateFrame                      = strtoull(value, NULL, 0);};
+static void SetUpdateTargetBitRate              (const char *value, EbConfig_t *cfg) {cfg->updateTargetBitRate              = strtoul(value, NULL, 0);};
+static void SetUpdateEncMode                    (const char *value, EbConfig_t *cfg) {cfg->updateEncMode                    = (int32_t)strtol(value, NULL, 0);};
 static void SetCfgSearchAreaWidth               (const char *value, EbConfig_t *cfg) {cfg->searchAreaWidth                  = strtoul(value, NULL, 0);};
 static void SetCfgSearchAreaHeight              (const char *value, EbConfig_t *cfg) {cfg->searchAreaHeight                 = strtoul(value, NULL, 0);};
 static void SetCfgUseDefaultMeHme               (const char *value, EbConfig_t *cfg) {cfg->useDefaultMeHme                  = (EB_BOOL)strtol(value, NULL, 0); };
@@ -278,10 +307,17 @@ static void SetInjectorFrameRate                (const char *value, EbConfig_t *
 static void SetAsmType                          (const char *value, EbConfig_t *cfg)  {cfg->asmType                         = (uint32_t)strtoul(value, NULL, 0); };
 static void SetLogicalProcessors                (const char *value, EbConfig_t *cfg)  {cfg->logicalProcessors               = (uint32_t)strtoul(value, NULL, 0);};
 static void SetTargetSocket                     (const char *value, EbConfig_t *cfg)  {cfg->targetSocket                    = (int32_t)strtol(value, NULL, 0);};
+static void SetNumaPartition                    (const char *value, EbConfig_t *cfg)  {cfg->numaPartition                   = (EB_BOOL)strtol(value, NULL, 0);};
+static void SetHugePages                        (const char *value, EbConfig_t *cfg)  {cfg->hugePages                       = (uint32_t)strtoul(value, NULL, 0);};
+static void SetMemoryBudget                     (const char *value, EbConfig_t *cfg)  {cfg->memoryBudgetMB                  = (uint32_t)strtoul(value, NULL, 0);};
 static void SetSwitchThreadsToRtPriority        (const char *value, EbConfig_t *cfg)  {cfg->switchThreadsToRtPriority       = (EB_BOOL)strtol(value, NULL, 0);};
 static void SetThreadCount                      (const char *value, EbConfig_t *cfg)  {cfg->threadCount                     = (uint32_t)strtoul(value, NULL, 0); };
+static void SetStagePriority                    (const char *value, EbConfig_t *cfg)  {cfg->stagePriority                   = (EB_BOOL)strtol(value, NULL, 0);};
+static void SetLockFreeFifo                     (const char *value, EbConfig_t *cfg)  {cfg->lockFreeFifo                    = (EB_BOOL)strtol(value, NULL, 0);};
 static void SetFpsInVps                         (const char *value, EbConfig_t *cfg)  {cfg->fpsInVps                        = (EB_BOOL)strtol(value, NULL, 0);};
 static void SetUnrestrictedMotionVector         (const char *value, EbConfig_t *cfg)  {cfg->unrestrictedMotionVector        = (EB_BOOL)strtol(value, NULL, 0);};
+static void SetSubPictureReference              (const char *value, EbConfig_t *cfg)  {cfg->subPictureReference             = (EB_BOOL)strtol(value, NULL, 0);};
+static void SetZeroCopyInput                    (const char *value, EbConfig_t *cfg)  {cfg->zeroCopyInput                   = (EB_BOOL)strtol(value, NULL, 0);};
 
 enum cfg_type{
     SINGLE_INPUT,   // Configuration parameters that have only 1 value input
@@ -319,6 +355,7 @@ config_entry_t config_entry[] = {
      { SINGLE_INPUT, TILE_ROW_COUNT_TOKEN, "TileRowCount", SetCfgTileRowCount },
      { SINGLE_INPUT, TILE_COL_COUNT_TOKEN, "TileColumnCount", SetCfgTileColumnCount },
      { SINGLE_INPUT, TILE_SLICE_MODE_TOKEN, "TileSliceMode", SetCfgTileSliceMode },
+     { SINGLE_INPUT, WPP_ENABLE_TOKEN, "WavefrontParallelProcessing", SetEnableWppFlag },
 
     // Encoding Presets
     { SINGLE_INPUT, ENCMODE_TOKEN, "EncoderMode", SetencMode },
@@ -381,10 +418,16 @@ config_entry_t config_entry[] = {
     // Rate Control
 	{ SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", SetRateControlMode },
     { SINGLE_INPUT, TARGET_BIT_RATE_TOKEN, "TargetBitRate", SetTargetBitRate },
+    { SINGLE_INPUT, CRF_TOKEN, "Crf", SetCrf },
     { SINGLE_INPUT, MAX_QP_TOKEN, "MaxQpAllowed", SetMaxQpAllowed },
     { SINGLE_INPUT, MIN_QP_TOKEN, "MinQpAllowed", SetMinQpAllowed },
     { SINGLE_INPUT, LOOK_AHEAD_DIST_TOKEN, "LookAheadDistance", SetLookAheadDistance },
     { SINGLE_INPUT, SCENE_CHANGE_DETECTION_TOKEN, "SceneChangeDetection", SetSceneChangeDetection },
+    { SINGLE_INPUT, RC_PASS_TOKEN, "RcPass", SetRcPass },
+    { SINGLE_INPUT, RC_STATS_FILE_TOKEN, "RcStatsFile", SetCfgRcStatsFile },
+    { SINGLE_INPUT, UPDATE_FRAME_TOKEN, "UpdateFrame", SetUpdateFrame },
+    { SINGLE_INPUT, UPDATE_TARGET_BIT_RATE_TOKEN, "UpdateTargetBitRate", SetUpdateTargetBitRate },
+    { SINGLE_INPUT, UPDATE_ENC_MODE_TOKEN, "UpdateEncoderMode", SetUpdateEncMode },
 
     // Tune
     { SINGLE_INPUT, TUNE_TOKEN, "Tune", SetCfgTune },
@@ -415,6 +458,8 @@ config_entry_t config_entry[] = {
     { SINGLE_INPUT, TEMPORAL_ID, "TemporalId", SetEnableTemporalId },
     { SINGLE_INPUT, FPSINVPS_TOKEN, "FPSInVPS", SetFpsInVps },
     { SINGLE_INPUT, UNRESTRICTED_MOTION_VECTOR, "UnrestrictedMotionVector", SetUnrestrictedMotionVector },
+    { SINGLE_INPUT, SUB_PICTURE_REFERENCE_TOKEN, "SubPictureReference", SetSubPictureReference },
+    { SINGLE_INPUT, ZERO_COPY_INPUT_TOKEN, "ZeroCopyInput", SetZeroCopyInput },
 
     // Latency
     { SINGLE_INPUT, INJECTOR_TOKEN, "Injector", SetInjector },
@@ -430,8 +475,13 @@ config_entry_t config_entry[] = {
     // Platform Specific Flags
     { SINGLE_INPUT, ASM_TYPE_TOKEN, "AsmType", SetAsmType },
     { SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", SetTargetSocket },
+    { SINGLE_INPUT, NUMA_PARTITION_TOKEN, "NumaPartition", SetNumaPartition },
+    { SINGLE_INPUT, HUGE_PAGES_TOKEN, "HugePages", SetHugePages },
+    { SINGLE_INPUT, MEMORY_BUDGET_TOKEN, "MemoryBudgetMB", SetMemoryBudget },
     { SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", SetLogicalProcessors },
     { SINGLE_INPUT, THREAD_COUNT, "ThreadCount", SetThreadCount },
+    { SINGLE_INPUT, STAGE_PRIORITY_TOKEN, "StagePriority", SetStagePriority },
+    { SINGLE_INPUT, LOCK_FREE_FIFO_TOKEN, "LockFreeFifo", SetLockFreeFifo },
 
     // Termination
     { SINGLE_INPUT, NULL, NULL, NULL }
@@ -450,6 +500,7 @@ void EbConfigCtor(EbConfig_t *configPtr)
     configPtr->reconFile                            = NULL;
     configPtr->bufferFile                           = NULL;
     configPtr->useQpFile                            = EB_FALSE;
+    configPtr->qpReadFromFile                       = EB_FALSE;
     configPtr->qpFile                               = NULL;
     configPtr->segmentOvFile                        = NULL;
 
@@ -458,6 +509,7 @@ void EbConfigCtor(EbConfig_t *configPtr)
     configPtr->tileColumnCount                      = 1;
     configPtr->tileRowCount                         = 1;
     configPtr->tileSliceMode                        = 0;
+    configPtr->enableWppFlag                        = EB_FALSE;
 
     // SEI
     configPtr->maxCLL                               = 0;
@@ -545,10 +597,16 @@ void EbConfigCtor(EbConfig_t *configPtr)
     // Rate Control
     configPtr->rateControlMode                      = 0;
     configPtr->targetBitRate                        = 7000000;
+    configPtr->crf                                  = 28;
     configPtr->maxQpAllowed                         = 48;
     configPtr->minQpAllowed                         = 10;
     configPtr->lookAheadDistance                    = (uint32_t)~0;
     configPtr->sceneChangeDetection                 = 1;
+    configPtr->rcPass                               = 0;
+    configPtr->rcStatsFileName[0]                   = '\0';
+    configPtr->updateFrame                          = 0;
+    configPtr->updateTargetBitRate                  = 0;
+    configPtr->updateEncMode                        = -1;
 
     // Tune: only OQ
     configPtr->tune                                 = 1;
@@ -570,12 +628,19 @@ void EbConfigCtor(EbConfig_t *configPtr)
     configPtr->switchThreadsToRtPriority            = EB_TRUE;
     configPtr->fpsInVps                             = EB_TRUE;
     configPtr->unrestrictedMotionVector             = EB_TRUE;
+    configPtr->subPictureReference                  = EB_FALSE;
+    configPtr->zeroCopyInput                        = EB_FALSE;
 
     // Platform Specific Flags
     configPtr->asmType                              = 1;
     configPtr->targetSocket                         = -1;
+    configPtr->numaPartition                        = EB_FALSE;
+    configPtr->hugePages                            = 0;
+    configPtr->memoryBudgetMB                       = 0;
     configPtr->logicalProcessors                    = 0;
     configPtr->threadCount                          = 0;
+    configPtr->stagePriority                        = EB_FALSE;
+    configPtr->lockFreeFifo                         = LOCK_FREE_FIFO;
 
     // vbv
     configPtr->vbvMaxRate                           = 0;
@@ -910,6 +975,16 @@ static EB_ERRORTYPE VerifySettings(EbConfig_t *config, uint32_t channelNumber)
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->zeroCopyInput && (config->encoderBitDepth != 8 || config->separateFields || config->bufferedInput != -1)) {
+        fprintf(config->errorLogFile, "SVT [Error]: Instance %u: ZeroCopyInput requires 8-bit progressive input and BufferedInput -1\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rcPass && config->rcStatsFileName[0] == '\0') {
+        fprintf(config->errorLogFile, "SVT [Error]: Instance %u: RcPass requires an RcStatsFile\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->useQpFile == EB_TRUE && config->qpFile == NULL) {
         fprintf(config->errorLogFile, "SVT [Error]: Instance %u: Could not find QP file, UseQpFile is set to 1\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -942,6 +1017,11 @@ static EB_ERRORTYPE VerifySettings(EbConfig_t *config, uint32_t channelNumber)
         return_error = EB_ErrorBadParameter;
     }
 
+    if ((config->tileColumnCount * config->tileRowCount) > 1 && config->enableWppFlag) {
+        fprintf(config->errorLogFile, "SVT [Error]: Instance %u: WavefrontParallelProcessing is only supported in single tile mode\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
 
     {
         for (horizontalTileIndex = 0; horizontalTileIndex < (config->tileColumnCount - 1); ++horizontalTileIndex) {
@@ -1002,6 +1082,23 @@ static EB_ERRORTYPE VerifySettings(EbConfig_t *config, uint32_t channelNumber)
         return_error = EB_ErrorBadParameter;
     }
 
+    // Runtime parameter update
+    if (config->updateFrame && config->updateTargetBitRate == 0 && config->updateEncMode == -1) {
+        fprintf(config->errorLogFile, "SVT [Error]: Instance %u: UpdateFrame needs UpdateTargetBitRate or UpdateEncoderMode\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->updateTargetBitRate && config->rateControlMode != 1) {
+        fprintf(config->errorLogFile, "SVT [Error]: Instance %u: UpdateTargetBitRate is only supported with RateControlMode 1\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    // HugePages
+    if (config->hugePages > 2) {
+        fprintf(config->errorLogFile, "SVT [Error]: Instance %u: Invalid HugePages [0 - 2], your input: %u\n", channelNumber + 1, config->hugePages);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->useNaluFile == 1 && config->naluFile == NULL) {
         fprintf(config->errorLogFile, "SVT [Error]: Instance %u : Invalid Nalu File\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -1022,15 +1119,16 @@ int32_t FindTokenMultipleInputs(
     int32_t         argc,
     char* const     argv[],
     const char*     token,
-    char**          configStr)
+    char**          configStr,
+    uint32_t        numChannels)
 {
     int32_t return_error = -1;
     int32_t done = 0;
     while((argc > 0) && (return_error != 0)) {
         return_error = EB_STRCMP(argv[--argc], token);
         if (return_error == 0) {
-            int32_t count;
-            for (count=0; count < MAX_CHANNEL_NUMBER  ; ++count){
+            uint32_t count;
+            for (count=0; count < numChannels; ++count){
                 if (done ==0){
                     if (argv[argc + count + 1] ){
                         if (strtoul(argv[argc + count + 1], NULL,0) != 0 || EB_STRCMP(argv[argc + count + 1], "0") == 0 ){
@@ -1100,8 +1198,8 @@ uint32_t GetNumberOfChannels(
 
         // Set the input file
         channelNumber = strtol(config_string,  NULL, 0);
-        if ((channelNumber > (uint32_t) MAX_CHANNEL_NUMBER) || channelNumber == 0){
-            printf("Error: The number of channels has to be within the range [1,%u]\n",(uint32_t) MAX_CHANNEL_NUMBER);
+        if ((int32_t)channelNumber <= 0){
+            printf("Error: The number of channels has to be at least 1\n");
             return 0;
         }else{
             return channelNumber;
@@ -1218,15 +1316,20 @@ EB_ERRORTYPE ReadCommandLine(
 
     EB_ERRORTYPE return_error = EB_ErrorBadParameter;
     char		    config_string[COMMAND_LINE_MAX_SIZE];		// for one input options
-    char		   *config_strings[MAX_CHANNEL_NUMBER]; // for multiple input options
+    char		  **config_strings;                         // for multiple input options
     char           *cmd_copy[MAX_NUM_TOKENS];                 // keep track of extra tokens
     uint32_t    index           = 0;
     int32_t             cmd_token_cnt   = 0;                        // total number of tokens
     int32_t             token_index     = -1;
     int32_t ret_y4m;
 
-    for (index = 0; index < MAX_CHANNEL_NUMBER; ++index){
+    config_strings = (char**)malloc(sizeof(char*) * numChannels);
+    if (config_strings == NULL)
+        return EB_ErrorInsufficientResources;
+    for (index = 0; index < numChannels; ++index){
         config_strings[index] = (char*)malloc(sizeof(char)*COMMAND_LINE_MAX_SIZE);
+        if (config_strings[index] == NULL)
+            return EB_ErrorInsufficientResources;
     }
 
     // Copy tokens (except for CHANNEL_NUMBER_TOKEN ) into a temp token buffer hosting all tokens that are passed through the command line
@@ -1241,7 +1344,7 @@ EB_ERRORTYPE ReadCommandLine(
     /****************  Find configuration files tokens and call respective functions  ******************/
     /***************************************************************************************************/
     // Find the Config File Path in the command line
-    if (FindTokenMultipleInputs(argc, argv, CONFIG_FILE_TOKEN, config_strings) == 0) {
+    if (FindTokenMultipleInputs(argc, argv, CONFIG_FILE_TOKEN, config_strings, numChannels) == 0) {
 
         mark_token_as_read(CONFIG_FILE_TOKEN, cmd_copy, &cmd_token_cnt);
         // Parse the config file
@@ -1269,7 +1372,7 @@ EB_ERRORTYPE ReadCommandLine(
     while (config_entry[++token_index].name != NULL){
         if (config_entry[token_index].type == SINGLE_INPUT){
 
-            if (FindTokenMultipleInputs(argc, argv, config_entry[token_index].token, config_strings) == 0) {
+            if (FindTokenMultipleInputs(argc, argv, config_entry[token_index].token, config_strings, numChannels) == 0) {
 
                 // When a token is found mark it as found in the temp token buffer
                 mark_token_as_read(config_entry[token_index].token, cmd_copy, &cmd_token_cnt);
@@ -1353,9 +1456,10 @@ EB_ERRORTYPE ReadCommandLine(
         return_error = EB_ErrorBadParameter;
     }
 
-    for (index = 0; index < MAX_CHANNEL_NUMBER; ++index){
+    for (index = 0; index < numChannels; ++index){
         free(config_strings[index]);
     }
+    free(config_strings);
 
     return return_error;
 }
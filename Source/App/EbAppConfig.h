@@ -137,7 +137,6 @@ typedef struct EB_PARAM_PORTDEFINITIONTYPE {
     printf("Total Number of Mallocs in App: %d\n", appMallocCount); \
     printf("Total App Memory: %.2lf KB\n\n",*totalAppMemory/(double)1024);
 
-#define MAX_CHANNEL_NUMBER      6
 #define MAX_NUM_TOKENS          200
 
 #define MAX_STRING_LENGTH       1024
@@ -209,9 +208,11 @@ typedef struct EbConfig_s
     unsigned char           y4m_buf[9];
 
     EB_BOOL                useQpFile;
+    EB_BOOL                qpReadFromFile;     // a valid qp was found in qpFile
     uint8_t                 tileColumnCount;
     uint8_t                 tileRowCount;
     uint8_t                 tileSliceMode;
+    uint8_t                 enableWppFlag;
     int32_t                 frameRate;
     int32_t                 frameRateNumerator;
     int32_t                 frameRateDenominator;
@@ -289,13 +290,21 @@ typedef struct EbConfig_s
     uint32_t                 sceneChangeDetection;
     uint32_t                 rateControlMode;
     uint32_t                 lookAheadDistance;
+    uint32_t                 rcPass;
+    char                     rcStatsFileName[MAX_STRING_LENGTH];
     uint32_t                 targetBitRate;
+    uint32_t                 crf;
     uint32_t                 maxQpAllowed;
     uint32_t                 minQpAllowed;
     uint32_t                 vbvMaxRate;
     uint32_t                 vbvBufsize;
     uint64_t                 vbvBufInit;
 
+    // EbH265EncUpdateParameter call before the picture updateFrame is sent, 0 = none
+    uint64_t                 updateFrame;
+    uint32_t                 updateTargetBitRate;                   // 0 = unchanged
+    int32_t                  updateEncMode;                         // -1 = unchanged
+
     /****************************************
     * TUNE
     ****************************************/
@@ -320,6 +329,8 @@ typedef struct EbConfig_s
     EB_BOOL                fpsInVps;
     uint32_t                 hrdFlag;
     EB_BOOL                unrestrictedMotionVector;
+    EB_BOOL                subPictureReference;
+    EB_BOOL                zeroCopyInput;
 
     /****************************************
      * Annex A Parameters
@@ -351,7 +362,12 @@ typedef struct EbConfig_s
     uint32_t     activeChannelCount;
     uint32_t     logicalProcessors;
     int32_t      targetSocket;
+    EB_BOOL      numaPartition;
+    uint32_t     hugePages;
+    uint32_t     memoryBudgetMB;
     uint32_t     threadCount;
+    EB_BOOL      stagePriority;
+    EB_BOOL      lockFreeFifo;
     EB_BOOL      stopEncoder;         // to signal CTRL+C Event, need to stop encoding.
 
     uint64_t     processedFrameCount;
@@ -19,9 +19,11 @@
 #define INPUT_SIZE_4K_TH				0x29F630    // 2.75 Million
 #define INPUT_SIZE_8K_TH				0xB71B00    // 12 Million
 
+// Two-pass statistics file: header, then one EB_H265_RC_STATS per picture in display order
+#define RC_STATS_FILE_MAGIC             0x53545648  // "HVTS"
+
 #define SIZE_OF_ONE_FRAME_IN_BYTES(width, height,is16bit) ( ( ((width)*(height)*3)>>1 )<<is16bit)
 #define IS_16_BIT(bit_depth) (bit_depth==10?1:0)
-#define EB_OUTPUTSTREAMBUFFERSIZE_MACRO(ResolutionSize)                ((ResolutionSize) < (INPUT_SIZE_1080i_TH) ? 0x1E8480 : (ResolutionSize) < (INPUT_SIZE_1080p_TH) ? 0x2DC6C0 : (ResolutionSize) < (INPUT_SIZE_4K_TH) ? 0x2DC6C0 : (ResolutionSize) < (INPUT_SIZE_8K_TH) ? 0x2DC6C0:0x5B8D80)
 
  /***************************************
  * Variables Defining a memory table
@@ -31,37 +33,36 @@ EbMemoryMapEntry                 *appMemoryMap;
 uint32_t                         *appMemoryMapIndex;
 uint64_t                         *totalAppMemory;
 uint32_t                          appMallocCount = 0;
-static EbMemoryMapEntry          *appMemoryMapAllChannels[MAX_CHANNEL_NUMBER];
-static uint32_t                   appMemoryMapIndexAllChannels[MAX_CHANNEL_NUMBER];
-static uint64_t                   appMemoryMallocdAllChannels[MAX_CHANNEL_NUMBER];
 
 /***************************************
 * Allocation and initializing a memory table
 *  hosting all allocated pointers
 ***************************************/
-void AllocateMemoryTable(
-    uint32_t	instanceIdx)
+EB_ERRORTYPE AllocateMemoryTable(
+    EbAppContext_t *callbackData)
 {
-    // Malloc Memory Table for the instance @ instanceIdx
-    appMemoryMapAllChannels[instanceIdx]        = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * MAX_APP_NUM_PTR);
+    // Malloc Memory Table for the instance
+    callbackData->appMemoryMap          = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * MAX_APP_NUM_PTR);
+    if (callbackData->appMemoryMap == NULL)
+        return EB_ErrorInsufficientResources;
 
     // Init the table index
-    appMemoryMapIndexAllChannels[instanceIdx]   = 0;
+    callbackData->appMemoryMapIndex     = 0;
 
     // Size of the table
-    appMemoryMallocdAllChannels[instanceIdx]    = sizeof(EbMemoryMapEntry) * MAX_APP_NUM_PTR;
-    totalAppMemory = &appMemoryMallocdAllChannels[instanceIdx];
+    callbackData->appMemoryMallocd      = sizeof(EbMemoryMapEntry) * MAX_APP_NUM_PTR;
+    totalAppMemory = &callbackData->appMemoryMallocd;
 
     // Set pointer to the first entry
-    appMemoryMap                                = appMemoryMapAllChannels[instanceIdx];
+    appMemoryMap                        = callbackData->appMemoryMap;
 
     // Set index to the first entry
-    appMemoryMapIndex                           = &appMemoryMapIndexAllChannels[instanceIdx];
+    appMemoryMapIndex                   = &callbackData->appMemoryMapIndex;
 
     // Init Number of pointers
     appMallocCount = 0;
 
-    return;
+    return EB_ErrorNone;
 }
 
 
@@ -143,6 +144,83 @@ void ProcessInputFieldBufferingMode(
     }
 }
 
+/***********************************************
+* Zero-copy input release callback, called from
+*  an encoder thread once a frame is encoded
+***********************************************/
+static void ReleaseZeroCopyFrame(
+    EB_BUFFERHEADERTYPE     *pBuffer)
+{
+    ((EbAppZeroCopyFrame_t*)pBuffer)->inUse = 0;
+}
+
+/***********************************************
+* Two-pass rate control statistics
+***********************************************/
+typedef struct RcStatsFileHeader_s {
+    uint32_t magic;
+    uint32_t recordSize;
+} RcStatsFileHeader_t;
+
+static void WriteRcStats(
+    void                    *pAppData,
+    const EB_H265_RC_STATS  *stats)
+{
+    EbAppContext_t *callbackData = (EbAppContext_t*)pAppData;
+
+    fwrite(stats, sizeof(EB_H265_RC_STATS), 1, callbackData->rcStatsFile);
+}
+
+static EB_ERRORTYPE OpenRcStatsFile(
+    EbConfig_t              *config,
+    EbAppContext_t          *callbackData)
+{
+    RcStatsFileHeader_t header;
+    long                fileSize;
+    size_t              recordCount;
+
+    if (config->rcPass == 1) {
+        FOPEN(callbackData->rcStatsFile, config->rcStatsFileName, "wb");
+        if (callbackData->rcStatsFile == NULL) {
+            fprintf(config->errorLogFile, "Error: Could not create the RcStatsFile %s\n", config->rcStatsFileName);
+            return EB_ErrorBadParameter;
+        }
+        header.magic = RC_STATS_FILE_MAGIC;
+        header.recordSize = sizeof(EB_H265_RC_STATS);
+        fwrite(&header, sizeof(header), 1, callbackData->rcStatsFile);
+
+        callbackData->ebEncParameters.rcStatsCallback = WriteRcStats;
+    }
+    else if (config->rcPass == 2) {
+        FOPEN(callbackData->rcStatsFile, config->rcStatsFileName, "rb");
+        if (callbackData->rcStatsFile == NULL) {
+            fprintf(config->errorLogFile, "Error: Could not open the RcStatsFile %s\n", config->rcStatsFileName);
+            return EB_ErrorBadParameter;
+        }
+        fseek(callbackData->rcStatsFile, 0, SEEK_END);
+        fileSize = ftell(callbackData->rcStatsFile);
+        fseek(callbackData->rcStatsFile, 0, SEEK_SET);
+
+        if (fread(&header, sizeof(header), 1, callbackData->rcStatsFile) != 1 ||
+            header.magic != RC_STATS_FILE_MAGIC || header.recordSize != sizeof(EB_H265_RC_STATS)) {
+            fprintf(config->errorLogFile, "Error: %s is not a first pass RcStatsFile\n", config->rcStatsFileName);
+            return EB_ErrorBadParameter;
+        }
+
+        recordCount = (size_t)(fileSize - (long)sizeof(header)) / sizeof(EB_H265_RC_STATS);
+        callbackData->rcStatsIn = (EB_H265_RC_STATS*)malloc(sizeof(EB_H265_RC_STATS) * (recordCount + 1));
+        if (callbackData->rcStatsIn == NULL) {
+            return EB_ErrorInsufficientResources;
+        }
+        recordCount = fread(callbackData->rcStatsIn, sizeof(EB_H265_RC_STATS), recordCount, callbackData->rcStatsFile);
+
+        callbackData->ebEncParameters.rcStatsIn = callbackData->rcStatsIn;
+        callbackData->ebEncParameters.rcStatsInCount = (uint32_t)recordCount;
+    }
+    callbackData->ebEncParameters.rcPass = config->rcPass;
+
+    return EB_ErrorNone;
+}
 
 /***********************************************
 * Copy configuration parameters from
@@ -167,7 +245,7 @@ EB_ERRORTYPE CopyConfigurationParameters(
     callbackData->ebEncParameters.rateControlMode = config->rateControlMode;
     callbackData->ebEncParameters.intraPeriodLength = config->intraPeriod;
     callbackData->ebEncParameters.intraRefreshType = config->intraRefreshType;
-    if (config->rateControlMode == 0 && config->intraRefreshType > 0)
+    if (config->rateControlMode != 1 && config->intraRefreshType > 0)
     {
         printf("\nWarning: intraRefreshType >0 is only supported in VBR mode\n");
         callbackData->ebEncParameters.intraRefreshType = 0;
@@ -184,6 +262,7 @@ EB_ERRORTYPE CopyConfigurationParameters(
     callbackData->ebEncParameters.lookAheadDistance = config->lookAheadDistance;
     callbackData->ebEncParameters.framesToBeEncoded = config->framesToBeEncoded;
     callbackData->ebEncParameters.targetBitRate = config->targetBitRate;
+    callbackData->ebEncParameters.crf = config->crf;
     callbackData->ebEncParameters.maxQpAllowed = config->maxQpAllowed;
     callbackData->ebEncParameters.minQpAllowed = config->minQpAllowed;
     callbackData->ebEncParameters.qp = config->qp;
@@ -194,6 +273,7 @@ EB_ERRORTYPE CopyConfigurationParameters(
     callbackData->ebEncParameters.tileColumnCount = (EB_BOOL)config->tileColumnCount;
     callbackData->ebEncParameters.tileRowCount = (EB_BOOL)config->tileRowCount;
     callbackData->ebEncParameters.tileSliceMode = (EB_BOOL)config->tileSliceMode;
+    callbackData->ebEncParameters.enableWppFlag = (EB_BOOL)config->enableWppFlag;
     callbackData->ebEncParameters.disableDlfFlag = (EB_BOOL)config->disableDlfFlag;
     callbackData->ebEncParameters.enableSaoFlag = (EB_BOOL)config->enableSaoFlag;
     callbackData->ebEncParameters.hrdFlag = (EB_BOOL)config->hrdFlag;
@@ -207,19 +287,17 @@ EB_ERRORTYPE CopyConfigurationParameters(
     callbackData->ebEncParameters.activeChannelCount = config->activeChannelCount;
     callbackData->ebEncParameters.logicalProcessors = config->logicalProcessors;
     callbackData->ebEncParameters.targetSocket = config->targetSocket;
-    if ((config->threadCount > 0) && (config->threadCount < EB_THREAD_COUNT_MIN_CORE * EB_THREAD_COUNT_FACTOR)) {
-        callbackData->ebEncParameters.threadCount = EB_THREAD_COUNT_MIN_CORE * EB_THREAD_COUNT_FACTOR;
-        printf("\nWarning: the thread count %u is set too small and is forced to the min value %u\n",
-                config->threadCount, callbackData->ebEncParameters.threadCount);
-    } else {
-        callbackData->ebEncParameters.threadCount = (config->threadCount + EB_THREAD_COUNT_MIN_CORE - 1)
-                                                    / EB_THREAD_COUNT_MIN_CORE * EB_THREAD_COUNT_MIN_CORE;
-        if (callbackData->ebEncParameters.threadCount != config->threadCount)
-            printf("\nInformation: the thread count %u is rounded to %u\n",
-                    config->threadCount, callbackData->ebEncParameters.threadCount);
-    }
+    callbackData->ebEncParameters.numaPartition = (uint8_t)config->numaPartition;
+    callbackData->ebEncParameters.hugePages = (uint8_t)config->hugePages;
+    callbackData->ebEncParameters.memoryBudgetMB = config->memoryBudgetMB;
+    callbackData->ebEncParameters.threadCount = config->threadCount;
+    callbackData->ebEncParameters.stagePriority = (uint8_t)config->stagePriority;
+    callbackData->ebEncParameters.lockFreeFifo = (uint8_t)config->lockFreeFifo;
 
     callbackData->ebEncParameters.unrestrictedMotionVector = config->unrestrictedMotionVector;
+    callbackData->ebEncParameters.subPictureReference = (uint8_t)config->subPictureReference;
+    callbackData->ebEncParameters.zeroCopyInput = (uint8_t)config->zeroCopyInput;
+    callbackData->ebEncParameters.inputReleaseCallback = config->zeroCopyInput ? ReleaseZeroCopyFrame : NULL;
     callbackData->ebEncParameters.bitRateReduction = (uint8_t)config->bitRateReduction;
     callbackData->ebEncParameters.improveSharpness = (uint8_t)config->improveSharpness;
     callbackData->ebEncParameters.videoUsabilityInfo = config->videoUsabilityInfo;
@@ -370,7 +448,7 @@ EB_ERRORTYPE AllocateInputBuffers(
 
         EB_APP_MALLOC(uint8_t*, callbackData->inputBufferPool->pBuffer, sizeof(EB_H265_ENC_INPUT), EB_N_PTR, EB_ErrorInsufficientResources);
 
-        if (config->bufferedInput == -1) {
+        if (config->bufferedInput == -1 && !config->zeroCopyInput) {
 
             // Allocate frame buffer for the pBuffer
             AllocateInputBuffer(
@@ -392,6 +470,76 @@ EB_ERRORTYPE AllocateInputBuffers(
 
     return return_error;
 }
+
+/***********************************************
+* Returns a zero-copy frame the encoder has released,
+*  or a new one when the encoder holds all of them.
+*  Planes follow the EB_ZERO_COPY_* layout.
+***********************************************/
+EB_BUFFERHEADERTYPE* GetZeroCopyFrame(
+    EbConfig_t              *config,
+    EbAppContext_t          *callbackData)
+{
+    const EB_COLOR_FORMAT colorFormat = (EB_COLOR_FORMAT)config->encoderColorFormat;
+    const uint8_t subWidthCMinus1 = (colorFormat == EB_YUV444 ? 1 : 2) - 1;
+    const uint8_t subHeightCMinus1 = (colorFormat >= EB_YUV422 ? 1 : 2) - 1;
+    const size_t lumaStride = EB_ZERO_COPY_LUMA_STRIDE(config->sourceWidth);
+    const size_t chromaStride = lumaStride >> subWidthCMinus1;
+    const size_t lumaRows = ((config->sourceHeight + 7) & ~7) + 2 * EB_ZERO_COPY_PADDING;
+    const size_t chromaRows = lumaRows >> subHeightCMinus1;
+    // Keep every plane start aligned
+    const size_t lumaSize = (lumaStride * lumaRows + EB_ZERO_COPY_ALIGNMENT - 1) & ~(size_t)(EB_ZERO_COPY_ALIGNMENT - 1);
+    const size_t chromaSize = (chromaStride * chromaRows + EB_ZERO_COPY_ALIGNMENT - 1) & ~(size_t)(EB_ZERO_COPY_ALIGNMENT - 1);
+    EbAppZeroCopyFrame_t  **framePool;
+    EbAppZeroCopyFrame_t   *framePtr;
+    uint8_t                *planePtr;
+    uint32_t                frameIndex;
+
+    for (frameIndex = 0; frameIndex < callbackData->zeroCopyFrameCount; ++frameIndex) {
+        if (!callbackData->zeroCopyFramePool[frameIndex]->inUse) {
+            callbackData->zeroCopyFramePool[frameIndex]->inUse = 1;
+            return &callbackData->zeroCopyFramePool[frameIndex]->header;
+        }
+    }
+
+    framePool = (EbAppZeroCopyFrame_t**)realloc(callbackData->zeroCopyFramePool, sizeof(EbAppZeroCopyFrame_t*) * (callbackData->zeroCopyFrameCount + 1));
+    if (framePool == NULL)
+        return NULL;
+    callbackData->zeroCopyFramePool = framePool;
+
+    framePtr = (EbAppZeroCopyFrame_t*)calloc(1, sizeof(EbAppZeroCopyFrame_t));
+    if (framePtr == NULL)
+        return NULL;
+    framePtr->frameBuffer = (uint8_t*)malloc(lumaSize + 2 * chromaSize + EB_ZERO_COPY_ALIGNMENT);
+    if (framePtr->frameBuffer == NULL) {
+        free(framePtr);
+        return NULL;
+    }
+    if (callbackData->ebEncParameters.segmentOvEnabled) {
+        size_t lcuTotalCount = ((config->sourceWidth + EB_SEGMENT_BLOCK_SIZE - 1) / EB_SEGMENT_BLOCK_SIZE) * ((config->sourceHeight + EB_SEGMENT_BLOCK_SIZE - 1) / EB_SEGMENT_BLOCK_SIZE);
+        framePtr->header.segmentOvPtr = (SegmentOverride_t*)malloc(sizeof(SegmentOverride_t) * lcuTotalCount);
+    }
+    if (config->dolbyVisionProfile == 81 && config->dolbyVisionRpuFile)
+        framePtr->input.dolbyVisionRpu.payload = (uint8_t*)malloc(1024);
+
+    planePtr = (uint8_t*)(((size_t)framePtr->frameBuffer + EB_ZERO_COPY_ALIGNMENT - 1) & ~(size_t)(EB_ZERO_COPY_ALIGNMENT - 1));
+    framePtr->input.yStride  = (uint32_t)lumaStride;
+    framePtr->input.cbStride = (uint32_t)chromaStride;
+    framePtr->input.crStride = (uint32_t)chromaStride;
+    framePtr->input.luma = planePtr + lumaStride * EB_ZERO_COPY_PADDING + EB_ZERO_COPY_PADDING;
+    framePtr->input.cb   = planePtr + lumaSize + chromaStride * (EB_ZERO_COPY_PADDING >> subHeightCMinus1) + (EB_ZERO_COPY_PADDING >> subWidthCMinus1);
+    framePtr->input.cr   = planePtr + lumaSize + chromaSize + chromaStride * (EB_ZERO_COPY_PADDING >> subHeightCMinus1) + (EB_ZERO_COPY_PADDING >> subWidthCMinus1);
+
+    framePtr->header.nSize = sizeof(EB_BUFFERHEADERTYPE);
+    framePtr->header.pBuffer = (uint8_t*)&framePtr->input;
+    framePtr->header.sliceType = EB_INVALID_PICTURE;
+    framePtr->inUse = 1;
+
+    callbackData->zeroCopyFramePool[callbackData->zeroCopyFrameCount++] = framePtr;
+
+    return &framePtr->header;
+}
+
 EB_ERRORTYPE AllocateOutputReconBuffers(
     EbConfig_t				*config,
     EbAppContext_t			*callbackData)
@@ -417,28 +565,6 @@ EB_ERRORTYPE AllocateOutputReconBuffers(
     return return_error;
 }
 
-EB_ERRORTYPE AllocateOutputBuffers(
-    EbConfig_t				*config,
-    EbAppContext_t			*callbackData)
-{
-
-    EB_ERRORTYPE   return_error = EB_ErrorNone;
-    uint32_t		   outputStreamBufferSize = (uint32_t)(EB_OUTPUTSTREAMBUFFERSIZE_MACRO(config->inputPaddedHeight * config->inputPaddedWidth));;
-    {
-        EB_APP_MALLOC(EB_BUFFERHEADERTYPE*, callbackData->streamBufferPool, sizeof(EB_BUFFERHEADERTYPE), EB_N_PTR, EB_ErrorInsufficientResources);
-
-        // Initialize Header
-        callbackData->streamBufferPool->nSize = sizeof(EB_BUFFERHEADERTYPE);
-
-        EB_APP_MALLOC(uint8_t*, callbackData->streamBufferPool->pBuffer, outputStreamBufferSize, EB_N_PTR, EB_ErrorInsufficientResources);
-
-        callbackData->streamBufferPool->nAllocLen = outputStreamBufferSize;
-        callbackData->streamBufferPool->pAppPrivate = NULL;
-        callbackData->streamBufferPool->sliceType = EB_INVALID_PICTURE;
-    }
-    return return_error;
-}
-
 EB_ERRORTYPE PreloadFramesIntoRam(
     EbConfig_t				*config)
 {
@@ -618,8 +744,16 @@ EB_ERRORTYPE InitEncoder(
 {
     EB_ERRORTYPE        return_error = EB_ErrorNone;
 
+    callbackData->zeroCopyFramePool = NULL;
+    callbackData->zeroCopyFrameCount = 0;
+    callbackData->rcStatsFile = NULL;
+    callbackData->rcStatsIn = NULL;
+
     // Allocate a memory table hosting all allocated pointers
-    AllocateMemoryTable(instanceIdx);
+    return_error = AllocateMemoryTable(callbackData);
+    if (return_error != EB_ErrorNone) {
+        return return_error;
+    }
 
     ///************************* LIBRARY INIT [START] *********************///
     // STEP 1: Call the library to construct a Component Handle
@@ -639,6 +773,14 @@ EB_ERRORTYPE InitEncoder(
         return return_error;
     }
 
+    return_error = OpenRcStatsFile(
+                    config,
+                    callbackData);
+
+    if (return_error != EB_ErrorNone) {
+        return return_error;
+    }
+
     // STEP 4: Send over all configuration parameters
     // Set the Parameters
     return_error = EbH265EncSetParameter(
@@ -652,6 +794,11 @@ EB_ERRORTYPE InitEncoder(
     // STEP 5: Init Encoder
     return_error = EbInitEncoder(callbackData->svtEncoderHandle);
 
+    // The encoder is done with the first pass statistics once initialized
+    free(callbackData->rcStatsIn);
+    callbackData->rcStatsIn = NULL;
+    callbackData->ebEncParameters.rcStatsIn = NULL;
+
     ///************************* LIBRARY INIT [END] *********************///
 
     ///********************** APPLICATION INIT [START] ******************///
@@ -665,16 +812,7 @@ EB_ERRORTYPE InitEncoder(
         return return_error;
     }
 
-    // STEP 7: Allocate output buffers carrying the bitstream out
-    return_error = AllocateOutputBuffers(
-        config,
-        callbackData);
-
-    if (return_error != EB_ErrorNone) {
-        return return_error;
-    }
-
-    // STEP 8: Allocate output Recon Buffer
+    // STEP 7: Allocate output Recon Buffer
     return_error = AllocateOutputReconBuffers(
         config,
         callbackData);
@@ -714,6 +852,7 @@ EB_ERRORTYPE DeInitEncoder(
     EB_ERRORTYPE return_error = EB_ErrorNone;
     int32_t              ptrIndex        = 0;
     EbMemoryMapEntry*   memoryEntry     = (EbMemoryMapEntry*)0;
+    (void)instanceIndex;
 
     if (((EB_COMPONENTTYPE*)(callbackDataPtr->svtEncoderHandle)) != NULL) {
             return_error = EbDeinitEncoder(callbackDataPtr->svtEncoderHandle);
@@ -725,8 +864,8 @@ EB_ERRORTYPE DeInitEncoder(
     }
 
     // Loop through the ptr table and free all malloc'd pointers per channel
-    for (ptrIndex = appMemoryMapIndexAllChannels[instanceIndex] - 1; ptrIndex >= 0; --ptrIndex) {
-        memoryEntry = &appMemoryMapAllChannels[instanceIndex][ptrIndex];
+    for (ptrIndex = callbackDataPtr->appMemoryMapIndex - 1; ptrIndex >= 0; --ptrIndex) {
+        memoryEntry = &callbackDataPtr->appMemoryMap[ptrIndex];
         switch (memoryEntry->ptrType) {
         case EB_N_PTR:
             free(memoryEntry->ptr);
@@ -736,7 +875,20 @@ EB_ERRORTYPE DeInitEncoder(
             break;
         }
     }
-    free(appMemoryMapAllChannels[instanceIndex]);
+    free(callbackDataPtr->appMemoryMap);
+
+    // Free the zero-copy frames, the encoder has released them all
+    for (ptrIndex = 0; ptrIndex < (int32_t)callbackDataPtr->zeroCopyFrameCount; ++ptrIndex) {
+        free(callbackDataPtr->zeroCopyFramePool[ptrIndex]->header.segmentOvPtr);
+        free(callbackDataPtr->zeroCopyFramePool[ptrIndex]->input.dolbyVisionRpu.payload);
+        free(callbackDataPtr->zeroCopyFramePool[ptrIndex]->frameBuffer);
+        free(callbackDataPtr->zeroCopyFramePool[ptrIndex]);
+    }
+    free(callbackDataPtr->zeroCopyFramePool);
+
+    if (callbackDataPtr->rcStatsFile) {
+        fclose(callbackDataPtr->rcStatsFile);
+    }
 
     // Destruct the component
     EbDeinitHandle(callbackDataPtr->svtEncoderHandle);
@@ -9,6 +9,19 @@
 #include "EbApi.h"
 #include "EbAppConfig.h"
 
+/***************************************
+ * Zero-copy input frame
+ *  header comes first so the release
+ *  callback can map it back to the frame
+ ***************************************/
+typedef struct EbAppZeroCopyFrame_s {
+    EB_BUFFERHEADERTYPE                 header;
+    EB_H265_ENC_INPUT                   input;
+    uint8_t                            *frameBuffer;
+    volatile int32_t                    inUse;
+
+} EbAppZeroCopyFrame_t;
+
 /***************************************
 
  * App Callback data struct
@@ -27,9 +40,21 @@ typedef struct EbAppContext_s {
 
     // Buffer Pools
     EB_BUFFERHEADERTYPE                *inputBufferPool;
-    EB_BUFFERHEADERTYPE                *streamBufferPool;
     EB_BUFFERHEADERTYPE                *reconBuffer;
 
+    // Zero-copy input frames, grown until the encoder holds as many as it needs
+    EbAppZeroCopyFrame_t              **zeroCopyFramePool;
+    uint32_t                            zeroCopyFrameCount;
+
+    // Two-pass rate control statistics
+    FILE                               *rcStatsFile;
+    EB_H265_RC_STATS                   *rcStatsIn;
+
+    // Memory table hosting all pointers allocated for the instance
+    EbMemoryMapEntry                   *appMemoryMap;
+    uint32_t                            appMemoryMapIndex;
+    uint64_t                            appMemoryMallocd;
+
 	// Instance Index
 	uint8_t								instanceIdx;
 
@@ -41,5 +66,6 @@ typedef struct EbAppContext_s {
  ********************************/
 extern EB_ERRORTYPE InitEncoder(EbConfig_t *config, EbAppContext_t *callbackData, uint32_t instanceIdx);
 extern EB_ERRORTYPE DeInitEncoder(EbAppContext_t *callbackDataPtr, uint32_t instanceIndex);
+extern EB_BUFFERHEADERTYPE* GetZeroCopyFrame(EbConfig_t *config, EbAppContext_t *callbackData);
 
 #endif // EbAppContext_h
\ No newline at end of file
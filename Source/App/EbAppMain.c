@@ -7,10 +7,12 @@
 //  -Contructs the following resources needed during the encoding process
 //      -memory
 //      -threads
-//      -semaphores
-//      -semaphores
 //  -Configures the encoder
-//  -Calls the encoder via the API
+//  -Calls the encoder via the API, every channel is driven by its own threads:
+//      -input thread reads the frames and sends them, it blocks in
+//       EbH265EncSendPicture once the encoder input buffers are all in use
+//      -output thread blocks in EbH265GetPacket and writes the packets
+//      -recon thread writes the recon pictures when a recon file is set
 //  -Destructs the resources
 
 /***************************************
@@ -26,7 +28,6 @@
 #include <windows.h>
 #else
 #include <pthread.h>
-#include <semaphore.h>
 #include <time.h>
 #include <errno.h>
 #endif
@@ -35,6 +36,15 @@
 #include <io.h>     /* _setmode() */
 #include <fcntl.h>  /* _O_BINARY */
 #endif
+
+#ifdef _WIN32
+typedef HANDLE                  AppThreadHandle;
+#define APP_THREAD_RETURN       DWORD WINAPI
+#else
+typedef pthread_t               AppThreadHandle;
+#define APP_THREAD_RETURN       void*
+#endif
+
 /***************************************
  * External Functions
  ***************************************/
@@ -51,6 +61,29 @@ extern APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
     EbAppContext_t         *appCallBack,
     uint8_t           picSendDone);
 
+extern void SendInputEndOfStream(
+    EbAppContext_t         *appCallBack);
+
+/***************************************
+ * Channel threads and their state
+ ***************************************/
+typedef struct EbAppChannel_s {
+    EbConfig_t             *config;
+    EbAppContext_t         *appCallback;
+
+    APPEXITCONDITIONTYPE    exitConditionInput;
+    APPEXITCONDITIONTYPE    exitConditionOutput;
+    APPEXITCONDITIONTYPE    exitConditionRecon;
+
+    AppThreadHandle         inputThread;
+    AppThreadHandle         outputThread;
+    AppThreadHandle         reconThread;
+    EB_BOOL                 inputThreadActive;
+    EB_BOOL                 outputThreadActive;
+    EB_BOOL                 reconThreadActive;
+
+} EbAppChannel_t;
+
 volatile int32_t keepRunning = 1;
 
 void EventHandler(int32_t dummy) {
@@ -75,6 +108,117 @@ void AssignAppThreadGroup(uint8_t targetSocket) {
 #endif
 }
 
+static EB_BOOL AppCreateThread(
+    AppThreadHandle    *threadHandle,
+    APP_THREAD_RETURN (*threadFunction)(void*),
+    void               *threadContext)
+{
+#ifdef _WIN32
+    *threadHandle = CreateThread(NULL, 0, threadFunction, threadContext, 0, NULL);
+    return (*threadHandle != NULL) ? EB_TRUE : EB_FALSE;
+#else
+    return (pthread_create(threadHandle, NULL, threadFunction, threadContext) == 0) ? EB_TRUE : EB_FALSE;
+#endif
+}
+
+static void AppJoinThread(
+    AppThreadHandle     threadHandle)
+{
+#ifdef _WIN32
+    WaitForSingleObject(threadHandle, INFINITE);
+    CloseHandle(threadHandle);
+#else
+    pthread_join(threadHandle, NULL);
+#endif
+}
+
+/***************************************
+ * Input thread
+ *  Reads and sends frames until the EOS is sent
+ ***************************************/
+static APP_THREAD_RETURN ChannelInputThread(void *inputPtr)
+{
+    EbAppChannel_t *channelPtr = (EbAppChannel_t*)inputPtr;
+
+    if (channelPtr->config->targetSocket != -1)
+        AssignAppThreadGroup(channelPtr->config->targetSocket);
+
+    while (channelPtr->exitConditionInput == APP_ExitConditionNone) {
+        channelPtr->exitConditionInput = ProcessInputBuffer(
+            channelPtr->config,
+            channelPtr->appCallback);
+    }
+
+    // Still flush the encoder so that the output thread reaches the EOS
+    if (channelPtr->exitConditionInput == APP_ExitConditionError)
+        SendInputEndOfStream(channelPtr->appCallback);
+
+    return 0;
+}
+
+/***************************************
+ * Output thread
+ *  Waits for packets until the EOS packet
+ ***************************************/
+static APP_THREAD_RETURN ChannelOutputThread(void *inputPtr)
+{
+    EbAppChannel_t      *channelPtr = (EbAppChannel_t*)inputPtr;
+    EB_BUFFERHEADERTYPE *headerPtr;
+    uint32_t             flags;
+
+    if (channelPtr->config->targetSocket != -1)
+        AssignAppThreadGroup(channelPtr->config->targetSocket);
+
+    while (channelPtr->exitConditionOutput == APP_ExitConditionNone) {
+        channelPtr->exitConditionOutput = ProcessOutputStreamBuffer(
+            channelPtr->config,
+            channelPtr->appCallback,
+            1);
+    }
+
+    // Keep releasing the packets so that the input thread is not left blocked
+    if (channelPtr->exitConditionOutput == APP_ExitConditionError &&
+        channelPtr->appCallback->outputStreamPortActive == APP_PortActive) {
+        do {
+            EbH265GetPacket(channelPtr->appCallback->svtEncoderHandle, &headerPtr, 1);
+            flags = headerPtr->nFlags;
+            EbH265ReleaseOutBuffer(&headerPtr);
+        } while (!(flags & EB_BUFFERFLAG_EOS));
+    }
+
+    return 0;
+}
+
+/***************************************
+ * Recon thread
+ *  Writes recon pictures until the EOS recon
+ ***************************************/
+static APP_THREAD_RETURN ChannelReconThread(void *inputPtr)
+{
+    EbAppChannel_t *channelPtr = (EbAppChannel_t*)inputPtr;
+    EB_ERRORTYPE    recon_status;
+
+    if (channelPtr->config->targetSocket != -1)
+        AssignAppThreadGroup(channelPtr->config->targetSocket);
+
+    while (channelPtr->exitConditionRecon == APP_ExitConditionNone) {
+        channelPtr->exitConditionRecon = ProcessOutputReconBuffer(
+            channelPtr->config,
+            channelPtr->appCallback);
+    }
+
+    // Keep taking the recon pictures so that the encoder does not stall on them
+    if (channelPtr->exitConditionRecon == APP_ExitConditionError) {
+        do {
+            recon_status = EbH265GetRecon(channelPtr->appCallback->svtEncoderHandle, channelPtr->appCallback->reconBuffer);
+            if (recon_status == EB_NoErrorEmptyQueue)
+                EbSleep(1);
+        } while (recon_status == EB_NoErrorEmptyQueue || !(channelPtr->appCallback->reconBuffer->nFlags & EB_BUFFERFLAG_EOS));
+    }
+
+    return 0;
+}
+
 
 /***************************************
  * Encoder App Main
@@ -90,22 +234,16 @@ int32_t main(int32_t argc, char* argv[])
 #endif
     // GLOBAL VARIABLES
     EB_ERRORTYPE            return_error = EB_ErrorNone;            // Error Handling
-    APPEXITCONDITIONTYPE    exitCondition = APP_ExitConditionNone;    // Processing loop exit condition
 
-    EB_ERRORTYPE            return_errors[MAX_CHANNEL_NUMBER];          // Error Handling
-    APPEXITCONDITIONTYPE    exitConditions[MAX_CHANNEL_NUMBER];          // Processing loop exit condition
-    APPEXITCONDITIONTYPE    exitConditionsOutput[MAX_CHANNEL_NUMBER];         // Processing loop exit condition
-    APPEXITCONDITIONTYPE    exitConditionsRecon[MAX_CHANNEL_NUMBER];         // Processing loop exit condition
-    APPEXITCONDITIONTYPE    exitConditionsInput[MAX_CHANNEL_NUMBER];          // Processing loop exit condition
+    EB_ERRORTYPE           *return_errors;                      // Error Handling
+    APPEXITCONDITIONTYPE   *exitConditions;                     // Processing loop exit condition
 
-
-    EB_BOOL                 channelActive[MAX_CHANNEL_NUMBER];
-
-    EbConfig_t             *configs[MAX_CHANNEL_NUMBER];        // Encoder Configuration
+    EbConfig_t            **configs;                            // Encoder Configuration
 
     uint32_t                numChannels = 0;
     uint32_t                instanceCount=0;
-    EbAppContext_t         *appCallbacks[MAX_CHANNEL_NUMBER];   // Instances App callback data
+    EbAppContext_t        **appCallbacks;                       // Instances App callback data
+    EbAppChannel_t         *channels;                           // Instances threads
     signal(SIGINT, EventHandler);
     printf("-------------------------------------------\n");
     printf("SVT-HEVC Encoder\n");
@@ -115,6 +253,14 @@ int32_t main(int32_t argc, char* argv[])
     if (numChannels == 0)
         return EB_ErrorBadParameter;
 
+    return_errors   = (EB_ERRORTYPE*)calloc(numChannels, sizeof(EB_ERRORTYPE));
+    exitConditions  = (APPEXITCONDITIONTYPE*)calloc(numChannels, sizeof(APPEXITCONDITIONTYPE));
+    configs         = (EbConfig_t**)calloc(numChannels, sizeof(EbConfig_t*));
+    appCallbacks    = (EbAppContext_t**)calloc(numChannels, sizeof(EbAppContext_t*));
+    channels        = (EbAppChannel_t*)calloc(numChannels, sizeof(EbAppChannel_t));
+    if (!return_errors || !exitConditions || !configs || !appCallbacks || !channels)
+        return EB_ErrorInsufficientResources;
+
     // Initialize config
     for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
         configs[instanceCount] = (EbConfig_t*)malloc(sizeof(EbConfig_t));
@@ -131,12 +277,13 @@ int32_t main(int32_t argc, char* argv[])
             return EB_ErrorInsufficientResources;
     }
 
-    for (instanceCount = 0; instanceCount < MAX_CHANNEL_NUMBER; ++instanceCount) {
+    for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
         exitConditions[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
-        exitConditionsOutput[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
-        exitConditionsRecon[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
-        exitConditionsInput[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
-        channelActive[instanceCount] = EB_FALSE;
+        channels[instanceCount].config = configs[instanceCount];
+        channels[instanceCount].appCallback = appCallbacks[instanceCount];
+        channels[instanceCount].exitConditionInput = APP_ExitConditionError;
+        channels[instanceCount].exitConditionOutput = APP_ExitConditionError;
+        channels[instanceCount].exitConditionRecon = APP_ExitConditionError;
     }
 
     // Read all configuration files.
@@ -162,9 +309,6 @@ int32_t main(int32_t argc, char* argv[])
                 return_errors[instanceCount] = InitEncoder(configs[instanceCount], appCallbacks[instanceCount], instanceCount);
                 return_error = (EB_ERRORTYPE)(return_error | return_errors[instanceCount]);
             }
-            else {
-                channelActive[instanceCount] = EB_FALSE;
-            }
         }
 
         {
@@ -172,19 +316,8 @@ int32_t main(int32_t argc, char* argv[])
             for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
                 if (return_errors[instanceCount] == EB_ErrorNone) {
                     return_error = (EB_ERRORTYPE)(return_error & return_errors[instanceCount]);
-                    exitConditions[instanceCount] = APP_ExitConditionNone;
-                    exitConditionsOutput[instanceCount] = APP_ExitConditionNone;
-                    exitConditionsRecon[instanceCount] = configs[instanceCount]->reconFile ? APP_ExitConditionNone : APP_ExitConditionError;
-                    exitConditionsInput[instanceCount] = APP_ExitConditionNone;
-                    channelActive[instanceCount] = EB_TRUE;
                     EbAppStartTime((uint64_t*)&configs[instanceCount]->performanceContext.encodeStartTime[0], (uint64_t*)&configs[instanceCount]->performanceContext.encodeStartTime[1]);
                 }
-                else {
-                    exitConditions[instanceCount] = APP_ExitConditionError;
-                    exitConditionsOutput[instanceCount] = APP_ExitConditionError;
-                    exitConditionsRecon[instanceCount] = APP_ExitConditionError;
-                    exitConditionsInput[instanceCount] = APP_ExitConditionError;
-                }
 
 #if DISPLAY_MEMORY
                 EB_APP_MEMORY();
@@ -193,37 +326,55 @@ int32_t main(int32_t argc, char* argv[])
             printf("Encoding          ");
             fflush(stdout);
 
-            while (exitCondition == APP_ExitConditionNone) {
-                exitCondition = APP_ExitConditionFinished;
-                for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
-                    if (channelActive[instanceCount] == EB_TRUE) {
-                        if (exitConditionsInput[instanceCount] == APP_ExitConditionNone)
-                            exitConditionsInput[instanceCount] = ProcessInputBuffer(
-                                configs[instanceCount],
-                                appCallbacks[instanceCount]);
-                        if (exitConditionsRecon[instanceCount] == APP_ExitConditionNone)
-                            exitConditionsRecon[instanceCount] = ProcessOutputReconBuffer(
-                                configs[instanceCount],
-                                appCallbacks[instanceCount]);
-                        if (exitConditionsOutput[instanceCount] == APP_ExitConditionNone)
-                            exitConditionsOutput[instanceCount] = ProcessOutputStreamBuffer(
-                                configs[instanceCount],
-                                appCallbacks[instanceCount],
-                                (exitConditionsInput[instanceCount] == APP_ExitConditionNone) || (exitConditionsRecon[instanceCount] == APP_ExitConditionNone) ? 0 : 1);
-                        if (((exitConditionsRecon[instanceCount] == APP_ExitConditionFinished || !configs[instanceCount]->reconFile) && exitConditionsOutput[instanceCount] == APP_ExitConditionFinished && exitConditionsInput[instanceCount] == APP_ExitConditionFinished) ||
-                            ((exitConditionsRecon[instanceCount] == APP_ExitConditionError && configs[instanceCount]->reconFile) || exitConditionsOutput[instanceCount] == APP_ExitConditionError || exitConditionsInput[instanceCount] == APP_ExitConditionError)) {
-                            channelActive[instanceCount] = EB_FALSE;
-                            if (configs[instanceCount]->reconFile)
-                                exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsRecon[instanceCount] | exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
-                            else
-                                exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
-                        }
-                    }
+            // The output and recon threads start first, they only wait for the encoder
+            for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
+                EbAppChannel_t *channelPtr = &channels[instanceCount];
+
+                if (return_errors[instanceCount] != EB_ErrorNone)
+                    continue;
+
+                channelPtr->exitConditionOutput = APP_ExitConditionNone;
+                channelPtr->outputThreadActive = AppCreateThread(&channelPtr->outputThread, ChannelOutputThread, channelPtr);
+                if (channelPtr->outputThreadActive == EB_FALSE) {
+                    channelPtr->exitConditionOutput = APP_ExitConditionError;
+                    continue;
+                }
+
+                if (configs[instanceCount]->reconFile) {
+                    channelPtr->exitConditionRecon = APP_ExitConditionNone;
+                    channelPtr->reconThreadActive = AppCreateThread(&channelPtr->reconThread, ChannelReconThread, channelPtr);
+                    if (channelPtr->reconThreadActive == EB_FALSE)
+                        channelPtr->exitConditionRecon = APP_ExitConditionError;
                 }
-                // check if all channels are inactive
-                for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
-                    if (channelActive[instanceCount] == EB_TRUE)
-                        exitCondition = APP_ExitConditionNone;
+
+                if (!configs[instanceCount]->reconFile || channelPtr->reconThreadActive) {
+                    channelPtr->exitConditionInput = APP_ExitConditionNone;
+                    channelPtr->inputThreadActive = AppCreateThread(&channelPtr->inputThread, ChannelInputThread, channelPtr);
+                    if (channelPtr->inputThreadActive == EB_FALSE)
+                        channelPtr->exitConditionInput = APP_ExitConditionError;
+                }
+
+                // Let the output thread reach the EOS when no frame will be sent
+                if (channelPtr->inputThreadActive == EB_FALSE)
+                    SendInputEndOfStream(appCallbacks[instanceCount]);
+            }
+
+            // Wait for all channels to finish
+            for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
+                EbAppChannel_t *channelPtr = &channels[instanceCount];
+
+                if (channelPtr->inputThreadActive)
+                    AppJoinThread(channelPtr->inputThread);
+                if (channelPtr->reconThreadActive)
+                    AppJoinThread(channelPtr->reconThread);
+                if (channelPtr->outputThreadActive)
+                    AppJoinThread(channelPtr->outputThread);
+
+                if (return_errors[instanceCount] == EB_ErrorNone) {
+                    if (configs[instanceCount]->reconFile)
+                        exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(channelPtr->exitConditionRecon | channelPtr->exitConditionOutput | channelPtr->exitConditionInput);
+                    else
+                        exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(channelPtr->exitConditionOutput | channelPtr->exitConditionInput);
                 }
             }
 
@@ -320,6 +471,11 @@ int32_t main(int32_t argc, char* argv[])
         if (appCallbacks[instanceCount])
             free(appCallbacks[instanceCount]);
     }
+    free(channels);
+    free(appCallbacks);
+    free(configs);
+    free(exitConditions);
+    free(return_errors);
 
     printf("Encoder finished\n");
 
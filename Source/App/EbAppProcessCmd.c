@@ -17,6 +17,9 @@
 #include "EbAppInputy4m.h"
 
 #include "EbTime.h"
+#ifdef _WIN32
+#include <windows.h>
+#endif
 /***************************************
  * Macros
  ***************************************/
@@ -26,6 +29,11 @@
 #define FUTURE_WINDOW_WIDTH                 4
 #define SIZE_OF_ONE_FRAME_IN_BYTES(width, height, csp, is16bit) \
     ( (((width)*(height)) + 2*(((width)*(height))>>(3-csp)) )<<is16bit)
+#ifdef _WIN32
+#define APP_ATOMIC_INCREMENT(counter)   InterlockedIncrement((volatile LONG*)(counter))
+#else
+#define APP_ATOMIC_INCREMENT(counter)   __sync_add_and_fetch((counter), 1)
+#endif
 extern volatile int32_t keepRunning;
 
 /***************************************
@@ -695,16 +703,13 @@ void ProcessInputFieldStandardMode(
 // Input  : QP file
 // Output : QP value
 /************************************/
-static int32_t qpReadFromFile = 0;
-
 int32_t GetNextQpFromQpFile(
     EbConfig_t  *config
 )
 {
-    uint8_t *line;
+    uint8_t line[8];
     int32_t qp = 0;
     uint32_t readsize = 0, eof = 0;
-    EB_APP_MALLOC(uint8_t*, line, 8, EB_N_PTR, EB_ErrorInsufficientResources);
     memset(line,0,8);
     readsize = (uint32_t)fread(line, 1, 2, config->qpFile);
 
@@ -752,7 +757,7 @@ int32_t GetNextQpFromQpFile(
     }
 
     if (qp > 0)
-        qpReadFromFile |= 1;
+        config->qpReadFromFile = EB_TRUE;
 
     return qp;
 }
@@ -943,20 +948,15 @@ void SendQpOnTheFly(
             // get next qp
             tmpQp = GetNextQpFromQpFile(config);
 
-            if (tmpQp == (int32_t)EB_ErrorInsufficientResources) {
-                printf("Malloc has failed due to insuffucient resources");
-                return;
-            }
-
             // check if eof
-            if ((tmpQp == -1) && (qpReadFromFile != 0))
+            if ((tmpQp == -1) && config->qpReadFromFile)
                 fseek(config->qpFile, 0, SEEK_SET);
 
             // check if the qp read is valid
             else if (tmpQp > 0)
                 break;
 
-        } while (tmpQp == 0 || ((tmpQp == -1) && (qpReadFromFile != 0)));
+        } while (tmpQp == 0 || ((tmpQp == -1) && config->qpReadFromFile));
 
         if (tmpQp == -1) {
             config->useQpFile = EB_FALSE;
@@ -1202,6 +1202,122 @@ int ParseDolbyVisionRPUMetadata(
 
 }
 
+/************************************
+ * Read one plane row by row into a
+ * strided zero-copy frame
+ ************************************/
+static uint32_t ReadZeroCopyPlane(
+    FILE        *inputFile,
+    uint8_t     *planePtr,
+    uint32_t     stride,
+    uint32_t     width,
+    uint32_t     height)
+{
+    uint32_t filledLen = 0;
+    uint32_t rowIndex;
+
+    for (rowIndex = 0; rowIndex < height; ++rowIndex)
+        filledLen += (uint32_t)fread(planePtr + (size_t)stride * rowIndex, 1, width, inputFile);
+
+    return filledLen;
+}
+
+/************************************
+ * Read a frame into the padded planes
+ * of a zero-copy frame (8-bit only)
+ ************************************/
+static void ReadZeroCopyFrame(
+    EbConfig_t                  *config,
+    EB_BUFFERHEADERTYPE         *headerPtr)
+{
+    EB_H265_ENC_INPUT  *inputPtr = (EB_H265_ENC_INPUT*)headerPtr->pBuffer;
+    FILE               *inputFile = config->inputFile;
+    const EB_COLOR_FORMAT colorFormat = (EB_COLOR_FORMAT)config->encoderColorFormat;
+    const uint8_t subWidthCMinus1 = (colorFormat == EB_YUV444 ? 1 : 2) - 1;
+    const uint8_t subHeightCMinus1 = (colorFormat >= EB_YUV422 ? 1 : 2) - 1;
+    const uint32_t lumaWidth = config->inputPaddedWidth;
+    const uint32_t lumaHeight = config->inputPaddedHeight;
+    const uint32_t readSize = SIZE_OF_ONE_FRAME_IN_BYTES(lumaWidth, lumaHeight, colorFormat, 0);
+    uint32_t firstRow = 0;
+
+    inputPtr->dolbyVisionRpu.payloadSize = 0;
+    headerPtr->nFilledLen = 0;
+
+    /* if input is a y4m file, read next line which contains "FRAME" */
+    if (config->y4m_input == EB_TRUE)
+        read_y4m_frame_delimiter(config);
+
+    if (config->y4m_input == EB_FALSE && config->processedFrameCount == 0 && config->inputFile == stdin) {
+        /* 9 bytes of the first row were already read when checking for the YUV4MPEG2 string */
+        memcpy(inputPtr->luma, config->y4m_buf, YUV4MPEG2_IND_SIZE);
+        headerPtr->nFilledLen += YUV4MPEG2_IND_SIZE;
+        headerPtr->nFilledLen += (uint32_t)fread(inputPtr->luma + YUV4MPEG2_IND_SIZE, 1, lumaWidth - YUV4MPEG2_IND_SIZE, inputFile);
+        firstRow = 1;
+    }
+
+    headerPtr->nFilledLen += ReadZeroCopyPlane(inputFile, inputPtr->luma + (size_t)inputPtr->yStride * firstRow, inputPtr->yStride, lumaWidth, lumaHeight - firstRow);
+    headerPtr->nFilledLen += ReadZeroCopyPlane(inputFile, inputPtr->cb, inputPtr->cbStride, lumaWidth >> subWidthCMinus1, lumaHeight >> subHeightCMinus1);
+    headerPtr->nFilledLen += ReadZeroCopyPlane(inputFile, inputPtr->cr, inputPtr->crStride, lumaWidth >> subWidthCMinus1, lumaHeight >> subHeightCMinus1);
+
+    if (readSize != headerPtr->nFilledLen) {
+
+        fseek(inputFile, 0, SEEK_SET);
+        headerPtr->nFilledLen = 0;
+        headerPtr->nFilledLen += ReadZeroCopyPlane(inputFile, inputPtr->luma, inputPtr->yStride, lumaWidth, lumaHeight);
+        headerPtr->nFilledLen += ReadZeroCopyPlane(inputFile, inputPtr->cb, inputPtr->cbStride, lumaWidth >> subWidthCMinus1, lumaHeight >> subHeightCMinus1);
+        headerPtr->nFilledLen += ReadZeroCopyPlane(inputFile, inputPtr->cr, inputPtr->crStride, lumaWidth >> subWidthCMinus1, lumaHeight >> subHeightCMinus1);
+    }
+}
+
+//************************************/
+// SendInputEndOfStream
+// Signals the end of the input, the
+// encoder then flushes all pictures
+/************************************/
+void SendInputEndOfStream(EbAppContext_t *appCallBack)
+{
+    // The last frame may still be referenced by the encoder
+    EB_BUFFERHEADERTYPE *headerPtr = appCallBack->inputBufferPool;
+
+    headerPtr->nAllocLen    = 0;
+    headerPtr->nFilledLen   = 0;
+    headerPtr->nTickCount   = 0;
+    headerPtr->pAppPrivate  = NULL;
+    headerPtr->nFlags       = EB_BUFFERFLAG_EOS;
+    headerPtr->pBuffer      = NULL;
+    headerPtr->sliceType    = EB_INVALID_PICTURE;
+
+    EbH265EncSendPicture((EB_COMPONENTTYPE*)appCallBack->svtEncoderHandle, headerPtr);
+}
+
+//************************************/
+// SendParameterUpdate
+// Applies the UpdateTargetBitRate and
+// UpdateEncoderMode settings from the
+// next picture sent on
+/************************************/
+static void SendParameterUpdate(
+    EbConfig_t                  *config,
+    EB_COMPONENTTYPE            *componentHandle)
+{
+    EB_H265_ENC_UPDATE update;
+
+    memset(&update, 0, sizeof(update));
+
+    if (config->updateTargetBitRate) {
+        update.updateFlags |= EB_ENC_UPDATE_TARGET_BIT_RATE;
+        update.targetBitRate = config->updateTargetBitRate;
+    }
+
+    if (config->updateEncMode != -1) {
+        update.updateFlags |= EB_ENC_UPDATE_ENC_MODE;
+        update.encMode = (uint8_t)config->updateEncMode;
+    }
+
+    if (EbH265EncUpdateParameter(componentHandle, &update) != EB_ErrorNone)
+        printf("\nSVT [Warning]: Parameter update at frame %" PRIu64 " rejected", config->updateFrame);
+}
+
 //************************************/
 // ProcessInputBuffer
 // Reads yuv frames from file and copy
@@ -1239,10 +1355,22 @@ APPEXITCONDITIONTYPE ProcessInputBuffer(EbConfig_t *config, EbAppContext_t *appC
 
     // If there are bytes left to encode, configure the header
     if (remainingByteCount != 0 && config->stopEncoder == EB_FALSE) {
-        ReadInputFrames(
-            config,
-            is16bit,
-            headerPtr);
+        if (config->zeroCopyInput) {
+            // Reuse a frame the encoder released, or add one to the pool
+            headerPtr = GetZeroCopyFrame(config, appCallBack);
+            if (headerPtr == NULL)
+                return APP_ExitConditionError;
+
+            ReadZeroCopyFrame(
+                config,
+                headerPtr);
+        }
+        else {
+            ReadInputFrames(
+                config,
+                is16bit,
+                headerPtr);
+        }
 
         // Update the context parameters
         config->processedByteCount += headerPtr->nFilledLen;
@@ -1285,25 +1413,20 @@ APPEXITCONDITIONTYPE ProcessInputBuffer(EbConfig_t *config, EbAppContext_t *appC
                 config,
                 headerPtr);
 
+        // Configuration parameters changed on the fly
+        if (config->updateFrame && config->processedFrameCount - 1 == config->updateFrame)
+            SendParameterUpdate(
+                config,
+                componentHandle);
+
         // Send the picture
         EbH265EncSendPicture(componentHandle, headerPtr);
 
         if ((config->processedFrameCount == (uint64_t)config->framesToBeEncoded) || config->stopEncoder) {
-
-            headerPtr->nAllocLen    = 0;
-            headerPtr->nFilledLen   = 0;
-            headerPtr->nTickCount   = 0;
-            headerPtr->pAppPrivate  = NULL;
-            headerPtr->nFlags       = EB_BUFFERFLAG_EOS;
-            headerPtr->pBuffer      = NULL;
-            headerPtr->sliceType    = EB_INVALID_PICTURE;
-
-            EbH265EncSendPicture(componentHandle, headerPtr);
-
+            SendInputEndOfStream(appCallBack);
+            return_value = APP_ExitConditionFinished;
         }
 
-        return_value = (headerPtr->nFlags == EB_BUFFERFLAG_EOS) ? APP_ExitConditionFinished : return_value;
-
     }
 
     return return_value;
@@ -1329,14 +1452,15 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
     uint64_t              *totalLatency     = &config->performanceContext.totalLatency;
     uint32_t              *maxLatency       = &config->performanceContext.maxLatency;
 
-    // System performance variables
-    static int32_t         frameCount       = 0;
+    // System performance variables, shared by the output threads of all channels
+    static volatile int32_t totalFrameCount = 0;
+    int32_t                frameCount;
 
     // Local variables
     uint64_t               finishsTime      = 0;
     uint64_t               finishuTime      = 0;
 
-    // non-blocking call until all input frames are sent
+    // blocks until a packet is ready once picSendDone is set
     stream_status = EbH265GetPacket(componentHandle, &headerPtr, picSendDone);
 
     if (stream_status == EB_ErrorMax) {
@@ -1347,6 +1471,9 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
         return APP_ExitConditionError;
     }
     else if (stream_status != EB_NoErrorEmptyQueue) {
+        // Update Output Port Activity State
+        *portState = (headerPtr->nFlags & EB_BUFFERFLAG_EOS) ? APP_PortInactive : *portState;
+
         ++(config->performanceContext.frameCount);
         *totalLatency += (uint64_t)headerPtr->nTickCount;
         *maxLatency = (headerPtr->nTickCount > *maxLatency) ? headerPtr->nTickCount : *maxLatency;
@@ -1389,19 +1516,15 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
             }
             config->performanceContext.byteCount += outputStreamBuffer->nFilledLen;
         }
-        // Update Output Port Activity State
-        *portState = (headerPtr->nFlags & EB_BUFFERFLAG_EOS) ? APP_PortInactive : *portState;
         return_value = (headerPtr->nFlags & EB_BUFFERFLAG_EOS) ? APP_ExitConditionFinished : APP_ExitConditionNone;
 
         // Release the output buffer
         if (stream_status != EB_NoErrorEmptyQueue)
             EbH265ReleaseOutBuffer(&headerPtr);
 
-#if DEADLOCK_DEBUG
-        ++frameCount;
-#else
-        //++frameCount;
-        printf("\b\b\b\b\b\b\b\b\b%9d", ++frameCount);
+        frameCount = APP_ATOMIC_INCREMENT(&totalFrameCount);
+#if !DEADLOCK_DEBUG
+        printf("\b\b\b\b\b\b\b\b\b%9d", frameCount);
 #endif
 
         //++frameCount;
@@ -1431,7 +1554,7 @@ APPEXITCONDITIONTYPE ProcessOutputReconBuffer(
     APPEXITCONDITIONTYPE    return_value = APP_ExitConditionNone;
     EB_ERRORTYPE            recon_status = EB_ErrorNone;
     int32_t fseekReturnVal;
-    // non-blocking call until all input frames are sent
+    // non-blocking call, there is no blocking recon API
     recon_status = EbH265GetRecon(componentHandle, headerPtr);
 
     if (recon_status == EB_ErrorMax) {
@@ -1460,5 +1583,9 @@ APPEXITCONDITIONTYPE ProcessOutputReconBuffer(
         // Update Output Port Activity State
         return_value = (headerPtr->nFlags & EB_BUFFERFLAG_EOS) ? APP_ExitConditionFinished : APP_ExitConditionNone;
     }
+    else {
+        // Nothing ready, wait rather than spin the recon thread
+        EbSleep(1);
+    }
     return return_value;
 }
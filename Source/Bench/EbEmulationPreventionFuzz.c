@@ -0,0 +1,148 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// EbEmulationPreventionFuzz
+//  -Checks InsertEmulationPrevention_AVX2_INTRIN against InsertEmulationPrevention_C
+//  -Buffers are random with most bytes in 0x00-0x03, so that zero runs and
+//   emulation prevention bytes are frequent, and are read and written at
+//   random offsets with random read and write limits
+//  -Returns non-zero on the first mismatch
+//
+// Usage: SvtHevcEmulationPreventionFuzz [iterations] [seed]
+
+/***************************************
+ * Includes
+ ***************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "EbDefinitions.h"
+#include "EbBitstreamUnit_C.h"
+#include "EbBitstreamUnit_Intrinsic_AVX2.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#define EP_FUZZ_DEFAULT_ITERATIONS      200000
+#define EP_FUZZ_MAX_READ_SIZE           512
+#define EP_FUZZ_MAX_WRITE_SIZE          (EP_FUZZ_MAX_READ_SIZE * 3 / 2 + 8)
+
+static EB_U32 fuzzState;
+
+/***************************************
+ * xorshift32
+ ***************************************/
+static EB_U32 FuzzRandom(void)
+{
+    fuzzState ^= fuzzState << 13;
+    fuzzState ^= fuzzState >> 17;
+    fuzzState ^= fuzzState << 5;
+    return fuzzState;
+}
+
+static int FuzzCpuSupportsAvx2(void)
+{
+#ifdef _MSC_VER
+    int cpuInfo[4];
+    __cpuidex(cpuInfo, 1, 0);
+    // OSXSAVE and AVX, YMM state enabled by the OS
+    if ((cpuInfo[2] & 0x18000000) != 0x18000000 || (_xgetbv(0) & 6) != 6) {
+        return 0;
+    }
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & 0x20) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static void FuzzFillBuffer(EB_U8 *bufferPtr, EB_U32 size)
+{
+    EB_U32 mode = FuzzRandom() & 3;
+    EB_U32 index;
+
+    for (index = 0; index < size; ++index) {
+        EB_U32 value = FuzzRandom();
+        switch (mode) {
+        case 0:  bufferPtr[index] = (EB_U8)value;                                    break;
+        case 1:  bufferPtr[index] = (EB_U8)(value & 3);                              break;
+        case 2:  bufferPtr[index] = (value & 0x700) ? 0 : (EB_U8)value;              break;
+        default: bufferPtr[index] = (value & 0x300) ? (EB_U8)(value & 3) : (EB_U8)value; break;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    EB_U32  iterationCount = (argc > 1) ? (EB_U32)strtoul(argv[1], NULL, 0) : EP_FUZZ_DEFAULT_ITERATIONS;
+    EB_U32  iteration;
+    EB_U8   readBuffer[EP_FUZZ_MAX_READ_SIZE];
+    EB_U8   writeBufferC[EP_FUZZ_MAX_WRITE_SIZE];
+    EB_U8   writeBufferAvx2[EP_FUZZ_MAX_WRITE_SIZE];
+
+    fuzzState = (argc > 2) ? (EB_U32)strtoul(argv[2], NULL, 0) : 0x2545F491;
+    if (fuzzState == 0) {
+        fuzzState = 1;
+    }
+
+    if (!FuzzCpuSupportsAvx2()) {
+        printf("AVX2 is not supported, nothing to check\n");
+        return 0;
+    }
+
+    for (iteration = 0; iteration < iterationCount; ++iteration) {
+        EB_U32 readStart     = FuzzRandom() % EP_FUZZ_MAX_READ_SIZE;
+        EB_U32 readEnd       = readStart + FuzzRandom() % (EP_FUZZ_MAX_READ_SIZE - readStart + 1);
+        EB_U32 writeStart    = FuzzRandom() % 64;
+        // The kernels may write two bytes past writeEnd
+        EB_U32 writeEnd      = writeStart + FuzzRandom() % (EP_FUZZ_MAX_WRITE_SIZE - 2 - writeStart + 1);
+        EB_U32 zeroCount     = FuzzRandom() % 3;
+        EB_U32 readIndexC    = readStart;
+        EB_U32 writeIndexC   = writeStart;
+        EB_U32 zeroCountC    = zeroCount;
+        EB_U32 readIndexAvx2 = readStart;
+        EB_U32 writeIndexAvx2 = writeStart;
+        EB_U32 zeroCountAvx2 = zeroCount;
+
+        FuzzFillBuffer(readBuffer, EP_FUZZ_MAX_READ_SIZE);
+        memset(writeBufferC, 0xAA, EP_FUZZ_MAX_WRITE_SIZE);
+        memset(writeBufferAvx2, 0xAA, EP_FUZZ_MAX_WRITE_SIZE);
+
+        InsertEmulationPrevention_C(
+            readBuffer,
+            &readIndexC,
+            readEnd,
+            writeBufferC,
+            &writeIndexC,
+            writeEnd,
+            &zeroCountC);
+
+        InsertEmulationPrevention_AVX2_INTRIN(
+            readBuffer,
+            &readIndexAvx2,
+            readEnd,
+            writeBufferAvx2,
+            &writeIndexAvx2,
+            writeEnd,
+            &zeroCountAvx2);
+
+        if (readIndexC != readIndexAvx2 ||
+            writeIndexC != writeIndexAvx2 ||
+            zeroCountC != zeroCountAvx2 ||
+            memcmp(writeBufferC, writeBufferAvx2, writeIndexC) != 0) {
+
+            printf("Mismatch at iteration %u: read [%u, %u) write [%u, %u) zeros %u\n",
+                iteration, readStart, readEnd, writeStart, writeEnd, zeroCount);
+            printf("  C:    read %u write %u zeros %u\n", readIndexC, writeIndexC, zeroCountC);
+            printf("  AVX2: read %u write %u zeros %u\n", readIndexAvx2, writeIndexAvx2, zeroCountAvx2);
+            return 1;
+        }
+    }
+
+    printf("%u iterations passed\n", iterationCount);
+    return 0;
+}
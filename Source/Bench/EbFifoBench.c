@@ -0,0 +1,190 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// EbFifoBench
+//  -Measures the throughput of the system resource manager fifos
+//  -Every thread cycles objects through the empty and full queues of a
+//   single SystemResource:
+//      EbGetEmptyObject -> EbPostFullObject -> EbGetFullObject -> EbReleaseObject
+//  -Reports queue operations per second for 1 to 128 threads
+//  -lock-free selects the lock-free ring buffers (1) or the mutex
+//   protected queues (0), the default follows LOCK_FREE_FIFO
+//
+// Usage: SvtHevcFifoBench [cycles per thread] [objects per thread] [lock-free]
+
+/***************************************
+ * Includes
+ ***************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "EbDefinitions.h"
+#include "EbThreads.h"
+#include "EbSystemResourceManager.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define FIFO_BENCH_MAX_THREADS          128
+#define FIFO_BENCH_MEMORY_MAP_SIZE      (1 << 20)
+#define FIFO_BENCH_DEFAULT_CYCLES       100000
+#define FIFO_BENCH_DEFAULT_OBJECTS      2
+#define FIFO_BENCH_OPS_PER_CYCLE        4
+
+// Memory map the EB_MALLOC family records into
+static EbMemoryContext_t        memoryContext;
+
+typedef struct FifoBenchContext_s {
+    EbFifo_t   *emptyFifoPtr;
+    EbFifo_t   *fullFifoPtr;
+    EB_U32      cycleCount;
+
+} FifoBenchContext_t;
+
+/***************************************
+ * Wall clock in seconds
+ ***************************************/
+static double FifoBenchTime(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+/***************************************
+ * Bench thread
+ ***************************************/
+static void* FifoBenchKernel(void *inputPtr)
+{
+    FifoBenchContext_t *contextPtr = (FifoBenchContext_t*)inputPtr;
+    EbObjectWrapper_t  *wrapperPtr;
+    EB_U32              cycleIndex;
+
+    for (cycleIndex = 0; cycleIndex < contextPtr->cycleCount; ++cycleIndex) {
+        EbGetEmptyObject(
+            contextPtr->emptyFifoPtr,
+            &wrapperPtr);
+
+        EbPostFullObject(wrapperPtr);
+
+        EbGetFullObject(
+            contextPtr->fullFifoPtr,
+            &wrapperPtr);
+
+        EbReleaseObject(wrapperPtr);
+    }
+
+    return EB_NULL;
+}
+
+/***************************************
+ * Runs one thread count, returns queue ops/sec
+ ***************************************/
+static EB_ERRORTYPE FifoBenchRun(
+    EB_U32      threadCount,
+    EB_U32      cycleCount,
+    EB_U32      objectsPerThread,
+    double     *opsPerSecond)
+{
+    EB_ERRORTYPE        return_error;
+    EbSystemResource_t *resourcePtr;
+    EbFifo_t          **emptyFifoPtrArray;
+    EbFifo_t          **fullFifoPtrArray;
+    FifoBenchContext_t  contextArray[FIFO_BENCH_MAX_THREADS];
+    EB_HANDLE           threadHandleArray[FIFO_BENCH_MAX_THREADS];
+    EB_U32              threadIndex;
+    double              startTime;
+    double              elapsedTime;
+
+    return_error = EbSystemResourceCtor(
+        &resourcePtr,
+        threadCount * objectsPerThread,
+        threadCount,
+        threadCount,
+        &emptyFifoPtrArray,
+        &fullFifoPtrArray,
+        EB_TRUE,
+        (EB_CTOR)EB_NULL,
+        EB_NULL);
+    if (return_error != EB_ErrorNone) {
+        return return_error;
+    }
+
+    for (threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+        contextArray[threadIndex].emptyFifoPtr  = emptyFifoPtrArray[threadIndex];
+        contextArray[threadIndex].fullFifoPtr   = fullFifoPtrArray[threadIndex];
+        contextArray[threadIndex].cycleCount    = cycleCount;
+    }
+
+    startTime = FifoBenchTime();
+
+    for (threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+        threadHandleArray[threadIndex] = EbCreateThread(FifoBenchKernel, &contextArray[threadIndex]);
+        if (threadHandleArray[threadIndex] == EB_NULL) {
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
+    for (threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+        EbDestroyThread(threadHandleArray[threadIndex]);
+    }
+
+    elapsedTime = FifoBenchTime() - startTime;
+
+    *opsPerSecond = (double)threadCount * cycleCount * FIFO_BENCH_OPS_PER_CYCLE / elapsedTime;
+
+    return EB_ErrorNone;
+}
+
+int main(int argc, char *argv[])
+{
+    EB_U32          cycleCount          = (argc > 1) ? (EB_U32)strtoul(argv[1], NULL, 0) : FIFO_BENCH_DEFAULT_CYCLES;
+    EB_U32          objectsPerThread    = (argc > 2) ? (EB_U32)strtoul(argv[2], NULL, 0) : FIFO_BENCH_DEFAULT_OBJECTS;
+    EB_BOOL         lockFree            = (argc > 3) ? (EB_BOOL)(strtoul(argv[3], NULL, 0) != 0) : LOCK_FREE_FIFO;
+    EB_U32          threadCount;
+    double          opsPerSecond;
+
+    if (cycleCount == 0 || objectsPerThread == 0) {
+        printf("Usage: %s [cycles per thread] [objects per thread] [lock-free]\n", argv[0]);
+        return 1;
+    }
+
+    // The resources are never destructed; the memory map only has to hold them
+    memoryContext.memoryMap = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * FIFO_BENCH_MEMORY_MAP_SIZE);
+    memoryContextPtr        = &memoryContext;
+    if (memoryContext.memoryMap == EB_NULL) {
+        return 1;
+    }
+
+    EbSetLockFreeFifo(lockFree);
+
+    printf("SVT-HEVC system resource manager fifo bench (%s)\n", lockFree ? "lock-free" : "mutex");
+    printf("%u cycles per thread, %u objects per thread\n", cycleCount, objectsPerThread);
+    printf("%8s %16s\n", "threads", "queue ops/sec");
+
+    for (threadCount = 1; threadCount <= FIFO_BENCH_MAX_THREADS; threadCount <<= 1) {
+        if (memoryContext.memoryMapIndex + 8 * threadCount * (objectsPerThread + 4) >= FIFO_BENCH_MEMORY_MAP_SIZE) {
+            printf("Out of memory map entries\n");
+            return 1;
+        }
+        if (FifoBenchRun(threadCount, cycleCount, objectsPerThread, &opsPerSecond) != EB_ErrorNone) {
+            printf("Failed to run %u threads\n", threadCount);
+            return 1;
+        }
+        printf("%8u %16.0f\n", threadCount, opsPerSecond);
+        fflush(stdout);
+    }
+
+    return 0;
+}
@@ -0,0 +1,2605 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// EbKernelBench
+//  -Checks the assembly slot of the function tables against the C_DEFAULT
+//   slot on randomized inputs, for every block size the table dispatches on
+//  -Reports the cycles per call of both slots and the speedup
+//  -Void slots of the tables (sizes the encoder never calls) are skipped,
+//   the other kernels are only called with the arguments and buffer layouts
+//   the encoder uses (e.g. the bi-prediction kernels are checked through
+//   their clipping kernel, the SAO offsets use the encoder packing)
+//  -Tables whose C_DEFAULT slot is itself an optimized kernel (partial
+//   frequency transforms) compare the two optimized slots
+//  -Tables that need encoder contexts (entropy coding, picture analysis
+//   denoising) and the 10-bit packing tables other than msbUnPack2D, which
+//   EbPackUnPack.h defines, are not covered
+//  -On AVX512 CPUs the AVX512 row of the three slot tables is also checked
+//   against the C_DEFAULT row (kernels suffixed _AVX512)
+//  -Dispatch times a 4x4 kernel called directly and through the library
+//   wrapper that reads ASM_TYPES, and reports the difference in cycles
+//  -HugePages walks an 8K reference plane with the 64x64 SAD kernel the way
+//   motion estimation does, on 4KB pages and on 2MB pages of the memory
+//   arena, and reports the cycles and DTLB load misses per LCU (Linux only)
+//  -Returns non-zero on any mismatch
+//
+// Usage: SvtHevcKernelBench [kernel name filter] [iterations] [seed]
+
+/***************************************
+ * Includes
+ ***************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "EbDefinitions.h"
+#include "EbComputeSAD.h"
+#include "EbMeSadCalculation.h"
+#include "EbPictureOperators.h"
+#include "EbTransforms.h"
+#include "EbIntraPrediction.h"
+#include "EbDeblockingFilter.h"
+#include "EbComputeMean.h"
+#include "EbMcp.h"
+#include "EbAvcStyleMcp.h"
+#include "EbSampleAdaptiveOffset.h"
+#include "EbBitstreamUnit_C.h"
+#include "EbBitstreamUnit_Intrinsic_AVX2.h"
+#include "EbComputeSAD_SadLoopKernel_AVX512.h"
+#include "EbMotionEstimation.h"
+#include "EbPackUnPack_C.h"
+#include "EbPackUnPack_Intrinsic_AVX2.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#define KERNEL_BENCH_DEFAULT_ITERATIONS 2000
+#define KERNEL_BENCH_TRIALS             32
+#define KERNEL_BENCH_STRIDE             256
+#define KERNEL_BENCH_BUFFER_SIZE        (KERNEL_BENCH_STRIDE * KERNEL_BENCH_STRIDE)
+#define KERNEL_BENCH_BLOCK_ORIGIN       (16 * KERNEL_BENCH_STRIDE + 16)
+#define KERNEL_BENCH_SCRATCH_SIZE       (80 * 80)
+
+#define KERNEL_BENCH_C                  0
+#define KERNEL_BENCH_SIMD               1
+
+// Block sizes of the [size >> 3] indexed tables
+static const EB_U32 KernelBenchBlockSizes[] = { 4, 8, 16, 32, 64 };
+#define KERNEL_BENCH_BLOCK_SIZE_COUNT   (sizeof(KernelBenchBlockSizes) / sizeof(KernelBenchBlockSizes[0]))
+
+// Input planes, and one output plane per slot
+EB_ALIGN(64) static EB_U8   inputBuffer8bit[3][KERNEL_BENCH_BUFFER_SIZE];
+EB_ALIGN(64) static EB_U16  inputBuffer16bit[3][KERNEL_BENCH_BUFFER_SIZE];
+EB_ALIGN(64) static EB_S16  coeffBuffer[2][KERNEL_BENCH_BUFFER_SIZE];
+EB_ALIGN(64) static EB_U8   outputBuffer8bit[2][KERNEL_BENCH_BUFFER_SIZE];
+EB_ALIGN(64) static EB_S16  outputBuffer16bit[2][KERNEL_BENCH_BUFFER_SIZE];
+EB_ALIGN(64) static EB_S16  outputBufferAux[2][KERNEL_BENCH_BUFFER_SIZE];
+EB_ALIGN(64) static EB_S16  biPredBuffer[2][2][KERNEL_BENCH_BUFFER_SIZE];
+EB_ALIGN(64) static EB_S16  scratchBuffer[KERNEL_BENCH_SCRATCH_SIZE];
+EB_ALIGN(64) static EB_U8   scratchBuffer8bit[KERNEL_BENCH_SCRATCH_SIZE * 2];
+
+static const char  *kernelFilter;
+static EB_U32       iterationCount;
+static EB_U32       benchState;
+static EB_BOOL      simdEnabled;
+static EB_U32       mismatchTotal;
+static EB_U32       kernelTotal;
+// Row of the three slot tables checked against their C_DEFAULT row
+static EB_U32       simdRow = KERNEL_BENCH_SIMD;
+
+// Times iterationCount calls of one slot, in cycles per call
+#define KERNEL_BENCH_TIME(cycles, call)                                             \
+    do {                                                                            \
+        EB_U32 iterationIndex;                                                      \
+        EB_U64 startCycles = KernelBenchCycles();                                   \
+        for (iterationIndex = 0; iterationIndex < iterationCount; ++iterationIndex) { \
+            call;                                                                   \
+        }                                                                           \
+        cycles = (double)(KernelBenchCycles() - startCycles) / iterationCount;      \
+    } while (0)
+
+/***************************************
+ * xorshift32
+ ***************************************/
+static EB_U32 KernelBenchRandom(void)
+{
+    benchState ^= benchState << 13;
+    benchState ^= benchState >> 17;
+    benchState ^= benchState << 5;
+    return benchState;
+}
+
+static EB_S32 KernelBenchRandomRange(
+    EB_S32 minValue,
+    EB_S32 maxValue)
+{
+    return minValue + (EB_S32)(KernelBenchRandom() % (EB_U32)(maxValue - minValue + 1));
+}
+
+static EB_U64 KernelBenchCycles(void)
+{
+    return (EB_U64)__rdtsc();
+}
+
+static int KernelBenchCpuSupportsAvx2(void)
+{
+#ifdef _MSC_VER
+    int cpuInfo[4];
+    __cpuidex(cpuInfo, 1, 0);
+    // OSXSAVE and AVX, YMM state enabled by the OS
+    if ((cpuInfo[2] & 0x18000000) != 0x18000000 || (_xgetbv(0) & 6) != 6) {
+        return 0;
+    }
+    __cpuidex(cpuInfo, 7, 0);
+    return (cpuInfo[1] & 0x20) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// The AVX512 subsets the kernels use
+static int KernelBenchCpuSupportsAvx512(void)
+{
+#ifdef _MSC_VER
+    int cpuInfo[4];
+    // OPMASK and ZMM state enabled by the OS
+    if ((_xgetbv(0) & 0xE6) != 0xE6) {
+        return 0;
+    }
+    __cpuidex(cpuInfo, 7, 0);
+    // AVX512F, AVX512DQ, AVX512BW and AVX512VL
+    return (cpuInfo[1] & 0xC0030000) == 0xC0030000;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl");
+#endif
+}
+
+/***************************************
+ * Input generation
+ *   Smooth planes keep the filters and the
+ *   deblocking decisions on their common paths,
+ *   noisy planes exercise the saturations
+ ***************************************/
+static void KernelBenchFill8bit(
+    EB_U8  *bufferPtr,
+    EB_U32  size,
+    EB_BOOL smooth)
+{
+    EB_U32 index;
+    EB_S32 base = KernelBenchRandomRange(16, 239);
+    EB_S32 sample;
+
+    // CLIP3 evaluates its argument more than once, draw the sample first
+    for (index = 0; index < size; ++index) {
+        sample = base + KernelBenchRandomRange(-3, 3);
+        bufferPtr[index] = smooth ?
+            (EB_U8)CLIP3(0, 255, sample) :
+            (EB_U8)KernelBenchRandom();
+    }
+}
+
+static void KernelBenchFill16bit(
+    EB_U16 *bufferPtr,
+    EB_U32  size,
+    EB_BOOL smooth)
+{
+    EB_U32 index;
+    EB_S32 base = KernelBenchRandomRange(64, 959);
+    EB_S32 sample;
+
+    for (index = 0; index < size; ++index) {
+        sample = base + KernelBenchRandomRange(-12, 12);
+        bufferPtr[index] = smooth ?
+            (EB_U16)CLIP3(0, 1023, sample) :
+            (EB_U16)(KernelBenchRandom() & 1023);
+    }
+}
+
+static void KernelBenchFillCoeff(
+    EB_S16 *bufferPtr,
+    EB_U32  size,
+    EB_S32  range)
+{
+    EB_U32 index;
+
+    for (index = 0; index < size; ++index) {
+        bufferPtr[index] = (EB_S16)KernelBenchRandomRange(-range, range - 1);
+    }
+}
+
+static void KernelBenchFillInputs(EB_U32 trialIndex)
+{
+    EB_BOOL smooth = (trialIndex & 1) ? EB_TRUE : EB_FALSE;
+    EB_U32  planeIndex;
+
+    for (planeIndex = 0; planeIndex < 3; ++planeIndex) {
+        KernelBenchFill8bit(inputBuffer8bit[planeIndex], KERNEL_BENCH_BUFFER_SIZE, smooth);
+        KernelBenchFill16bit(inputBuffer16bit[planeIndex], KERNEL_BENCH_BUFFER_SIZE, smooth);
+    }
+    // Residual range for the transforms
+    KernelBenchFillCoeff(coeffBuffer[0], KERNEL_BENCH_BUFFER_SIZE, 256);
+    KernelBenchFillCoeff(coeffBuffer[1], KERNEL_BENCH_BUFFER_SIZE, 256);
+}
+
+// Reconstruction planes, within a few levels of the input planes
+static void KernelBenchFillRecon(void)
+{
+    EB_U32 index;
+    EB_S32 sample;
+
+    for (index = 0; index < KERNEL_BENCH_BUFFER_SIZE; ++index) {
+        sample = inputBuffer8bit[0][index] + KernelBenchRandomRange(-4, 4);
+        inputBuffer8bit[1][index]  = (EB_U8)CLIP3(0, 255, sample);
+        sample = inputBuffer16bit[0][index] + KernelBenchRandomRange(-16, 16);
+        inputBuffer16bit[1][index] = (EB_U16)CLIP3(0, 1023, sample);
+    }
+}
+
+// Both output planes start from the same contents, so untouched samples compare equal
+static void KernelBenchResetOutputs(void)
+{
+    memset(outputBuffer8bit, 0, sizeof(outputBuffer8bit));
+    memset(outputBuffer16bit, 0, sizeof(outputBuffer16bit));
+    memset(outputBufferAux, 0, sizeof(outputBufferAux));
+}
+
+// Compares the top left width x height samples of the 16 bit output planes
+static EB_BOOL KernelBenchBlocksMatch16bit(
+    EB_U32 width,
+    EB_U32 height)
+{
+    EB_U32 rowIndex;
+
+    for (rowIndex = 0; rowIndex < height; ++rowIndex) {
+        if (memcmp(
+            outputBuffer16bit[KERNEL_BENCH_C] + rowIndex * KERNEL_BENCH_STRIDE,
+            outputBuffer16bit[KERNEL_BENCH_SIMD] + rowIndex * KERNEL_BENCH_STRIDE,
+            width * sizeof(EB_S16)) != 0) {
+            return EB_FALSE;
+        }
+    }
+    return EB_TRUE;
+}
+
+static EB_BOOL KernelBenchOutputsMatch(void)
+{
+    return (EB_BOOL)(
+        memcmp(outputBuffer8bit[KERNEL_BENCH_C], outputBuffer8bit[KERNEL_BENCH_SIMD], sizeof(outputBuffer8bit[0])) == 0 &&
+        memcmp(outputBuffer16bit[KERNEL_BENCH_C], outputBuffer16bit[KERNEL_BENCH_SIMD], sizeof(outputBuffer16bit[0])) == 0 &&
+        memcmp(outputBufferAux[KERNEL_BENCH_C], outputBufferAux[KERNEL_BENCH_SIMD], sizeof(outputBufferAux[0])) == 0);
+}
+
+/***************************************
+ * Reporting
+ ***************************************/
+static EB_BOOL KernelBenchSelected(const char *kernelName)
+{
+    return (EB_BOOL)(kernelFilter == NULL || strstr(kernelName, kernelFilter) != NULL);
+}
+
+static void KernelBenchReport(
+    const char *kernelName,
+    const char *sizeName,
+    double      cyclesC,
+    double      cyclesSimd,
+    EB_U32      mismatchCount)
+{
+    ++kernelTotal;
+    mismatchTotal += mismatchCount;
+
+    if (simdEnabled) {
+        printf("%-44s %-8s %12.1f %12.1f %8.2fx  %s\n",
+            kernelName,
+            sizeName,
+            cyclesC,
+            cyclesSimd,
+            cyclesSimd > 0 ? cyclesC / cyclesSimd : 0,
+            mismatchCount ? "MISMATCH" : "ok");
+    }
+    else {
+        printf("%-44s %-8s %12.1f %12s %9s  %s\n", kernelName, sizeName, cyclesC, "-", "-", "c only");
+    }
+    fflush(stdout);
+}
+
+static const char* KernelBenchSizeName(
+    EB_U32 width,
+    EB_U32 height)
+{
+    static char sizeName[24];
+    sprintf(sizeName, "%ux%u", width, height);
+    return sizeName;
+}
+
+/***************************************
+ * Motion estimation SAD
+ ***************************************/
+static void KernelBenchSadLoopKernel(
+    const char               *kernelName,
+    EB_SADLOOPKERNELNxM_TYPE  simdKernel)
+{
+    // Hierarchical ME levels 0 and 1: sixteenth and quarter LCU, every other line
+    static const EB_U32 loopBlockWidth[2] = { 16, 32 };
+    const EB_SADLOOPKERNELNxM_TYPE kernel[2] = { NxMSadLoopKernel_funcPtrArray[KERNEL_BENCH_C], simdKernel };
+    EB_U32 levelIndex;
+    EB_U32 trialIndex;
+
+    for (levelIndex = 0; levelIndex < 2; ++levelIndex) {
+        EB_U32 width  = loopBlockWidth[levelIndex];
+        EB_U32 height = width >> 1;
+        EB_S16 searchAreaWidth  = 64;
+        EB_S16 searchAreaHeight = 32;
+        EB_U32 mismatchCount = 0;
+        EB_U64 bestSad[2];
+        EB_S16 xSearchCenter[2];
+        EB_S16 ySearchCenter[2];
+        double cycles[2] = { 0, 0 };
+        EB_U32 slot;
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                bestSad[slot] = 0xFFFFFF;
+                xSearchCenter[slot] = ySearchCenter[slot] = 0;
+                kernel[slot](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE * 2,
+                    inputBuffer8bit[1], KERNEL_BENCH_STRIDE * 2,
+                    height, width,
+                    &bestSad[slot], &xSearchCenter[slot], &ySearchCenter[slot],
+                    KERNEL_BENCH_STRIDE, searchAreaWidth, searchAreaHeight);
+            }
+            mismatchCount += (simdEnabled &&
+                (bestSad[0] != bestSad[1] || xSearchCenter[0] != xSearchCenter[1] || ySearchCenter[0] != ySearchCenter[1]));
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], kernel[slot](
+                inputBuffer8bit[0], KERNEL_BENCH_STRIDE * 2,
+                inputBuffer8bit[1], KERNEL_BENCH_STRIDE * 2,
+                height, width,
+                &bestSad[slot], &xSearchCenter[slot], &ySearchCenter[slot],
+                KERNEL_BENCH_STRIDE, searchAreaWidth, searchAreaHeight));
+        }
+        KernelBenchReport(kernelName, KernelBenchSizeName(width, height), cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+// Best SADs and MVs of the 85 PUs: 64 8x8, 16 16x16, 4 32x32 and 1 64x64
+#define KERNEL_BENCH_PU_COUNT 85
+
+static EB_U32 KernelBenchPuArea(EB_U32 puIndex)
+{
+    return puIndex < 64 ? 8 * 8 : puIndex < 80 ? 16 * 16 : puIndex < 84 ? 32 * 32 : 64 * 64;
+}
+
+static void KernelBenchAll85PUs(
+    const char        *kernelName,
+    EB_FPSEARCH_FUNC   simdKernel)
+{
+    const EB_FPSEARCH_FUNC kernel[2] = { GetEightHorizontalSearchPointResultsAll85PUs_funcPtrArray[KERNEL_BENCH_C], simdKernel };
+    static MeContext_t context[2];
+    EB_U32 bestSad[2][KERNEL_BENCH_PU_COUNT];
+    EB_U32 bestMv[2][KERNEL_BENCH_PU_COUNT];
+    EB_U32 initialSad[KERNEL_BENCH_PU_COUNT];
+    EB_U16 eightPosSad16x16[2][16 * 8];
+    EB_U32 searchRegionIndex = 0;
+    EB_U32 xSearchIndex = 0;
+    EB_U32 ySearchIndex = 0;
+    EB_U32 mismatchCount = 0;
+    EB_U32 trialIndex;
+    EB_U32 puIndex;
+    EB_U32 slot;
+    double cycles[2] = { 0, 0 };
+
+    for (slot = 0; slot < 2; ++slot) {
+        context[slot].lcuSrcStride = KERNEL_BENCH_STRIDE;
+        context[slot].integerBufferPtr[0][0] = inputBuffer8bit[1];
+        context[slot].interpolatedFullStride[0][0] = KERNEL_BENCH_STRIDE;
+        context[slot].pBestSad8x8 = &bestSad[slot][0];
+        context[slot].pBestSad16x16 = &bestSad[slot][64];
+        context[slot].pBestSad32x32 = &bestSad[slot][80];
+        context[slot].pBestSad64x64 = &bestSad[slot][84];
+        context[slot].pBestMV8x8 = &bestMv[slot][0];
+        context[slot].pBestMV16x16 = &bestMv[slot][64];
+        context[slot].pBestMV32x32 = &bestMv[slot][80];
+        context[slot].pBestMV64x64 = &bestMv[slot][84];
+        context[slot].pEightPosSad16x16 = eightPosSad16x16[slot];
+    }
+
+    for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+        KernelBenchFillInputs(trialIndex);
+        // Misaligned LCU source and a search position within the padded reference
+        searchRegionIndex = KernelBenchRandom() % 100 + (KernelBenchRandom() % 64) * KERNEL_BENCH_STRIDE;
+        xSearchIndex = (EB_U32)KernelBenchRandomRange(-64, 63);
+        ySearchIndex = (EB_U32)KernelBenchRandomRange(-64, 63);
+        // Best SADs around the SAD of the smooth planes, so that some of them are replaced
+        for (puIndex = 0; puIndex < KERNEL_BENCH_PU_COUNT; ++puIndex) {
+            initialSad[puIndex] = KernelBenchRandom() % (KernelBenchPuArea(puIndex) * 8);
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            context[slot].lcuSrcPtr = inputBuffer8bit[0] + (trialIndex & 15);
+            memcpy(bestSad[slot], initialSad, sizeof(initialSad));
+            memset(bestMv[slot], 0, sizeof(bestMv[slot]));
+            kernel[slot](&context[slot], 0, searchRegionIndex, xSearchIndex, ySearchIndex);
+        }
+        mismatchCount += (simdEnabled &&
+            (memcmp(bestSad[0], bestSad[1], sizeof(bestSad[0])) || memcmp(bestMv[0], bestMv[1], sizeof(bestMv[0]))));
+    }
+    for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+        KERNEL_BENCH_TIME(cycles[slot], kernel[slot](&context[slot], 0, searchRegionIndex, xSearchIndex, ySearchIndex));
+    }
+    KernelBenchReport(kernelName, "64x64", cycles[0], cycles[1], mismatchCount);
+}
+
+static void KernelBenchSad(void)
+{
+    // 24, 40, 48 and 56 wide blocks are the AMP partitions
+    static const EB_U32 sadBlockHeight[9] = { 4, 8, 16, 32, 32, 40, 64, 56, 64 };
+    EB_U32 sizeIndex;
+    EB_U32 trialIndex;
+
+    if (KernelBenchSelected("NxMSadKernel")) {
+        for (sizeIndex = 0; sizeIndex < 9; ++sizeIndex) {
+            EB_U32 width  = sizeIndex ? sizeIndex << 3 : 4;
+            EB_U32 height = sadBlockHeight[sizeIndex];
+            EB_U32 mismatchCount = 0;
+            EB_U32 sad[2] = { 0, 0 };
+            EB_U32 refOffset = 0;
+            double cycles[2] = { 0, 0 };
+            EB_U32 slot;
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                refOffset = KernelBenchRandom() % (KERNEL_BENCH_STRIDE * 64);
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    sad[slot] = NxMSadKernel_funcPtrArray[slot][sizeIndex](
+                        inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                        inputBuffer8bit[1] + refOffset, KERNEL_BENCH_STRIDE,
+                        height, width);
+                }
+                mismatchCount += (simdEnabled && sad[0] != sad[1]);
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], sad[slot] += NxMSadKernel_funcPtrArray[slot][sizeIndex](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1] + refOffset, KERNEL_BENCH_STRIDE,
+                    height, width));
+            }
+            KernelBenchReport("NxMSadKernel", KernelBenchSizeName(width, height), cycles[0], cycles[1], mismatchCount);
+        }
+    }
+
+    if (KernelBenchSelected("NxMSadAveragingKernel")) {
+        for (sizeIndex = 0; sizeIndex < 9; ++sizeIndex) {
+            EB_U32 width  = sizeIndex ? sizeIndex << 3 : 4;
+            EB_U32 height = sadBlockHeight[sizeIndex];
+            EB_U32 mismatchCount = 0;
+            EB_U32 sad[2] = { 0, 0 };
+            double cycles[2] = { 0, 0 };
+            EB_U32 slot;
+
+            if (width == 40 || width == 56) {
+                continue;
+            }
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    sad[slot] = NxMSadAveragingKernel_funcPtrArray[slot][sizeIndex](
+                        inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                        inputBuffer8bit[1] + (trialIndex & 7), KERNEL_BENCH_STRIDE,
+                        inputBuffer8bit[2] + KERNEL_BENCH_STRIDE * (trialIndex & 3), KERNEL_BENCH_STRIDE,
+                        height, width);
+                }
+                mismatchCount += (simdEnabled && sad[0] != sad[1]);
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], sad[slot] += NxMSadAveragingKernel_funcPtrArray[slot][sizeIndex](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[2], KERNEL_BENCH_STRIDE,
+                    height, width));
+            }
+            KernelBenchReport("NxMSadAveragingKernel", KernelBenchSizeName(width, height), cycles[0], cycles[1], mismatchCount);
+        }
+    }
+
+    if (KernelBenchSelected("NxMSadLoopKernel")) {
+        KernelBenchSadLoopKernel("NxMSadLoopKernel", NxMSadLoopKernel_funcPtrArray[KERNEL_BENCH_SIMD]);
+    }
+
+    if (KernelBenchSelected("GetEightHorizontalSearchPointResultsAll85PUs")) {
+        KernelBenchAll85PUs("GetEightHorizontalSearchPointResultsAll85PUs", GetEightHorizontalSearchPointResultsAll85PUs_funcPtrArray[KERNEL_BENCH_SIMD]);
+    }
+
+    if (KernelBenchSelected("SadCalculation_8x8_16x16")) {
+        EB_U32 mismatchCount = 0;
+        EB_U32 bestSad8x8[2][4], bestSad16x16[2], bestMv8x8[2][4], bestMv16x16[2], sad16x16[2];
+        EB_U32 mv = 0;
+        double cycles[2] = { 0, 0 };
+        EB_U32 slot;
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            mv = KernelBenchRandom();
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                memset(bestSad8x8[slot], 0x7F, sizeof(bestSad8x8[slot]));
+                memset(bestMv8x8[slot], 0, sizeof(bestMv8x8[slot]));
+                bestSad16x16[slot] = 0x7F7F7F7F;
+                bestMv16x16[slot] = sad16x16[slot] = 0;
+                SadCalculation_8x8_16x16_funcPtrArray[slot](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                    bestSad8x8[slot], &bestSad16x16[slot], bestMv8x8[slot], &bestMv16x16[slot], mv, &sad16x16[slot]);
+            }
+            mismatchCount += (simdEnabled &&
+                (memcmp(bestSad8x8[0], bestSad8x8[1], sizeof(bestSad8x8[0])) || memcmp(bestMv8x8[0], bestMv8x8[1], sizeof(bestMv8x8[0])) ||
+                 bestSad16x16[0] != bestSad16x16[1] || bestMv16x16[0] != bestMv16x16[1] || sad16x16[0] != sad16x16[1]));
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], SadCalculation_8x8_16x16_funcPtrArray[slot](
+                inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                bestSad8x8[slot], &bestSad16x16[slot], bestMv8x8[slot], &bestMv16x16[slot], mv, &sad16x16[slot]));
+        }
+        KernelBenchReport("SadCalculation_8x8_16x16", "16x16", cycles[0], cycles[1], mismatchCount);
+    }
+
+    if (KernelBenchSelected("SadCalculation_32x32_64x64")) {
+        EB_U32 mismatchCount = 0;
+        EB_U32 sad16x16[16], bestSad32x32[2][4], bestSad64x64[2], bestMv32x32[2][4], bestMv64x64[2];
+        EB_U32 mv = 0;
+        EB_U32 index;
+        double cycles[2] = { 0, 0 };
+        EB_U32 slot;
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            for (index = 0; index < 16; ++index) {
+                sad16x16[index] = KernelBenchRandom() & 0xFFFF;
+            }
+            mv = KernelBenchRandom();
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                for (index = 0; index < 4; ++index) {
+                    bestSad32x32[slot][index] = 0x1FFFF + (index << 14);
+                    bestMv32x32[slot][index] = 0;
+                }
+                bestSad64x64[slot] = 0x7FFFF;
+                bestMv64x64[slot] = 0;
+                SadCalculation_32x32_64x64_funcPtrArray[slot](
+                    sad16x16, bestSad32x32[slot], &bestSad64x64[slot], bestMv32x32[slot], &bestMv64x64[slot], mv);
+            }
+            mismatchCount += (simdEnabled &&
+                (memcmp(bestSad32x32[0], bestSad32x32[1], sizeof(bestSad32x32[0])) || memcmp(bestMv32x32[0], bestMv32x32[1], sizeof(bestMv32x32[0])) ||
+                 bestSad64x64[0] != bestSad64x64[1] || bestMv64x64[0] != bestMv64x64[1]));
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], SadCalculation_32x32_64x64_funcPtrArray[slot](
+                sad16x16, bestSad32x32[slot], &bestSad64x64[slot], bestMv32x32[slot], &bestMv64x64[slot], mv));
+        }
+        KernelBenchReport("SadCalculation_32x32_64x64", "64x64", cycles[0], cycles[1], mismatchCount);
+    }
+
+    if (KernelBenchSelected("InitializeBuffer_32bits")) {
+        EB_U32 mismatchCount = 0;
+        EB_U32 value = 0;
+        double cycles[2] = { 0, 0 };
+        EB_U32 slot;
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchResetOutputs();
+            value = KernelBenchRandom();
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                InitializeBuffer_32bits_funcPtrArray[slot]((EB_U32*)outputBuffer16bit[slot], 16, trialIndex % 4, value);
+            }
+            mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], InitializeBuffer_32bits_funcPtrArray[slot]((EB_U32*)outputBuffer16bit[slot], 16, 0, value));
+        }
+        KernelBenchReport("InitializeBuffer_32bits", "64x4", cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+/***************************************
+ * Picture operators
+ ***************************************/
+typedef void(*KernelBenchUnPack2D_TYPE)(
+    EB_U16      *in16BitBuffer,
+    EB_U32       inStride,
+    EB_U8       *out8BitBuffer,
+    EB_U8       *outnBitBuffer,
+    EB_U32       out8Stride,
+    EB_U32       outnStride,
+    EB_U32       width,
+    EB_U32       height);
+
+// Row 1 of UnPack2D_funcPtrArray_16Bit: widths multiple of 4, even heights
+static void KernelBenchUnPack2D(
+    const char               *kernelName,
+    KernelBenchUnPack2D_TYPE  simdKernel)
+{
+    static const EB_U32 unpackWidth[6] = { 32, 36, 88, 100, 136, 200 };
+    static const EB_U32 unpackHeight[6] = { 2, 4, 8, 8, 16, 16 };
+    const KernelBenchUnPack2D_TYPE kernel[2] = { EB_ENC_msbUnPack2D, simdKernel };
+    EB_U32 sizeIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    for (sizeIndex = 0; sizeIndex < 6; ++sizeIndex) {
+        EB_U32 width = unpackWidth[sizeIndex];
+        EB_U32 height = unpackHeight[sizeIndex];
+        EB_U32 out8Offset = 0;
+        EB_U32 outnOffset = 0;
+        EB_U32 outStride = KERNEL_BENCH_STRIDE;
+        EB_U32 mismatchCount = 0;
+        double cycles[2] = { 0, 0 };
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchResetOutputs();
+            // Both outputs at the same alignment (non temporal stores for both) on even
+            // trials, strides that change the alignment from row to row on half of them
+            out8Offset = KernelBenchRandom() & 63;
+            outnOffset = (trialIndex & 1) ? KernelBenchRandom() & 63 : out8Offset;
+            outStride = (trialIndex & 2) ? KERNEL_BENCH_STRIDE - 4 * (KernelBenchRandom() & 7) : KERNEL_BENCH_STRIDE;
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                kernel[slot](
+                    inputBuffer16bit[0], KERNEL_BENCH_STRIDE,
+                    outputBuffer8bit[slot] + out8Offset,
+                    (EB_U8*)outputBufferAux[slot] + outnOffset,
+                    outStride, outStride,
+                    width, height);
+            }
+            mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], kernel[slot](
+                inputBuffer16bit[0], KERNEL_BENCH_STRIDE,
+                outputBuffer8bit[slot] + out8Offset,
+                (EB_U8*)outputBufferAux[slot] + outnOffset,
+                outStride, outStride,
+                width, height));
+        }
+        KernelBenchReport(kernelName, KernelBenchSizeName(width, height), cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+static void KernelBenchFullDistortion(
+    EB_U32      size,
+    const char *kernelSuffix)
+{
+    static const char *fullDistortionName[2][2] = {
+        { "FullDistortionIntrinsic[cbf 0]", "FullDistortionIntrinsic[cbf 0 intra]" },
+        { "FullDistortionIntrinsic[cbf 1]", "FullDistortionIntrinsic[cbf 1 intra]" }
+    };
+    EB_U32 sizeIndex = size >> 3;
+    EB_U32 cbfIndex;
+    EB_U32 intraIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+    char   kernelName[64];
+
+    for (cbfIndex = 0; cbfIndex < 2; ++cbfIndex) {
+        for (intraIndex = 0; intraIndex < 2; ++intraIndex) {
+            EB_U64 distortion[2][DIST_CALC_TOTAL];
+            EB_U32 mismatchCount = 0;
+            double cycles[2] = { 0, 0 };
+
+            sprintf(kernelName, "%s%s", fullDistortionName[cbfIndex][intraIndex], kernelSuffix);
+            if (!KernelBenchSelected(kernelName)) {
+                continue;
+            }
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    memset(distortion[slot], 0, sizeof(distortion[slot]));
+                    FullDistortionIntrinsic_funcPtrArray[slot ? simdRow : slot][cbfIndex][intraIndex][sizeIndex](
+                        coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                        coeffBuffer[1], KERNEL_BENCH_STRIDE,
+                        distortion[slot], size, size);
+                }
+                mismatchCount += (simdEnabled && memcmp(distortion[0], distortion[1], sizeof(distortion[0])) != 0);
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], FullDistortionIntrinsic_funcPtrArray[slot ? simdRow : slot][cbfIndex][intraIndex][sizeIndex](
+                    coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                    coeffBuffer[1], KERNEL_BENCH_STRIDE,
+                    distortion[slot], size, size));
+            }
+            KernelBenchReport(kernelName, KernelBenchSizeName(size, size), cycles[0], cycles[1], mismatchCount);
+        }
+    }
+}
+
+static void KernelBenchPictureOperators(void)
+{
+    EB_U32 blockIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    if (KernelBenchSelected("msbUnPack2D")) {
+        KernelBenchUnPack2D("msbUnPack2D", EB_ENC_msbUnPack2D_AVX2_INTRIN);
+    }
+
+    for (blockIndex = 0; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT; ++blockIndex) {
+        EB_U32      size      = KernelBenchBlockSizes[blockIndex];
+        EB_U32      sizeIndex = size >> 3;
+        const char *sizeName  = KernelBenchSizeName(size, size);
+        EB_U32      mismatchCount;
+        double      cycles[2] = { 0, 0 };
+
+        if (KernelBenchSelected("ResidualKernel")) {
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    ResidualKernel_funcPtrArray[slot][sizeIndex](
+                        inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                        inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                        outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                        size, size);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], ResidualKernel_funcPtrArray[slot][sizeIndex](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                    outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                    size, size));
+            }
+            KernelBenchReport("ResidualKernel", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (KernelBenchSelected("ResidualKernelSubSampled")) {
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    ResidualKernelSubSampled_funcPtrArray[slot][sizeIndex](
+                        inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                        inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                        outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                        size, size, (EB_U8)(trialIndex & 1));
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], ResidualKernelSubSampled_funcPtrArray[slot][sizeIndex](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                    outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                    size, size, 0));
+            }
+            KernelBenchReport("ResidualKernelSubSampled", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (KernelBenchSelected("ResidualKernel16Bit")) {
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    ResidualKernel_funcPtrArray16Bit[slot](
+                        inputBuffer16bit[0], KERNEL_BENCH_STRIDE,
+                        inputBuffer16bit[1], KERNEL_BENCH_STRIDE,
+                        outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                        size, size);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], ResidualKernel_funcPtrArray16Bit[slot](
+                    inputBuffer16bit[0], KERNEL_BENCH_STRIDE,
+                    inputBuffer16bit[1], KERNEL_BENCH_STRIDE,
+                    outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                    size, size));
+            }
+            KernelBenchReport("ResidualKernel16Bit", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (KernelBenchSelected("PicCopyKernel")) {
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    PicCopyKernel_funcPtrArray[slot][sizeIndex](
+                        inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                        outputBuffer8bit[slot], KERNEL_BENCH_STRIDE,
+                        size, size);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], PicCopyKernel_funcPtrArray[slot][sizeIndex](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    outputBuffer8bit[slot], KERNEL_BENCH_STRIDE,
+                    size, size));
+            }
+            KernelBenchReport("PicCopyKernel", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (KernelBenchSelected("AdditionKernel")) {
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    AdditionKernel_funcPtrArray[slot][sizeIndex](
+                        inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                        coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                        outputBuffer8bit[slot], KERNEL_BENCH_STRIDE,
+                        size, size);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], AdditionKernel_funcPtrArray[slot][sizeIndex](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                    outputBuffer8bit[slot], KERNEL_BENCH_STRIDE,
+                    size, size));
+            }
+            KernelBenchReport("AdditionKernel", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (KernelBenchSelected("AdditionKernel16bit")) {
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    AdditionKernel_funcPtrArray16bit[slot](
+                        inputBuffer16bit[0], KERNEL_BENCH_STRIDE,
+                        coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                        (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                        size, size);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], AdditionKernel_funcPtrArray16bit[slot](
+                    inputBuffer16bit[0], KERNEL_BENCH_STRIDE,
+                    coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                    (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                    size, size));
+            }
+            KernelBenchReport("AdditionKernel16bit", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        KernelBenchFullDistortion(size, "");
+
+        if (KernelBenchSelected("SpatialFullDistortionKernel")) {
+            EB_U64 distortion[2] = { 0, 0 };
+
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    distortion[slot] = SpatialFullDistortionKernel_funcPtrArray[slot][Log2f(size) - 2](
+                        inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                        inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                        size, size);
+                }
+                mismatchCount += (simdEnabled && distortion[0] != distortion[1]);
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], distortion[slot] += SpatialFullDistortionKernel_funcPtrArray[slot][Log2f(size) - 2](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                    size, size));
+            }
+            KernelBenchReport("SpatialFullDistortionKernel", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (size <= 32 && KernelBenchSelected("PicZeroOutCoef")) {
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                memcpy(outputBuffer16bit[0], coeffBuffer[0], sizeof(outputBuffer16bit[0]));
+                memcpy(outputBuffer16bit[1], coeffBuffer[0], sizeof(outputBuffer16bit[1]));
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    PicZeroOutCoef_funcPtrArray[slot][sizeIndex](
+                        outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                        (trialIndex & 7) * (KERNEL_BENCH_STRIDE + 1),
+                        size, size);
+                }
+                mismatchCount += (simdEnabled &&
+                    memcmp(outputBuffer16bit[0], outputBuffer16bit[1], sizeof(outputBuffer16bit[0])) != 0);
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], PicZeroOutCoef_funcPtrArray[slot][sizeIndex](
+                    outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, 0, size, size));
+            }
+            KernelBenchReport("PicZeroOutCoef", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (size >= 4 && size <= 32 && KernelBenchSelected("SumResidual")) {
+            EB_S32 sum[2] = { 0, 0 };
+
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    sum[slot] = SumResidual_funcPtrArray[slot](coeffBuffer[0], size, KERNEL_BENCH_STRIDE);
+                }
+                mismatchCount += (simdEnabled && sum[0] != sum[1]);
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], sum[slot] += SumResidual_funcPtrArray[slot](coeffBuffer[0], size, KERNEL_BENCH_STRIDE));
+            }
+            KernelBenchReport("SumResidual", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (size >= 4 && size <= 32 && KernelBenchSelected("memset16bitBlock")) {
+            EB_S16 value = 0;
+
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchResetOutputs();
+                value = (EB_S16)KernelBenchRandom();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    memset16bitBlock_funcPtrArray[slot](outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, size, value);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], memset16bitBlock_funcPtrArray[slot](outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, size, value));
+            }
+            KernelBenchReport("memset16bitBlock", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+    }
+
+    if (KernelBenchSelected("Compute8x8Satd")) {
+        EB_U64 satd[2] = { 0, 0 };
+        EB_U32 mismatchCount = 0;
+        double cycles[2] = { 0, 0 };
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                satd[slot] = Compute8x8Satd_funcPtrArray[slot](coeffBuffer[0]);
+            }
+            mismatchCount += (simdEnabled && satd[0] != satd[1]);
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], satd[slot] += Compute8x8Satd_funcPtrArray[slot](coeffBuffer[0]));
+        }
+        KernelBenchReport("Compute8x8Satd", "8x8", cycles[0], cycles[1], mismatchCount);
+    }
+
+    if (KernelBenchSelected("Compute8x8Satd_U8")) {
+        EB_U64 satd[2] = { 0, 0 };
+        EB_U64 dcValue[2] = { 0, 0 };
+        EB_U32 mismatchCount = 0;
+        double cycles[2] = { 0, 0 };
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                dcValue[slot] = 0;
+                satd[slot] = Compute8x8Satd_U8_funcPtrArray[slot](inputBuffer8bit[0], &dcValue[slot], KERNEL_BENCH_STRIDE);
+            }
+            mismatchCount += (simdEnabled && (satd[0] != satd[1] || dcValue[0] != dcValue[1]));
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], satd[slot] += Compute8x8Satd_U8_funcPtrArray[slot](inputBuffer8bit[0], &dcValue[slot], KERNEL_BENCH_STRIDE));
+        }
+        KernelBenchReport("Compute8x8Satd_U8", "8x8", cycles[0], cycles[1], mismatchCount);
+    }
+
+    if (KernelBenchSelected("ComputeMeanFunc")) {
+        static const char *computeMeanName[2] = { "ComputeMeanFunc[mean]", "ComputeMeanFunc[mean of squares]" };
+        EB_U32 meanIndex;
+
+        for (meanIndex = 0; meanIndex < 2; ++meanIndex) {
+            EB_U64 mean[2] = { 0, 0 };
+            EB_U32 mismatchCount = 0;
+            double cycles[2] = { 0, 0 };
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    mean[slot] = ComputeMeanFunc[meanIndex][slot](inputBuffer8bit[0], KERNEL_BENCH_STRIDE, 8, 8);
+                }
+                mismatchCount += (simdEnabled && mean[0] != mean[1]);
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], mean[slot] += ComputeMeanFunc[meanIndex][slot](inputBuffer8bit[0], KERNEL_BENCH_STRIDE, 8, 8));
+            }
+            KernelBenchReport(computeMeanName[meanIndex], "8x8", cycles[0], cycles[1], mismatchCount);
+        }
+    }
+
+    if (KernelBenchSelected("Decimation2D")) {
+        // One LCU row of a picture whose width is not a multiple of the vector width
+        static const char *decimationName[2] = { "Decimation2D[quarter]", "Decimation2D[sixteenth]" };
+        const EB_U32 areaWidth = 200;
+        const EB_U32 areaHeight = 64;
+        EB_U32 stepIndex;
+
+        for (stepIndex = 0; stepIndex < 2; ++stepIndex) {
+            EB_U32 decimStep = 2 << stepIndex;
+            EB_U32 mismatchCount = 0;
+            double cycles[2] = { 0, 0 };
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    Decimation2D_funcPtrArray[slot](
+                        inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                        areaWidth, areaHeight,
+                        outputBuffer8bit[slot] + (trialIndex & 15), KERNEL_BENCH_STRIDE,
+                        decimStep);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], Decimation2D_funcPtrArray[slot](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    areaWidth, areaHeight,
+                    outputBuffer8bit[slot], KERNEL_BENCH_STRIDE,
+                    decimStep));
+            }
+            KernelBenchReport(decimationName[stepIndex], KernelBenchSizeName(areaWidth, areaHeight), cycles[0], cycles[1], mismatchCount);
+        }
+    }
+}
+
+/***************************************
+ * Transforms and quantization
+ ***************************************/
+static void KernelBenchTransformTable(
+    const char               *kernelName,
+    const EB_TRANSFORM_FUNC   transformTable[][5],
+    EB_U32                    retainedShift)
+{
+    // Table order is 32x32, 16x16, 8x8, 4x4, DST 4x4
+    static const EB_U32 transformSize[5] = { 32, 16, 8, 4, 4 };
+    EB_U32 transformIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    for (transformIndex = 0; transformIndex < 5; ++transformIndex) {
+        EB_U32 size = transformSize[transformIndex];
+        // Partial frequency kernels only produce the low frequency quadrant
+        EB_U32 retainedSize = (transformIndex < 3) ? size >> retainedShift : size;
+        EB_U32 mismatchCount = 0;
+        double cycles[2] = { 0, 0 };
+        char sizeName[24];
+
+        sprintf(sizeName, "%s%ux%u", transformIndex == 4 ? "dst" : "", size, size);
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchResetOutputs();
+            // 10-bit residuals are always transformed by the C_DEFAULT slot
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                transformTable[slot ? simdRow : slot][transformIndex](
+                    coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                    outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                    scratchBuffer, 0);
+            }
+            mismatchCount += (simdEnabled && !KernelBenchBlocksMatch16bit(retainedSize, retainedSize));
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], transformTable[slot ? simdRow : slot][transformIndex](
+                coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                scratchBuffer, 0));
+        }
+        KernelBenchReport(kernelName, sizeName, cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+static void KernelBenchInvTransformTable(
+    const char                 *kernelName,
+    const EB_INVTRANSFORM_FUNC  invTransformTable[][5])
+{
+    static const EB_U32 transformSize[5] = { 32, 16, 8, 4, 4 };
+    EB_U32 transformIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    for (transformIndex = 0; transformIndex < 5; ++transformIndex) {
+        EB_U32 size = transformSize[transformIndex];
+        EB_U32 bitIncrement = 0;
+        EB_U32 mismatchCount = 0;
+        double cycles[2] = { 0, 0 };
+        char sizeName[24];
+
+        sprintf(sizeName, "%s%ux%u", transformIndex == 4 ? "dst" : "", size, size);
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchResetOutputs();
+            bitIncrement = (trialIndex & 2) ? 2 : 0;
+            // Dequantized coefficients
+            KernelBenchFillCoeff(coeffBuffer[0], KERNEL_BENCH_BUFFER_SIZE, 4096);
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                invTransformTable[slot ? simdRow : slot][transformIndex](
+                    coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                    outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                    scratchBuffer, bitIncrement);
+            }
+            mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], invTransformTable[slot ? simdRow : slot][transformIndex](
+                coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                scratchBuffer, bitIncrement));
+        }
+        KernelBenchReport(kernelName, sizeName, cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+static void KernelBenchTransforms(void)
+{
+    EB_U32 blockIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    if (KernelBenchSelected("transformFunctionTableEstimate")) {
+        KernelBenchTransformTable("transformFunctionTableEstimate", transformFunctionTableEstimate, 0);
+    }
+    if (KernelBenchSelected("transformFunctionTableEncode0")) {
+        KernelBenchTransformTable("transformFunctionTableEncode0", transformFunctionTableEncode0, 0);
+    }
+    if (KernelBenchSelected("transformFunctionTableEncode1")) {
+        KernelBenchTransformTable("transformFunctionTableEncode1", transformFunctionTableEncode1, 0);
+    }
+    // The C_DEFAULT row of Table1 already holds SSE2 kernels
+    if (KernelBenchSelected("PfreqN2TransformTable")) {
+        KernelBenchTransformTable("PfreqN2TransformTable", PfreqN2TransformTable0, 1);
+    }
+    if (KernelBenchSelected("PfreqN4TransformTable")) {
+        KernelBenchTransformTable("PfreqN4TransformTable", PfreqN4TransformTable0, 2);
+    }
+    if (KernelBenchSelected("invTransformFunctionTableEstimate")) {
+        KernelBenchInvTransformTable("invTransformFunctionTableEstimate", invTransformFunctionTableEstimate);
+    }
+    if (KernelBenchSelected("invTransformFunctionTableEncode")) {
+        KernelBenchInvTransformTable("invTransformFunctionTableEncode", invTransformFunctionTableEncode);
+    }
+
+    for (blockIndex = 0; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT - 1; ++blockIndex) {
+        EB_U32      size      = KernelBenchBlockSizes[blockIndex];
+        EB_U32      sizeIndex = size >> 3;
+        const char *sizeName  = KernelBenchSizeName(size, size);
+        double      cycles[2] = { 0, 0 };
+
+        if (KernelBenchSelected("QiQ")) {
+            EB_U32 nonZeroCount[2] = { 0, 0 };
+            EB_U32 mismatchCount = 0;
+            EB_U32 qp = 0;
+            EB_U32 qFunc = 0, qOffset = 0;
+            EB_S32 shiftedQBits = 0, shiftedFFunc = 0, iqOffset = 0, shiftNum = 0;
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                EB_S32 qpRem, qpPer;
+                EB_U32 transformShiftNum = 7 - Log2f(size);
+
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchFillCoeff(coeffBuffer[0], KERNEL_BENCH_BUFFER_SIZE, 16384);
+                KernelBenchResetOutputs();
+
+                // Same derivation as the encoder's full loop
+                qp           = KernelBenchRandom() % 52;
+                qpRem        = (EB_S32)QpModSix[qp];
+                qpPer        = (EB_S32)QpDivSix[qp];
+                qFunc        = QFunc[qpRem];
+                shiftedQBits = QUANT_SHIFT + qpPer + transformShiftNum;
+                qOffset      = QUANT_OFFSET_I << (shiftedQBits - 9);
+                shiftedFFunc = (qpPer > 8) ? (EB_S32)FFunc[qpRem] << (qpPer - 2) : (EB_S32)FFunc[qpRem] << qpPer;
+                shiftNum     = (qpPer > 8) ? QUANT_IQUANT_SHIFT - QUANT_SHIFT - transformShiftNum - 2 : QUANT_IQUANT_SHIFT - QUANT_SHIFT - transformShiftNum;
+                iqOffset     = 1 << (shiftNum - 1);
+
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    QiQ_funcPtrArray[slot][sizeIndex](
+                        coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                        outputBuffer16bit[slot], outputBufferAux[slot],
+                        qFunc, qOffset, shiftedQBits, shiftedFFunc, iqOffset, shiftNum,
+                        size, &nonZeroCount[slot]);
+                }
+                mismatchCount += (simdEnabled && (!KernelBenchOutputsMatch() || nonZeroCount[0] != nonZeroCount[1]));
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], QiQ_funcPtrArray[slot][sizeIndex](
+                    coeffBuffer[0], KERNEL_BENCH_STRIDE,
+                    outputBuffer16bit[slot], outputBufferAux[slot],
+                    qFunc, qOffset, shiftedQBits, shiftedFFunc, iqOffset, shiftNum,
+                    size, &nonZeroCount[slot]));
+            }
+            KernelBenchReport("QiQ", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (KernelBenchSelected("MatMul")) {
+            EB_U16 maskingMatrix[32 * 32];
+            EB_U32 nonZeroCount[2] = { 0, 0 };
+            EB_U32 mismatchCount = 0;
+            EB_U32 index;
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchFillCoeff(coeffBuffer[0], KERNEL_BENCH_BUFFER_SIZE, 16384);
+                for (index = 0; index < 32 * 32; ++index) {
+                    // PMP_MAX is 256
+                    maskingMatrix[index] = (EB_U16)(KernelBenchRandom() % 257);
+                }
+                memcpy(outputBuffer16bit[0], coeffBuffer[0], sizeof(outputBuffer16bit[0]));
+                memcpy(outputBuffer16bit[1], coeffBuffer[0], sizeof(outputBuffer16bit[1]));
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    MatMul_funcPtrArray[slot][sizeIndex](
+                        outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                        maskingMatrix, size, size,
+                        128, 8, &nonZeroCount[slot]);
+                }
+                mismatchCount += (simdEnabled &&
+                    (memcmp(outputBuffer16bit[0], outputBuffer16bit[1], sizeof(outputBuffer16bit[0])) != 0 || nonZeroCount[0] != nonZeroCount[1]));
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], MatMul_funcPtrArray[slot][sizeIndex](
+                    outputBuffer16bit[slot], KERNEL_BENCH_STRIDE,
+                    maskingMatrix, size, size,
+                    128, 8, &nonZeroCount[slot]));
+            }
+            KernelBenchReport("MatMul", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+    }
+}
+
+/***************************************
+ * Intra prediction
+ ***************************************/
+typedef struct KernelBenchIntraTable_s {
+    const char                 *kernelName;
+    const EB_INTRA_NOANG_TYPE  *table8bit;
+    const EB_INTRA_NOANG_16bit_TYPE *table16bit;
+    EB_U32                      maxSize;
+} KernelBenchIntraTable_t;
+
+// Modes 27 to 33 and 19 to 25
+static const EB_S32 KernelBenchIntraPredAngle[14] = { 2, 5, 9, 13, 17, 21, 26, -2, -5, -9, -13, -17, -21, -26 };
+// Reference samples in front of refSampMain for the negative angles
+#define KERNEL_BENCH_REF_MAIN_OFFSET    (2 * 64)
+
+// The 16 bit planar table has C_DEFAULT, SSE2 and AVX2 slots
+static void KernelBenchIntraPlanar16bit(const char *kernelName)
+{
+    EB_U32 blockIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    for (blockIndex = 0; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT - 1; ++blockIndex) {
+        EB_U32 size = KernelBenchBlockSizes[blockIndex];
+        EB_U32 mismatchCount = 0;
+        double cycles[2] = { 0, 0 };
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchResetOutputs();
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                IntraPlanar_16bit_funcPtrArray[slot ? simdRow : slot](size, inputBuffer16bit[0], (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE);
+            }
+            mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], IntraPlanar_16bit_funcPtrArray[slot ? simdRow : slot](size, inputBuffer16bit[0], (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE));
+        }
+        KernelBenchReport(kernelName, KernelBenchSizeName(size, size), cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+// tableIndex 0 to 3: vertical, horizontal, 16 bit vertical and 16 bit horizontal.
+// The 16 bit vertical table has C_DEFAULT, SSE2 and AVX2 slots
+static void KernelBenchIntraAngular(
+    EB_U32      tableIndex,
+    const char *kernelName)
+{
+    const EB_U32 refMainOffset = KERNEL_BENCH_REF_MAIN_OFFSET;
+    EB_U32 blockIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    for (blockIndex = 0; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT - 1; ++blockIndex) {
+        EB_U32 size = KernelBenchBlockSizes[blockIndex];
+        EB_U32 mismatchCount = 0;
+        EB_S32 angle = 0;
+        double cycles[2] = { 0, 0 };
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchResetOutputs();
+            angle = KernelBenchIntraPredAngle[KernelBenchRandom() % 14];
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                switch (tableIndex) {
+                case 0:
+                    IntraAngVertical_funcPtrArray[slot](size, inputBuffer8bit[0] + refMainOffset, outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE, angle);
+                    break;
+                case 1:
+                    IntraAngHorizontal_funcPtrArray[slot](size, inputBuffer8bit[0] + refMainOffset, outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE, angle);
+                    break;
+                case 2:
+                    IntraAngVertical_16bit_funcPtrArray[slot ? simdRow : slot](size, inputBuffer16bit[0] + refMainOffset, (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE, angle);
+                    break;
+                default:
+                    IntraAngHorizontal_16bit_funcPtrArray[slot](size, inputBuffer16bit[0] + refMainOffset, (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE, angle);
+                    break;
+                }
+            }
+            mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            switch (tableIndex) {
+            case 0:
+                KERNEL_BENCH_TIME(cycles[slot], IntraAngVertical_funcPtrArray[slot](size, inputBuffer8bit[0] + refMainOffset, outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE, angle));
+                break;
+            case 1:
+                KERNEL_BENCH_TIME(cycles[slot], IntraAngHorizontal_funcPtrArray[slot](size, inputBuffer8bit[0] + refMainOffset, outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE, angle));
+                break;
+            case 2:
+                KERNEL_BENCH_TIME(cycles[slot], IntraAngVertical_16bit_funcPtrArray[slot ? simdRow : slot](size, inputBuffer16bit[0] + refMainOffset, (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE, angle));
+                break;
+            default:
+                KERNEL_BENCH_TIME(cycles[slot], IntraAngHorizontal_16bit_funcPtrArray[slot](size, inputBuffer16bit[0] + refMainOffset, (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE, angle));
+                break;
+            }
+        }
+        KernelBenchReport(kernelName, KernelBenchSizeName(size, size), cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+static void KernelBenchIntra(void)
+{
+    static const KernelBenchIntraTable_t intraTable[] = {
+        { "IntraVerticalLuma",      IntraVerticalLuma_funcPtrArray,     IntraVerticalLuma_16bit_funcPtrArray,   32 },
+        { "IntraVerticalChroma",    IntraVerticalChroma_funcPtrArray,   IntraVerticalChroma_16bit_funcPtrArray, 32 },
+        { "IntraHorzLuma",          IntraHorzLuma_funcPtrArray,         IntraHorzLuma_16bit_funcPtrArray,       32 },
+        { "IntraHorzChroma",        IntraHorzChroma_funcPtrArray,       IntraHorzChroma_16bit_funcPtrArray,     32 },
+        { "IntraDCLuma",            IntraDCLuma_funcPtrArray,           IntraDCLuma_16bit_funcPtrArray,         32 },
+        { "IntraDCChroma",          IntraDCChroma_funcPtrArray,         IntraDCChroma_16bit_funcPtrArray,       32 },
+        { "IntraPlanar",            IntraPlanar_funcPtrArray,           NULL,                                   32 },
+        { "IntraAng34",             IntraAng34_funcPtrArray,            IntraAng34_16bit_funcPtrArray,          32 },
+        { "IntraAng18",             IntraAng18_funcPtrArray,            IntraAng18_16bit_funcPtrArray,          32 },
+        { "IntraAng2",              IntraAng2_funcPtrArray,             IntraAng2_16bit_funcPtrArray,           32 },
+    };
+    static const char *angularName[4] = {
+        "IntraAngVertical", "IntraAngHorizontal", "IntraAngVertical_16bit", "IntraAngHorizontal_16bit"
+    };
+    EB_U32 tableIndex;
+    EB_U32 blockIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+    char   kernelName[64];
+
+    for (tableIndex = 0; tableIndex < sizeof(intraTable) / sizeof(intraTable[0]); ++tableIndex) {
+        for (blockIndex = 0; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT; ++blockIndex) {
+            EB_U32      size     = KernelBenchBlockSizes[blockIndex];
+            const char *sizeName = KernelBenchSizeName(size, size);
+            EB_U32      bitDepthIndex;
+
+            if (size > intraTable[tableIndex].maxSize) {
+                continue;
+            }
+            for (bitDepthIndex = 0; bitDepthIndex < 2; ++bitDepthIndex) {
+                EB_U32 mismatchCount = 0;
+                double cycles[2] = { 0, 0 };
+
+                sprintf(kernelName, "%s%s", intraTable[tableIndex].kernelName, bitDepthIndex ? "_16bit" : "");
+                // Three slot tables have their own loops
+                if (!KernelBenchSelected(kernelName) || (bitDepthIndex && intraTable[tableIndex].table16bit == NULL)) {
+                    continue;
+                }
+                for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                    KernelBenchFillInputs(trialIndex);
+                    KernelBenchResetOutputs();
+                    for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                        if (bitDepthIndex) {
+                            intraTable[tableIndex].table16bit[slot](size, inputBuffer16bit[0], (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE);
+                        }
+                        else {
+                            intraTable[tableIndex].table8bit[slot](size, inputBuffer8bit[0], outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE);
+                        }
+                    }
+                    mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+                }
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    if (bitDepthIndex) {
+                        KERNEL_BENCH_TIME(cycles[slot], intraTable[tableIndex].table16bit[slot](size, inputBuffer16bit[0], (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE));
+                    }
+                    else {
+                        KERNEL_BENCH_TIME(cycles[slot], intraTable[tableIndex].table8bit[slot](size, inputBuffer8bit[0], outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, EB_FALSE));
+                    }
+                }
+                KernelBenchReport(kernelName, sizeName, cycles[0], cycles[1], mismatchCount);
+            }
+        }
+    }
+
+    if (KernelBenchSelected("IntraPlanar_16bit")) {
+        KernelBenchIntraPlanar16bit("IntraPlanar_16bit");
+    }
+    for (tableIndex = 0; tableIndex < 4; ++tableIndex) {
+        if (KernelBenchSelected(angularName[tableIndex])) {
+            KernelBenchIntraAngular(tableIndex, angularName[tableIndex]);
+        }
+    }
+}
+
+/***************************************
+ * Deblocking filter
+ *   Each call filters one 4 sample luma or
+ *   2 sample chroma edge segment in place
+ ***************************************/
+static void KernelBenchDeblocking(void)
+{
+    EB_U32 tableIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    for (tableIndex = 0; tableIndex < 4; ++tableIndex) {
+        static const char *deblockingName[4] = {
+            "Luma4SampleEdgeDLFCore", "Chroma2SampleEdgeDLFCore", "lumaDlf16bit", "chromaDlf16bit"
+        };
+        EB_U32 edgeIndex;
+
+        if (!KernelBenchSelected(deblockingName[tableIndex])) {
+            continue;
+        }
+        for (edgeIndex = 0; edgeIndex < 2; ++edgeIndex) {
+            EB_BOOL isVerticalEdge = edgeIndex ? EB_TRUE : EB_FALSE;
+            EB_U32  mismatchCount = 0;
+            EB_S32  tc = 0, beta = 0;
+            double  cycles[2] = { 0, 0 };
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                tc   = KernelBenchRandomRange(0, 24);
+                beta = KernelBenchRandomRange(0, 64);
+                for (slot = 0; slot < 2; ++slot) {
+                    memcpy(outputBuffer8bit[slot], inputBuffer8bit[0], sizeof(outputBuffer8bit[slot]));
+                    memcpy(outputBuffer16bit[slot], inputBuffer16bit[0], sizeof(outputBuffer16bit[slot]));
+                    memcpy(outputBufferAux[slot], inputBuffer16bit[1], sizeof(outputBufferAux[slot]));
+                }
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    switch (tableIndex) {
+                    case 0:
+                        Luma4SampleEdgeDLFCore_Table[slot](outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, tc, beta);
+                        break;
+                    case 1:
+                        Chroma2SampleEdgeDLFCore_Table[slot](outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, outputBuffer8bit[slot] + 2 * KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, (EB_U8)tc, (EB_U8)(tc >> 1));
+                        break;
+                    case 2:
+                        lumaDlf_funcPtrArray16bit[slot]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, tc << 2, beta << 2);
+                        break;
+                    default:
+                        chromaDlf_funcPtrArray16bit[slot]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, (EB_U16*)outputBufferAux[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, (EB_U8)tc, (EB_U8)(tc >> 1));
+                        break;
+                    }
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                switch (tableIndex) {
+                case 0:
+                    KERNEL_BENCH_TIME(cycles[slot], Luma4SampleEdgeDLFCore_Table[slot](outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, tc, beta));
+                    break;
+                case 1:
+                    KERNEL_BENCH_TIME(cycles[slot], Chroma2SampleEdgeDLFCore_Table[slot](outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, outputBuffer8bit[slot] + 2 * KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, (EB_U8)tc, (EB_U8)(tc >> 1)));
+                    break;
+                case 2:
+                    KERNEL_BENCH_TIME(cycles[slot], lumaDlf_funcPtrArray16bit[slot]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, tc << 2, beta << 2));
+                    break;
+                default:
+                    KERNEL_BENCH_TIME(cycles[slot], chromaDlf_funcPtrArray16bit[slot]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, (EB_U16*)outputBufferAux[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, (EB_U8)tc, (EB_U8)(tc >> 1)));
+                    break;
+                }
+            }
+            KernelBenchReport(deblockingName[tableIndex], isVerticalEdge ? "vertical" : "horiz", cycles[0], cycles[1], mismatchCount);
+        }
+    }
+}
+
+/***************************************
+ * 16 bit deblocking, 8 sample edges
+ *   Each call filters the two 4 sample luma or
+ *   four 2 sample chroma segments of an 8x8 block
+ *   edge; about a quarter of the segments are
+ *   disabled so the per-segment fallback is checked
+ ***************************************/
+static void KernelBenchDeblocking8Sample16bit(const char *kernelSuffix)
+{
+    EB_U32 tableIndex;
+    EB_U32 trialIndex;
+    EB_U32 segmentIndex;
+    EB_U32 slot;
+    char   kernelName[64];
+
+    for (tableIndex = 0; tableIndex < 2; ++tableIndex) {
+        static const char *deblockingName[2] = { "lumaDlf8Sample16bit", "chromaDlf8Sample16bit" };
+        EB_U32 edgeIndex;
+
+        sprintf(kernelName, "%s%s", deblockingName[tableIndex], kernelSuffix);
+        if (!KernelBenchSelected(kernelName)) {
+            continue;
+        }
+        for (edgeIndex = 0; edgeIndex < 2; ++edgeIndex) {
+            EB_BOOL isVerticalEdge = edgeIndex ? EB_TRUE : EB_FALSE;
+            EB_U32  mismatchCount = 0;
+            EB_S32  tcArray[2];
+            EB_S32  betaArray[2];
+            EB_U8   cbTcArray[4];
+            EB_U8   crTcArray[4];
+            double  cycles[2] = { 0, 0 };
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                for (segmentIndex = 0; segmentIndex < 2; ++segmentIndex) {
+                    tcArray[segmentIndex]   = KernelBenchRandomRange(0, 24) << 2;
+                    betaArray[segmentIndex] = KernelBenchRandomRange(0, 3) ? KernelBenchRandomRange(1, 64) << 2 : 0;
+                }
+                for (segmentIndex = 0; segmentIndex < 4; ++segmentIndex) {
+                    cbTcArray[segmentIndex] = KernelBenchRandomRange(0, 3) ? (EB_U8)KernelBenchRandomRange(1, 96) : 0;
+                    crTcArray[segmentIndex] = (EB_U8)KernelBenchRandomRange(0, 96);
+                }
+                for (slot = 0; slot < 2; ++slot) {
+                    memcpy(outputBuffer16bit[slot], inputBuffer16bit[0], sizeof(outputBuffer16bit[slot]));
+                    memcpy(outputBufferAux[slot], inputBuffer16bit[1], sizeof(outputBufferAux[slot]));
+                }
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    if (tableIndex == 0) {
+                        lumaDlf8Sample_funcPtrArray16bit[slot ? simdRow : slot]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, tcArray, betaArray);
+                    }
+                    else {
+                        chromaDlf8Sample_funcPtrArray16bit[slot ? simdRow : slot]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, (EB_U16*)outputBufferAux[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, cbTcArray, crTcArray);
+                    }
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+
+            // Timed with every segment enabled
+            for (segmentIndex = 0; segmentIndex < 2; ++segmentIndex) {
+                tcArray[segmentIndex]   = 8 << 2;
+                betaArray[segmentIndex] = 32 << 2;
+            }
+            for (segmentIndex = 0; segmentIndex < 4; ++segmentIndex) {
+                cbTcArray[segmentIndex] = 32;
+                crTcArray[segmentIndex] = 16;
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                if (tableIndex == 0) {
+                    KERNEL_BENCH_TIME(cycles[slot], lumaDlf8Sample_funcPtrArray16bit[slot ? simdRow : slot]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, tcArray, betaArray));
+                }
+                else {
+                    KERNEL_BENCH_TIME(cycles[slot], chromaDlf8Sample_funcPtrArray16bit[slot ? simdRow : slot]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, (EB_U16*)outputBufferAux[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, isVerticalEdge, cbTcArray, crTcArray));
+                }
+            }
+            KernelBenchReport(kernelName, isVerticalEdge ? "vertical" : "horiz", cycles[0], cycles[1], mismatchCount);
+        }
+    }
+}
+
+/***************************************
+ * Motion compensation
+ *   The bi-prediction filters store their
+ *   14 bit output in the layout their own
+ *   clipping kernel reads, so both lists and
+ *   the clipping are run and timed together
+ ***************************************/
+#define KERNEL_BENCH_LUMA_UNI_8BIT      0
+#define KERNEL_BENCH_LUMA_BI_8BIT       1
+#define KERNEL_BENCH_LUMA_UNI_16BIT     2
+#define KERNEL_BENCH_LUMA_BI_16BIT      3
+#define KERNEL_BENCH_MCP_TABLE_COUNT    4
+
+static void KernelBenchLumaPrediction(
+    EB_U32 tableIndex,
+    EB_U32 slot,
+    EB_U32 positionIndex,
+    EB_U32 size)
+{
+    EB_U8  *ref8bit[2]  = { inputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, inputBuffer8bit[1] + KERNEL_BENCH_BLOCK_ORIGIN };
+    EB_U16 *ref16bit[2] = { inputBuffer16bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, inputBuffer16bit[1] + KERNEL_BENCH_BLOCK_ORIGIN };
+    EB_U32  listIndex;
+
+    switch (tableIndex) {
+    case KERNEL_BENCH_LUMA_UNI_8BIT:
+        uniPredLumaIFFunctionPtrArrayNew[slot ? simdRow : slot][positionIndex](ref8bit[0], KERNEL_BENCH_STRIDE, outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, size, size, scratchBuffer);
+        break;
+    case KERNEL_BENCH_LUMA_BI_8BIT:
+        for (listIndex = 0; listIndex < 2; ++listIndex) {
+            biPredLumaIFFunctionPtrArrayNew[slot ? simdRow : slot][positionIndex](ref8bit[listIndex], KERNEL_BENCH_STRIDE, biPredBuffer[slot][listIndex], size, size, scratchBuffer);
+        }
+        biPredClippingFuncPtrArray[slot](size, size, biPredBuffer[slot][0], biPredBuffer[slot][1], outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, Offset5);
+        break;
+    case KERNEL_BENCH_LUMA_UNI_16BIT:
+        uniPredLuma16bitIFFunctionPtrArray[slot][positionIndex](ref16bit[0], KERNEL_BENCH_STRIDE, (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, size, size, scratchBuffer);
+        break;
+    default:
+        for (listIndex = 0; listIndex < 2; ++listIndex) {
+            biPredLumaIFFunctionPtrArrayNew16bit[slot][positionIndex](ref16bit[listIndex], KERNEL_BENCH_STRIDE, biPredBuffer[slot][listIndex], size, size, scratchBuffer);
+        }
+        biPredClipping16bitFuncPtrArray[slot](size, size, biPredBuffer[slot][0], biPredBuffer[slot][1], (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE);
+        break;
+    }
+}
+
+static void KernelBenchChromaPrediction(
+    EB_U32 tableIndex,
+    EB_U32 slot,
+    EB_U32 positionIndex,
+    EB_U32 size)
+{
+    EB_U8  *ref8bit[2]  = { inputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, inputBuffer8bit[1] + KERNEL_BENCH_BLOCK_ORIGIN };
+    EB_U16 *ref16bit[2] = { inputBuffer16bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, inputBuffer16bit[1] + KERNEL_BENCH_BLOCK_ORIGIN };
+    EB_U32  fracPosx = positionIndex & 7;
+    EB_U32  fracPosy = positionIndex >> 3;
+    EB_U32  listIndex;
+
+    switch (tableIndex) {
+    case KERNEL_BENCH_LUMA_UNI_8BIT:
+        uniPredChromaIFFunctionPtrArrayNew[slot][positionIndex](ref8bit[0], KERNEL_BENCH_STRIDE, outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, size, size, scratchBuffer, fracPosx, fracPosy);
+        break;
+    case KERNEL_BENCH_LUMA_BI_8BIT:
+        for (listIndex = 0; listIndex < 2; ++listIndex) {
+            biPredChromaIFFunctionPtrArrayNew[slot][positionIndex](ref8bit[listIndex], KERNEL_BENCH_STRIDE, biPredBuffer[slot][listIndex], size, size, scratchBuffer, fracPosx, fracPosy);
+        }
+        biPredClippingFuncPtrArray[slot](size, size, biPredBuffer[slot][0], biPredBuffer[slot][1], outputBuffer8bit[slot], KERNEL_BENCH_STRIDE, Offset5);
+        break;
+    case KERNEL_BENCH_LUMA_UNI_16BIT:
+        uniPredChromaIFFunctionPtrArrayNew16bit[slot][positionIndex](ref16bit[0], KERNEL_BENCH_STRIDE, (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE, size, size, scratchBuffer, fracPosx, fracPosy);
+        break;
+    default:
+        for (listIndex = 0; listIndex < 2; ++listIndex) {
+            biPredChromaIFFunctionPtrArrayNew16bit[slot][positionIndex](ref16bit[listIndex], KERNEL_BENCH_STRIDE, biPredBuffer[slot][listIndex], size, size, scratchBuffer, fracPosx, fracPosy);
+        }
+        biPredClipping16bitFuncPtrArray[slot](size, size, biPredBuffer[slot][0], biPredBuffer[slot][1], (EB_U16*)outputBuffer16bit[slot], KERNEL_BENCH_STRIDE);
+        break;
+    }
+}
+
+static void KernelBenchLumaTable(
+    EB_U32      tableIndex,
+    const char *tableName)
+{
+    // Luma fractional positions, fracPosx + (fracPosy << 2)
+    static const char *lumaPositionName = "Aabcdefghijknpqr";
+    EB_U32 blockIndex;
+    EB_U32 positionIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+    char   kernelName[64];
+
+    for (blockIndex = 0; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT; ++blockIndex) {
+        EB_U32 size = KernelBenchBlockSizes[blockIndex];
+
+        for (positionIndex = 0; positionIndex < 16; ++positionIndex) {
+            EB_U32 mismatchCount = 0;
+            double cycles[2] = { 0, 0 };
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    KernelBenchLumaPrediction(tableIndex, slot, positionIndex, size);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], KernelBenchLumaPrediction(tableIndex, slot, positionIndex, size));
+            }
+            sprintf(kernelName, "%s[%c]", tableName, lumaPositionName[positionIndex]);
+            KernelBenchReport(kernelName, KernelBenchSizeName(size, size), cycles[0], cycles[1], mismatchCount);
+        }
+    }
+}
+
+// Widths of the PUs and AMP partitions, even heights
+static void KernelBenchBiPredAverage(
+    const char     *kernelName,
+    EB_BIAVG_FUNC   simdKernel)
+{
+    static const EB_U32 averageWidth[8] = { 4, 8, 12, 16, 24, 32, 48, 64 };
+    static const EB_U32 averageHeight[8] = { 4, 8, 16, 16, 32, 32, 64, 64 };
+    const EB_BIAVG_FUNC kernel[2] = { BiPredAverageKernel_C, simdKernel };
+    EB_U32 sizeIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    for (sizeIndex = 0; sizeIndex < 8; ++sizeIndex) {
+        EB_U32 width = averageWidth[sizeIndex];
+        EB_U32 height = averageHeight[sizeIndex];
+        EB_U32 mismatchCount = 0;
+        double cycles[2] = { 0, 0 };
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchResetOutputs();
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                kernel[slot](
+                    inputBuffer8bit[0] + (trialIndex & 7), KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1] + (trialIndex >> 3), KERNEL_BENCH_STRIDE,
+                    outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN + (trialIndex & 15), KERNEL_BENCH_STRIDE,
+                    width, height);
+            }
+            mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], kernel[slot](
+                inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                width, height));
+        }
+        KernelBenchReport(kernelName, KernelBenchSizeName(width, height), cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+static void KernelBenchMcp(void)
+{
+    static const char *lumaTableName[KERNEL_BENCH_MCP_TABLE_COUNT] = {
+        "uniPredLumaIFFunctionPtrArrayNew", "biPredLumaIFFunctionPtrArrayNew",
+        "uniPredLuma16bitIFFunctionPtrArray", "biPredLumaIFFunctionPtrArrayNew16bit"
+    };
+    static const char *chromaTableName[KERNEL_BENCH_MCP_TABLE_COUNT] = {
+        "uniPredChromaIFFunctionPtrArrayNew", "biPredChromaIFFunctionPtrArrayNew",
+        "uniPredChromaIFFunctionPtrArrayNew16bit", "biPredChromaIFFunctionPtrArrayNew16bit"
+    };
+    EB_U32 blockIndex;
+    EB_U32 tableIndex;
+    EB_U32 positionIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    for (tableIndex = 0; tableIndex < KERNEL_BENCH_MCP_TABLE_COUNT; ++tableIndex) {
+        if (KernelBenchSelected(lumaTableName[tableIndex])) {
+            KernelBenchLumaTable(tableIndex, lumaTableName[tableIndex]);
+        }
+    }
+
+    if (KernelBenchSelected("BiPredAverage")) {
+        KernelBenchBiPredAverage("BiPredAverage", BiPredAverageKernel_funcPtrArray[KERNEL_BENCH_SIMD]);
+    }
+
+    // The 64 chroma fractional positions are reported as one line per block size
+    for (tableIndex = 0; tableIndex < KERNEL_BENCH_MCP_TABLE_COUNT; ++tableIndex) {
+        if (!KernelBenchSelected(chromaTableName[tableIndex])) {
+            continue;
+        }
+        for (blockIndex = 0; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT - 1; ++blockIndex) {
+            EB_U32 size = KernelBenchBlockSizes[blockIndex];
+            EB_U32 mismatchCount = 0;
+            double cycles[2] = { 0, 0 };
+            double cyclesTotal[2] = { 0, 0 };
+
+            for (positionIndex = 0; positionIndex < 64; ++positionIndex) {
+                for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS / 8; ++trialIndex) {
+                    KernelBenchFillInputs(trialIndex);
+                    KernelBenchResetOutputs();
+                    for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                        KernelBenchChromaPrediction(tableIndex, slot, positionIndex, size);
+                    }
+                    mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+                }
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    KERNEL_BENCH_TIME(cycles[slot], KernelBenchChromaPrediction(tableIndex, slot, positionIndex, size));
+                    cyclesTotal[slot] += cycles[slot] / 64;
+                }
+            }
+            KernelBenchReport(chromaTableName[tableIndex], KernelBenchSizeName(size, size), cyclesTotal[0], cyclesTotal[1], mismatchCount);
+        }
+    }
+
+    for (blockIndex = 0; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT; ++blockIndex) {
+        EB_U32 size = KernelBenchBlockSizes[blockIndex];
+
+        if (KernelBenchSelected("AvcStyleUniPredLumaIFFunctionPtrArray")) {
+            static const char *avcStyleName[3] = {
+                "AvcStyleUniPredLumaIFFunctionPtrArray[copy]",
+                "AvcStyleUniPredLumaIFFunctionPtrArray[horiz]",
+                "AvcStyleUniPredLumaIFFunctionPtrArray[vert]"
+            };
+
+            // The filters work on multiples of 8 samples, only the copy is called on 4 wide blocks
+            for (tableIndex = 0; tableIndex < (EB_U32)(size < 8 ? 1 : 3); ++tableIndex) {
+                EB_U32 mismatchCount = 0;
+                EB_U32 fracPos = 0;
+                double cycles[2] = { 0, 0 };
+
+                for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                    KernelBenchFillInputs(trialIndex);
+                    KernelBenchResetOutputs();
+                    fracPos = tableIndex ? 1 + (KernelBenchRandom() % 3) : 0;
+                    for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                        AvcStyleUniPredLumaIFFunctionPtrArray[slot][tableIndex](
+                            inputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                            outputBuffer8bit[slot], KERNEL_BENCH_STRIDE,
+                            size, size, scratchBuffer8bit, fracPos);
+                    }
+                    mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+                }
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    KERNEL_BENCH_TIME(cycles[slot], AvcStyleUniPredLumaIFFunctionPtrArray[slot][tableIndex](
+                        inputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                        outputBuffer8bit[slot], KERNEL_BENCH_STRIDE,
+                        size, size, scratchBuffer8bit, fracPos));
+                }
+                KernelBenchReport(avcStyleName[tableIndex], KernelBenchSizeName(size, size), cycles[0], cycles[1], mismatchCount);
+            }
+        }
+
+        if (KernelBenchSelected("PictureAverageArray")) {
+            EB_U32 mismatchCount = 0;
+            double cycles[2] = { 0, 0 };
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    PictureAverageArray[slot](
+                        inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                        inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                        outputBuffer8bit[slot], KERNEL_BENCH_STRIDE,
+                        size, size);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], PictureAverageArray[slot](
+                    inputBuffer8bit[0], KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1], KERNEL_BENCH_STRIDE,
+                    outputBuffer8bit[slot], KERNEL_BENCH_STRIDE,
+                    size, size));
+            }
+            KernelBenchReport("PictureAverageArray", KernelBenchSizeName(size, size), cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (KernelBenchSelected("PictureAverage1LineArray")) {
+            EB_U32 mismatchCount = 0;
+            double cycles[2] = { 0, 0 };
+
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchResetOutputs();
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    PictureAverage1LineArray[slot](inputBuffer8bit[0], inputBuffer8bit[1], outputBuffer8bit[slot], size);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], PictureAverage1LineArray[slot](inputBuffer8bit[0], inputBuffer8bit[1], outputBuffer8bit[slot], size));
+            }
+            KernelBenchReport("PictureAverage1LineArray", KernelBenchSizeName(size, 1), cycles[0], cycles[1], mismatchCount);
+        }
+    }
+}
+
+/***************************************
+ * Sample adaptive offset
+ ***************************************/
+// The C kernels also fill the spare last category of the edge statistics
+static EB_BOOL KernelBenchSaoStatsMatch(
+    EB_S32 boDiff[2][SAO_BO_INTERVALS],
+    EB_U16 boCount[2][SAO_BO_INTERVALS],
+    EB_S32 eoDiff[2][SAO_EO_TYPES][SAO_EO_CATEGORIES + 1],
+    EB_U16 eoCount[2][SAO_EO_TYPES][SAO_EO_CATEGORIES + 1])
+{
+    EB_U32 eoType;
+
+    if (memcmp(boDiff[0], boDiff[1], sizeof(boDiff[0])) != 0 ||
+        memcmp(boCount[0], boCount[1], sizeof(boCount[0])) != 0) {
+        return EB_FALSE;
+    }
+    for (eoType = 0; eoType < SAO_EO_TYPES; ++eoType) {
+        if (memcmp(eoDiff[0][eoType], eoDiff[1][eoType], SAO_EO_CATEGORIES * sizeof(EB_S32)) != 0 ||
+            memcmp(eoCount[0][eoType], eoCount[1][eoType], SAO_EO_CATEGORIES * sizeof(EB_U16)) != 0) {
+            return EB_FALSE;
+        }
+    }
+    return EB_TRUE;
+}
+
+// The 16 bit statistics and apply tables have C_DEFAULT, SSE2 and AVX2 slots
+static void KernelBenchSao16bit(
+    EB_U32      lcuSize,
+    const char *kernelSuffix)
+{
+    static const char *eoName[4] = { "SaoFunctionTableEO_0_16bit", "SaoFunctionTableEO_90_16bit", "SaoFunctionTableEO_135_16bit", "SaoFunctionTableEO_45_16bit" };
+    const char *sizeName = KernelBenchSizeName(lcuSize, lcuSize);
+    EB_S32      boDiff[2][SAO_BO_INTERVALS];
+    EB_U16      boCount[2][SAO_BO_INTERVALS];
+    EB_S32      eoDiff[2][SAO_EO_TYPES][SAO_EO_CATEGORIES + 1];
+    EB_U16      eoCount[2][SAO_EO_TYPES][SAO_EO_CATEGORIES + 1];
+    EB_S8       eoOffset[8];
+    EB_S8       boOffset[5];
+    EB_U32      bandPosition = 0;
+    EB_U32      mismatchCount;
+    EB_U32      trialIndex;
+    EB_U32      eoIndex;
+    EB_U32      slot;
+    double      cycles[2] = { 0, 0 };
+    char        kernelName[64];
+
+    sprintf(kernelName, "SaoGatherFunctionTabl_16bit%s", kernelSuffix);
+    if (KernelBenchSelected(kernelName)) {
+        mismatchCount = 0;
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchFillRecon();
+            memset(boDiff, 0, sizeof(boDiff));
+            memset(boCount, 0, sizeof(boCount));
+            memset(eoDiff, 0, sizeof(eoDiff));
+            memset(eoCount, 0, sizeof(eoCount));
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                SaoGatherFunctionTabl_16bit[slot ? simdRow : slot][1](
+                    inputBuffer16bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                    inputBuffer16bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                    lcuSize, lcuSize, boDiff[slot], boCount[slot], eoDiff[slot], eoCount[slot]);
+            }
+            mismatchCount += (simdEnabled && !KernelBenchSaoStatsMatch(boDiff, boCount, eoDiff, eoCount));
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], SaoGatherFunctionTabl_16bit[slot ? simdRow : slot][1](
+                inputBuffer16bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                inputBuffer16bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                lcuSize, lcuSize, boDiff[slot], boCount[slot], eoDiff[slot], eoCount[slot]));
+        }
+        KernelBenchReport(kernelName, sizeName, cycles[0], cycles[1], mismatchCount);
+    }
+
+    sprintf(kernelName, "SaoGatherFunctionTable_90_45_135_16bit%s", kernelSuffix);
+    if (KernelBenchSelected(kernelName)) {
+        mismatchCount = 0;
+        memset(boDiff, 0, sizeof(boDiff));
+        memset(boCount, 0, sizeof(boCount));
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchFillRecon();
+            memset(eoDiff, 0, sizeof(eoDiff));
+            memset(eoCount, 0, sizeof(eoCount));
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                SaoGatherFunctionTable_90_45_135_16bit_SSE2[slot ? simdRow : slot][1](
+                    inputBuffer16bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                    inputBuffer16bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                    lcuSize, lcuSize, eoDiff[slot], eoCount[slot]);
+            }
+            mismatchCount += (simdEnabled && !KernelBenchSaoStatsMatch(boDiff, boCount, eoDiff, eoCount));
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], SaoGatherFunctionTable_90_45_135_16bit_SSE2[slot ? simdRow : slot][1](
+                inputBuffer16bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                inputBuffer16bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                lcuSize, lcuSize, eoDiff[slot], eoCount[slot]));
+        }
+        KernelBenchReport(kernelName, sizeName, cycles[0], cycles[1], mismatchCount);
+    }
+
+    // The SIMD apply kernels are only dispatched for 32 and 64 wide LCUs
+    if (lcuSize < 32) {
+        return;
+    }
+
+    // Same layouts as the encoder: edge offsets with the flat category and
+    // the padding zeroed, band offsets followed by a zero
+    eoOffset[0] = boOffset[0] = (EB_S8)KernelBenchRandomRange(0, 7);
+    eoOffset[1] = boOffset[1] = (EB_S8)KernelBenchRandomRange(0, 7);
+    eoOffset[3] = boOffset[2] = (EB_S8)KernelBenchRandomRange(-7, 0);
+    eoOffset[4] = boOffset[3] = (EB_S8)KernelBenchRandomRange(-7, 0);
+    eoOffset[2] = eoOffset[5] = eoOffset[6] = eoOffset[7] = boOffset[4] = 0;
+
+    sprintf(kernelName, "SaoFunctionTableBo_16bit%s", kernelSuffix);
+    if (KernelBenchSelected(kernelName)) {
+        mismatchCount = 0;
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchResetOutputs();
+            bandPosition = KernelBenchRandom() % 29;
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                memcpy(outputBuffer16bit[slot], inputBuffer16bit[0], sizeof(outputBuffer16bit[slot]));
+                SaoFunctionTableBo_16bit[slot ? simdRow : slot][1]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, bandPosition, boOffset, lcuSize, lcuSize);
+            }
+            mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            KERNEL_BENCH_TIME(cycles[slot], SaoFunctionTableBo_16bit[slot ? simdRow : slot][1]((EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, bandPosition, boOffset, lcuSize, lcuSize));
+        }
+        KernelBenchReport(kernelName, sizeName, cycles[0], cycles[1], mismatchCount);
+    }
+
+    // The temporal buffers hold the unfiltered neighbouring column and row
+    for (eoIndex = 0; eoIndex < 4; ++eoIndex) {
+        sprintf(kernelName, "%s%s", eoName[eoIndex], kernelSuffix);
+        if (!KernelBenchSelected(kernelName)) {
+            continue;
+        }
+        mismatchCount = 0;
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchFillInputs(trialIndex);
+            KernelBenchResetOutputs();
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                EB_U16 *recon16bit = (EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN;
+
+                memcpy(outputBuffer16bit[slot], inputBuffer16bit[0], sizeof(outputBuffer16bit[slot]));
+                if (eoIndex < 2) {
+                    SaoFunctionTableEO_0_90_16bit[slot ? simdRow : slot][eoIndex][1](recon16bit, KERNEL_BENCH_STRIDE, inputBuffer16bit[1], eoOffset, lcuSize, lcuSize);
+                }
+                else {
+                    SaoFunctionTableEO_135_45_16bit[slot ? simdRow : slot][eoIndex - 2][1](recon16bit, KERNEL_BENCH_STRIDE, inputBuffer16bit[1], inputBuffer16bit[2] + 1, eoOffset, lcuSize, lcuSize);
+                }
+            }
+            mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            EB_U16 *recon16bit = (EB_U16*)outputBuffer16bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN;
+
+            if (eoIndex < 2) {
+                KERNEL_BENCH_TIME(cycles[slot], SaoFunctionTableEO_0_90_16bit[slot ? simdRow : slot][eoIndex][1](recon16bit, KERNEL_BENCH_STRIDE, inputBuffer16bit[1], eoOffset, lcuSize, lcuSize));
+            }
+            else {
+                KERNEL_BENCH_TIME(cycles[slot], SaoFunctionTableEO_135_45_16bit[slot ? simdRow : slot][eoIndex - 2][1](recon16bit, KERNEL_BENCH_STRIDE, inputBuffer16bit[1], inputBuffer16bit[2] + 1, eoOffset, lcuSize, lcuSize));
+            }
+        }
+        KernelBenchReport(kernelName, sizeName, cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+static void KernelBenchSao(void)
+{
+    EB_U32 blockIndex;
+    EB_U32 trialIndex;
+    EB_U32 slot;
+
+    for (blockIndex = 2; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT; ++blockIndex) {
+        EB_U32      lcuSize  = KernelBenchBlockSizes[blockIndex];
+        const char *sizeName = KernelBenchSizeName(lcuSize, lcuSize);
+        EB_S32      boDiff[2][SAO_BO_INTERVALS];
+        EB_U16      boCount[2][SAO_BO_INTERVALS];
+        EB_S32      eoDiff[2][SAO_EO_TYPES][SAO_EO_CATEGORIES + 1];
+        EB_U16      eoCount[2][SAO_EO_TYPES][SAO_EO_CATEGORIES + 1];
+        EB_S8       eoOffset[8];
+        EB_S8       boOffset[5];
+        EB_U32      bandPosition = 0;
+        EB_U32      mismatchCount;
+        double      cycles[2] = { 0, 0 };
+
+        if (KernelBenchSelected("SaoGatherFunctionTableLossy")) {
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchFillRecon();
+                memset(boDiff, 0, sizeof(boDiff));
+                memset(boCount, 0, sizeof(boCount));
+                memset(eoDiff, 0, sizeof(eoDiff));
+                memset(eoCount, 0, sizeof(eoCount));
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    SaoGatherFunctionTableLossy[slot](
+                        inputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                        inputBuffer8bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                        lcuSize, lcuSize, boDiff[slot], boCount[slot], eoDiff[slot], eoCount[slot]);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchSaoStatsMatch(boDiff, boCount, eoDiff, eoCount));
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], SaoGatherFunctionTableLossy[slot](
+                    inputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                    lcuSize, lcuSize, boDiff[slot], boCount[slot], eoDiff[slot], eoCount[slot]));
+            }
+            KernelBenchReport("SaoGatherFunctionTableLossy", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (KernelBenchSelected("SaoGatherFunctionTableLossy_90_45_135")) {
+            mismatchCount = 0;
+            memset(boDiff, 0, sizeof(boDiff));
+            memset(boCount, 0, sizeof(boCount));
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                KernelBenchFillRecon();
+                memset(eoDiff, 0, sizeof(eoDiff));
+                memset(eoCount, 0, sizeof(eoCount));
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    SaoGatherFunctionTableLossy_90_45_135[slot](
+                        inputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                        inputBuffer8bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                        lcuSize, lcuSize, eoDiff[slot], eoCount[slot]);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchSaoStatsMatch(boDiff, boCount, eoDiff, eoCount));
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], SaoGatherFunctionTableLossy_90_45_135[slot](
+                    inputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                    inputBuffer8bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE,
+                    lcuSize, lcuSize, eoDiff[slot], eoCount[slot]));
+            }
+            KernelBenchReport("SaoGatherFunctionTableLossy_90_45_135", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        KernelBenchSao16bit(lcuSize, "");
+
+        // The apply kernels filter the reconstruction in place, the temporal
+        // buffers hold the unfiltered neighbouring column and row. Their SIMD
+        // versions are only dispatched for 32 and 64 wide LCUs.
+        if (lcuSize < 32) {
+            continue;
+        }
+
+        // Same layouts as the encoder: edge offsets with the flat category
+        // and the padding zeroed, band offsets followed by a zero
+        eoOffset[0] = boOffset[0] = (EB_S8)KernelBenchRandomRange(0, 7);
+        eoOffset[1] = boOffset[1] = (EB_S8)KernelBenchRandomRange(0, 7);
+        eoOffset[3] = boOffset[2] = (EB_S8)KernelBenchRandomRange(-7, 0);
+        eoOffset[4] = boOffset[3] = (EB_S8)KernelBenchRandomRange(-7, 0);
+        eoOffset[2] = eoOffset[5] = eoOffset[6] = eoOffset[7] = boOffset[4] = 0;
+
+        if (KernelBenchSelected("SaoFunctionTableBo")) {
+            mismatchCount = 0;
+            for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                KernelBenchFillInputs(trialIndex);
+                bandPosition = KernelBenchRandom() % 29;
+                for (slot = 0; slot < 2; ++slot) {
+                    memcpy(outputBuffer8bit[slot], inputBuffer8bit[0], sizeof(outputBuffer8bit[slot]));
+                    memcpy(outputBuffer16bit[slot], inputBuffer16bit[0], sizeof(outputBuffer16bit[slot]));
+                    memset(outputBufferAux[slot], 0, sizeof(outputBufferAux[slot]));
+                }
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    SaoFunctionTableBo[slot][1](outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, bandPosition, boOffset, lcuSize, lcuSize);
+                }
+                mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                KERNEL_BENCH_TIME(cycles[slot], SaoFunctionTableBo[slot][1](outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, bandPosition, boOffset, lcuSize, lcuSize));
+            }
+            KernelBenchReport("SaoFunctionTableBo", sizeName, cycles[0], cycles[1], mismatchCount);
+        }
+
+        if (KernelBenchSelected("SaoFunctionTableEO")) {
+            static const char *eoName[4] = { "SaoFunctionTableEO_0", "SaoFunctionTableEO_90", "SaoFunctionTableEO_135", "SaoFunctionTableEO_45" };
+            EB_U32 eoIndex;
+
+            for (eoIndex = 0; eoIndex < 4; ++eoIndex) {
+                mismatchCount = 0;
+                for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+                    KernelBenchFillInputs(trialIndex);
+                    for (slot = 0; slot < 2; ++slot) {
+                        memcpy(outputBuffer8bit[slot], inputBuffer8bit[0], sizeof(outputBuffer8bit[slot]));
+                        memcpy(outputBuffer16bit[slot], inputBuffer16bit[0], sizeof(outputBuffer16bit[slot]));
+                        memset(outputBufferAux[slot], 0, sizeof(outputBufferAux[slot]));
+                    }
+                    for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                        EB_U8  *recon8bit  = outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN;
+
+                        if (eoIndex < 2) {
+                            SaoFunctionTableEO_0_90[slot][eoIndex][1](recon8bit, KERNEL_BENCH_STRIDE, inputBuffer8bit[1], eoOffset, lcuSize, lcuSize);
+                        }
+                        else {
+                            SaoFunctionTableEO_135_45[slot][eoIndex - 2][0][1](recon8bit, KERNEL_BENCH_STRIDE, inputBuffer8bit[1], inputBuffer8bit[2], eoOffset, lcuSize, lcuSize);
+                        }
+                    }
+                    mismatchCount += (simdEnabled && !KernelBenchOutputsMatch());
+                }
+                for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                    if (eoIndex < 2) {
+                        KERNEL_BENCH_TIME(cycles[slot], SaoFunctionTableEO_0_90[slot][eoIndex][1](outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, inputBuffer8bit[1], eoOffset, lcuSize, lcuSize));
+                    }
+                    else {
+                        KERNEL_BENCH_TIME(cycles[slot], SaoFunctionTableEO_135_45[slot][eoIndex - 2][0][1](outputBuffer8bit[slot] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, inputBuffer8bit[1], inputBuffer8bit[2], eoOffset, lcuSize, lcuSize));
+                    }
+                }
+                KernelBenchReport(eoName[eoIndex], sizeName, cycles[0], cycles[1], mismatchCount);
+            }
+        }
+    }
+}
+
+/***************************************
+ * Emulation prevention
+ ***************************************/
+static void KernelBenchEmulationPrevention(void)
+{
+    static const EB_U32 payloadSize[3] = { 64, 1024, 16384 };
+    EB_U32 sizeIndex;
+    EB_U32 trialIndex;
+
+    if (!KernelBenchSelected("InsertEmulationPrevention")) {
+        return;
+    }
+    for (sizeIndex = 0; sizeIndex < 3; ++sizeIndex) {
+        EB_U32 readEnd  = payloadSize[sizeIndex];
+        EB_U32 writeEnd = sizeof(outputBuffer8bit[0]);
+        EB_U32 mismatchCount = 0;
+        EB_U32 readLocation[2], writeLocation[2], zeroByteCount[2];
+        double cycles[2] = { 0, 0 };
+        EB_U32 slot;
+        EB_U32 index;
+        char   sizeName[24];
+
+        for (trialIndex = 0; trialIndex < KERNEL_BENCH_TRIALS; ++trialIndex) {
+            KernelBenchResetOutputs();
+            // Mostly 0x00 to 0x03, so that emulation prevention bytes are frequent
+            for (index = 0; index < readEnd; ++index) {
+                EB_U32 value = KernelBenchRandom();
+                inputBuffer8bit[0][index] = (EB_U8)((value & 0x300) ? (value & 3) : value);
+            }
+            for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+                readLocation[slot] = writeLocation[slot] = zeroByteCount[slot] = 0;
+                if (slot == KERNEL_BENCH_C) {
+                    InsertEmulationPrevention_C(inputBuffer8bit[0], &readLocation[slot], readEnd, outputBuffer8bit[slot], &writeLocation[slot], writeEnd, &zeroByteCount[slot]);
+                }
+                else {
+                    InsertEmulationPrevention_AVX2_INTRIN(inputBuffer8bit[0], &readLocation[slot], readEnd, outputBuffer8bit[slot], &writeLocation[slot], writeEnd, &zeroByteCount[slot]);
+                }
+            }
+            mismatchCount += (simdEnabled &&
+                (!KernelBenchOutputsMatch() || readLocation[0] != readLocation[1] || writeLocation[0] != writeLocation[1] || zeroByteCount[0] != zeroByteCount[1]));
+        }
+        for (slot = 0; slot <= (EB_U32)simdEnabled; ++slot) {
+            if (slot == KERNEL_BENCH_C) {
+                KERNEL_BENCH_TIME(cycles[slot], (readLocation[slot] = writeLocation[slot] = zeroByteCount[slot] = 0,
+                    InsertEmulationPrevention_C(inputBuffer8bit[0], &readLocation[slot], readEnd, outputBuffer8bit[slot], &writeLocation[slot], writeEnd, &zeroByteCount[slot])));
+            }
+            else {
+                KERNEL_BENCH_TIME(cycles[slot], (readLocation[slot] = writeLocation[slot] = zeroByteCount[slot] = 0,
+                    InsertEmulationPrevention_AVX2_INTRIN(inputBuffer8bit[0], &readLocation[slot], readEnd, outputBuffer8bit[slot], &writeLocation[slot], writeEnd, &zeroByteCount[slot])));
+            }
+        }
+        sprintf(sizeName, "%uB", readEnd);
+        KernelBenchReport("InsertEmulationPrevention", sizeName, cycles[0], cycles[1], mismatchCount);
+    }
+}
+
+/***************************************
+ * Dispatch
+ *   Cycles a 4x4 kernel call spends in the
+ *   library dispatch: PictureAddition reads
+ *   ASM_TYPES, a thread local of the library,
+ *   and calls through its function table. The
+ *   bench thread is not bound to an encoder, so
+ *   both calls run the C_DEFAULT kernel.
+ ***************************************/
+static void KernelBenchDispatch(void)
+{
+    EB_U8  *predPtr = inputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN;
+    EB_S16 *residualPtr = coeffBuffer[0] + KERNEL_BENCH_BLOCK_ORIGIN;
+    EB_U32  mismatchCount;
+    double  cyclesDirect;
+    double  cyclesDispatch;
+
+    if (!KernelBenchSelected("Dispatch")) {
+        return;
+    }
+
+    KernelBenchFillInputs(0);
+    KernelBenchResetOutputs();
+    AdditionKernel_funcPtrArray[EB_ASM_C][0](predPtr, KERNEL_BENCH_STRIDE, residualPtr, KERNEL_BENCH_STRIDE, outputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, 4, 4);
+    PictureAddition(predPtr, KERNEL_BENCH_STRIDE, residualPtr, KERNEL_BENCH_STRIDE, outputBuffer8bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, 4, 4);
+    mismatchCount = KernelBenchOutputsMatch() ? 0 : 1;
+
+    KERNEL_BENCH_TIME(cyclesDirect,
+        AdditionKernel_funcPtrArray[EB_ASM_C][0](predPtr, KERNEL_BENCH_STRIDE, residualPtr, KERNEL_BENCH_STRIDE, outputBuffer8bit[0] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, 4, 4));
+    KERNEL_BENCH_TIME(cyclesDispatch,
+        PictureAddition(predPtr, KERNEL_BENCH_STRIDE, residualPtr, KERNEL_BENCH_STRIDE, outputBuffer8bit[1] + KERNEL_BENCH_BLOCK_ORIGIN, KERNEL_BENCH_STRIDE, 4, 4));
+
+    ++kernelTotal;
+    mismatchTotal += mismatchCount;
+    printf("%-44s %-8s %12.1f %12.1f %+8.1fc  %s\n",
+        "Dispatch PictureAddition (direct, library)",
+        "4x4",
+        cyclesDirect,
+        cyclesDispatch,
+        cyclesDispatch - cyclesDirect,
+        mismatchCount ? "MISMATCH" : "ok");
+    fflush(stdout);
+}
+
+/***************************************
+ * Huge pages
+ ***************************************/
+#define KERNEL_BENCH_8K_WIDTH           7680
+#define KERNEL_BENCH_8K_HEIGHT          4320
+#define KERNEL_BENCH_8K_PADDING         (64 + 16)
+#define KERNEL_BENCH_SEARCH_STEP        32      // candidates on a 5x5 grid of +/- 64 pels
+
+#if defined(__linux__)
+/***************************************
+ * DTLB load miss counter of the calling thread,
+ * -1 when perf events are not available
+ ***************************************/
+static int KernelBenchOpenDtlbCounter(void)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HW_CACHE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static EB_U64 KernelBenchReadCounter(int counterFd)
+{
+    EB_U64 count = 0;
+
+    if (counterFd < 0 || read(counterFd, &count, sizeof(count)) != (ssize_t)sizeof(count)) {
+        return 0;
+    }
+    return count;
+}
+
+/***************************************
+ * One pass of the 64x64 SAD kernel over every LCU of
+ * the 8K picture, KERNEL_BENCH_SEARCH_STEP apart
+ * candidates of a +/- 64 pel window each
+ ***************************************/
+static EB_U32 KernelBenchPictureWalk(
+    EB_U8  *sourcePtr,
+    EB_U8  *referencePtr,
+    EB_U32  stride)
+{
+    EB_SADKERNELNxM_TYPE sadKernel = NxMSadKernel_funcPtrArray[simdEnabled ? KERNEL_BENCH_SIMD : KERNEL_BENCH_C][64 >> 3];
+    EB_U32 sad = 0;
+    EB_U32 lcuOriginX;
+    EB_U32 lcuOriginY;
+    EB_S32 xOffset;
+    EB_S32 yOffset;
+
+    for (lcuOriginY = 0; lcuOriginY + 64 <= KERNEL_BENCH_8K_HEIGHT; lcuOriginY += 64) {
+        for (lcuOriginX = 0; lcuOriginX + 64 <= KERNEL_BENCH_8K_WIDTH; lcuOriginX += 64) {
+            EB_U8 *lcuPtr = sourcePtr + (KERNEL_BENCH_8K_PADDING + lcuOriginY) * stride + KERNEL_BENCH_8K_PADDING + lcuOriginX;
+            for (yOffset = -64; yOffset <= 64; yOffset += KERNEL_BENCH_SEARCH_STEP) {
+                for (xOffset = -64; xOffset <= 64; xOffset += KERNEL_BENCH_SEARCH_STEP) {
+                    EB_U8 *candidatePtr = referencePtr + (KERNEL_BENCH_8K_PADDING + lcuOriginY + yOffset) * stride + KERNEL_BENCH_8K_PADDING + lcuOriginX + xOffset;
+                    sad += sadKernel(lcuPtr, stride, candidatePtr, stride, 64, 64);
+                }
+            }
+        }
+    }
+    return sad;
+}
+
+/***************************************
+ * Releases the blocks of a bench arena the
+ * way EbDeinitEncoder does, then its map
+ ***************************************/
+static void KernelBenchFreeArena(EbMemoryContext_t *contextPtr)
+{
+    EB_S32 ptrIndex;
+
+    for (ptrIndex = (EB_S32)contextPtr->memoryMapIndex - 1; ptrIndex >= 0; --ptrIndex) {
+        if (contextPtr->memoryMap[ptrIndex].ptrType == EB_HUGE_PTR) {
+            EbArenaFreeHugeBlock(contextPtr->memoryMap[ptrIndex].ptr);
+        }
+        else {
+            free(contextPtr->memoryMap[ptrIndex].ptr);
+        }
+    }
+    free(contextPtr->memoryMap);
+    contextPtr->memoryMap = (EbMemoryMapEntry*)EB_NULL;
+}
+#endif
+
+/***************************************
+ * Allocates the source and reference planes from a memory
+ * arena in the given huge page mode, walks them, and reports
+ * the cycles and DTLB misses per LCU
+ ***************************************/
+static void KernelBenchHugePages(void)
+{
+#if defined(__linux__)
+    static const char *modeName[3] = { "4KB pages", "transparent", "explicit" };
+    const EB_U32 stride = KERNEL_BENCH_8K_WIDTH + 2 * KERNEL_BENCH_8K_PADDING;
+    const EB_U64 planeSize = (EB_U64)stride * (KERNEL_BENCH_8K_HEIGHT + 2 * KERNEL_BENCH_8K_PADDING);
+    const EB_U32 lcuCount = (KERNEL_BENCH_8K_WIDTH / 64) * (KERNEL_BENCH_8K_HEIGHT / 64);
+    const EB_U32 planeSeed = benchState;
+    double baseMisses = 0;
+    EB_U32 mode;
+
+    if (!KernelBenchSelected("HugePages")) {
+        return;
+    }
+
+    printf("\n%-44s %-12s %12s %16s %10s\n", "HugePages 8K SAD walk", "pages", "cyc/LCU", "DTLB misses/LCU", "reduction");
+
+    for (mode = EB_HUGE_PAGES_OFF; mode <= EB_HUGE_PAGES_EXPLICIT; ++mode) {
+        EbMemoryContext_t   context;
+        EB_U8              *planePtr[2];
+        EB_U32              planeIndex;
+        EB_S32              ptrIndex;
+        EB_U64              startCycles;
+        EB_U64              walkCycles;
+        EB_U64              misses;
+        EB_U32              sad = 0;
+        int                 counterFd;
+        EB_U32              iterationIndex;
+        EB_U32              walkCount = MAX(iterationCount / 1000, 1);
+
+        memset(&context, 0, sizeof(context));
+        context.memoryMap = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * 16);
+        context.hugePages = (EB_U8)mode;
+        if (context.memoryMap == EB_NULL) {
+            return;
+        }
+
+        // Every mode walks the same planes
+        benchState = planeSeed;
+        for (planeIndex = 0; planeIndex < 2; ++planeIndex) {
+            planePtr[planeIndex] = (EB_U8*)EbArenaAlloc(&context, planeSize, 64);
+            if (planePtr[planeIndex] == EB_NULL) {
+                printf("Failed to allocate the planes\n");
+                KernelBenchFreeArena(&context);
+                return;
+            }
+            for (ptrIndex = 0; ptrIndex < (EB_S32)planeSize; ptrIndex += 64) {
+                planePtr[planeIndex][ptrIndex] = (EB_U8)KernelBenchRandom();
+            }
+        }
+
+        counterFd = KernelBenchOpenDtlbCounter();
+        sad += KernelBenchPictureWalk(planePtr[0], planePtr[1], stride);
+        misses = KernelBenchReadCounter(counterFd);
+        startCycles = KernelBenchCycles();
+        for (iterationIndex = 0; iterationIndex < walkCount; ++iterationIndex) {
+            sad += KernelBenchPictureWalk(planePtr[0], planePtr[1], stride);
+        }
+        walkCycles = KernelBenchCycles() - startCycles;
+        misses = KernelBenchReadCounter(counterFd) - misses;
+        if (counterFd >= 0) {
+            close(counterFd);
+        }
+
+        if (mode == EB_HUGE_PAGES_OFF) {
+            baseMisses = (double)misses;
+        }
+        if (counterFd < 0) {
+            printf("%-44s %-12s %12.1f %16s %10s\n", "", modeName[mode], (double)walkCycles / walkCount / lcuCount, "n/a", "n/a");
+        }
+        else {
+            printf("%-44s %-12s %12.1f %16.2f %9.1f%%\n", "", modeName[mode],
+                (double)walkCycles / walkCount / lcuCount,
+                (double)misses / walkCount / lcuCount,
+                baseMisses > 0 ? 100.0 * (baseMisses - (double)misses) / baseMisses : 0);
+        }
+        printf("%-44s %-12s explicit %.0f MB, transparent %.0f MB, sad %u\n", "", "",
+            context.arenaExplicitHugeMemory / (1024.0 * 1024.0), context.arenaTransparentHugeMemory / (1024.0 * 1024.0), sad);
+        fflush(stdout);
+
+        KernelBenchFreeArena(&context);
+    }
+#endif
+}
+
+/***************************************
+ * AVX2 rows
+ *   Checks the AVX2 row of the 16 bit tables that
+ *   also keep an SSE2 row against their C_DEFAULT row
+ ***************************************/
+static void KernelBenchAvx2Rows(void)
+{
+    EB_U32 blockIndex;
+
+    simdRow = EB_ASM_AVX2;
+
+    if (KernelBenchSelected("IntraPlanar_16bit_AVX2")) {
+        KernelBenchIntraPlanar16bit("IntraPlanar_16bit_AVX2");
+    }
+    if (KernelBenchSelected("IntraAngVertical_16bit_AVX2")) {
+        KernelBenchIntraAngular(2, "IntraAngVertical_16bit_AVX2");
+    }
+    for (blockIndex = 2; blockIndex < KERNEL_BENCH_BLOCK_SIZE_COUNT; ++blockIndex) {
+        KernelBenchSao16bit(KernelBenchBlockSizes[blockIndex], "_AVX2");
+    }
+    KernelBenchDeblocking8Sample16bit("_AVX2");
+
+    simdRow = KERNEL_BENCH_SIMD;
+}
+
+/***************************************
+ * AVX512 rows
+ *   Checks the AVX512 row of the three slot
+ *   tables against their C_DEFAULT row
+ ***************************************/
+#ifndef NON_AVX512_SUPPORT
+static void KernelBenchAvx512(void)
+{
+    simdRow = EB_ASM_AVX512;
+
+    if (KernelBenchSelected("SadLoopKernel_AVX512_HmeL0")) {
+        KernelBenchSadLoopKernel("SadLoopKernel_AVX512_HmeL0", SadLoopKernel_AVX512_HmeL0_INTRIN);
+    }
+    if (KernelBenchSelected("transformFunctionTableEstimate_AVX512")) {
+        KernelBenchTransformTable("transformFunctionTableEstimate_AVX512", transformFunctionTableEstimate, 0);
+    }
+    if (KernelBenchSelected("transformFunctionTableEncode1_AVX512")) {
+        KernelBenchTransformTable("transformFunctionTableEncode1_AVX512", transformFunctionTableEncode1, 0);
+    }
+    if (KernelBenchSelected("uniPredLumaIFFunctionPtrArrayNew_AVX512")) {
+        KernelBenchLumaTable(KERNEL_BENCH_LUMA_UNI_8BIT, "uniPredLumaIFFunctionPtrArrayNew_AVX512");
+    }
+    if (KernelBenchSelected("biPredLumaIFFunctionPtrArrayNew_AVX512")) {
+        KernelBenchLumaTable(KERNEL_BENCH_LUMA_BI_8BIT, "biPredLumaIFFunctionPtrArrayNew_AVX512");
+    }
+    if (KernelBenchSelected("invTransformFunctionTableEstimate_AVX512")) {
+        KernelBenchInvTransformTable("invTransformFunctionTableEstimate_AVX512", invTransformFunctionTableEstimate);
+    }
+    if (KernelBenchSelected("invTransformFunctionTableEncode_AVX512")) {
+        KernelBenchInvTransformTable("invTransformFunctionTableEncode_AVX512", invTransformFunctionTableEncode);
+    }
+    KernelBenchFullDistortion(32, "_AVX512");
+    KernelBenchFullDistortion(64, "_AVX512");
+    if (KernelBenchSelected("All85PUs_AVX512")) {
+        KernelBenchAll85PUs("All85PUs_AVX512", GetEightHorizontalSearchPointResultsAll85PUs_funcPtrArray[EB_ASM_AVX512]);
+    }
+    if (KernelBenchSelected("BiPredAverage_AVX512")) {
+        KernelBenchBiPredAverage("BiPredAverage_AVX512", BiPredAverageKernel_funcPtrArray[EB_ASM_AVX512]);
+    }
+    if (KernelBenchSelected("msbUnPack2D_AVX512")) {
+        KernelBenchUnPack2D("msbUnPack2D_AVX512", EB_ENC_msbUnPack2D_AVX512_INTRIN);
+    }
+
+    simdRow = KERNEL_BENCH_SIMD;
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    kernelFilter    = (argc > 1 && strcmp(argv[1], "all") != 0) ? argv[1] : NULL;
+    iterationCount  = (argc > 2) ? (EB_U32)strtoul(argv[2], NULL, 0) : KERNEL_BENCH_DEFAULT_ITERATIONS;
+    benchState      = (argc > 3) ? (EB_U32)strtoul(argv[3], NULL, 0) : 0x2545F491;
+
+    if (iterationCount == 0 || benchState == 0) {
+        printf("Usage: %s [kernel name filter|all] [iterations] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    simdEnabled = KernelBenchCpuSupportsAvx2() ? EB_TRUE : EB_FALSE;
+
+    printf("SVT-HEVC kernel bench, %u iterations, seed 0x%x\n", iterationCount, benchState);
+    if (!simdEnabled) {
+        printf("AVX2 not supported, timing the C_DEFAULT slot only\n");
+    }
+    printf("%-44s %-8s %12s %12s %9s  %s\n", "kernel", "size", "C cyc/call", "ASM cyc/call", "speedup", "status");
+
+    KernelBenchSad();
+    KernelBenchPictureOperators();
+    KernelBenchTransforms();
+    KernelBenchIntra();
+    KernelBenchDeblocking();
+    KernelBenchDeblocking8Sample16bit("");
+    KernelBenchMcp();
+    KernelBenchSao();
+    KernelBenchEmulationPrevention();
+    KernelBenchDispatch();
+    if (simdEnabled) {
+        KernelBenchAvx2Rows();
+    }
+#ifndef NON_AVX512_SUPPORT
+    if (simdEnabled && KernelBenchCpuSupportsAvx512()) {
+        KernelBenchAvx512();
+    }
+    else {
+        printf("AVX512 not supported, AVX512 rows skipped\n");
+    }
+#endif
+    KernelBenchHugePages();
+
+    printf("%u kernels, %u mismatches\n", kernelTotal, mismatchTotal);
+
+    return mismatchTotal ? 1 : 0;
+}
@@ -0,0 +1,199 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// EbSubPictureRefTest
+//  -Checks EncDecSegmentLastLcuRow against the LCU walk of the EncDec
+//   segment loop, for several picture sizes and segment grids
+//  -Checks that the row count a segment waits for in the reference picture
+//   is reached before the reference is fully reconstructed, and that the
+//   segment still waits while one of those rows is missing
+//  -Returns non-zero on the first failure
+//
+// Usage: SvtHevcSubPictureRefTest
+
+/***************************************
+ * Includes
+ ***************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "EbDefinitions.h"
+#include "EbThreads.h"
+#include "EbEncDecSegments.h"
+#include "EbReferenceObject.h"
+#include "EbUtility.h"
+
+typedef struct SubPictureRefTestCase_s {
+    EB_U32 pictureWidth;
+    EB_U32 pictureHeight;
+} SubPictureRefTestCase_t;
+
+// Picture sizes in luma samples. The segment grid is sized the way the
+// encoder sizes it, so heights such as 720 and 600 get fewer segment rows
+// than LCU rows and some segments span two LCU rows
+static const SubPictureRefTestCase_t subPictureRefTestCases[] = {
+    {  416,  240 },
+    { 1024,  600 },
+    { 1280,  720 },
+    { 1920, 1080 },
+    { 2560, 1440 },
+    { 3840, 2160 },
+    { 7680, 4320 },
+};
+
+/***************************************
+ * Last row reached by the EncDec segment loop
+ ***************************************/
+static EB_U32 SubPictureRefWalkLastRow(EncDecSegments_t *segmentsPtr, EB_U32 segmentIndex, EB_U32 pictureWidthInLcu, EB_U32 pictureHeightInLcu)
+{
+    EB_U32 segmentRowIndex = segmentIndex / segmentsPtr->segmentBandCount;
+    EB_U32 segmentBandIndex = segmentIndex - segmentRowIndex * segmentsPtr->segmentBandCount;
+    EB_U32 segmentBandSize = (segmentsPtr->lcuBandCount * (segmentBandIndex + 1) + segmentsPtr->segmentBandCount - 1) / segmentsPtr->segmentBandCount;
+    EB_U32 lcuSegmentCount = segmentsPtr->validLcuCountArray[segmentIndex];
+    EB_U32 lcuSegmentIndex = 0;
+    EB_U32 xLcuIndex;
+    EB_U32 yLcuIndex;
+    EB_U32 lastRow = segmentsPtr->yStartArray[segmentIndex];
+
+    // The picture height only stops a walk that would not end in the encoder
+    for (yLcuIndex = segmentsPtr->yStartArray[segmentIndex]; lcuSegmentIndex < lcuSegmentCount && yLcuIndex < pictureHeightInLcu; ++yLcuIndex) {
+        for (xLcuIndex = segmentsPtr->xStartArray[segmentIndex]; xLcuIndex < pictureWidthInLcu && (xLcuIndex + yLcuIndex < segmentBandSize) && lcuSegmentIndex < lcuSegmentCount; ++xLcuIndex, ++lcuSegmentIndex) {
+            lastRow = yLcuIndex;
+        }
+    }
+
+    return lastRow;
+}
+
+static int SubPictureRefRunCase(const SubPictureRefTestCase_t *testCasePtr)
+{
+    EncDecSegments_t    segments;
+    EbReferenceObject_t referenceObject;
+    EB_U32              segmentIndex;
+    EB_U32              pictureWidthInLcu = (testCasePtr->pictureWidth + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE;
+    EB_U32              pictureHeightInLcu = (testCasePtr->pictureHeight + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE;
+    EB_U32              segmentColCount = (testCasePtr->pictureWidth + 32) / MAX_LCU_SIZE;
+    EB_U32              segmentRowCount = (testCasePtr->pictureHeight + 32) / MAX_LCU_SIZE;
+    EB_U32              validCount = 0;
+    EB_U32              multiRowCount = 0;
+    EB_U32              earlyCount = 0;
+    int                 failed = 0;
+
+    // Same sizes as EncDecSegmentsCtor, which needs the encoder memory map
+    segments.segmentMaxRowCount = segmentRowCount;
+    segments.segmentMaxBandCount = segmentRowCount + segmentColCount;
+    segments.segmentMaxTotalCount = segments.segmentMaxRowCount * segments.segmentMaxBandCount;
+    segments.xStartArray = (EB_U16*)malloc(sizeof(EB_U16) * segments.segmentMaxTotalCount);
+    segments.yStartArray = (EB_U16*)malloc(sizeof(EB_U16) * segments.segmentMaxTotalCount);
+    segments.validLcuCountArray = (EB_U16*)malloc(sizeof(EB_U16) * segments.segmentMaxTotalCount);
+    segments.rowArray = (EncDecSegSegmentRow_t*)malloc(sizeof(EncDecSegSegmentRow_t) * segments.segmentMaxRowCount);
+    segments.depMap.dependencyMap = (EB_U8*)malloc(sizeof(EB_U8) * segments.segmentMaxTotalCount);
+
+    referenceObject.lcuRowTotalCount = (EB_U16)pictureHeightInLcu;
+    referenceObject.rowWaiterCountArray = (EB_U32*)calloc(pictureHeightInLcu, sizeof(EB_U32));
+    referenceObject.rowSemaphoreArray = EB_NULL;
+    referenceObject.rowProgressMutex = EbCreateMutex();
+
+    // The picture manager asks for one segment per LCU of the tile group
+    EncDecSegmentsInit(
+        &segments,
+        pictureWidthInLcu,
+        pictureHeightInLcu,
+        pictureWidthInLcu,
+        pictureHeightInLcu);
+
+    for (segmentIndex = 0; segmentIndex < segments.segmentTotalCount && !failed; ++segmentIndex) {
+        EB_U32 walkLastRow;
+        EB_U32 lastRow;
+        EB_U16 requiredRowCount;
+
+        if (segments.validLcuCountArray[segmentIndex] == 0) {
+            continue;
+        }
+
+        walkLastRow = SubPictureRefWalkLastRow(&segments, segmentIndex, pictureWidthInLcu, pictureHeightInLcu);
+        lastRow = EncDecSegmentLastLcuRow(&segments, segmentIndex, pictureWidthInLcu, pictureHeightInLcu);
+        if (lastRow != walkLastRow) {
+            printf("%ux%u: segment %u last row %u, the walk reaches row %u\n",
+                testCasePtr->pictureWidth, testCasePtr->pictureHeight,
+                segmentIndex, lastRow, walkLastRow);
+            failed = 1;
+            break;
+        }
+
+        ++validCount;
+        if (lastRow > segments.yStartArray[segmentIndex]) {
+            ++multiRowCount;
+        }
+
+        // Same bound as the EncDec sub-picture reference check
+        requiredRowCount = (EB_U16)MIN(pictureHeightInLcu, lastRow + 1 + SUB_PICTURE_REF_LCU_ROW_MARGIN);
+
+        referenceObject.availableLcuRowCount = 0;
+        EbReferenceObjectPostRowProgress(&referenceObject, (EB_U16)(requiredRowCount - 1));
+        if (EbReferenceObjectRowsAvailable(&referenceObject, requiredRowCount)) {
+            printf("%ux%u: segment %u proceeds with %u of %u rows\n",
+                testCasePtr->pictureWidth, testCasePtr->pictureHeight,
+                segmentIndex, requiredRowCount - 1, requiredRowCount);
+            failed = 1;
+            break;
+        }
+
+        EbReferenceObjectPostRowProgress(&referenceObject, requiredRowCount);
+        if (!EbReferenceObjectRowsAvailable(&referenceObject, requiredRowCount)) {
+            printf("%ux%u: segment %u waits with %u rows\n",
+                testCasePtr->pictureWidth, testCasePtr->pictureHeight,
+                segmentIndex, requiredRowCount);
+            failed = 1;
+            break;
+        }
+
+        if (referenceObject.availableLcuRowCount < referenceObject.lcuRowTotalCount) {
+            ++earlyCount;
+        }
+    }
+
+    // Every grid with more than one segment row has segments that start
+    // before the last rows of the reference are reconstructed
+    if (!failed && segments.segmentRowCount > 1 && pictureHeightInLcu > 1 + SUB_PICTURE_REF_LCU_ROW_MARGIN && earlyCount == 0) {
+        printf("%ux%u: no segment proceeds before the reference is complete\n",
+            testCasePtr->pictureWidth, testCasePtr->pictureHeight);
+        failed = 1;
+    }
+
+    if (!failed) {
+        printf("%ux%u: %u segments, %u spanning several LCU rows, %u proceed before the reference is complete\n",
+            testCasePtr->pictureWidth, testCasePtr->pictureHeight,
+            validCount,
+            multiRowCount,
+            earlyCount);
+    }
+
+    EbDestroyMutex(referenceObject.rowProgressMutex);
+    free(referenceObject.rowWaiterCountArray);
+    free(segments.depMap.dependencyMap);
+    free(segments.rowArray);
+    free(segments.validLcuCountArray);
+    free(segments.yStartArray);
+    free(segments.xStartArray);
+
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    EB_U32 caseIndex;
+
+    (void)argc;
+    (void)argv;
+
+    for (caseIndex = 0; caseIndex < sizeof(subPictureRefTestCases) / sizeof(subPictureRefTestCases[0]); ++caseIndex) {
+        if (SubPictureRefRunCase(&subPictureRefTestCases[caseIndex])) {
+            return 1;
+        }
+    }
+
+    printf("All cases passed\n");
+    return 0;
+}
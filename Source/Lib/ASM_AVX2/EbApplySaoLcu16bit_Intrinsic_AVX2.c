@@ -0,0 +1,216 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "immintrin.h"
+#include "EbDefinitions.h"
+#include "EbSampleAdaptiveOffset_AVX2.h"
+
+// The kernels filter 16 samples per vector, the LCU width must be a multiple of 16.
+// Every sample is classified against the unfiltered neighbours, so the neighbours
+// the filtering of the previous vector or row overwrites are carried in registers
+// or in a line buffer.
+
+/*****************************************
+* Offset lookup
+*   Sign extends the first offsetCount offsets to
+*   16 bits in both lanes, the other entries are 0
+*****************************************/
+static FORCE_INLINE __m256i SaoOffsetTable16bit(
+    EB_S8  *saoOffsetPtr,
+    EB_U32  offsetCount)
+{
+    EB_S8 offsets[16] = { 0 };
+
+    EB_MEMCPY(offsets, saoOffsetPtr, offsetCount);
+
+    return _mm256_broadcastsi128_si256(_mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i *)offsets)));
+}
+
+// Adds the offsets selected by the 16 bit indices (0 to 7) and clips to 10 bits
+static FORCE_INLINE __m256i SaoAddOffset16bit(
+    __m256i recon,
+    __m256i offsetTable,
+    __m256i index)
+{
+    // Byte shuffle control of the 16 bit entries: 2 * index, 2 * index + 1
+    __m256i control = _mm256_add_epi16(_mm256_mullo_epi16(index, _mm256_set1_epi16(0x0202)), _mm256_set1_epi16(0x0100));
+    __m256i sum = _mm256_add_epi16(recon, _mm256_shuffle_epi8(offsetTable, control));
+
+    return _mm256_max_epi16(_mm256_min_epi16(sum, _mm256_set1_epi16(MAX_SAMPLE_VALUE_10BIT)), _mm256_setzero_si256());
+}
+
+// SIGN(cur, neighbor0) + SIGN(cur, neighbor1) + 2
+static FORCE_INLINE __m256i SaoEoIndex16bit(
+    __m256i cur,
+    __m256i neighbor0,
+    __m256i neighbor1)
+{
+    __m256i sign0 = _mm256_sub_epi16(_mm256_cmpgt_epi16(neighbor0, cur), _mm256_cmpgt_epi16(cur, neighbor0));
+    __m256i sign1 = _mm256_sub_epi16(_mm256_cmpgt_epi16(neighbor1, cur), _mm256_cmpgt_epi16(cur, neighbor1));
+
+    return _mm256_add_epi16(_mm256_add_epi16(sign0, sign1), _mm256_set1_epi16(2));
+}
+
+// { prev[15], cur[0], ..., cur[14] }
+static FORCE_INLINE __m256i SaoShiftInLeft16bit(
+    __m256i prev,
+    __m256i cur)
+{
+    return _mm256_alignr_epi8(cur, _mm256_permute2x128_si256(prev, cur, 0x21), 14);
+}
+
+EB_ERRORTYPE SAOApplyBO16bit_AVX2_INTRIN(
+    EB_U16 *reconSamplePtr,
+    EB_U32  reconStride,
+    EB_U32  saoBandPosition,
+    EB_S8  *saoOffsetPtr,
+    EB_U32  lcuHeight,
+    EB_U32  lcuWidth)
+{
+    const __m256i offsetTable = SaoOffsetTable16bit(saoOffsetPtr, SAO_BO_LEN);
+    const __m256i bandPosition = _mm256_set1_epi16((EB_S16)saoBandPosition);
+    const __m256i outOfBand = _mm256_set1_epi16(SAO_BO_LEN);
+    EB_U32 rowIndex, columnIndex;
+
+    for (rowIndex = 0; rowIndex < lcuHeight; ++rowIndex) {
+        for (columnIndex = 0; columnIndex < lcuWidth; columnIndex += 16) {
+            __m256i recon = _mm256_loadu_si256((__m256i *)(reconSamplePtr + columnIndex));
+            // Bands below saoBandPosition wrap to large unsigned values, the bands
+            // outside of the four offset ones select the zero entry SAO_BO_LEN
+            __m256i index = _mm256_min_epu16(_mm256_sub_epi16(_mm256_srli_epi16(recon, 5), bandPosition), outOfBand);
+
+            _mm256_storeu_si256((__m256i *)(reconSamplePtr + columnIndex), SaoAddOffset16bit(recon, offsetTable, index));
+        }
+        reconSamplePtr += reconStride;
+    }
+
+    return EB_ErrorNone;
+}
+
+EB_ERRORTYPE SAOApplyEO_0_16bit_AVX2_INTRIN(
+    EB_U16 *reconSamplePtr,
+    EB_U32  reconStride,
+    EB_U16 *temporalBufferLeft,
+    EB_S8  *saoOffsetPtr,
+    EB_U32  lcuHeight,
+    EB_U32  lcuWidth)
+{
+    const __m256i offsetTable = SaoOffsetTable16bit(saoOffsetPtr, SAO_EO_CATEGORIES + 1);
+    EB_U32 rowIndex, columnIndex;
+
+    for (rowIndex = 0; rowIndex < lcuHeight; ++rowIndex) {
+        __m256i previous = _mm256_set1_epi16((EB_S16)temporalBufferLeft[rowIndex]);
+
+        for (columnIndex = 0; columnIndex < lcuWidth; columnIndex += 16) {
+            __m256i recon = _mm256_loadu_si256((__m256i *)(reconSamplePtr + columnIndex));
+            __m256i right = _mm256_loadu_si256((__m256i *)(reconSamplePtr + columnIndex + 1));
+            __m256i left = SaoShiftInLeft16bit(previous, recon);
+
+            _mm256_storeu_si256((__m256i *)(reconSamplePtr + columnIndex), SaoAddOffset16bit(recon, offsetTable, SaoEoIndex16bit(recon, left, right)));
+            previous = recon;
+        }
+        reconSamplePtr += reconStride;
+    }
+
+    return EB_ErrorNone;
+}
+
+EB_ERRORTYPE SAOApplyEO_90_16bit_AVX2_INTRIN(
+    EB_U16 *reconSamplePtr,
+    EB_U32  reconStride,
+    EB_U16 *temporalBufferUpper,
+    EB_S8  *saoOffsetPtr,
+    EB_U32  lcuHeight,
+    EB_U32  lcuWidth)
+{
+    const __m256i offsetTable = SaoOffsetTable16bit(saoOffsetPtr, SAO_EO_CATEGORIES + 1);
+    EB_U16 topLine[MAX_LCU_SIZE];
+    EB_U32 rowIndex, columnIndex;
+
+    EB_MEMCPY(topLine, temporalBufferUpper, lcuWidth * sizeof(EB_U16));
+
+    for (rowIndex = 0; rowIndex < lcuHeight; ++rowIndex) {
+        for (columnIndex = 0; columnIndex < lcuWidth; columnIndex += 16) {
+            __m256i recon = _mm256_loadu_si256((__m256i *)(reconSamplePtr + columnIndex));
+            __m256i top = _mm256_loadu_si256((__m256i *)(topLine + columnIndex));
+            __m256i bottom = _mm256_loadu_si256((__m256i *)(reconSamplePtr + reconStride + columnIndex));
+
+            _mm256_storeu_si256((__m256i *)(topLine + columnIndex), recon);
+            _mm256_storeu_si256((__m256i *)(reconSamplePtr + columnIndex), SaoAddOffset16bit(recon, offsetTable, SaoEoIndex16bit(recon, top, bottom)));
+        }
+        reconSamplePtr += reconStride;
+    }
+
+    return EB_ErrorNone;
+}
+
+EB_ERRORTYPE SAOApplyEO_135_16bit_AVX2_INTRIN(
+    EB_U16 *reconSamplePtr,
+    EB_U32  reconStride,
+    EB_U16 *temporalBufferLeft,
+    EB_U16 *temporalBufferUpper,
+    EB_S8  *saoOffsetPtr,
+    EB_U32  lcuHeight,
+    EB_U32  lcuWidth)
+{
+    const __m256i offsetTable = SaoOffsetTable16bit(saoOffsetPtr, SAO_EO_CATEGORIES + 1);
+    EB_U16 topLeftLine[MAX_LCU_SIZE];
+    EB_U32 rowIndex, columnIndex;
+
+    EB_MEMCPY(topLeftLine, temporalBufferUpper - 1, lcuWidth * sizeof(EB_U16));
+
+    for (rowIndex = 0; rowIndex < lcuHeight; ++rowIndex) {
+        // The top left neighbour of the first sample of the next row
+        __m256i previous = _mm256_set1_epi16((EB_S16)temporalBufferLeft[rowIndex]);
+
+        for (columnIndex = 0; columnIndex < lcuWidth; columnIndex += 16) {
+            __m256i recon = _mm256_loadu_si256((__m256i *)(reconSamplePtr + columnIndex));
+            __m256i topLeft = _mm256_loadu_si256((__m256i *)(topLeftLine + columnIndex));
+            __m256i bottomRight = _mm256_loadu_si256((__m256i *)(reconSamplePtr + reconStride + columnIndex + 1));
+
+            _mm256_storeu_si256((__m256i *)(topLeftLine + columnIndex), SaoShiftInLeft16bit(previous, recon));
+            _mm256_storeu_si256((__m256i *)(reconSamplePtr + columnIndex), SaoAddOffset16bit(recon, offsetTable, SaoEoIndex16bit(recon, topLeft, bottomRight)));
+            previous = recon;
+        }
+        reconSamplePtr += reconStride;
+    }
+
+    return EB_ErrorNone;
+}
+
+EB_ERRORTYPE SAOApplyEO_45_16bit_AVX2_INTRIN(
+    EB_U16 *reconSamplePtr,
+    EB_U32  reconStride,
+    EB_U16 *temporalBufferLeft,
+    EB_U16 *temporalBufferUpper,
+    EB_S8  *saoOffsetPtr,
+    EB_U32  lcuHeight,
+    EB_U32  lcuWidth)
+{
+    const __m256i offsetTable = SaoOffsetTable16bit(saoOffsetPtr, SAO_EO_CATEGORIES + 1);
+    EB_U16 topRightLine[MAX_LCU_SIZE];
+    EB_U32 rowIndex, columnIndex;
+
+    EB_MEMCPY(topRightLine, temporalBufferUpper + 1, lcuWidth * sizeof(EB_U16));
+
+    for (rowIndex = 0; rowIndex < lcuHeight; ++rowIndex) {
+        __m256i previousBottom = _mm256_set1_epi16((EB_S16)temporalBufferLeft[rowIndex + 1]);
+
+        for (columnIndex = 0; columnIndex < lcuWidth; columnIndex += 16) {
+            __m256i recon = _mm256_loadu_si256((__m256i *)(reconSamplePtr + columnIndex));
+            __m256i topRight = _mm256_loadu_si256((__m256i *)(topRightLine + columnIndex));
+            __m256i bottom = _mm256_loadu_si256((__m256i *)(reconSamplePtr + reconStride + columnIndex));
+            __m256i bottomLeft = SaoShiftInLeft16bit(previousBottom, bottom);
+
+            // The top right neighbours of the next row, read before this vector is filtered
+            _mm256_storeu_si256((__m256i *)(topRightLine + columnIndex), _mm256_loadu_si256((__m256i *)(reconSamplePtr + columnIndex + 1)));
+            _mm256_storeu_si256((__m256i *)(reconSamplePtr + columnIndex), SaoAddOffset16bit(recon, offsetTable, SaoEoIndex16bit(recon, topRight, bottomLeft)));
+            previousBottom = bottom;
+        }
+        reconSamplePtr += reconStride;
+    }
+
+    return EB_ErrorNone;
+}
@@ -0,0 +1,86 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "immintrin.h"
+#include "EbBitstreamUnit_Intrinsic_AVX2.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+static EB_U32 FirstSetBit(EB_U32 mask)
+{
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (EB_U32)index;
+}
+#else
+#define FirstSetBit(mask) ((EB_U32)__builtin_ctz(mask))
+#endif
+
+/*********************************************************
+* InsertEmulationPrevention_AVX2_INTRIN
+*  Same output as InsertEmulationPrevention_C. 32 bytes are
+*  checked at a time; a byte can only need an emulation
+*  prevention byte when the two bytes before it are zero, so
+*  the bytes up to the first such position are block copied
+*  and only that position is handled one byte at a time.
+*********************************************************/
+void InsertEmulationPrevention_AVX2_INTRIN(
+    const EB_U8 *readBytePtr,
+    EB_U32      *readLocation,
+    EB_U32       readEnd,
+    EB_U8       *writeBytePtr,
+    EB_U32      *writeLocation,
+    EB_U32       writeEnd,
+    EB_U32      *zeroByteCount)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    EB_U32 readIndex  = *readLocation;
+    EB_U32 writeIndex = *writeLocation;
+    EB_U32 zeroCount  = *zeroByteCount;
+
+    while (readIndex < readEnd && writeIndex < writeEnd) {
+
+        if (readEnd - readIndex >= 32 && writeEnd - writeIndex >= 32) {
+            __m256i bytes    = _mm256_loadu_si256((const __m256i*)(readBytePtr + readIndex));
+            EB_U64  zeroMask = (EB_U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, zero));
+            // Bit k + 2 is set when byte k is zero, bits 0 and 1 carry the zero run before the block
+            EB_U64  runMask  = (zeroMask << 2) | (zeroCount >= 2 ? 3 : zeroCount << 1);
+            // Bit k is set when bytes k - 2 and k - 1 are zero
+            EB_U32  candidateMask = (EB_U32)(runMask & (runMask >> 1));
+
+            _mm256_storeu_si256((__m256i*)(writeBytePtr + writeIndex), bytes);
+
+            if (candidateMask == 0) {
+                readIndex  += 32;
+                writeIndex += 32;
+                zeroCount   = (zeroMask >> 31) ? (EB_U32)((zeroMask >> 30) & 1) + 1 : 0;
+                continue;
+            }
+            else {
+                // The bytes before the first candidate are already in place and end with two zeros
+                EB_U32 candidateIndex = FirstSetBit(candidateMask);
+                readIndex  += candidateIndex;
+                writeIndex += candidateIndex;
+                zeroCount   = 2;
+            }
+        }
+
+        // add emulation code
+        if (zeroCount == 2 && (readBytePtr[readIndex] & 0xfc) == 0) {
+            writeBytePtr[writeIndex++] = 0x03;
+            zeroCount = 0;
+        }
+
+        writeBytePtr[writeIndex++] = readBytePtr[readIndex];
+
+        // count the number of zeros for emulation code check
+        zeroCount = (readBytePtr[readIndex] == 0) ? zeroCount + 1 : 0;
+        readIndex++;
+    }
+
+    *readLocation   = readIndex;
+    *writeLocation  = writeIndex;
+    *zeroByteCount  = zeroCount;
+}
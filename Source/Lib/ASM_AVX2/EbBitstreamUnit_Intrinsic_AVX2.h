@@ -0,0 +1,26 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbBitstreamUnit_Intrinsic_AVX2_h
+#define EbBitstreamUnit_Intrinsic_AVX2_h
+
+#include "EbDefinitions.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void InsertEmulationPrevention_AVX2_INTRIN(
+    const EB_U8 *readBytePtr,
+    EB_U32      *readLocation,
+    EB_U32       readEnd,
+    EB_U8       *writeBytePtr,
+    EB_U32      *writeLocation,
+    EB_U32       writeEnd,
+    EB_U32      *zeroByteCount);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbBitstreamUnit_Intrinsic_AVX2_h
@@ -174,7 +174,7 @@ void BiPredAverageKernel_AVX512_INTRIN(
 	}
 
 }
-#else
+#endif
 
 //BiPredAveragingOnthefly
 void BiPredAverageKernel_AVX2_INTRIN(
@@ -341,4 +341,3 @@ void BiPredAverageKernel_AVX2_INTRIN(
 
 }
 
-#endif
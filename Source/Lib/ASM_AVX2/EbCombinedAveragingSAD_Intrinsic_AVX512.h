@@ -33,7 +33,7 @@ void BiPredAverageKernel_AVX512_INTRIN(
 	EB_U32                   dstStride,
 	EB_U32                   areaWidth,
 	EB_U32                   areaHeight);
-#else
+#endif
 void BiPredAverageKernel_AVX2_INTRIN(
     EB_BYTE                  src0,
     EB_U32                   src0Stride,
@@ -43,7 +43,6 @@ void BiPredAverageKernel_AVX2_INTRIN(
     EB_U32                   dstStride,
     EB_U32                   areaWidth,
     EB_U32                   areaHeight);
-#endif
 
 #ifdef __cplusplus
 }
@@ -75,7 +75,6 @@ void SadLoopKernel_AVX2_INTRIN(
 	EB_S16 searchAreaWidth,
 	EB_S16 searchAreaHeight);
 
-#ifdef NON_AVX512_SUPPORT
 void GetEightHorizontalSearchPointResults_8x8_16x16_PU_AVX2_INTRIN(
     EB_U8   *src,
     EB_U32   srcStride,
@@ -96,8 +95,6 @@ void GetEightHorizontalSearchPointResults_32x32_64x64_PU_AVX2_INTRIN(
     EB_U32  *pBestMV64x64,
     EB_U32   mv);
 
-#endif
-
 #ifdef __cplusplus
 }
 #endif        
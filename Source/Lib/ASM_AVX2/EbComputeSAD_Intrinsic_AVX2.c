@@ -1791,8 +1791,6 @@ EB_U32 Compute64xMSad_AVX2_INTRIN(
 	return _mm_extract_epi32(xmm0, 0);
 }
 
-#ifdef NON_AVX512_SUPPORT
-
 void GetEightHorizontalSearchPointResults_8x8_16x16_PU_AVX2_INTRIN(
     EB_U8   *src,
     EB_U32   srcStride,
@@ -2306,5 +2304,3 @@ void GetEightHorizontalSearchPointResults_32x32_64x64_PU_AVX2_INTRIN(
     // Store back to memory
     _mm_storeu_si128((__m128i*)pBestMV32x32, s3);
 }
-
-#endif
@@ -1116,7 +1116,7 @@ EB_U16  *pSad16x16)
     sad_2 = _mm_or_si128(sad_2, sad_3);
     _mm_storeu_si128((__m128i*)pBestMV8x8, sad_2);
 }
-#else
+#endif
 
 void SadLoopKernel_AVX2_HmeL0_INTRIN(
     EB_U8  *src,                            // input parameter, source samples Ptr
@@ -1953,7 +1953,6 @@ void SadLoopKernel_AVX2_HmeL0_INTRIN(
     *ySearchCenter = yBest;
 }
 
-#endif
 
 
 
@@ -1961,395 +1960,7 @@ void SadLoopKernel_AVX2_HmeL0_INTRIN(
 /*******************************************
 * GetEightHorizontalSearchPointResultsAll85CUs
 *******************************************/
-
-
-/*******************************************
-Calcualte SAD for 32x32,64x64 from 16x16
-and check if there is improvement, if yes keep
-the best SAD+MV
-*******************************************/
 #ifndef NON_AVX512_SUPPORT
-FORCE_INLINE static 
-void GetEightHorizontalSearchPointResults_32x32_64x64_PU_AVX2_INTRIN(
-	EB_U16  *pSad16x16,
-	EB_U32  *pBestSad32x32,
-	EB_U32  *pBestSad64x64,
-	EB_U32  *pBestMV32x32,
-	EB_U32  *pBestMV64x64,
-	EB_U32   mv)
-{
-	EB_S16 xMv, yMv;
-	EB_U32 temSum, bestSad64x64, bestMV64x64;
-	__m128i s0, s1, s2, s3, s4, s5, s6, s7, sad_0, sad_1;
-	__m128i sad_00, sad_01, sad_10, sad_11, sad_20, sad_21, sad_30, sad_31;
-	__m256i ss0, ss1, ss2, ss3, ss4, ss5, ss6, ss7;
-
-	s0 = _mm_setzero_si128();
-	s1 = _mm_setzero_si128();
-	s2 = _mm_setzero_si128();
-	s3 = _mm_setzero_si128();
-	s4 = _mm_setzero_si128();
-	s5 = _mm_setzero_si128();
-	s6 = _mm_setzero_si128();
-	s7 = _mm_setzero_si128();
-	sad_0 = _mm_setzero_si128();
-	sad_1 = _mm_setzero_si128();
-
-	sad_00 = _mm_setzero_si128();
-	sad_01 = _mm_setzero_si128();
-	sad_10 = _mm_setzero_si128();
-	sad_11 = _mm_setzero_si128();
-	sad_20 = _mm_setzero_si128();
-	sad_21 = _mm_setzero_si128();
-	sad_30 = _mm_setzero_si128();
-	sad_31 = _mm_setzero_si128();
-
-	ss0 = _mm256_setzero_si256();
-	ss1 = _mm256_setzero_si256();
-	ss2 = _mm256_setzero_si256();
-	ss3 = _mm256_setzero_si256();
-	ss4 = _mm256_setzero_si256();
-	ss5 = _mm256_setzero_si256();
-	ss6 = _mm256_setzero_si256();
-	ss7 = _mm256_setzero_si256();
-
-
-	/*--------------------
-	|  32x32_0  |  32x32_1
-	----------------------
-	|  32x32_2  |  32x32_3
-	----------------------*/
-
-
-	/*  data ordering in pSad16x16 buffer
-
-	Search    Search            Search
-	Point 0   Point 1           Point 7
-	---------------------------------------
-	16x16_0    |    x    |    x    | ...... |    x    |
-	---------------------------------------
-	16x16_1    |    x    |    x    | ...... |    x    |
-
-	16x16_n    |    x    |    x    | ...... |    x    |
-
-	---------------------------------------
-	16x16_15   |    x    |    x    | ...... |    x    |
-	---------------------------------------
-	*/
-
-//    __m128i Zero = _mm_setzero_si128();
-
-	//32x32_0
-	s0 = _mm_loadu_si128((__m128i*)(pSad16x16 + 0 * 8));
-	s1 = _mm_loadu_si128((__m128i*)(pSad16x16 + 1 * 8));
-	s2 = _mm_loadu_si128((__m128i*)(pSad16x16 + 2 * 8));
-	s3 = _mm_loadu_si128((__m128i*)(pSad16x16 + 3 * 8));
-
-	s4 = _mm_unpackhi_epi16(s0, _mm_setzero_si128());
-	s5 = _mm_unpacklo_epi16(s0, _mm_setzero_si128());
-	s6 = _mm_unpackhi_epi16(s1, _mm_setzero_si128());
-	s7 = _mm_unpacklo_epi16(s1, _mm_setzero_si128());
-	s0 = _mm_add_epi32(s4, s6);
-	s1 = _mm_add_epi32(s5, s7);
-
-	s4 = _mm_unpackhi_epi16(s2, _mm_setzero_si128());
-	s5 = _mm_unpacklo_epi16(s2, _mm_setzero_si128());
-	s6 = _mm_unpackhi_epi16(s3, _mm_setzero_si128());
-	s7 = _mm_unpacklo_epi16(s3, _mm_setzero_si128());
-	s2 = _mm_add_epi32(s4, s6);
-	s3 = _mm_add_epi32(s5, s7);
-
-	sad_01 = _mm_add_epi32(s0, s2);
-	sad_00 = _mm_add_epi32(s1, s3);
-
-	//32x32_1
-	s0 = _mm_loadu_si128((__m128i*)(pSad16x16 + 4 * 8));
-	s1 = _mm_loadu_si128((__m128i*)(pSad16x16 + 5 * 8));
-	s2 = _mm_loadu_si128((__m128i*)(pSad16x16 + 6 * 8));
-	s3 = _mm_loadu_si128((__m128i*)(pSad16x16 + 7 * 8));
-
-	s4 = _mm_unpackhi_epi16(s0, _mm_setzero_si128());
-	s5 = _mm_unpacklo_epi16(s0, _mm_setzero_si128());
-	s6 = _mm_unpackhi_epi16(s1, _mm_setzero_si128());
-	s7 = _mm_unpacklo_epi16(s1, _mm_setzero_si128());
-	s0 = _mm_add_epi32(s4, s6);
-	s1 = _mm_add_epi32(s5, s7);
-
-	s4 = _mm_unpackhi_epi16(s2, _mm_setzero_si128());
-	s5 = _mm_unpacklo_epi16(s2, _mm_setzero_si128());
-	s6 = _mm_unpackhi_epi16(s3, _mm_setzero_si128());
-	s7 = _mm_unpacklo_epi16(s3, _mm_setzero_si128());
-	s2 = _mm_add_epi32(s4, s6);
-	s3 = _mm_add_epi32(s5, s7);
-
-	sad_11 = _mm_add_epi32(s0, s2);
-	sad_10 = _mm_add_epi32(s1, s3);
-
-	//32x32_2
-	s0 = _mm_loadu_si128((__m128i*)(pSad16x16 + 8 * 8));
-	s1 = _mm_loadu_si128((__m128i*)(pSad16x16 + 9 * 8));
-	s2 = _mm_loadu_si128((__m128i*)(pSad16x16 + 10 * 8));
-	s3 = _mm_loadu_si128((__m128i*)(pSad16x16 + 11 * 8));
-
-	s4 = _mm_unpackhi_epi16(s0, _mm_setzero_si128());
-	s5 = _mm_unpacklo_epi16(s0, _mm_setzero_si128());
-	s6 = _mm_unpackhi_epi16(s1, _mm_setzero_si128());
-	s7 = _mm_unpacklo_epi16(s1, _mm_setzero_si128());
-	s0 = _mm_add_epi32(s4, s6);
-	s1 = _mm_add_epi32(s5, s7);
-
-	s4 = _mm_unpackhi_epi16(s2, _mm_setzero_si128());
-	s5 = _mm_unpacklo_epi16(s2, _mm_setzero_si128());
-	s6 = _mm_unpackhi_epi16(s3, _mm_setzero_si128());
-	s7 = _mm_unpacklo_epi16(s3, _mm_setzero_si128());
-	s2 = _mm_add_epi32(s4, s6);
-	s3 = _mm_add_epi32(s5, s7);
-
-	sad_21 = _mm_add_epi32(s0, s2);
-	sad_20 = _mm_add_epi32(s1, s3);
-
-	//32x32_3
-	s0 = _mm_loadu_si128((__m128i*)(pSad16x16 + 12 * 8));
-	s1 = _mm_loadu_si128((__m128i*)(pSad16x16 + 13 * 8));
-	s2 = _mm_loadu_si128((__m128i*)(pSad16x16 + 14 * 8));
-	s3 = _mm_loadu_si128((__m128i*)(pSad16x16 + 15 * 8));
-
-	s4 = _mm_unpackhi_epi16(s0, _mm_setzero_si128());
-	s5 = _mm_unpacklo_epi16(s0, _mm_setzero_si128());
-	s6 = _mm_unpackhi_epi16(s1, _mm_setzero_si128());
-	s7 = _mm_unpacklo_epi16(s1, _mm_setzero_si128());
-	s0 = _mm_add_epi32(s4, s6);
-	s1 = _mm_add_epi32(s5, s7);
-
-	s4 = _mm_unpackhi_epi16(s2, _mm_setzero_si128());
-	s5 = _mm_unpacklo_epi16(s2, _mm_setzero_si128());
-	s6 = _mm_unpackhi_epi16(s3, _mm_setzero_si128());
-	s7 = _mm_unpacklo_epi16(s3, _mm_setzero_si128());
-	s2 = _mm_add_epi32(s4, s6);
-	s3 = _mm_add_epi32(s5, s7);
-
-	sad_31 = _mm_add_epi32(s0, s2);
-	sad_30 = _mm_add_epi32(s1, s3);
-
-	sad_0 = _mm_add_epi32(_mm_add_epi32(sad_00, sad_10), _mm_add_epi32(sad_20, sad_30));
-	sad_1 = _mm_add_epi32(_mm_add_epi32(sad_01, sad_11), _mm_add_epi32(sad_21, sad_31));
-	sad_0 = _mm_slli_epi32(sad_0, 1);
-	sad_1 = _mm_slli_epi32(sad_1, 1);
-
-	bestSad64x64 = pBestSad64x64[0];
-	bestMV64x64 = 0;
-	//sad_0
-	temSum = _mm_extract_epi32(sad_0, 0);
-	if (temSum < bestSad64x64){
-		bestSad64x64 = temSum;
-	}
-	temSum = _mm_extract_epi32(sad_0, 1);
-	if (temSum < bestSad64x64){
-		bestSad64x64 = temSum;
-		bestMV64x64 = 1 * 4;
-	}
-	temSum = _mm_extract_epi32(sad_0, 2);
-	if (temSum < bestSad64x64){
-		bestSad64x64 = temSum;
-		bestMV64x64 = 2 * 4;
-	}
-	temSum = _mm_extract_epi32(sad_0, 3);
-	if (temSum < bestSad64x64){
-		bestSad64x64 = temSum;
-		bestMV64x64 = 3 * 4;
-	}
-
-	//sad_1
-	temSum = _mm_extract_epi32(sad_1, 0);
-	if (temSum < bestSad64x64){
-		bestSad64x64 = temSum;
-		bestMV64x64 = 4 * 4;
-	}
-	temSum = _mm_extract_epi32(sad_1, 1);
-	if (temSum < bestSad64x64){
-		bestSad64x64 = temSum;
-		bestMV64x64 = 5 * 4;
-	}
-	temSum = _mm_extract_epi32(sad_1, 2);
-	if (temSum < bestSad64x64){
-		bestSad64x64 = temSum;
-		bestMV64x64 = 6 * 4;
-	}
-	temSum = _mm_extract_epi32(sad_1, 3);
-	if (temSum < bestSad64x64){
-		bestSad64x64 = temSum;
-		bestMV64x64 = 7 * 4;
-	}
-	if (pBestSad64x64[0] != bestSad64x64) {
-		pBestSad64x64[0] = bestSad64x64;
-		xMv = _MVXT(mv) + (EB_S16) bestMV64x64;  yMv = _MVYT(mv);
-		pBestMV64x64[0] = ((EB_U16)yMv << 16) | ((EB_U16)xMv);
-	}
-
-	// ****CODE PAST HERE IS BUGGY FOR GCC****
-
-	// XY
-	// X: 32x32 block [0..3]
-	// Y: Search position [0..7]
-	ss0 = _mm256_setr_m128i(sad_00, sad_01); // 07 06 05 04  03 02 01 00
-	ss1 = _mm256_setr_m128i(sad_10, sad_11); // 17 16 15 14  13 12 11 10
-	ss2 = _mm256_setr_m128i(sad_20, sad_21); // 27 26 25 24  23 22 21 20
-	ss3 = _mm256_setr_m128i(sad_30, sad_31); // 37 36 35 34  33 32 31 30
-	ss4 = _mm256_unpacklo_epi32(ss0, ss1);   // 15 05 14 04  11 01 10 00
-	ss5 = _mm256_unpacklo_epi32(ss2, ss3);   // 35 25 34 24  31 21 30 20
-	ss6 = _mm256_unpackhi_epi32(ss0, ss1);   // 17 07 16 06  13 03 12 02
-	ss7 = _mm256_unpackhi_epi32(ss2, ss3);   // 37 27 36 26  33 23 32 22
-	ss0 = _mm256_unpacklo_epi64(ss4, ss5);   // 34 24 14 04  30 20 10 00
-	ss1 = _mm256_unpackhi_epi64(ss4, ss5);   // 35 25 15 05  31 21 11 01
-	ss2 = _mm256_unpacklo_epi64(ss6, ss7);   // 36 26 16 06  32 22 12 02
-	ss3 = _mm256_unpackhi_epi64(ss6, ss7);   // 37 27 17 07  33 23 13 03
-
-	//   ss4   |  ss5-2  |                ss6        |
-	// a0 : a1 | a2 : a3 | min(a0, a1) : min(a2, a3) |    | (ss4 & !ss6) | ((ss5-2) & ss6) | ((ss4 & !ss6) | ((ss5-2) & ss6)) |
-	// > (-1)  | >  (-3) |         >     (-1)        | a3 |       0      |       -3        |              -3                  |
-	// > (-1)  | >  (-3) |         <=     (0)        | a1 |      -1      |        0        |              -1                  |
-	// > (-1)  | <= (-2) |         >     (-1)        | a2 |       0      |       -2        |              -2                  |
-	// > (-1)  | <= (-2) |         <=     (0)        | a1 |      -1      |        0        |              -1                  |
-	// <= (0)  | >  (-3) |         >     (-1)        | a3 |       0      |       -3        |              -3                  |
-	// <= (0)  | >  (-3) |         <=     (0)        | a0 |       0      |        0        |               0                  |
-	// <= (0)  | <= (-2) |         >     (-1)        | a2 |       0      |       -2        |              -2                  |
-	// <= (0)  | <= (-2) |         <=     (0)        | a0 |       0      |        0        |               0                  |
-
-	// *** 8 search points per position ***
-
-	// ss0: Search Pos 0,4 for blocks 0,1,2,3
-	// ss1: Search Pos 1,5 for blocks 0,1,2,3
-	// ss2: Search Pos 2,6 for blocks 0,1,2,3
-	// ss3: Search Pos 3,7 for blocks 0,1,2,3
-
-	ss4 = _mm256_cmpgt_epi32(ss0, ss1);
-	// not different SVT_LOG("%d\n", _mm_extract_epi32(_mm256_extracti128_si256(ss4, 0), 0)); // DEBUG
-	//ss4 = _mm256_or_si256(_mm256_cmpgt_epi32(ss0, ss1), _mm256_cmpeq_epi32(ss0, ss1));
-	ss0 = _mm256_min_epi32(ss0, ss1);
-	ss5 = _mm256_cmpgt_epi32(ss2, ss3);
-	//ss5 = _mm256_or_si256(_mm256_cmpgt_epi32(ss2, ss3), _mm256_cmpeq_epi32(ss2, ss3));
-	ss2 = _mm256_min_epi32(ss2, ss3);
-	ss5 = _mm256_sub_epi32(ss5, _mm256_set1_epi32(2)); // ss5-2
-
-
-	// *** 4 search points per position ***
-	ss6 = _mm256_cmpgt_epi32(ss0, ss2);
-	//ss6 = _mm256_or_si256(_mm256_cmpgt_epi32(ss0, ss2), _mm256_cmpeq_epi32(ss0, ss2));
-	ss0 = _mm256_min_epi32(ss0, ss2);
-	ss5 = _mm256_and_si256(ss5, ss6); // (ss5-2) & ss6
-	ss4 = _mm256_andnot_si256(ss6, ss4); // ss4 & !ss6
-	ss4 = _mm256_or_si256(ss4, ss5); // (ss4 & !ss6) | ((ss5-2) & ss6)
-
-	// *** 2 search points per position ***
-	s0 = _mm_setzero_si128();
-	s1 = _mm_setzero_si128();
-	s2 = _mm_setzero_si128();
-	s3 = _mm_setzero_si128();
-	s4 = _mm_setzero_si128();
-	s5 = _mm_setzero_si128();
-	s6 = _mm_setzero_si128();
-	s7 = _mm_setzero_si128();
-
-	// ss0 = 8 SADs, two search points for each 32x32
-	// ss4 = 8 MVs, two search points for each 32x32
-	//
-	// XY
-	// X: 32x32 block [0..3]
-	// Y: search position [0..1]
-	// Format: 00 10 20 30  01 11 21 31
-
-	// Each 128 bits contains 4 32x32 32bit block results
-#ifdef __GNUC__
-	// SAD
-	s0 = _mm256_extracti128_si256(ss0, 1);
-	s1 = _mm256_extracti128_si256(ss0, 0);
-	// MV
-	s2 = _mm256_extracti128_si256(ss4, 1);
-	s3 = _mm256_extracti128_si256(ss4, 0);
-#else
-	// SAD
-	s0 = _mm256_extracti128_si256(ss0, 0);
-	s1 = _mm256_extracti128_si256(ss0, 1);
-	// MV
-	s2 = _mm256_extracti128_si256(ss4, 0);
-	s3 = _mm256_extracti128_si256(ss4, 1);
-#endif
-
-	//// Should be fine
-	//SVT_LOG("sad0 %d, %d, %d, %d\n", _mm_extract_epi32(s0, 0), _mm_extract_epi32(s0, 1), _mm_extract_epi32(s0, 2), _mm_extract_epi32(s0, 3)); // DEBUG
-	//SVT_LOG("sad1 %d, %d, %d, %d\n", _mm_extract_epi32(s1, 0), _mm_extract_epi32(s1, 1), _mm_extract_epi32(s1, 2), _mm_extract_epi32(s1, 3)); // DEBUG
-	//SVT_LOG("mv0 %d, %d, %d, %d\n", _mm_extract_epi32(s2, 0), _mm_extract_epi32(s2, 1), _mm_extract_epi32(s2, 2), _mm_extract_epi32(s2, 3)); // DEBUG
-	//SVT_LOG("mv1 %d, %d, %d, %d\n", _mm_extract_epi32(s3, 0), _mm_extract_epi32(s3, 1), _mm_extract_epi32(s3, 2), _mm_extract_epi32(s3, 3)); // DEBUG
-
-
-	// Choose the best MV out of the two, use s4 to hold results of min
-	s4 = _mm_cmpgt_epi32(s0, s1);
-
-	// DIFFERENT BETWEEN VS AND GCC
-	// SVT_LOG("%d, %d, %d, %d\n", _mm_extract_epi32(s4, 0), _mm_extract_epi32(s4, 1), _mm_extract_epi32(s4, 2), _mm_extract_epi32(s4, 3)); // DEBUG
-
-	//s4 = _mm_or_si128(_mm_cmpgt_epi32(s0, s1), _mm_cmpeq_epi32(s0, s1));
-	s0 = _mm_min_epi32(s0, s1);
-
-
-
-	// Extract MV's based on the blocks to s2
-	s3 = _mm_sub_epi32(s3, _mm_set1_epi32(4)); // s3-4
-	// Remove the MV's are not used from s2
-	s2 = _mm_andnot_si128(s4, s2);
-	// Remove the MV's that are not used from s3 (inverse from s2 above operation)
-	s3 = _mm_and_si128(s4, s3);
-	// Combine the remaining candidates into s2
-	s2 = _mm_or_si128(s2, s3);
-	// Convert MV's into encoders format
-	s2 = _mm_sub_epi32(_mm_setzero_si128(), s2);
-	s2 = _mm_slli_epi32(s2, 2); // mv info
-
-
-	// ***SAD***
-	// s0: current SAD candidates for each 32x32
-	// s1: best SAD's for 32x32
-
-	// << 1 to compensate for every other line
-	s0 = _mm_slli_epi32(s0, 1); // best sad info 
-	// Load best SAD's
-	s1 = _mm_loadu_si128((__m128i*)pBestSad32x32);
-
-	// Determine which candidates are better than the current best SAD's. 
-	// s4 is used to determine the MV's of the new best SAD's
-	s4 = _mm_cmpgt_epi32(s1, s0);
-	// not different SVT_LOG("%d, %d, %d, %d\n", _mm_extract_epi32(s4, 0), _mm_extract_epi32(s4, 1), _mm_extract_epi32(s4, 2), _mm_extract_epi32(s4, 3)); // DEBUG
-	//s4 = _mm_or_si128(_mm_cmpgt_epi32(s1, s0), _mm_cmpeq_epi32(s1, s0));
-	// Combine old and new min SAD's
-	s0 = _mm_min_epu32(s0, s1);
-	// Store new best SAD's back to memory
-	_mm_storeu_si128((__m128i*)pBestSad32x32, s0);
-
-
-	// ***Motion Vectors***
-	// Load best MV's
-	// s3: candidate MV's
-	// s4: results of comparing SAD's
-	// s5: previous best MV's
-
-	// Load previous best MV's
-	s5 = _mm_loadu_si128((__m128i*)pBestMV32x32);
-	// Remove the MV's that are being replaced
-	s5 = _mm_andnot_si128(s4, s5);
-	// Set s3 to the base MV
-	s3 = _mm_set1_epi32(mv);
-	// Add candidate MV's to base MV
-	s3 = _mm_add_epi16(s3, s2);
-	// Remove non-candidate's
-	s3 = _mm_and_si128(s3, s4);
-	// Combine remaining candidates with remaining best MVs
-	s3 = _mm_or_si128(s3, s5);
-	// Store back to memory
-	_mm_storeu_si128((__m128i*)pBestMV32x32, s3);
-}
-
-
-
 AVX512_FUNC_TARGET
 void GetEightHorizontalSearchPointResultsAll85PUs_AVX512_INTRIN(
 	MeContext_t             *contextPtr,
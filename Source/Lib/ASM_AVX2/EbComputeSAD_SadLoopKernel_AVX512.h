@@ -27,7 +27,8 @@ void SadLoopKernel_AVX512_HmeL0_INTRIN(
     EB_U32  srcStrideRaw,                   // input parameter, source stride (no line skipping)
     EB_S16 searchAreaWidth,
     EB_S16 searchAreaHeight);
-#else
+#endif
+
     void SadLoopKernel_AVX2_HmeL0_INTRIN(
         EB_U8  *src,                            // input parameter, source samples Ptr
         EB_U32  srcStride,                      // input parameter, source stride
@@ -41,7 +42,6 @@ void SadLoopKernel_AVX512_HmeL0_INTRIN(
         EB_U32  srcStrideRaw,                   // input parameter, source stride (no line skipping)
         EB_S16 searchAreaWidth,
         EB_S16 searchAreaHeight);
-#endif
 
 #ifndef NON_AVX512_SUPPORT
 extern void GetEightHorizontalSearchPointResultsAll85PUs_AVX512_INTRIN(
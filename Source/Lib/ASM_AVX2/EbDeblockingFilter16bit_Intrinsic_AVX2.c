@@ -0,0 +1,351 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "immintrin.h"
+#include "EbDefinitions.h"
+#include "EbDeblockingFilter_SSE2.h"
+#include "EbDeblockingFilter_SSSE3.h"
+#include "EbDeblockingFilter_AVX2.h"
+
+// The kernels filter the 8 samples of an edge of an 8x8 block at once: the two
+// 4 sample luma segments, or the four 2 sample chroma segments, each with its own
+// tc and beta. The decisions of a segment only read the lines of that segment.
+// When a segment of the edge is not filtered the other ones go to the segment
+// kernels, so no sample outside the filtered segments is read or written.
+
+/*****************************************
+* 8x8 transpose
+*   in:  { row0 | row4 }, { row1 | row5 }, { row2 | row6 }, { row3 | row7 }
+*   out: { col0 | col1 }, { col2 | col3 }, { col4 | col5 }, { col6 | col7 }
+*****************************************/
+static FORCE_INLINE void Dlf16bitTranspose8x8(
+    __m256i *x)
+{
+    __m256i b0 = _mm256_unpacklo_epi16(x[0], x[1]);
+    __m256i b1 = _mm256_unpackhi_epi16(x[0], x[1]);
+    __m256i b2 = _mm256_unpacklo_epi16(x[2], x[3]);
+    __m256i b3 = _mm256_unpackhi_epi16(x[2], x[3]);
+
+    x[0] = _mm256_permute4x64_epi64(_mm256_unpacklo_epi32(b0, b2), 0xD8);
+    x[1] = _mm256_permute4x64_epi64(_mm256_unpackhi_epi32(b0, b2), 0xD8);
+    x[2] = _mm256_permute4x64_epi64(_mm256_unpacklo_epi32(b1, b3), 0xD8);
+    x[3] = _mm256_permute4x64_epi64(_mm256_unpackhi_epi32(b1, b3), 0xD8);
+}
+
+// Line 0 and line 3 of each 4 sample luma segment, copied to the whole segment
+static FORCE_INLINE __m256i Dlf16bitLine0(
+    __m256i x)
+{
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0x00), 0x00);
+}
+
+static FORCE_INLINE __m256i Dlf16bitLine3(
+    __m256i x)
+{
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xFF), 0xFF);
+}
+
+static FORCE_INLINE __m256i Dlf16bitClip(
+    __m256i x,
+    __m256i minValue,
+    __m256i maxValue)
+{
+    return _mm256_max_epi16(_mm256_min_epi16(x, maxValue), minValue);
+}
+
+/*****************************************
+* Luma 8 sample edge filter
+*   pq[i] = { pi | qi } of the 8 lines, p2 to q2 are
+*   filtered in place. Returns 0 when no line is filtered
+*****************************************/
+static FORCE_INLINE int Luma8SampleEdgeFilter16bit(
+    __m256i *pq,
+    __m256i  tc,
+    __m256i  beta)
+{
+    __m256i zero     = _mm256_setzero_si256();
+    __m256i max10bit = _mm256_set1_epi16(0x03FF);
+    __m256i qp0      = _mm256_permute2x128_si256(pq[0], pq[0], 0x01);
+    __m256i qp1      = _mm256_permute2x128_si256(pq[1], pq[1], 0x01);
+    __m256i dpq, dLine, filterMask, strongMask, weakMask, sideMask;
+    __m256i tc2, sum, strong0, strong1, strong2, delta, weak0, weak1, t0, t1;
+
+    // dp = | p2 - 2*p1 + p0 | in the low half, dq = | q2 - 2*q1 + q0 | in the high half
+    dpq = _mm256_abs_epi16(_mm256_sub_epi16(_mm256_add_epi16(pq[2], pq[0]), _mm256_add_epi16(pq[1], pq[1])));
+
+    // d = d0 + d3, decision if d > beta : no filtering
+    dLine = _mm256_add_epi16(dpq, _mm256_permute2x128_si256(dpq, dpq, 0x01));
+    filterMask = _mm256_cmpgt_epi16(beta, _mm256_add_epi16(Dlf16bitLine0(dLine), Dlf16bitLine3(dLine)));
+    if (_mm256_testz_si256(filterMask, filterMask)) {
+        return 0;
+    }
+
+    // strong filtering decision of each line
+    // ((d << 1) < (beta >> 2)) && (beta >> 3) > (ABS(p3 - p0) + ABS(q3 - q0)) && ((5 * tc + 1) >> 1) > ABS(p0 - q0)
+    t0 = _mm256_abs_epi16(_mm256_sub_epi16(pq[3], pq[0]));
+    t0 = _mm256_add_epi16(t0, _mm256_permute2x128_si256(t0, t0, 0x01));
+    t1 = _mm256_and_si256(
+        _mm256_cmpgt_epi16(_mm256_srai_epi16(beta, 2), _mm256_slli_epi16(dLine, 1)),
+        _mm256_cmpgt_epi16(_mm256_srai_epi16(beta, 3), t0));
+    t0 = _mm256_avg_epu16(_mm256_add_epi16(_mm256_slli_epi16(tc, 2), tc), zero);
+    t1 = _mm256_and_si256(t1, _mm256_cmpgt_epi16(t0, _mm256_abs_epi16(_mm256_sub_epi16(pq[0], qp0))));
+
+    // strongFiltering = strongFilteringLine0 && strongFilteringLine3
+    strongMask = _mm256_and_si256(filterMask, _mm256_and_si256(Dlf16bitLine0(t1), Dlf16bitLine3(t1)));
+
+    // strong filtering
+    tc2 = _mm256_slli_epi16(tc, 1);
+    sum = _mm256_add_epi16(_mm256_add_epi16(pq[0], qp0), pq[1]);                                     // p0 + q0 + p1
+    strong0 = _mm256_add_epi16(_mm256_add_epi16(sum, sum), _mm256_add_epi16(pq[2], qp1));              // p2 + 2*p1 + 2*p0 + 2*q0 + q1
+    strong0 = _mm256_srai_epi16(_mm256_add_epi16(strong0, _mm256_set1_epi16(4)), 3);
+    strong0 = Dlf16bitClip(strong0, _mm256_sub_epi16(pq[0], tc2), _mm256_add_epi16(pq[0], tc2));
+
+    strong1 = _mm256_add_epi16(sum, pq[2]);                                                           // p2 + p1 + p0 + q0
+    strong1 = _mm256_srai_epi16(_mm256_add_epi16(strong1, _mm256_set1_epi16(2)), 2);
+    strong1 = Dlf16bitClip(strong1, _mm256_sub_epi16(pq[1], tc2), _mm256_add_epi16(pq[1], tc2));
+
+    strong2 = _mm256_add_epi16(_mm256_add_epi16(pq[3], pq[2]), _mm256_add_epi16(pq[3], pq[2]));
+    strong2 = _mm256_add_epi16(_mm256_add_epi16(strong2, pq[2]), sum);                                // 2*p3 + 3*p2 + p1 + p0 + q0
+    strong2 = _mm256_srai_epi16(_mm256_add_epi16(strong2, _mm256_set1_epi16(4)), 3);
+    strong2 = Dlf16bitClip(strong2, _mm256_sub_epi16(pq[2], tc2), _mm256_add_epi16(pq[2], tc2));
+
+    // weak filtering, delta = ((q0 - p0) * 9 - (q1 - p1) * 3 + 8) >> 4 in the low half
+    t0 = _mm256_sub_epi16(qp0, pq[0]);
+    t1 = _mm256_sub_epi16(qp1, pq[1]);
+    delta = _mm256_sub_epi16(_mm256_add_epi16(t0, _mm256_slli_epi16(t0, 3)), _mm256_add_epi16(t1, _mm256_add_epi16(t1, t1)));
+    delta = _mm256_srai_epi16(_mm256_add_epi16(delta, _mm256_set1_epi16(8)), 4);
+
+    // if ABS(delta) < tc * 10 the line is filtered, delta = CLIP3(-tc, tc, delta)
+    t0 = _mm256_slli_epi16(_mm256_add_epi16(_mm256_slli_epi16(tc, 2), tc), 1);
+    t0 = _mm256_cmpgt_epi16(t0, _mm256_abs_epi16(delta));
+    weakMask = _mm256_andnot_si256(strongMask, _mm256_and_si256(filterMask, _mm256_permute2x128_si256(t0, t0, 0x00)));
+    delta = Dlf16bitClip(delta, _mm256_sub_epi16(zero, tc), tc);
+    delta = _mm256_permute2x128_si256(delta, _mm256_sub_epi16(zero, delta), 0x20);                     // { delta | -delta }
+
+    weak0 = Dlf16bitClip(_mm256_add_epi16(pq[0], delta), zero, max10bit);
+
+    // sideBlocksThresh = (beta + (beta >> 1)) >> 3, p1 is filtered if sideBlocksThresh > dp, q1 if sideBlocksThresh > dq
+    t0 = _mm256_srai_epi16(_mm256_add_epi16(beta, _mm256_srai_epi16(beta, 1)), 3);
+    sideMask = _mm256_and_si256(weakMask, _mm256_cmpgt_epi16(t0, _mm256_add_epi16(Dlf16bitLine0(dpq), Dlf16bitLine3(dpq))));
+
+    // delta1 = CLIP3(-tc2, tc2, ((((p0 + p2 + 1) >> 1) - p1 + delta) >> 1)), tc2 = tc >> 1
+    t0 = _mm256_srai_epi16(tc, 1);
+    t1 = _mm256_sub_epi16(_mm256_avg_epu16(pq[0], pq[2]), pq[1]);
+    t1 = _mm256_srai_epi16(_mm256_add_epi16(t1, delta), 1);
+    t1 = Dlf16bitClip(t1, _mm256_sub_epi16(zero, t0), t0);
+    weak1 = Dlf16bitClip(_mm256_add_epi16(pq[1], t1), zero, max10bit);
+
+    pq[0] = _mm256_blendv_epi8(_mm256_blendv_epi8(pq[0], strong0, strongMask), weak0, weakMask);
+    pq[1] = _mm256_blendv_epi8(_mm256_blendv_epi8(pq[1], strong1, strongMask), weak1, sideMask);
+    pq[2] = _mm256_blendv_epi8(pq[2], strong2, strongMask);
+
+    return 1;
+}
+
+void Luma8SampleEdgeDLFCore16bit_AVX2_INTRIN(
+    EB_U16         *edgeStartFilteredSamplePtr,
+    EB_U32          reconLumaPicStride,
+    EB_BOOL         isVerticalEdge,
+    EB_S32         *tcArray,
+    EB_S32         *betaArray)
+{
+    EB_U16 *samplePtr;
+    __m256i tc;
+    __m256i beta;
+    __m256i pq[4];
+    __m256i x[4];
+    EB_U32  segmentIndex;
+    EB_U32  lineIndex;
+
+    // A segment with a zero beta is not filtered
+    if (betaArray[0] == 0 || betaArray[1] == 0) {
+        for (segmentIndex = 0; segmentIndex < 2; ++segmentIndex) {
+            if (betaArray[segmentIndex]) {
+                Luma4SampleEdgeDLFCore16bit_SSSE3_INTRIN(
+                    edgeStartFilteredSamplePtr + segmentIndex * (isVerticalEdge ? 4 * reconLumaPicStride : 4),
+                    reconLumaPicStride,
+                    isVerticalEdge,
+                    tcArray[segmentIndex],
+                    betaArray[segmentIndex]);
+            }
+        }
+        return;
+    }
+
+    tc   = _mm256_broadcastsi128_si256(_mm_unpacklo_epi64(_mm_set1_epi16((EB_S16)tcArray[0]), _mm_set1_epi16((EB_S16)tcArray[1])));
+    beta = _mm256_broadcastsi128_si256(_mm_unpacklo_epi64(_mm_set1_epi16((EB_S16)betaArray[0]), _mm_set1_epi16((EB_S16)betaArray[1])));
+
+    if (!isVerticalEdge) {
+        for (lineIndex = 0; lineIndex < 4; ++lineIndex) {
+            pq[lineIndex] = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(edgeStartFilteredSamplePtr - (lineIndex + 1) * reconLumaPicStride))),
+                _mm_loadu_si128((__m128i *)(edgeStartFilteredSamplePtr + lineIndex * reconLumaPicStride)),
+                1);
+        }
+
+        if (Luma8SampleEdgeFilter16bit(pq, tc, beta)) {
+            for (lineIndex = 0; lineIndex < 3; ++lineIndex) {
+                _mm_storeu_si128((__m128i *)(edgeStartFilteredSamplePtr - (lineIndex + 1) * reconLumaPicStride), _mm256_castsi256_si128(pq[lineIndex]));
+                _mm_storeu_si128((__m128i *)(edgeStartFilteredSamplePtr + lineIndex * reconLumaPicStride), _mm256_extracti128_si256(pq[lineIndex], 1));
+            }
+        }
+    }
+    else {
+        samplePtr = edgeStartFilteredSamplePtr - 4;
+        for (lineIndex = 0; lineIndex < 4; ++lineIndex) {
+            x[lineIndex] = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(samplePtr + lineIndex * reconLumaPicStride))),
+                _mm_loadu_si128((__m128i *)(samplePtr + (lineIndex + 4) * reconLumaPicStride)),
+                1);
+        }
+
+        // { p3 | p2 }, { p1 | p0 }, { q0 | q1 }, { q2 | q3 }
+        Dlf16bitTranspose8x8(x);
+        pq[0] = _mm256_permute2x128_si256(x[1], x[2], 0x21);
+        pq[1] = _mm256_permute2x128_si256(x[1], x[2], 0x30);
+        pq[2] = _mm256_permute2x128_si256(x[0], x[3], 0x21);
+        pq[3] = _mm256_permute2x128_si256(x[0], x[3], 0x30);
+
+        if (Luma8SampleEdgeFilter16bit(pq, tc, beta)) {
+            // { p3 | q0 }, { p2 | q1 }, { p1 | q2 }, { p0 | q3 } back to the lines
+            x[0] = _mm256_permute2x128_si256(pq[3], pq[0], 0x30);
+            x[1] = _mm256_permute2x128_si256(pq[2], pq[1], 0x30);
+            x[2] = _mm256_permute2x128_si256(pq[1], pq[2], 0x30);
+            x[3] = _mm256_permute2x128_si256(pq[0], pq[3], 0x30);
+            Dlf16bitTranspose8x8(x);
+
+            for (lineIndex = 0; lineIndex < 4; ++lineIndex) {
+                _mm_storeu_si128((__m128i *)(samplePtr + (2 * lineIndex) * reconLumaPicStride), _mm256_castsi256_si128(x[lineIndex]));
+                _mm_storeu_si128((__m128i *)(samplePtr + (2 * lineIndex + 1) * reconLumaPicStride), _mm256_extracti128_si256(x[lineIndex], 1));
+            }
+        }
+    }
+}
+
+/*****************************************
+* Chroma 8 sample edge filter
+*   { Cb | Cr } of the 8 lines in each vector,
+*   p0 and q0 are filtered in place
+*****************************************/
+static FORCE_INLINE void Chroma8SampleEdgeFilter16bit(
+    __m256i  p1,
+    __m256i *p0,
+    __m256i *q0,
+    __m256i  q1,
+    __m256i  tc)
+{
+    __m256i zero     = _mm256_setzero_si256();
+    __m256i max10bit = _mm256_set1_epi16(0x03FF);
+
+    // delta = CLIP3(-tc, tc, ((((q0 - p0) << 2) + p1 - q1 + 4) >> 3))
+    __m256i delta = _mm256_add_epi16(_mm256_slli_epi16(_mm256_sub_epi16(*q0, *p0), 2), _mm256_sub_epi16(p1, q1));
+    delta = _mm256_srai_epi16(_mm256_add_epi16(delta, _mm256_set1_epi16(4)), 3);
+    delta = Dlf16bitClip(delta, _mm256_sub_epi16(zero, tc), tc);
+
+    *p0 = Dlf16bitClip(_mm256_add_epi16(*p0, delta), zero, max10bit);
+    *q0 = Dlf16bitClip(_mm256_sub_epi16(*q0, delta), zero, max10bit);
+}
+
+void Chroma8SampleEdgeDLFCore16bit_AVX2_INTRIN(
+    EB_U16         *edgeStartSampleCb,
+    EB_U16         *edgeStartSampleCr,
+    EB_U32          reconChromaPicStride,
+    EB_BOOL         isVerticalEdge,
+    EB_U8          *cbTcArray,
+    EB_U8          *crTcArray)
+{
+    __m256i tc;
+    __m256i p1, p0, q0, q1;
+    __m256i y[4];
+    __m128i cb;
+    __m128i cr;
+    EB_U32  segmentIndex;
+    EB_U32  lineIndex;
+
+    // A segment with a zero tc in both components is not filtered
+    for (segmentIndex = 0; segmentIndex < 4; ++segmentIndex) {
+        if ((cbTcArray[segmentIndex] | crTcArray[segmentIndex]) == 0) {
+            break;
+        }
+    }
+    if (segmentIndex < 4) {
+        for (segmentIndex = 0; segmentIndex < 4; ++segmentIndex) {
+            if (cbTcArray[segmentIndex] | crTcArray[segmentIndex]) {
+                Chroma2SampleEdgeDLFCore16bit_SSE2_INTRIN(
+                    edgeStartSampleCb + segmentIndex * (isVerticalEdge ? 2 * reconChromaPicStride : 2),
+                    edgeStartSampleCr + segmentIndex * (isVerticalEdge ? 2 * reconChromaPicStride : 2),
+                    reconChromaPicStride,
+                    isVerticalEdge,
+                    cbTcArray[segmentIndex],
+                    crTcArray[segmentIndex]);
+            }
+        }
+        return;
+    }
+
+    tc = _mm256_setr_epi16(
+        cbTcArray[0], cbTcArray[0], cbTcArray[1], cbTcArray[1], cbTcArray[2], cbTcArray[2], cbTcArray[3], cbTcArray[3],
+        crTcArray[0], crTcArray[0], crTcArray[1], crTcArray[1], crTcArray[2], crTcArray[2], crTcArray[3], crTcArray[3]);
+
+    if (!isVerticalEdge) {
+        p1 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(edgeStartSampleCb - 2 * reconChromaPicStride))), _mm_loadu_si128((__m128i *)(edgeStartSampleCr - 2 * reconChromaPicStride)), 1);
+        p0 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(edgeStartSampleCb - reconChromaPicStride))), _mm_loadu_si128((__m128i *)(edgeStartSampleCr - reconChromaPicStride)), 1);
+        q0 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)edgeStartSampleCb)), _mm_loadu_si128((__m128i *)edgeStartSampleCr), 1);
+        q1 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(edgeStartSampleCb + reconChromaPicStride))), _mm_loadu_si128((__m128i *)(edgeStartSampleCr + reconChromaPicStride)), 1);
+
+        Chroma8SampleEdgeFilter16bit(p1, &p0, &q0, q1, tc);
+
+        _mm_storeu_si128((__m128i *)(edgeStartSampleCb - reconChromaPicStride), _mm256_castsi256_si128(p0));
+        _mm_storeu_si128((__m128i *)(edgeStartSampleCr - reconChromaPicStride), _mm256_extracti128_si256(p0, 1));
+        _mm_storeu_si128((__m128i *)edgeStartSampleCb, _mm256_castsi256_si128(q0));
+        _mm_storeu_si128((__m128i *)edgeStartSampleCr, _mm256_extracti128_si256(q0, 1));
+    }
+    else {
+        // { p1 p0 q0 q1 of line 2i, line 2i + 1 } of Cb and Cr
+        for (lineIndex = 0; lineIndex < 4; ++lineIndex) {
+            cb = _mm_unpacklo_epi64(
+                _mm_loadl_epi64((__m128i *)(edgeStartSampleCb + (2 * lineIndex) * reconChromaPicStride - 2)),
+                _mm_loadl_epi64((__m128i *)(edgeStartSampleCb + (2 * lineIndex + 1) * reconChromaPicStride - 2)));
+            cr = _mm_unpacklo_epi64(
+                _mm_loadl_epi64((__m128i *)(edgeStartSampleCr + (2 * lineIndex) * reconChromaPicStride - 2)),
+                _mm_loadl_epi64((__m128i *)(edgeStartSampleCr + (2 * lineIndex + 1) * reconChromaPicStride - 2)));
+            y[lineIndex] = _mm256_inserti128_si256(_mm256_castsi128_si256(cb), cr, 1);
+        }
+
+        p1 = _mm256_unpacklo_epi16(y[0], y[1]);                       // lines 0 2 of p1, p0, q0, q1
+        p0 = _mm256_unpackhi_epi16(y[0], y[1]);                       // lines 1 3
+        q0 = _mm256_unpacklo_epi16(y[2], y[3]);                       // lines 4 6
+        q1 = _mm256_unpackhi_epi16(y[2], y[3]);                       // lines 5 7
+        y[0] = _mm256_unpacklo_epi16(p1, p0);                         // p1 p0 of lines 0 to 3
+        y[1] = _mm256_unpackhi_epi16(p1, p0);                         // q0 q1 of lines 0 to 3
+        y[2] = _mm256_unpacklo_epi16(q0, q1);                         // p1 p0 of lines 4 to 7
+        y[3] = _mm256_unpackhi_epi16(q0, q1);                         // q0 q1 of lines 4 to 7
+        p1 = _mm256_unpacklo_epi64(y[0], y[2]);
+        p0 = _mm256_unpackhi_epi64(y[0], y[2]);
+        q0 = _mm256_unpacklo_epi64(y[1], y[3]);
+        q1 = _mm256_unpackhi_epi64(y[1], y[3]);
+
+        Chroma8SampleEdgeFilter16bit(p1, &p0, &q0, q1, tc);
+
+        // { p0 q0 } of each line
+        y[0] = _mm256_unpacklo_epi16(p0, q0);
+        y[1] = _mm256_unpackhi_epi16(p0, q0);
+        for (lineIndex = 0; lineIndex < 2; ++lineIndex) {
+            EB_U16 *cbPtr = edgeStartSampleCb + 4 * lineIndex * reconChromaPicStride - 1;
+            EB_U16 *crPtr = edgeStartSampleCr + 4 * lineIndex * reconChromaPicStride - 1;
+
+            cb = _mm256_castsi256_si128(y[lineIndex]);
+            cr = _mm256_extracti128_si256(y[lineIndex], 1);
+            *(EB_U32 *)cbPtr = _mm_cvtsi128_si32(cb);
+            *(EB_U32 *)crPtr = _mm_cvtsi128_si32(cr);
+            *(EB_U32 *)(cbPtr + reconChromaPicStride) = _mm_cvtsi128_si32(_mm_srli_si128(cb, 4));
+            *(EB_U32 *)(crPtr + reconChromaPicStride) = _mm_cvtsi128_si32(_mm_srli_si128(cr, 4));
+            *(EB_U32 *)(cbPtr + 2 * reconChromaPicStride) = _mm_cvtsi128_si32(_mm_srli_si128(cb, 8));
+            *(EB_U32 *)(crPtr + 2 * reconChromaPicStride) = _mm_cvtsi128_si32(_mm_srli_si128(cr, 8));
+            *(EB_U32 *)(cbPtr + 3 * reconChromaPicStride) = _mm_cvtsi128_si32(_mm_srli_si128(cb, 12));
+            *(EB_U32 *)(crPtr + 3 * reconChromaPicStride) = _mm_cvtsi128_si32(_mm_srli_si128(cr, 12));
+        }
+    }
+}
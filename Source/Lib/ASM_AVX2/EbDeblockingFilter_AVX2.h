@@ -0,0 +1,33 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbDeblockingFilter_AVX2_h
+#define EbDeblockingFilter_AVX2_h
+
+#include "EbDefinitions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Luma8SampleEdgeDLFCore16bit_AVX2_INTRIN(
+    EB_U16         *edgeStartFilteredSamplePtr,
+    EB_U32          reconLumaPicStride,
+    EB_BOOL         isVerticalEdge,
+    EB_S32         *tcArray,
+    EB_S32         *betaArray);
+
+void Chroma8SampleEdgeDLFCore16bit_AVX2_INTRIN(
+    EB_U16         *edgeStartSampleCb,
+    EB_U16         *edgeStartSampleCr,
+    EB_U32          reconChromaPicStride,
+    EB_BOOL         isVerticalEdge,
+    EB_U8          *cbTcArray,
+    EB_U8          *crTcArray);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbDeblockingFilter_AVX2_h
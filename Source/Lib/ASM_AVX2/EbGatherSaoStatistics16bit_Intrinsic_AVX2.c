@@ -0,0 +1,229 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "immintrin.h"
+#include "EbDefinitions.h"
+#include "EbSampleAdaptiveOffset_AVX2.h"
+#include "EbSampleAdaptiveOffset_C.h"
+
+#define SAO_EO_GATHER_CATEGORIES    4   // edge categories -2, -1, 1 and 2; category 0 is not gathered
+#define SAO_EO_GATHER_MIN_WIDTH     18  // one full vector of 16 samples between the borders
+
+typedef struct SaoEoAccumulator16bit_s {
+    __m256i diff[SAO_EO_TYPES][SAO_EO_GATHER_CATEGORIES];   // 32-bit sums of input - recon
+    __m256i count[SAO_EO_TYPES][SAO_EO_GATHER_CATEGORIES];  // 16-bit sample counts
+} SaoEoAccumulator16bit_t;
+
+/*****************************************
+* Accumulates one edge direction of 16 samples
+*   sign(a, b) = (b < a) - (a < b); the edge index
+*   sign(cur, n0) + sign(cur, n1) selects the category
+*****************************************/
+static FORCE_INLINE void GatherSaoEoType16bit(
+    __m256i     cur,
+    __m256i     neighbor0,
+    __m256i     neighbor1,
+    __m256i     diff,
+    __m256i     valid,
+    __m256i    *diffSum,
+    __m256i    *count)
+{
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i sign0 = _mm256_sub_epi16(_mm256_cmpgt_epi16(neighbor0, cur), _mm256_cmpgt_epi16(cur, neighbor0));
+    __m256i sign1 = _mm256_sub_epi16(_mm256_cmpgt_epi16(neighbor1, cur), _mm256_cmpgt_epi16(cur, neighbor1));
+    __m256i eoIndex = _mm256_add_epi16(sign0, sign1);
+    __m256i mask;
+
+    mask = _mm256_and_si256(_mm256_cmpeq_epi16(eoIndex, _mm256_set1_epi16(-2)), valid);
+    count[0] = _mm256_sub_epi16(count[0], mask);
+    diffSum[0] = _mm256_add_epi32(diffSum[0], _mm256_madd_epi16(_mm256_and_si256(mask, diff), ones));
+
+    mask = _mm256_and_si256(_mm256_cmpeq_epi16(eoIndex, _mm256_set1_epi16(-1)), valid);
+    count[1] = _mm256_sub_epi16(count[1], mask);
+    diffSum[1] = _mm256_add_epi32(diffSum[1], _mm256_madd_epi16(_mm256_and_si256(mask, diff), ones));
+
+    mask = _mm256_and_si256(_mm256_cmpeq_epi16(eoIndex, ones), valid);
+    count[2] = _mm256_sub_epi16(count[2], mask);
+    diffSum[2] = _mm256_add_epi32(diffSum[2], _mm256_madd_epi16(_mm256_and_si256(mask, diff), ones));
+
+    mask = _mm256_and_si256(_mm256_cmpeq_epi16(eoIndex, _mm256_set1_epi16(2)), valid);
+    count[3] = _mm256_sub_epi16(count[3], mask);
+    diffSum[3] = _mm256_add_epi32(diffSum[3], _mm256_madd_epi16(_mm256_and_si256(mask, diff), ones));
+}
+
+/*****************************************
+* Accumulates the edge categories of the 16 samples at reconPtr
+*****************************************/
+static FORCE_INLINE void GatherSaoEo16bit(
+    EB_U16                  *inputPtr,
+    EB_U16                  *reconPtr,
+    EB_U32                   reconStride,
+    __m256i                  valid,
+    SaoEoAccumulator16bit_t *accumulator,
+    const EB_BOOL            gatherEo0)
+{
+    __m256i cur = _mm256_loadu_si256((__m256i *)reconPtr);
+    __m256i diff = _mm256_sub_epi16(_mm256_loadu_si256((__m256i *)inputPtr), cur);
+    EB_U16 *topPtr = reconPtr - reconStride;
+    EB_U16 *bottomPtr = reconPtr + reconStride;
+
+    if (gatherEo0) {
+        GatherSaoEoType16bit(cur,
+            _mm256_loadu_si256((__m256i *)(reconPtr - 1)),
+            _mm256_loadu_si256((__m256i *)(reconPtr + 1)),
+            diff, valid, accumulator->diff[0], accumulator->count[0]);
+    }
+    GatherSaoEoType16bit(cur,
+        _mm256_loadu_si256((__m256i *)topPtr),
+        _mm256_loadu_si256((__m256i *)bottomPtr),
+        diff, valid, accumulator->diff[1], accumulator->count[1]);
+    GatherSaoEoType16bit(cur,
+        _mm256_loadu_si256((__m256i *)(topPtr - 1)),
+        _mm256_loadu_si256((__m256i *)(bottomPtr + 1)),
+        diff, valid, accumulator->diff[2], accumulator->count[2]);
+    GatherSaoEoType16bit(cur,
+        _mm256_loadu_si256((__m256i *)(topPtr + 1)),
+        _mm256_loadu_si256((__m256i *)(bottomPtr - 1)),
+        diff, valid, accumulator->diff[3], accumulator->count[3]);
+}
+
+static FORCE_INLINE EB_S32 HorizontalSum32_AVX2(
+    __m256i sum)
+{
+    __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0x4E));
+    sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0xB1));
+    return _mm_cvtsi128_si32(sum128);
+}
+
+/*****************************************
+* Gathers the SAO statistics of one LCU
+*   The edge offset is vectorized 16 samples at a time; a row whose
+*   width is not a multiple of 16 ends with an overlapping vector
+*   whose already gathered lanes are masked out. The band histogram
+*   is gathered per sample.
+*****************************************/
+static FORCE_INLINE void GatherSaoStatisticsLcu16bit_AVX2(
+    EB_U16                   *inputSamplePtr,
+    EB_U32                   inputStride,
+    EB_U16                   *reconSamplePtr,
+    EB_U32                   reconStride,
+    EB_U32                   lcuWidth,
+    EB_U32                   lcuHeight,
+    EB_S32                  *boDiff,
+    EB_U16                  *boCount,
+    EB_S32                   eoDiff[SAO_EO_TYPES][SAO_EO_CATEGORIES + 1],
+    EB_U16                   eoCount[SAO_EO_TYPES][SAO_EO_CATEGORIES + 1],
+    const EB_BOOL            gatherBoEo0)
+{
+    static const EB_S16 tailLanes[32] = {
+         0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+    SaoEoAccumulator16bit_t accumulator;
+    const __m256i allLanes = _mm256_set1_epi16(-1);
+    __m256i tailValid;
+    EB_U32 width = lcuWidth - 2;
+    EB_U32 tailStart = width - 16;
+    EB_U32 boIndex, eoType, eoIndex;
+    EB_U32 i, j;
+
+    // Only the lanes past the last full vector are new in the tail vector
+    tailValid = _mm256_loadu_si256((__m256i *)(tailLanes + (width & 15)));
+
+    for (eoType = 0; eoType < SAO_EO_TYPES; ++eoType) {
+        for (eoIndex = 0; eoIndex < SAO_EO_GATHER_CATEGORIES; ++eoIndex) {
+            accumulator.diff[eoType][eoIndex] = _mm256_setzero_si256();
+            accumulator.count[eoType][eoIndex] = _mm256_setzero_si256();
+        }
+    }
+
+    if (gatherBoEo0) {
+        for (boIndex = 0; boIndex < SAO_BO_INTERVALS; ++boIndex) {
+            boDiff[boIndex] = 0;
+            boCount[boIndex] = 0;
+        }
+    }
+
+    inputSamplePtr += 1 + inputStride;
+    reconSamplePtr += 1 + reconStride;
+
+    for (j = 0; j < lcuHeight - 2; j++) {
+        for (i = 0; i + 16 <= width; i += 16) {
+            GatherSaoEo16bit(inputSamplePtr + i, reconSamplePtr + i, reconStride, allLanes, &accumulator, gatherBoEo0);
+        }
+        if (width & 15) {
+            GatherSaoEo16bit(inputSamplePtr + tailStart, reconSamplePtr + tailStart, reconStride, tailValid, &accumulator, gatherBoEo0);
+        }
+
+        if (gatherBoEo0) {
+            for (i = 0; i < width; i++) {
+                boIndex = reconSamplePtr[i] >> 5;
+                boDiff[boIndex] += inputSamplePtr[i] - reconSamplePtr[i];
+                boCount[boIndex]++;
+            }
+        }
+
+        inputSamplePtr += inputStride;
+        reconSamplePtr += reconStride;
+    }
+
+    // Categories -2, -1, 1, 2 land in [0], [1], [2], [3]; [4] keeps category 2 as the C kernel does
+    for (eoType = 0; eoType < SAO_EO_TYPES; ++eoType) {
+        for (eoIndex = 0; eoIndex < SAO_EO_GATHER_CATEGORIES; ++eoIndex) {
+            eoDiff[eoType][eoIndex] = HorizontalSum32_AVX2(accumulator.diff[eoType][eoIndex]);
+            eoCount[eoType][eoIndex] = (EB_U16)HorizontalSum32_AVX2(_mm256_madd_epi16(accumulator.count[eoType][eoIndex], _mm256_set1_epi16(1)));
+        }
+        eoDiff[eoType][SAO_EO_CATEGORIES] = eoDiff[eoType][SAO_EO_CATEGORIES - 1];
+        eoCount[eoType][SAO_EO_CATEGORIES] = eoCount[eoType][SAO_EO_CATEGORIES - 1];
+    }
+}
+
+/********************************************
+* GatherSaoStatisticsLcu16bit_AVX2_INTRIN
+* collects Sao Statistics
+********************************************/
+EB_EXTERN EB_ERRORTYPE GatherSaoStatisticsLcu16bit_AVX2_INTRIN(
+    EB_U16                   *inputSamplePtr,        // input parameter, source Picture Ptr
+    EB_U32                   inputStride,           // input parameter, source stride
+    EB_U16                   *reconSamplePtr,        // input parameter, deblocked Picture Ptr
+    EB_U32                   reconStride,           // input parameter, deblocked stride
+    EB_U32                   lcuWidth,              // input parameter, LCU width
+    EB_U32                   lcuHeight,             // input parameter, LCU height
+    EB_S32                  *boDiff,                // output parameter, used to store Band Offset diff, boDiff[SAO_BO_INTERVALS]
+    EB_U16                  *boCount,               // output parameter, used to store Band Offset count, boCount[SAO_BO_INTERVALS]
+    EB_S32                   eoDiff[SAO_EO_TYPES][SAO_EO_CATEGORIES + 1],    // output parameter, used to store Edge Offset diff, eoDiff[SAO_EO_TYPES] [SAO_EO_CATEGORIES]
+    EB_U16                   eoCount[SAO_EO_TYPES][SAO_EO_CATEGORIES + 1])   // output parameter, used to store Edge Offset count, eoCount[SAO_EO_TYPES] [SAO_EO_CATEGORIES]
+{
+    if (lcuWidth < SAO_EO_GATHER_MIN_WIDTH) {
+        return GatherSaoStatisticsLcu_62x62_16bit(inputSamplePtr, inputStride, reconSamplePtr, reconStride, lcuWidth, lcuHeight, boDiff, boCount, eoDiff, eoCount);
+    }
+
+    GatherSaoStatisticsLcu16bit_AVX2(inputSamplePtr, inputStride, reconSamplePtr, reconStride, lcuWidth, lcuHeight, boDiff, boCount, eoDiff, eoCount, EB_TRUE);
+
+    return EB_ErrorNone;
+}
+
+/********************************************
+* GatherSaoStatisticsLcu_OnlyEo_90_45_135_16bit_AVX2_INTRIN
+* collects the vertical and diagonal Edge Offset statistics
+********************************************/
+EB_EXTERN EB_ERRORTYPE GatherSaoStatisticsLcu_OnlyEo_90_45_135_16bit_AVX2_INTRIN(
+    EB_U16                   *inputSamplePtr,        // input parameter, source Picture Ptr
+    EB_U32                   inputStride,           // input parameter, source stride
+    EB_U16                   *reconSamplePtr,        // input parameter, deblocked Picture Ptr
+    EB_U32                   reconStride,           // input parameter, deblocked stride
+    EB_U32                   lcuWidth,              // input parameter, LCU width
+    EB_U32                   lcuHeight,             // input parameter, LCU height
+    EB_S32                   eoDiff[SAO_EO_TYPES][SAO_EO_CATEGORIES + 1],    // output parameter, used to store Edge Offset diff, eoDiff[SAO_EO_TYPES] [SAO_EO_CATEGORIES]
+    EB_U16                   eoCount[SAO_EO_TYPES][SAO_EO_CATEGORIES + 1])   // output parameter, used to store Edge Offset count, eoCount[SAO_EO_TYPES] [SAO_EO_CATEGORIES]
+{
+    if (lcuWidth < SAO_EO_GATHER_MIN_WIDTH) {
+        return GatherSaoStatisticsLcu_62x62_OnlyEo_90_45_135_16bit(inputSamplePtr, inputStride, reconSamplePtr, reconStride, lcuWidth, lcuHeight, eoDiff, eoCount);
+    }
+
+    GatherSaoStatisticsLcu16bit_AVX2(inputSamplePtr, inputStride, reconSamplePtr, reconStride, lcuWidth, lcuHeight, EB_NULL, EB_NULL, eoDiff, eoCount, EB_FALSE);
+
+    return EB_ErrorNone;
+}
@@ -0,0 +1,174 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbDefinitions.h"
+#include "immintrin.h"
+#include "EbIntraPrediction_AVX2.h"
+
+// (x + 1) for the planar weights of columns 0 to 31
+EB_ALIGN(32) static const EB_U16 IntraPlanarColumn16bit[32] = {
+     1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 16,
+    17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32
+};
+
+/***************************************************************************************************
+* 10-bit samples keep the two tap angular filter, ((32 - f) * a + f * b + 16) >> 5, and the planar
+* sum, at most 2 * size * 1023 + size, within 16 bits, so both are computed with 16-bit multiplies.
+***************************************************************************************************/
+static FORCE_INLINE __m256i IntraAngularFilterWide16bit(
+    const EB_U16 *refPtr,
+    __m256i       fract,
+    __m256i       fractComplement)
+{
+    __m256i a = _mm256_loadu_si256((const __m256i *)refPtr);
+    __m256i b = _mm256_loadu_si256((const __m256i *)(refPtr + 1));
+    __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(a, fractComplement), _mm256_mullo_epi16(b, fract));
+    return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(16)), 5);
+}
+
+static FORCE_INLINE __m128i IntraAngularFilterNarrow16bit(
+    const EB_U16 *refPtr,
+    __m128i       fract,
+    __m128i       fractComplement,
+    EB_U32        size)
+{
+    __m128i a = (size == 4) ? _mm_loadl_epi64((const __m128i *)refPtr) : _mm_loadu_si128((const __m128i *)refPtr);
+    __m128i b = (size == 4) ? _mm_loadl_epi64((const __m128i *)(refPtr + 1)) : _mm_loadu_si128((const __m128i *)(refPtr + 1));
+    __m128i sum = _mm_add_epi16(_mm_mullo_epi16(a, fractComplement), _mm_mullo_epi16(b, fract));
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(16)), 5);
+}
+
+// Filters size samples per row, one row per deltaSum step of intraPredAngle
+static FORCE_INLINE void IntraAngularRows16bit_AVX2(
+    EB_U32        size,
+    EB_U16       *refSampMain,
+    EB_U16       *dstPtr,
+    EB_U32        dstStride,
+    EB_U32        rowCount,
+    EB_U32        rowStride,
+    EB_S32        deltaSum,
+    EB_S32        intraPredAngle)
+{
+    EB_U32 rowIndex, colIndex;
+
+    for (rowIndex = 0; rowIndex < rowCount; rowIndex += rowStride) {
+        EB_S32  deltaInt = deltaSum >> 5;
+        EB_S16  deltaFract = (EB_S16)(deltaSum & 31);
+        EB_U16 *refPtr = refSampMain + deltaInt;
+
+        if (size >= 16) {
+            __m256i fract = _mm256_set1_epi16(deltaFract);
+            __m256i fractComplement = _mm256_set1_epi16(32 - deltaFract);
+            for (colIndex = 0; colIndex < size; colIndex += 16) {
+                _mm256_storeu_si256((__m256i *)(dstPtr + colIndex), IntraAngularFilterWide16bit(refPtr + colIndex, fract, fractComplement));
+            }
+        }
+        else {
+            __m128i fract = _mm_set1_epi16(deltaFract);
+            __m128i fractComplement = _mm_set1_epi16(32 - deltaFract);
+            __m128i pred = IntraAngularFilterNarrow16bit(refPtr, fract, fractComplement, size);
+            if (size == 4) {
+                _mm_storel_epi64((__m128i *)dstPtr, pred);
+            }
+            else {
+                _mm_storeu_si128((__m128i *)dstPtr, pred);
+            }
+        }
+        dstPtr += rowStride * dstStride;
+        deltaSum += (EB_S32)rowStride * intraPredAngle;
+    }
+}
+
+/** IntraModePlanar16bit_AVX2_INTRIN()
+is used to compute the prediction for Intra planar mode
+*/
+EB_EXTERN void IntraModePlanar16bit_AVX2_INTRIN(
+    const EB_U32   size,                       //input parameter, denotes the size of the current PU
+    EB_U16         *refSamples,                 //input parameter, pointer to the reference samples
+    EB_U16         *predictionPtr,              //output parameter, pointer to the prediction
+    const EB_U32   predictionBufferStride,     //input parameter, denotes the stride for the prediction ptr
+    const EB_BOOL  skip)                       //skip half rows
+{
+    EB_U32 topOffset = (size << 1) + 1;
+    EB_U32 rowStride = skip ? 2 : 1;
+    EB_U32 shift = (size == 4) ? 3 : (size == 8) ? 4 : (size == 16) ? 5 : 6;
+    EB_U16 topRightPel = refSamples[topOffset + size];
+    EB_U16 bottomLeftPel = refSamples[size];
+    EB_U32 x, y;
+
+    // pred(x, y) = base(x) + y * step(x) + (size - 1 - x) * left(y), with
+    // base(x) = (x + 1) * topRight + (size - 1) * top(x) + bottomLeft + size
+    // step(x) = bottomLeft - top(x)
+    if (size >= 16) {
+        __m256i base[2], step[2], leftWeight[2];
+        __m128i shiftCount = _mm_cvtsi32_si128(shift);
+
+        for (x = 0; x < size; x += 16) {
+            __m256i top = _mm256_loadu_si256((__m256i *)(refSamples + topOffset + x));
+            __m256i column = _mm256_load_si256((__m256i *)(IntraPlanarColumn16bit + x));
+            step[x >> 4] = _mm256_sub_epi16(_mm256_set1_epi16(bottomLeftPel), top);
+            base[x >> 4] = _mm256_add_epi16(
+                _mm256_add_epi16(_mm256_mullo_epi16(column, _mm256_set1_epi16(topRightPel)), _mm256_mullo_epi16(top, _mm256_set1_epi16((EB_S16)(size - 1)))),
+                _mm256_set1_epi16((EB_S16)(bottomLeftPel + size)));
+            leftWeight[x >> 4] = _mm256_sub_epi16(_mm256_set1_epi16((EB_S16)size), column);
+            step[x >> 4] = _mm256_mullo_epi16(step[x >> 4], _mm256_set1_epi16((EB_S16)rowStride));
+        }
+
+        for (y = 0; y < size; y += rowStride) {
+            __m256i left = _mm256_set1_epi16(refSamples[y]);
+            for (x = 0; x < size; x += 16) {
+                __m256i pred = _mm256_add_epi16(base[x >> 4], _mm256_mullo_epi16(leftWeight[x >> 4], left));
+                _mm256_storeu_si256((__m256i *)(predictionPtr + x), _mm256_srl_epi16(pred, shiftCount));
+                base[x >> 4] = _mm256_add_epi16(base[x >> 4], step[x >> 4]);
+            }
+            predictionPtr += rowStride * predictionBufferStride;
+        }
+    }
+    else {
+        __m128i top = (size == 4) ? _mm_loadl_epi64((__m128i *)(refSamples + topOffset)) : _mm_loadu_si128((__m128i *)(refSamples + topOffset));
+        __m128i column = _mm_load_si128((__m128i *)IntraPlanarColumn16bit);
+        __m128i step = _mm_mullo_epi16(_mm_sub_epi16(_mm_set1_epi16(bottomLeftPel), top), _mm_set1_epi16((EB_S16)rowStride));
+        __m128i base = _mm_add_epi16(
+            _mm_add_epi16(_mm_mullo_epi16(column, _mm_set1_epi16(topRightPel)), _mm_mullo_epi16(top, _mm_set1_epi16((EB_S16)(size - 1)))),
+            _mm_set1_epi16((EB_S16)(bottomLeftPel + size)));
+        __m128i leftWeight = _mm_sub_epi16(_mm_set1_epi16((EB_S16)size), column);
+        __m128i shiftCount = _mm_cvtsi32_si128(shift);
+
+        for (y = 0; y < size; y += rowStride) {
+            __m128i pred = _mm_add_epi16(base, _mm_mullo_epi16(leftWeight, _mm_set1_epi16(refSamples[y])));
+            pred = _mm_srl_epi16(pred, shiftCount);
+            if (size == 4) {
+                _mm_storel_epi64((__m128i *)predictionPtr, pred);
+            }
+            else {
+                _mm_storeu_si128((__m128i *)predictionPtr, pred);
+            }
+            base = _mm_add_epi16(base, step);
+            predictionPtr += rowStride * predictionBufferStride;
+        }
+    }
+}
+
+/** IntraModeAngular16bit_Vertical_Kernel_AVX2_INTRIN()
+is used to compute the prediction for Intra angular mode 33-27 and 19-25
+*/
+EB_EXTERN void IntraModeAngular16bit_Vertical_Kernel_AVX2_INTRIN(
+    EB_U32         size,                       //input parameter, denotes the size of the current PU
+    EB_U16         *refSampMain,                //input parameter, pointer to the reference samples
+    EB_U16         *predictionPtr,              //output parameter, pointer to the prediction
+    EB_U32         predictionBufferStride,     //input parameter, denotes the stride for the prediction ptr
+    const EB_BOOL  skip,
+    EB_S32         intraPredAngle)
+{
+    IntraAngularRows16bit_AVX2(
+        size,
+        refSampMain + 1,
+        predictionPtr,
+        predictionBufferStride,
+        size,
+        skip ? 2 : 1,
+        intraPredAngle,
+        intraPredAngle);
+}
@@ -0,0 +1,412 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "EbMcp_AVX512.h"
+#include "EbMcp_SSSE3.h"
+
+#ifndef NON_AVX512_SUPPORT
+
+/*******************************************************************************
+* The horizontal filters work on 8 column wide strips, one row per 128-bit lane,
+* with the same maddubs arithmetic as the SSSE3 filters. The 4 column strip of
+* the widths that are not a multiple of 8 is left to the SSSE3 filters, which
+* also fixes the layout of the first pass buffer of the 2D filters.
+*******************************************************************************/
+
+// Coefficient pairs {0,1}, {2,3}, {4,5}, {6,7} of the 8-tap filter as signed bytes
+FORCE_INLINE static AVX512_FUNC_TARGET
+void LumaFilterCoeff_AVX512(EB_U32 fracPos, __m512i *c)
+{
+    __m128i c0;
+
+    c0 = _mm_loadu_si128((__m128i *)EbHevcLumaFilterCoeff[fracPos]);
+    c0 = _mm_packs_epi16(c0, c0);
+    c0 = _mm_unpacklo_epi16(c0, c0);
+    c[0] = _mm512_broadcast_i32x4(_mm_shuffle_epi32(c0, 0x00));
+    c[1] = _mm512_broadcast_i32x4(_mm_shuffle_epi32(c0, 0x55));
+    c[2] = _mm512_broadcast_i32x4(_mm_shuffle_epi32(c0, 0xaa));
+    c[3] = _mm512_broadcast_i32x4(_mm_shuffle_epi32(c0, 0xff));
+}
+
+// Unrounded 8-tap sums of 8 columns of up to 4 rows, lanes of the missing rows are undefined
+FORCE_INLINE static AVX512_FUNC_TARGET
+__m512i LumaFilterHorizontal4Rows_AVX512(EB_BYTE ptr, EB_U32 srcStride, EB_U32 rowCount, const __m512i *c)
+{
+    __m512i a0;
+    __m512i sum;
+
+    a0 = _mm512_castsi128_si512(_mm_loadu_si128((__m128i *)ptr));
+    if (rowCount > 1) {
+        a0 = _mm512_inserti32x4(a0, _mm_loadu_si128((__m128i *)(ptr + srcStride)), 1);
+    }
+    if (rowCount > 2) {
+        a0 = _mm512_inserti32x4(a0, _mm_loadu_si128((__m128i *)(ptr + 2 * srcStride)), 2);
+    }
+    if (rowCount > 3) {
+        a0 = _mm512_inserti32x4(a0, _mm_loadu_si128((__m128i *)(ptr + 3 * srcStride)), 3);
+    }
+
+    sum = _mm512_maddubs_epi16(_mm512_shuffle_epi8(a0, _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8))), c[0]);
+    sum = _mm512_add_epi16(sum, _mm512_maddubs_epi16(_mm512_shuffle_epi8(a0, _mm512_broadcast_i32x4(_mm_setr_epi8(2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10))), c[1]));
+    sum = _mm512_add_epi16(sum, _mm512_maddubs_epi16(_mm512_shuffle_epi8(a0, _mm512_broadcast_i32x4(_mm_setr_epi8(4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12))), c[2]));
+    sum = _mm512_add_epi16(sum, _mm512_maddubs_epi16(_mm512_shuffle_epi8(a0, _mm512_broadcast_i32x4(_mm_setr_epi8(6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14))), c[3]));
+
+    return sum;
+}
+
+AVX512_FUNC_TARGET
+void LumaInterpolationFilterOneDHorizontal_AVX512(
+    EB_BYTE               refPic,
+    EB_U32                srcStride,
+    EB_BYTE               dst,
+    EB_U32                dstStride,
+    EB_U32                puWidth,
+    EB_U32                puHeight,
+    EB_U32                fracPosx)
+{
+    EB_U32 rowIndex, colIndex, rowCount;
+    __m512i c[4];
+    __m512i sum;
+    __m128i out;
+
+    // Blocks narrower than 16 do not fill the 512-bit registers
+    if (puWidth < 16) {
+        LumaInterpolationFilterOneDHorizontal_SSSE3(refPic, srcStride, dst, dstStride, puWidth, puHeight, fracPosx);
+        return;
+    }
+    if (puWidth & 4) {
+        LumaInterpolationFilterOneDHorizontal_SSSE3(refPic, srcStride, dst, dstStride, 4, puHeight, fracPosx);
+        puWidth -= 4;
+        refPic += 4;
+        dst += 4;
+    }
+
+    LumaFilterCoeff_AVX512(fracPosx, c);
+    refPic -= 3;
+
+    for (colIndex = 0; colIndex < puWidth; colIndex += 8) {
+        for (rowIndex = 0; rowIndex < puHeight; rowIndex += 4) {
+            EB_BYTE qtr = dst + rowIndex * dstStride + colIndex;
+
+            rowCount = puHeight - rowIndex < 4 ? puHeight - rowIndex : 4;
+            sum = LumaFilterHorizontal4Rows_AVX512(refPic + rowIndex * srcStride + colIndex, srcStride, rowCount, c);
+            sum = _mm512_srai_epi16(_mm512_add_epi16(sum, _mm512_set1_epi16(32)), 6);
+            sum = _mm512_packus_epi16(sum, sum);
+
+            _mm_storel_epi64((__m128i *)qtr, _mm512_castsi512_si128(sum));
+            if (rowCount > 1) {
+                out = _mm512_extracti32x4_epi32(sum, 1);
+                _mm_storel_epi64((__m128i *)(qtr + dstStride), out);
+            }
+            if (rowCount > 2) {
+                out = _mm512_extracti32x4_epi32(sum, 2);
+                _mm_storel_epi64((__m128i *)(qtr + 2 * dstStride), out);
+            }
+            if (rowCount > 3) {
+                out = _mm512_extracti32x4_epi32(sum, 3);
+                _mm_storel_epi64((__m128i *)(qtr + 3 * dstStride), out);
+            }
+        }
+    }
+}
+
+// Same output layout as LumaInterpolationFilterOneDOutRawHorizontal_SSSE3: the strips follow each other, 8 samples per row
+AVX512_FUNC_TARGET
+void LumaInterpolationFilterOneDOutRawHorizontal_AVX512(
+    EB_BYTE               refPic,
+    EB_U32                srcStride,
+    EB_S16               *dst,
+    EB_U32                puWidth,
+    EB_U32                puHeight,
+    EB_U32                fracPosx)
+{
+    EB_U32 rowIndex, colIndex, rowCount;
+    __m512i c[4];
+    __m512i sum;
+
+    if (puWidth < 16) {
+        LumaInterpolationFilterOneDOutRawHorizontal_SSSE3(refPic, srcStride, dst, puWidth, puHeight, fracPosx);
+        return;
+    }
+    if (puWidth & 4) {
+        // The SSSE3 strip covers the rows in pairs
+        LumaInterpolationFilterOneDOutRawHorizontal_SSSE3(refPic, srcStride, dst, 4, puHeight, fracPosx);
+        puWidth -= 4;
+        refPic += 4;
+        dst += ((puHeight + 1) & ~1) * 4;
+    }
+
+    LumaFilterCoeff_AVX512(fracPosx, c);
+    refPic -= 3;
+
+    for (colIndex = 0; colIndex < puWidth; colIndex += 8) {
+        for (rowIndex = 0; rowIndex < puHeight; rowIndex += 4) {
+            rowCount = puHeight - rowIndex < 4 ? puHeight - rowIndex : 4;
+            sum = LumaFilterHorizontal4Rows_AVX512(refPic + rowIndex * srcStride + colIndex, srcStride, rowCount, c);
+            sum = _mm512_sub_epi16(sum, _mm512_set1_epi16(128 * 64));
+
+            if (rowCount == 4) {
+                _mm512_storeu_si512((__m512i *)dst, sum);
+            }
+            else {
+                _mm512_mask_storeu_epi16(dst, (__mmask32)((1u << (rowCount * 8)) - 1), sum);
+            }
+            dst += rowCount * 8;
+        }
+    }
+}
+
+/*******************************************************************************
+* The vertical filter covers up to 64 columns per row, the rows are read with
+* masked loads so that no sample right of the block is touched. Interleaving
+* two rows per 128-bit lane keeps the columns in order through packus.
+*******************************************************************************/
+AVX512_FUNC_TARGET
+void LumaInterpolationFilterOneDVertical_AVX512(
+    EB_BYTE               refPic,
+    EB_U32                srcStride,
+    EB_BYTE               dst,
+    EB_U32                dstStride,
+    EB_U32                puWidth,
+    EB_U32                puHeight,
+    EB_U32                fracPosx)
+{
+    EB_U32 rowIndex, colIndex;
+    __m512i c[4];
+    __m512i a0, a1, a2, a3, a4, a5, a6, a7, a8;
+    __m512i lo[8], hi[8];
+    __m512i sumLo, sumHi;
+    __mmask64 mask;
+
+    if (puWidth < 16) {
+        LumaInterpolationFilterOneDVertical_SSSE3(refPic, srcStride, dst, dstStride, puWidth, puHeight, fracPosx);
+        return;
+    }
+
+    LumaFilterCoeff_AVX512(fracPosx, c);
+    refPic -= 3 * srcStride;
+
+    for (colIndex = 0; colIndex < puWidth; colIndex += 64) {
+        EB_BYTE ptr = refPic + colIndex;
+        EB_BYTE qtr = dst + colIndex;
+
+        mask = (puWidth - colIndex >= 64) ? ~(__mmask64)0 : (((__mmask64)1 << (puWidth - colIndex)) - 1);
+
+        a0 = _mm512_maskz_loadu_epi8(mask, ptr); ptr += srcStride;
+        a1 = _mm512_maskz_loadu_epi8(mask, ptr); ptr += srcStride;
+        a2 = _mm512_maskz_loadu_epi8(mask, ptr); ptr += srcStride;
+        a3 = _mm512_maskz_loadu_epi8(mask, ptr); ptr += srcStride;
+        a4 = _mm512_maskz_loadu_epi8(mask, ptr); ptr += srcStride;
+        a5 = _mm512_maskz_loadu_epi8(mask, ptr); ptr += srcStride;
+        a6 = _mm512_maskz_loadu_epi8(mask, ptr); ptr += srcStride;
+
+        lo[0] = _mm512_unpacklo_epi8(a0, a1); hi[0] = _mm512_unpackhi_epi8(a0, a1);
+        lo[1] = _mm512_unpacklo_epi8(a1, a2); hi[1] = _mm512_unpackhi_epi8(a1, a2);
+        lo[2] = _mm512_unpacklo_epi8(a2, a3); hi[2] = _mm512_unpackhi_epi8(a2, a3);
+        lo[3] = _mm512_unpacklo_epi8(a3, a4); hi[3] = _mm512_unpackhi_epi8(a3, a4);
+        lo[4] = _mm512_unpacklo_epi8(a4, a5); hi[4] = _mm512_unpackhi_epi8(a4, a5);
+        lo[5] = _mm512_unpacklo_epi8(a5, a6); hi[5] = _mm512_unpackhi_epi8(a5, a6);
+
+        for (rowIndex = 0; rowIndex < puHeight; rowIndex += 2) {
+            a7 = _mm512_maskz_loadu_epi8(mask, ptr); ptr += srcStride;
+            a8 = _mm512_maskz_loadu_epi8(mask, ptr); ptr += srcStride;
+            lo[6] = _mm512_unpacklo_epi8(a6, a7); hi[6] = _mm512_unpackhi_epi8(a6, a7);
+            lo[7] = _mm512_unpacklo_epi8(a7, a8); hi[7] = _mm512_unpackhi_epi8(a7, a8);
+
+            sumLo = _mm512_add_epi16(_mm512_maddubs_epi16(lo[0], c[0]), _mm512_maddubs_epi16(lo[2], c[1]));
+            sumLo = _mm512_add_epi16(sumLo, _mm512_add_epi16(_mm512_maddubs_epi16(lo[4], c[2]), _mm512_maddubs_epi16(lo[6], c[3])));
+            sumHi = _mm512_add_epi16(_mm512_maddubs_epi16(hi[0], c[0]), _mm512_maddubs_epi16(hi[2], c[1]));
+            sumHi = _mm512_add_epi16(sumHi, _mm512_add_epi16(_mm512_maddubs_epi16(hi[4], c[2]), _mm512_maddubs_epi16(hi[6], c[3])));
+            sumLo = _mm512_srai_epi16(_mm512_add_epi16(sumLo, _mm512_set1_epi16(32)), 6);
+            sumHi = _mm512_srai_epi16(_mm512_add_epi16(sumHi, _mm512_set1_epi16(32)), 6);
+            _mm512_mask_storeu_epi8(qtr, mask, _mm512_packus_epi16(sumLo, sumHi)); qtr += dstStride;
+
+            sumLo = _mm512_add_epi16(_mm512_maddubs_epi16(lo[1], c[0]), _mm512_maddubs_epi16(lo[3], c[1]));
+            sumLo = _mm512_add_epi16(sumLo, _mm512_add_epi16(_mm512_maddubs_epi16(lo[5], c[2]), _mm512_maddubs_epi16(lo[7], c[3])));
+            sumHi = _mm512_add_epi16(_mm512_maddubs_epi16(hi[1], c[0]), _mm512_maddubs_epi16(hi[3], c[1]));
+            sumHi = _mm512_add_epi16(sumHi, _mm512_add_epi16(_mm512_maddubs_epi16(hi[5], c[2]), _mm512_maddubs_epi16(hi[7], c[3])));
+            sumLo = _mm512_srai_epi16(_mm512_add_epi16(sumLo, _mm512_set1_epi16(32)), 6);
+            sumHi = _mm512_srai_epi16(_mm512_add_epi16(sumHi, _mm512_set1_epi16(32)), 6);
+            _mm512_mask_storeu_epi8(qtr, mask, _mm512_packus_epi16(sumLo, sumHi)); qtr += dstStride;
+
+            lo[0] = lo[2]; hi[0] = hi[2];
+            lo[1] = lo[3]; hi[1] = hi[3];
+            lo[2] = lo[4]; hi[2] = hi[4];
+            lo[3] = lo[5]; hi[3] = hi[5];
+            lo[4] = lo[6]; hi[4] = hi[6];
+            lo[5] = lo[7]; hi[5] = hi[7];
+            a6 = a8;
+        }
+    }
+}
+
+/*******************************************************************************
+* Interpolation positions, the second pass of the 2D positions stays on SSSE3
+*******************************************************************************/
+void LumaInterpolationFilterPosa_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    (void)firstPassIFDst;
+    LumaInterpolationFilterOneDHorizontal_AVX512(refPic, srcStride, dst, dstStride, puWidth, puHeight, 1);
+}
+
+void LumaInterpolationFilterPosb_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    (void)firstPassIFDst;
+    LumaInterpolationFilterOneDHorizontal_AVX512(refPic, srcStride, dst, dstStride, puWidth, puHeight, 2);
+}
+
+void LumaInterpolationFilterPosc_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    (void)firstPassIFDst;
+    LumaInterpolationFilterOneDHorizontal_AVX512(refPic, srcStride, dst, dstStride, puWidth, puHeight, 3);
+}
+
+void LumaInterpolationFilterPosd_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    (void)firstPassIFDst;
+    LumaInterpolationFilterOneDVertical_AVX512(refPic, srcStride, dst, dstStride, puWidth, puHeight, 1);
+}
+
+void LumaInterpolationFilterPosh_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    (void)firstPassIFDst;
+    LumaInterpolationFilterOneDVertical_AVX512(refPic, srcStride, dst, dstStride, puWidth, puHeight, 2);
+}
+
+void LumaInterpolationFilterPosn_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    (void)firstPassIFDst;
+    LumaInterpolationFilterOneDVertical_AVX512(refPic, srcStride, dst, dstStride, puWidth, puHeight, 3);
+}
+
+void LumaInterpolationFilterPose_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 1);
+    EbHevcLumaInterpolationFilterTwoDInRaw7_SSSE3(firstPassIFDst, dst, dstStride, puWidth, puHeight, 1);
+}
+
+void LumaInterpolationFilterPosf_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 2);
+    EbHevcLumaInterpolationFilterTwoDInRaw7_SSSE3(firstPassIFDst, dst, dstStride, puWidth, puHeight, 1);
+}
+
+void LumaInterpolationFilterPosg_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 3);
+    EbHevcLumaInterpolationFilterTwoDInRaw7_SSSE3(firstPassIFDst, dst, dstStride, puWidth, puHeight, 1);
+}
+
+void LumaInterpolationFilterPosi_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 7, 1);
+    EbHevcLumaInterpolationFilterTwoDInRawM_SSSE3(firstPassIFDst, dst, dstStride, puWidth, puHeight);
+}
+
+void LumaInterpolationFilterPosj_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 7, 2);
+    EbHevcLumaInterpolationFilterTwoDInRawM_SSSE3(firstPassIFDst, dst, dstStride, puWidth, puHeight);
+}
+
+void LumaInterpolationFilterPosk_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 7, 3);
+    EbHevcLumaInterpolationFilterTwoDInRawM_SSSE3(firstPassIFDst, dst, dstStride, puWidth, puHeight);
+}
+
+void LumaInterpolationFilterPosp_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 2 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 1);
+    EbHevcLumaInterpolationFilterTwoDInRaw7_SSSE3(firstPassIFDst, dst, dstStride, puWidth, puHeight, 3);
+}
+
+void LumaInterpolationFilterPosq_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 2 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 2);
+    EbHevcLumaInterpolationFilterTwoDInRaw7_SSSE3(firstPassIFDst, dst, dstStride, puWidth, puHeight, 3);
+}
+
+void LumaInterpolationFilterPosr_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 2 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 3);
+    EbHevcLumaInterpolationFilterTwoDInRaw7_SSSE3(firstPassIFDst, dst, dstStride, puWidth, puHeight, 3);
+}
+
+void LumaInterpolationFilterPosaOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    (void)firstPassIFDst;
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic, srcStride, dst, puWidth, puHeight, 1);
+}
+
+void LumaInterpolationFilterPosbOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    (void)firstPassIFDst;
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic, srcStride, dst, puWidth, puHeight, 2);
+}
+
+void LumaInterpolationFilterPoscOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    (void)firstPassIFDst;
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic, srcStride, dst, puWidth, puHeight, 3);
+}
+
+void LumaInterpolationFilterPoseOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 1);
+    EbHevcLumaInterpolationFilterTwoDInRawOutRaw7_SSSE3(firstPassIFDst, dst, puWidth, puHeight, 1);
+}
+
+void LumaInterpolationFilterPosfOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 2);
+    EbHevcLumaInterpolationFilterTwoDInRawOutRaw7_SSSE3(firstPassIFDst, dst, puWidth, puHeight, 1);
+}
+
+void LumaInterpolationFilterPosgOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 3);
+    EbHevcLumaInterpolationFilterTwoDInRawOutRaw7_SSSE3(firstPassIFDst, dst, puWidth, puHeight, 1);
+}
+
+void LumaInterpolationFilterPosiOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 7, 1);
+    EbHevcLumaInterpolationFilterTwoDInRawOutRawM_SSSE3(firstPassIFDst, dst, puWidth, puHeight);
+}
+
+void LumaInterpolationFilterPosjOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 7, 2);
+    EbHevcLumaInterpolationFilterTwoDInRawOutRawM_SSSE3(firstPassIFDst, dst, puWidth, puHeight);
+}
+
+void LumaInterpolationFilterPoskOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 3 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 7, 3);
+    EbHevcLumaInterpolationFilterTwoDInRawOutRawM_SSSE3(firstPassIFDst, dst, puWidth, puHeight);
+}
+
+void LumaInterpolationFilterPospOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 2 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 1);
+    EbHevcLumaInterpolationFilterTwoDInRawOutRaw7_SSSE3(firstPassIFDst, dst, puWidth, puHeight, 3);
+}
+
+void LumaInterpolationFilterPosqOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 2 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 2);
+    EbHevcLumaInterpolationFilterTwoDInRawOutRaw7_SSSE3(firstPassIFDst, dst, puWidth, puHeight, 3);
+}
+
+void LumaInterpolationFilterPosrOutRaw_AVX512(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst)
+{
+    LumaInterpolationFilterOneDOutRawHorizontal_AVX512(refPic - 2 * srcStride, srcStride, firstPassIFDst, puWidth, puHeight + 6, 3);
+    EbHevcLumaInterpolationFilterTwoDInRawOutRaw7_SSSE3(firstPassIFDst, dst, puWidth, puHeight, 3);
+}
+
+#endif
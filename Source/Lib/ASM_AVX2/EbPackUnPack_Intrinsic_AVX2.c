@@ -35,8 +35,19 @@ void EB_ENC_msbUnPack2D_AVX512_INTRIN(
     for (x = 0; x < height; x++) {
             // Find offset to the aligned store address
             EB_U32 offset = (CHUNK_SIZE - (size_t)out8BitBuffer) & (CHUNK_SIZE - 1);
-            EB_U32 complOffset = (width - offset) & (CHUNK_SIZE - 1);
-            EB_U32 numChunks = (width - (offset + complOffset)) / CHUNK_SIZE;
+            EB_U32 complOffset;
+            EB_U32 numChunks;
+
+            // Rows that end before the first aligned chunk go through the AVX2 kernel
+            if (width < offset + CHUNK_SIZE) {
+                EB_ENC_msbUnPack2D_AVX2_INTRIN(in16BitBuffer, inStride, out8BitBuffer, outnBitBuffer, out8Stride, outnStride, width, 1);
+                in16BitBuffer += inStride;
+                outnBitBuffer += outnStride;
+                out8BitBuffer += out8Stride;
+                continue;
+            }
+            complOffset = (width - offset) & (CHUNK_SIZE - 1);
+            numChunks = (width - (offset + complOffset)) / CHUNK_SIZE;
 
             // Process the unaligned output data pixel by pixel
             for (y = 0; y < offset; y++)
@@ -90,7 +101,7 @@ void EB_ENC_msbUnPack2D_AVX512_INTRIN(
 
     return;
 }
-#else
+#endif
 void EB_ENC_msbUnPack2D_AVX2_INTRIN(
     EB_U16      *in16BitBuffer,
     EB_U32       inStride,
@@ -111,8 +122,11 @@ void EB_ENC_msbUnPack2D_AVX2_INTRIN(
     const int b_use_nt_store_for_both = (out8BitBufferAlign == outnBitBufferAlign) && (out8Stride == outnStride);
 
     for (x = 0; x < height; x++) {
-        // Find offset to the aligned store address
-        const EB_U32 offset = (CHUNK_SIZE - (size_t)out8BitBuffer) & (CHUNK_SIZE - 1);
+        // Find offset to the aligned store address. Rows that end before the
+        // first aligned chunk are stored unaligned from their start
+        const EB_U32 alignOffset = (CHUNK_SIZE - (size_t)out8BitBuffer) & (CHUNK_SIZE - 1);
+        const int b_aligned = width >= alignOffset + CHUNK_SIZE;
+        const EB_U32 offset = b_aligned ? alignOffset : 0;
         const EB_U32 complOffset = (width - offset) & (CHUNK_SIZE - 1);
         const EB_U32 numChunks = (width - offset - complOffset) / CHUNK_SIZE;
 
@@ -139,8 +153,11 @@ void EB_ENC_msbUnPack2D_AVX2_INTRIN(
             outn0_U8 = _mm256_permute4x64_epi64(outn0_U8, 0xD8);
             out8_0_U8 = _mm256_permute4x64_epi64(out8_0_U8, 0xD8);
 
-            _mm256_stream_si256((__m256i*)out8BitBuffer, out8_0_U8);
-            if (b_use_nt_store_for_both)
+            if (b_aligned)
+                _mm256_stream_si256((__m256i*)out8BitBuffer, out8_0_U8);
+            else
+                _mm256_storeu_si256((__m256i*)out8BitBuffer, out8_0_U8);
+            if (b_aligned && b_use_nt_store_for_both)
                 _mm256_stream_si256((__m256i*)outnBitBuffer, outn0_U8);
             else
                 _mm256_storeu_si256((__m256i*)outnBitBuffer, outn0_U8);
@@ -166,5 +183,4 @@ void EB_ENC_msbUnPack2D_AVX2_INTRIN(
 
     return;
 }
-#endif
 
@@ -22,7 +22,7 @@ extern "C" {
 	EB_U32       outnStride,
 	EB_U32       width,
 	EB_U32       height);
-#else
+#endif
     void EB_ENC_msbUnPack2D_AVX2_INTRIN(
     EB_U16      *in16BitBuffer,
     EB_U32       inStride,
@@ -32,7 +32,6 @@ extern "C" {
     EB_U32       outnStride,
     EB_U32       width,
     EB_U32       height);
-#endif
 
 
 #ifdef __cplusplus
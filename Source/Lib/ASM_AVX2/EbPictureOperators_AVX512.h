@@ -0,0 +1,24 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EBPICTUREOPERATORS_AVX512_H
+#define EBPICTUREOPERATORS_AVX512_H
+
+#include "EbDefinitions.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NON_AVX512_SUPPORT
+// Full distortion of 32 column wide strips, the area width must be a multiple of 32
+void FullDistortionKernel32MxN_32bit_AVX512(EB_S16 *coeff, EB_U32 coeffStride, EB_S16 *reconCoeff, EB_U32 reconCoeffStride, EB_U64 distortionResult[2], EB_U32 areaWidth, EB_U32 areaHeight);
+void FullDistortionKernelIntra32MxN_32bit_AVX512(EB_S16 *coeff, EB_U32 coeffStride, EB_S16 *reconCoeff, EB_U32 reconCoeffStride, EB_U64 distortionResult[2], EB_U32 areaWidth, EB_U32 areaHeight);
+void FullDistortionKernelCbfZero32MxN_32bit_AVX512(EB_S16 *coeff, EB_U32 coeffStride, EB_S16 *reconCoeff, EB_U32 reconCoeffStride, EB_U64 distortionResult[2], EB_U32 areaWidth, EB_U32 areaHeight);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EBPICTUREOPERATORS_AVX512_H
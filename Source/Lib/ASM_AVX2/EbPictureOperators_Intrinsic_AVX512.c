@@ -0,0 +1,126 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "EbPictureOperators_AVX512.h"
+
+#ifndef NON_AVX512_SUPPORT
+
+/*******************************************************************************
+* The full distortion kernels have the arithmetic of the SSE2 16MxN kernels:
+* 16 bit differences, squared and summed in 32 bit lanes, on one 32 sample row
+* of a 32 column strip per iteration.
+*******************************************************************************/
+
+// Sum of the 16 32-bit lanes, zero extended
+FORCE_INLINE static AVX512_FUNC_TARGET
+EB_U64 FullDistortionSum_AVX512(__m512i sum)
+{
+    __m256i x0 = _mm256_add_epi32(_mm512_castsi512_si256(sum), _mm512_extracti64x4_epi64(sum, 1));
+    __m128i x1 = _mm_add_epi32(_mm256_castsi256_si128(x0), _mm256_extracti128_si256(x0, 1));
+
+    x1 = _mm_add_epi32(x1, _mm_shuffle_epi32(x1, 0x4e)); // 01001110
+    x1 = _mm_add_epi32(x1, _mm_shuffle_epi32(x1, 0xb1)); // 10110001
+
+    return (EB_U32)_mm_cvtsi128_si32(x1);
+}
+
+AVX512_FUNC_TARGET
+void FullDistortionKernel32MxN_32bit_AVX512(
+    EB_S16  *coeff,
+    EB_U32   coeffStride,
+    EB_S16  *reconCoeff,
+    EB_U32   reconCoeffStride,
+    EB_U64   distortionResult[2],
+    EB_U32   areaWidth,
+    EB_U32   areaHeight)
+{
+    EB_U32 rowCount, colCount;
+    __m512i sum = _mm512_setzero_si512();
+    __m512i sum2 = _mm512_setzero_si512();
+
+    for (colCount = 0; colCount < areaWidth; colCount += 32) {
+        EB_S16 *coeffTemp = coeff + colCount;
+        EB_S16 *reconCoeffTemp = reconCoeff + colCount;
+
+        for (rowCount = 0; rowCount < areaHeight; ++rowCount) {
+            __m512i x0 = _mm512_loadu_si512((const __m512i *)coeffTemp);
+            __m512i y0 = _mm512_loadu_si512((const __m512i *)reconCoeffTemp);
+
+            sum2 = _mm512_add_epi32(sum2, _mm512_madd_epi16(x0, x0));
+            x0 = _mm512_sub_epi16(x0, y0);
+            sum = _mm512_add_epi32(sum, _mm512_madd_epi16(x0, x0));
+
+            coeffTemp += coeffStride;
+            reconCoeffTemp += reconCoeffStride;
+        }
+    }
+
+    distortionResult[0] = FullDistortionSum_AVX512(sum);
+    distortionResult[1] = FullDistortionSum_AVX512(sum2);
+}
+
+AVX512_FUNC_TARGET
+void FullDistortionKernelIntra32MxN_32bit_AVX512(
+    EB_S16  *coeff,
+    EB_U32   coeffStride,
+    EB_S16  *reconCoeff,
+    EB_U32   reconCoeffStride,
+    EB_U64   distortionResult[2],
+    EB_U32   areaWidth,
+    EB_U32   areaHeight)
+{
+    EB_U32 rowCount, colCount;
+    __m512i sum = _mm512_setzero_si512();
+
+    for (colCount = 0; colCount < areaWidth; colCount += 32) {
+        EB_S16 *coeffTemp = coeff + colCount;
+        EB_S16 *reconCoeffTemp = reconCoeff + colCount;
+
+        for (rowCount = 0; rowCount < areaHeight; ++rowCount) {
+            __m512i x0 = _mm512_sub_epi16(_mm512_loadu_si512((const __m512i *)coeffTemp), _mm512_loadu_si512((const __m512i *)reconCoeffTemp));
+
+            sum = _mm512_add_epi32(sum, _mm512_madd_epi16(x0, x0));
+
+            coeffTemp += coeffStride;
+            reconCoeffTemp += reconCoeffStride;
+        }
+    }
+
+    distortionResult[0] = distortionResult[1] = FullDistortionSum_AVX512(sum);
+}
+
+AVX512_FUNC_TARGET
+void FullDistortionKernelCbfZero32MxN_32bit_AVX512(
+    EB_S16  *coeff,
+    EB_U32   coeffStride,
+    EB_S16  *reconCoeff,
+    EB_U32   reconCoeffStride,
+    EB_U64   distortionResult[2],
+    EB_U32   areaWidth,
+    EB_U32   areaHeight)
+{
+    EB_U32 rowCount, colCount;
+    __m512i sum2 = _mm512_setzero_si512();
+
+    for (colCount = 0; colCount < areaWidth; colCount += 32) {
+        EB_S16 *coeffTemp = coeff + colCount;
+
+        for (rowCount = 0; rowCount < areaHeight; ++rowCount) {
+            __m512i x0 = _mm512_loadu_si512((const __m512i *)coeffTemp);
+
+            sum2 = _mm512_add_epi32(sum2, _mm512_madd_epi16(x0, x0));
+
+            coeffTemp += coeffStride;
+        }
+    }
+
+    distortionResult[0] = distortionResult[1] = FullDistortionSum_AVX512(sum2);
+    (void)reconCoeff;
+    (void)reconCoeffStride;
+}
+
+#endif
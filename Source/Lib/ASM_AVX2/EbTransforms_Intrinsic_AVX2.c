@@ -745,6 +745,215 @@ void EbHevcTransform32_AVX2_INTRIN(EB_S16 *src, EB_U32 src_stride, EB_S16 *dst,
     }
 }
 
+#ifndef NON_AVX512_SUPPORT
+// Four 8-sample segments at the same offset of four consecutive rows, one per 128-bit lane
+FORCE_INLINE static AVX512_FUNC_TARGET
+__m512i Load4Rows_AVX512(const EB_S16 *src, EB_U32 src_stride)
+{
+    __m256i lo = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)src)), _mm_loadu_si128((const __m128i *)(src + src_stride)), 0x1);
+    __m256i hi = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(src + 2 * src_stride))), _mm_loadu_si128((const __m128i *)(src + 3 * src_stride)), 0x1);
+
+    return _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 0x1);
+}
+
+// Partial products of 8 input pairs against coeff[0], coeff[step], coeff[2*step] and coeff[3*step]
+FORCE_INLINE static AVX512_FUNC_TARGET
+__m512i Transform32Madd_AVX512(__m512i x, const __m256i *coeff, EB_U32 step)
+{
+    __m512i a;
+
+    a = _mm512_madd_epi16(_mm512_shuffle_epi32(x, (_MM_PERM_ENUM)0x00), _mm512_broadcast_i64x4(coeff[0]));
+    a = _mm512_add_epi32(a, _mm512_madd_epi16(_mm512_shuffle_epi32(x, (_MM_PERM_ENUM)0x55), _mm512_broadcast_i64x4(coeff[step])));
+    a = _mm512_add_epi32(a, _mm512_madd_epi16(_mm512_shuffle_epi32(x, (_MM_PERM_ENUM)0xaa), _mm512_broadcast_i64x4(coeff[2 * step])));
+    a = _mm512_add_epi32(a, _mm512_madd_epi16(_mm512_shuffle_epi32(x, (_MM_PERM_ENUM)0xff), _mm512_broadcast_i64x4(coeff[3 * step])));
+
+    return a;
+}
+
+// 32-point forward transform (32 rows), same arithmetic as EbHevcTransform32_AVX2_INTRIN on four rows at a time
+AVX512_FUNC_TARGET
+void EbHevcTransform32_AVX512_INTRIN(EB_S16 *src, EB_U32 src_stride, EB_S16 *dst, EB_U32 dst_stride, EB_U32 shift)
+{
+    EB_U32 i;
+    __m128i s0;
+    __m512i o0;
+    __m512i reverse;
+    const __m256i *coeff32 = (const __m256i *)EbHevcCoeff_tbl_AVX2;
+
+    s0 = _mm_cvtsi32_si128(shift);
+    o0 = _mm512_set1_epi32(1 << (shift - 1));
+    reverse = _mm512_broadcast_i32x4(_mm_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1));
+
+    for (i = 0; i < 8; i++)
+    {
+        __m512i x0, x1, x2, x3;
+        __m512i y0, y1, y2, y3;
+        __m512i a0, a1, a2, a3, a4, a5, a6, a7;
+
+        x0 = Load4Rows_AVX512(src + 0x00, src_stride);
+        x1 = Load4Rows_AVX512(src + 0x08, src_stride);
+        x2 = Load4Rows_AVX512(src + 0x10, src_stride);
+        x3 = Load4Rows_AVX512(src + 0x18, src_stride);
+
+        // 32-point butterfly
+        x2 = _mm512_shuffle_epi8(x2, reverse);
+        x3 = _mm512_shuffle_epi8(x3, reverse);
+
+        y0 = _mm512_add_epi16(x0, x3);
+        y1 = _mm512_add_epi16(x1, x2);
+
+        y2 = _mm512_sub_epi16(x0, x3);
+        y3 = _mm512_sub_epi16(x1, x2);
+
+        // 16-point butterfly
+        y1 = _mm512_shuffle_epi8(y1, reverse);
+
+        x0 = _mm512_add_epi16(y0, y1);
+        x1 = _mm512_sub_epi16(y0, y1);
+
+        a0 = Transform32Madd_AVX512(x0, coeff32 + 0, 2);
+        a1 = Transform32Madd_AVX512(x0, coeff32 + 1, 2);
+        a2 = Transform32Madd_AVX512(x1, coeff32 + 8, 2);
+        a3 = Transform32Madd_AVX512(x1, coeff32 + 9, 2);
+        a4 = _mm512_add_epi32(Transform32Madd_AVX512(y2, coeff32 + 16, 4), Transform32Madd_AVX512(y3, coeff32 + 32, 4));
+        a5 = _mm512_add_epi32(Transform32Madd_AVX512(y2, coeff32 + 17, 4), Transform32Madd_AVX512(y3, coeff32 + 33, 4));
+        a6 = _mm512_add_epi32(Transform32Madd_AVX512(y2, coeff32 + 18, 4), Transform32Madd_AVX512(y3, coeff32 + 34, 4));
+        a7 = _mm512_add_epi32(Transform32Madd_AVX512(y2, coeff32 + 19, 4), Transform32Madd_AVX512(y3, coeff32 + 35, 4));
+
+        a0 = _mm512_sra_epi32(_mm512_add_epi32(a0, o0), s0);
+        a1 = _mm512_sra_epi32(_mm512_add_epi32(a1, o0), s0);
+        a2 = _mm512_sra_epi32(_mm512_add_epi32(a2, o0), s0);
+        a3 = _mm512_sra_epi32(_mm512_add_epi32(a3, o0), s0);
+        a4 = _mm512_sra_epi32(_mm512_add_epi32(a4, o0), s0);
+        a5 = _mm512_sra_epi32(_mm512_add_epi32(a5, o0), s0);
+        a6 = _mm512_sra_epi32(_mm512_add_epi32(a6, o0), s0);
+        a7 = _mm512_sra_epi32(_mm512_add_epi32(a7, o0), s0);
+
+        x0 = _mm512_packs_epi32(a0, a1);
+        x1 = _mm512_packs_epi32(a2, a3);
+        x2 = _mm512_packs_epi32(a4, a5);
+        x3 = _mm512_packs_epi32(a6, a7);
+
+        y0 = _mm512_unpacklo_epi16(x0, x1);
+        y1 = _mm512_unpackhi_epi16(x0, x1);
+        x0 = _mm512_unpacklo_epi16(y0, x2);
+        x1 = _mm512_unpackhi_epi16(y0, x2);
+        x2 = _mm512_unpacklo_epi16(y1, x3);
+        x3 = _mm512_unpackhi_epi16(y1, x3);
+
+        // Lane n of x0..x3 holds coefficients 0-7, 8-15, 16-23 and 24-31 of row n
+        y0 = _mm512_shuffle_i32x4(x0, x1, 0x44);
+        y1 = _mm512_shuffle_i32x4(x2, x3, 0x44);
+        y2 = _mm512_shuffle_i32x4(x0, x1, 0xee);
+        y3 = _mm512_shuffle_i32x4(x2, x3, 0xee);
+
+        _mm512_storeu_si512((__m512i *)(dst + 0 * dst_stride), _mm512_shuffle_i32x4(y0, y1, 0x88));
+        _mm512_storeu_si512((__m512i *)(dst + 1 * dst_stride), _mm512_shuffle_i32x4(y0, y1, 0xdd));
+        _mm512_storeu_si512((__m512i *)(dst + 2 * dst_stride), _mm512_shuffle_i32x4(y2, y3, 0x88));
+        _mm512_storeu_si512((__m512i *)(dst + 3 * dst_stride), _mm512_shuffle_i32x4(y2, y3, 0xdd));
+
+        src += 4 * src_stride;
+        dst += 4 * dst_stride;
+    }
+}
+
+// Coefficient pairs of the 32-point inverse transform. Row n holds, for the outputs n
+// and 31 - n, the even pairs { T[4p][n], T[4p+2][n] } then the odd pairs { T[4p+1][n], T[4p+3][n] }
+#define INV32_PAIR(a, b) ((EB_S32)(((EB_U32)(b) << 16) | ((EB_U32)(a) & 0xffff)))
+
+static const EB_S32 EbHevcInvCoeff32_AVX512[16][16] =
+{
+    { INV32_PAIR(64, 90), INV32_PAIR(89, 87), INV32_PAIR(83, 80), INV32_PAIR(75, 70), INV32_PAIR(64, 57), INV32_PAIR(50, 43), INV32_PAIR(36, 25), INV32_PAIR(18, 9),
+      INV32_PAIR(90, 90), INV32_PAIR(88, 85), INV32_PAIR(82, 78), INV32_PAIR(73, 67), INV32_PAIR(61, 54), INV32_PAIR(46, 38), INV32_PAIR(31, 22), INV32_PAIR(13, 4) },
+    { INV32_PAIR(64, 87), INV32_PAIR(75, 57), INV32_PAIR(36, 9), INV32_PAIR(-18, -43), INV32_PAIR(-64, -80), INV32_PAIR(-89, -90), INV32_PAIR(-83, -70), INV32_PAIR(-50, -25),
+      INV32_PAIR(90, 82), INV32_PAIR(67, 46), INV32_PAIR(22, -4), INV32_PAIR(-31, -54), INV32_PAIR(-73, -85), INV32_PAIR(-90, -88), INV32_PAIR(-78, -61), INV32_PAIR(-38, -13) },
+    { INV32_PAIR(64, 80), INV32_PAIR(50, 9), INV32_PAIR(-36, -70), INV32_PAIR(-89, -87), INV32_PAIR(-64, -25), INV32_PAIR(18, 57), INV32_PAIR(83, 90), INV32_PAIR(75, 43),
+      INV32_PAIR(88, 67), INV32_PAIR(31, -13), INV32_PAIR(-54, -82), INV32_PAIR(-90, -78), INV32_PAIR(-46, -4), INV32_PAIR(38, 73), INV32_PAIR(90, 85), INV32_PAIR(61, 22) },
+    { INV32_PAIR(64, 70), INV32_PAIR(18, -43), INV32_PAIR(-83, -87), INV32_PAIR(-50, 9), INV32_PAIR(64, 90), INV32_PAIR(75, 25), INV32_PAIR(-36, -80), INV32_PAIR(-89, -57),
+      INV32_PAIR(85, 46), INV32_PAIR(-13, -67), INV32_PAIR(-90, -73), INV32_PAIR(-22, 38), INV32_PAIR(82, 88), INV32_PAIR(54, -4), INV32_PAIR(-61, -90), INV32_PAIR(-78, -31) },
+    { INV32_PAIR(64, 57), INV32_PAIR(-18, -80), INV32_PAIR(-83, -25), INV32_PAIR(50, 90), INV32_PAIR(64, -9), INV32_PAIR(-75, -87), INV32_PAIR(-36, 43), INV32_PAIR(89, 70),
+      INV32_PAIR(82, 22), INV32_PAIR(-54, -90), INV32_PAIR(-61, 13), INV32_PAIR(78, 85), INV32_PAIR(31, -46), INV32_PAIR(-90, -67), INV32_PAIR(4, 73), INV32_PAIR(88, 38) },
+    { INV32_PAIR(64, 43), INV32_PAIR(-50, -90), INV32_PAIR(-36, 57), INV32_PAIR(89, 25), INV32_PAIR(-64, -87), INV32_PAIR(-18, 70), INV32_PAIR(83, 9), INV32_PAIR(-75, -80),
+      INV32_PAIR(78, -4), INV32_PAIR(-82, -73), INV32_PAIR(13, 85), INV32_PAIR(67, -22), INV32_PAIR(-88, -61), INV32_PAIR(31, 90), INV32_PAIR(54, -38), INV32_PAIR(-90, -46) },
+    { INV32_PAIR(64, 25), INV32_PAIR(-75, -70), INV32_PAIR(36, 90), INV32_PAIR(18, -80), INV32_PAIR(-64, 43), INV32_PAIR(89, 9), INV32_PAIR(-83, -57), INV32_PAIR(50, 87),
+      INV32_PAIR(73, -31), INV32_PAIR(-90, -22), INV32_PAIR(78, 67), INV32_PAIR(-38, -90), INV32_PAIR(-13, 82), INV32_PAIR(61, -46), INV32_PAIR(-88, -4), INV32_PAIR(85, 54) },
+    { INV32_PAIR(64, 9), INV32_PAIR(-89, -25), INV32_PAIR(83, 43), INV32_PAIR(-75, -57), INV32_PAIR(64, 70), INV32_PAIR(-50, -80), INV32_PAIR(36, 87), INV32_PAIR(-18, -90),
+      INV32_PAIR(67, -54), INV32_PAIR(-78, 38), INV32_PAIR(85, -22), INV32_PAIR(-90, 4), INV32_PAIR(90, 13), INV32_PAIR(-88, -31), INV32_PAIR(82, 46), INV32_PAIR(-73, -61) },
+    { INV32_PAIR(64, -9), INV32_PAIR(-89, 25), INV32_PAIR(83, -43), INV32_PAIR(-75, 57), INV32_PAIR(64, -70), INV32_PAIR(-50, 80), INV32_PAIR(36, -87), INV32_PAIR(-18, 90),
+      INV32_PAIR(61, -73), INV32_PAIR(-46, 82), INV32_PAIR(31, -88), INV32_PAIR(-13, 90), INV32_PAIR(-4, -90), INV32_PAIR(22, 85), INV32_PAIR(-38, -78), INV32_PAIR(54, 67) },
+    { INV32_PAIR(64, -25), INV32_PAIR(-75, 70), INV32_PAIR(36, -90), INV32_PAIR(18, 80), INV32_PAIR(-64, -43), INV32_PAIR(89, -9), INV32_PAIR(-83, 57), INV32_PAIR(50, -87),
+      INV32_PAIR(54, -85), INV32_PAIR(-4, 88), INV32_PAIR(-46, -61), INV32_PAIR(82, 13), INV32_PAIR(-90, 38), INV32_PAIR(67, -78), INV32_PAIR(-22, 90), INV32_PAIR(-31, -73) },
+    { INV32_PAIR(64, -43), INV32_PAIR(-50, 90), INV32_PAIR(-36, -57), INV32_PAIR(89, -25), INV32_PAIR(-64, 87), INV32_PAIR(-18, -70), INV32_PAIR(83, -9), INV32_PAIR(-75, 80),
+      INV32_PAIR(46, -90), INV32_PAIR(38, 54), INV32_PAIR(-90, 31), INV32_PAIR(61, -88), INV32_PAIR(22, 67), INV32_PAIR(-85, 13), INV32_PAIR(73, -82), INV32_PAIR(4, 78) },
+    { INV32_PAIR(64, -57), INV32_PAIR(-18, 80), INV32_PAIR(-83, 25), INV32_PAIR(50, -90), INV32_PAIR(64, 9), INV32_PAIR(-75, 87), INV32_PAIR(-36, -43), INV32_PAIR(89, -70),
+      INV32_PAIR(38, -88), INV32_PAIR(73, -4), INV32_PAIR(-67, 90), INV32_PAIR(-46, -31), INV32_PAIR(85, -78), INV32_PAIR(13, 61), INV32_PAIR(-90, 54), INV32_PAIR(22, -82) },
+    { INV32_PAIR(64, -70), INV32_PAIR(18, 43), INV32_PAIR(-83, 87), INV32_PAIR(-50, -9), INV32_PAIR(64, -90), INV32_PAIR(75, -25), INV32_PAIR(-36, 80), INV32_PAIR(-89, 57),
+      INV32_PAIR(31, -78), INV32_PAIR(90, -61), INV32_PAIR(4, 54), INV32_PAIR(-88, 82), INV32_PAIR(-38, -22), INV32_PAIR(73, -90), INV32_PAIR(67, -13), INV32_PAIR(-46, 85) },
+    { INV32_PAIR(64, -80), INV32_PAIR(50, -9), INV32_PAIR(-36, 70), INV32_PAIR(-89, 87), INV32_PAIR(-64, 25), INV32_PAIR(18, -57), INV32_PAIR(83, -90), INV32_PAIR(75, -43),
+      INV32_PAIR(22, -61), INV32_PAIR(85, -90), INV32_PAIR(73, -38), INV32_PAIR(-4, 46), INV32_PAIR(-78, 90), INV32_PAIR(-82, 54), INV32_PAIR(-13, -31), INV32_PAIR(67, -88) },
+    { INV32_PAIR(64, -87), INV32_PAIR(75, -57), INV32_PAIR(36, -9), INV32_PAIR(-18, 43), INV32_PAIR(-64, 80), INV32_PAIR(-89, 90), INV32_PAIR(-83, 70), INV32_PAIR(-50, 25),
+      INV32_PAIR(13, -38), INV32_PAIR(61, -78), INV32_PAIR(88, -90), INV32_PAIR(85, -73), INV32_PAIR(54, -31), INV32_PAIR(4, 22), INV32_PAIR(-46, 67), INV32_PAIR(-82, 90) },
+    { INV32_PAIR(64, -90), INV32_PAIR(89, -87), INV32_PAIR(83, -80), INV32_PAIR(75, -70), INV32_PAIR(64, -57), INV32_PAIR(50, -43), INV32_PAIR(36, -25), INV32_PAIR(18, -9),
+      INV32_PAIR(4, -13), INV32_PAIR(22, -31), INV32_PAIR(38, -46), INV32_PAIR(54, -61), INV32_PAIR(67, -73), INV32_PAIR(78, -82), INV32_PAIR(85, -88), INV32_PAIR(90, -90) },
+};
+
+#undef INV32_PAIR
+
+// 32-point inverse transform of the 32 columns of src, row n of dst is sum(T[j][n] * src row j).
+// The sums over the even and the odd rows j give row n as even + odd and row 31 - n as
+// even - odd. The columns are processed in the unpacklo/unpackhi order, which packs_epi32 undoes.
+FORCE_INLINE static AVX512_FUNC_TARGET
+void EbHevcInvTransform32_AVX512_INTRIN(EB_S16 *src, EB_U32 src_stride, EB_S16 *dst, EB_U32 dst_stride, EB_U32 shift)
+{
+    EB_U32 n, p;
+    __m128i s0;
+    __m512i o0;
+    __m512i evenRows[16], oddRows[16];
+
+    s0 = _mm_cvtsi32_si128(shift);
+    o0 = _mm512_set1_epi32(1 << (shift - 1));
+
+    for (p = 0; p < 8; p++)
+    {
+        __m512i x0 = _mm512_loadu_si512((const __m512i *)(src + (4 * p + 0) * src_stride));
+        __m512i x1 = _mm512_loadu_si512((const __m512i *)(src + (4 * p + 1) * src_stride));
+        __m512i x2 = _mm512_loadu_si512((const __m512i *)(src + (4 * p + 2) * src_stride));
+        __m512i x3 = _mm512_loadu_si512((const __m512i *)(src + (4 * p + 3) * src_stride));
+
+        evenRows[p] = _mm512_unpacklo_epi16(x0, x2);
+        evenRows[p + 8] = _mm512_unpackhi_epi16(x0, x2);
+        oddRows[p] = _mm512_unpacklo_epi16(x1, x3);
+        oddRows[p + 8] = _mm512_unpackhi_epi16(x1, x3);
+    }
+
+    for (n = 0; n < 16; n++)
+    {
+        __m512i evenLo = o0;
+        __m512i evenHi = o0;
+        __m512i oddLo = _mm512_setzero_si512();
+        __m512i oddHi = _mm512_setzero_si512();
+
+        for (p = 0; p < 8; p++)
+        {
+            __m512i evenCoeff = _mm512_set1_epi32(EbHevcInvCoeff32_AVX512[n][p]);
+            __m512i oddCoeff = _mm512_set1_epi32(EbHevcInvCoeff32_AVX512[n][p + 8]);
+
+            evenLo = _mm512_add_epi32(evenLo, _mm512_madd_epi16(evenRows[p], evenCoeff));
+            evenHi = _mm512_add_epi32(evenHi, _mm512_madd_epi16(evenRows[p + 8], evenCoeff));
+            oddLo = _mm512_add_epi32(oddLo, _mm512_madd_epi16(oddRows[p], oddCoeff));
+            oddHi = _mm512_add_epi32(oddHi, _mm512_madd_epi16(oddRows[p + 8], oddCoeff));
+        }
+
+        _mm512_storeu_si512((__m512i *)(dst + n * dst_stride), _mm512_packs_epi32(
+            _mm512_sra_epi32(_mm512_add_epi32(evenLo, oddLo), s0),
+            _mm512_sra_epi32(_mm512_add_epi32(evenHi, oddHi), s0)));
+        _mm512_storeu_si512((__m512i *)(dst + (31 - n) * dst_stride), _mm512_packs_epi32(
+            _mm512_sra_epi32(_mm512_sub_epi32(evenLo, oddLo), s0),
+            _mm512_sra_epi32(_mm512_sub_epi32(evenHi, oddHi), s0)));
+    }
+}
+#endif
+
 void Pfreq1DTransform32_AVX2_INTRIN(
     EB_S16 *src,
     EB_U32  src_stride,
@@ -1474,6 +1683,26 @@ EB_EXTERN void lowPrecisionTransform32x32_AVX2_INTRIN(EB_S16 *src, EB_U32 src_st
     EbHevcTranspose32_AVX2_INTRIN(intermediate, 32, dst, dst_stride);
 }
 
+#ifndef NON_AVX512_SUPPORT
+EB_EXTERN void lowPrecisionTransform32x32_AVX512_INTRIN(EB_S16 *src, EB_U32 src_stride, EB_S16 *dst, EB_U32 dst_stride, EB_S16 *intermediate, EB_U32 addshift)
+{
+    EbHevcTransform32_AVX512_INTRIN(src, src_stride, intermediate, 32, 6 + addshift);
+    EbHevcTranspose32_AVX2_INTRIN(intermediate, 32, dst, dst_stride);
+    EbHevcTransform32_AVX512_INTRIN(dst, dst_stride, intermediate, 32, 9);
+    EbHevcTranspose32_AVX2_INTRIN(intermediate, 32, dst, dst_stride);
+}
+
+// inverse 32x32 transform, bit exact with InvTransform32x32
+AVX512_FUNC_TARGET
+EB_EXTERN void InvTransform32x32_AVX512_INTRIN(EB_S16 *src, EB_U32 src_stride, EB_S16 *dst, EB_U32 dst_stride, EB_S16 *intermediate, EB_U32 addshift)
+{
+    EbHevcInvTransform32_AVX512_INTRIN(src, src_stride, intermediate, 32, 7);
+    EbHevcTranspose32_AVX2_INTRIN(intermediate, 32, dst, dst_stride);
+    EbHevcInvTransform32_AVX512_INTRIN(dst, dst_stride, intermediate, 32, 12 - addshift);
+    EbHevcTranspose32_AVX2_INTRIN(intermediate, 32, dst, dst_stride);
+}
+#endif
+
 void MatMult4x4_OutBuff_AVX2_INTRIN(
 	EB_S16*              coeff,
 	const EB_U32         coeffStride,
@@ -1609,8 +1838,10 @@ void MatMult4x4_AVX2_INTRIN(
         _mm_storel_epi64((__m128i *)(coeff + 2 * coeffStride), b);
         _mm_storel_epi64((__m128i *)(coeff + 3 * coeffStride), _mm_srli_si128(b, 8));
 
-		  z = _mm256_sad_epu8(z, _mm256_srli_si256(z, 8));
-          *nonzerocoeff = _mm_cvtsi128_si32(_mm_add_epi32(_mm256_extracti128_si256(z, 0), _mm256_extracti128_si256(z, 1)));
+        // z holds a 1 in every 16 bit lane of a non zero coefficient
+        z = _mm256_sad_epu8(z, _mm256_setzero_si256());
+        a = _mm_add_epi64(_mm256_extracti128_si256(z, 0), _mm256_extracti128_si256(z, 1));
+        *nonzerocoeff = _mm_cvtsi128_si32(_mm_add_epi64(a, _mm_srli_si128(a, 8)));
 
 }
 /*******************************************MatMult8x8_AVX2_INTRIN**************************************************/
@@ -69,3 +69,28 @@ void Chroma2SampleEdgeDLFCore16bit_SSE2_INTRIN(
 
     return;
 }
+
+void Chroma8SampleEdgeDLFCore16bit_SSE2_INTRIN(
+    EB_U16				  *edgeStartSampleCb,
+    EB_U16				  *edgeStartSampleCr,
+    EB_U32                 reconChromaPicStride,
+    EB_BOOL                isVerticalEdge,
+    EB_U8                 *cbTcArray,
+    EB_U8                 *crTcArray)
+{
+    EB_U32 segmentIndex;
+
+    for (segmentIndex = 0; segmentIndex < 4; ++segmentIndex) {
+        if (cbTcArray[segmentIndex] | crTcArray[segmentIndex]) {
+            Chroma2SampleEdgeDLFCore16bit_SSE2_INTRIN(
+                edgeStartSampleCb + segmentIndex * (isVerticalEdge ? 2 * reconChromaPicStride : 2),
+                edgeStartSampleCr + segmentIndex * (isVerticalEdge ? 2 * reconChromaPicStride : 2),
+                reconChromaPicStride,
+                isVerticalEdge,
+                cbTcArray[segmentIndex],
+                crTcArray[segmentIndex]);
+        }
+    }
+
+    return;
+}
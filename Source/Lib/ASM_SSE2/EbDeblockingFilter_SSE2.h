@@ -20,6 +20,14 @@ extern void Chroma2SampleEdgeDLFCore16bit_SSE2_INTRIN(
     EB_U8                  cbTc,
     EB_U8                  crTc);
 
+extern void Chroma8SampleEdgeDLFCore16bit_SSE2_INTRIN(
+    EB_U16				  *edgeStartSampleCb,
+    EB_U16				  *edgeStartSampleCr,
+    EB_U32                 reconChromaPicStride,
+    EB_BOOL                isVerticalEdge,
+    EB_U8                 *cbTcArray,
+    EB_U8                 *crTcArray);
+
 
 #ifdef __cplusplus
 }
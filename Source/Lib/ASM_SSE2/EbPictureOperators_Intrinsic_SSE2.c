@@ -1700,4 +1700,51 @@ void PictureAdditionKernel16bit_SSE2_INTRIN(
 	return;
 }
 
+/*********************************
+ * Decimation2D_SSE2_INTRIN
+ *   SIMD version of Decimation2D: keeps
+ *   every decimStep-th sample of every
+ *   decimStep-th row, decimStep 2 or 4
+ *********************************/
+void Decimation2D_SSE2_INTRIN(
+	EB_U8  *inputSamples,
+	EB_U32  inputStride,
+	EB_U32  inputAreaWidth,
+	EB_U32  inputAreaHeight,
+	EB_U8  *decimSamples,
+	EB_U32  decimStride,
+	EB_U32  decimStep)
+{
+	const __m128i evenMask = _mm_set1_epi16(0x00FF);
+	const __m128i fourthMask = _mm_set1_epi32(0x000000FF);
+	EB_U32 horizontalIndex;
+	EB_U32 verticalIndex;
+
+	for (verticalIndex = 0; verticalIndex < inputAreaHeight; verticalIndex += decimStep) {
+		horizontalIndex = 0;
+		if (decimStep == 2) {
+			for (; horizontalIndex + 32 <= inputAreaWidth; horizontalIndex += 32) {
+				__m128i xmm0 = _mm_and_si128(_mm_loadu_si128((__m128i *)(inputSamples + horizontalIndex)), evenMask);
+				__m128i xmm1 = _mm_and_si128(_mm_loadu_si128((__m128i *)(inputSamples + horizontalIndex + 16)), evenMask);
+				_mm_storeu_si128((__m128i *)(decimSamples + (horizontalIndex >> 1)), _mm_packus_epi16(xmm0, xmm1));
+			}
+		}
+		else if (decimStep == 4) {
+			for (; horizontalIndex + 64 <= inputAreaWidth; horizontalIndex += 64) {
+				__m128i xmm0 = _mm_and_si128(_mm_loadu_si128((__m128i *)(inputSamples + horizontalIndex)), fourthMask);
+				__m128i xmm1 = _mm_and_si128(_mm_loadu_si128((__m128i *)(inputSamples + horizontalIndex + 16)), fourthMask);
+				__m128i xmm2 = _mm_and_si128(_mm_loadu_si128((__m128i *)(inputSamples + horizontalIndex + 32)), fourthMask);
+				__m128i xmm3 = _mm_and_si128(_mm_loadu_si128((__m128i *)(inputSamples + horizontalIndex + 48)), fourthMask);
+				_mm_storeu_si128((__m128i *)(decimSamples + (horizontalIndex >> 2)),
+					_mm_packus_epi16(_mm_packs_epi32(xmm0, xmm1), _mm_packs_epi32(xmm2, xmm3)));
+			}
+		}
+		for (; horizontalIndex < inputAreaWidth; horizontalIndex += decimStep) {
+			decimSamples[(horizontalIndex >> (decimStep >> 1))] = inputSamples[horizontalIndex];
+		}
+		inputSamples += (inputStride << (decimStep >> 1));
+		decimSamples += decimStride;
+	}
 
+	return;
+}
@@ -336,6 +336,15 @@ void PictureAdditionKernel16bit_SSE2_INTRIN(
 	EB_U32  width,
 	EB_U32  height);
 
+void Decimation2D_SSE2_INTRIN(
+	EB_U8  *inputSamples,
+	EB_U32  inputStride,
+	EB_U32  inputAreaWidth,
+	EB_U32  inputAreaHeight,
+	EB_U8  *decimSamples,
+	EB_U32  decimStride,
+	EB_U32  decimStep);
+
 
 
 #ifdef __cplusplus
@@ -455,3 +455,24 @@ EB_EXTERN void Luma4SampleEdgeDLFCore16bit_SSSE3_INTRIN(
         }
     }
 }
+
+EB_EXTERN void Luma8SampleEdgeDLFCore16bit_SSSE3_INTRIN(
+    EB_U16*                edgeStartFilteredSamplePtr,
+    EB_U32                 reconLumaPicStride,
+    EB_BOOL                isVerticalEdge,
+    EB_S32*                tcArray,
+    EB_S32*                betaArray)
+{
+    EB_U32 segmentIndex;
+
+    for (segmentIndex = 0; segmentIndex < 2; ++segmentIndex) {
+        if (betaArray[segmentIndex]) {
+            Luma4SampleEdgeDLFCore16bit_SSSE3_INTRIN(
+                edgeStartFilteredSamplePtr + segmentIndex * (isVerticalEdge ? 4 * reconLumaPicStride : 4),
+                reconLumaPicStride,
+                isVerticalEdge,
+                tcArray[segmentIndex],
+                betaArray[segmentIndex]);
+        }
+    }
+}
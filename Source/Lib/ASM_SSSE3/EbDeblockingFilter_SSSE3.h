@@ -33,6 +33,13 @@ void Luma4SampleEdgeDLFCore16bit_SSSE3_INTRIN(
     EB_S32          tc,                     
     EB_S32          beta); 
 
+void Luma8SampleEdgeDLFCore16bit_SSSE3_INTRIN(
+    EB_U16         *edgeStartFilteredSamplePtr,
+    EB_U32          reconLumaPicStride,
+    EB_BOOL         isVerticalEdge,
+    EB_S32         *tcArray,
+    EB_S32         *betaArray);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,8 @@
 extern "C" {
 #endif
 
+extern const EB_S16 EbHevcLumaFilterCoeff[4][8];
+
 // SSSE3 functions
 void ChromaInterpolationCopy_SSSE3(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst, EB_U32 fracPosx, EB_U32 fracPosy);
 void ChromaInterpolationFilterOneDHorizontal_SSSE3(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst, EB_U32 fracPosx, EB_U32 fracPosy);
@@ -54,6 +56,13 @@ void LumaInterpolationFilterPosnOutRaw_SSSE3(EB_BYTE refPic, EB_U32 srcStride, E
 void LumaInterpolationFilterPospOutRaw_SSSE3(EB_BYTE refPic, EB_U32 srcStride, EB_S16* dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst);
 void LumaInterpolationFilterPosqOutRaw_SSSE3(EB_BYTE refPic, EB_U32 srcStride, EB_S16* dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst);
 void LumaInterpolationFilterPosrOutRaw_SSSE3(EB_BYTE refPic, EB_U32 srcStride, EB_S16* dst, EB_U32 puWidth, EB_U32 puHeight, EB_S16 *firstPassIFDst);
+void LumaInterpolationFilterOneDHorizontal_SSSE3(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_U32 fracPosx);
+void LumaInterpolationFilterOneDOutRawHorizontal_SSSE3(EB_BYTE refPic, EB_U32 srcStride, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_U32 fracPosx);
+void LumaInterpolationFilterOneDVertical_SSSE3(EB_BYTE refPic, EB_U32 srcStride, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_U32 fracPosx);
+void EbHevcLumaInterpolationFilterTwoDInRaw7_SSSE3(EB_S16 *firstPassIFDst, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight, EB_U32 fracPosy);
+void EbHevcLumaInterpolationFilterTwoDInRawM_SSSE3(EB_S16 *firstPassIFDst, EB_BYTE dst, EB_U32 dstStride, EB_U32 puWidth, EB_U32 puHeight);
+void EbHevcLumaInterpolationFilterTwoDInRawOutRaw7_SSSE3(EB_S16 *firstPassIFDst, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight, EB_U32 fracPosy);
+void EbHevcLumaInterpolationFilterTwoDInRawOutRawM_SSSE3(EB_S16 *firstPassIFDst, EB_S16 *dst, EB_U32 puWidth, EB_U32 puHeight);
 void BiPredClipping_SSSE3(EB_U32 puWidth, EB_U32 puHeight, EB_S16 *list0Src, EB_S16 *list1Src, EB_BYTE dst, EB_U32 dstStride, EB_S32 offset);
 
 void BiPredClippingOnTheFly_SSSE3(
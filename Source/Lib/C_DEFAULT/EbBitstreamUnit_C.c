@@ -0,0 +1,45 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbBitstreamUnit_C.h"
+
+/*********************************************************
+* InsertEmulationPrevention_C
+*  Copies RBSP bytes to the payload and inserts an emulation
+*  prevention byte (0x03) before any 0x00-0x03 byte that
+*  follows two zero bytes. A byte may be followed by its
+*  emulation prevention byte past writeEnd.
+*********************************************************/
+void InsertEmulationPrevention_C(
+    const EB_U8 *readBytePtr,
+    EB_U32      *readLocation,
+    EB_U32       readEnd,
+    EB_U8       *writeBytePtr,
+    EB_U32      *writeLocation,
+    EB_U32       writeEnd,
+    EB_U32      *zeroByteCount)
+{
+    EB_U32 readIndex  = *readLocation;
+    EB_U32 writeIndex = *writeLocation;
+    EB_U32 zeroCount  = *zeroByteCount;
+
+    while (readIndex < readEnd && writeIndex < writeEnd) {
+        // add emulation code
+        if (zeroCount == 2 && (readBytePtr[readIndex] & 0xfc) == 0) {
+            writeBytePtr[writeIndex++] = 0x03;
+            zeroCount = 0;
+        }
+
+        writeBytePtr[writeIndex++] = readBytePtr[readIndex];
+
+        // count the number of zeros for emulation code check
+        zeroCount = (readBytePtr[readIndex] == 0) ? zeroCount + 1 : 0;
+        readIndex++;
+    }
+
+    *readLocation   = readIndex;
+    *writeLocation  = writeIndex;
+    *zeroByteCount  = zeroCount;
+}
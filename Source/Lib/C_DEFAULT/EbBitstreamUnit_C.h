@@ -0,0 +1,27 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbBitstreamUnit_C_h
+#define EbBitstreamUnit_C_h
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "EbDefinitions.h"
+
+void InsertEmulationPrevention_C(
+    const EB_U8 *readBytePtr,       // input parameter, RBSP bytes
+    EB_U32      *readLocation,      // input/output parameter, next byte to read
+    EB_U32       readEnd,           // input parameter, read stops at this byte
+    EB_U8       *writeBytePtr,      // output parameter, payload bytes
+    EB_U32      *writeLocation,     // input/output parameter, next byte to write
+    EB_U32       writeEnd,          // input parameter, no byte is read once writeLocation reaches it
+    EB_U32      *zeroByteCount);    // input/output parameter, zero bytes written since the last non-zero byte
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EbBitstreamUnit_C_h
@@ -575,3 +575,61 @@ void Chroma2SampleEdgeDLFCore16bit(
 
     return;
 }
+
+/** Luma8SampleEdgeDLFCore16bit()
+filters the two 4 sample segments of the 8 sample luma edge of an 8x8
+block. tcArray and betaArray hold the thresholds of each segment, a
+segment with a zero beta is not filtered.
+*/
+void Luma8SampleEdgeDLFCore16bit(
+    EB_U16         *edgeStartFilteredSamplePtr,
+    EB_U32          reconLumaPicStride,
+    EB_BOOL         isVerticalEdge,
+    EB_S32         *tcArray,
+    EB_S32         *betaArray)
+{
+    EB_U32 segmentIndex;
+
+    for (segmentIndex = 0; segmentIndex < 2; ++segmentIndex) {
+        if (betaArray[segmentIndex]) {
+            Luma4SampleEdgeDLFCore16bit(
+                edgeStartFilteredSamplePtr + segmentIndex * (isVerticalEdge ? 4 * reconLumaPicStride : 4),
+                reconLumaPicStride,
+                isVerticalEdge,
+                tcArray[segmentIndex],
+                betaArray[segmentIndex]);
+        }
+    }
+
+    return;
+}
+
+/** Chroma8SampleEdgeDLFCore16bit()
+filters the four 2 sample segments of the 8 sample chroma edge of an
+8x8 block. cbTcArray and crTcArray hold the tc of each segment, a
+segment with a zero tc in both components is not filtered.
+*/
+void Chroma8SampleEdgeDLFCore16bit(
+    EB_U16                *edgeStartSampleCb,
+    EB_U16                *edgeStartSampleCr,
+    EB_U32                 reconChromaPicStride,
+    EB_BOOL                isVerticalEdge,
+    EB_U8                 *cbTcArray,
+    EB_U8                 *crTcArray)
+{
+    EB_U32 segmentIndex;
+
+    for (segmentIndex = 0; segmentIndex < 4; ++segmentIndex) {
+        if (cbTcArray[segmentIndex] | crTcArray[segmentIndex]) {
+            Chroma2SampleEdgeDLFCore16bit(
+                edgeStartSampleCb + segmentIndex * (isVerticalEdge ? 2 * reconChromaPicStride : 2),
+                edgeStartSampleCr + segmentIndex * (isVerticalEdge ? 2 * reconChromaPicStride : 2),
+                reconChromaPicStride,
+                isVerticalEdge,
+                cbTcArray[segmentIndex],
+                crTcArray[segmentIndex]);
+        }
+    }
+
+    return;
+}
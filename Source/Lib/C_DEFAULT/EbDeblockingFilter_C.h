@@ -45,6 +45,21 @@ void Chroma2SampleEdgeDLFCore16bit(
     EB_U8                  cbTc,
     EB_U8                  crTc);
 
+void Luma8SampleEdgeDLFCore16bit(
+    EB_U16         *edgeStartFilteredSamplePtr,
+    EB_U32          reconLumaPicStride,
+    EB_BOOL         isVerticalEdge,
+    EB_S32         *tcArray,
+    EB_S32         *betaArray);
+
+void Chroma8SampleEdgeDLFCore16bit(
+    EB_U16				  *edgeStartSampleCb,
+    EB_U16				  *edgeStartSampleCr,
+    EB_U32                 reconChromaPicStride,
+    EB_BOOL                isVerticalEdge,
+    EB_U8                 *cbTcArray,
+    EB_U8                 *crTcArray);
+
 
 #ifdef __cplusplus
 }
@@ -293,27 +293,15 @@ void BiPredAverageKernel_C(
 
 }
 
-typedef void(*EB_BIAVG_FUNC)(
-	EB_BYTE                  src0,
-	EB_U32                   src0Stride,
-	EB_BYTE                  src1,
-	EB_U32                   src1Stride,
-	EB_BYTE                  dst,
-	EB_U32                   dstStride,
-	EB_U32                   areaWidth,
-	EB_U32                   areaHeight);
-
-
 /*****************************
 * Function Tables
 *****************************/
-static EB_BIAVG_FUNC FUNC_TABLE BiPredAverageKernel_funcPtrArray[EB_ASM_TYPE_TOTAL] =
+const EB_BIAVG_FUNC FUNC_TABLE BiPredAverageKernel_funcPtrArray[EB_ASM_AVX512_TYPE_TOTAL] =
 {
 	BiPredAverageKernel_C,
+    BiPredAverageKernel_AVX2_INTRIN,
 #ifndef NON_AVX512_SUPPORT
 	BiPredAverageKernel_AVX512_INTRIN
-#else
-    BiPredAverageKernel_AVX2_INTRIN
 #endif
 };
 
@@ -383,11 +371,7 @@ void BiPredIFreeRef8Bit(
 
 		if ( (fracPosL0 == 0) && (fracPosL1 == 0) )	 
 		{
-#ifndef NON_AVX512_SUPPORT
-			BiPredAverageKernel_funcPtrArray[!!(ASM_TYPES & AVX512_MASK) ](
-#else
-            BiPredAverageKernel_funcPtrArray[!!(ASM_TYPES & AVX2_MASK)](
-#endif
+			BiPredAverageKernel_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & AVX2_MASK))](
 				refPicList0->bufferY + integPosL0x + integPosL0y * refLumaStride,
 				refLumaStride,
 				refPicList1->bufferY + integPosL1x + integPosL1y * refLumaStride,
@@ -495,11 +479,7 @@ void BiPredIFreeRef8Bit(
 		shift = 0;
 		if ((fracPosL0 == 0) && (fracPosL1 == 0))
 		{
-#ifndef NON_AVX512_SUPPORT
-            BiPredAverageKernel_funcPtrArray[!!(ASM_TYPES & AVX512_MASK)](
-#else
-            BiPredAverageKernel_funcPtrArray[!!(ASM_TYPES & AVX2_MASK)](
-#endif
+            BiPredAverageKernel_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & AVX2_MASK))](
 				refPicList0->bufferCb + integPosL0x + integPosL0y * refPicList0->strideCb,
 				refPicList0->strideCb,
 				refPicList1->bufferCb + integPosL1x + integPosL1y * refPicList1->strideCb,
@@ -509,11 +489,7 @@ void BiPredIFreeRef8Bit(
 				chromaPuWidth,
 				chromaPuHeight);
 
-#ifndef NON_AVX512_SUPPORT
-            BiPredAverageKernel_funcPtrArray[!!(ASM_TYPES & AVX512_MASK)](
-#else
-            BiPredAverageKernel_funcPtrArray[!!(ASM_TYPES & AVX2_MASK)](
-#endif
+            BiPredAverageKernel_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & AVX2_MASK))](
 				refPicList0->bufferCr + integPosL0x + integPosL0y * refPicList0->strideCr,
 				refPicList0->strideCr,
 				refPicList1->bufferCr + integPosL1x + integPosL1y * refPicList1->strideCr,
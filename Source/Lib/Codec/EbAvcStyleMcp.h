@@ -146,6 +146,28 @@ static const PictureAverage1Line FUNC_TABLE PictureAverage1LineArray[EB_ASM_TYPE
     PictureAverageKernel1Line_SSE2_INTRIN,
 };
 
+typedef void(*EB_BIAVG_FUNC)(
+	EB_BYTE                  src0,
+	EB_U32                   src0Stride,
+	EB_BYTE                  src1,
+	EB_U32                   src1Stride,
+	EB_BYTE                  dst,
+	EB_U32                   dstStride,
+	EB_U32                   areaWidth,
+	EB_U32                   areaHeight);
+
+void BiPredAverageKernel_C(
+	EB_BYTE                  src0,
+	EB_U32                   src0Stride,
+	EB_BYTE                  src1,
+	EB_U32                   src1Stride,
+	EB_BYTE                  dst,
+	EB_U32                   dstStride,
+	EB_U32                   areaWidth,
+	EB_U32                   areaHeight);
+
+extern const EB_BIAVG_FUNC BiPredAverageKernel_funcPtrArray[EB_ASM_AVX512_TYPE_TOTAL];
+
 #ifdef __cplusplus
 }
 #endif
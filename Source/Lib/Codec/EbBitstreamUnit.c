@@ -7,6 +7,24 @@
 
 #include "EbBitstreamUnit.h"
 #include "EbDefinitions.h"
+#include "EbBitstreamUnit_C.h"
+#include "EbBitstreamUnit_Intrinsic_AVX2.h"
+
+typedef void(*EB_INSERT_EMULATION_PREVENTION_TYPE)(
+    const EB_U8 *readBytePtr,
+    EB_U32      *readLocation,
+    EB_U32       readEnd,
+    EB_U8       *writeBytePtr,
+    EB_U32      *writeLocation,
+    EB_U32       writeEnd,
+    EB_U32      *zeroByteCount);
+
+static EB_INSERT_EMULATION_PREVENTION_TYPE FUNC_TABLE InsertEmulationPrevention_funcPtrArray[EB_ASM_TYPE_TOTAL] = {
+    // C_DEFAULT
+    InsertEmulationPrevention_C,
+    // AVX2
+    InsertEmulationPrevention_AVX2_INTRIN,
+};
 
 /**********************************
  * Constructor
@@ -176,44 +194,61 @@ EB_ERRORTYPE OutputBitstreamRBSPToPayload(
     EB_U32  writeLocation           = startLocation;
     EB_U32  readLocation            = startLocation;
     EB_U32  sliceIndex              = 0;
+    EB_U32  writeEnd;
+    EB_U32  segmentEnd;
+    EB_U32  copySize;
     EB_BYTE readBytePtr;
     EB_BYTE writeBytePtr;
 
-
     readBytePtr  = (EB_BYTE) bitstreamPtr->bufferBegin;
     writeBytePtr = &outputBuffer[*outputBufferIndex];
 
-    while ( (readLocation < bufferWrittenBytesCount) && ((*outputBufferIndex) < ((*outputBufferSize)-5)) ) {
+    // Bytes are written while the payload holds fewer than outputBufferSize - 5 bytes
+    if (*outputBufferIndex >= *outputBufferSize - 5) {
+        return return_error;
+    }
+    writeEnd = startLocation + ((*outputBufferSize - 5) - *outputBufferIndex);
+
+    while (readLocation < bufferWrittenBytesCount && writeLocation < writeEnd) {
         // skip over start codes introduced before slice headers
         if (sliceIndex < bitstreamPtr->sliceNum &&
-                readLocation == bitstreamPtr->sliceLocation[sliceIndex] &&
-                (*outputBufferIndex) < ((*outputBufferSize)-3)) {
+                readLocation == bitstreamPtr->sliceLocation[sliceIndex]) {
             writeBytePtr[writeLocation++] =  readBytePtr[readLocation++];
             writeBytePtr[writeLocation++] =  readBytePtr[readLocation++];
             writeBytePtr[writeLocation++] =  readBytePtr[readLocation++];
             writeBytePtr[writeLocation++] =  readBytePtr[readLocation++];
 
-            *outputBufferIndex += 4;
             sliceIndex++;
+            continue;
         }
 
-        // add emulation code
-        if( (zeroByteCount == 2) && ((readBytePtr[readLocation] & 0xfc) == 0) && ((*outputBufferIndex) < (*outputBufferSize)) && nalType != NAL_UNIT_UNSPECIFIED_62 ) {
-            writeBytePtr[writeLocation++] = 0x03;
-            zeroByteCount = 0;
-            *outputBufferIndex += 1;
+        // the bytes up to the next start code are processed in one call
+        segmentEnd = bufferWrittenBytesCount;
+        if (sliceIndex < bitstreamPtr->sliceNum &&
+                bitstreamPtr->sliceLocation[sliceIndex] > readLocation &&
+                bitstreamPtr->sliceLocation[sliceIndex] < bufferWrittenBytesCount) {
+            segmentEnd = bitstreamPtr->sliceLocation[sliceIndex];
         }
 
-        if ((*outputBufferIndex) < (*outputBufferSize)) {
-            writeBytePtr[writeLocation++] = readBytePtr[readLocation];
-            *outputBufferIndex += 1;
+        if (nalType == NAL_UNIT_UNSPECIFIED_62) {
+            copySize = EB_MIN(segmentEnd - readLocation, writeEnd - writeLocation);
+            EB_MEMCPY(&writeBytePtr[writeLocation], &readBytePtr[readLocation], copySize);
+            readLocation  += copySize;
+            writeLocation += copySize;
+        }
+        else {
+            InsertEmulationPrevention_funcPtrArray[!!(ASM_TYPES & AVX2_MASK)](
+                readBytePtr,
+                &readLocation,
+                segmentEnd,
+                writeBytePtr,
+                &writeLocation,
+                writeEnd,
+                &zeroByteCount);
         }
-
-        // count the number of zeros for emulation code check
-        zeroByteCount = (readBytePtr[readLocation] == 0 ) ? zeroByteCount + 1 : 0;
-        readLocation++;
     }
 
+    *outputBufferIndex += writeLocation - startLocation;
     bitstreamPtr->writtenBitsCount = writeLocation << 3;
 
     return return_error;
@@ -2350,6 +2350,10 @@ EB_ERRORTYPE QpmDeriveBeaAndSkipQpmFlagLcu(
     EB_U8                           minQpAllowed = (EB_U8)sequenceControlSetPtr->staticConfig.minQpAllowed;
     EB_U8                           maxQpAllowed = (EB_U8)sequenceControlSetPtr->staticConfig.maxQpAllowed;
 
+    // CRF temporal importance of the LCU
+    if (sequenceControlSetPtr->staticConfig.rateControlMode == 2) {
+        pictureQp += pictureControlSetPtr->ParentPcsPtr->propagateDeltaQpArray[lcuIndex];
+    }
 
     if (sequenceControlSetPtr->staticConfig.segmentOvEnabled && pictureControlSetPtr->ParentPcsPtr->segmentOvArray != NULL) {
         SegmentOverride_t *segmentOvPtr = pictureControlSetPtr->ParentPcsPtr->segmentOvArray;
@@ -3158,11 +3162,11 @@ EB_EXTERN void EncodePass(
     }
 
 
-    EB_BOOL useDeltaQp = (EB_BOOL)(sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled);
+    EB_BOOL useDeltaQp = (EB_BOOL)(sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled || sequenceControlSetPtr->staticConfig.rateControlMode == 2);
 
     EB_BOOL singleSegment = (sequenceControlSetPtr->encDecSegmentColCountArray[pictureControlSetPtr->temporalLayerIndex] == 1) && (sequenceControlSetPtr->encDecSegmentRowCountArray[pictureControlSetPtr->temporalLayerIndex] == 1);
 
-    EB_BOOL useDeltaQpSegments = singleSegment ? 0 : (EB_BOOL)(sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled);
+    EB_BOOL useDeltaQpSegments = singleSegment ? 0 : (EB_BOOL)(sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled || sequenceControlSetPtr->staticConfig.rateControlMode == 2);
 
     if (is16bit) {
         EncodePassPackLcu(
@@ -3210,8 +3214,8 @@ EB_EXTERN void EncodePass(
 
             cuPtr->deltaQp = 0;
 
-			cuPtr->qp = (sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled) ? contextPtr->qpmQp : pictureControlSetPtr->pictureQp;
-			lcuPtr->qp = (sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled) ? contextPtr->qpmQp : pictureControlSetPtr->pictureQp;
+			cuPtr->qp = (sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled || sequenceControlSetPtr->staticConfig.rateControlMode == 2) ? contextPtr->qpmQp : pictureControlSetPtr->pictureQp;
+			lcuPtr->qp = (sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled || sequenceControlSetPtr->staticConfig.rateControlMode == 2) ? contextPtr->qpmQp : pictureControlSetPtr->pictureQp;
             cuPtr->orgDeltaQp = cuPtr->deltaQp;
 
 			if (!contextPtr->skipQpmFlag &&
@@ -4464,8 +4468,8 @@ EB_EXTERN void EncodePass(
                     useDeltaQp,
                     &isDeltaQpNotCoded,
                     pictureControlSetPtr->difCuDeltaQpDepth,
-                    &(pictureControlSetPtr->encPrevCodedQp[tileIdx][singleSegment ? 0 : lcuRowIndex]),
-                    &(pictureControlSetPtr->encPrevQuantGroupCodedQp[tileIdx][singleSegment ? 0 : lcuRowIndex]),
+                    &(pictureControlSetPtr->encPrevCodedQp[tileIdx][(singleSegment && !sequenceControlSetPtr->staticConfig.enableWppFlag) ? 0 : lcuRowIndex]),
+                    &(pictureControlSetPtr->encPrevQuantGroupCodedQp[tileIdx][(singleSegment && !sequenceControlSetPtr->staticConfig.enableWppFlag) ? 0 : lcuRowIndex]),
                     lcuPtr->tileInfoPtr->tilePxlOriginX,
                     lcuPtr->tileInfoPtr->tilePxlOriginY,
                     lcuQp);
@@ -157,7 +157,6 @@ extern "C" {
         SadLoopKernel_AVX2_INTRIN,
     };
 
-#ifdef NON_AVX512_SUPPORT
     static EB_GETEIGHTSAD8x8 FUNC_TABLE GetEightHorizontalSearchPointResults_8x8_16x16_funcPtrArray[EB_ASM_TYPE_TOTAL] =
     {
         // C_DEFAULT
@@ -173,7 +172,6 @@ extern "C" {
         // AVX2
         GetEightHorizontalSearchPointResults_32x32_64x64_PU_AVX2_INTRIN,
     };
-#endif
 #ifdef __cplusplus
 }
 #endif
@@ -1220,6 +1220,10 @@ void Luma8x8blkDLFCore16bit(
 	EB_U32   Tc;
 	EB_S32   Beta;
 	EB_U16  *edgeStartFilteredSamplePtr;
+	EB_S32   verticalTcArray[2] = { 0, 0 };
+	EB_S32   verticalBetaArray[2] = { 0, 0 };
+	EB_S32   horizontalTcArray[2] = { 0, 0 };
+	EB_S32   horizontalBetaArray[2] = { 0, 0 };
 	//EB_BOOL  PCMFlagArray[2];
 
 	//vertical edge A filtering
@@ -1253,16 +1257,8 @@ void Luma8x8blkDLFCore16bit(
 		//CHKN
 		Tc = Tc << 2;
 		Beta = Beta << 2;
-
-		edgeStartFilteredSamplePtr = (EB_U16*)reconPic->bufferY + reconPic->originX + reconPic->originY * reconPic->strideY + (centerSamplePos_y - 4) * reconLumaPicStride + centerSamplePos_x;
-
-		// luma 4 sample edge DLF core
-		lumaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
-			edgeStartFilteredSamplePtr,
-			reconLumaPicStride,
-			EB_TRUE,
-			Tc,
-			Beta);
+		verticalTcArray[0] = Tc;
+		verticalBetaArray[0] = Beta;
 	}
 
 	//vertical edge C filtering
@@ -1296,17 +1292,21 @@ void Luma8x8blkDLFCore16bit(
 		//CHKN
 		Tc = Tc << 2;
 		Beta = Beta << 2;
+		verticalTcArray[1] = Tc;
+		verticalBetaArray[1] = Beta;
+	}
 
-		edgeStartFilteredSamplePtr = (EB_U16*)reconPic->bufferY + reconPic->originX + reconPic->originY * reconPic->strideY + centerSamplePos_y  * reconLumaPicStride + centerSamplePos_x;
+	// vertical edges A and C as one 8 sample edge, a zero beta skips the segment
+	// Stepped back from edge C, edge A is off when centerSamplePos_y - 4 would wrap
+	if (bSEdgeA > 0 || bSEdgeC > 0) {
+		edgeStartFilteredSamplePtr = (EB_U16*)reconPic->bufferY + reconPic->originX + reconPic->originY * reconPic->strideY + centerSamplePos_y * reconLumaPicStride + centerSamplePos_x - 4 * reconLumaPicStride;
 
-		// luma 4 sample edge DLF core
-		lumaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
+		lumaDlf8Sample_funcPtrArray16bit[SSE2_AVX2_SLOT](
 			edgeStartFilteredSamplePtr,
 			reconLumaPicStride,
 			EB_TRUE,
-			Tc,
-			Beta);
-		//PCMFlagArray);
+			verticalTcArray,
+			verticalBetaArray);
 	}
 
 	//horizontal edge B filtering
@@ -1339,15 +1339,8 @@ void Luma8x8blkDLFCore16bit(
 		//CHKN
 		Tc = Tc << 2;
 		Beta = Beta << 2;
-		edgeStartFilteredSamplePtr = (EB_U16*)reconPic->bufferY + reconPic->originX + reconPic->originY * reconPic->strideY + centerSamplePos_y * reconLumaPicStride + (centerSamplePos_x - 4);
-
-		// luma 4 sample edge DLF core
-		lumaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
-			edgeStartFilteredSamplePtr,
-			reconLumaPicStride,
-			EB_FALSE,
-			Tc,
-			Beta);
+		horizontalTcArray[0] = Tc;
+		horizontalBetaArray[0] = Beta;
 	}
 
 	//horizontal edge D filtering
@@ -1380,20 +1373,26 @@ void Luma8x8blkDLFCore16bit(
 		//CHKN
 		Tc = Tc << 2;
 		Beta = Beta << 2;
-		edgeStartFilteredSamplePtr = (EB_U16*)reconPic->bufferY + reconPic->originX + reconPic->originY * reconPic->strideY + centerSamplePos_y * reconLumaPicStride + centerSamplePos_x;
+		horizontalTcArray[1] = Tc;
+		horizontalBetaArray[1] = Beta;
+	}
 
-		// luma 4 sample edge DLF core
-		lumaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
+	// horizontal edges B and D as one 8 sample edge
+	if (bSEdgeB > 0 || bSEdgeD > 0) {
+		edgeStartFilteredSamplePtr = (EB_U16*)reconPic->bufferY + reconPic->originX + reconPic->originY * reconPic->strideY + centerSamplePos_y * reconLumaPicStride + centerSamplePos_x - 4;
+
+		lumaDlf8Sample_funcPtrArray16bit[SSE2_AVX2_SLOT](
 			edgeStartFilteredSamplePtr,
 			reconLumaPicStride,
 			EB_FALSE,
-			Tc,
-			Beta);
+			horizontalTcArray,
+			horizontalBetaArray);
 	}
 
 	return;
 }
 
+
 /** chroma8x8blkDLFCore()
 is used to conduct the deblocking fitler for each 8x8 independent
 chroma block. There are two 8 sample chroma edges crossing each other inside
@@ -1819,6 +1818,10 @@ static void chroma8x8blkDLFCore16bit(
 	EB_U8   crQp;
 	EB_U8    cbTc;
 	EB_U8    crTc;
+	EB_U8    verticalCbTcArray[4] = { 0, 0, 0, 0 };
+	EB_U8    verticalCrTcArray[4] = { 0, 0, 0, 0 };
+	EB_U8    horizontalCbTcArray[4] = { 0, 0, 0, 0 };
+	EB_U8    horizontalCrTcArray[4] = { 0, 0, 0, 0 };
 	//EB_BOOL  chromaPCMFlagArray[2];
 	EB_S32   CUqpIndex;
     EB_COLOR_FORMAT colorFormat = reconPic->colorFormat;
@@ -1862,18 +1865,8 @@ static void chroma8x8blkDLFCore16bit(
 		//CHKN
 		cbTc = cbTc << 2;
 		crTc = crTc << 2;
-
-        edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + (centerSamplePos_y - 4) * reconChromaPicStride + centerSamplePos_x;
-        edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + (centerSamplePos_y - 4) * reconChromaPicStride + centerSamplePos_x;
-
-		chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
-			edgeStartSampleCb,
-			edgeStartSampleCr,
-			reconChromaPicStride,
-			EB_TRUE,
-			cbTc,
-			crTc);
-		//chromaPCMFlagArray);
+		verticalCbTcArray[0] = cbTc;
+		verticalCrTcArray[0] = crTc;
 	}
 	if (bSEdgeAArray[1] > 1) {
 		// Qp for the current CU
@@ -1909,18 +1902,8 @@ static void chroma8x8blkDLFCore16bit(
 		//CHKN
 		cbTc = cbTc << 2;
 		crTc = crTc << 2;
-
-		edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + (centerSamplePos_y - 2) * reconChromaPicStride + centerSamplePos_x;
-		edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + (centerSamplePos_y - 2) * reconChromaPicStride + centerSamplePos_x;
-
-		chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
-			edgeStartSampleCb,
-			edgeStartSampleCr,
-			reconChromaPicStride,
-			EB_TRUE,
-			cbTc,
-			crTc);
-		//chromaPCMFlagArray);
+		verticalCbTcArray[1] = cbTc;
+		verticalCrTcArray[1] = crTc;
 	}
 
 	//vertical edge C filtering
@@ -1959,18 +1942,8 @@ static void chroma8x8blkDLFCore16bit(
 		//CHKN
 		cbTc = cbTc << 2;
 		crTc = crTc << 2;
-
-		edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + centerSamplePos_y * reconChromaPicStride + centerSamplePos_x;
-		edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + centerSamplePos_y * reconChromaPicStride + centerSamplePos_x;
-
-		chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
-			edgeStartSampleCb,
-			edgeStartSampleCr,
-			reconChromaPicStride,
-			EB_TRUE,
-			cbTc,
-			crTc);
-		//chromaPCMFlagArray);
+		verticalCbTcArray[2] = cbTc;
+		verticalCrTcArray[2] = crTc;
 	}
 
 	if (bSEdgeCArray[1] > 1) {
@@ -2006,18 +1979,23 @@ static void chroma8x8blkDLFCore16bit(
 		//CHKN
 		cbTc = cbTc << 2;
 		crTc = crTc << 2;
-		edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + (centerSamplePos_y + 2) * reconChromaPicStride + centerSamplePos_x;
-		edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + (centerSamplePos_y + 2) * reconChromaPicStride + centerSamplePos_x;
+		verticalCbTcArray[3] = cbTc;
+		verticalCrTcArray[3] = crTc;
+	}
 
+	// vertical edges A and C as one 8 sample edge, a zero tc skips the segment
+	// Stepped back from edge C, edge A is off when centerSamplePos_y - 4 would wrap
+	if (bSEdgeAArray[0] > 1 || bSEdgeAArray[1] > 1 || bSEdgeCArray[0] > 1 || bSEdgeCArray[1] > 1) {
+		edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + centerSamplePos_y * reconChromaPicStride + centerSamplePos_x - 4 * reconChromaPicStride;
+		edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + centerSamplePos_y * reconChromaPicStride + centerSamplePos_x - 4 * reconChromaPicStride;
 
-		chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
+		chromaDlf8Sample_funcPtrArray16bit[SSE2_AVX2_SLOT](
 			edgeStartSampleCb,
 			edgeStartSampleCr,
 			reconChromaPicStride,
 			EB_TRUE,
-			cbTc,
-			crTc);
-		//chromaPCMFlagArray);
+			verticalCbTcArray,
+			verticalCrTcArray);
 	}
 
 	//horizontal edge B filtering
@@ -2055,18 +2033,8 @@ static void chroma8x8blkDLFCore16bit(
 		//CHKN
 		cbTc = cbTc << 2;
 		crTc = crTc << 2;
-
-		edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + centerSamplePos_y * reconChromaPicStride + (centerSamplePos_x - 4);
-		edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + centerSamplePos_y * reconChromaPicStride + (centerSamplePos_x - 4);
-
-		chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
-			edgeStartSampleCb,
-			edgeStartSampleCr,
-			reconChromaPicStride,
-			EB_FALSE,
-			cbTc,
-			crTc);
-		//chromaPCMFlagArray);
+		horizontalCbTcArray[0] = cbTc;
+		horizontalCrTcArray[0] = crTc;
 	}
 
 	if (bSEdgeBArray[1] > 1) {
@@ -2103,18 +2071,8 @@ static void chroma8x8blkDLFCore16bit(
 		//CHKN
 		cbTc = cbTc << 2;
 		crTc = crTc << 2;
-		edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + centerSamplePos_y * reconChromaPicStride + (centerSamplePos_x - 2);
-		edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + centerSamplePos_y * reconChromaPicStride + (centerSamplePos_x - 2);
-
-
-		chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
-			edgeStartSampleCb,
-			edgeStartSampleCr,
-			reconChromaPicStride,
-			EB_FALSE,
-			cbTc,
-			crTc);
-		//chromaPCMFlagArray);
+		horizontalCbTcArray[1] = cbTc;
+		horizontalCrTcArray[1] = crTc;
 	}
 
 	//horizontal edge D filtering
@@ -2152,18 +2110,8 @@ static void chroma8x8blkDLFCore16bit(
 		//CHKN
 		cbTc = cbTc << 2;
 		crTc = crTc << 2;
-		edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + centerSamplePos_y * reconChromaPicStride + centerSamplePos_x;
-		edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + centerSamplePos_y * reconChromaPicStride + centerSamplePos_x;
-
-
-		chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
-			edgeStartSampleCb,
-			edgeStartSampleCr,
-			reconChromaPicStride,
-			EB_FALSE,
-			cbTc,
-			crTc);
-		//chromaPCMFlagArray);
+		horizontalCbTcArray[2] = cbTc;
+		horizontalCrTcArray[2] = crTc;
 	}
 
 	if (bSEdgeDArray[1] > 1) {
@@ -2200,17 +2148,22 @@ static void chroma8x8blkDLFCore16bit(
 		//CHKN
 		cbTc = cbTc << 2;
 		crTc = crTc << 2;
-		edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + centerSamplePos_y * reconChromaPicStride + (centerSamplePos_x + 2);
-		edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + centerSamplePos_y * reconChromaPicStride + (centerSamplePos_x + 2);
+		horizontalCbTcArray[3] = cbTc;
+		horizontalCrTcArray[3] = crTc;
+	}
+
+	// horizontal edges B and D as one 8 sample edge
+	if (bSEdgeBArray[0] > 1 || bSEdgeBArray[1] > 1 || bSEdgeDArray[0] > 1 || bSEdgeDArray[1] > 1) {
+		edgeStartSampleCb = (EB_U16*)reconPic->bufferCb + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCb + centerSamplePos_y * reconChromaPicStride + centerSamplePos_x - 4;
+		edgeStartSampleCr = (EB_U16*)reconPic->bufferCr + (reconPic->originX >> subWidthCMinus1) + (reconPic->originY >> subHeightCMinus1) * reconPic->strideCr + centerSamplePos_y * reconChromaPicStride + centerSamplePos_x - 4;
 
-		chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
+		chromaDlf8Sample_funcPtrArray16bit[SSE2_AVX2_SLOT](
 			edgeStartSampleCb,
 			edgeStartSampleCr,
 			reconChromaPicStride,
 			EB_FALSE,
-			cbTc,
-			crTc);
-		//chromaPCMFlagArray);
+			horizontalCbTcArray,
+			horizontalCrTcArray);
 	}
 
 	return;
@@ -2576,6 +2529,11 @@ EB_ERRORTYPE LCUInternalAreaDLFCore16bit(
 	EB_U8  crQp;
 	EB_U8   cbTc;
 	EB_U8   crTc;
+	EB_U32  segmentIndex;
+	EB_S32  lumaTcArray[2];
+	EB_S32  lumaBetaArray[2];
+	EB_U8   cbTcArray[4];
+	EB_U8   crTcArray[4];
 
 	EncodeContext_t        *encodeContextPtr = ((SequenceControlSet_t*)(reconPictureControlSet->sequenceControlSetWrapperPtr->objectPtr))->encodeContextPtr;
 
@@ -2586,12 +2544,16 @@ EB_ERRORTYPE LCUInternalAreaDLFCore16bit(
 
 
 	/***** luma component filtering *****/
-	// filter all vertical edges
+	// filter all vertical edges, two 4 sample edges at a time
 	for (horizontalIdx = 1; horizontalIdx <= numVerticalLumaSampleEdges; ++horizontalIdx) {
 		for (verticalIdx = 1; verticalIdx <= num4SampleEdgesPerVerticalLumaSampleEdge; ++verticalIdx) {
 			// edge A
 			fourSampleEdgeStartSamplePos_x = horizontalIdx << 3;   // LCU-wise position
 			fourSampleEdgeStartSamplePos_y = verticalIdx << 2;     // LCU-wise position
+			segmentIndex = (verticalIdx - 1) & 1;
+			if (segmentIndex == 0) {
+				lumaBetaArray[0] = lumaBetaArray[1] = 0;
+			}
 			blk4x4Addr = GET_LUMA_4X4BLK_ADDR(
 				fourSampleEdgeStartSamplePos_x,
 				fourSampleEdgeStartSamplePos_y,
@@ -2630,25 +2592,34 @@ EB_ERRORTYPE LCUInternalAreaDLFCore16bit(
 				lumaTc = lumaTc << 2;
 				Beta = Beta << 2;
 
-				edgeStartFilteredSamplePtr = (EB_U16*)reconpicture->bufferY + reconpicture->originX + reconpicture->originY * reconpicture->strideY + (fourSampleEdgeStartSamplePos_y + lcuPos_y) * reconpicture->strideY + fourSampleEdgeStartSamplePos_x + lcuPos_x;
+				lumaTcArray[segmentIndex] = lumaTc;
+				lumaBetaArray[segmentIndex] = Beta;
+			}
 
-				// 4 sample edge DLF core
-				lumaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
+			if ((segmentIndex == 1 || verticalIdx == num4SampleEdgesPerVerticalLumaSampleEdge) && (lumaBetaArray[0] || lumaBetaArray[1])) {
+				edgeStartFilteredSamplePtr = (EB_U16*)reconpicture->bufferY + reconpicture->originX + reconpicture->originY * reconpicture->strideY + (fourSampleEdgeStartSamplePos_y - (segmentIndex << 2) + lcuPos_y) * reconpicture->strideY + fourSampleEdgeStartSamplePos_x + lcuPos_x;
+
+				// 8 sample edge DLF core
+				lumaDlf8Sample_funcPtrArray16bit[SSE2_AVX2_SLOT](
 					edgeStartFilteredSamplePtr,
 					reconpicture->strideY,
 					EB_TRUE,
-					lumaTc,
-					Beta);
+					lumaTcArray,
+					lumaBetaArray);
 			}
 		}
 	}
 
-	// filter all horizontal edges
+	// filter all horizontal edges, two 4 sample edges at a time
 	for (verticalIdx = 1; verticalIdx <= numHorizontalLumaSampleEdges; ++verticalIdx) {
 		for (horizontalIdx = 1; horizontalIdx <= num4SampleEdgesPerHorizontalLumaSampleEdge; ++horizontalIdx) {
 			// edge B
 			fourSampleEdgeStartSamplePos_x = horizontalIdx << 2;    // LCU-wise position
 			fourSampleEdgeStartSamplePos_y = verticalIdx << 3;      // LCU-wise position
+			segmentIndex = (horizontalIdx - 1) & 1;
+			if (segmentIndex == 0) {
+				lumaBetaArray[0] = lumaBetaArray[1] = 0;
+			}
 			blk4x4Addr = GET_LUMA_4X4BLK_ADDR(
 				fourSampleEdgeStartSamplePos_x,
 				fourSampleEdgeStartSamplePos_y,
@@ -2685,25 +2656,35 @@ EB_ERRORTYPE LCUInternalAreaDLFCore16bit(
 				//CHKN
 				lumaTc = lumaTc << 2;
 				Beta = Beta << 2;
-				edgeStartFilteredSamplePtr = (EB_U16*)reconpicture->bufferY + reconpicture->originX + reconpicture->originY * reconpicture->strideY + (fourSampleEdgeStartSamplePos_y + lcuPos_y) * reconpicture->strideY + fourSampleEdgeStartSamplePos_x + lcuPos_x;
+				lumaTcArray[segmentIndex] = lumaTc;
+				lumaBetaArray[segmentIndex] = Beta;
+			}
 
-				// 4 sample edge DLF core
-				lumaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
+			if ((segmentIndex == 1 || horizontalIdx == num4SampleEdgesPerHorizontalLumaSampleEdge) && (lumaBetaArray[0] || lumaBetaArray[1])) {
+				edgeStartFilteredSamplePtr = (EB_U16*)reconpicture->bufferY + reconpicture->originX + reconpicture->originY * reconpicture->strideY + (fourSampleEdgeStartSamplePos_y + lcuPos_y) * reconpicture->strideY + fourSampleEdgeStartSamplePos_x - (segmentIndex << 2) + lcuPos_x;
+
+				// 8 sample edge DLF core
+				lumaDlf8Sample_funcPtrArray16bit[SSE2_AVX2_SLOT](
 					edgeStartFilteredSamplePtr,
 					reconpicture->strideY,
 					EB_FALSE,
-					lumaTc,
-					Beta);
+					lumaTcArray,
+					lumaBetaArray);
 			}
 		}
 	}
 
 	/***** chroma component filtering ****/
-	// filter all vertical edges
+	// filter all vertical edges, four 2 sample edges at a time
 	for (horizontalIdx = 1; horizontalIdx <= numVerticalChromaSampleEdges; ++horizontalIdx) {
 		for (verticalIdx = 1; verticalIdx <= num2SampleEdgesPerVerticalChromaSampleEdge; ++verticalIdx) {
 			twoSampleEdgeStartSamplePos_x = horizontalIdx << 3;          // LCU-wise position
 			twoSampleEdgeStartSamplePos_y = (verticalIdx << 1) + 2;      // LCU-wise position
+			segmentIndex = (verticalIdx - 1) & 3;
+			if (segmentIndex == 0) {
+				EB_MEMSET(cbTcArray, 0, sizeof(cbTcArray));
+				EB_MEMSET(crTcArray, 0, sizeof(crTcArray));
+			}
 			blk2x2Addr = GET_CHROMA_4X4BLK_ADDR(
 				twoSampleEdgeStartSamplePos_x >> subWidthShfitMinus1,
 				twoSampleEdgeStartSamplePos_y >> subHeightShfitMinus1,
@@ -2743,27 +2724,35 @@ EB_ERRORTYPE LCUInternalAreaDLFCore16bit(
 				//CHKN
 				cbTc = cbTc << 2;
 				crTc = crTc << 2;
-				edgeStartSampleCb = (EB_U16*)reconpicture->bufferCb + (reconpicture->originX >> subWidthCMinus1) + (reconpicture->originY >> subHeightCMinus1) * reconpicture->strideCb + (twoSampleEdgeStartSamplePos_y + chromaLcuPos_y) * reconpicture->strideCb + (twoSampleEdgeStartSamplePos_x + chromaLcuPos_x);
-				edgeStartSampleCr = (EB_U16*)reconpicture->bufferCr + (reconpicture->originX >> subWidthCMinus1) + (reconpicture->originY >> subHeightCMinus1) * reconpicture->strideCr + (twoSampleEdgeStartSamplePos_y + chromaLcuPos_y) * reconpicture->strideCr + (twoSampleEdgeStartSamplePos_x + chromaLcuPos_x);
+				cbTcArray[segmentIndex] = cbTc;
+				crTcArray[segmentIndex] = crTc;
+			}
 
+			if (segmentIndex == 3 || verticalIdx == num2SampleEdgesPerVerticalChromaSampleEdge) {
+				edgeStartSampleCb = (EB_U16*)reconpicture->bufferCb + (reconpicture->originX >> subWidthCMinus1) + (reconpicture->originY >> subHeightCMinus1) * reconpicture->strideCb + (twoSampleEdgeStartSamplePos_y - (segmentIndex << 1) + chromaLcuPos_y) * reconpicture->strideCb + (twoSampleEdgeStartSamplePos_x + chromaLcuPos_x);
+				edgeStartSampleCr = (EB_U16*)reconpicture->bufferCr + (reconpicture->originX >> subWidthCMinus1) + (reconpicture->originY >> subHeightCMinus1) * reconpicture->strideCr + (twoSampleEdgeStartSamplePos_y - (segmentIndex << 1) + chromaLcuPos_y) * reconpicture->strideCr + (twoSampleEdgeStartSamplePos_x + chromaLcuPos_x);
 
-				chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
+				chromaDlf8Sample_funcPtrArray16bit[SSE2_AVX2_SLOT](
 					edgeStartSampleCb,
 					edgeStartSampleCr,
 					reconpicture->strideCb,
 					EB_TRUE,
-					cbTc,
-					crTc);
-				//chromaPCMFlagArray);
+					cbTcArray,
+					crTcArray);
 			}
 		}
 	}
 
-	// filter all horizontal edges
+	// filter all horizontal edges, four 2 sample edges at a time
 	for (verticalIdx = 1; verticalIdx <= numHorizontalChromaSampleEdges; ++verticalIdx) {
 		for (horizontalIdx = 1; horizontalIdx <= num2SampleEdgesPerHorizontalChromaSampleEdge; ++horizontalIdx) {
 			twoSampleEdgeStartSamplePos_x = (horizontalIdx << 1) + 2;    // LCU-wise position
 			twoSampleEdgeStartSamplePos_y = verticalIdx << 3;            // LCU-wise position
+			segmentIndex = (horizontalIdx - 1) & 3;
+			if (segmentIndex == 0) {
+				EB_MEMSET(cbTcArray, 0, sizeof(cbTcArray));
+				EB_MEMSET(crTcArray, 0, sizeof(crTcArray));
+			}
 			blk2x2Addr = GET_CHROMA_4X4BLK_ADDR(
 				twoSampleEdgeStartSamplePos_x >> subWidthShfitMinus1,
 				twoSampleEdgeStartSamplePos_y >> subHeightShfitMinus1,
@@ -2803,17 +2792,21 @@ EB_ERRORTYPE LCUInternalAreaDLFCore16bit(
 				//CHKN
 				cbTc = cbTc << 2;
 				crTc = crTc << 2;
-				edgeStartSampleCb = (EB_U16*)reconpicture->bufferCb + (reconpicture->originX >> subWidthCMinus1) + (reconpicture->originY >> subHeightCMinus1) * reconpicture->strideCb + (twoSampleEdgeStartSamplePos_y + chromaLcuPos_y) * reconpicture->strideCb + (twoSampleEdgeStartSamplePos_x + chromaLcuPos_x);
-				edgeStartSampleCr = (EB_U16*)reconpicture->bufferCr + (reconpicture->originX >> subWidthCMinus1) + (reconpicture->originY >> subHeightCMinus1) * reconpicture->strideCr + (twoSampleEdgeStartSamplePos_y + chromaLcuPos_y) * reconpicture->strideCr + (twoSampleEdgeStartSamplePos_x + chromaLcuPos_x);
+				cbTcArray[segmentIndex] = cbTc;
+				crTcArray[segmentIndex] = crTc;
+			}
 
-				chromaDlf_funcPtrArray16bit[!!(ASM_TYPES & PREAVX2_MASK)](
+			if (segmentIndex == 3 || horizontalIdx == num2SampleEdgesPerHorizontalChromaSampleEdge) {
+				edgeStartSampleCb = (EB_U16*)reconpicture->bufferCb + (reconpicture->originX >> subWidthCMinus1) + (reconpicture->originY >> subHeightCMinus1) * reconpicture->strideCb + (twoSampleEdgeStartSamplePos_y + chromaLcuPos_y) * reconpicture->strideCb + (twoSampleEdgeStartSamplePos_x - (segmentIndex << 1) + chromaLcuPos_x);
+				edgeStartSampleCr = (EB_U16*)reconpicture->bufferCr + (reconpicture->originX >> subWidthCMinus1) + (reconpicture->originY >> subHeightCMinus1) * reconpicture->strideCr + (twoSampleEdgeStartSamplePos_y + chromaLcuPos_y) * reconpicture->strideCr + (twoSampleEdgeStartSamplePos_x - (segmentIndex << 1) + chromaLcuPos_x);
+
+				chromaDlf8Sample_funcPtrArray16bit[SSE2_AVX2_SLOT](
 					edgeStartSampleCb,
 					edgeStartSampleCr,
 					reconpicture->strideCb,
 					EB_FALSE,
-					cbTc,
-					crTc);
-				//chromaPCMFlagArray);
+					cbTcArray,
+					crTcArray);
 			}
 		}
 	}
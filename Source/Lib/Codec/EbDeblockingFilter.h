@@ -9,6 +9,7 @@
 #include "EbDeblockingFilter_C.h"
 #include "EbDeblockingFilter_SSE2.h"
 #include "EbDeblockingFilter_SSSE3.h"
+#include "EbDeblockingFilter_AVX2.h"
 #include "EbPredictionUnit.h"
 #include "EbNeighborArrays.h"
 
@@ -239,6 +240,23 @@ typedef void(*EB_LUMADLF_TYPE_16BIT)(
     EB_S32          tc,
     EB_S32          beta);
 
+// The 8 sample edge kernels filter the segments of an 8 sample edge together,
+// each segment with its own thresholds
+typedef void(*EB_CHROMADLF8SAMPLE_TYPE_16BIT)(
+    EB_U16				  *edgeStartSampleCb,
+    EB_U16				  *edgeStartSampleCr,
+    EB_U32                 reconChromaPicStride,
+    EB_BOOL                isVerticalEdge,
+    EB_U8                 *cbTcArray,
+    EB_U8                 *crTcArray);
+
+typedef void(*EB_LUMADLF8SAMPLE_TYPE_16BIT)(
+    EB_U16         *edgeStartFilteredSamplePtr,
+    EB_U32          reconLumaPicStride,
+    EB_BOOL         isVerticalEdge,
+    EB_S32         *tcArray,
+    EB_S32         *betaArray);
+
 /***************************************
 * Function Ptr Types
 ***************************************/
@@ -261,17 +279,35 @@ static EB_CHROMA2SAMPLEDGEDLF_FUNC FUNC_TABLE Chroma2SampleEdgeDLFCore_Table[EB_
 static EB_CHROMADLF_TYPE_16BIT FUNC_TABLE chromaDlf_funcPtrArray16bit[EB_ASM_TYPE_TOTAL] = {
     // C_DEFAULT
     Chroma2SampleEdgeDLFCore16bit,
-    // AVX2
+    // SSE2
     Chroma2SampleEdgeDLFCore16bit_SSE2_INTRIN,
 };
 
 static EB_LUMADLF_TYPE_16BIT FUNC_TABLE lumaDlf_funcPtrArray16bit[EB_ASM_TYPE_TOTAL] = {
     // C_DEFAULT
     Luma4SampleEdgeDLFCore16bit,
-    // AVX2
+    // SSSE3
     Luma4SampleEdgeDLFCore16bit_SSSE3_INTRIN,
 };
 
+static EB_CHROMADLF8SAMPLE_TYPE_16BIT FUNC_TABLE chromaDlf8Sample_funcPtrArray16bit[EB_ASM_SSE2_AVX2_TYPE_TOTAL] = {
+    // C_DEFAULT
+    Chroma8SampleEdgeDLFCore16bit,
+    // SSE2
+    Chroma8SampleEdgeDLFCore16bit_SSE2_INTRIN,
+    // AVX2
+    Chroma8SampleEdgeDLFCore16bit_AVX2_INTRIN,
+};
+
+static EB_LUMADLF8SAMPLE_TYPE_16BIT FUNC_TABLE lumaDlf8Sample_funcPtrArray16bit[EB_ASM_SSE2_AVX2_TYPE_TOTAL] = {
+    // C_DEFAULT
+    Luma8SampleEdgeDLFCore16bit,
+    // SSSE3
+    Luma8SampleEdgeDLFCore16bit_SSSE3_INTRIN,
+    // AVX2
+    Luma8SampleEdgeDLFCore16bit_AVX2_INTRIN,
+};
+
 #ifdef __cplusplus
 }
 #endif
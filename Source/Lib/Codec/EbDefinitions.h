@@ -13,9 +13,13 @@ extern "C" {
 
 //#define BENCHMARK 0
 #define LATENCY_PROFILE 0
+#ifndef LOCK_FREE_FIFO
+#define LOCK_FREE_FIFO 1 // Set by the LOCK_FREE_FIFO CMake option
+#endif
+#define MEMORY_ARENA 1 // Back the EB_MALLOC family with per-instance arena blocks
 //#define DEBUG_LIFE_CYCLE 0
 // Internal Marcos
-#define NON_AVX512_SUPPORT
+// NON_AVX512_SUPPORT is set when the AVX512 CMake option is off
 
 #ifdef __cplusplus
 #define EB_EXTERN extern "C"
@@ -85,6 +89,20 @@ extern "C" {
 #endif
 #endif
 
+// The initial-exec TLS model reads a thread local with one %fs relative
+// load instead of a __tls_get_addr call per function that touches it. A
+// library loaded with dlopen() takes its initial-exec variables from the
+// surplus static TLS that the loader reserves for that purpose; the
+// encoder keeps under 32 bytes there. EB_HIDDEN keeps the thread locals
+// shared between translation units out of the dynamic symbol table.
+#ifdef	_MSC_VER
+#define EB_THREAD_LOCAL         __declspec(thread)
+#define EB_HIDDEN
+#else
+#define EB_THREAD_LOCAL         __thread __attribute__((tls_model("initial-exec")))
+#define EB_HIDDEN               __attribute__((visibility("hidden")))
+#endif
+
 #define INPUT_SIZE_576p_TH				0x90000     // 0.58 Million
 #define INPUT_SIZE_1080i_TH				0xB71B0     // 0.75 Million
 #define INPUT_SIZE_1080p_TH				0x1AB3F0    // 1.75 Million
@@ -202,7 +220,9 @@ typedef enum EbPtrType{
 	EB_A_PTR = 1,                                   // malloc'd pointer aligned
 	EB_MUTEX = 2,                                   // mutex
 	EB_SEMAPHORE = 3,                                   // semaphore
-	EB_THREAD = 4                                    // thread handle
+	EB_THREAD = 4,                                   // thread handle
+	EB_APP_PTR = 5,                                  // output stream buffer from the application allocator
+	EB_HUGE_PTR = 6                                  // arena block mapped on huge pages, see EbArenaFreeHugeBlock
 }EbPtrType;
 
 /** The EB_PTR type is intended to be used to pass pointers to and from the svt
@@ -361,11 +381,28 @@ typedef EB_U8 EB_MODETYPE;
 
 #define PREAVX2_MASK    1
 #define AVX2_MASK       2
-#ifndef NON_AVX512_SUPPORT
 #define AVX512_MASK     4
-#endif
 #define ASM_AVX2_BIT    3
 
+// The function tables of the kernels that have an AVX512 version carry it
+// in a third slot, after the C_DEFAULT and AVX2 slots. AVX512_SLOT selects
+// it on AVX512 capable instances and the call site's usual slot otherwise.
+#define EB_ASM_AVX512               2
+#define EB_ASM_AVX512_TYPE_TOTAL    3
+#ifndef NON_AVX512_SUPPORT
+#define AVX512_SLOT(avx2Slot)       ((ASM_TYPES & AVX512_MASK) ? EB_ASM_AVX512 : (avx2Slot))
+#else
+#define AVX512_SLOT(avx2Slot)       (avx2Slot)
+#endif
+
+// The function tables of the 16 bit kernels that have both an SSE2 and an
+// AVX2 version carry them in separate slots, after the C_DEFAULT slot.
+// SSE2_AVX2_SLOT selects the highest one the instance supports.
+#define EB_ASM_SSE2                 1
+#define EB_ASM_AVX2                 2
+#define EB_ASM_SSE2_AVX2_TYPE_TOTAL 3
+#define SSE2_AVX2_SLOT              ((ASM_TYPES & AVX2_MASK) ? EB_ASM_AVX2 : !!(ASM_TYPES & PREAVX2_MASK))
+
 #define BIT(nr)         (1UL << (nr))
 
 /** INTRA_4x4 offsets
@@ -373,7 +410,9 @@ typedef EB_U8 EB_MODETYPE;
 static const EB_U8 INTRA_4x4_OFFSET_X[4] = { 0, 4, 0, 4 };
 static const EB_U8 INTRA_4x4_OFFSET_Y[4] = { 0, 0, 4, 4 };
 
-extern EB_U32 ASM_TYPES;
+// Assembly level of the encoder instance the calling thread works for.
+// Set by the API entry points and inherited by the encoder threads.
+extern EB_HIDDEN EB_THREAD_LOCAL EB_U32 ASM_TYPES;
 
 /** Depth offsets
 */
@@ -517,36 +556,99 @@ typedef void * EB_HANDLE;
 
 #define ALVALUE                     32
 
-extern    EbMemoryMapEntry        *memoryMap;               // library Memory table
-extern    EB_U32                  *memoryMapIndex;          // library memory index
-extern    EB_U64                  *totalLibMemory;          // library Memory malloc'd
+#define EB_ARENA_BLOCK_SIZE         (4 << 20)   // Size of the blocks small allocations are carved from
+#define EB_ARENA_DEDICATED_SIZE     (256 << 10) // Allocations from this size on get a block of their own
+#define EB_ARENA_CACHE_LINE_SIZE    64
+#define EB_ARENA_PAGE_SIZE          4096
+#define EB_ARENA_HUGE_PAGE_SIZE     (2 << 20)   // Dedicated blocks from this size on may be mapped on huge pages
 
-extern    EB_U32                   libMallocCount;
-extern    EB_U32                   libThreadCount;
-extern    EB_U32                   libSemaphoreCount;
-extern    EB_U32                   libMutexCount;
+// Huge page modes of the dedicated arena blocks
+#define EB_HUGE_PAGES_OFF           0
+#define EB_HUGE_PAGES_TRANSPARENT   1           // madvise(MADV_HUGEPAGE)
+#define EB_HUGE_PAGES_EXPLICIT      2           // MAP_HUGETLB, transparent when the reserved pages run out
 
+/** The EbMemorySubsystem type identifies the part of the encoder that
+allocations are charged to in the memory usage report.
+*/
+typedef enum EbMemorySubsystem {
+    EB_MEMORY_ENCODER_HANDLE = 0,
+    EB_MEMORY_SEQUENCE_CONTROL_SET,
+    EB_MEMORY_PICTURE_CONTROL_SET,
+    EB_MEMORY_PICTURE_BUFFERS,
+    EB_MEMORY_SYSTEM_RESOURCES,
+    EB_MEMORY_PROCESS_CONTEXTS,
+    EB_MEMORY_SUBSYSTEM_COUNT
+} EbMemorySubsystem;
+
+/** EbMemoryContext_t holds the allocation bookkeeping of one encoder
+instance. It lives in EbEncHandle_t; memoryContextPtr points the EB_MALLOC
+family at it for the thread running an API entry point and for the threads
+that instance creates.
+*/
+typedef struct EbMemoryContext_s
+{
+    EbMemoryMapEntry         *memoryMap;                 // library Memory table
+    EB_U32                    memoryMapIndex;            // library memory index
+    EB_U64                    totalLibMemory;            // library Memory malloc'd
+
+    EB_U32                    libMallocCount;
+    EB_U32                    libThreadCount;
+    EB_U32                    libSemaphoreCount;
+    EB_U32                    libMutexCount;
+
+    // Arena
+    EB_U8                    *arenaBlockPtr;             // block small allocations are carved from
+    EB_U64                    arenaBlockOffset;          // first free byte of arenaBlockPtr
+    EB_U64                    arenaReservedMemory;       // bytes of all arena blocks
+    EB_U32                    arenaBlockCount;
+    EbMemorySubsystem         subsystem;                 // subsystem new allocations are charged to
+    EB_U64                    subsystemMemory[EB_MEMORY_SUBSYSTEM_COUNT];
+    EB_U8                     hugePages;                 // EB_HUGE_PAGES_* mode of new dedicated blocks
+    EB_U64                    arenaExplicitHugeMemory;   // bytes of the blocks on MAP_HUGETLB pages
+    EB_U64                    arenaTransparentHugeMemory;// bytes of the blocks advised to transparent huge pages
+} EbMemoryContext_t;
+
+extern EB_HIDDEN EB_THREAD_LOCAL EbMemoryContext_t *memoryContextPtr;
+
+extern void* EbArenaAlloc(
+    EbMemoryContext_t        *contextPtr,
+    EB_U64                    size,
+    EB_U64                    alignment);
+
+extern void EbArenaFreeHugeBlock(
+    EB_PTR                    hugeBlockPtr);
+
+extern void EbArenaPrintUsage(
+    EbMemoryContext_t        *contextPtr);
+
+#if MEMORY_ARENA
+#define EB_ALLIGN_MALLOC(type, pointer, nElements, pointerClass) \
+    pointer = (type) EbArenaAlloc(memoryContextPtr, (EB_U64)(nElements), ALVALUE); \
+    if (pointer == (type)EB_NULL) { \
+        return EB_ErrorInsufficientResources; \
+    } \
+    memoryContextPtr->libMallocCount++;
 
-#ifdef _WIN32
+#elif defined(_WIN32)
 #define EB_ALLIGN_MALLOC(type, pointer, nElements, pointerClass) \
     pointer = (type) _aligned_malloc(nElements,ALVALUE); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
 	    } \
 	    else { \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = pointerClass; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = pointer; \
 		if (nElements % 8 == 0) { \
-			*totalLibMemory += (nElements); \
+			memoryContextPtr->totalLibMemory += (nElements); \
 		} \
 		else { \
-			*totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
+			memoryContextPtr->totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
 		} \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) { \
         return EB_ErrorInsufficientResources; \
     } \
-    libMallocCount++;
+    memoryContextPtr->libMallocCount++;
 
 #else
 #define EB_ALLIGN_MALLOC(type, pointer, nElements, pointerClass) \
@@ -555,19 +657,19 @@ extern    EB_U32                   libMutexCount;
     	    } \
         	    else { \
         pointer = (type) pointer;  \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = pointerClass; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = pointer; \
 		if (nElements % 8 == 0) { \
-			*totalLibMemory += (nElements); \
+			memoryContextPtr->totalLibMemory += (nElements); \
         		} \
         		else { \
-			*totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
+			memoryContextPtr->totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
 		} \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) { \
         return EB_ErrorInsufficientResources; \
         } \
-    libMallocCount++;
+    memoryContextPtr->libMallocCount++;
 #endif
 
 // Debug Macros
@@ -589,31 +691,48 @@ extern    EB_U32                   libMutexCount;
 #endif
 
 #define EB_MEMORY() \
-    SVT_LOG("Total Number of Mallocs in Library: %d\n", libMallocCount); \
-    SVT_LOG("Total Number of Threads in Library: %d\n", libThreadCount); \
-    SVT_LOG("Total Number of Semaphore in Library: %d\n", libSemaphoreCount); \
-    SVT_LOG("Total Number of Mutex in Library: %d\n", libMutexCount); \
-    SVT_LOG("Total Library Memory: %.2lf KB\n\n",*totalLibMemory/(double)1024);
+    SVT_LOG("Total Number of Mallocs in Library: %d\n", memoryContextPtr->libMallocCount); \
+    SVT_LOG("Total Number of Threads in Library: %d\n", memoryContextPtr->libThreadCount); \
+    SVT_LOG("Total Number of Semaphore in Library: %d\n", memoryContextPtr->libSemaphoreCount); \
+    SVT_LOG("Total Number of Mutex in Library: %d\n", memoryContextPtr->libMutexCount); \
+    SVT_LOG("Total Library Memory: %.2lf KB\n\n",memoryContextPtr->totalLibMemory/(double)1024); \
+    EbArenaPrintUsage(memoryContextPtr);
+
+#if MEMORY_ARENA
+#define EB_MALLOC(type, pointer, nElements, pointerClass) \
+    pointer = (type) EbArenaAlloc(memoryContextPtr, (EB_U64)(nElements), 1); \
+    if (pointer == (type)EB_NULL) { \
+        return EB_ErrorInsufficientResources; \
+    } \
+    memoryContextPtr->libMallocCount++;
 
+// Arena blocks are zeroed when they are obtained
+#define EB_CALLOC(type, pointer, count, size, pointerClass) \
+    pointer = (type) EbArenaAlloc(memoryContextPtr, (EB_U64)(count) * (size), 1); \
+    if (pointer == (type)EB_NULL) { \
+        return EB_ErrorInsufficientResources; \
+    } \
+    memoryContextPtr->libMallocCount++;
+#else
 #define EB_MALLOC(type, pointer, nElements, pointerClass) \
     pointer = (type) malloc(nElements); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
 	    } \
 	    else { \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = pointerClass; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = pointer; \
 		if (nElements % 8 == 0) { \
-			*totalLibMemory += (nElements); \
+			memoryContextPtr->totalLibMemory += (nElements); \
 		} \
 		else { \
-			*totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
+			memoryContextPtr->totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
 		} \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) { \
         return EB_ErrorInsufficientResources; \
     } \
-    libMallocCount++;
+    memoryContextPtr->libMallocCount++;
 
 #define EB_CALLOC(type, pointer, count, size, pointerClass) \
     pointer = (type) calloc(count, size); \
@@ -621,19 +740,20 @@ extern    EB_U32                   libMutexCount;
         return EB_ErrorInsufficientResources; \
     } \
     else { \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = pointerClass; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = pointer; \
 		if (count % 8 == 0) { \
-			*totalLibMemory += (count); \
+			memoryContextPtr->totalLibMemory += (count); \
 		} \
 		else { \
-			*totalLibMemory += ((count) + (8 - ((count) % 8))); \
+			memoryContextPtr->totalLibMemory += ((count) + (8 - ((count) % 8))); \
 		} \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) { \
         return EB_ErrorInsufficientResources; \
     } \
-    libMallocCount++;
+    memoryContextPtr->libMallocCount++;
+#endif
 
 #define EB_CREATESEMAPHORE(type, pointer, nElements, pointerClass, initialCount, maxCount) \
     pointer = EbCreateSemaphore(initialCount, maxCount); \
@@ -641,19 +761,19 @@ extern    EB_U32                   libMutexCount;
         return EB_ErrorInsufficientResources; \
     } \
     else { \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = pointerClass; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = pointer; \
 		if (nElements % 8 == 0) { \
-			*totalLibMemory += (nElements); \
+			memoryContextPtr->totalLibMemory += (nElements); \
 		} \
 		else { \
-			*totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
+			memoryContextPtr->totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
 		} \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) { \
         return EB_ErrorInsufficientResources; \
     } \
-    libSemaphoreCount++;
+    memoryContextPtr->libSemaphoreCount++;
 
 #define EB_CREATEMUTEX(type, pointer, nElements, pointerClass) \
     pointer = EbCreateMutex(); \
@@ -661,19 +781,19 @@ extern    EB_U32                   libMutexCount;
         return EB_ErrorInsufficientResources; \
     } \
     else { \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = pointerClass; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = pointer; \
 		if (nElements % 8 == 0) { \
-			*totalLibMemory += (nElements); \
+			memoryContextPtr->totalLibMemory += (nElements); \
 		} \
 		else { \
-			*totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
+			memoryContextPtr->totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
 		} \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) { \
         return EB_ErrorInsufficientResources; \
     } \
-    libMutexCount++;
+    memoryContextPtr->libMutexCount++;
 
 #define EB_STRDUP(dst, src) \
     EB_MALLOC_(char*, dst, strlen(src)+1, EB_N_PTR); \
@@ -967,6 +1087,7 @@ typedef enum EB_SEI {
 #define MAX_NUM_OF_TU_PER_CU                        21
 #define MIN_NUM_OF_TU_PER_CU                        5
 #define MAX_LCU_ROWS                                ((MAX_PICTURE_HEIGHT_SIZE) / (MAX_LCU_SIZE))
+#define SUB_PICTURE_REF_LCU_ROW_MARGIN              2 // LCU rows below the current row a MV may reach in sub-picture reference mode
 
 #define MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE       ((MAX_PICTURE_WIDTH_SIZE + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE) * \
                                                    ((MAX_PICTURE_HEIGHT_SIZE + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE)
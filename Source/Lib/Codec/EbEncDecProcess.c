@@ -56,6 +56,8 @@ EB_ERRORTYPE EncDecContextCtor(
 
     contextPtr->is16bit = is16bit;
     contextPtr->colorFormat = colorFormat;
+    EB_MEMSET(&contextPtr->numaState, 0, sizeof(EbNumaThreadState_t));
+    contextPtr->numaState.partition = EB_NUMA_NO_PARTITION;
 
     // Input/Output System Resource Manager FIFOs
     contextPtr->modeDecisionInputFifoPtr = modeDecisionConfigurationInputFifoPtr;
@@ -511,22 +513,28 @@ static EB_ERRORTYPE ApplySaoOffsetsLcu(
 }
 
 /********************************************
- * ApplySaoOffsetsPicture
- *   applies SAO for the whole Picture
+ * ApplySaoOffsetsLcuRow
+ *   applies SAO for one LCU row of the Picture
+ *   Rows are filtered in order from the top of the picture.
+ *   Each row saves its unfiltered last line for the row below,
+ *   and reads the first line of the row below before that row
+ *   is filtered.
  ********************************************/
-static EB_ERRORTYPE ApplySaoOffsetsPicture(
+static EB_ERRORTYPE ApplySaoOffsetsLcuRow(
     EncDecContext_t         *contextPtr,             // input parameter, DLF context Ptr, used to store the intermediate source samples
     SequenceControlSet_t    *sequenceControlSetPtr,  // input parameter, Sequence control set Ptr
-    PictureControlSet_t     *pictureControlSetPtr)   // input/output parameter, picture Control Set Ptr, used to get/update recontructed samples
+    PictureControlSet_t     *pictureControlSetPtr,   // input/output parameter, picture Control Set Ptr, used to get/update recontructed samples
+    EB_U32                   lcuRowIndex)            // input parameter, LCU row to filter
 {
     EB_ERRORTYPE    return_error = EB_ErrorNone;
 
     EB_U32 lcuNumberInWidth;
-    EB_U32 lcuNumberInHeight;
 
     EB_U32 pictureWidthInLcu = (sequenceControlSetPtr->lumaWidth + sequenceControlSetPtr->lcuSize - 1) / sequenceControlSetPtr->lcuSize;
     EB_U32 pictureHeightInLcu = (sequenceControlSetPtr->lumaHeight + sequenceControlSetPtr->lcuSize - 1) / sequenceControlSetPtr->lcuSize;
+    EB_BOOL lastRowFlag = (EB_BOOL)(lcuRowIndex + 1 == pictureHeightInLcu);
 
+    EB_U32 componentIndex;
     EB_U32 lcuIndex;
     EB_U32 lcuRow;
     EB_U32 lcuWidth;
@@ -535,13 +543,8 @@ static EB_ERRORTYPE ApplySaoOffsetsPicture(
     EB_U32 tbOriginX;
     EB_U32 tbOriginY;
 
-    EB_U32 reconSampleLumaIndex;
-    EB_U32 reconSampleChromaIndex;
-    EB_U8 *reconSampleYPtr;
-    EB_U8 *reconSampleCbPtr;
-    EB_U8 *reconSampleCrPtr;
+    EB_U32 reconSampleIndex;
 
-    EB_U8 pingpongIdxUp = 0;
     EB_U8 pingpongIdxLeft = 0;
 
     SaoParameters_t *saoParams;
@@ -554,198 +557,81 @@ static EB_ERRORTYPE ApplySaoOffsetsPicture(
     const EB_COLOR_FORMAT colorFormat = reconPicturePtr->colorFormat;    // Chroma format
     const EB_U16 subWidthCMinus1 = (colorFormat == EB_YUV444 ? 1 : 2) - 1;
     const EB_U16 subHeightCMinus1 = (colorFormat >= EB_YUV422 ? 1 : 2) - 1;
-    // Apply SAO
 
-    // Y
-    if (pictureControlSetPtr->saoFlag[0]) {
+    // Apply SAO, Y then U and V
+    for (componentIndex = 0; componentIndex < 3; ++componentIndex) {
 
-        lcuIndex = 0;
-        for (lcuNumberInHeight = 0; lcuNumberInHeight < pictureHeightInLcu; ++lcuNumberInHeight) {
+        const EB_U32 isChroma = (componentIndex == 0) ? 0 : 1;
+        const EB_U16 shiftX = isChroma ? subWidthCMinus1 : 0;
+        const EB_U16 shiftY = isChroma ? subHeightCMinus1 : 0;
+        const EB_U32 componentWidth = isChroma ? sequenceControlSetPtr->chromaWidth : sequenceControlSetPtr->lumaWidth;
+        const EB_U32 componentHeight = isChroma ? sequenceControlSetPtr->chromaHeight : sequenceControlSetPtr->lumaHeight;
+        EB_U8 *reconBufferPtr = (componentIndex == 0) ? reconPicturePtr->bufferY : (componentIndex == 1) ? reconPicturePtr->bufferCb : reconPicturePtr->bufferCr;
+        EB_U32 reconStride = (componentIndex == 0) ? reconPicturePtr->strideY : (componentIndex == 1) ? reconPicturePtr->strideCb : reconPicturePtr->strideCr;
+        EB_U8 *savedLastLinePtr = pictureControlSetPtr->saoRowLastLineArray[componentIndex];
+        EB_U8 *rowFirstLinePtr;
 
-            for (lcuNumberInWidth = 0; lcuNumberInWidth < pictureWidthInLcu; ++lcuNumberInWidth, ++lcuIndex) {
-
-                LcuParams_t *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
-
-                tbOriginX = lcuParams->originX;
-                tbOriginY = lcuParams->originY;
-
-                lcuWidth = lcuParams->width;
-                lcuHeight = lcuParams->height;
-
-                saoParams = &pictureControlSetPtr->lcuPtrArray[lcuIndex]->saoParams;
-                reconSampleLumaIndex = (reconPicturePtr->originY + tbOriginY) * reconPicturePtr->strideY + reconPicturePtr->originX + tbOriginX;
-
-                if (tbOriginX == 0) {
-
-                    reconSampleYPtr = &(reconPicturePtr->bufferY[reconSampleLumaIndex]) + (lcuHeight - 1)*reconPicturePtr->strideY;
-
-                    //Save last pixel row of this LCU row for next LCU row
-                    EB_MEMCPY(contextPtr->saoUpBuffer[pingpongIdxUp], reconSampleYPtr, sizeof(EB_U8) * sequenceControlSetPtr->lumaWidth);
-
-                }
-
-                lcuHeightPlusOne = (sequenceControlSetPtr->lumaHeight == tbOriginY + lcuHeight) ? lcuHeight : lcuHeight + 1;
-
-                //Save last pixel column of this LCU  for next LCU
-                for (lcuRow = 0; lcuRow < lcuHeightPlusOne; ++lcuRow) {
-                    contextPtr->saoLeftBuffer[pingpongIdxLeft][lcuRow] = reconPicturePtr->bufferY[reconSampleLumaIndex + lcuWidth - 1 + lcuRow*reconPicturePtr->strideY];
-                }
-
-                if (saoParams->saoTypeIndex[0])
-                    ApplySaoOffsetsLcu(
-                        pictureControlSetPtr,
-                        lcuIndex,
-                        contextPtr,
-                        0,
-                        saoParams,
-                        tbOriginX,
-                        tbOriginY,
-                        &(reconPicturePtr->bufferY[reconSampleLumaIndex]),
-                        reconPicturePtr->strideY,
-                        pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr->bitDepth,
-                        lcuWidth,
-                        lcuHeight,
-                        sequenceControlSetPtr->lumaWidth,
-                        sequenceControlSetPtr->lumaHeight,
-                        1 - pingpongIdxUp,
-                        1 - pingpongIdxLeft);
-
-                // Toggle pingpong buffer
-                pingpongIdxLeft = 1 - pingpongIdxLeft;
-            }
-
-            // Toggle pingpong buffer
-            pingpongIdxUp = 1 - pingpongIdxUp;
+        if (!pictureControlSetPtr->saoFlag[isChroma]) {
+            continue;
         }
-    }
-
-    // U
-    if (pictureControlSetPtr->saoFlag[1]) {
 
-        lcuIndex = 0;
-        for (lcuNumberInHeight = 0; lcuNumberInHeight < pictureHeightInLcu; ++lcuNumberInHeight) {
+        lcuIndex = lcuRowIndex * pictureWidthInLcu;
+        lcuHeight = sequenceControlSetPtr->lcuParamsArray[lcuIndex].height >> shiftY;
+        rowFirstLinePtr = &(reconBufferPtr[(reconPicturePtr->originX >> shiftX) +
+            (((reconPicturePtr->originY + sequenceControlSetPtr->lcuParamsArray[lcuIndex].originY) * reconStride) >> shiftY)]);
 
-            for (lcuNumberInWidth = 0; lcuNumberInWidth < pictureWidthInLcu; ++lcuNumberInWidth, ++lcuIndex) {
-
-                LcuParams_t *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
-
-                tbOriginX = lcuParams->originX;
-                tbOriginY = lcuParams->originY;
-
-                lcuWidth = lcuParams->width >> subWidthCMinus1;
-                lcuHeight = lcuParams->height >> subHeightCMinus1;
-
-                saoParams = &pictureControlSetPtr->lcuPtrArray[lcuIndex]->saoParams;
-
-                reconSampleChromaIndex = ((reconPicturePtr->originX + tbOriginX) >> subWidthCMinus1) +
-                    (((reconPicturePtr->originY + tbOriginY) * reconPicturePtr->strideCb) >> subHeightCMinus1);
-
-                if (tbOriginX == 0) {
-
-                    reconSampleCbPtr = &(reconPicturePtr->bufferCb[reconSampleChromaIndex]) + (lcuHeight - 1)*reconPicturePtr->strideCb;
-                    //Save last pixel row of this LCU row for next LCU row
-                    EB_MEMCPY(contextPtr->saoUpBuffer[pingpongIdxUp], reconSampleCbPtr, sizeof(EB_U8) * sequenceControlSetPtr->chromaWidth);
-                }
-
-                lcuHeightPlusOne = (sequenceControlSetPtr->chromaHeight == (tbOriginY >> subHeightCMinus1) + lcuHeight) ? lcuHeight : lcuHeight + 1;
-                //Save last pixel colunm of this LCU  for next LCU
-                for (lcuRow = 0; lcuRow < lcuHeightPlusOne; ++lcuRow) {
-                    contextPtr->saoLeftBuffer[pingpongIdxLeft][lcuRow] = reconPicturePtr->bufferCb[reconSampleChromaIndex + lcuWidth - 1 + lcuRow*reconPicturePtr->strideCb];
-                }
-
-                if (saoParams->saoTypeIndex[1])
-                    ApplySaoOffsetsLcu(
-                        pictureControlSetPtr,
-                        lcuIndex,
-                        contextPtr,
-                        1,
-                        saoParams,
-                        tbOriginX,
-                        tbOriginY,
-                        &(reconPicturePtr->bufferCb[reconSampleChromaIndex]),
-                        reconPicturePtr->strideCb,
-                        pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr->bitDepth,
-                        lcuWidth,
-                        lcuHeight,
-                        sequenceControlSetPtr->chromaWidth,
-                        sequenceControlSetPtr->chromaHeight,
-                        1 - pingpongIdxUp,
-                        1 - pingpongIdxLeft);
-
-                // Toggle pingpong buffer
-                pingpongIdxLeft = 1 - pingpongIdxLeft;
-
-            }
-
-            // Toggle pingpong buffer
-            pingpongIdxUp = 1 - pingpongIdxUp;
+        // The row above is already filtered; use its unfiltered last line and keep this row's for the row below
+        if (lcuRowIndex > 0) {
+            EB_MEMCPY(contextPtr->saoUpBuffer[0], savedLastLinePtr, sizeof(EB_U8) * componentWidth);
+        }
+        if (!lastRowFlag) {
+            EB_MEMCPY(savedLastLinePtr, rowFirstLinePtr + (lcuHeight - 1) * reconStride, sizeof(EB_U8) * componentWidth);
         }
 
-        // V
-
-        lcuIndex = 0;
-        for (lcuNumberInHeight = 0; lcuNumberInHeight < pictureHeightInLcu; ++lcuNumberInHeight) {
-
-            for (lcuNumberInWidth = 0; lcuNumberInWidth < pictureWidthInLcu; ++lcuNumberInWidth, ++lcuIndex) {
-
-                LcuParams_t *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
-
-                tbOriginX = lcuParams->originX;
-                tbOriginY = lcuParams->originY;
-
-                lcuWidth = lcuParams->width >> subWidthCMinus1;
-                lcuHeight = lcuParams->height >> subHeightCMinus1;
-
-                saoParams = &pictureControlSetPtr->lcuPtrArray[lcuIndex]->saoParams;
-
-                reconSampleChromaIndex = ((reconPicturePtr->originX + tbOriginX) >> subWidthCMinus1) +
-                    (((reconPicturePtr->originY + tbOriginY) * reconPicturePtr->strideCr) >> subHeightCMinus1);
-
-                if (tbOriginX == 0) {
+        for (lcuNumberInWidth = 0; lcuNumberInWidth < pictureWidthInLcu; ++lcuNumberInWidth, ++lcuIndex) {
 
-                    reconSampleCrPtr = &(reconPicturePtr->bufferCr[reconSampleChromaIndex]) + (lcuHeight - 1)*reconPicturePtr->strideCr;
+            LcuParams_t *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
 
-                    //Save last pixel row of this LCU row for next LCU row
-                    EB_MEMCPY(contextPtr->saoUpBuffer[pingpongIdxUp], reconSampleCrPtr, sizeof(EB_U8) * sequenceControlSetPtr->chromaWidth);
-                }
+            tbOriginX = lcuParams->originX;
+            tbOriginY = lcuParams->originY;
 
+            lcuWidth = lcuParams->width >> shiftX;
+            lcuHeight = lcuParams->height >> shiftY;
 
-                lcuHeightPlusOne = (sequenceControlSetPtr->chromaHeight == (tbOriginY >> subHeightCMinus1) + lcuHeight) ? lcuHeight : lcuHeight + 1;
+            saoParams = &pictureControlSetPtr->lcuPtrArray[lcuIndex]->saoParams;
 
-                //Save last pixel colunm of this LCU  for next LCU
-                for (lcuRow = 0; lcuRow < lcuHeightPlusOne; ++lcuRow) {
-                    contextPtr->saoLeftBuffer[pingpongIdxLeft][lcuRow] = reconPicturePtr->bufferCr[reconSampleChromaIndex + lcuWidth - 1 + lcuRow*reconPicturePtr->strideCr];
-                }
-
-                if (saoParams->saoTypeIndex[1])
-                    ApplySaoOffsetsLcu(
-                        pictureControlSetPtr,
-                        lcuIndex,
-                        contextPtr,
-                        2,
-                        saoParams,
-                        tbOriginX,
-                        tbOriginY,
-                        &(reconPicturePtr->bufferCr[reconSampleChromaIndex]),
-                        reconPicturePtr->strideCr,
-                        pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr->bitDepth,
-                        lcuWidth,
-                        lcuHeight,
-                        sequenceControlSetPtr->chromaWidth,
-                        sequenceControlSetPtr->chromaHeight,
-                        1 - pingpongIdxUp,
-                        1 - pingpongIdxLeft);
+            reconSampleIndex = ((reconPicturePtr->originX + tbOriginX) >> shiftX) +
+                (((reconPicturePtr->originY + tbOriginY) * reconStride) >> shiftY);
 
-                //Toggle pingpong buffer
-                pingpongIdxLeft = 1 - pingpongIdxLeft;
+            lcuHeightPlusOne = (componentHeight == (tbOriginY >> shiftY) + lcuHeight) ? lcuHeight : lcuHeight + 1;
 
+            //Save last pixel column of this LCU  for next LCU
+            for (lcuRow = 0; lcuRow < lcuHeightPlusOne; ++lcuRow) {
+                contextPtr->saoLeftBuffer[pingpongIdxLeft][lcuRow] = reconBufferPtr[reconSampleIndex + lcuWidth - 1 + lcuRow*reconStride];
             }
 
-            //Toggle pingpong buffer
-            pingpongIdxUp = 1 - pingpongIdxUp;
+            if (saoParams->saoTypeIndex[isChroma])
+                ApplySaoOffsetsLcu(
+                    pictureControlSetPtr,
+                    lcuIndex,
+                    contextPtr,
+                    componentIndex,
+                    saoParams,
+                    tbOriginX,
+                    tbOriginY,
+                    &(reconBufferPtr[reconSampleIndex]),
+                    reconStride,
+                    pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr->bitDepth,
+                    lcuWidth,
+                    lcuHeight,
+                    componentWidth,
+                    componentHeight,
+                    0,
+                    1 - pingpongIdxLeft);
 
+            // Toggle pingpong buffer
+            pingpongIdxLeft = 1 - pingpongIdxLeft;
         }
-
     }
 
     return return_error;
@@ -834,7 +720,7 @@ static EB_ERRORTYPE ApplySaoOffsetsLcu16bit(
         }
 
 
-        SaoFunctionTableEO_0_90_16bit[!!(ASM_TYPES & PREAVX2_MASK)][(saoPtr->saoTypeIndex[isChroma]) - 1][((lcuHeight & 15) == 0) && ((lcuWidth & 15) == 0) && (lcuWidth >= 32)](
+        SaoFunctionTableEO_0_90_16bit[SSE2_AVX2_SLOT][(saoPtr->saoTypeIndex[isChroma]) - 1][((lcuHeight & 15) == 0) && ((lcuWidth & 15) == 0) && (lcuWidth >= 32)](
             reconSamplePtr,
             reconStride,
             temporalBufferLeft,
@@ -875,7 +761,7 @@ static EB_ERRORTYPE ApplySaoOffsetsLcu16bit(
             }
         }
 
-        SaoFunctionTableEO_0_90_16bit[!!(ASM_TYPES & PREAVX2_MASK)][(saoPtr->saoTypeIndex[isChroma]) - 1][((lcuHeight & 15) == 0) && ((lcuWidth & 15) == 0) && (lcuWidth >= 32)](
+        SaoFunctionTableEO_0_90_16bit[SSE2_AVX2_SLOT][(saoPtr->saoTypeIndex[isChroma]) - 1][((lcuHeight & 15) == 0) && ((lcuWidth & 15) == 0) && (lcuWidth >= 32)](
             reconSamplePtr,
             reconStride,
             temporalBufferUpper,
@@ -931,7 +817,7 @@ static EB_ERRORTYPE ApplySaoOffsetsLcu16bit(
             }
         }
 
-        SaoFunctionTableEO_135_45_16bit[!!(ASM_TYPES & PREAVX2_MASK)][(saoPtr->saoTypeIndex[isChroma]) - 3][((lcuWidth & 15) == 0) && (lcuWidth >= 32) && ((lcuHeight & 7) == 0) && (lcuHeight >= 8)](
+        SaoFunctionTableEO_135_45_16bit[SSE2_AVX2_SLOT][(saoPtr->saoTypeIndex[isChroma]) - 3][((lcuWidth & 15) == 0) && (lcuWidth >= 32) && ((lcuHeight & 7) == 0) && (lcuHeight >= 8)](
             reconSamplePtr,
             reconStride,
             temporalBufferLeft,
@@ -997,7 +883,7 @@ static EB_ERRORTYPE ApplySaoOffsetsLcu16bit(
             }
         }
 
-        SaoFunctionTableEO_135_45_16bit[!!(ASM_TYPES & PREAVX2_MASK)][(saoPtr->saoTypeIndex[isChroma]) - 3][((lcuWidth & 15) == 0) && (lcuWidth >= 32) && ((lcuHeight & 7) == 0) && (lcuHeight >= 8)](
+        SaoFunctionTableEO_135_45_16bit[SSE2_AVX2_SLOT][(saoPtr->saoTypeIndex[isChroma]) - 3][((lcuWidth & 15) == 0) && (lcuWidth >= 32) && ((lcuHeight & 7) == 0) && (lcuHeight >= 8)](
             reconSamplePtr,
             reconStride,
             temporalBufferLeft,
@@ -1032,7 +918,7 @@ static EB_ERRORTYPE ApplySaoOffsetsLcu16bit(
 
     case 5: // BO
 
-        SaoFunctionTableBo_16bit[!!(ASM_TYPES & PREAVX2_MASK)][((lcuWidth & 15) == 0)](
+        SaoFunctionTableBo_16bit[SSE2_AVX2_SLOT][((lcuWidth & 15) == 0)](
             reconSamplePtr,
             reconStride,
             saoPtr->saoBandPosition[videoComponent],
@@ -1052,22 +938,24 @@ static EB_ERRORTYPE ApplySaoOffsetsLcu16bit(
     return return_error;
 }
 /********************************************
- * ApplySaoOffsetsPicture16bit
- *   applies SAO for the whole Picture in 16bit mode
+ * ApplySaoOffsetsLcuRow16bit
+ *   applies SAO for one LCU row of the Picture in 16bit mode
  ********************************************/
-static EB_ERRORTYPE ApplySaoOffsetsPicture16bit(
-    EncDecContext_t                *contextPtr,             // input parameter, DLF context Ptr, used to store the intermediate source samples
-    SequenceControlSet_t           *sequenceControlSetPtr,  // input parameter, Sequence control set Ptr
-    PictureControlSet_t            *pictureControlSetPtr)   // input/output parameter, picture Control Set Ptr, used to get/update recontructed samples
+static EB_ERRORTYPE ApplySaoOffsetsLcuRow16bit(
+    EncDecContext_t         *contextPtr,             // input parameter, DLF context Ptr, used to store the intermediate source samples
+    SequenceControlSet_t    *sequenceControlSetPtr,  // input parameter, Sequence control set Ptr
+    PictureControlSet_t     *pictureControlSetPtr,   // input/output parameter, picture Control Set Ptr, used to get/update recontructed samples
+    EB_U32                   lcuRowIndex)            // input parameter, LCU row to filter
 {
     EB_ERRORTYPE    return_error = EB_ErrorNone;
 
     EB_U32 lcuNumberInWidth;
-    EB_U32 lcuNumberInHeight;
 
     EB_U32 pictureWidthInLcu = (sequenceControlSetPtr->lumaWidth + sequenceControlSetPtr->lcuSize - 1) / sequenceControlSetPtr->lcuSize;
     EB_U32 pictureHeightInLcu = (sequenceControlSetPtr->lumaHeight + sequenceControlSetPtr->lcuSize - 1) / sequenceControlSetPtr->lcuSize;
+    EB_BOOL lastRowFlag = (EB_BOOL)(lcuRowIndex + 1 == pictureHeightInLcu);
 
+    EB_U32 componentIndex;
     EB_U32 lcuIndex;
     EB_U32 lcuRow;
     EB_U32 lcuWidth;
@@ -1076,226 +964,100 @@ static EB_ERRORTYPE ApplySaoOffsetsPicture16bit(
     EB_U32 tbOriginX;
     EB_U32 tbOriginY;
 
-    EB_U32 reconSampleLumaIndex;
-    EB_U32 reconSampleChromaIndex;
-    EB_U16 *reconSampleYPtr;
-    EB_U16 *reconSampleCbPtr;
-    EB_U16 *reconSampleCrPtr;
+    EB_U32 reconSampleIndex;
 
-    EB_U8 pingpongIdxUp = 0;
     EB_U8 pingpongIdxLeft = 0;
 
     SaoParameters_t *saoParams;
+
     EbPictureBufferDesc_t  * recBuf16bit;
     if (pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag == EB_TRUE)
         recBuf16bit = ((EbReferenceObject_t*)pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr->objectPtr)->referencePicture16bit;
     else
         recBuf16bit = pictureControlSetPtr->reconPicture16bitPtr;
-    const EB_COLOR_FORMAT colorFormat = recBuf16bit->colorFormat;
+    const EB_COLOR_FORMAT colorFormat = recBuf16bit->colorFormat;    // Chroma format
     const EB_U16 subWidthCMinus1 = (colorFormat == EB_YUV444 ? 1 : 2) - 1;
     const EB_U16 subHeightCMinus1 = (colorFormat >= EB_YUV422 ? 1 : 2) - 1;
-    // Apply SAO
-    // Y
-    if (pictureControlSetPtr->saoFlag[0]) {
-
-        lcuIndex = 0;
-        for (lcuNumberInHeight = 0; lcuNumberInHeight < pictureHeightInLcu; ++lcuNumberInHeight) {
-
-            for (lcuNumberInWidth = 0; lcuNumberInWidth < pictureWidthInLcu; ++lcuNumberInWidth, ++lcuIndex) {
 
-                LcuParams_t *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
+    // Apply SAO, Y then U and V
+    for (componentIndex = 0; componentIndex < 3; ++componentIndex) {
 
-                tbOriginX = lcuParams->originX;
-                tbOriginY = lcuParams->originY;
-
-                lcuWidth = lcuParams->width;
-                lcuHeight = lcuParams->height;
-
-                saoParams = &pictureControlSetPtr->lcuPtrArray[lcuIndex]->saoParams;
-                reconSampleLumaIndex = (recBuf16bit->originY + tbOriginY) * recBuf16bit->strideY + recBuf16bit->originX + tbOriginX;
-
-                if (tbOriginX == 0) {
-
-                    reconSampleYPtr = (EB_U16*)(recBuf16bit->bufferY) + reconSampleLumaIndex + (lcuHeight - 1)*recBuf16bit->strideY;
-                    //Save last pixel row of this LCU row for next LCU row
-                    EbHevcMemcpy16bit(contextPtr->saoUpBuffer16[pingpongIdxUp], reconSampleYPtr, sequenceControlSetPtr->lumaWidth);
-
-                }
-
-                //Save last pixel colunm of this LCU  for next LCU
-                lcuHeightPlusOne = (sequenceControlSetPtr->lumaHeight == tbOriginY + lcuHeight) ? lcuHeight : lcuHeight + 1;
-                reconSampleYPtr = (EB_U16*)(recBuf16bit->bufferY) + reconSampleLumaIndex + lcuWidth - 1;
-
-                for (lcuRow = 0; lcuRow < lcuHeightPlusOne; ++lcuRow) {
-                    contextPtr->saoLeftBuffer16[pingpongIdxLeft][lcuRow] = reconSampleYPtr[lcuRow*recBuf16bit->strideY];
-                }
-
-
-                if (saoParams->saoTypeIndex[0])
-                    ApplySaoOffsetsLcu16bit(
-                        pictureControlSetPtr,
-                        lcuIndex,
-                        contextPtr,
-                        0,
-                        saoParams,
-                        tbOriginX,
-                        tbOriginY,
-                        (EB_U16*)recBuf16bit->bufferY + reconSampleLumaIndex,
-                        recBuf16bit->strideY,
-                        pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr->bitDepth,
-                        lcuWidth,
-                        lcuHeight,
-                        sequenceControlSetPtr->lumaWidth,
-                        sequenceControlSetPtr->lumaHeight,
-                        1 - pingpongIdxUp,
-                        1 - pingpongIdxLeft);
-
-                //Toggle pingpong buffer
-                pingpongIdxLeft = 1 - pingpongIdxLeft;
-
-            }
-
-            //Toggle pingpong buffer
-            pingpongIdxUp = 1 - pingpongIdxUp;
+        const EB_U32 isChroma = (componentIndex == 0) ? 0 : 1;
+        const EB_U16 shiftX = isChroma ? subWidthCMinus1 : 0;
+        const EB_U16 shiftY = isChroma ? subHeightCMinus1 : 0;
+        const EB_U32 componentWidth = isChroma ? sequenceControlSetPtr->chromaWidth : sequenceControlSetPtr->lumaWidth;
+        const EB_U32 componentHeight = isChroma ? sequenceControlSetPtr->chromaHeight : sequenceControlSetPtr->lumaHeight;
+        EB_U16 *reconBufferPtr = (EB_U16*)((componentIndex == 0) ? recBuf16bit->bufferY : (componentIndex == 1) ? recBuf16bit->bufferCb : recBuf16bit->bufferCr);
+        EB_U32 reconStride = (componentIndex == 0) ? recBuf16bit->strideY : (componentIndex == 1) ? recBuf16bit->strideCb : recBuf16bit->strideCr;
+        EB_U16 *savedLastLinePtr = (EB_U16*)pictureControlSetPtr->saoRowLastLineArray[componentIndex];
+        EB_U16 *rowFirstLinePtr;
 
+        if (!pictureControlSetPtr->saoFlag[isChroma]) {
+            continue;
         }
-    }
-
-    //TODO: U+V loop could be merged in one loop
-    // U
-    if (pictureControlSetPtr->saoFlag[1]) {
-
-        lcuIndex = 0;
-        for (lcuNumberInHeight = 0; lcuNumberInHeight < pictureHeightInLcu; ++lcuNumberInHeight) {
 
-            for (lcuNumberInWidth = 0; lcuNumberInWidth < pictureWidthInLcu; ++lcuNumberInWidth, ++lcuIndex) {
-
-                LcuParams_t *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
-
-                tbOriginX = lcuParams->originX;
-                tbOriginY = lcuParams->originY;
-
-                lcuWidth = lcuParams->width >> subWidthCMinus1;
-                lcuHeight = lcuParams->height >> subHeightCMinus1;
-
-                saoParams = &pictureControlSetPtr->lcuPtrArray[lcuIndex]->saoParams;
-                reconSampleChromaIndex = ((recBuf16bit->originX + tbOriginX) >> subWidthCMinus1) +
-                    (((recBuf16bit->originY + tbOriginY) * recBuf16bit->strideCb) >> subHeightCMinus1);
-
-                if (tbOriginX == 0) {
-
-                    reconSampleCbPtr = (EB_U16*)(recBuf16bit->bufferCb) + reconSampleChromaIndex + (lcuHeight - 1)*recBuf16bit->strideCb;
-
-                    //Save last pixel row of this LCU row for next LCU row
-                    EbHevcMemcpy16bit(contextPtr->saoUpBuffer16[pingpongIdxUp], reconSampleCbPtr, sequenceControlSetPtr->chromaWidth);
-                }
-
-                //Save last pixel colunm of this LCU  for next LCU
-                lcuHeightPlusOne = (sequenceControlSetPtr->chromaHeight == (tbOriginY >> subHeightCMinus1) + lcuHeight) ? lcuHeight : lcuHeight + 1;
-                reconSampleCbPtr = (EB_U16*)(recBuf16bit->bufferCb) + reconSampleChromaIndex + lcuWidth - 1;
-
-                for (lcuRow = 0; lcuRow < lcuHeightPlusOne; ++lcuRow) {
-                    contextPtr->saoLeftBuffer16[pingpongIdxLeft][lcuRow] = reconSampleCbPtr[lcuRow*recBuf16bit->strideCb];
-                }
-
-                if (saoParams->saoTypeIndex[1])
-                    ApplySaoOffsetsLcu16bit(
-                        pictureControlSetPtr,
-                        lcuIndex,
-                        contextPtr,
-                        1,
-                        saoParams,
-                        tbOriginX,
-                        tbOriginY,
-                        (EB_U16*)recBuf16bit->bufferCb + reconSampleChromaIndex,
-                        recBuf16bit->strideCb,
-                        pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr->bitDepth,
-                        lcuWidth,
-                        lcuHeight,
-                        sequenceControlSetPtr->chromaWidth,
-                        sequenceControlSetPtr->chromaHeight,
-                        1 - pingpongIdxUp,
-                        1 - pingpongIdxLeft);
-
-
-                // Toggle pingpong buffer
-                pingpongIdxLeft = 1 - pingpongIdxLeft;
-
-            }
-
-            // Toggle pingpong buffer
-            pingpongIdxUp = 1 - pingpongIdxUp;
+        lcuIndex = lcuRowIndex * pictureWidthInLcu;
+        lcuHeight = sequenceControlSetPtr->lcuParamsArray[lcuIndex].height >> shiftY;
+        rowFirstLinePtr = &(reconBufferPtr[(recBuf16bit->originX >> shiftX) +
+            (((recBuf16bit->originY + sequenceControlSetPtr->lcuParamsArray[lcuIndex].originY) * reconStride) >> shiftY)]);
 
+        // The row above is already filtered; use its unfiltered last line and keep this row's for the row below
+        if (lcuRowIndex > 0) {
+            EB_MEMCPY(contextPtr->saoUpBuffer16[0], savedLastLinePtr, sizeof(EB_U16) * componentWidth);
+        }
+        if (!lastRowFlag) {
+            EB_MEMCPY(savedLastLinePtr, rowFirstLinePtr + (lcuHeight - 1) * reconStride, sizeof(EB_U16) * componentWidth);
         }
 
-        // V
-        lcuIndex = 0;
-        for (lcuNumberInHeight = 0; lcuNumberInHeight < pictureHeightInLcu; ++lcuNumberInHeight) {
-
-            for (lcuNumberInWidth = 0; lcuNumberInWidth < pictureWidthInLcu; ++lcuNumberInWidth, ++lcuIndex) {
-
-                LcuParams_t *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
-
-                tbOriginX = lcuParams->originX;
-                tbOriginY = lcuParams->originY;
-
-                lcuWidth = lcuParams->width >> subWidthCMinus1;
-                lcuHeight = lcuParams->height >> subHeightCMinus1;
-
-                saoParams = &pictureControlSetPtr->lcuPtrArray[lcuIndex]->saoParams;
+        for (lcuNumberInWidth = 0; lcuNumberInWidth < pictureWidthInLcu; ++lcuNumberInWidth, ++lcuIndex) {
 
-                reconSampleChromaIndex = ((recBuf16bit->originX + tbOriginX) >> subWidthCMinus1) +
-                    (((recBuf16bit->originY + tbOriginY) * recBuf16bit->strideCr) >> subHeightCMinus1);
+            LcuParams_t *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
 
-                if (tbOriginX == 0) {
+            tbOriginX = lcuParams->originX;
+            tbOriginY = lcuParams->originY;
 
-                    reconSampleCrPtr = (EB_U16*)(recBuf16bit->bufferCr) + reconSampleChromaIndex + (lcuHeight - 1)*recBuf16bit->strideCr;
-                    //Save last pixel row of this LCU row for next LCU row
-                    EbHevcMemcpy16bit(contextPtr->saoUpBuffer16[pingpongIdxUp], reconSampleCrPtr, sequenceControlSetPtr->chromaWidth);
-                }
+            lcuWidth = lcuParams->width >> shiftX;
+            lcuHeight = lcuParams->height >> shiftY;
 
-                //Save last pixel colunm of this LCU  for next LCU
-                lcuHeightPlusOne = (sequenceControlSetPtr->chromaHeight == (tbOriginY >> subHeightCMinus1) + lcuHeight) ? lcuHeight : lcuHeight + 1;
-                reconSampleCrPtr = (EB_U16*)(recBuf16bit->bufferCr) + reconSampleChromaIndex + lcuWidth - 1;
+            saoParams = &pictureControlSetPtr->lcuPtrArray[lcuIndex]->saoParams;
 
-                for (lcuRow = 0; lcuRow < lcuHeightPlusOne; ++lcuRow) {
-                    contextPtr->saoLeftBuffer16[pingpongIdxLeft][lcuRow] = reconSampleCrPtr[lcuRow*recBuf16bit->strideCr];
-                }
+            reconSampleIndex = ((recBuf16bit->originX + tbOriginX) >> shiftX) +
+                (((recBuf16bit->originY + tbOriginY) * reconStride) >> shiftY);
 
-                if (saoParams->saoTypeIndex[1])
-                    ApplySaoOffsetsLcu16bit(
-                        pictureControlSetPtr,
-                        lcuIndex,
-                        contextPtr,
-                        2,
-                        saoParams,
-                        tbOriginX,
-                        tbOriginY,
-                        (EB_U16*)recBuf16bit->bufferCr + reconSampleChromaIndex,
-                        recBuf16bit->strideCr,
-                        pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr->bitDepth,
-                        lcuWidth,
-                        lcuHeight,
-                        sequenceControlSetPtr->chromaWidth,
-                        sequenceControlSetPtr->chromaHeight,
-                        1 - pingpongIdxUp,
-                        1 - pingpongIdxLeft);
-
-                // Toggle pingpong buffer
-                pingpongIdxLeft = 1 - pingpongIdxLeft;
+            lcuHeightPlusOne = (componentHeight == (tbOriginY >> shiftY) + lcuHeight) ? lcuHeight : lcuHeight + 1;
 
+            //Save last pixel column of this LCU  for next LCU
+            for (lcuRow = 0; lcuRow < lcuHeightPlusOne; ++lcuRow) {
+                contextPtr->saoLeftBuffer16[pingpongIdxLeft][lcuRow] = reconBufferPtr[reconSampleIndex + lcuWidth - 1 + lcuRow*reconStride];
             }
 
-            // Toggle pingpong buffer
-            pingpongIdxUp = 1 - pingpongIdxUp;
+            if (saoParams->saoTypeIndex[isChroma])
+                ApplySaoOffsetsLcu16bit(
+                    pictureControlSetPtr,
+                    lcuIndex,
+                    contextPtr,
+                    componentIndex,
+                    saoParams,
+                    tbOriginX,
+                    tbOriginY,
+                    &(reconBufferPtr[reconSampleIndex]),
+                    reconStride,
+                    pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr->bitDepth,
+                    lcuWidth,
+                    lcuHeight,
+                    componentWidth,
+                    componentHeight,
+                    0,
+                    1 - pingpongIdxLeft);
 
+            // Toggle pingpong buffer
+            pingpongIdxLeft = 1 - pingpongIdxLeft;
         }
     }
 
     return return_error;
 }
 
-
 /**************************************************
  * Reset Mode Decision Neighbor Arrays
  *************************************************/
@@ -1590,6 +1352,16 @@ static EB_BOOL AssignEncDecSegments(
 
         break;
 
+    case ENCDEC_TASKS_SEGMENT_RETRY:
+
+        // The segment was already assigned but deferred while its
+        //   sub-picture reference rows were not available; resume it.
+        *segmentInOutIndex = taskPtr->encDecSegmentIndex;
+        taskPtr->inputType = ENCDEC_TASKS_CONTINUE;
+        continueProcessingFlag = EB_TRUE;
+
+        break;
+
     case ENCDEC_TASKS_CONTINUE:
 
         // Update the Dependency List for Right and Bottom Neighbors
@@ -1794,10 +1566,16 @@ static void ReconOutput(
     EbReleaseMutex(encodeContextPtr->terminatingConditionsMutex);
 }
 
-static void PadRefAndSetFlags(
+/********************************************
+ * PadRefLcuRow
+ *   pads the lines of one LCU row of the reference picture,
+ *   and copies/pads the matching lines of refDenSrcPicture
+ *   when the source is used as reference (-sharp)
+ ********************************************/
+static void PadRefLcuRow(
     PictureControlSet_t    *pictureControlSetPtr,
-    SequenceControlSet_t   *sequenceControlSetPtr
-    )
+    SequenceControlSet_t   *sequenceControlSetPtr,
+    EB_U32                  lcuRowIndex)
 {
 
     EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr->objectPtr;
@@ -1807,68 +1585,150 @@ static void PadRefAndSetFlags(
     EB_COLOR_FORMAT colorFormat = pictureControlSetPtr->colorFormat;
     EB_U16 subWidthCMinus1 = (colorFormat == EB_YUV444 ? 1 : 2) - 1;
     EB_U16 subHeightCMinus1 = (colorFormat >= EB_YUV422 ? 1 : 2) - 1;
+    EB_BOOL lastRowFlag = (EB_BOOL)(lcuRowIndex + 1 == pictureControlSetPtr->ParentPcsPtr->pictureHeightInLcu);
+    EB_U32 pictureHeight = is16bit ? refPic16BitPtr->height : refPicPtr->height;
+
+    // Luma lines of the LCU row; the last row also takes any lines below the last full LCU
+    EB_U32 firstLine = lcuRowIndex * sequenceControlSetPtr->lcuSize;
+    EB_U32 lineCount = lastRowFlag ? pictureHeight - firstLine : sequenceControlSetPtr->lcuSize;
 
     if (!is16bit) {
         // Y samples
-        GeneratePadding(
+        GeneratePaddingLines(
             refPicPtr->bufferY,
             refPicPtr->strideY,
             refPicPtr->width,
             refPicPtr->height,
             refPicPtr->originX,
-            refPicPtr->originY);
+            refPicPtr->originY,
+            firstLine,
+            lineCount);
 
         // Cb samples
-        GeneratePadding(
+        GeneratePaddingLines(
             refPicPtr->bufferCb,
             refPicPtr->strideCb,
             refPicPtr->width >> subWidthCMinus1,
             refPicPtr->height >> subHeightCMinus1,
             refPicPtr->originX >> subWidthCMinus1,
-            refPicPtr->originY >> subHeightCMinus1);
+            refPicPtr->originY >> subHeightCMinus1,
+            firstLine >> subHeightCMinus1,
+            lineCount >> subHeightCMinus1);
 
         // Cr samples
-        GeneratePadding(
+        GeneratePaddingLines(
             refPicPtr->bufferCr,
             refPicPtr->strideCr,
             refPicPtr->width >> subWidthCMinus1,
             refPicPtr->height >> subHeightCMinus1,
             refPicPtr->originX >> subWidthCMinus1,
-            refPicPtr->originY >> subHeightCMinus1);
+            refPicPtr->originY >> subHeightCMinus1,
+            firstLine >> subHeightCMinus1,
+            lineCount >> subHeightCMinus1);
     }
 
     //We need this for MCP
     if (is16bit) {
         // Y samples
-        GeneratePadding16Bit(
+        GeneratePaddingLines16Bit(
             refPic16BitPtr->bufferY,
             refPic16BitPtr->strideY << 1,
             refPic16BitPtr->width << 1,
             refPic16BitPtr->height,
             refPic16BitPtr->originX << 1,
-            refPic16BitPtr->originY);
+            refPic16BitPtr->originY,
+            firstLine,
+            lineCount);
 
         // Cb samples
-        GeneratePadding16Bit(
+        GeneratePaddingLines16Bit(
             refPic16BitPtr->bufferCb,
             refPic16BitPtr->strideCb << 1,
             refPic16BitPtr->width << (1 - subWidthCMinus1),
             refPic16BitPtr->height >> subHeightCMinus1,
             refPic16BitPtr->originX << (1 - subWidthCMinus1),
-            refPic16BitPtr->originY >> subHeightCMinus1);
+            refPic16BitPtr->originY >> subHeightCMinus1,
+            firstLine >> subHeightCMinus1,
+            lineCount >> subHeightCMinus1);
 
         // Cr samples
-        GeneratePadding16Bit(
+        GeneratePaddingLines16Bit(
             refPic16BitPtr->bufferCr,
             refPic16BitPtr->strideCr << 1,
             refPic16BitPtr->width << (1 - subWidthCMinus1),
             refPic16BitPtr->height >> subHeightCMinus1,
             refPic16BitPtr->originX << (1 - subWidthCMinus1),
-            refPic16BitPtr->originY >> subHeightCMinus1);
+            refPic16BitPtr->originY >> subHeightCMinus1,
+            firstLine >> subHeightCMinus1,
+            lineCount >> subHeightCMinus1);
     }
 
-}
+    //Jing: Only copy/pad refDenSrcPicture if useSrcRef flag is set(in -sharp case)
+    //      Should not use pcs->useSrcRef directly
+    if (sequenceControlSetPtr->staticConfig.improveSharpness) {
+        EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr;
+        const EB_U32  SrclumaOffSet = inputPicturePtr->originX + inputPicturePtr->originY    *inputPicturePtr->strideY;
+        const EB_U32 SrccbOffset = (inputPicturePtr->originX >> subWidthCMinus1) + (inputPicturePtr->originY >> subHeightCMinus1) * inputPicturePtr->strideCb;
+        const EB_U32 SrccrOffset = (inputPicturePtr->originX >> subWidthCMinus1) + (inputPicturePtr->originY >> subHeightCMinus1) * inputPicturePtr->strideCr;
+
+        EbPictureBufferDesc_t *refDenPic = referenceObject->refDenSrcPicture;
+        const EB_U32           ReflumaOffSet = refDenPic->originX + refDenPic->originY    *refDenPic->strideY;
+        const EB_U32 RefcbOffset = (refDenPic->originX >> subWidthCMinus1) + (refDenPic->originY >> subHeightCMinus1) * refDenPic->strideCb;
+        const EB_U32 RefcrOffset = (refDenPic->originX >> subWidthCMinus1) + (refDenPic->originY >> subHeightCMinus1) * refDenPic->strideCr;
 
+        EB_U32 denLineCount = lastRowFlag ? refDenPic->height - firstLine : sequenceControlSetPtr->lcuSize;
+        EB_U32 chromaLineEnd = lastRowFlag ? (EB_U32)(inputPicturePtr->height >> subHeightCMinus1) : (firstLine + denLineCount) >> subHeightCMinus1;
+        EB_U32 verticalIdx;
+
+        for (verticalIdx = firstLine; verticalIdx < firstLine + denLineCount; ++verticalIdx)
+        {
+            EB_MEMCPY(refDenPic->bufferY + ReflumaOffSet + verticalIdx*refDenPic->strideY,
+                    inputPicturePtr->bufferY + SrclumaOffSet + verticalIdx* inputPicturePtr->strideY,
+                    inputPicturePtr->width);
+        }
+
+        for (verticalIdx = firstLine >> subHeightCMinus1; verticalIdx < chromaLineEnd; ++verticalIdx)
+        {
+            EB_MEMCPY(refDenPic->bufferCb + RefcbOffset + verticalIdx*refDenPic->strideCb,
+                    inputPicturePtr->bufferCb + SrccbOffset + verticalIdx* inputPicturePtr->strideCb,
+                    inputPicturePtr->width >> subWidthCMinus1);
+
+            EB_MEMCPY(refDenPic->bufferCr + RefcrOffset + verticalIdx*refDenPic->strideCr,
+                    inputPicturePtr->bufferCr + SrccrOffset + verticalIdx* inputPicturePtr->strideCr,
+                    inputPicturePtr->width >> subWidthCMinus1 );
+        }
+
+        GeneratePaddingLines(
+                refDenPic->bufferY,
+                refDenPic->strideY,
+                refDenPic->width,
+                refDenPic->height,
+                refDenPic->originX,
+                refDenPic->originY,
+                firstLine,
+                denLineCount);
+
+        GeneratePaddingLines(
+                refDenPic->bufferCb,
+                refDenPic->strideCb,
+                refDenPic->width >> subWidthCMinus1,
+                refDenPic->height >> subHeightCMinus1,
+                refDenPic->originX >> subWidthCMinus1,
+                refDenPic->originY >> subHeightCMinus1,
+                firstLine >> subHeightCMinus1,
+                denLineCount >> subHeightCMinus1);
+
+        GeneratePaddingLines(
+                refDenPic->bufferCr,
+                refDenPic->strideCr,
+                refDenPic->width >> subWidthCMinus1,
+                refDenPic->height >> subHeightCMinus1,
+                refDenPic->originX >> subWidthCMinus1,
+                refDenPic->originY >> subHeightCMinus1,
+                firstLine >> subHeightCMinus1,
+                denLineCount >> subHeightCMinus1);
+    }
+}
 
 static void CopyStatisticsToRefObject(
     PictureControlSet_t    *pictureControlSetPtr,
@@ -1907,6 +1767,294 @@ static void CopyStatisticsToRefObject(
 
 }
 
+/******************************************************
+ * Post Reference Picture
+ *   Signals Picture Manager that the reference picture
+ *   can be used by dependent pictures.
+ ******************************************************/
+static void PostReferencePicture(
+    EncDecContext_t        *contextPtr,
+    PictureControlSet_t    *pictureControlSetPtr)
+{
+    EbObjectWrapper_t      *pictureDemuxResultsWrapperPtr;
+    PictureDemuxResults_t  *pictureDemuxResultsPtr;
+
+    // Get Empty EntropyCoding Results
+    EbGetEmptyObject(
+            contextPtr->pictureDemuxOutputFifoPtr,
+            &pictureDemuxResultsWrapperPtr);
+
+    pictureDemuxResultsPtr = (PictureDemuxResults_t*)pictureDemuxResultsWrapperPtr->objectPtr;
+    pictureDemuxResultsPtr->referencePictureWrapperPtr = pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr;
+    pictureDemuxResultsPtr->sequenceControlSetWrapperPtr = pictureControlSetPtr->sequenceControlSetWrapperPtr;
+    pictureDemuxResultsPtr->pictureNumber = pictureControlSetPtr->pictureNumber;
+    pictureDemuxResultsPtr->pictureType = EB_PIC_REFERENCE;
+
+    // Post Reference Picture
+    EbPostFullObject(pictureDemuxResultsWrapperPtr);
+}
+
+/******************************************************
+ * Sub-picture Reference Rows Ready
+ *   Checks that the reference pictures have the first
+ *   lcuRowCount LCU rows available. When they are not,
+ *   the thread waits unless that would leave no EncDec
+ *   thread free to make progress on the reference
+ *   pictures; EB_FALSE is then returned and the caller
+ *   requeues the segment. The waiting thread gives its
+ *   EncDec slot to the threads that can progress.
+ ******************************************************/
+static EB_BOOL SubPictureReferenceRowsReady(
+    SequenceControlSet_t   *sequenceControlSetPtr,
+    PictureControlSet_t    *pictureControlSetPtr,
+    EB_U16                  lcuRowCount)
+{
+    EncodeContext_t     *encodeContextPtr = sequenceControlSetPtr->encodeContextPtr;
+    EbReferenceObject_t *refObjArray[2] = { EB_NULL, EB_NULL };
+    EB_BOOL              waitFlag;
+    EB_U32               listIndex;
+
+    if (pictureControlSetPtr->sliceType == EB_I_PICTURE) {
+        return EB_TRUE;
+    }
+
+    refObjArray[REF_LIST_0] = (EbReferenceObject_t*)pictureControlSetPtr->refPicPtrArray[REF_LIST_0]->objectPtr;
+    if (pictureControlSetPtr->sliceType == EB_B_PICTURE) {
+        refObjArray[REF_LIST_1] = (EbReferenceObject_t*)pictureControlSetPtr->refPicPtrArray[REF_LIST_1]->objectPtr;
+    }
+
+    for (listIndex = 0; listIndex < 2; ++listIndex) {
+        if (refObjArray[listIndex] == EB_NULL || EbReferenceObjectRowsAvailable(refObjArray[listIndex], lcuRowCount)) {
+            continue;
+        }
+
+        EbBlockOnMutex(encodeContextPtr->subPictureRefWaitMutex);
+        waitFlag = (encodeContextPtr->subPictureRefWaitCount + 1 < sequenceControlSetPtr->encDecProcessInitCount) ? EB_TRUE : EB_FALSE;
+        if (waitFlag) {
+            ++encodeContextPtr->subPictureRefWaitCount;
+        }
+        EbReleaseMutex(encodeContextPtr->subPictureRefWaitMutex);
+
+        if (!waitFlag) {
+            return EB_FALSE;
+        }
+
+        EbSuspendTask();
+        EbReferenceObjectWaitRowProgress(refObjArray[listIndex], lcuRowCount);
+        EbResumeTask();
+
+        EbBlockOnMutex(encodeContextPtr->subPictureRefWaitMutex);
+        --encodeContextPtr->subPictureRefWaitCount;
+        EbReleaseMutex(encodeContextPtr->subPictureRefWaitMutex);
+    }
+
+    return EB_TRUE;
+}
+
+/******************************************************
+ * EncDec Picture Finish
+ *   Runs once all LCUs of the picture are coded and all
+ *   its LCU rows post-filtered: outputs the recon, signals
+ *   the reference picture and releases the picture's
+ *   references.
+ ******************************************************/
+static void EncDecPictureFinish(
+    EncDecContext_t        *contextPtr,
+    SequenceControlSet_t   *sequenceControlSetPtr,
+    PictureControlSet_t    *pictureControlSetPtr,
+    EbObjectWrapper_t      *pictureControlSetWrapperPtr)
+{
+    if (pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr != NULL) {
+        // copy stat to ref object (intraCodedArea, Luminance, Scene change detection flags)
+        CopyStatisticsToRefObject(
+                pictureControlSetPtr,
+                sequenceControlSetPtr);
+    }
+
+    if (sequenceControlSetPtr->staticConfig.reconEnabled) {
+        ReconOutput(
+                pictureControlSetPtr,
+                sequenceControlSetPtr);
+    }
+
+    if (pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag && sequenceControlSetPtr->staticConfig.subPictureReference) {
+        // The reference was posted at picture start; release the dependents waiting on its rows
+        EbReferenceObjectPostRowProgress(
+                (EbReferenceObject_t*)pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr->objectPtr,
+                (EB_U16)pictureControlSetPtr->ParentPcsPtr->pictureHeightInLcu);
+        EbReleaseObject(pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr);
+    }
+    else if (pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag) {
+        //Jing: TODO: double check here
+        PostReferencePicture(
+                contextPtr,
+                pictureControlSetPtr);
+#if LATENCY_PROFILE
+        double latency = 0.0;
+        EB_U64 finishTimeSeconds = 0;
+        EB_U64 finishTimeuSeconds = 0;
+        EbHevcFinishTime((uint64_t*)&finishTimeSeconds, (uint64_t*)&finishTimeuSeconds);
+
+        EbHevcComputeOverallElapsedTimeMs(
+                pictureControlSetPtr->ParentPcsPtr->startTimeSeconds,
+                pictureControlSetPtr->ParentPcsPtr->startTimeuSeconds,
+                finishTimeSeconds,
+                finishTimeuSeconds,
+                &latency);
+
+        SVT_LOG("POC %lld ENCDEC REF DONE, decoder order %d, latency %3.3f \n",
+                pictureControlSetPtr->pictureNumber,
+                pictureControlSetPtr->ParentPcsPtr->decodeOrder,
+                latency);
+#endif
+    }
+
+    // Release the List 0 Reference Pictures
+    for (EB_U8 refIdx = 0; refIdx < pictureControlSetPtr->ParentPcsPtr->refList0Count; ++refIdx) {
+        if (pictureControlSetPtr->refPicPtrArray[0] != EB_NULL) {
+
+            EbReleaseObject(pictureControlSetPtr->refPicPtrArray[0]);
+        }
+    }
+
+    // Release the List 1 Reference Pictures
+    for (EB_U8 refIdx = 0; refIdx < pictureControlSetPtr->ParentPcsPtr->refList1Count; ++refIdx) {
+        if (pictureControlSetPtr->refPicPtrArray[1] != EB_NULL) {
+            EbReleaseObject(pictureControlSetPtr->refPicPtrArray[1]);
+        }
+    }
+
+    // Release the Child PCS held for the post-filter row tasks
+    EbReleaseObject(pictureControlSetWrapperPtr);
+}
+
+/******************************************************
+ * Post-Filter Row Ready
+ *   Checks whether the next LCU row of the picture can
+ *   be post-filtered: the row and the row below it are
+ *   coded, so the deblocking of the row is final, and no
+ *   row task of the picture is queued. Marks the row
+ *   task queued when it is. Called with the intraMutex
+ *   held.
+ ******************************************************/
+static EB_BOOL PostFilterRowReady(
+    PictureControlSet_t    *pictureControlSetPtr)
+{
+    EB_U32 pictureWidthInLcu = pictureControlSetPtr->ParentPcsPtr->pictureWidthInLcu;
+    EB_U32 pictureHeightInLcu = pictureControlSetPtr->ParentPcsPtr->pictureHeightInLcu;
+    EB_U32 lcuRowIndex = pictureControlSetPtr->postFilterNextRow;
+
+    if (pictureControlSetPtr->postFilterBusyFlag || lcuRowIndex >= pictureHeightInLcu) {
+        return EB_FALSE;
+    }
+
+    // The deblocking of the row below filters the last lines of this row
+    if (EbAtomicLoad32(&pictureControlSetPtr->lcuRowCodedCountArray[lcuRowIndex]) < pictureWidthInLcu ||
+        (lcuRowIndex + 1 < pictureHeightInLcu && EbAtomicLoad32(&pictureControlSetPtr->lcuRowCodedCountArray[lcuRowIndex + 1]) < pictureWidthInLcu)) {
+        return EB_FALSE;
+    }
+
+    pictureControlSetPtr->postFilterBusyFlag = EB_TRUE;
+
+    return EB_TRUE;
+}
+
+/******************************************************
+ * Start Post-Filter Row
+ *   Posts the EncDec task that post-filters one LCU row
+ ******************************************************/
+static void StartPostFilterRow(
+    EncDecContext_t        *contextPtr,
+    EbObjectWrapper_t      *pictureControlSetWrapperPtr,
+    EB_U32                  lcuRowIndex)
+{
+    EbObjectWrapper_t *taskWrapperPtr;
+    EncDecTasks_t     *taskPtr;
+
+    EbGetEmptyObject(
+        contextPtr->encDecFeedbackFifoPtr,
+        &taskWrapperPtr);
+    taskPtr = (EncDecTasks_t*)taskWrapperPtr->objectPtr;
+    taskPtr->inputType = ENCDEC_TASKS_POST_FILTER_ROW;
+    taskPtr->encDecSegmentRow = (EB_S16)lcuRowIndex;
+    taskPtr->pictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
+    taskPtr->tileGroupIndex = 0;
+    EbPostFullObject(taskWrapperPtr);
+}
+
+/******************************************************
+ * Post-Filter LCU Row
+ *   Applies SAO to one LCU row and pads it in the
+ *   reference picture, then posts the row progress of
+ *   the reference. Rows run one at a time from the top
+ *   of the picture, each as soon as it is deblocked;
+ *   the last one finishes the picture.
+ ******************************************************/
+static void PostFilterLcuRow(
+    EncDecContext_t        *contextPtr,
+    SequenceControlSet_t   *sequenceControlSetPtr,
+    PictureControlSet_t    *pictureControlSetPtr,
+    EbObjectWrapper_t      *pictureControlSetWrapperPtr,
+    EB_U32                  lcuRowIndex)
+{
+    EB_BOOL nextRowFlag;
+    EB_BOOL pictureDoneFlag;
+    EB_U16  readyRowCount;
+
+    if (pictureControlSetPtr->postFilterSaoFlag) {
+        if (sequenceControlSetPtr->staticConfig.encoderBitDepth > EB_8BIT) {
+            ApplySaoOffsetsLcuRow16bit(
+                contextPtr,
+                sequenceControlSetPtr,
+                pictureControlSetPtr,
+                lcuRowIndex);
+        }
+        else {
+            ApplySaoOffsetsLcuRow(
+                contextPtr,
+                sequenceControlSetPtr,
+                pictureControlSetPtr,
+                lcuRowIndex);
+        }
+    }
+
+    if (pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag) {
+        PadRefLcuRow(
+            pictureControlSetPtr,
+            sequenceControlSetPtr,
+            lcuRowIndex);
+    }
+
+    EbBlockOnMutex(pictureControlSetPtr->intraMutex);
+    pictureControlSetPtr->postFilterBusyFlag = EB_FALSE;
+    readyRowCount = ++pictureControlSetPtr->postFilterNextRow;
+    nextRowFlag = PostFilterRowReady(pictureControlSetPtr);
+    pictureDoneFlag = (readyRowCount == pictureControlSetPtr->ParentPcsPtr->pictureHeightInLcu &&
+        pictureControlSetPtr->encDecCodedLcuCount == pictureControlSetPtr->lcuTotalCount) ? EB_TRUE : EB_FALSE;
+    EbReleaseMutex(pictureControlSetPtr->intraMutex);
+
+    if (pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag && sequenceControlSetPtr->staticConfig.subPictureReference) {
+        EbReferenceObjectPostRowProgress(
+            (EbReferenceObject_t*)pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr->objectPtr,
+            readyRowCount);
+    }
+
+    if (nextRowFlag) {
+        StartPostFilterRow(
+            contextPtr,
+            pictureControlSetWrapperPtr,
+            readyRowCount);
+    }
+
+    if (pictureDoneFlag) {
+        EncDecPictureFinish(
+            contextPtr,
+            sequenceControlSetPtr,
+            pictureControlSetPtr,
+            pictureControlSetWrapperPtr);
+    }
+}
+
 EB_ERRORTYPE QpmDeriveWeightsMinAndMax(
     PictureControlSet_t                    *pictureControlSetPtr,
     EncDecContext_t                        *contextPtr)
@@ -2633,8 +2781,6 @@ void* EncDecKernel(void *inputPtr)
     // Output
     EbObjectWrapper_t      *encDecResultsWrapperPtr;
     EncDecResults_t        *encDecResultsPtr;
-    EbObjectWrapper_t      *pictureDemuxResultsWrapperPtr;
-    PictureDemuxResults_t  *pictureDemuxResultsPtr;
 
     // LCU Loop variables
     LargestCodingUnit_t    *lcuPtr;
@@ -2654,7 +2800,6 @@ void* EncDecKernel(void *inputPtr)
     MdcLcuData_t           *mdcPtr;
     // Variables
     EB_BOOL                 enableSaoFlag = EB_TRUE;
-    EB_BOOL                 is16bit;
 
     // Segments
     //EB_BOOL                 initialProcessCall;
@@ -2684,6 +2829,19 @@ void* EncDecKernel(void *inputPtr)
         pictureControlSetPtr = (PictureControlSet_t*)encDecTasksPtr->pictureControlSetWrapperPtr->objectPtr;
         ppcsPtr = pictureControlSetPtr->ParentPcsPtr;
         sequenceControlSetPtr = (SequenceControlSet_t*)pictureControlSetPtr->sequenceControlSetWrapperPtr->objectPtr;
+
+        if (encDecTasksPtr->inputType == ENCDEC_TASKS_POST_FILTER_ROW) {
+            PostFilterLcuRow(
+                    contextPtr,
+                    sequenceControlSetPtr,
+                    pictureControlSetPtr,
+                    encDecTasksPtr->pictureControlSetWrapperPtr,
+                    (EB_U32)encDecTasksPtr->encDecSegmentRow);
+
+            // Release Mode Decision Results
+            EbReleaseObject(encDecTasksWrapperPtr);
+            continue;
+        }
         enableSaoFlag = (sequenceControlSetPtr->staticConfig.enableSaoFlag) ? EB_TRUE : EB_FALSE;
         tileGroupIdx = encDecTasksPtr->tileGroupIndex;
 
@@ -2695,7 +2853,6 @@ void* EncDecKernel(void *inputPtr)
         tileGroupLcuStartY = ppcsPtr->tileGroupInfoArray[tileGroupIdx].tileGroupLcuOriginY;
 
         lastLcuFlag = EB_FALSE;
-        is16bit = (EB_BOOL)(sequenceControlSetPtr->staticConfig.encoderBitDepth > EB_8BIT);
 #if DEADLOCK_DEBUG
         SVT_LOG("POC %lld ENCDEC IN \n", pictureControlSetPtr->pictureNumber);
 #endif
@@ -2772,7 +2929,43 @@ void* EncDecKernel(void *inputPtr)
 
                 // set up the Slice Type
                 referenceObject->sliceType = pictureControlSetPtr->ParentPcsPtr->sliceType;
+
+                if (sequenceControlSetPtr->staticConfig.subPictureReference) {
+                    // Dependent pictures start before this picture completes; publish the
+                    //   statistics they read up front and track reconstructed LCU rows.
+                    for (EB_U32 lcuIdx = 0; lcuIdx < pictureControlSetPtr->lcuTotalCount; ++lcuIdx) {
+                        referenceObject->nonMovingIndexArray[lcuIdx] = pictureControlSetPtr->ParentPcsPtr->nonMovingIndexArray[lcuIdx];
+                    }
+                    referenceObject->picAvgVariance = pictureControlSetPtr->ParentPcsPtr->picAvgVariance;
+                    referenceObject->averageIntensity = pictureControlSetPtr->ParentPcsPtr->averageIntensity[0];
+                    referenceObject->tmpLayerIdx = (EB_U8)pictureControlSetPtr->temporalLayerIndex;
+                    referenceObject->isSceneChange = pictureControlSetPtr->ParentPcsPtr->sceneChangeFlag;
+                    EbReferenceObjectResetRowProgress(referenceObject);
+
+                    // Keep the reference alive until its last row is posted
+                    EbObjectIncLiveCount(pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr, 1);
+                    PostReferencePicture(
+                            contextPtr,
+                            pictureControlSetPtr);
+                }
             }
+
+            // SAO application and reference padding run as LCU row tasks on the EncDec FIFO as
+            //   soon as each row is deblocked; the Child PCS is held until the picture is finished.
+            //   The per-component saoFlag is set by the segments and checked by the row tasks.
+            EB_BOOL applySAOAtEncoderFlag = sequenceControlSetPtr->staticConfig.enableSaoFlag &&
+                (pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag ||
+                 sequenceControlSetPtr->staticConfig.reconEnabled);
+
+            applySAOAtEncoderFlag = contextPtr->allowEncDecMismatch ? EB_FALSE : applySAOAtEncoderFlag;
+
+            pictureControlSetPtr->postFilterSaoFlag = applySAOAtEncoderFlag;
+            pictureControlSetPtr->postFilterNextRow = (pictureControlSetPtr->postFilterSaoFlag || pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag) ?
+                0 :
+                ppcsPtr->pictureHeightInLcu;
+            pictureControlSetPtr->postFilterBusyFlag = EB_FALSE;
+            EB_MEMSET(pictureControlSetPtr->lcuRowCodedCountArray, 0, sizeof(EB_U32) * ppcsPtr->pictureHeightInLcu);
+            EbObjectIncLiveCount(encDecTasksPtr->pictureControlSetWrapperPtr, 1);
         }
         EbReleaseMutex(pictureControlSetPtr->intraMutex);
 
@@ -2800,6 +2993,47 @@ void* EncDecKernel(void *inputPtr)
             segmentBandIndex = segmentIndex - segmentRowIndex * segmentsPtr->segmentBandCount;
             segmentBandSize = (segmentsPtr->lcuBandCount * (segmentBandIndex + 1) + segmentsPtr->segmentBandCount - 1) / segmentsPtr->segmentBandCount;
 
+            // Sub-picture reference: the segment's MVs reach SUB_PICTURE_REF_LCU_ROW_MARGIN rows below its last row
+            if (sequenceControlSetPtr->staticConfig.subPictureReference) {
+                EB_U32 segmentLastRow = tileGroupLcuStartY + EncDecSegmentLastLcuRow(
+                    segmentsPtr,
+                    segmentIndex,
+                    tileGroupWidthInLcu,
+                    ppcsPtr->tileGroupInfoArray[tileGroupIdx].tileGroupHeightInLcu);
+                EB_U16 requiredRowCount = (EB_U16)MIN(ppcsPtr->pictureHeightInLcu, segmentLastRow + 1 + SUB_PICTURE_REF_LCU_ROW_MARGIN);
+
+                if (!SubPictureReferenceRowsReady(sequenceControlSetPtr, pictureControlSetPtr, requiredRowCount)) {
+                    EbObjectWrapper_t *retryTaskWrapperPtr;
+                    EncDecTasks_t     *retryTaskPtr;
+
+                    // Requeue the segment behind the work that produces the missing rows
+                    EbGetEmptyObject(
+                            contextPtr->encDecFeedbackFifoPtr,
+                            &retryTaskWrapperPtr);
+                    retryTaskPtr = (EncDecTasks_t*)retryTaskWrapperPtr->objectPtr;
+                    retryTaskPtr->inputType = ENCDEC_TASKS_SEGMENT_RETRY;
+                    retryTaskPtr->encDecSegmentRow = (EB_S16)segmentRowIndex;
+                    retryTaskPtr->encDecSegmentIndex = segmentIndex;
+                    retryTaskPtr->pictureControlSetWrapperPtr = encDecTasksPtr->pictureControlSetWrapperPtr;
+                    retryTaskPtr->tileGroupIndex = tileGroupIdx;
+                    EbPostFullObject(retryTaskWrapperPtr);
+                    break;
+                }
+            }
+
+            // Work on the node of the middle row of the diagonal the segment walks
+            if (sequenceControlSetPtr->encodeContextPtr->numaTopology.nodeCount) {
+                EB_U32 segmentLastRow = EncDecSegmentLastLcuRow(
+                    segmentsPtr,
+                    segmentIndex,
+                    tileGroupWidthInLcu,
+                    ppcsPtr->tileGroupInfoArray[tileGroupIdx].tileGroupHeightInLcu);
+
+                EbNumaEnterPartition(
+                    &sequenceControlSetPtr->encodeContextPtr->numaTopology,
+                    &contextPtr->numaState,
+                    EbNumaRowPartition(&sequenceControlSetPtr->encodeContextPtr->numaTopology, tileGroupLcuStartY + ((yLcuStartIndex + segmentLastRow) >> 1), ppcsPtr->pictureHeightInLcu));
+            }
 
             // Reset Coding Loop State
             ProductResetModeDecision( // HT done
@@ -3011,6 +3245,24 @@ void* EncDecKernel(void *inputPtr)
                         ((EbReferenceObject_t*)pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr->objectPtr)->intraCodedAreaLCU[lcuIndex] = (EB_U8)((100 * contextPtr->intraCodedAreaLCU[lcuIndex]) / (64 * 64));
                     }
 
+                    // A coded LCU row completes the deblocking of the row above; start the post-filter row it unblocks
+                    if (EbAtomicFetchAdd32(&pictureControlSetPtr->lcuRowCodedCountArray[tileGroupLcuStartY + yLcuIndex], 1) + 1 == ppcsPtr->pictureWidthInLcu) {
+                        EB_BOOL postFilterRowFlag;
+                        EB_U32  postFilterRowIndex;
+
+                        EbBlockOnMutex(pictureControlSetPtr->intraMutex);
+                        postFilterRowFlag = PostFilterRowReady(pictureControlSetPtr);
+                        postFilterRowIndex = pictureControlSetPtr->postFilterNextRow;
+                        EbReleaseMutex(pictureControlSetPtr->intraMutex);
+
+                        if (postFilterRowFlag) {
+                            StartPostFilterRow(
+                                    contextPtr,
+                                    encDecTasksPtr->pictureControlSetWrapperPtr,
+                                    postFilterRowIndex);
+                        }
+                    }
+
                 }
                 xLcuStartIndex = (xLcuStartIndex > 0) ? xLcuStartIndex - 1 : 0;
             }
@@ -3048,166 +3300,16 @@ void* EncDecKernel(void *inputPtr)
         //        contextPtr, encDecTasksPtr->tileIndex,
         //        contextPtr->codedLcuCount,
         //        pictureControlSetPtr->encDecCodedLcuCount, lastLcuFlag);
+        // The picture is finished by whichever of its last segment and its last post-filter row ends last
+        lastLcuFlag = (lastLcuFlag && pictureControlSetPtr->postFilterNextRow == ppcsPtr->pictureHeightInLcu) ? EB_TRUE : EB_FALSE;
         EbReleaseMutex(pictureControlSetPtr->intraMutex);
 
         if (lastLcuFlag) {
-            if (pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr != NULL){
-                // copy stat to ref object (intraCodedArea, Luminance, Scene change detection flags)
-                CopyStatisticsToRefObject(
-                        pictureControlSetPtr,
-                        sequenceControlSetPtr);
-            }
-
-            EB_BOOL applySAOAtEncoderFlag = sequenceControlSetPtr->staticConfig.enableSaoFlag &&
-                (pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag ||
-                 sequenceControlSetPtr->staticConfig.reconEnabled);
-
-            applySAOAtEncoderFlag = contextPtr->allowEncDecMismatch ? EB_FALSE : applySAOAtEncoderFlag;
-
-            if (applySAOAtEncoderFlag)
-            {
-                if (is16bit) {
-                    ApplySaoOffsetsPicture16bit(
-                            contextPtr,
-                            sequenceControlSetPtr,
-                            pictureControlSetPtr);
-                }
-                else {
-                    ApplySaoOffsetsPicture(
-                            contextPtr,
-                            sequenceControlSetPtr,
-                            pictureControlSetPtr);
-                }
-
-            }
-
-
-            // Pad the reference picture and set up TMVP flag and ref POC
-            if (pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag == EB_TRUE) {
-                PadRefAndSetFlags(
-                        pictureControlSetPtr,
-                        sequenceControlSetPtr);
-
-                //Jing: Only copy/pad refDenSrcPicture if useSrcRef flag is set(in -sharp case)
-                //      Should not use pcs->useSrcRef directly
-                if (sequenceControlSetPtr->staticConfig.improveSharpness) {
-                    EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)pictureControlSetPtr->ParentPcsPtr->enhancedPicturePtr;
-                    EB_COLOR_FORMAT colorFormat = inputPicturePtr->colorFormat;
-                    EB_U16 subWidthCMinus1 = (colorFormat == EB_YUV444 ? 1 : 2) - 1;
-                    EB_U16 subHeightCMinus1 = (colorFormat >= EB_YUV422 ? 1 : 2) - 1;
-                    const EB_U32  SrclumaOffSet = inputPicturePtr->originX + inputPicturePtr->originY    *inputPicturePtr->strideY;
-                    const EB_U32 SrccbOffset = (inputPicturePtr->originX >> subWidthCMinus1) + (inputPicturePtr->originY >> subHeightCMinus1) * inputPicturePtr->strideCb;
-                    const EB_U32 SrccrOffset = (inputPicturePtr->originX >> subWidthCMinus1) + (inputPicturePtr->originY >> subHeightCMinus1) * inputPicturePtr->strideCr;
-
-                    EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr->objectPtr;
-                    EbPictureBufferDesc_t *refDenPic = referenceObject->refDenSrcPicture;
-                    const EB_U32           ReflumaOffSet = refDenPic->originX + refDenPic->originY    *refDenPic->strideY;
-                    const EB_U32 RefcbOffset = (refDenPic->originX >> subWidthCMinus1) + (refDenPic->originY >> subHeightCMinus1) * refDenPic->strideCb;
-                    const EB_U32 RefcrOffset = (refDenPic->originX >> subWidthCMinus1) + (refDenPic->originY >> subHeightCMinus1) * refDenPic->strideCr;
-
-                    EB_U16  verticalIdx;
-
-                    for (verticalIdx = 0; verticalIdx < refDenPic->height; ++verticalIdx)
-                    {
-                        EB_MEMCPY(refDenPic->bufferY + ReflumaOffSet + verticalIdx*refDenPic->strideY,
-                                inputPicturePtr->bufferY + SrclumaOffSet + verticalIdx* inputPicturePtr->strideY,
-                                inputPicturePtr->width);
-                    }
-
-                    for (verticalIdx = 0; verticalIdx < inputPicturePtr->height >> subHeightCMinus1; ++verticalIdx)
-                    {
-                        EB_MEMCPY(refDenPic->bufferCb + RefcbOffset + verticalIdx*refDenPic->strideCb,
-                                inputPicturePtr->bufferCb + SrccbOffset + verticalIdx* inputPicturePtr->strideCb,
-                                inputPicturePtr->width >> subWidthCMinus1);
-
-                        EB_MEMCPY(refDenPic->bufferCr + RefcrOffset + verticalIdx*refDenPic->strideCr,
-                                inputPicturePtr->bufferCr + SrccrOffset + verticalIdx* inputPicturePtr->strideCr,
-                                inputPicturePtr->width >> subWidthCMinus1 );
-                    }
-
-                    GeneratePadding(
-                            refDenPic->bufferY,
-                            refDenPic->strideY,
-                            refDenPic->width,
-                            refDenPic->height,
-                            refDenPic->originX,
-                            refDenPic->originY);
-
-                    GeneratePadding(
-                            refDenPic->bufferCb,
-                            refDenPic->strideCb,
-                            refDenPic->width >> subWidthCMinus1,
-                            refDenPic->height >> subHeightCMinus1,
-                            refDenPic->originX >> subWidthCMinus1,
-                            refDenPic->originY >> subHeightCMinus1);
-
-                    GeneratePadding(
-                            refDenPic->bufferCr,
-                            refDenPic->strideCr,
-                            refDenPic->width >> subWidthCMinus1,
-                            refDenPic->height >> subHeightCMinus1,
-                            refDenPic->originX >> subWidthCMinus1,
-                            refDenPic->originY >> subHeightCMinus1);
-                }
-            }
-
-
-            if (sequenceControlSetPtr->staticConfig.reconEnabled) {
-                ReconOutput(
-                        pictureControlSetPtr,
-                        sequenceControlSetPtr);
-            }
-
-            if (pictureControlSetPtr->ParentPcsPtr->isUsedAsReferenceFlag) {
-                //Jing: TODO: double check here
-
-                // Get Empty EntropyCoding Results
-                EbGetEmptyObject(
-                        contextPtr->pictureDemuxOutputFifoPtr,
-                        &pictureDemuxResultsWrapperPtr);
-
-                pictureDemuxResultsPtr = (PictureDemuxResults_t*)pictureDemuxResultsWrapperPtr->objectPtr;
-                pictureDemuxResultsPtr->referencePictureWrapperPtr = pictureControlSetPtr->ParentPcsPtr->referencePictureWrapperPtr;
-                pictureDemuxResultsPtr->sequenceControlSetWrapperPtr = pictureControlSetPtr->sequenceControlSetWrapperPtr;
-                pictureDemuxResultsPtr->pictureNumber = pictureControlSetPtr->pictureNumber;
-                pictureDemuxResultsPtr->pictureType = EB_PIC_REFERENCE;
-
-                // Post Reference Picture
-                EbPostFullObject(pictureDemuxResultsWrapperPtr);
-#if LATENCY_PROFILE
-                    double latency = 0.0;
-                    EB_U64 finishTimeSeconds = 0;
-                    EB_U64 finishTimeuSeconds = 0;
-                    EbHevcFinishTime((uint64_t*)&finishTimeSeconds, (uint64_t*)&finishTimeuSeconds);
-
-                    EbHevcComputeOverallElapsedTimeMs(
-                            pictureControlSetPtr->ParentPcsPtr->startTimeSeconds,
-                            pictureControlSetPtr->ParentPcsPtr->startTimeuSeconds,
-                            finishTimeSeconds,
-                            finishTimeuSeconds,
-                            &latency);
-
-                    SVT_LOG("POC %lld ENCDEC REF DONE, decoder order %d, latency %3.3f \n",
-                            pictureControlSetPtr->pictureNumber,
-                            pictureControlSetPtr->ParentPcsPtr->decodeOrder,
-                            latency);
-#endif
-            }
-
-            // Release the List 0 Reference Pictures
-            for (EB_U8 refIdx = 0; refIdx < pictureControlSetPtr->ParentPcsPtr->refList0Count; ++refIdx) {
-                if (pictureControlSetPtr->refPicPtrArray[0] != EB_NULL) {
-
-                    EbReleaseObject(pictureControlSetPtr->refPicPtrArray[0]);
-                }
-            }
-
-            // Release the List 1 Reference Pictures
-            for (EB_U8 refIdx = 0; refIdx < pictureControlSetPtr->ParentPcsPtr->refList1Count; ++refIdx) {
-                if (pictureControlSetPtr->refPicPtrArray[1] != EB_NULL) {
-                    EbReleaseObject(pictureControlSetPtr->refPicPtrArray[1]);
-                }
-            }
+            EncDecPictureFinish(
+                    contextPtr,
+                    sequenceControlSetPtr,
+                    pictureControlSetPtr,
+                    encDecTasksPtr->pictureControlSetWrapperPtr);
         }
         EbReleaseObject(encDecTasksPtr->pictureControlSetWrapperPtr);
 
@@ -148,6 +148,8 @@ typedef struct EncDecContext_s
     EB_BOOL                         pmMethod;   // 1-stgae   vs. 2-stage 
 
     EB_U16                          encDecTileIndex;
+
+    EbNumaThreadState_t             numaState;
     ////
 } EncDecContext_t;
 
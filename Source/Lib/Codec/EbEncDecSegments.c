@@ -129,3 +129,35 @@ void EncDecSegmentsInit(
     return;
 }
 
+/**************************************
+ * EncDecSegmentLastLcuRow
+ *   Last LCU row of the tile group the LCU walk of a segment
+ *   reaches. The walk has the bounds of the EncDec segment loop:
+ *   each row starts at the segment's xStart and ends at the band
+ *   edge or the tile group width, until the segment's LCUs are done.
+ **************************************/
+EB_U32 EncDecSegmentLastLcuRow(
+    EncDecSegments_t *segmentsPtr,
+    EB_U32            segmentIndex,
+    EB_U32            tileGroupWidthInLcu,
+    EB_U32            tileGroupHeightInLcu)
+{
+    EB_U32 segmentRowIndex = segmentIndex / segmentsPtr->segmentBandCount;
+    EB_U32 segmentBandIndex = segmentIndex - segmentRowIndex * segmentsPtr->segmentBandCount;
+    EB_U32 segmentBandSize = (segmentsPtr->lcuBandCount * (segmentBandIndex + 1) + segmentsPtr->segmentBandCount - 1) / segmentsPtr->segmentBandCount;
+    EB_U32 xLcuStartIndex = segmentsPtr->xStartArray[segmentIndex];
+    EB_U32 yLcuIndex = segmentsPtr->yStartArray[segmentIndex];
+    EB_U32 lastRow = yLcuIndex;
+    EB_U32 lcuCount = 0;
+
+    for (; lcuCount < segmentsPtr->validLcuCountArray[segmentIndex] && yLcuIndex < tileGroupHeightInLcu; ++yLcuIndex) {
+        EB_U32 xLcuEndIndex = (segmentBandSize > yLcuIndex) ? ((segmentBandSize - yLcuIndex < tileGroupWidthInLcu) ? segmentBandSize - yLcuIndex : tileGroupWidthInLcu) : 0;
+
+        if (xLcuEndIndex > xLcuStartIndex) {
+            lcuCount += xLcuEndIndex - xLcuStartIndex;
+            lastRow = yLcuIndex;
+        }
+    }
+
+    return lastRow;
+}
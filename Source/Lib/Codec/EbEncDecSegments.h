@@ -86,6 +86,12 @@ extern void EncDecSegmentsInit(
     EB_U32            rowCount,
     EB_U32            picWidthLcu,
     EB_U32            picHeightLcu);
+
+extern EB_U32 EncDecSegmentLastLcuRow(
+    EncDecSegments_t *segmentsPtr,
+    EB_U32            segmentIndex,
+    EB_U32            tileGroupWidthInLcu,
+    EB_U32            tileGroupHeightInLcu);
 #ifdef __cplusplus
 }
 #endif
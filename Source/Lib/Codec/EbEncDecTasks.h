@@ -14,6 +14,8 @@ extern "C" {
 #define ENCDEC_TASKS_MDC_INPUT      0
 #define ENCDEC_TASKS_ENCDEC_INPUT   1
 #define ENCDEC_TASKS_CONTINUE       2
+#define ENCDEC_TASKS_SEGMENT_RETRY  3   // segment requeued while waiting on sub-picture reference rows
+#define ENCDEC_TASKS_POST_FILTER_ROW 4  // SAO application and reference padding of one LCU row
 
 /**************************************
  * Process Results
@@ -23,6 +25,7 @@ typedef struct EncDecTasks_s
     EbObjectWrapper_t            *pictureControlSetWrapperPtr;
     EB_U32                        inputType;
     EB_S16                        encDecSegmentRow;
+    EB_U16                        encDecSegmentIndex;
 
     EB_U32                        tileGroupIndex;
 } EncDecTasks_t;
@@ -81,6 +81,9 @@
 #define EB_RateControlProcessInitCount                  1
 #define EB_PacketizationProcessInitCount                1
 
+// Stage concurrency balancing
+#define EB_BALANCE_PERIOD_US                            100000
+
 // Buffer Transfer Parameters
 #define EB_INPUTVIDEOBUFFERSIZE                         0x10000//   832*480*3//      // Input Slice Size , must me a multiple of 2 in case of 10 bit video.
 #define EB_OUTPUTSTREAMBUFFERSIZE                       0x2DC6C0   //0x7D00        // match MTU Size
@@ -98,39 +101,35 @@ static EB_U32 highTierMaxBitRate[TOTAL_LEVEL_COUNT] = { 128000, 1500000, 3000000
 static EB_U32 maxTileColumn[TOTAL_LEVEL_COUNT] = { 1, 1, 1, 2, 3, 5, 5, 10, 10, 10, 20, 20, 20 };
 static EB_U32 maxTileRow[TOTAL_LEVEL_COUNT]    = { 1, 1, 1, 2, 3, 5, 5, 11, 11, 11, 22, 22, 22 };
 
-EB_U32 ASM_TYPES;
 /**************************************
  * External Functions
  **************************************/
 static EB_ERRORTYPE InitH265EncoderHandle(EB_HANDLETYPE hComponent);
+static EB_ERRORTYPE CopyInputPayload(EB_SEI_MESSAGE *dstPtr, EB_U8 *payloadPtr, EB_U32 payloadSize);
 #include <immintrin.h>
 
 /**************************************
- * Globals
+ * EbEncHandleBind
+ *   Points the calling thread at the memory map and assembly level of the
+ *   encoder instance. Every API entry point of an instance calls it first,
+ *   as applications may call the API from any thread.
  **************************************/
+static void EbEncHandleBind(EbEncHandle_t *encHandlePtr)
+{
+    memoryContextPtr    = &encHandlePtr->memoryContext;
+    ASM_TYPES           = encHandlePtr->asmTypes;
+}
 
-EbMemoryMapEntry               *memoryMap;
-EB_U32                         *memoryMapIndex;
-EB_U64                         *totalLibMemory;
-
-EB_U32                         libMallocCount = 0;
-EB_U32                         libThreadCount = 0;
-EB_U32                         libSemaphoreCount = 0;
-EB_U32                         libMutexCount = 0;
-
-EB_U8                           numGroups = 0;
-#ifdef _WIN32
-GROUP_AFFINITY                  groupAffinity;
-EB_BOOL                         alternateGroups = 0;
-#elif defined(__linux__)
-cpu_set_t                       groupAffinity;
-typedef struct logicalProcessorGroup {
-    uint32_t num;
-    uint32_t group[1024];
-}processorGroup;
-#define INITIAL_PROCESSOR_GROUP 16
-processorGroup                  *lpGroup = EB_NULL;
-#endif
+/**************************************
+ * Output Stream Buffer
+ *   The output stream buffers of an instance record it, so that
+ *   EbH265ReleaseOutBuffer can bind the calling thread to it.
+ **************************************/
+typedef struct EbOutputStreamBuffer_s
+{
+    EB_BUFFERHEADERTYPE  header;
+    EbEncHandle_t       *encHandlePtr;
+} EbOutputStreamBuffer_t;
 
 /**************************************
 * Instruction Set Support
@@ -292,15 +291,173 @@ EB_U32 EbHevcGetCpuAsmType()
 }
 
 //Get Number of logical processors
-EB_U32 EbHevcGetNumProcessors() {
+EB_U32 EbHevcGetNumProcessors(EB_U8 numGroups) {
 #ifdef WIN32
     SYSTEM_INFO sysinfo;
     GetSystemInfo(&sysinfo);
     return numGroups == 1 ? sysinfo.dwNumberOfProcessors : sysinfo.dwNumberOfProcessors << 1;
 #else
+    (void)numGroups;
 	return sysconf(_SC_NPROCESSORS_ONLN);
 #endif
 }
+
+#ifdef __linux__
+#define EB_CGROUP_PATH_LENGTH   512
+
+/*****************************************
+ * EbHevcReadCpuQuota
+ *   Whole CPUs of the bandwidth limit set in one
+ *   cgroup directory, 0 when it sets none
+ *****************************************/
+static EB_U32 EbHevcReadCpuQuota(
+    const char *cgroupDir,
+    EB_BOOL     cgroupV2)
+{
+    FILE     *fin;
+    char      fileName[EB_CGROUP_PATH_LENGTH + 32];
+    char      quota[32];
+    long long quotaUs = -1;
+    long long periodUs = 0;
+
+    if (cgroupV2) {
+        // "<quota|max> <period>"
+        snprintf(fileName, sizeof(fileName), "%s/cpu.max", cgroupDir);
+        fin = fopen(fileName, "r");
+        if (fin) {
+            if (fscanf(fin, "%31s %lld", quota, &periodUs) == 2 && strcmp(quota, "max") != 0) {
+                quotaUs = strtoll(quota, NULL, 10);
+            }
+            fclose(fin);
+        }
+    }
+    else {
+        // A quota of -1 is not limited
+        snprintf(fileName, sizeof(fileName), "%s/cpu.cfs_quota_us", cgroupDir);
+        fin = fopen(fileName, "r");
+        if (fin) {
+            if (fscanf(fin, "%lld", &quotaUs) != 1) {
+                quotaUs = -1;
+            }
+            fclose(fin);
+        }
+        snprintf(fileName, sizeof(fileName), "%s/cpu.cfs_period_us", cgroupDir);
+        fin = fopen(fileName, "r");
+        if (fin) {
+            if (fscanf(fin, "%lld", &periodUs) != 1) {
+                periodUs = 0;
+            }
+            fclose(fin);
+        }
+    }
+
+    if (quotaUs <= 0 || periodUs <= 0) {
+        return 0;
+    }
+
+    return (EB_U32)((quotaUs + periodUs - 1) / periodUs);
+}
+
+/*****************************************
+ * EbHevcGetCpuQuota
+ *   Whole CPUs granted to the process by the
+ *   cgroup CPU bandwidth controller, 0 when
+ *   the bandwidth is not limited. The cgroup of
+ *   the process comes from /proc/self/cgroup; a
+ *   limit set on a parent applies as well, so
+ *   the tightest one up to the mount is kept
+ *****************************************/
+static EB_U32 EbHevcGetCpuQuota(void)
+{
+    FILE   *fin;
+    char    line[EB_CGROUP_PATH_LENGTH];
+    char    cgroupDir[EB_CGROUP_PATH_LENGTH + 32];
+    char    v2Path[EB_CGROUP_PATH_LENGTH] = "";
+    char    v1Path[EB_CGROUP_PATH_LENGTH] = "";
+    EB_BOOL cgroupV2 = EB_TRUE;
+    size_t  mountLength;
+    char   *separatorPtr;
+    EB_U32  cpuQuota = 0;
+    EB_U32  dirQuota;
+
+    // "<id>:<controllers>:<path>", the v2 hierarchy is "0::<path>"
+    fin = fopen("/proc/self/cgroup", "r");
+    if (fin) {
+        while (fgets(line, sizeof(line), fin)) {
+            char *controllersPtr = strchr(line, ':');
+            char *pathPtr = controllersPtr ? strchr(controllersPtr + 1, ':') : NULL;
+            char *controllerPtr;
+            char *savePtr = NULL;
+            if (pathPtr == NULL) {
+                continue;
+            }
+            *pathPtr++ = '\0';
+            pathPtr[strcspn(pathPtr, "\n")] = '\0';
+            if (strcmp(line, "0") == 0 && controllersPtr[1] == '\0') {
+                snprintf(v2Path, sizeof(v2Path), "%s", pathPtr);
+                continue;
+            }
+            for (controllerPtr = strtok_r(controllersPtr + 1, ",", &savePtr); controllerPtr; controllerPtr = strtok_r(NULL, ",", &savePtr)) {
+                if (strcmp(controllerPtr, "cpu") == 0) {
+                    snprintf(v1Path, sizeof(v1Path), "%s", pathPtr);
+                }
+            }
+        }
+        fclose(fin);
+    }
+
+    // The v1 cpu controller takes over when it is mounted
+    fin = fopen("/sys/fs/cgroup/cpu/cpu.cfs_period_us", "r");
+    if (fin) {
+        fclose(fin);
+        cgroupV2 = EB_FALSE;
+    }
+
+    snprintf(cgroupDir, sizeof(cgroupDir), "%s", cgroupV2 ? "/sys/fs/cgroup" : "/sys/fs/cgroup/cpu");
+    mountLength = strlen(cgroupDir);
+    snprintf(cgroupDir + mountLength, sizeof(cgroupDir) - mountLength, "%s", cgroupV2 ? v2Path : v1Path);
+
+    // Up to the mount, which is the root file when the
+    // path of the process is not visible in this namespace
+    for (;;) {
+        dirQuota = EbHevcReadCpuQuota(cgroupDir, cgroupV2);
+        if (dirQuota != 0 && (cpuQuota == 0 || dirQuota < cpuQuota)) {
+            cpuQuota = dirQuota;
+        }
+        separatorPtr = strrchr(cgroupDir, '/');
+        if (separatorPtr == NULL || (size_t)(separatorPtr - cgroupDir) < mountLength) {
+            break;
+        }
+        *separatorPtr = '\0';
+    }
+
+    return cpuQuota;
+}
+#endif
+
+/*****************************************
+ * EbHevcGetEffectiveCoreCount
+ *   Containers see the cores of the host; the
+ *   encoder can only keep busy those of its
+ *   affinity mask and of its CPU quota
+ *****************************************/
+static EB_U32 EbHevcGetEffectiveCoreCount(
+    EB_U32 coreCount)
+{
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    EB_U32    cpuQuota = EbHevcGetCpuQuota();
+
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet) == 0 && CPU_COUNT(&cpuSet) > 0) {
+        coreCount = MIN(coreCount, (EB_U32)CPU_COUNT(&cpuSet));
+    }
+    if (cpuQuota != 0) {
+        coreCount = MIN(coreCount, cpuQuota);
+    }
+#endif
+    return MAX(coreCount, 1);
+}
 /*****************************************
  * Process Input Ports Config
  *****************************************/
@@ -393,11 +550,12 @@ static EB_U32 EncDecPortTotalCount(void)
     return totalCount;
 }
 
-EB_ERRORTYPE EbHevcInitThreadManagmentParams(){
+EB_ERRORTYPE EbHevcInitThreadManagmentParams(EbThreadAffinity_t *affinityPtr){
 #ifdef _WIN32
     // Initialize groupAffinity structure with Current thread info
-    GetThreadGroupAffinity(GetCurrentThread(),&groupAffinity);
-    numGroups = (EB_U8) GetActiveProcessorGroupCount();
+    GetThreadGroupAffinity(GetCurrentThread(),&affinityPtr->groupAffinity);
+    affinityPtr->numGroups = (EB_U8) GetActiveProcessorGroupCount();
+    affinityPtr->alternateGroups = EB_FALSE;
 #elif defined(__linux__)
     const char* PROCESSORID = "processor";
     const char* PHYSICALID = "physical id";
@@ -406,6 +564,8 @@ EB_ERRORTYPE EbHevcInitThreadManagmentParams(){
     int maxSize = INITIAL_PROCESSOR_GROUP;
     if (processor_id_len < 0 || processor_id_len >= 128) return EB_ErrorInsufficientResources;
     if (physical_id_len < 0 || physical_id_len >= 128) return EB_ErrorInsufficientResources;
+    processorGroup *lpGroup = affinityPtr->lpGroup;
+    affinityPtr->numGroups = 0;
     memset(lpGroup, 0, INITIAL_PROCESSOR_GROUP * sizeof(processorGroup));
 
     FILE *fin = fopen("/proc/cpuinfo", "r");
@@ -426,11 +586,12 @@ EB_ERRORTYPE EbHevcInitThreadManagmentParams(){
                     fclose(fin);
                     return EB_ErrorInsufficientResources;
                 }
-                if (socket_id + 1 > numGroups)
-                    numGroups = socket_id + 1;
+                if (socket_id + 1 > affinityPtr->numGroups)
+                    affinityPtr->numGroups = socket_id + 1;
                 if (socket_id >= maxSize) {
                     maxSize = maxSize * 2;
                     lpGroup = (processorGroup*)realloc(lpGroup,maxSize * sizeof(processorGroup));
+                    affinityPtr->lpGroup = lpGroup;
                     if (lpGroup == (processorGroup*) EB_NULL)
                         return EB_ErrorInsufficientResources;
                 }
@@ -461,24 +622,26 @@ static EB_ERRORTYPE EbEncHandleCtor(
     if (encHandlePtr == (EbEncHandle_t*) EB_NULL){
         return EB_ErrorInsufficientResources;
     }
-    encHandlePtr->memoryMap             = (EbMemoryMapEntry*) malloc(sizeof(EbMemoryMapEntry) * MAX_NUM_PTR);
-    encHandlePtr->memoryMapIndex        = 0;
-	encHandlePtr->totalLibMemory		= sizeof(EbEncHandle_t) + sizeof(EbMemoryMapEntry) * MAX_NUM_PTR;
+    memset(&encHandlePtr->memoryContext, 0, sizeof(EbMemoryContext_t));
+    memset(&encHandlePtr->threadAffinity, 0, sizeof(EbThreadAffinity_t));
+    encHandlePtr->memoryContext.memoryMap       = (EbMemoryMapEntry*) malloc(sizeof(EbMemoryMapEntry) * MAX_NUM_PTR);
+	encHandlePtr->memoryContext.totalLibMemory	= sizeof(EbEncHandle_t) + sizeof(EbMemoryMapEntry) * MAX_NUM_PTR;
+    encHandlePtr->asmTypes                      = EB_ASM_C;
 
-    // Save Memory Map Pointers
-    totalLibMemory                      = &encHandlePtr->totalLibMemory;
-    memoryMap                           =  encHandlePtr->memoryMap;
-    memoryMapIndex                      = &encHandlePtr->memoryMapIndex;
-    libMallocCount                      = 0;
-    libThreadCount                      = 0;
-    libMutexCount                       = 0;
-    libSemaphoreCount                   = 0;
+    // Route the allocations of this instance to its own memory map
+    EbEncHandleBind(encHandlePtr);
 
-    if (memoryMap == (EbMemoryMapEntry*) EB_NULL){
+    if (encHandlePtr->memoryContext.memoryMap == (EbMemoryMapEntry*) EB_NULL){
         return EB_ErrorInsufficientResources;
     }
 
-    return_error = EbHevcInitThreadManagmentParams();
+#if defined(__linux__)
+    encHandlePtr->threadAffinity.lpGroup = (processorGroup*) malloc(sizeof(processorGroup) * INITIAL_PROCESSOR_GROUP);
+    if (encHandlePtr->threadAffinity.lpGroup == (processorGroup*) EB_NULL)
+        return EB_ErrorInsufficientResources;
+#endif
+
+    return_error = EbHevcInitThreadManagmentParams(&encHandlePtr->threadAffinity);
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
@@ -642,62 +805,64 @@ void EbHevcSwitchToRealTime()
 }
 
 void EbHevcSetThreadManagementParameters(
+    EbThreadAffinity_t          *affinityPtr,
     EB_H265_ENC_CONFIGURATION   *configPtr)
 {
+    EB_U8 numGroups = affinityPtr->numGroups;
     if (configPtr->switchThreadsToRtPriority == 1)
         EbHevcSwitchToRealTime();
 
 #ifdef _WIN32
-    EB_U32 numLogicProcessors = EbHevcGetNumProcessors();
+    EB_U32 numLogicProcessors = EbHevcGetNumProcessors(numGroups);
     // For system with a single processor group(no more than 64 logic processors all together)
     // Affinity of the thread can be set to one or more logical processors
     if (numGroups == 1) {
         EB_U32 lps = configPtr->logicalProcessors == 0 ? numLogicProcessors:
             configPtr->logicalProcessors < numLogicProcessors ? configPtr->logicalProcessors : numLogicProcessors;
-        groupAffinity.Mask = EbHevcGetAffinityMask(lps);
+        affinityPtr->groupAffinity.Mask = EbHevcGetAffinityMask(lps);
     }
     else if (numGroups > 1) { // For system with multiple processor group
         if (configPtr->logicalProcessors == 0) {
             if (configPtr->targetSocket != -1) {
-                groupAffinity.Group = configPtr->targetSocket;
+                affinityPtr->groupAffinity.Group = configPtr->targetSocket;
             }
         }
         else {
             EB_U32 numLpPerGroup = numLogicProcessors / numGroups;
             if (configPtr->targetSocket == -1) {
                 if (configPtr->logicalProcessors > numLpPerGroup) {
-                    alternateGroups = TRUE;
+                    affinityPtr->alternateGroups = EB_TRUE;
                     SVT_LOG("SVT [WARNING]: -lp(logical processors) setting is ignored. Run on both sockets. \n");
                 }
                 else {
-                    groupAffinity.Mask = EbHevcGetAffinityMask(configPtr->logicalProcessors);
+                    affinityPtr->groupAffinity.Mask = EbHevcGetAffinityMask(configPtr->logicalProcessors);
                 }
             }
             else {
                 EB_U32 lps = configPtr->logicalProcessors == 0 ? numLpPerGroup :
                     configPtr->logicalProcessors < numLpPerGroup ? configPtr->logicalProcessors : numLpPerGroup;
-                groupAffinity.Mask = EbHevcGetAffinityMask(lps);
-                groupAffinity.Group = configPtr->targetSocket;
+                affinityPtr->groupAffinity.Mask = EbHevcGetAffinityMask(lps);
+                affinityPtr->groupAffinity.Group = configPtr->targetSocket;
             }
         }
     }
 #elif defined(__linux__)
-    EB_U32 numLogicProcessors = EbHevcGetNumProcessors();
-    CPU_ZERO(&groupAffinity);
+    EB_U32 numLogicProcessors = EbHevcGetNumProcessors(numGroups);
+    CPU_ZERO(&affinityPtr->groupAffinity);
     if (numGroups == 1) {
         EB_U32 lps = configPtr->logicalProcessors == 0 ? numLogicProcessors:
             configPtr->logicalProcessors < numLogicProcessors ? configPtr->logicalProcessors : numLogicProcessors;
             if (configPtr->targetSocket != -1) {
                 for(EB_U32 i=0; i<lps; i++)
-                    CPU_SET(lpGroup[0].group[i], &groupAffinity);
+                    CPU_SET(affinityPtr->lpGroup[0].group[i], &affinityPtr->groupAffinity);
             }
     }
     else if (numGroups > 1) {
         EB_U32 numLpPerGroup = numLogicProcessors / numGroups;
         if (configPtr->logicalProcessors == 0) {
             if (configPtr->targetSocket != -1) {
-                for(EB_U32 i=0; i<lpGroup[configPtr->targetSocket].num; i++)
-                    CPU_SET(lpGroup[configPtr->targetSocket].group[i], &groupAffinity);
+                for(EB_U32 i=0; i<affinityPtr->lpGroup[configPtr->targetSocket].num; i++)
+                    CPU_SET(affinityPtr->lpGroup[configPtr->targetSocket].group[i], &affinityPtr->groupAffinity);
             }
         }
         else {
@@ -705,27 +870,120 @@ void EbHevcSetThreadManagementParameters(
                 EB_U32 lps = configPtr->logicalProcessors == 0 ? numLogicProcessors:
                     configPtr->logicalProcessors < numLogicProcessors ? configPtr->logicalProcessors : numLogicProcessors;
                 if(lps > numLpPerGroup) {
-                    for(EB_U32 i=0; i<lpGroup[0].num; i++)
-                        CPU_SET(lpGroup[0].group[i], &groupAffinity);
-                    for(EB_U32 i=0; i< (lps -lpGroup[0].num); i++)
-                        CPU_SET(lpGroup[1].group[i], &groupAffinity);
+                    for(EB_U32 i=0; i<affinityPtr->lpGroup[0].num; i++)
+                        CPU_SET(affinityPtr->lpGroup[0].group[i], &affinityPtr->groupAffinity);
+                    for(EB_U32 i=0; i< (lps -affinityPtr->lpGroup[0].num); i++)
+                        CPU_SET(affinityPtr->lpGroup[1].group[i], &affinityPtr->groupAffinity);
                 }
                 else {
                     for(EB_U32 i=0; i<lps; i++)
-                        CPU_SET(lpGroup[0].group[i], &groupAffinity);
+                        CPU_SET(affinityPtr->lpGroup[0].group[i], &affinityPtr->groupAffinity);
                 }
             }
             else {
                 EB_U32 lps = configPtr->logicalProcessors == 0 ? numLpPerGroup :
                     configPtr->logicalProcessors < numLpPerGroup ? configPtr->logicalProcessors : numLpPerGroup;
                 for(EB_U32 i=0; i<lps; i++)
-                    CPU_SET(lpGroup[configPtr->targetSocket].group[i], &groupAffinity);
+                    CPU_SET(affinityPtr->lpGroup[configPtr->targetSocket].group[i], &affinityPtr->groupAffinity);
             }
         }
     }
 #endif
 }
 
+/*********************************************************************************
+* EbHevcSetNumaTopology
+*   Splits the LCU rows of the pictures over the sockets, one band per socket.
+*   Only when asked for and the threads are not already kept to a socket or to
+*   a count of logical processors.
+**********************************************************************************/
+static void EbHevcSetNumaTopology(
+    EbEncHandle_t *encHandlePtr)
+{
+#if defined(__linux__)
+    EB_H265_ENC_CONFIGURATION *configPtr = &encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig;
+    EbThreadAffinity_t        *affinityPtr = &encHandlePtr->threadAffinity;
+    EbNumaTopology_t           topology;
+    EB_U32                     socketIndex;
+    EB_U32                     processorIndex;
+    EB_U32                     instanceIndex;
+
+    if (!configPtr->numaPartition || configPtr->targetSocket != -1 || configPtr->logicalProcessors != 0 || affinityPtr->numGroups < 2) {
+        return;
+    }
+
+    EB_MEMSET(&topology, 0, sizeof(topology));
+    topology.nodeCount = MIN(affinityPtr->numGroups, EB_NUMA_MAX_NODES);
+    for (socketIndex = 0; socketIndex < topology.nodeCount; ++socketIndex) {
+        CPU_ZERO(&topology.nodeAffinity[socketIndex]);
+        for (processorIndex = 0; processorIndex < affinityPtr->lpGroup[socketIndex].num; ++processorIndex) {
+            CPU_SET(affinityPtr->lpGroup[socketIndex].group[processorIndex], &topology.nodeAffinity[socketIndex]);
+        }
+        topology.nodeId[socketIndex] = (affinityPtr->lpGroup[socketIndex].num > 0) ?
+            EbNumaGetNodeOfCpu(affinityPtr->lpGroup[socketIndex].group[0]) :
+            socketIndex;
+    }
+
+    for (instanceIndex = 0; instanceIndex < encHandlePtr->encodeInstanceTotalCount; ++instanceIndex) {
+        encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->encodeContextPtr->numaTopology = topology;
+    }
+#else
+    (void)encHandlePtr;
+#endif
+}
+
+/*********************************************************************************
+* EbHevcBindPicturePools
+*   Places the rows of the input, reference and PA reference pictures on the
+*   node of the band they belong to, before any of them is written
+**********************************************************************************/
+static void EbHevcBindPicturePools(
+    EbEncHandle_t *encHandlePtr)
+{
+    EB_U32 instanceIndex;
+    EB_U32 objectIndex;
+
+    for (instanceIndex = 0; instanceIndex < encHandlePtr->encodeInstanceTotalCount; ++instanceIndex) {
+        EbNumaTopology_t     *topologyPtr = &encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->encodeContextPtr->numaTopology;
+        EB_U32                lcuSize = encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->lcuSize;
+        EbSystemResource_t   *referencePoolPtr = encHandlePtr->referencePicturePoolPtrArray[instanceIndex];
+        EbSystemResource_t   *paReferencePoolPtr = encHandlePtr->paReferencePicturePoolPtrArray[instanceIndex];
+
+        if (topologyPtr->nodeCount == 0) {
+            continue;
+        }
+
+        for (objectIndex = 0; objectIndex < referencePoolPtr->objectTotalCount; ++objectIndex) {
+            EbReferenceObject_t *referenceObjectPtr = (EbReferenceObject_t*)referencePoolPtr->wrapperPtrPool[objectIndex]->objectPtr;
+            if (referenceObjectPtr->referencePicture) {
+                EbPictureBufferDescBindNuma(referenceObjectPtr->referencePicture, topologyPtr, lcuSize);
+            }
+            if (referenceObjectPtr->referencePicture16bit) {
+                EbPictureBufferDescBindNuma(referenceObjectPtr->referencePicture16bit, topologyPtr, lcuSize);
+            }
+            EbPictureBufferDescBindNuma(referenceObjectPtr->refDenSrcPicture, topologyPtr, lcuSize);
+        }
+
+        for (objectIndex = 0; objectIndex < paReferencePoolPtr->objectTotalCount; ++objectIndex) {
+            EbPaReferenceObject_t *paReferenceObjectPtr = (EbPaReferenceObject_t*)paReferencePoolPtr->wrapperPtrPool[objectIndex]->objectPtr;
+            EbPictureBufferDescBindNuma(paReferenceObjectPtr->inputPaddedPicturePtr, topologyPtr, lcuSize);
+            EbPictureBufferDescBindNuma(paReferenceObjectPtr->quarterDecimatedPicturePtr, topologyPtr, lcuSize >> 1);
+            EbPictureBufferDescBindNuma(paReferenceObjectPtr->sixteenthDecimatedPicturePtr, topologyPtr, lcuSize >> 2);
+        }
+    }
+
+    // The input pictures are shared by the instances
+    if (encHandlePtr->sequenceControlSetInstanceArray[0]->encodeContextPtr->numaTopology.nodeCount) {
+        for (objectIndex = 0; objectIndex < encHandlePtr->inputBufferResourcePtr->objectTotalCount; ++objectIndex) {
+            EB_BUFFERHEADERTYPE *inputBufferPtr = (EB_BUFFERHEADERTYPE*)encHandlePtr->inputBufferResourcePtr->wrapperPtrPool[objectIndex]->objectPtr;
+            EbPictureBufferDescBindNuma(
+                (EbPictureBufferDesc_t*)inputBufferPtr->pBuffer,
+                &encHandlePtr->sequenceControlSetInstanceArray[0]->encodeContextPtr->numaTopology,
+                encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->lcuSize);
+        }
+    }
+}
+
 /**********************************
  * Initialize Encoder Library
  **********************************/
@@ -746,15 +1004,26 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
     * Plateform detection
     ************************************/
     if (encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig.asmType == EB_ASM_AUTO) {
-        ASM_TYPES = EbHevcGetCpuAsmType(); // Use highest assembly
+        encHandlePtr->asmTypes = EbHevcGetCpuAsmType(); // Use highest assembly
     }
     else if (encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig.asmType == EB_ASM_C) {
-        ASM_TYPES = EB_ASM_C; // Use C_only
+        encHandlePtr->asmTypes = EB_ASM_C; // Use C_only
     }
+    EbEncHandleBind(encHandlePtr);
+    EbSetLockFreeFifo((EB_BOOL)encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig.lockFreeFifo);
+
+    EbHevcSetNumaTopology(encHandlePtr);
 
     /************************************
      * Sequence Control Set
      ************************************/
+    // With EbH265EncUpdateParameter every picture in flight can hold its own
+    // set next to the active one
+    encHandlePtr->sequenceControlSetPoolTotalCount = MAX(
+        EB_SequenceControlSetPoolInitCount,
+        encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->pictureControlSetPoolInitCount + 1);
+
+    encHandlePtr->memoryContext.subsystem = EB_MEMORY_SEQUENCE_CONTROL_SET;
     return_error = EbSystemResourceCtor(
         &encHandlePtr->sequenceControlSetPoolPtr,
         encHandlePtr->sequenceControlSetPoolTotalCount,
@@ -772,6 +1041,7 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
     /************************************
      * Picture Control Set: Parent
      ************************************/
+    encHandlePtr->memoryContext.subsystem = EB_MEMORY_PICTURE_CONTROL_SET;
     EB_MALLOC(EbSystemResource_t**, encHandlePtr->pictureParentControlSetPoolPtrArray, sizeof(EbSystemResource_t*)  * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
     EB_MALLOC(EbFifo_t***, encHandlePtr->pictureParentControlSetPoolProducerFifoPtrDblArray, sizeof(EbSystemResource_t**) * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
 
@@ -798,6 +1068,7 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
         inputData.encMode = encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->staticConfig.encMode;
         inputData.speedControl = (EB_U8)encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->staticConfig.speedControlFlag;
         inputData.segmentOvEnabled = encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->staticConfig.segmentOvEnabled;
+        inputData.enableWppFlag = (EB_BOOL)encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->staticConfig.enableWppFlag;
         //inputData.tune = encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->staticConfig.tune;
 	    return_error = EbSystemResourceCtor(
             &(encHandlePtr->pictureParentControlSetPoolPtrArray[instanceIndex]),
@@ -862,6 +1133,7 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
 
         inputData.encMode = encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->staticConfig.encMode;
         inputData.speedControl = (EB_U8)encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->staticConfig.speedControlFlag;
+        inputData.enableWppFlag = (EB_BOOL)encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->staticConfig.enableWppFlag;
         return_error = EbSystemResourceCtor(
             &(encHandlePtr->pictureControlSetPoolPtrArray[instanceIndex]),
             encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->pictureControlSetPoolInitCountChild, //EB_PictureControlSetPoolInitCountChild,
@@ -880,6 +1152,8 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
     /************************************
      * Picture Buffers
      ************************************/
+    encHandlePtr->memoryContext.subsystem = EB_MEMORY_PICTURE_BUFFERS;
+    encHandlePtr->memoryContext.hugePages = encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig.hugePages;
 
     // Allocate Resource Arrays
     EB_MALLOC(EbSystemResource_t**, encHandlePtr->referencePicturePoolPtrArray, sizeof(EbSystemResource_t*) * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
@@ -1003,6 +1277,7 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
     /************************************
      * System Resource Managers & Fifos
      ************************************/
+    encHandlePtr->memoryContext.subsystem = EB_MEMORY_SYSTEM_RESOURCES;
 
     // EB_BUFFERHEADERTYPE Input
     return_error = EbSystemResourceCtor(
@@ -1019,6 +1294,12 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
     if (return_error == EB_ErrorInsufficientResources){
         return EB_ErrorInsufficientResources;
     }
+
+    // Only the picture buffers are mapped on huge pages
+    encHandlePtr->memoryContext.hugePages = EB_HUGE_PAGES_OFF;
+
+    EbHevcBindPicturePools(encHandlePtr);
+
     // EB_BUFFERHEADERTYPE Output Stream
     EB_MALLOC(EbSystemResource_t**, encHandlePtr->outputStreamBufferResourcePtrArray, sizeof(EbSystemResource_t*) * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
     EB_MALLOC(EbFifo_t***, encHandlePtr->outputStreamBufferProducerFifoPtrDblArray, sizeof(EbFifo_t**)          * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
@@ -1034,7 +1315,7 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
             &encHandlePtr->outputStreamBufferConsumerFifoPtrDblArray[instanceIndex],
             EB_TRUE,
             EbOutputBufferHeaderCtor,
-            &encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig);
+            encHandlePtr);
         if (return_error == EB_ErrorInsufficientResources){
             return EB_ErrorInsufficientResources;
         }
@@ -1302,6 +1583,7 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
     /************************************
      * Contexts
      ************************************/
+    encHandlePtr->memoryContext.subsystem = EB_MEMORY_PROCESS_CONTEXTS;
 
     // Resource Coordination Context
     return_error = ResourceCoordinationContextCtor(
@@ -1415,7 +1697,8 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
         (RateControlContext_t**) &encHandlePtr->rateControlContextPtr,
         encHandlePtr->rateControlTasksConsumerFifoPtrArray[0],
         encHandlePtr->rateControlResultsProducerFifoPtrArray[0],
-        encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->intraPeriodLength);
+        encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->intraPeriodLength,
+        &encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig);
     if (return_error == EB_ErrorInsufficientResources){
         return EB_ErrorInsufficientResources;
     }
@@ -1494,69 +1777,73 @@ EB_API EB_ERRORTYPE EbInitEncoder(EB_COMPONENTTYPE *h265EncComponent)
     /************************************
      * Thread Handles
      ************************************/
+    encHandlePtr->memoryContext.subsystem = EB_MEMORY_ENCODER_HANDLE;
     EB_H265_ENC_CONFIGURATION   *configPtr = &encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig;
 
-    EbHevcSetThreadManagementParameters(configPtr);
+    EbHevcSetThreadManagementParameters(&encHandlePtr->threadAffinity, configPtr);
 
     // Resource Coordination
-    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->resourceCoordinationThreadHandle, sizeof(EB_HANDLE), EB_THREAD, ResourceCoordinationKernel, encHandlePtr->resourceCoordinationContextPtr);
+    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->resourceCoordinationThreadHandle, sizeof(EB_HANDLE), EB_THREAD, ResourceCoordinationKernel, encHandlePtr->resourceCoordinationContextPtr, &encHandlePtr->threadAffinity);
 
     // Picture Analysis
     EB_MALLOC(EB_HANDLE*, encHandlePtr->pictureAnalysisThreadHandleArray, sizeof(EB_HANDLE) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->pictureAnalysisProcessInitCount, EB_N_PTR);
 
     for(processIndex=0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->pictureAnalysisProcessInitCount; ++processIndex) {
-        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->pictureAnalysisThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, PictureAnalysisKernel, encHandlePtr->pictureAnalysisContextPtrArray[processIndex]);
+        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->pictureAnalysisThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, PictureAnalysisKernel, encHandlePtr->pictureAnalysisContextPtrArray[processIndex], &encHandlePtr->threadAffinity);
     }
 
     // Picture Decision
-    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->pictureDecisionThreadHandle, sizeof(EB_HANDLE), EB_THREAD, PictureDecisionKernel, encHandlePtr->pictureDecisionContextPtr);
+    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->pictureDecisionThreadHandle, sizeof(EB_HANDLE), EB_THREAD, PictureDecisionKernel, encHandlePtr->pictureDecisionContextPtr, &encHandlePtr->threadAffinity);
 
     // Motion Estimation
     EB_MALLOC(EB_HANDLE*, encHandlePtr->motionEstimationThreadHandleArray, sizeof(EB_HANDLE) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->motionEstimationProcessInitCount, EB_N_PTR);
 
     for(processIndex=0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->motionEstimationProcessInitCount; ++processIndex) {
-        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->motionEstimationThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, MotionEstimationKernel, encHandlePtr->motionEstimationContextPtrArray[processIndex]);
+        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->motionEstimationThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, MotionEstimationKernel, encHandlePtr->motionEstimationContextPtrArray[processIndex], &encHandlePtr->threadAffinity);
     }
 
     // Initial Rate Control
-    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->initialRateControlThreadHandle, sizeof(EB_HANDLE), EB_THREAD, InitialRateControlKernel, encHandlePtr->initialRateControlContextPtr);
+    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->initialRateControlThreadHandle, sizeof(EB_HANDLE), EB_THREAD, InitialRateControlKernel, encHandlePtr->initialRateControlContextPtr, &encHandlePtr->threadAffinity);
 
 	// Source Based Oprations
     EB_MALLOC(EB_HANDLE*, encHandlePtr->sourceBasedOperationsThreadHandleArray, sizeof(EB_HANDLE) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->sourceBasedOperationsProcessInitCount, EB_N_PTR);
 
     for (processIndex = 0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->sourceBasedOperationsProcessInitCount; ++processIndex) {
-	    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->sourceBasedOperationsThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, SourceBasedOperationsKernel, encHandlePtr->sourceBasedOperationsContextPtrArray[processIndex]);
+	    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->sourceBasedOperationsThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, SourceBasedOperationsKernel, encHandlePtr->sourceBasedOperationsContextPtrArray[processIndex], &encHandlePtr->threadAffinity);
     }
 
     // Picture Manager
-    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->pictureManagerThreadHandle, sizeof(EB_HANDLE), EB_THREAD, PictureManagerKernel, encHandlePtr->pictureManagerContextPtr);
+    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->pictureManagerThreadHandle, sizeof(EB_HANDLE), EB_THREAD, PictureManagerKernel, encHandlePtr->pictureManagerContextPtr, &encHandlePtr->threadAffinity);
 
     // Rate Control
-    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->rateControlThreadHandle, sizeof(EB_HANDLE), EB_THREAD, RateControlKernel, encHandlePtr->rateControlContextPtr);
+    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->rateControlThreadHandle, sizeof(EB_HANDLE), EB_THREAD, RateControlKernel, encHandlePtr->rateControlContextPtr, &encHandlePtr->threadAffinity);
 
     // Mode Decision Configuration Process
     EB_MALLOC(EB_HANDLE*, encHandlePtr->modeDecisionConfigurationThreadHandleArray, sizeof(EB_HANDLE) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->modeDecisionConfigurationProcessInitCount, EB_N_PTR);
 
     for(processIndex=0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->modeDecisionConfigurationProcessInitCount; ++processIndex) {
-        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->modeDecisionConfigurationThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, ModeDecisionConfigurationKernel, encHandlePtr->modeDecisionConfigurationContextPtrArray[processIndex]);
+        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->modeDecisionConfigurationThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, ModeDecisionConfigurationKernel, encHandlePtr->modeDecisionConfigurationContextPtrArray[processIndex], &encHandlePtr->threadAffinity);
     }
 
     // EncDec Process
     EB_MALLOC(EB_HANDLE*, encHandlePtr->encDecThreadHandleArray, sizeof(EB_HANDLE) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->encDecProcessInitCount, EB_N_PTR);
 
     for(processIndex=0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->encDecProcessInitCount; ++processIndex) {
-        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->encDecThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, EncDecKernel, encHandlePtr->encDecContextPtrArray[processIndex]);
+        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->encDecThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, EncDecKernel, encHandlePtr->encDecContextPtrArray[processIndex], &encHandlePtr->threadAffinity);
     }
 
     // Entropy Coding Process
     EB_MALLOC(EB_HANDLE*, encHandlePtr->entropyCodingThreadHandleArray, sizeof(EB_HANDLE) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->entropyCodingProcessInitCount, EB_N_PTR);
 
     for(processIndex=0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->entropyCodingProcessInitCount; ++processIndex) {
-        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->entropyCodingThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, EntropyCodingKernel, encHandlePtr->entropyCodingContextPtrArray[processIndex]);
+        EB_CREATETHREAD(EB_HANDLE, encHandlePtr->entropyCodingThreadHandleArray[processIndex], sizeof(EB_HANDLE), EB_THREAD, EntropyCodingKernel, encHandlePtr->entropyCodingContextPtrArray[processIndex], &encHandlePtr->threadAffinity);
     }
 
     // Packetization
-    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->packetizationThreadHandle, sizeof(EB_HANDLE), EB_THREAD, PacketizationKernel, encHandlePtr->packetizationContextPtr);
+    EB_CREATETHREAD(EB_HANDLE, encHandlePtr->packetizationThreadHandle, sizeof(EB_HANDLE), EB_THREAD, PacketizationKernel, encHandlePtr->packetizationContextPtr, &encHandlePtr->threadAffinity);
+
+    encHandlePtr->encoderStartTime = EbMonotonicTimeUs();
+    encHandlePtr->balanceTime = encHandlePtr->encoderStartTime;
 
 #if DISPLAY_MEMORY
     EB_MEMORY();
@@ -1578,6 +1865,20 @@ EB_API EB_ERRORTYPE EbDeinitEncoder(EB_COMPONENTTYPE *h265EncComponent)
     EbMemoryMapEntry*   memoryEntry  = (EbMemoryMapEntry*)EB_NULL;
 
     if (encHandlePtr){
+        void (*outputStreamFree)(uint8_t*) = encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig.outputStreamFree;
+
+        EbEncHandleBind(encHandlePtr);
+
+        // Every thread takes its end object, so none may stay parked
+        if (encHandlePtr->encDecResultsResourcePtr) {
+            EbSetFullObjectConcurrency(encHandlePtr->resourceCoordinationResultsResourcePtr, ~0u);
+            EbSetFullObjectConcurrency(encHandlePtr->pictureDecisionResultsResourcePtr, ~0u);
+            EbSetFullObjectConcurrency(encHandlePtr->initialRateControlResultsResourcePtr, ~0u);
+            EbSetFullObjectConcurrency(encHandlePtr->rateControlResultsResourcePtr, ~0u);
+            EbSetFullObjectConcurrency(encHandlePtr->encDecTasksResourcePtr, ~0u);
+            EbSetFullObjectConcurrency(encHandlePtr->encDecResultsResourcePtr, ~0u);
+        }
+
         //Jing: Send signal to quit thread
         EB_SEND_END_OBJ(encHandlePtr->inputBufferProducerFifoPtrArray, EB_ResourceCoordinationProcessInitCount)
         EB_SEND_END_OBJ(encHandlePtr->resourceCoordinationResultsProducerFifoPtrArray, encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->pictureAnalysisProcessInitCount)
@@ -1592,7 +1893,7 @@ EB_API EB_ERRORTYPE EbDeinitEncoder(EB_COMPONENTTYPE *h265EncComponent)
         EB_SEND_END_OBJ(encHandlePtr->encDecResultsProducerFifoPtrArray, encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->entropyCodingProcessInitCount)
         EB_SEND_END_OBJ(encHandlePtr->entropyCodingResultsProducerFifoPtrArray, EB_PacketizationProcessInitCount)
 
-        if (encHandlePtr->memoryMapIndex){
+        if (encHandlePtr->memoryContext.memoryMapIndex){
             // Loop through the ptr table and free all malloc'd pointers per channel
 
             // Destroy all the kernel threads at first as the work around for race condition.
@@ -1600,8 +1901,8 @@ EB_API EB_ERRORTYPE EbDeinitEncoder(EB_COMPONENTTYPE *h265EncComponent)
             // at any time, when some kernel threads may keep processing. So that some of them
             // (such as EncDecKernel) still need to access to the memory resources which would
             // be freed (but should have been unreferenced).
-            for (ptrIndex = (encHandlePtr->memoryMapIndex) - 1; ptrIndex >= 0; --ptrIndex) {
-                memoryEntry = &encHandlePtr->memoryMap[ptrIndex];
+            for (ptrIndex = (encHandlePtr->memoryContext.memoryMapIndex) - 1; ptrIndex >= 0; --ptrIndex) {
+                memoryEntry = &encHandlePtr->memoryContext.memoryMap[ptrIndex];
                 switch (memoryEntry->ptrType) {
                 case EB_THREAD:
                     EbDestroyThread(memoryEntry->ptr);
@@ -1611,8 +1912,25 @@ EB_API EB_ERRORTYPE EbDeinitEncoder(EB_COMPONENTTYPE *h265EncComponent)
                 }
             }
 
-            for (ptrIndex = (encHandlePtr->memoryMapIndex) - 1; ptrIndex >= 0; --ptrIndex) {
-                memoryEntry = &encHandlePtr->memoryMap[ptrIndex];
+            // The SEI and RPU payloads of the input pictures are not in the memory map
+            if (encHandlePtr->inputBufferResourcePtr) {
+                EB_U32 objectIndex;
+                for (objectIndex = 0; objectIndex < encHandlePtr->inputBufferResourcePtr->objectTotalCount; ++objectIndex) {
+                    EbObjectWrapper_t *wrapperPtr = encHandlePtr->inputBufferResourcePtr->wrapperPtrPool[objectIndex];
+                    EbPictureBufferDesc_t *inputPicturePtr;
+                    if (wrapperPtr == EB_NULL || wrapperPtr->objectPtr == EB_NULL) {
+                        break;
+                    }
+                    inputPicturePtr = (EbPictureBufferDesc_t*)((EB_BUFFERHEADERTYPE*)wrapperPtr->objectPtr)->pBuffer;
+                    if (inputPicturePtr) {
+                        CopyInputPayload(&inputPicturePtr->userSeiMsg, NULL, 0);
+                        CopyInputPayload(&inputPicturePtr->dolbyVisionRpu, NULL, 0);
+                    }
+                }
+            }
+
+            for (ptrIndex = (encHandlePtr->memoryContext.memoryMapIndex) - 1; ptrIndex >= 0; --ptrIndex) {
+                memoryEntry = &encHandlePtr->memoryContext.memoryMap[ptrIndex];
                 switch (memoryEntry->ptrType) {
                 case EB_N_PTR:
                     free(memoryEntry->ptr);
@@ -1630,14 +1948,21 @@ EB_API EB_ERRORTYPE EbDeinitEncoder(EB_COMPONENTTYPE *h265EncComponent)
                 case EB_MUTEX:
                     EbDestroyMutex(memoryEntry->ptr);
                     break;
+                case EB_APP_PTR:
+                    outputStreamFree((uint8_t*)memoryEntry->ptr);
+                    break;
+                case EB_HUGE_PTR:
+                    EbArenaFreeHugeBlock(memoryEntry->ptr);
+                    break;
                 default:
                     return_error = EB_ErrorMax;
                     break;
                 }
             }
 
-            if (encHandlePtr->memoryMap != (EbMemoryMapEntry*) NULL) {
-                free(encHandlePtr->memoryMap);
+            if (encHandlePtr->memoryContext.memoryMap != (EbMemoryMapEntry*) NULL) {
+                free(encHandlePtr->memoryContext.memoryMap);
+                encHandlePtr->memoryContext.memoryMap = (EbMemoryMapEntry*) NULL;
             }
 
             //(void)(encHandlePtr);
@@ -1663,14 +1988,6 @@ EB_API EB_ERRORTYPE EbInitHandle(
 {
     EB_ERRORTYPE           return_error = EB_ErrorNone;
 
-    #if  defined(__linux__)
-    if(lpGroup == EB_NULL) {
-        lpGroup = (processorGroup*) malloc(sizeof(processorGroup) * INITIAL_PROCESSOR_GROUP);
-        if (lpGroup == (processorGroup*) EB_NULL)
-            return EB_ErrorInsufficientResources;
-    }
-    #endif
-
     *pHandle = (EB_COMPONENTTYPE*) malloc(sizeof(EB_COMPONENTTYPE));
     if (*pHandle != (EB_HANDLETYPE) NULL) {
 
@@ -1705,6 +2022,9 @@ EB_ERRORTYPE EbH265EncComponentDeInit(EB_COMPONENTTYPE  *h265EncComponent)
     EB_ERRORTYPE       return_error        = EB_ErrorNone;
 
     if (h265EncComponent->pComponentPrivate) {
+#if defined(__linux__)
+        free(((EbEncHandle_t *)h265EncComponent->pComponentPrivate)->threadAffinity.lpGroup);
+#endif
         free((EbEncHandle_t *)h265EncComponent->pComponentPrivate);
     }
     else {
@@ -1726,6 +2046,10 @@ EB_API EB_ERRORTYPE EbDeinitHandle(
     EB_ERRORTYPE return_error = EB_ErrorNone;
 
     if (h265EncComponent) {
+        // Do not leave the calling thread bound to the freed instance
+        if (h265EncComponent->pComponentPrivate && memoryContextPtr == &((EbEncHandle_t*)h265EncComponent->pComponentPrivate)->memoryContext) {
+            memoryContextPtr = (EbMemoryContext_t*)EB_NULL;
+        }
         return_error = EbH265EncComponentDeInit(h265EncComponent);
 
         free(h265EncComponent);
@@ -1734,13 +2058,6 @@ EB_API EB_ERRORTYPE EbDeinitHandle(
         return_error = EB_ErrorInvalidComponent;
     }
 
-    #if  defined(__linux__)
-    if(lpGroup != EB_NULL) {
-        free(lpGroup);
-        lpGroup = EB_NULL;
-    }
-    #endif
-
     return return_error;
 }
 
@@ -1773,8 +2090,139 @@ EB_U32 SetParentPcs(EB_H265_ENC_CONFIGURATION*   config)
     return inputPic;
 }
 
+/*********************************************************************************
+* Picture pool sizing
+*   The reference objects are taken in display order as the pictures leave the
+*   lookahead and are released once the pictures predicting from them are coded,
+*   so a mini-GOP and the base layer picture before it always fit in
+*   (1 << hierarchicalLevels) + 2 objects. The PA references are taken at input and
+*   released after motion estimation; the picture decision also holds the SCD_LAD
+*   pictures of the scene change window. Anything above these floors only lets
+*   more pictures be in flight.
+*********************************************************************************/
+#define REFERENCE_POOL_FLOOR(miniGopSize)       ((miniGopSize) + 2)
+#define PA_REFERENCE_POOL_FLOOR(miniGopSize)    ((miniGopSize) + SCD_LAD + 2)
+
+static EB_U64 PictureSampleCount(
+    EB_U32                      width,
+    EB_U32                      height,
+    EB_U32                      padding,
+    EB_U32                      colorFormat)
+{
+    EB_U64 lumaCount = (EB_U64)(width + (padding << 1)) * (height + (padding << 1));
+    EB_U64 chromaCount = (colorFormat == EB_YUV400) ? 0 :
+                         (colorFormat == EB_YUV420) ? lumaCount >> 1 :
+                         (colorFormat == EB_YUV422) ? lumaCount : lumaCount << 1;
+
+    return lumaCount + chromaCount;
+}
+
+/*********************************************************************************
+* EstimatePicturePoolBytes
+*   Bytes held by the picture sized buffers of the input, parent picture control
+*   set, reference and PA reference pools for the given counts. The fixed size
+*   contexts are left out, they do not scale with the pool counts.
+*********************************************************************************/
+static EB_U64 EstimatePicturePoolBytes(
+    SequenceControlSet_t       *sequenceControlSetPtr,
+    EB_U32                      inputPic,
+    EB_U32                      referenceCount,
+    EB_U32                      paReferenceCount)
+{
+    EB_U32 width = sequenceControlSetPtr->maxInputLumaWidth;
+    EB_U32 height = sequenceControlSetPtr->maxInputLumaHeight;
+    EB_U32 colorFormat = sequenceControlSetPtr->chromaFormatIdc;
+    EB_U32 sampleSize = (sequenceControlSetPtr->staticConfig.encoderBitDepth > 8) ? 2 : 1;
+    EB_U64 lcuTotalCount = (EB_U64)((width + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE) * ((height + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE);
+
+    EB_U64 inputBytes = PictureSampleCount(width, height, sequenceControlSetPtr->leftPadding, colorFormat) * sampleSize;
+
+    EB_U64 parentPcsBytes = lcuTotalCount * (
+        sizeof(EB_U16) * LCU_VARIANCE_STRIDE +
+        sizeof(EB_U8) * (LCU_Y_MEAN_STRIDE + 2 * LCU_CHROMA_MEAN_STRIDE) +
+        sizeof(MeCuResults_t) * MAX_ME_PU_COUNT +
+        sizeof(OisCu32Cu16Results_t) + sizeof(OisCu8Results_t) +
+        sizeof(EB_U64) * LCU_VAR_OF_VAR_STRIDE);
+
+    // Reconstructed picture and the 8 bit denoised source
+    EB_U64 referenceBytes =
+        PictureSampleCount(width, height, MAX_LCU_SIZE + MCPXPaddingOffset, colorFormat) * (sampleSize + 1) +
+        lcuTotalCount * (sizeof(TmvpUnit_t) + 2 * sizeof(EB_U8));
+
+    // The full resolution luma is shared with the input picture
+    EB_U64 paReferenceBytes =
+        PictureSampleCount(width >> 1, height >> 1, sequenceControlSetPtr->lcuSize >> 1, EB_YUV400) +
+        PictureSampleCount(width >> 2, height >> 2, sequenceControlSetPtr->lcuSize >> 2, EB_YUV400) +
+        lcuTotalCount * (sizeof(EB_U16) + sizeof(EB_U8));
+
+    return (EB_U64)(inputPic + SCD_LAD) * inputBytes +
+           (EB_U64)inputPic * parentPcsBytes +
+           (EB_U64)referenceCount * referenceBytes +
+           (EB_U64)paReferenceCount * paReferenceBytes;
+}
+
+/*********************************************************************************
+* SetPicturePoolCounts
+*   Sizes the parent picture control set, input, reference and PA reference pools
+*   from the prediction structure and the lookahead. When memoryBudgetMB is set and
+*   exceeded, the latency is lowered first, then the lookahead, then the pools
+*   that only add throughput are cut down to their floors.
+*********************************************************************************/
+static void SetPicturePoolCounts(
+    SequenceControlSet_t       *sequenceControlSetPtr)
+{
+    EB_H265_ENC_CONFIGURATION *config = &sequenceControlSetPtr->staticConfig;
+    EB_U32 miniGopSize = 1 << config->hierarchicalLevels;
+    EB_U32 inputPic = SetParentPcs(config);
+    EB_U32 referenceCount = REFERENCE_POOL_FLOOR(miniGopSize) + sequenceControlSetPtr->pictureControlSetPoolInitCountChild;
+    EB_U32 paReferenceCount = PA_REFERENCE_POOL_FLOOR(miniGopSize) + miniGopSize;
+
+    if (config->memoryBudgetMB != 0) {
+        EB_U64 budgetBytes = (EB_U64)config->memoryBudgetMB << 20;
+        EB_U32 lookAheadDistance = config->lookAheadDistance;
+        EB_U32 minLookAheadDistance = (config->rateControlMode || config->rcPass == 2) ? MIN(lookAheadDistance, miniGopSize) : 0;
+        EB_U32 minInputPic = (2 << config->hierarchicalLevels) + SCD_LAD;
+        EB_U32 defaultInputPic = inputPic;
+        EB_U64 footprintBytes;
+
+        // The lowest latency, as the fast presets run with
+        while (inputPic > minInputPic + lookAheadDistance &&
+            EstimatePicturePoolBytes(sequenceControlSetPtr, inputPic, MIN(inputPic, referenceCount), MIN(inputPic, paReferenceCount)) > budgetBytes)
+            --inputPic;
+
+        while (lookAheadDistance > minLookAheadDistance &&
+            EstimatePicturePoolBytes(sequenceControlSetPtr, inputPic, MIN(inputPic, referenceCount), MIN(inputPic, paReferenceCount)) > budgetBytes) {
+            --lookAheadDistance;
+            --inputPic;
+        }
+
+        if (EstimatePicturePoolBytes(sequenceControlSetPtr, inputPic, MIN(inputPic, referenceCount), MIN(inputPic, paReferenceCount)) > budgetBytes) {
+            referenceCount = REFERENCE_POOL_FLOOR(miniGopSize);
+            paReferenceCount = PA_REFERENCE_POOL_FLOOR(miniGopSize);
+        }
+
+        if (lookAheadDistance != config->lookAheadDistance)
+            SVT_LOG("SVT [Warning]: The memory budget of %u MB lowers the lookahead distance from %u to %u\n", config->memoryBudgetMB, config->lookAheadDistance, lookAheadDistance);
+        if (inputPic != defaultInputPic)
+            SVT_LOG("SVT [Warning]: The memory budget of %u MB lowers the latency from %u to %u pictures\n", config->memoryBudgetMB, defaultInputPic, inputPic);
+
+        footprintBytes = EstimatePicturePoolBytes(sequenceControlSetPtr, inputPic, MIN(inputPic, referenceCount), MIN(inputPic, paReferenceCount));
+        if (footprintBytes > budgetBytes)
+            SVT_LOG("SVT [Warning]: The picture buffers need %u MB, above the memory budget of %u MB\n", (EB_U32)((footprintBytes + (1 << 20) - 1) >> 20), config->memoryBudgetMB);
+
+        config->lookAheadDistance = lookAheadDistance;
+    }
+
+    sequenceControlSetPtr->pictureControlSetPoolInitCount       = inputPic;
+    sequenceControlSetPtr->inputOutputBufferFifoInitCount       = inputPic + SCD_LAD;
+    sequenceControlSetPtr->referencePictureBufferInitCount      = MIN(inputPic, referenceCount);
+    sequenceControlSetPtr->paReferencePictureBufferInitCount    = MIN(inputPic, paReferenceCount);
+    sequenceControlSetPtr->reconBufferFifoInitCount             = inputPic;
+}
+
 void LoadDefaultBufferConfigurationSettings(
-    SequenceControlSet_t       *sequenceControlSetPtr
+    SequenceControlSet_t       *sequenceControlSetPtr,
+    EB_U8                       numGroups
 )
 {
     EB_U32 encDecSegH = ((sequenceControlSetPtr->maxInputLumaHeight + 32) / MAX_LCU_SIZE);
@@ -1786,13 +2234,10 @@ void LoadDefaultBufferConfigurationSettings(
     EB_U16 tileColCount = sequenceControlSetPtr->staticConfig.tileColumnCount;
     EB_U16 tileRowCount = sequenceControlSetPtr->staticConfig.tileRowCount;
 
-    EB_U32 inputPic = SetParentPcs(&sequenceControlSetPtr->staticConfig);
-
-    unsigned int lpCount = EbHevcGetNumProcessors();
+    unsigned int lpCount = EbHevcGetNumProcessors(numGroups);
     unsigned int coreCount = lpCount;
 
     unsigned int totalThreadCount;
-    unsigned int threadUnit;
 
 #if defined(_WIN32) || defined(__linux__)
     if (sequenceControlSetPtr->staticConfig.targetSocket != -1)
@@ -1817,23 +2262,16 @@ void LoadDefaultBufferConfigurationSettings(
         coreCount = lpCount;
 #endif
 
-    // Thread count computation
+    coreCount = EbHevcGetEffectiveCoreCount(coreCount);
+    sequenceControlSetPtr->coreCount = coreCount;
+
+    // Thread count computation. The parallel stages share the threads in
+    // units of 1/EB_THREAD_COUNT_MIN_CORE; how many of them run at a time
+    // is balanced at run time, see EbHevcBalanceStages.
     if (sequenceControlSetPtr->staticConfig.threadCount != 0)
         totalThreadCount = sequenceControlSetPtr->staticConfig.threadCount;
     else
-        totalThreadCount = coreCount * EB_THREAD_COUNT_FACTOR;
-
-    if (totalThreadCount < EB_THREAD_COUNT_MIN_CORE * EB_THREAD_COUNT_FACTOR) {
-        totalThreadCount = EB_THREAD_COUNT_MIN_CORE * EB_THREAD_COUNT_FACTOR;
-    }
-
-    if (totalThreadCount % EB_THREAD_COUNT_MIN_CORE) {
-        totalThreadCount = (totalThreadCount + EB_THREAD_COUNT_MIN_CORE - 1)
-                           / EB_THREAD_COUNT_MIN_CORE * EB_THREAD_COUNT_MIN_CORE;
-    }
-    threadUnit = totalThreadCount / EB_THREAD_COUNT_MIN_CORE;
-
-    sequenceControlSetPtr->inputOutputBufferFifoInitCount = inputPic + SCD_LAD;
+        totalThreadCount = MAX(coreCount * EB_THREAD_COUNT_FACTOR, EB_THREAD_COUNT_MIN_CORE);
 
     // ME segments
     sequenceControlSetPtr->meSegmentRowCountArray[0] = meSegH;
@@ -1886,11 +2324,8 @@ void LoadDefaultBufferConfigurationSettings(
     sequenceControlSetPtr->tileGroupRowCountArray[5] = tileGroupRowCount;
 
     //#====================== Data Structures and Picture Buffers ======================
-    sequenceControlSetPtr->pictureControlSetPoolInitCount       = inputPic;
     sequenceControlSetPtr->pictureControlSetPoolInitCountChild  = MAX(4, coreCount / 6);
-    sequenceControlSetPtr->referencePictureBufferInitCount      = inputPic;//MAX((EB_U32)(sequenceControlSetPtr->inputOutputBufferFifoInitCount >> 1), (EB_U32)((1 << sequenceControlSetPtr->staticConfig.hierarchicalLevels) + 2));
-    sequenceControlSetPtr->paReferencePictureBufferInitCount    = inputPic;//MAX((EB_U32)(sequenceControlSetPtr->inputOutputBufferFifoInitCount >> 1), (EB_U32)((1 << sequenceControlSetPtr->staticConfig.hierarchicalLevels) + 2));
-    sequenceControlSetPtr->reconBufferFifoInitCount             = sequenceControlSetPtr->referencePictureBufferInitCount;
+    SetPicturePoolCounts(sequenceControlSetPtr);
 
     //#====================== Inter process Fifos ======================
     sequenceControlSetPtr->resourceCoordinationFifoInitCount = 300;
@@ -1908,16 +2343,21 @@ void LoadDefaultBufferConfigurationSettings(
 
     //#====================== Processes number ======================
     sequenceControlSetPtr->totalProcessInitCount = 0;
-    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->pictureAnalysisProcessInitCount           = threadUnit * 4;
-    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->motionEstimationProcessInitCount          = threadUnit * 8;
-    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->sourceBasedOperationsProcessInitCount     = threadUnit * 2;
-    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->modeDecisionConfigurationProcessInitCount = threadUnit * 2;
-    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->entropyCodingProcessInitCount             = threadUnit * 4;
+    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->pictureAnalysisProcessInitCount           = MAX(totalThreadCount * 4 / EB_THREAD_COUNT_MIN_CORE, 1);
+    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->motionEstimationProcessInitCount          = MAX(totalThreadCount * 8 / EB_THREAD_COUNT_MIN_CORE, 1);
+    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->sourceBasedOperationsProcessInitCount     = MAX(totalThreadCount * 2 / EB_THREAD_COUNT_MIN_CORE, 1);
+    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->modeDecisionConfigurationProcessInitCount = MAX(totalThreadCount * 2 / EB_THREAD_COUNT_MIN_CORE, 1);
+    sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->entropyCodingProcessInitCount             = MAX(totalThreadCount * 4 / EB_THREAD_COUNT_MIN_CORE, 1);
     sequenceControlSetPtr->totalProcessInitCount += 6; // single processes count
     sequenceControlSetPtr->totalProcessInitCount += sequenceControlSetPtr->encDecProcessInitCount =
-                                                    totalThreadCount - sequenceControlSetPtr->totalProcessInitCount;
+                                                    (totalThreadCount > sequenceControlSetPtr->totalProcessInitCount) ? totalThreadCount - sequenceControlSetPtr->totalProcessInitCount : 1;
+
+    // PA segments, so that the analysis of one picture spreads over all the PA processes
+    sequenceControlSetPtr->paSegmentRowCount = (EB_U16)MIN(
+        (sequenceControlSetPtr->maxInputLumaHeight + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE,
+        sequenceControlSetPtr->pictureAnalysisProcessInitCount);
 
-    SVT_LOG("Number of logical cores available: %u\nNumber of PPCS %u\n", coreCount, inputPic);
+    SVT_LOG("Number of logical cores available: %u\nNumber of PPCS %u\n", coreCount, sequenceControlSetPtr->pictureControlSetPoolInitCount);
 
     return;
 
@@ -2106,7 +2546,7 @@ EB_U32 ComputeDefaultLookAhead(
     EB_H265_ENC_CONFIGURATION*   config)
 {
     EB_S32 lad = 0;
-    if (config->rateControlMode == 0)
+    if (config->rateControlMode != 1)
         lad = 17;
     else
         lad = config->intraPeriodLength;
@@ -2221,6 +2661,9 @@ void EbHevcCopyApiFromApp(
 
     // Quantization
     sequenceControlSetPtr->qp = ((EB_H265_ENC_CONFIGURATION*)pComponentParameterStructure)->qp;
+    // CRF runs the constant QP pictures around crf
+    if (sequenceControlSetPtr->staticConfig.rateControlMode == 2)
+        sequenceControlSetPtr->qp = ((EB_H265_ENC_CONFIGURATION*)pComponentParameterStructure)->crf;
     if (((EB_H265_ENC_CONFIGURATION*)pComponentParameterStructure)->frameRate > 1000)
         sequenceControlSetPtr->frameRate = sequenceControlSetPtr->staticConfig.frameRate = ((EB_H265_ENC_CONFIGURATION*)pComponentParameterStructure)->frameRate;
     else
@@ -2282,6 +2725,10 @@ void EbHevcCopyApiFromApp(
         sequenceControlSetPtr->staticConfig.lookAheadDistance = ComputeDefaultLookAhead(&sequenceControlSetPtr->staticConfig);
     }
 
+    // VBR and the VBV model predict the rate of the pictures from the lookahead statistics
+    sequenceControlSetPtr->rateStatisticsFlag = (EB_BOOL)(sequenceControlSetPtr->staticConfig.rateControlMode == 1 ||
+        (sequenceControlSetPtr->staticConfig.vbvMaxrate && sequenceControlSetPtr->staticConfig.vbvBufsize));
+
     //Set required flags to signal vbv status when hrd is enabled
     if (sequenceControlSetPtr->staticConfig.hrdFlag == 1) {
         sequenceControlSetPtr->staticConfig.videoUsabilityInfo = 1;
@@ -2530,6 +2977,12 @@ static EB_ERRORTYPE VerifySettings(\
         }
     }
 
+    // The first rate control pass only gathers the PA / ME statistics
+    if (config->rcPass == 1 && config->encMode < sequenceControlSetPtr->maxEncMode) {
+        SVT_LOG("SVT [WARNING]: -encMode is set to %d for the first rate control pass\n", sequenceControlSetPtr->maxEncMode);
+        config->encMode = sequenceControlSetPtr->maxEncMode;
+    }
+
     if (config->qp > 51) {
         SVT_LOG("SVT [Error]: Instance %u: QP must be [0 - 51]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -2575,7 +3028,7 @@ static EB_ERRORTYPE VerifySettings(\
     }
 
     if ((config->rateControlMode == 0) && ((config->vbvBufsize > 0) || (config->vbvMaxrate > 0))) {
-        SVT_LOG("SVT [Error]: Instance %u: VBV options can not be used when RateControlMode is 1 (CQP) \n", channelNumber + 1);
+        SVT_LOG("SVT [Error]: Instance %u: VBV options can only be used when RateControlMode is 1 (VBR) or 2 (CRF) \n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
 
@@ -2619,19 +3072,19 @@ static EB_ERRORTYPE VerifySettings(\
         return_error = EB_ErrorBadParameter;
     }
 
-    if ((config->level != 0) && (config->rateControlMode) && (config->tier == 0) && ((config->targetBitRate*2) > mainTierMaxBitRate[levelIdx])){
+    if ((config->level != 0) && (config->rateControlMode == 1) && (config->tier == 0) && ((config->targetBitRate*2) > mainTierMaxBitRate[levelIdx])){
         SVT_LOG("SVT [Error]: Instance %u: Allowed MaxBitRate exceeded for level %s and tier 0 \n",channelNumber+1, levelIdc);
         return_error = EB_ErrorBadParameter;
     }
-    if ((config->level != 0) && (config->rateControlMode) && (config->tier == 1) && ((config->targetBitRate*2) > highTierMaxBitRate[levelIdx])){
+    if ((config->level != 0) && (config->rateControlMode == 1) && (config->tier == 1) && ((config->targetBitRate*2) > highTierMaxBitRate[levelIdx])){
         SVT_LOG("SVT [Error]: Instance %u: Allowed MaxBitRate exceeded for level %s and tier 1 \n",channelNumber+1, levelIdc);
         return_error = EB_ErrorBadParameter;
     }
-    if ((config->level != 0) && (config->rateControlMode) && (config->tier == 0) && ((config->targetBitRate * 3) > mainTierCPB[levelIdx])) {
+    if ((config->level != 0) && (config->rateControlMode == 1) && (config->tier == 0) && ((config->targetBitRate * 3) > mainTierCPB[levelIdx])) {
         SVT_LOG("SVT [Error]: Instance %u: Out of bound maxBufferSize for level %s and tier 0 \n",channelNumber+1, levelIdc);
         return_error = EB_ErrorBadParameter;
     }
-    if ((config->level != 0) && (config->rateControlMode) && (config->tier == 1) && ((config->targetBitRate * 3) > highTierCPB[levelIdx])) {
+    if ((config->level != 0) && (config->rateControlMode == 1) && (config->tier == 1) && ((config->targetBitRate * 3) > highTierCPB[levelIdx])) {
         SVT_LOG("SVT [Error]: Instance %u: Out of bound maxBufferSize for level %s and tier 1 \n",channelNumber+1, levelIdc);
         return_error = EB_ErrorBadParameter;
     }
@@ -2685,8 +3138,38 @@ static EB_ERRORTYPE VerifySettings(\
         SVT_LOG("SVT [Error]: Instance %u: The constrained intra must be [0 - 1] \n", channelNumber + 1);
 	    return_error = EB_ErrorBadParameter;
     }
-    if (config->rateControlMode > 1) {
-        SVT_LOG("SVT [Error]: Instance %u: The rate control mode must be [0 - 1] \n", channelNumber + 1);
+    if (config->rateControlMode > 2) {
+        SVT_LOG("SVT [Error]: Instance %u: The rate control mode must be [0 - 2] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rateControlMode == 2 && config->crf > MAX_QP_VALUE) {
+        SVT_LOG("SVT [Error]: Instance %u: The crf must be [0 - %d] \n", channelNumber + 1, MAX_QP_VALUE);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rcPass > 2) {
+        SVT_LOG("SVT [Error]: Instance %u: The rate control pass must be [0 - 2] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rcPass && config->rateControlMode != 1) {
+        SVT_LOG("SVT [Error]: Instance %u: Two-pass rate control requires RateControlMode 1 (VBR) \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rcPass == 1 && config->rcStatsCallback == NULL) {
+        SVT_LOG("SVT [Error]: Instance %u: The first rate control pass requires an rcStatsCallback \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rcPass == 1 && config->reconEnabled) {
+        SVT_LOG("SVT [Error]: Instance %u: The first rate control pass does not reconstruct the pictures \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rcPass == 2 && (config->rcStatsIn == NULL || config->rcStatsInCount == 0 || config->lookAheadDistance == 0)) {
+        SVT_LOG("SVT [Error]: Instance %u: The second rate control pass requires the first pass statistics and a lookahead \n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
 
@@ -2845,6 +3328,21 @@ static EB_ERRORTYPE VerifySettings(\
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->numaPartition > 1) {
+        SVT_LOG("SVT [Error]: Instance %u : Invalid NumaPartition flag [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->hugePages > EB_HUGE_PAGES_EXPLICIT) {
+        SVT_LOG("SVT [Error]: Instance %u : Invalid HugePages [0 - 2]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->lockFreeFifo > 1) {
+        SVT_LOG("SVT [Error]: Instance %u : Invalid LockFreeFifo flag [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->switchThreadsToRtPriority > 1) {
         SVT_LOG("SVT [Error]: Instance %u : Invalid Switch Threads To Real Time Priority flag [0 - 1]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -2875,11 +3373,51 @@ static EB_ERRORTYPE VerifySettings(\
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->enableWppFlag > 1) {
+        SVT_LOG("SVT [Error]: Instance %u : Invalid WavefrontParallelProcessing flag [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if ((config->tileColumnCount * config->tileRowCount) > 1 && config->enableWppFlag) {
+        SVT_LOG("SVT [Error]: Instance %u: WavefrontParallelProcessing is only supported in single tile mode\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->unrestrictedMotionVector > 1) {
         SVT_LOG("SVT [Error]: Instance %u : Invalid Unrestricted Motion Vector flag [0 - 1]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->subPictureReference > 1) {
+        SVT_LOG("SVT [Error]: Instance %u : Invalid SubPictureReference flag [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->subPictureReference && (config->unrestrictedMotionVector || config->predStructure != EB_PRED_LOW_DELAY_P)) {
+        SVT_LOG("SVT [Error]: Instance %u: SubPictureReference requires UnrestrictedMotionVector 0 and the low delay P prediction structure\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->stagePriority > 1) {
+        SVT_LOG("SVT [Error]: Instance %u : Invalid StagePriority flag [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->zeroCopyInput > 1) {
+        SVT_LOG("SVT [Error]: Instance %u : Invalid ZeroCopyInput flag [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->zeroCopyInput && (config->encoderBitDepth != EB_8BIT || config->inputReleaseCallback == NULL)) {
+        SVT_LOG("SVT [Error]: Instance %u: ZeroCopyInput requires 8-bit input and an inputReleaseCallback\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if ((config->outputStreamAlloc == NULL) != (config->outputStreamFree == NULL)) {
+        SVT_LOG("SVT [Error]: Instance %u: outputStreamAlloc and outputStreamFree must be set together\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     //Check tiles
     //TODO: Check maxTileCol/maxTileRow according to profile/level later
     uint32_t pictureWidthInLcu = (config->sourceWidth + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE;
@@ -2936,8 +3474,10 @@ EB_ERRORTYPE EbH265EncInitParameter(
     configPtr->tileRowCount = 1;
     configPtr->tileColumnCount = 1;
     configPtr->tileSliceMode = 0;
+    configPtr->enableWppFlag = EB_FALSE;
     configPtr->sceneChangeDetection = 1;
     configPtr->rateControlMode = 0;
+    configPtr->crf = 28;
     configPtr->lookAheadDistance = (EB_U32)~0;
     configPtr->targetBitRate = 7000000;
     configPtr->maxQpAllowed = 48;
@@ -2965,6 +3505,7 @@ EB_ERRORTYPE EbH265EncInitParameter(
     configPtr->switchThreadsToRtPriority = EB_TRUE;
     configPtr->fpsInVps      = EB_TRUE;
     configPtr->unrestrictedMotionVector = EB_TRUE;
+    configPtr->subPictureReference = EB_FALSE;
 
     configPtr->videoUsabilityInfo = 0;
     configPtr->highDynamicRangeInput = 0;
@@ -2992,6 +3533,10 @@ EB_ERRORTYPE EbH265EncInitParameter(
     // Channel info
     configPtr->logicalProcessors = 0;
     configPtr->targetSocket = -1;
+    configPtr->numaPartition = 0;
+    configPtr->hugePages = EB_HUGE_PAGES_OFF;
+    configPtr->memoryBudgetMB = 0;
+    configPtr->lockFreeFifo = LOCK_FREE_FIFO;
     configPtr->threadCount = 0;
     configPtr->channelId = 0;
     configPtr->activeChannelCount   = 1;
@@ -3026,6 +3571,23 @@ EB_ERRORTYPE EbH265EncInitParameter(
 
     //segmentOv
     configPtr->segmentOvEnabled = 0;
+
+    // Stage balancing
+    configPtr->stagePriority = 0;
+
+    // Zero-copy input
+    configPtr->zeroCopyInput = 0;
+    configPtr->inputReleaseCallback = NULL;
+
+    // Output buffer allocator
+    configPtr->outputStreamAlloc = NULL;
+    configPtr->outputStreamFree = NULL;
+
+    // Two-pass rate control
+    configPtr->rcPass = 0;
+    configPtr->rcStatsCallback = NULL;
+    configPtr->rcStatsIn = NULL;
+    configPtr->rcStatsInCount = 0;
     return return_error;
 }
 static void PrintLibParams(
@@ -3069,8 +3631,13 @@ static void PrintLibParams(
 
     SVT_LOG("\nSVT [config]: HierarchicalLevels / BaseLayerSwitchMode / PredStructure\t\t\t: %d / %d / %d ", config->hierarchicalLevels, config->baseLayerSwitchMode, config->predStructure);
 
-    if (config->rateControlMode == 1)
+    if (config->rateControlMode == 1) {
         SVT_LOG("\nSVT [config]: RCMode / TargetBitrate / LAD / SceneChange / QP Range [%u ~ %u]\t\t: VBR / %d / %d / %d ", config->minQpAllowed, config->maxQpAllowed, config->targetBitRate, config->lookAheadDistance, config->sceneChangeDetection);
+        if (config->rcPass)
+            SVT_LOG("\nSVT [config]: RC Pass\t\t\t\t\t\t\t\t\t: %d ", config->rcPass);
+    }
+    else if (config->rateControlMode == 2)
+        SVT_LOG("\nSVT [config]: BRC Mode / CRF / LookaheadDistance / SceneChange\t\t\t\t: CRF / %d / %d / %d ", config->crf, config->lookAheadDistance, config->sceneChangeDetection);
     else
         SVT_LOG("\nSVT [config]: BRC Mode / QP / LookaheadDistance / SceneChange\t\t\t\t: CQP / %d / %d / %d ", config->qp, config->lookAheadDistance, config->sceneChangeDetection);
 
@@ -3078,6 +3645,13 @@ static void PrintLibParams(
         SVT_LOG("\nSVT [config]: BitRateReduction / ImproveSharpness\t\t\t\t\t: %d / %d ", config->bitRateReduction, config->improveSharpness);
 
     SVT_LOG("\nSVT [config]: tileColumnCount / tileRowCount / tileSliceMode / Constraint MV \t\t: %d / %d / %d / %d", config->tileColumnCount, config->tileRowCount, config->tileSliceMode, !config->unrestrictedMotionVector);
+    SVT_LOG("\nSVT [config]: WavefrontParallelProcessing\t\t\t\t\t\t: %d ", config->enableWppFlag);
+    SVT_LOG("\nSVT [config]: SubPictureReference\t\t\t\t\t\t\t: %d ", config->subPictureReference);
+    SVT_LOG("\nSVT [config]: ZeroCopyInput\t\t\t\t\t\t\t\t: %d ", config->zeroCopyInput);
+    SVT_LOG("\nSVT [config]: StagePriority / LockFreeFifo\t\t\t\t\t\t: %d / %d ", config->stagePriority, config->lockFreeFifo);
+    SVT_LOG("\nSVT [config]: NumaPartition / HugePages\t\t\t\t\t\t: %d / %d ", config->numaPartition, config->hugePages);
+    if (config->memoryBudgetMB)
+        SVT_LOG("\nSVT [config]: MemoryBudgetMB\t\t\t\t\t\t\t\t: %u ", config->memoryBudgetMB);
     SVT_LOG("\nSVT [config]: De-blocking Filter / SAO Filter\t\t\t\t\t\t: %d / %d ", !config->disableDlfFlag, config->enableSaoFlag);
     SVT_LOG("\nSVT [config]: HME / UseDefaultHME\t\t\t\t\t\t\t: %d / %d ", config->enableHmeFlag, config->useDefaultMeHme);
     SVT_LOG("\nSVT [config]: MV Search Area Width / Height \t\t\t\t\t\t: %d / %d ", config->searchAreaWidth, config->searchAreaHeight);
@@ -3126,6 +3700,7 @@ EB_API EB_ERRORTYPE EbH265EncSetParameter(
     }
 
     pEncCompData = (EbEncHandle_t*)h265EncComponent->pComponentPrivate;
+    EbEncHandleBind(pEncCompData);
 
     // Acquire Config Mutex
     EbBlockOnMutex(pEncCompData->sequenceControlSetInstanceArray[instanceIndex]->configMutex);
@@ -3164,7 +3739,8 @@ EB_API EB_ERRORTYPE EbH265EncSetParameter(
         pEncCompData->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->maxTemporalLayers);
 
     LoadDefaultBufferConfigurationSettings(
-        pEncCompData->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr);
+        pEncCompData->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr,
+        pEncCompData->threadAffinity.numGroups);
 
     PrintLibParams(
         &pEncCompData->sequenceControlSetInstanceArray[instanceIndex]->sequenceControlSetPtr->staticConfig);
@@ -3190,6 +3766,8 @@ EB_API EB_ERRORTYPE EbH265EncStreamHeader(
     EbPPSConfig_t          *ppsConfig;
     EB_BUFFERHEADERTYPE    *outputStreamBuffer;
 
+    EbEncHandleBind(pEncCompData);
+
     // Output buffer Allocation
     EB_MALLOC(EB_BUFFERHEADERTYPE*, outputStreamBuffer, sizeof(EB_BUFFERHEADERTYPE), EB_N_PTR);
     EB_MALLOC(EB_U8*, outputStreamBuffer->pBuffer, sizeof(EB_U8) * PACKETIZATION_PROCESS_BUFFER_SIZE, EB_N_PTR);
@@ -3288,6 +3866,8 @@ EB_API EB_ERRORTYPE EbH265EncEosNal(
     EncodeContext_t        *encodeContextPtr = sequenceControlSetPtr->encodeContextPtr;
     EB_BUFFERHEADERTYPE    *outputStreamBuffer;
 
+    EbEncHandleBind(pEncCompData);
+
     // Output buffer Allocation
     EB_MALLOC(EB_BUFFERHEADERTYPE*, outputStreamBuffer, sizeof(EB_BUFFERHEADERTYPE), EB_N_PTR);
     EB_MALLOC(EB_U8*, outputStreamBuffer->pBuffer, sizeof(EB_U8) * PACKETIZATION_PROCESS_BUFFER_SIZE, EB_N_PTR);
@@ -3386,6 +3966,33 @@ static EB_ERRORTYPE BaseDecodeFunction(EB_U8* encodedString, EB_U32 base64Encode
     return return_error;
 }
 
+/***********************************************
+**** Copy a SEI or RPU payload to an input picture
+****   The payload lives until the input buffer is
+****   reused or the encoder is deinitialized, so
+****   the per-picture copies do not grow the arena
+************************************************/
+static EB_ERRORTYPE CopyInputPayload(
+    EB_SEI_MESSAGE              *dstPtr,
+    EB_U8                       *payloadPtr,
+    EB_U32                       payloadSize)
+{
+    free(dstPtr->payload);
+    dstPtr->payload = NULL;
+    dstPtr->payloadSize = 0;
+
+    if (payloadSize) {
+        dstPtr->payload = (EB_U8*)malloc(payloadSize);
+        if (dstPtr->payload == (EB_U8*)EB_NULL) {
+            return EB_ErrorInsufficientResources;
+        }
+        EB_MEMCPY(dstPtr->payload, payloadPtr, payloadSize);
+        dstPtr->payloadSize = payloadSize;
+    }
+
+    return EB_ErrorNone;
+}
+
 static EB_ERRORTYPE ParseSeiMetaData(
     EB_BUFFERHEADERTYPE         *dst,
     EB_BUFFERHEADERTYPE         *src)
@@ -3405,11 +4012,15 @@ static EB_ERRORTYPE ParseSeiMetaData(
     base64Encode = src->naluBase64Encode;
     base64EncodeLength = (uint32_t)strlen((char*)base64Encode);
     base64DecodeLength = (base64EncodeLength / 4) * 3;
-    EB_MALLOC(EB_U8*, base64Decode, base64DecodeLength, EB_N_PTR);
+    base64Decode = (EB_U8*)malloc(base64DecodeLength);
+    if (base64Decode == (EB_U8*)EB_NULL) {
+        return EB_ErrorInsufficientResources;
+    }
 
     return_error = BaseDecodeFunction(base64Encode, base64EncodeLength, base64Decode, base64DecodeLength);
 
     if (return_error != EB_ErrorNone) {
+        free(base64Decode);
         src->naluFound = EB_FALSE;
         SVT_LOG("\nSVT [WARNING]: SEI encoded message cannot be decoded \n ");
         return EB_ErrorBadParameter;
@@ -3418,30 +4029,32 @@ static EB_ERRORTYPE ParseSeiMetaData(
     if (src->naluNalType == NAL_UNIT_PREFIX_SEI && src->naluPrefix == 0) {
         EB_U64 currentPOC = src->pts;
         if (currentPOC == src->naluPOC) {
-            headerPtr->userSeiMsg.payloadSize = (base64EncodeLength / 4) * 3;
-            EB_MALLOC(EB_U8*, headerPtr->userSeiMsg.payload, headerPtr->userSeiMsg.payloadSize, EB_N_PTR);
             if (src->naluPayloadType == 4)
                 headerPtr->userSeiMsg.payloadType = USER_DATA_REGISTERED_ITU_T_T35;
             else if (src->naluPayloadType == 5)
                 headerPtr->userSeiMsg.payloadType = USER_DATA_UNREGISTERED;
             else {
+                free(base64Decode);
                 src->naluFound = EB_FALSE;
                 SVT_LOG("\nSVT [WARNING]: Unsupported SEI payload Type for frame %u\n ", src->naluPOC);
                 return EB_ErrorBadParameter;
             }
-            EB_MEMCPY(headerPtr->userSeiMsg.payload, base64Decode, headerPtr->userSeiMsg.payloadSize);
+            return_error = CopyInputPayload(&headerPtr->userSeiMsg, base64Decode, base64DecodeLength);
         }
         else {
+            free(base64Decode);
             src->naluFound = EB_FALSE;
             SVT_LOG("\nSVT [WARNING]: User SEI frame number %u doesn't match input frame number %" PRId64 "\n ", src->naluPOC, currentPOC);
             return EB_ErrorBadParameter;
         }
     }
     else {
+        free(base64Decode);
         src->naluFound = EB_FALSE;
         SVT_LOG("\nSVT [WARNING]: SEI message for frame %u is not inserted. Will support only PREFIX SEI message \n ", src->naluPOC);
         return EB_ErrorBadParameter;
     }
+    free(base64Decode);
     return return_error;
 }
 
@@ -3458,17 +4071,29 @@ static EB_ERRORTYPE CopyUserSei(
         config->useNaluFile = EB_FALSE;
     }
 
+    // Drop the payload of the previous picture of this buffer
+    CopyInputPayload(&dstPicturePtr->userSeiMsg, NULL, 0);
+
     // Copy User SEI metadata from input
     if (config->useNaluFile) {
         return_error = ParseSeiMetaData(dst, src);
     }
-    else {
-        dstPicturePtr->userSeiMsg.payloadSize = 0;
-        dstPicturePtr->userSeiMsg.payload = NULL;
-    }
     return return_error;
 }
 
+/***********************************************
+**** Copy Dolby Vision RPU metadata from input
+************************************************/
+static EB_ERRORTYPE CopyDolbyVisionRpu(
+    EbPictureBufferDesc_t       *inputPicturePtr,
+    EB_H265_ENC_INPUT           *inputPtr)
+{
+    return CopyInputPayload(
+        &inputPicturePtr->dolbyVisionRpu,
+        inputPtr->dolbyVisionRpu.payload,
+        inputPtr->dolbyVisionRpu.payloadSize);
+}
+
 /***********************************************
 **** Copy the input buffer from the
 **** sample application to the library buffers
@@ -3659,18 +4284,60 @@ static EB_ERRORTYPE CopyFrameBuffer(
             chromaHeight);
     }
 
-    // Copy Dolby Vision RPU metadata from input
-    if (inputPtr->dolbyVisionRpu.payloadSize) {
-        inputPicturePtr->dolbyVisionRpu.payloadSize = inputPtr->dolbyVisionRpu.payloadSize;
-        EB_MALLOC(EB_U8*, inputPicturePtr->dolbyVisionRpu.payload, inputPtr->dolbyVisionRpu.payloadSize, EB_N_PTR);
-        EB_MEMCPY(inputPicturePtr->dolbyVisionRpu.payload, inputPtr->dolbyVisionRpu.payload, inputPtr->dolbyVisionRpu.payloadSize);
+    return_error = CopyDolbyVisionRpu(inputPicturePtr, inputPtr);
+
+    return return_error;
+}
+
+/***********************************************
+**** Check that the planes of a zero-copy input
+**** follow the EB_ZERO_COPY_* layout
+************************************************/
+static EB_ERRORTYPE VerifyZeroCopyInput(
+    SequenceControlSet_t        *sequenceControlSetPtr,
+    EB_H265_ENC_INPUT           *inputPtr)
+{
+    EB_U16  subWidthCMinus1     = (sequenceControlSetPtr->chromaFormatIdc == EB_YUV444 ? 1 : 2) - 1;
+    EB_U16  subHeightCMinus1    = (sequenceControlSetPtr->chromaFormatIdc >= EB_YUV422 ? 1 : 2) - 1;
+    EB_U32  lumaStride          = sequenceControlSetPtr->lumaWidth + sequenceControlSetPtr->leftPadding + sequenceControlSetPtr->rightPadding;
+    EB_U32  chromaStride        = lumaStride >> subWidthCMinus1;
+    EB_U32  lumaOffset          = lumaStride * sequenceControlSetPtr->topPadding + sequenceControlSetPtr->leftPadding;
+    EB_U32  chromaOffset        = chromaStride * (sequenceControlSetPtr->topPadding >> subHeightCMinus1) + (sequenceControlSetPtr->leftPadding >> subWidthCMinus1);
+
+    if (inputPtr->luma == EB_NULL || inputPtr->cb == EB_NULL || inputPtr->cr == EB_NULL) {
+        return EB_ErrorBadParameter;
     }
-    else {
-        inputPicturePtr->dolbyVisionRpu.payloadSize = 0;
-        inputPicturePtr->dolbyVisionRpu.payload = NULL;
+    if (inputPtr->yStride != lumaStride || inputPtr->cbStride != chromaStride || inputPtr->crStride != chromaStride) {
+        return EB_ErrorBadParameter;
+    }
+    if ((((size_t)inputPtr->luma - lumaOffset) | ((size_t)inputPtr->cb - chromaOffset) | ((size_t)inputPtr->cr - chromaOffset)) & (EB_ZERO_COPY_ALIGNMENT - 1)) {
+        return EB_ErrorBadParameter;
     }
 
-    return return_error;
+    return EB_ErrorNone;
+}
+
+/***********************************************
+**** Point the library buffer descriptor at the
+**** padded planes of a zero-copy input
+************************************************/
+static EB_ERRORTYPE ReferenceFrameBuffer(
+    SequenceControlSet_t        *sequenceControlSetPtr,
+    EB_BUFFERHEADERTYPE         *dst,
+    EB_BUFFERHEADERTYPE         *src)
+{
+    EbPictureBufferDesc_t       *inputPicturePtr = (EbPictureBufferDesc_t*)dst->pBuffer;
+    EB_H265_ENC_INPUT           *inputPtr = (EB_H265_ENC_INPUT*)src->pBuffer;
+    EB_U16                       subWidthCMinus1 = (sequenceControlSetPtr->chromaFormatIdc == EB_YUV444 ? 1 : 2) - 1;
+    EB_U16                       subHeightCMinus1 = (sequenceControlSetPtr->chromaFormatIdc >= EB_YUV422 ? 1 : 2) - 1;
+
+    inputPicturePtr->bufferY    = inputPtr->luma - (inputPtr->yStride * sequenceControlSetPtr->topPadding + sequenceControlSetPtr->leftPadding);
+    inputPicturePtr->bufferCb   = inputPtr->cb - (inputPtr->cbStride * (sequenceControlSetPtr->topPadding >> subHeightCMinus1) + (sequenceControlSetPtr->leftPadding >> subWidthCMinus1));
+    inputPicturePtr->bufferCr   = inputPtr->cr - (inputPtr->crStride * (sequenceControlSetPtr->topPadding >> subHeightCMinus1) + (sequenceControlSetPtr->leftPadding >> subWidthCMinus1));
+
+    inputPicturePtr->appBufferPtr = (EB_PTR)src;
+
+    return CopyDolbyVisionRpu(inputPicturePtr, inputPtr);
 }
 
 static EB_ERRORTYPE  CopyInputBuffer(
@@ -3692,9 +4359,14 @@ static EB_ERRORTYPE  CopyInputBuffer(
     dst->qpValue     = src->qpValue;
     dst->sliceType   = src->sliceType;
 
-    // Copy the picture buffer
-    if(src->pBuffer != NULL)
-        return_error = CopyFrameBuffer(sequenceControlSet, dst->pBuffer, src->pBuffer);
+    // Copy or reference the picture buffer
+    ((EbPictureBufferDesc_t*)dst->pBuffer)->appBufferPtr = EB_NULL;
+    if (src->pBuffer != NULL) {
+        if (sequenceControlSet->staticConfig.zeroCopyInput)
+            return_error = ReferenceFrameBuffer(sequenceControlSet, dst, src);
+        else
+            return_error = CopyFrameBuffer(sequenceControlSet, dst->pBuffer, src->pBuffer);
+    }
 
     if (return_error != EB_ErrorNone)
         return return_error;
@@ -3727,6 +4399,18 @@ EB_API EB_ERRORTYPE EbH265EncSendPicture(
 
     EB_ERRORTYPE return_error = EB_ErrorNone;
 
+    EbEncHandleBind(encHandlePtr);
+
+    if (pBuffer != NULL && pBuffer->pBuffer != NULL && encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig.zeroCopyInput) {
+        return_error = VerifyZeroCopyInput(
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr,
+            (EB_H265_ENC_INPUT*)pBuffer->pBuffer);
+
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+
     // Take the buffer and put it into our internal queue structure
     EbGetEmptyObject(
         encHandlePtr->inputBufferProducerFifoPtrArray[0],
@@ -3743,6 +4427,16 @@ EB_API EB_ERRORTYPE EbH265EncSendPicture(
         {
             return return_error;
         }
+
+        // Mark the input with the EbH265EncUpdateParameter calls made before it
+        EbBlockOnMutex(encHandlePtr->sequenceControlSetInstanceArray[0]->configMutex);
+        ((EbPictureBufferDesc_t*)((EB_BUFFERHEADERTYPE*)ebWrapperPtr->objectPtr)->pBuffer)->parameterUpdateCount =
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->parameterUpdateCount;
+        if (encHandlePtr->sequenceControlSetInstanceArray[0]->encodeContextPtr->forceIdrPending && pBuffer->pBuffer != NULL) {
+            ((EB_BUFFERHEADERTYPE*)ebWrapperPtr->objectPtr)->sliceType = EB_IDR_PICTURE;
+            encHandlePtr->sequenceControlSetInstanceArray[0]->encodeContextPtr->forceIdrPending = EB_FALSE;
+        }
+        EbReleaseMutex(encHandlePtr->sequenceControlSetInstanceArray[0]->configMutex);
     }
 
     EbPostFullObject(ebWrapperPtr);
@@ -3750,26 +4444,6 @@ EB_API EB_ERRORTYPE EbH265EncSendPicture(
     return EB_ErrorNone;
 }
 
-static void CopyOutputBuffer(
-    EB_BUFFERHEADERTYPE   *dst,
-    EB_BUFFERHEADERTYPE   *src
-)
-{
-    // copy output bitstream fileds
-    dst->nSize         = src->nSize;
-    dst->nAllocLen     = src->nAllocLen;
-    dst->nFilledLen    = src->nFilledLen;
-    dst->pAppPrivate   = src->pAppPrivate;
-    dst->nTickCount    = src->nTickCount;
-    dst->pts           = src->pts;
-    dst->dts           = src->dts;
-    dst->nFlags        = src->nFlags;
-    dst->sliceType     = src->sliceType;
-    if (src->pBuffer)
-        EB_MEMCPY(dst->pBuffer, src->pBuffer, src->nFilledLen);
-    return;
-}
-
 static void CopyOutputReconBuffer(
     EB_BUFFERHEADERTYPE   *dst,
     EB_BUFFERHEADERTYPE   *src
@@ -3791,6 +4465,112 @@ static void CopyOutputReconBuffer(
     return;
 }
 
+/**********************************
+ * EbHevcBalanceStages
+ *   Caps how many threads of each parallel stage
+ *   run at a time so that together they do not
+ *   exceed the cores of the encoder. A stage asks
+ *   for the threads it kept busy over the last
+ *   period plus one, twice that if tasks are
+ *   queued for it; when the demands exceed the
+ *   cores they are scaled down, keeping at least
+ *   one thread per stage. With stagePriority the
+ *   later stages, those of the older pictures,
+ *   keep their demand first instead.
+ **********************************/
+static void EbHevcBalanceStages(
+    EbEncHandle_t          *encHandlePtr)
+{
+    SequenceControlSet_t   *sequenceControlSetPtr = encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr;
+    EbSystemResource_t     *resourcePtrArray[EB_BALANCED_STAGE_COUNT];
+    EbFifo_t              **fifoPtrDblArray[EB_BALANCED_STAGE_COUNT];
+    EB_U32                  threadCountArray[EB_BALANCED_STAGE_COUNT];
+    EB_U32                  demandArray[EB_BALANCED_STAGE_COUNT];
+    EB_U32                  threadTotalCount = 0;
+    EB_U32                  demandTotalCount = 0;
+    EB_U32                  spareCount;
+    EB_U32                  grantCount;
+    EB_U32                  coreCount = MAX(sequenceControlSetPtr->coreCount, EB_BALANCED_STAGE_COUNT);
+    EB_U64                  currentTime = EbMonotonicTimeUs();
+    EB_U64                  elapsedTime = currentTime - encHandlePtr->balanceTime;
+    EB_U64                  busyTime;
+    EB_U32                  stageIndex;
+    EB_U32                  processIndex;
+
+    if (elapsedTime < EB_BALANCE_PERIOD_US) {
+        return;
+    }
+    encHandlePtr->balanceTime = currentTime;
+
+    resourcePtrArray[0] = encHandlePtr->resourceCoordinationResultsResourcePtr;
+    resourcePtrArray[1] = encHandlePtr->pictureDecisionResultsResourcePtr;
+    resourcePtrArray[2] = encHandlePtr->initialRateControlResultsResourcePtr;
+    resourcePtrArray[3] = encHandlePtr->rateControlResultsResourcePtr;
+    resourcePtrArray[4] = encHandlePtr->encDecTasksResourcePtr;
+    resourcePtrArray[5] = encHandlePtr->encDecResultsResourcePtr;
+
+    fifoPtrDblArray[0] = encHandlePtr->resourceCoordinationResultsConsumerFifoPtrArray;
+    fifoPtrDblArray[1] = encHandlePtr->pictureDecisionResultsConsumerFifoPtrArray;
+    fifoPtrDblArray[2] = encHandlePtr->initialRateControlResultsConsumerFifoPtrArray;
+    fifoPtrDblArray[3] = encHandlePtr->rateControlResultsConsumerFifoPtrArray;
+    fifoPtrDblArray[4] = encHandlePtr->encDecTasksConsumerFifoPtrArray;
+    fifoPtrDblArray[5] = encHandlePtr->encDecResultsConsumerFifoPtrArray;
+
+    threadCountArray[0] = sequenceControlSetPtr->pictureAnalysisProcessInitCount;
+    threadCountArray[1] = sequenceControlSetPtr->motionEstimationProcessInitCount;
+    threadCountArray[2] = sequenceControlSetPtr->sourceBasedOperationsProcessInitCount;
+    threadCountArray[3] = sequenceControlSetPtr->modeDecisionConfigurationProcessInitCount;
+    threadCountArray[4] = sequenceControlSetPtr->encDecProcessInitCount;
+    threadCountArray[5] = sequenceControlSetPtr->entropyCodingProcessInitCount;
+
+    for (stageIndex = 0; stageIndex < EB_BALANCED_STAGE_COUNT; ++stageIndex) {
+        threadTotalCount += threadCountArray[stageIndex];
+    }
+
+    // Enough cores for every thread, nothing to balance
+    if (threadTotalCount <= coreCount) {
+        return;
+    }
+
+    for (stageIndex = 0; stageIndex < EB_BALANCED_STAGE_COUNT; ++stageIndex) {
+        busyTime = 0;
+        for (processIndex = 0; processIndex < threadCountArray[stageIndex]; ++processIndex) {
+            busyTime += fifoPtrDblArray[stageIndex][processIndex]->busyTime;
+        }
+
+        demandArray[stageIndex] = (EB_U32)((busyTime - encHandlePtr->balanceBusyTime[stageIndex] + elapsedTime - 1) / elapsedTime);
+        demandArray[stageIndex] = (EbGetFullObjectCount(resourcePtrArray[stageIndex]) > 0) ?
+            demandArray[stageIndex] * 2 + 1 :
+            demandArray[stageIndex] + 1;
+        demandArray[stageIndex] = MIN(demandArray[stageIndex], threadCountArray[stageIndex]);
+        demandTotalCount += demandArray[stageIndex];
+
+        encHandlePtr->balanceBusyTime[stageIndex] = busyTime;
+    }
+
+    // Every stage keeps one thread, the cores left go from the last stage back
+    if (demandTotalCount > coreCount && sequenceControlSetPtr->staticConfig.stagePriority) {
+        spareCount = coreCount - EB_BALANCED_STAGE_COUNT;
+        for (stageIndex = EB_BALANCED_STAGE_COUNT; stageIndex-- > 0;) {
+            grantCount = MIN(demandArray[stageIndex] - 1, spareCount);
+            demandArray[stageIndex] = grantCount + 1;
+            spareCount -= grantCount;
+        }
+        demandTotalCount = coreCount;
+    }
+
+    for (stageIndex = 0; stageIndex < EB_BALANCED_STAGE_COUNT; ++stageIndex) {
+        if (demandTotalCount > coreCount) {
+            demandArray[stageIndex] = MAX(demandArray[stageIndex] * coreCount / demandTotalCount, 1);
+        }
+        EbSetFullObjectConcurrency(
+            resourcePtrArray[stageIndex],
+            demandArray[stageIndex]);
+    }
+
+    return;
+}
+
 /**********************************
  * EbH265GetPacket sends out packet
  **********************************/
@@ -3806,6 +4586,11 @@ EB_API EB_ERRORTYPE EbH265GetPacket(
     EbEncHandle_t          *pEncCompData = (EbEncHandle_t*)h265EncComponent->pComponentPrivate;
     EbObjectWrapper_t      *ebWrapperPtr = NULL;
     EB_BUFFERHEADERTYPE    *packet;
+
+    EbEncHandleBind(pEncCompData);
+
+    EbHevcBalanceStages(pEncCompData);
+
     if (picSendDone)
         EbGetFullObject(
         (pEncCompData->outputStreamBufferConsumerFifoPtrDblArray[0])[0],
@@ -3842,9 +4627,12 @@ __attribute__((visibility("default")))
 EB_API void EbH265ReleaseOutBuffer(
     EB_BUFFERHEADERTYPE  **pBuffer)
 {
-    if ((*pBuffer)->wrapperPtr)
+    if ((*pBuffer)->wrapperPtr) {
+        EbEncHandleBind(((EbOutputStreamBuffer_t*)*pBuffer)->encHandlePtr);
+
         // Release out put buffer back into the pool
         EbReleaseObject((EbObjectWrapper_t  *)(*pBuffer)->wrapperPtr);
+    }
 
     return;
 }
@@ -3863,6 +4651,8 @@ EB_API EB_ERRORTYPE EbH265GetRecon(
     EbEncHandle_t          *pEncCompData = (EbEncHandle_t*)h265EncComponent->pComponentPrivate;
     EbObjectWrapper_t      *ebWrapperPtr = NULL;
 
+    EbEncHandleBind(pEncCompData);
+
     if (pEncCompData->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig.reconEnabled) {
 
         EbGetFullObjectNonBlocking(
@@ -3892,6 +4682,245 @@ EB_API EB_ERRORTYPE EbH265GetRecon(
 
     return return_error;
 }
+/**********************************
+* Pipeline Statistics
+**********************************/
+static void EbHevcGetStageStats(
+    EB_H265_ENC_STAGE_STATS *stageStatsPtr,
+    EbSystemResource_t      *inputResourcePtr,
+    EbFifo_t               **consumerFifoPtrArray,
+    EB_U32                   threadCount)
+{
+    EB_U32 processIndex;
+
+    stageStatsPtr->threadCount  = threadCount;
+    stageStatsPtr->queueDepth   = EbGetFullObjectCount(inputResourcePtr);
+    stageStatsPtr->taskCount    = 0;
+    stageStatsPtr->busyTimeUs   = 0;
+    stageStatsPtr->stallTimeUs  = 0;
+
+    // Each thread keeps the counters of its own consumer fifo
+    for (processIndex = 0; processIndex < threadCount; ++processIndex) {
+        stageStatsPtr->taskCount    += consumerFifoPtrArray[processIndex]->taskCount;
+        stageStatsPtr->busyTimeUs   += consumerFifoPtrArray[processIndex]->busyTime;
+        stageStatsPtr->stallTimeUs  += consumerFifoPtrArray[processIndex]->stallTime;
+    }
+
+    return;
+}
+
+/*********************************************************************************
+* EbHevcGetNumaStats
+*   Sums the segment counters of the motion estimation and EncDec threads
+**********************************************************************************/
+static void EbHevcGetNumaStats(
+    EB_H265_ENC_STATS      *statsPtr,
+    EbEncHandle_t          *encHandlePtr,
+    SequenceControlSet_t   *sequenceControlSetPtr,
+    EbNumaTopology_t       *topologyPtr)
+{
+    EB_U32 nodeIndex;
+    EB_U32 processIndex;
+
+    statsPtr->numaNodeCount = topologyPtr->nodeCount;
+
+    for (nodeIndex = 0; nodeIndex < EB_ENC_NUMA_NODE_COUNT; ++nodeIndex) {
+        EB_H265_ENC_NUMA_STATS *nodeStatsPtr = &statsPtr->numaNode[nodeIndex];
+
+        nodeStatsPtr->nodeId            = (nodeIndex < topologyPtr->nodeCount) ? topologyPtr->nodeId[nodeIndex] : 0;
+        nodeStatsPtr->placedBytes       = (nodeIndex < topologyPtr->nodeCount) ? topologyPtr->placedBytes[nodeIndex] : 0;
+        nodeStatsPtr->segmentCount          = 0;
+        nodeStatsPtr->remoteSegmentCount    = 0;
+        nodeStatsPtr->migrationCount        = 0;
+
+        if (nodeIndex >= topologyPtr->nodeCount) {
+            continue;
+        }
+        for (processIndex = 0; processIndex < sequenceControlSetPtr->motionEstimationProcessInitCount; ++processIndex) {
+            EbNumaThreadState_t *statePtr = &((MotionEstimationContext_t*)encHandlePtr->motionEstimationContextPtrArray[processIndex])->numaState;
+            nodeStatsPtr->segmentCount          += statePtr->segmentCount[nodeIndex];
+            nodeStatsPtr->remoteSegmentCount    += statePtr->remoteSegmentCount[nodeIndex];
+            nodeStatsPtr->migrationCount        += statePtr->migrationCount[nodeIndex];
+        }
+        for (processIndex = 0; processIndex < sequenceControlSetPtr->encDecProcessInitCount; ++processIndex) {
+            EbNumaThreadState_t *statePtr = &((EncDecContext_t*)encHandlePtr->encDecContextPtrArray[processIndex])->numaState;
+            nodeStatsPtr->segmentCount          += statePtr->segmentCount[nodeIndex];
+            nodeStatsPtr->remoteSegmentCount    += statePtr->remoteSegmentCount[nodeIndex];
+            nodeStatsPtr->migrationCount        += statePtr->migrationCount[nodeIndex];
+        }
+    }
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EB_ERRORTYPE EbH265GetStats(
+    EB_COMPONENTTYPE      *h265EncComponent,
+    EB_H265_ENC_STATS     *statsPtr)
+{
+    EbEncHandle_t          *encHandlePtr;
+    SequenceControlSet_t   *sequenceControlSetPtr;
+    EncodeContext_t        *encodeContextPtr;
+    EB_U32                  binIndex;
+
+    if (h265EncComponent == NULL || statsPtr == NULL) {
+        return EB_ErrorBadParameter;
+    }
+
+    encHandlePtr            = (EbEncHandle_t*)h265EncComponent->pComponentPrivate;
+    sequenceControlSetPtr   = encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr;
+    encodeContextPtr        = encHandlePtr->sequenceControlSetInstanceArray[0]->encodeContextPtr;
+
+    EbEncHandleBind(encHandlePtr);
+
+    statsPtr->elapsedTimeUs = EbMonotonicTimeUs() - encHandlePtr->encoderStartTime;
+
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_RESOURCE_COORDINATION],       encHandlePtr->inputBufferResourcePtr,                  encHandlePtr->inputBufferConsumerFifoPtrArray,                  EB_ResourceCoordinationProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_PICTURE_ANALYSIS],            encHandlePtr->resourceCoordinationResultsResourcePtr,  encHandlePtr->resourceCoordinationResultsConsumerFifoPtrArray,  sequenceControlSetPtr->pictureAnalysisProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_PICTURE_DECISION],            encHandlePtr->pictureAnalysisResultsResourcePtr,       encHandlePtr->pictureAnalysisResultsConsumerFifoPtrArray,       EB_PictureDecisionProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_MOTION_ESTIMATION],           encHandlePtr->pictureDecisionResultsResourcePtr,       encHandlePtr->pictureDecisionResultsConsumerFifoPtrArray,       sequenceControlSetPtr->motionEstimationProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_INITIAL_RATE_CONTROL],        encHandlePtr->motionEstimationResultsResourcePtr,      encHandlePtr->motionEstimationResultsConsumerFifoPtrArray,      EB_InitialRateControlProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_SOURCE_BASED_OPERATIONS],     encHandlePtr->initialRateControlResultsResourcePtr,    encHandlePtr->initialRateControlResultsConsumerFifoPtrArray,    sequenceControlSetPtr->sourceBasedOperationsProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_PICTURE_MANAGER],             encHandlePtr->pictureDemuxResultsResourcePtr,          encHandlePtr->pictureDemuxResultsConsumerFifoPtrArray,          EB_PictureManagerProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_RATE_CONTROL],                encHandlePtr->rateControlTasksResourcePtr,             encHandlePtr->rateControlTasksConsumerFifoPtrArray,             EB_RateControlProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_MODE_DECISION_CONFIGURATION], encHandlePtr->rateControlResultsResourcePtr,           encHandlePtr->rateControlResultsConsumerFifoPtrArray,           sequenceControlSetPtr->modeDecisionConfigurationProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_ENC_DEC],                     encHandlePtr->encDecTasksResourcePtr,                  encHandlePtr->encDecTasksConsumerFifoPtrArray,                  sequenceControlSetPtr->encDecProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_ENTROPY_CODING],              encHandlePtr->encDecResultsResourcePtr,                encHandlePtr->encDecResultsConsumerFifoPtrArray,                sequenceControlSetPtr->entropyCodingProcessInitCount);
+    EbHevcGetStageStats(&statsPtr->stage[EB_ENC_STAGE_PACKETIZATION],               encHandlePtr->entropyCodingResultsResourcePtr,         encHandlePtr->entropyCodingResultsConsumerFifoPtrArray,         EB_PacketizationProcessInitCount);
+
+    statsPtr->outputQueueDepth = EbGetFullObjectCount(encHandlePtr->outputStreamBufferResourcePtrArray[0]);
+
+    // Read picturesOut first so that picturesInFlight never goes negative
+    statsPtr->picturesOut       = encodeContextPtr->picturesOut;
+    statsPtr->picturesIn        = encodeContextPtr->picturesIn;
+    statsPtr->picturesInFlight  = (statsPtr->picturesIn > statsPtr->picturesOut) ? statsPtr->picturesIn - statsPtr->picturesOut : 0;
+
+    for (binIndex = 0; binIndex < EB_ENC_LATENCY_BIN_COUNT; ++binIndex) {
+        statsPtr->latencyHistogram[binIndex] = encodeContextPtr->latencyHistogram[binIndex];
+    }
+    statsPtr->latencySumMs      = encodeContextPtr->latencySumMs;
+    statsPtr->latencyMaxMs      = encodeContextPtr->latencyMaxMs;
+
+    EbHevcGetNumaStats(statsPtr, encHandlePtr, sequenceControlSetPtr, &encodeContextPtr->numaTopology);
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* EbH265EncUpdateParameter
+*   Checks the new parameters against the configuration the encoder was
+*   initialized with and writes them into the instance sequence control set.
+*   The inputs sent afterwards carry the new update count, resource
+*   coordination switches sets when the first of them comes in. The previous
+*   parameters stay in the history for the inputs sent before.
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EB_ERRORTYPE EbH265EncUpdateParameter(
+    EB_COMPONENTTYPE      *h265EncComponent,
+    EB_H265_ENC_UPDATE    *updatePtr)
+{
+    EbEncHandle_t                  *encHandlePtr;
+    EbSequenceControlSetInstance_t *instancePtr;
+    SequenceControlSet_t           *sequenceControlSetPtr;
+    EB_H265_ENC_CONFIGURATION      *config;
+    EB_U32                          channelNumber = 0;
+    EB_U32                          vbvMaxrate;
+    EB_U32                          vbvBufsize;
+    EB_U32                          maxQpAllowed;
+    EB_U32                          minQpAllowed;
+    EB_ERRORTYPE                    return_error = EB_ErrorNone;
+
+    if (h265EncComponent == NULL || updatePtr == NULL) {
+        return EB_ErrorBadParameter;
+    }
+
+    encHandlePtr            = (EbEncHandle_t*)h265EncComponent->pComponentPrivate;
+    instancePtr             = encHandlePtr->sequenceControlSetInstanceArray[0];
+    sequenceControlSetPtr   = instancePtr->sequenceControlSetPtr;
+    config                  = &sequenceControlSetPtr->staticConfig;
+
+    EbEncHandleBind(encHandlePtr);
+
+    EbBlockOnMutex(instancePtr->configMutex);
+
+    vbvMaxrate      = (updatePtr->updateFlags & EB_ENC_UPDATE_VBV) ? updatePtr->vbvMaxrate : config->vbvMaxrate;
+    vbvBufsize      = (updatePtr->updateFlags & EB_ENC_UPDATE_VBV) ? updatePtr->vbvBufsize : config->vbvBufsize;
+    maxQpAllowed    = (updatePtr->updateFlags & EB_ENC_UPDATE_QP_RANGE) ? updatePtr->maxQpAllowed : config->maxQpAllowed;
+    minQpAllowed    = (updatePtr->updateFlags & EB_ENC_UPDATE_QP_RANGE) ? updatePtr->minQpAllowed : config->minQpAllowed;
+
+    if ((updatePtr->updateFlags & EB_ENC_UPDATE_TARGET_BIT_RATE) && config->rateControlMode != 1) {
+        SVT_LOG("SVT [Error]: Instance %u: The bit rate can only be updated when RateControlMode is 1 (VBR) \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    // The statistics the VBV model needs are only gathered when CRF starts with a VBV
+    if ((updatePtr->updateFlags & EB_ENC_UPDATE_VBV) && !sequenceControlSetPtr->rateStatisticsFlag) {
+        SVT_LOG("SVT [Error]: Instance %u: The VBV can only be updated when RateControlMode is 1 (VBR) or 2 (CRF) started with a VBV \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if ((updatePtr->updateFlags & EB_ENC_UPDATE_TARGET_BIT_RATE) && updatePtr->targetBitRate == 0) {
+        SVT_LOG("SVT [Error]: Instance %u: The target bit rate must be greater than 0 \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if ((vbvMaxrate == 0) != (vbvBufsize == 0)) {
+        SVT_LOG("SVT [Error]: Instance %u: vbv max rate and vbv bufsize must be both set or both 0 \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->hrdFlag == 1 && (vbvMaxrate == 0 || vbvBufsize == 0)) {
+        SVT_LOG("SVT [Error]: Instance %u: hrd requires vbv max rate and vbv bufsize to be greater than 0 \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (maxQpAllowed > 51 || minQpAllowed > maxQpAllowed) {
+        SVT_LOG("SVT [Error]: Instance %u: The QP range must be within [0 - 51] with MinQpAllowed not above MaxQpAllowed \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (updatePtr->updateFlags & EB_ENC_UPDATE_ENC_MODE) {
+        if (updatePtr->encMode > sequenceControlSetPtr->maxEncMode) {
+            SVT_LOG("SVT [Error]: Instance %u: encMode must be [0 - %d]\n", channelNumber + 1, sequenceControlSetPtr->maxEncMode);
+            return_error = EB_ErrorBadParameter;
+        }
+        else if (config->rcPass == 1 && updatePtr->encMode != config->encMode) {
+            SVT_LOG("SVT [Error]: Instance %u: encMode can not be updated in the first rate control pass\n", channelNumber + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
+    if (return_error == EB_ErrorNone) {
+        // Keep the parameters of the inputs already sent
+        if (updatePtr->updateFlags & (EB_ENC_UPDATE_TARGET_BIT_RATE | EB_ENC_UPDATE_VBV | EB_ENC_UPDATE_QP_RANGE | EB_ENC_UPDATE_ENC_MODE)) {
+            GetDynamicParameters(
+                &instancePtr->parameterUpdateHistory[sequenceControlSetPtr->parameterUpdateCount % PARAMETER_UPDATE_HISTORY_COUNT],
+                sequenceControlSetPtr);
+        }
+        if (updatePtr->updateFlags & EB_ENC_UPDATE_TARGET_BIT_RATE) {
+            config->targetBitRate = updatePtr->targetBitRate;
+        }
+        if (updatePtr->updateFlags & EB_ENC_UPDATE_ENC_MODE) {
+            config->encMode = updatePtr->encMode;
+        }
+        config->vbvMaxrate      = vbvMaxrate;
+        config->vbvBufsize      = vbvBufsize;
+        config->maxQpAllowed    = maxQpAllowed;
+        config->minQpAllowed    = minQpAllowed;
+
+        if (updatePtr->updateFlags & (EB_ENC_UPDATE_TARGET_BIT_RATE | EB_ENC_UPDATE_VBV | EB_ENC_UPDATE_QP_RANGE | EB_ENC_UPDATE_ENC_MODE)) {
+            ++sequenceControlSetPtr->parameterUpdateCount;
+        }
+
+        // The HRD parameters of the SPS follow the bit rate and the VBV, they
+        // can only change with a new coded video sequence
+        if ((updatePtr->updateFlags & EB_ENC_UPDATE_FORCE_IDR) ||
+            (config->hrdFlag == 1 && (updatePtr->updateFlags & (EB_ENC_UPDATE_TARGET_BIT_RATE | EB_ENC_UPDATE_VBV)))) {
+            instancePtr->encodeContextPtr->forceIdrPending = EB_TRUE;
+        }
+    }
+
+    EbReleaseMutex(instancePtr->configMutex);
+
+    return return_error;
+}
+
 /**********************************
 * Encoder Error Handling
 **********************************/
@@ -3984,7 +5013,8 @@ EB_ERRORTYPE AllocateFrameBuffer(
 
     inputPictureBufferDescInitData.splitMode = is16bit ? EB_TRUE : EB_FALSE;
 
-    inputPictureBufferDescInitData.bufferEnableMask = PICTURE_BUFFER_DESC_FULL_MASK;
+    // Zero-copy inputs reference the application planes
+    inputPictureBufferDescInitData.bufferEnableMask = config->zeroCopyInput ? 0 : PICTURE_BUFFER_DESC_FULL_MASK;
 
     if (is16bit && config->compressedTenBitFormat == 1) {
         inputPictureBufferDescInitData.splitMode = EB_FALSE;  //do special allocation for 2bit data down below.
@@ -3999,6 +5029,12 @@ EB_ERRORTYPE AllocateFrameBuffer(
         return EB_ErrorInsufficientResources;
     }
 
+    // SEI and RPU payloads are copied per picture, see CopyInputPayload
+    ((EbPictureBufferDesc_t*)(inputBuffer->pBuffer))->userSeiMsg.payload = NULL;
+    ((EbPictureBufferDesc_t*)(inputBuffer->pBuffer))->userSeiMsg.payloadSize = 0;
+    ((EbPictureBufferDesc_t*)(inputBuffer->pBuffer))->dolbyVisionRpu.payload = NULL;
+    ((EbPictureBufferDesc_t*)(inputBuffer->pBuffer))->dolbyVisionRpu.payloadSize = 0;
+
     if (is16bit && config->compressedTenBitFormat == 1) {
 
         const EB_COLOR_FORMAT colorFormat = (EB_COLOR_FORMAT)sequenceControlSetPtr->chromaFormatIdc;
@@ -4050,11 +5086,15 @@ EB_ERRORTYPE EbOutputBufferHeaderCtor(
     EB_PTR *objectDblPtr,
     EB_PTR objectInitDataPtr)
 {
-    EB_H265_ENC_CONFIGURATION   * config = (EB_H265_ENC_CONFIGURATION*)objectInitDataPtr;
+    EbEncHandle_t               * encHandlePtr = (EbEncHandle_t*)objectInitDataPtr;
+    EB_H265_ENC_CONFIGURATION   * config = &encHandlePtr->sequenceControlSetInstanceArray[0]->sequenceControlSetPtr->staticConfig;
     EB_U32 nStride = (EB_U32)(EB_OUTPUTSTREAMBUFFERSIZE_MACRO(config->sourceWidth * config->sourceHeight));  //TBC
+    EbOutputStreamBuffer_t* outStreamBufPtr;
 	EB_BUFFERHEADERTYPE* outBufPtr;
 
-	EB_MALLOC(EB_BUFFERHEADERTYPE*, outBufPtr, sizeof(EB_BUFFERHEADERTYPE), EB_N_PTR);
+	EB_MALLOC(EbOutputStreamBuffer_t*, outStreamBufPtr, sizeof(EbOutputStreamBuffer_t), EB_N_PTR);
+    outStreamBufPtr->encHandlePtr = encHandlePtr;
+    outBufPtr = &outStreamBufPtr->header;
 	*objectDblPtr = (EB_PTR)outBufPtr;
 
     //Jing:TODO
@@ -4068,13 +5108,25 @@ EB_ERRORTYPE EbOutputBufferHeaderCtor(
 	// Initialize Header
 	outBufPtr->nSize = sizeof(EB_BUFFERHEADERTYPE);
 
-	EB_MALLOC(EB_U8*, outBufPtr->pBuffer, nStride, EB_N_PTR);
+    // Packetization writes straight into the buffer handed out by EbH265GetPacket
+    if (config->outputStreamAlloc) {
+        if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) {
+            return EB_ErrorInsufficientResources;
+        }
+        outBufPtr->pBuffer = config->outputStreamAlloc(nStride);
+        if (outBufPtr->pBuffer == (EB_U8*)EB_NULL) {
+            return EB_ErrorInsufficientResources;
+        }
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = EB_APP_PTR;
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = outBufPtr->pBuffer;
+    }
+    else {
+        EB_MALLOC(EB_U8*, outBufPtr->pBuffer, nStride, EB_N_PTR);
+    }
 
 	outBufPtr->nAllocLen =  nStride;
 	outBufPtr->pAppPrivate = NULL;
 
-    (void)objectInitDataPtr;
-
     return EB_ErrorNone;
 }
 
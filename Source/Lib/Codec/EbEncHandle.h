@@ -19,6 +19,11 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+
+// Parallel stages whose concurrency EbHevcBalanceStages caps:
+// PA, ME, SBO, MDC, EncDec and EC
+#define EB_BALANCED_STAGE_COUNT         6
+
 /**************************************
  * Component Private Data
  **************************************/  
@@ -154,9 +159,20 @@ typedef struct EbEncHandle_s
     // the end of the buffer.  This distortion data aids in the calculation
     // of PSNR.
     // Memory Map
-    EbMemoryMapEntry                       *memoryMap; 
-    EB_U32                                  memoryMapIndex;
-    EB_U64                                  totalLibMemory;
+    EbMemoryContext_t                       memoryContext;
+
+    // Processor topology and thread affinity
+    EbThreadAffinity_t                      threadAffinity;
+
+    // Assembly level
+    EB_U32                                  asmTypes;
+
+    // Origin of the pipeline statistics elapsed time
+    EB_U64                                  encoderStartTime;
+
+    // Last run of EbHevcBalanceStages and the busy time of the stages then
+    EB_U64                                  balanceTime;
+    EB_U64                                  balanceBusyTime[EB_BALANCED_STAGE_COUNT];
 
 } EbEncHandle_t;
 
@@ -131,6 +131,8 @@ EB_ERRORTYPE EncodeContextCtor(
     
     // Initial Rate Control Reordering Queue
     encodeContextPtr->initialRateControlReorderQueueHeadIndex                 = 0;
+    EB_MEMSET(encodeContextPtr->propagateDeltaQpLayerMean, 0, sizeof(encodeContextPtr->propagateDeltaQpLayerMean));
+    EB_MEMSET(encodeContextPtr->propagateDeltaQpLayerCount, 0, sizeof(encodeContextPtr->propagateDeltaQpLayerCount));
     EB_MALLOC(InitialRateControlReorderEntry_t**, encodeContextPtr->initialRateControlReorderQueue, sizeof(InitialRateControlReorderEntry_t*) * INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH, EB_N_PTR);
 
 	for(pictureIndex=0; pictureIndex < INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -227,6 +229,7 @@ EB_ERRORTYPE EncodeContextCtor(
     encodeContextPtr->scFrameIn     = 0;
     encodeContextPtr->scFrameOut    = 0;
     encodeContextPtr->encMode = SPEED_CONTROL_INIT_MOD;
+    encodeContextPtr->forceIdrPending = EB_FALSE;
 
     EB_CREATEMUTEX(EB_HANDLE, encodeContextPtr->bufferFillMutex, sizeof(EB_HANDLE), EB_MUTEX);
     encodeContextPtr->previousSelectedRefQp = 32;
@@ -237,11 +240,13 @@ EB_ERRORTYPE EncodeContextCtor(
 	if (encodeContextPtr->sharedReferenceMutex  == (EB_HANDLE) EB_NULL){
         return EB_ErrorInsufficientResources;
     }else {
-        memoryMap[*(memoryMapIndex)].ptrType          = EB_MUTEX;
-        memoryMap[(*(memoryMapIndex))++].ptr          = encodeContextPtr->sharedReferenceMutex ;
-        *totalLibMemory                              += (sizeof(EB_HANDLE));    
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType    = EB_MUTEX;
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr      = encodeContextPtr->sharedReferenceMutex ;
+        memoryContextPtr->totalLibMemory                                       += (sizeof(EB_HANDLE));
     }
 
+    encodeContextPtr->subPictureRefWaitCount = 0;
+    EB_CREATEMUTEX(EB_HANDLE, encodeContextPtr->subPictureRefWaitMutex, sizeof(EB_HANDLE), EB_MUTEX);
 
     return EB_ErrorNone;
 }
@@ -99,6 +99,10 @@ typedef struct EncodeContext_s
     InitialRateControlReorderEntry_t   **initialRateControlReorderQueue;
     EB_U32                               initialRateControlReorderQueueHeadIndex;
 
+    // CRF temporal importance, running mean of the picture offsets of each temporal layer in Q4
+    EB_S32                               propagateDeltaQpLayerMean[MAX_TEMPORAL_LAYERS];
+    EB_U32                               propagateDeltaQpLayerCount[MAX_TEMPORAL_LAYERS];
+
     // High Level Rate Control Histogram Queue
     HlRateControlHistogramEntry_t      **hlRateControlHistorgramQueue;
     EB_U32                               hlRateControlHistorgramQueueHeadIndex;
@@ -144,6 +148,10 @@ typedef struct EncodeContext_s
 
 	EB_ENC_MODE                          encMode;
 
+    // Set by EbH265EncUpdateParameter, the next picture sent is coded as an
+    // IDR. Guarded by the instance configMutex.
+    EB_BOOL                              forceIdrPending;
+
     // Rate Control
     EB_U32                               availableTargetBitRate;
     EB_BOOL                              availableTargetBitRateChanged;
@@ -163,6 +171,20 @@ typedef struct EncodeContext_s
 	EbObjectWrapper_t                   *previousPictureControlSetWrapperPtr;
     EB_HANDLE						     sharedReferenceMutex;
 
+    // Sub-picture reference: number of EncDec threads blocked on reference row progress
+    EB_U32                               subPictureRefWaitCount;
+    EB_HANDLE                            subPictureRefWaitMutex;
+
+    // Nodes the LCU rows of the pictures are split over, set at init
+    EbNumaTopology_t                     numaTopology;
+
+    // Pipeline statistics, picturesIn is written by resource coordination
+    // as it hands the pictures over, the others by packetization
+    EB_U64                               picturesIn;
+    EB_U64                               picturesOut;
+    EB_U64                               latencyHistogram[EB_ENC_LATENCY_BIN_COUNT];
+    EB_U64                               latencySumMs;
+    EB_U64                               latencyMaxMs;
 
 } EncodeContext_t;
 
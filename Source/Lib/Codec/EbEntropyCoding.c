@@ -5055,7 +5055,7 @@ EB_ERRORTYPE ComputeProfileTierLevelInfo(
 	scsPtr->profileIdc = scsPtr->staticConfig.profile;
 
 
-	if (scsPtr->staticConfig.rateControlMode == 0){
+	if (scsPtr->staticConfig.rateControlMode != 1){
 		// level calculation
 		if ((lumaSampleRate <= maxLumaSampleRate[0]) && (lumaPictureSize <= maxLumaPictureSize[0]) && (lumaWidthSquare <= maxLumaPictureSize[0] * 8) && (lumaHeightSquare <= maxLumaPictureSize[0] * 8))
 			scsPtr->levelIdc = 30; //1*30
@@ -6240,9 +6240,9 @@ static void CodePPS(
 	// "cu_qp_delta_enabled_flag"
 	WriteFlagCavlc(
 		bitstreamPtr,
-        scsPtr->staticConfig.improveSharpness || scsPtr->staticConfig.bitRateReduction || scsPtr->staticConfig.segmentOvEnabled);// pcsPtr->useDeltaQp);
+        scsPtr->staticConfig.improveSharpness || scsPtr->staticConfig.bitRateReduction || scsPtr->staticConfig.segmentOvEnabled || scsPtr->staticConfig.rateControlMode == 2);// pcsPtr->useDeltaQp);
 
-	if (scsPtr->staticConfig.improveSharpness || scsPtr->staticConfig.bitRateReduction || scsPtr->staticConfig.segmentOvEnabled) { //pcsPtr->useDeltaQp) {
+	if (scsPtr->staticConfig.improveSharpness || scsPtr->staticConfig.bitRateReduction || scsPtr->staticConfig.segmentOvEnabled || scsPtr->staticConfig.rateControlMode == 2) { //pcsPtr->useDeltaQp) {
 		// "diff_cu_qp_delta_depth"
 		WriteUvlc(
 			bitstreamPtr,
@@ -6287,7 +6287,7 @@ static void CodePPS(
 	// "entropy_coding_sync_enabled_flag"
 	WriteFlagCavlc(
 		bitstreamPtr,
-		0);
+		scsPtr->staticConfig.enableWppFlag);
 
     if (tileMode == EB_TRUE) {
 
@@ -6760,6 +6760,38 @@ static void CodeSliceHeader(
             }
         }
     }
+    else if (sequenceControlSetPtr->staticConfig.enableWppFlag) {
+        // One entry point per LCU row substream, except the first
+        unsigned num_entry_point_offsets = sequenceControlSetPtr->pictureHeightInLcu - 1;
+        EB_U32 maxOffset = 0;
+        EB_U32 offset[MAX_LCU_ROWS];
+        for (unsigned rowIdx = 0; rowIdx < num_entry_point_offsets; rowIdx++) {
+            offset[rowIdx] = GetEntropyCoderGetBitstreamSize(pcsPtr->wppEntropyCoderPtrArray[rowIdx]);
+            if (offset[rowIdx] > maxOffset) {
+                maxOffset = offset[rowIdx];
+            }
+        }
+
+        EB_U32 offsetLenMinus1 = 0;
+        while (maxOffset >= (1u << (offsetLenMinus1 + 1))) {
+            offsetLenMinus1++;
+        }
+
+        // "num_entry_point_offsets"
+        WriteUvlc(
+            bitstreamPtr,
+            num_entry_point_offsets);
+
+        if (num_entry_point_offsets > 0) {
+            WriteUvlc(
+                bitstreamPtr,
+                offsetLenMinus1);
+
+            for (unsigned rowIdx = 0; rowIdx < num_entry_point_offsets; rowIdx++) {
+                WriteCodeCavlc(bitstreamPtr, offset[rowIdx] - 1, offsetLenMinus1 + 1);
+            }
+        }
+    }
 
 	// Byte Alignment
 
@@ -7339,7 +7371,8 @@ EB_ERRORTYPE EncodeLcu(
 	NeighborArrayUnit_t     *leafDepthNeighborArray,
 	NeighborArrayUnit_t     *intraLumaModeNeighborArray,
 	NeighborArrayUnit_t     *skipFlagNeighborArray,
-	EB_U16                   tileIdx,
+	EB_U8                   *prevCodedQp,
+	EB_U8                   *prevQuantGroupCodedQp,
 	EB_U32                   pictureOriginX,
 	EB_U32                   pictureOriginY)
 {
@@ -7440,11 +7473,11 @@ EB_ERRORTYPE EncodeLcu(
                     cuOriginY,
                     cuSize,
                     sequenceControlSetPtr->lcuSize,
-					sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled ? EB_TRUE : EB_FALSE,
+					sequenceControlSetPtr->staticConfig.improveSharpness || sequenceControlSetPtr->staticConfig.bitRateReduction || sequenceControlSetPtr->staticConfig.segmentOvEnabled || sequenceControlSetPtr->staticConfig.rateControlMode == 2 ? EB_TRUE : EB_FALSE,
                     &entropyDeltaQpNotCoded,
                     pictureControlSetPtr->difCuDeltaQpDepth,
-                    &pictureControlSetPtr->prevCodedQp[tileIdx],
-                    &pictureControlSetPtr->prevQuantGroupCodedQp[tileIdx],
+                    prevCodedQp,
+                    prevQuantGroupCodedQp,
                     tbPtr->qp,
                     pictureControlSetPtr,
 					pictureOriginX,
@@ -8196,6 +8229,46 @@ EB_ERRORTYPE ResetEntropyCoder(
 	return return_error;
 }
 
+/**************************************************
+* StoreEntropyCoderContexts
+*   Saves the CABAC context models of the coder,
+*   used for the wavefront row synchronization
+**************************************************/
+EB_ERRORTYPE StoreEntropyCoderContexts(
+	EntropyCoder_t             *entropyCoderPtr,
+	ContextModelEncContext_t   *contextModelStoragePtr)
+{
+	EB_ERRORTYPE return_error = EB_ErrorNone;
+
+	CabacEncodeContext_t      *cabacEncCtxPtr = (CabacEncodeContext_t*)entropyCoderPtr->cabacEncodeContextPtr;
+
+	EB_MEMCPY(&(contextModelStoragePtr->splitFlagContextModel[0]), &(cabacEncCtxPtr->contextModelEncContext.splitFlagContextModel[0]), sizeof(EB_ContextModel)* TOTAL_NUMBER_OF_CABAC_CONTEXT_MODELS);
+
+	return return_error;
+}
+
+/**************************************************
+* SyncEntropyCoderContexts
+*   Initializes the coder at the start of an LCU row
+*   from the context models stored by the row above
+**************************************************/
+EB_ERRORTYPE SyncEntropyCoderContexts(
+	EntropyCoder_t             *entropyCoderPtr,
+	ContextModelEncContext_t   *contextModelStoragePtr)
+{
+	EB_ERRORTYPE return_error = EB_ErrorNone;
+
+	CabacEncodeContext_t      *cabacEncCtxPtr = (CabacEncodeContext_t*)entropyCoderPtr->cabacEncodeContextPtr;
+
+	EB_MEMCPY(&(cabacEncCtxPtr->contextModelEncContext.splitFlagContextModel[0]), &(contextModelStoragePtr->splitFlagContextModel[0]), sizeof(EB_ContextModel)* TOTAL_NUMBER_OF_CABAC_CONTEXT_MODELS);
+
+	// Reset Binary Arithmetic Coder (BAC) to initial values
+	ResetBacEnc(
+		&(cabacEncCtxPtr->bacEncContext));
+
+	return return_error;
+}
+
 EB_ERRORTYPE FlushBitstream(
 	EB_PTR outputBitstreamPtr)
 {
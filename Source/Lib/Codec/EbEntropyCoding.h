@@ -41,7 +41,8 @@ extern EB_ERRORTYPE EncodeLcu(
     NeighborArrayUnit_t     *leafDepthNeighborArray,
     NeighborArrayUnit_t     *intraLumaModeNeighborArray,
     NeighborArrayUnit_t     *skipFlagNeighborArray,
-    EB_U16                   tileIdx,
+    EB_U8                   *prevCodedQp,
+    EB_U8                   *prevQuantGroupCodedQp,
     EB_U32                   pictureOriginX,
 	EB_U32                   pictureOriginY);
 
@@ -77,6 +78,14 @@ extern EB_ERRORTYPE ResetEntropyCoder(
     EB_U32                 qp,
     EB_PICTURE               sliceType);
 
+extern EB_ERRORTYPE StoreEntropyCoderContexts(
+    EntropyCoder_t             *entropyCoderPtr,
+    ContextModelEncContext_t   *contextModelStoragePtr);
+
+extern EB_ERRORTYPE SyncEntropyCoderContexts(
+    EntropyCoder_t             *entropyCoderPtr,
+    ContextModelEncContext_t   *contextModelStoragePtr);
+
 extern EB_ERRORTYPE FlushBitstream(
     EB_PTR outputBitstreamPtr);
 
@@ -138,6 +138,9 @@ static void EntropyCodingLcu(
     EB_U32                             lcuOriginY,
     EB_BOOL                            terminateSliceFlag,
     EB_U16                             tileIdx,
+    EntropyCoder_t                    *entropyCoderPtr,
+    EB_U8                             *prevCodedQp,
+    EB_U8                             *prevQuantGroupCodedQp,
     EB_U32                             pictureOriginX,
     EB_U32                             pictureOriginY)
 {
@@ -147,7 +150,6 @@ static void EntropyCodingLcu(
     //rate Control
     EB_U32                       writtenBitsBeforeQuantizedCoeff;
     EB_U32                       writtenBitsAfterQuantizedCoeff;
-    EntropyCoder_t               *entropyCoderPtr = pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCoderPtr;
     //store the number of written bits before coding quantized coeffs (flush is not called yet): 
     // The total number of bits is 
     // number of written bits
@@ -181,7 +183,8 @@ static void EntropyCodingLcu(
         pictureControlSetPtr->leafDepthNeighborArray[tileIdx],
         pictureControlSetPtr->intraLumaModeNeighborArray[tileIdx],
         pictureControlSetPtr->skipFlagNeighborArray[tileIdx],
-        tileIdx,
+        prevCodedQp,
+        prevQuantGroupCodedQp,
 		pictureOriginX,
 		pictureOriginY);
 
@@ -199,8 +202,6 @@ static void EntropyCodingLcu(
 
     lcuPtr->totalBits = writtenBitsAfterQuantizedCoeff - writtenBitsBeforeQuantizedCoeff;
 
-    pictureControlSetPtr->ParentPcsPtr->quantizedCoeffNumBits += lcuPtr->quantizedCoeffsBits;
-
     /*********************************************************
     *Note - At the end of each LCU, HEVC adds 1 bit to indicate that
     if the current LCU is the end of a slice, where 0x1 means it is the
@@ -226,7 +227,9 @@ static void EntropyCodingLcu(
  *   processing of LCU-rows as soon as their inputs are 
  *   available and the previous LCU-row has completed.  
  *   At any given time, only one segment row per picture
- *   is being processed.
+ *   is being processed, except in WPP mode where rows are
+ *   handed out as soon as their inputs are available and
+ *   synchronized LCU by LCU in the Entropy Coding Kernel.
  *
  * The function has two parts:
  *
@@ -261,6 +264,7 @@ static EB_BOOL UpdateEntropyCodingRows(
     EB_U32              *rowIndex,
     EB_U32               rowCount,
     EB_U32               tileIdx,
+    EB_BOOL              enableWppFlag,
     EB_BOOL             *initialProcessCall)
 {
     EB_BOOL processNextRow = EB_FALSE;
@@ -292,12 +296,12 @@ static EB_BOOL UpdateEntropyCodingRows(
     // Test if the picture is not already complete AND not currently being worked on by another ENCDEC process
     if(infoPtr->entropyCodingCurrentRow < infoPtr->entropyCodingRowCount && 
        infoPtr->entropyCodingRowArray[infoPtr->entropyCodingCurrentRow] == EB_TRUE &&
-       infoPtr->entropyCodingInProgress == EB_FALSE)
+       (infoPtr->entropyCodingInProgress == EB_FALSE || enableWppFlag))
     {
         // Test if the next LCU-row is ready to go
         if(infoPtr->entropyCodingCurrentRow <= infoPtr->entropyCodingCurrentAvailableRow)
         {
-            infoPtr->entropyCodingInProgress = EB_TRUE;
+            infoPtr->entropyCodingInProgress = enableWppFlag ? EB_FALSE : EB_TRUE;
             *rowIndex = infoPtr->entropyCodingCurrentRow++;
             processNextRow = EB_TRUE;
         }
@@ -351,6 +355,11 @@ void* EntropyCodingKernel(void *inputPtr)
     EB_U32                                   tileCnt;
     EB_U32                                   xLcuStart;
     EB_U32                                   yLcuStart;
+    EB_BOOL                                  enableWppFlag;
+    EntropyCoder_t                          *entropyCoderPtr;
+    EB_U8                                   *prevCodedQp;
+    EB_U8                                   *prevQuantGroupCodedQp;
+    EB_U32                                   wppSyncCount;
 
     for(;;) {
 
@@ -368,6 +377,7 @@ void* EntropyCodingKernel(void *inputPtr)
         lastLcuFlagInSlice     = EB_FALSE;
         lastLcuFlagInTile      = EB_FALSE;
         tileCnt                = pictureControlSetPtr->ParentPcsPtr->tileRowCount * pictureControlSetPtr->ParentPcsPtr->tileColumnCount;
+        enableWppFlag          = (EB_BOOL)sequenceControlSetPtr->staticConfig.enableWppFlag;
 #if DEADLOCK_DEBUG
         SVT_LOG("POC %lld EC IN \n", pictureControlSetPtr->pictureNumber);
 #endif
@@ -392,9 +402,10 @@ void* EntropyCodingKernel(void *inputPtr)
             yLcuIndex = encDecResultsPtr->completedLcuRowIndexStart;   
             
             // LCU-loops
-            while(UpdateEntropyCodingRows(pictureControlSetPtr, &yLcuIndex, encDecResultsPtr->completedLcuRowCount, tileIdx, &initialProcessCall) == EB_TRUE) 
+            while(UpdateEntropyCodingRows(pictureControlSetPtr, &yLcuIndex, encDecResultsPtr->completedLcuRowCount, tileIdx, enableWppFlag, &initialProcessCall) == EB_TRUE) 
             {
                 EB_U32 rowTotalBits = 0;
+                EB_U64 rowQuantizedCoeffNumBits = 0;
 
                 if(yLcuIndex == 0) {
                     EbBlockOnMutex(pictureControlSetPtr->entropyCodingPicMutex);
@@ -412,6 +423,24 @@ void* EntropyCodingKernel(void *inputPtr)
 					pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCodingPicDone = EB_FALSE;
                 }
 
+                if (enableWppFlag) {
+                    // Each LCU row is coded into its own substream
+                    entropyCoderPtr = pictureControlSetPtr->wppEntropyCoderPtrArray[yLcuIndex];
+                    prevCodedQp = &pictureControlSetPtr->wppPrevCodedQp[yLcuIndex];
+                    prevQuantGroupCodedQp = &pictureControlSetPtr->wppPrevQuantGroupCodedQp[yLcuIndex];
+                    *prevCodedQp = (EB_U8)pictureControlSetPtr->pictureQp;
+                    *prevQuantGroupCodedQp = (EB_U8)pictureControlSetPtr->pictureQp;
+                    if (yLcuIndex > 0) {
+                        ResetBitstream(EntropyCoderGetBitstreamPtr(entropyCoderPtr));
+                    }
+                }
+                else {
+                    entropyCoderPtr = pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCoderPtr;
+                    prevCodedQp = &pictureControlSetPtr->prevCodedQp[tileIdx];
+                    prevQuantGroupCodedQp = &pictureControlSetPtr->prevQuantGroupCodedQp[tileIdx];
+                }
+                wppSyncCount = 0;
+
                 for(xLcuIndex = 0; xLcuIndex < tileWidthInLcu; ++xLcuIndex) {
                     lcuIndex = (EB_U16)((xLcuIndex + xLcuStart) + (yLcuIndex + yLcuStart) * pictureWidthInLcu);
                     lcuPtr = pictureControlSetPtr->lcuPtrArray[lcuIndex];
@@ -426,6 +455,32 @@ void* EntropyCodingKernel(void *inputPtr)
                         lastLcuFlagInSlice = lastLcuFlagInTile;
                     }
             
+                    // WPP: stay two LCUs behind the row above
+                    if (enableWppFlag && yLcuIndex > 0) {
+                        if (wppSyncCount < MIN(xLcuIndex + 2, tileWidthInLcu)) {
+                            EbSuspendTask();
+                            while (wppSyncCount < MIN(xLcuIndex + 2, tileWidthInLcu)) {
+                                EbBlockOnSemaphore(pictureControlSetPtr->wppRowProgressSemaphoreArray[yLcuIndex - 1]);
+                                ++wppSyncCount;
+                            }
+                            EbResumeTask();
+                        }
+                        if (xLcuIndex == 0) {
+                            if (tileWidthInLcu > 1) {
+                                SyncEntropyCoderContexts(
+                                    entropyCoderPtr,
+                                    &pictureControlSetPtr->wppContextModelArray[yLcuIndex - 1]);
+                            }
+                            else {
+                                ResetEntropyCoder(
+                                    sequenceControlSetPtr->encodeContextPtr,
+                                    entropyCoderPtr,
+                                    pictureControlSetPtr->pictureQp,
+                                    pictureControlSetPtr->sliceType);
+                            }
+                        }
+                    }
+
                     // Configure the LCU
                     EntropyCodingConfigureLcu(
                         contextPtr,
@@ -441,12 +496,39 @@ void* EntropyCodingKernel(void *inputPtr)
                         lcuOriginY,
                         lastLcuFlagInSlice,
                         tileIdx,
+                        entropyCoderPtr,
+                        prevCodedQp,
+                        prevQuantGroupCodedQp,
                         (xLcuIndex + xLcuStart) * lcuSize,
                         (yLcuIndex + yLcuStart) * lcuSize);
 
                     rowTotalBits += lcuPtr->totalBits;
+                    rowQuantizedCoeffNumBits += lcuPtr->quantizedCoeffsBits;
+
+                    if (enableWppFlag && yLcuIndex < tileHeightInLcu - 1) {
+                        // Store the contexts for the row below after its 2nd LCU
+                        if (xLcuIndex == 1) {
+                            StoreEntropyCoderContexts(
+                                entropyCoderPtr,
+                                &pictureControlSetPtr->wppContextModelArray[yLcuIndex]);
+                        }
+                        // The last LCU is released once the substream is terminated
+                        if (xLcuIndex < tileWidthInLcu - 1) {
+                            EbPostSemaphore(pictureControlSetPtr->wppRowProgressSemaphoreArray[yLcuIndex]);
+                        }
+                    }
+                }
+
+                if (enableWppFlag && yLcuIndex < tileHeightInLcu - 1) {
+                    // Terminate the LCU row substream
+                    EncodeTileFinish(entropyCoderPtr);
+                    EbPostSemaphore(pictureControlSetPtr->wppRowProgressSemaphoreArray[yLcuIndex]);
                 }
 
+                EbBlockOnMutex(pictureControlSetPtr->entropyCodingPicMutex);
+                pictureControlSetPtr->ParentPcsPtr->quantizedCoeffNumBits += rowQuantizedCoeffNumBits;
+                EbReleaseMutex(pictureControlSetPtr->entropyCodingPicMutex);
+
                 // At the end of each LCU-row, send the updated bit-count to Entropy Coding
                 {
                     //Jing: TODO
@@ -477,7 +559,9 @@ void* EntropyCodingKernel(void *inputPtr)
                     //Jing: Store the av(e) part for different tiles and copy it as a whole to slice bitstream
 
 					// If the picture is complete, terminate the slice
-					if (pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCodingCurrentRow == pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCodingRowCount)
+					// In WPP mode the last row completes only after all the rows above it
+					if ((enableWppFlag && yLcuIndex == tileHeightInLcu - 1) ||
+					    (!enableWppFlag && pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCodingCurrentRow == pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCodingRowCount))
 					{
                         EB_BOOL pic_ready = EB_TRUE;
 
@@ -486,10 +570,10 @@ void* EntropyCodingKernel(void *inputPtr)
                         //Jing:tile end, may not be the slice end
                         if (!lastLcuFlagInSlice) {
                             //printf("[%lld]:Encode tile end for tile %d\n", EbGetSysTimeMs(), tileIdx);
-                            EncodeTileFinish(pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCoderPtr);
+                            EncodeTileFinish(entropyCoderPtr);
                         } else {
                             //printf("[%lld]:Encode slice end for tile %d\n", EbGetSysTimeMs(), tileIdx);
-						    EncodeSliceFinish(pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCoderPtr);
+						    EncodeSliceFinish(entropyCoderPtr);
                         }
 
                         //Jing: TODO
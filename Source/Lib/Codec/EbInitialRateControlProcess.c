@@ -26,6 +26,11 @@
 #define PAN_LCU_PERCENTAGE                    75
 #define LOW_AMPLITUDE_TH                      64
 
+#define PROPAGATE_DELTA_QP_STRENGTH           2     // QP per doubling of the propagated cost
+#define PROPAGATE_MAX_DELTA_QP                8
+#define PROPAGATE_MAX_WINDOW                  256   // Lookahead pictures plus the current one
+#define PROPAGATE_LAYER_MEAN_WINDOW           16    // Pictures in the running mean of a temporal layer
+
 
 static EB_BOOL CheckMvForPanHighAmp(
 	EB_U32   hierarchicalLevels,
@@ -605,6 +610,177 @@ void EbHevcUpdateBeaInfoOverTime(
     return;
 }
 
+/************************************************
+* Propagate Delta QP helpers
+************************************************/
+static EB_U64 OisDistortionLcu(
+	PictureParentControlSet_t         *pictureControlSetPtr,
+	EB_U32                             lcuIdx)
+{
+	OisCu32Cu16Results_t *oisResultsPtr = &pictureControlSetPtr->oisCu32Cu16ResultsBuffer[lcuIdx * LCU_OIS_CU32_CU16_STRIDE];
+
+	return (EB_U64)oisResultsPtr->sortedOisCandidate[1][0].distortion +
+		oisResultsPtr->sortedOisCandidate[2][0].distortion +
+		oisResultsPtr->sortedOisCandidate[3][0].distortion +
+		oisResultsPtr->sortedOisCandidate[4][0].distortion + 1;
+}
+
+// log2(x) in Q8, the mantissa is linearly interpolated
+static EB_S32 Log2Q8(
+	EB_U64                             x)
+{
+	EB_U32 msb = 0;
+
+	while ((x >> (msb + 1)) != 0) {
+		msb++;
+	}
+
+	return (EB_S32)((msb << 8) + ((msb >= 8 ? (x >> (msb - 8)) : (x << (8 - msb))) & 255));
+}
+
+// Rounds a Q4 value to the nearest integer, halves away from zero
+static EB_S32 RoundQ4(
+	EB_S32                             x)
+{
+	return (x >= 0) ? (x + 8) >> 4 : -((8 - x) >> 4);
+}
+
+/************************************************
+* Update Propagate Delta QP
+** Temporal importance of each LCU for CRF, in the
+** manner of a macroblock tree: the lookahead pictures
+** are walked in reverse decode order and each one
+** hands the part of its intra cost (and of what it
+** inherited) that motion compensation saves to the
+** collocated LCU of its references. The ME direction
+** of the 16x16 blocks splits the LCU between list 0
+** and list 1
+** The offsets are zero mean: the LCUs keep the
+** difference to the picture mean, and the picture
+** keeps the difference to the running mean of its
+** temporal layer, so the CRF lands near the CQP rate
+** of the same value
+** LAD Window: min (sliding window size, up to the next I picture)
+************************************************/
+void EbHevcUpdatePropagateDeltaQp(
+	EncodeContext_t                   *encodeContextPtr,
+	SequenceControlSet_t              *sequenceControlSetPtr,
+	PictureParentControlSet_t         *pictureControlSetPtr)
+{
+	InitialRateControlReorderEntry_t   *temporaryQueueEntryPtr;
+	PictureParentControlSet_t          *temporaryPictureControlSetPtr;
+	PictureParentControlSet_t          *windowPcsArray[PROPAGATE_MAX_WINDOW];
+	EB_U64                              propagateCostArray[PROPAGATE_MAX_WINDOW];
+	EB_U32                              framesToCheck;
+	EB_U32                              framesToCheckIndex;
+	EB_U32                              sortIndex;
+	EB_U32                              inputQueueIndex;
+	EB_U32                              temporalLayerIndex = pictureControlSetPtr->temporalLayerIndex;
+	EB_U16                              lcuIdx;
+	EB_S32                              deltaQpSum = 0;
+	EB_S32                              pictureDeltaQp;
+	EB_S32                             *layerMeanPtr = &encodeContextPtr->propagateDeltaQpLayerMean[temporalLayerIndex];
+
+	// Collect the lookahead pictures up to the next I picture, the current picture is entry 0
+	framesToCheck = 0;
+	windowPcsArray[0] = pictureControlSetPtr;
+	if (!pictureControlSetPtr->endOfSequenceFlag && pictureControlSetPtr->isUsedAsReferenceFlag) {
+		EB_U32 framesInWindow = MIN(MIN(pictureControlSetPtr->framesInSw, sequenceControlSetPtr->staticConfig.lookAheadDistance + 1), PROPAGATE_MAX_WINDOW);
+
+		inputQueueIndex = (encodeContextPtr->initialRateControlReorderQueueHeadIndex == INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH - 1) ? 0 : encodeContextPtr->initialRateControlReorderQueueHeadIndex + 1;
+		for (framesToCheckIndex = 1; framesToCheckIndex < framesInWindow; framesToCheckIndex++) {
+			temporaryQueueEntryPtr = encodeContextPtr->initialRateControlReorderQueue[inputQueueIndex];
+			temporaryPictureControlSetPtr = ((PictureParentControlSet_t*)(temporaryQueueEntryPtr->parentPcsWrapperPtr)->objectPtr);
+
+			if (temporaryPictureControlSetPtr->sliceType == EB_I_PICTURE) {
+				break;
+			}
+
+			// Insertion sort on the decode order, latest decoded first
+			for (sortIndex = ++framesToCheck; sortIndex > 1 && windowPcsArray[sortIndex - 1]->decodeOrder < temporaryPictureControlSetPtr->decodeOrder; --sortIndex) {
+				windowPcsArray[sortIndex] = windowPcsArray[sortIndex - 1];
+			}
+			windowPcsArray[sortIndex] = temporaryPictureControlSetPtr;
+
+			if (temporaryPictureControlSetPtr->endOfSequenceFlag) {
+				break;
+			}
+			inputQueueIndex = (inputQueueIndex == INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH - 1) ? 0 : inputQueueIndex + 1;
+		}
+	}
+
+	// LCU Loop
+	for (lcuIdx = 0; lcuIdx < pictureControlSetPtr->lcuTotalCount; ++lcuIdx) {
+		EB_U64 intraCost = OisDistortionLcu(pictureControlSetPtr, lcuIdx);
+		EB_S32 deltaQp;
+
+		EB_MEMSET(propagateCostArray, 0, sizeof(EB_U64) * (framesToCheck + 1));
+
+		// A picture is handed its cost before it hands it on, its references are decoded earlier
+		for (framesToCheckIndex = 1; framesToCheckIndex <= framesToCheck; framesToCheckIndex++) {
+			EB_U64 futureIntraCost;
+			EB_U64 futureInterCost;
+			EB_U64 inheritedCost;
+			EB_U32 listWeight[2] = { 0, 0 };
+			EB_U32 listIndex;
+			EB_U32 blockIndex;
+
+			temporaryPictureControlSetPtr = windowPcsArray[framesToCheckIndex];
+
+			futureIntraCost = OisDistortionLcu(temporaryPictureControlSetPtr, lcuIdx);
+			futureInterCost = MIN(temporaryPictureControlSetPtr->rcMEdistortion[lcuIdx], futureIntraCost);
+
+			// The inherited fraction of the picture cost and of what propagated into it
+			inheritedCost = ((futureIntraCost + propagateCostArray[framesToCheckIndex]) * (((futureIntraCost - futureInterCost) << 8) / futureIntraCost)) >> 8;
+
+			// Share of each list from the best ME direction of the 16x16 blocks, in 32nds
+			for (blockIndex = 0; blockIndex < 16; ++blockIndex) {
+				EB_U8 direction = temporaryPictureControlSetPtr->meResultsBuffer[lcuIdx * LCU_ME_RESULTS_STRIDE + 5 + blockIndex].distortionDirection[0].direction;
+
+				listWeight[REF_LIST_0] += (direction == UNI_PRED_LIST_0) ? 2 : (direction == BI_PRED) ? 1 : 0;
+				listWeight[REF_LIST_1] += (direction == UNI_PRED_LIST_1) ? 2 : (direction == BI_PRED) ? 1 : 0;
+			}
+			if (temporaryPictureControlSetPtr->refList1Count == 0) {
+				listWeight[REF_LIST_0] = 32;
+				listWeight[REF_LIST_1] = 0;
+			}
+
+			for (listIndex = REF_LIST_0; listIndex <= REF_LIST_1; ++listIndex) {
+				if (listWeight[listIndex] == 0 || (listIndex == REF_LIST_0 ? temporaryPictureControlSetPtr->refList0Count : temporaryPictureControlSetPtr->refList1Count) == 0) {
+					continue;
+				}
+				// References outside of the window take nothing
+				for (sortIndex = 0; sortIndex <= framesToCheck; ++sortIndex) {
+					if (windowPcsArray[sortIndex]->pictureNumber == temporaryPictureControlSetPtr->refPicPocArray[listIndex]) {
+						propagateCostArray[sortIndex] += (inheritedCost * listWeight[listIndex]) >> 5;
+						break;
+					}
+				}
+			}
+		}
+
+		// Offset in Q4, it fits the LCU array until the picture mean is known
+		deltaQp = -((PROPAGATE_DELTA_QP_STRENGTH * (Log2Q8(intraCost + propagateCostArray[0]) - Log2Q8(intraCost)) + 8) >> 4);
+		deltaQp = MAX(deltaQp, -(PROPAGATE_MAX_DELTA_QP << 4));
+
+		pictureControlSetPtr->propagateDeltaQpArray[lcuIdx] = (EB_S8)deltaQp;
+		deltaQpSum += deltaQp;
+	}
+
+	// The picture keeps the difference to the running mean of its temporal layer
+	pictureDeltaQp = deltaQpSum / (EB_S32)pictureControlSetPtr->lcuTotalCount;
+	encodeContextPtr->propagateDeltaQpLayerCount[temporalLayerIndex] = MIN(encodeContextPtr->propagateDeltaQpLayerCount[temporalLayerIndex] + 1, PROPAGATE_LAYER_MEAN_WINDOW);
+	*layerMeanPtr += (pictureDeltaQp - *layerMeanPtr) / (EB_S32)encodeContextPtr->propagateDeltaQpLayerCount[temporalLayerIndex];
+	pictureControlSetPtr->propagateDeltaQp = (EB_S8)CLIP3(-PROPAGATE_MAX_DELTA_QP, PROPAGATE_MAX_DELTA_QP, RoundQ4(pictureDeltaQp - *layerMeanPtr));
+
+	// The LCUs keep the difference to the picture mean
+	for (lcuIdx = 0; lcuIdx < pictureControlSetPtr->lcuTotalCount; ++lcuIdx) {
+		pictureControlSetPtr->propagateDeltaQpArray[lcuIdx] = (EB_S8)RoundQ4(pictureControlSetPtr->propagateDeltaQpArray[lcuIdx] - pictureDeltaQp);
+	}
+
+	return;
+}
+
 /****************************************
 * Init ZZ Cost array to default values
 ** Used when no Lookahead is available
@@ -729,7 +905,7 @@ void UpdateHomogeneityOverTime(
 				break;
 			}
 
-			variancePtr = temporaryPictureControlSetPtr->variance[lcuIdx];
+			variancePtr = &temporaryPictureControlSetPtr->varianceBuffer[lcuIdx * LCU_VARIANCE_STRIDE];
 
 			meanSqrvariance64x64Based += (variancePtr[ME_TIER_ZERO_PU_64x64])*(variancePtr[ME_TIER_ZERO_PU_64x64]);
 			meanvariance64x64Based += (variancePtr[ME_TIER_ZERO_PU_64x64]);
@@ -869,6 +1045,123 @@ void EbHevcUpdateHistogramQueueEntry(
 	return;
 }
 
+/************************************************
+* EbHevcReportRcPassStats
+*   Hands the complexity of one picture to the
+*   application in the first rate control pass
+************************************************/
+static void EbHevcReportRcPassStats(
+	SequenceControlSet_t              *sequenceControlSetPtr,
+	PictureParentControlSet_t         *pictureControlSetPtr)
+{
+	EncodeContext_t                   *encodeContextPtr = sequenceControlSetPtr->encodeContextPtr;
+	EbCallback_t                      *appCallbackPtr = encodeContextPtr->appCallbackPtr;
+	EB_H265_RC_STATS                   stats;
+	EB_U32                             lcuIndex;
+	EB_U32                             qpIndex;
+	EB_U32                             intervalIndex;
+
+	EB_MEMSET(&stats, 0, sizeof(EB_H265_RC_STATS));
+	stats.pictureNumber = pictureControlSetPtr->pictureNumber;
+	stats.sliceType = (EB_U8)pictureControlSetPtr->sliceType;
+	stats.temporalLayerIndex = pictureControlSetPtr->temporalLayerIndex;
+	stats.sceneChangeFlag = (EB_U8)pictureControlSetPtr->sceneChangeFlag;
+
+	for (lcuIndex = 0; lcuIndex < sequenceControlSetPtr->lcuTotalCount; ++lcuIndex) {
+		OisCu32Cu16Results_t *oisResultsPtr = &pictureControlSetPtr->oisCu32Cu16ResultsBuffer[lcuIndex * LCU_OIS_CU32_CU16_STRIDE];
+
+		if (sequenceControlSetPtr->lcuParamsArray[lcuIndex].isCompleteLcu) {
+			if (pictureControlSetPtr->sliceType != EB_I_PICTURE) {
+				stats.meDistortion += pictureControlSetPtr->rcMEdistortion[lcuIndex];
+			}
+			stats.oisDistortion +=
+				oisResultsPtr->sortedOisCandidate[1][0].distortion +
+				oisResultsPtr->sortedOisCandidate[2][0].distortion +
+				oisResultsPtr->sortedOisCandidate[3][0].distortion +
+				oisResultsPtr->sortedOisCandidate[4][0].distortion;
+			++stats.fullLcuCount;
+		}
+	}
+
+	// Same prediction as the high level rate control, from the ME and OIS histograms
+	for (qpIndex = 0; qpIndex < sizeof(stats.predictedBits) / sizeof(stats.predictedBits[0]); ++qpIndex) {
+		RateControlTables_t *rateControlTablesPtr = &encodeContextPtr->rateControlTablesArray[qpIndex];
+		EB_U64               predBits = 0;
+		EB_U64               predBitsIntra = 0;
+
+		for (intervalIndex = 0; intervalIndex < NUMBER_OF_INTRA_SAD_INTERVALS; ++intervalIndex) {
+			predBitsIntra += (EB_U64)pictureControlSetPtr->oisDistortionHistogram[intervalIndex] * rateControlTablesPtr->intraSadBitsArray[0][intervalIndex];
+		}
+		if (pictureControlSetPtr->sliceType == EB_I_PICTURE) {
+			predBits = predBitsIntra;
+		}
+		else {
+			for (intervalIndex = 0; intervalIndex < NUMBER_OF_SAD_INTERVALS; ++intervalIndex) {
+				predBits += (EB_U64)pictureControlSetPtr->meDistortionHistogram[intervalIndex] * rateControlTablesPtr->sadBitsArray[pictureControlSetPtr->temporalLayerIndex][intervalIndex];
+			}
+			if (predBits > predBitsIntra * 3) {
+				predBits = predBitsIntra;
+			}
+		}
+
+		// Scaled to the picture area for the LCUs at the picture boundaries
+		stats.predictedBits[qpIndex] = (EB_U32)MIN(predBits * sequenceControlSetPtr->lumaWidth * sequenceControlSetPtr->lumaHeight / MAX((EB_U64)stats.fullLcuCount << 12, 1), 0xFFFFFFFF);
+	}
+
+	sequenceControlSetPtr->staticConfig.rcStatsCallback(
+		((EB_COMPONENTTYPE*)appCallbackPtr->handle)->pApplicationPrivate,
+		&stats);
+}
+
+/************************************************
+* EbHevcCompleteRcPassPicture
+*   The first rate control pass stops after the
+*   Initial Rate Control: posts an empty packet and
+*   releases what the Picture Manager and the Rate
+*   Control release at the end of an encode
+************************************************/
+static void EbHevcCompleteRcPassPicture(
+	SequenceControlSet_t              *sequenceControlSetPtr,
+	PictureParentControlSet_t         *pictureControlSetPtr)
+{
+	EncodeContext_t                   *encodeContextPtr = sequenceControlSetPtr->encodeContextPtr;
+	EbObjectWrapper_t                 *outputStreamWrapperPtr = pictureControlSetPtr->outputStreamWrapperPtr;
+	EB_BUFFERHEADERTYPE               *outputStreamPtr = (EB_BUFFERHEADERTYPE*)outputStreamWrapperPtr->objectPtr;
+
+	// Pictures leave in display order, so the last one carries the EOS
+	outputStreamPtr->nFlags = pictureControlSetPtr->endOfSequenceFlag ? EB_BUFFERFLAG_EOS : 0;
+	outputStreamPtr->nFilledLen = 0;
+	outputStreamPtr->nTickCount = 0;
+	outputStreamPtr->pts = pictureControlSetPtr->ebInputPtr->pts;
+	outputStreamPtr->dts = pictureControlSetPtr->pictureNumber;
+	outputStreamPtr->sliceType = pictureControlSetPtr->isUsedAsReferenceFlag ?
+		pictureControlSetPtr->idrFlag ? EB_IDR_PICTURE :
+		pictureControlSetPtr->sliceType : EB_NON_REF_PICTURE;
+	outputStreamPtr->pAppPrivate = pictureControlSetPtr->ebInputPtr->pAppPrivate;
+
+	if (sequenceControlSetPtr->staticConfig.speedControlFlag) {
+		EbBlockOnMutex(encodeContextPtr->scBufferMutex);
+		encodeContextPtr->scFrameOut++;
+		EbReleaseMutex(encodeContextPtr->scBufferMutex);
+	}
+
+	// Hand zero-copy planes back to the application
+	if (sequenceControlSetPtr->staticConfig.zeroCopyInput && pictureControlSetPtr->enhancedPicturePtr->appBufferPtr) {
+		sequenceControlSetPtr->staticConfig.inputReleaseCallback((EB_BUFFERHEADERTYPE*)pictureControlSetPtr->enhancedPicturePtr->appBufferPtr);
+		pictureControlSetPtr->enhancedPicturePtr->appBufferPtr = EB_NULL;
+	}
+
+	// The Sequence Control Set count of the Picture Manager feedback
+	if (sequenceControlSetPtr->staticConfig.rateControlMode == 1) {
+		EbReleaseObject(pictureControlSetPtr->sequenceControlSetWrapperPtr);
+	}
+	EbReleaseObject(pictureControlSetPtr->sequenceControlSetWrapperPtr);
+	EbReleaseObject(pictureControlSetPtr->ebInputWrapperPtr);
+	EbReleaseObject(pictureControlSetPtr->pPcsWrapperPtr);
+
+	EbPostFullObject(outputStreamWrapperPtr);
+}
+
 /************************************************
 * Initial Rate Control Kernel
 * The Initial Rate Control Process determines the initial bit budget for each
@@ -945,7 +1238,8 @@ void* InitialRateControlKernel(void *inputPtr)
 				pictureControlSetPtr,
 				inputResultsPtr);
 
-			if (sequenceControlSetPtr->staticConfig.rateControlMode)
+			// The first pass has no Rate Control to consume the histogram queue
+			if (sequenceControlSetPtr->rateStatisticsFlag && sequenceControlSetPtr->staticConfig.rcPass != 1)
 			{
 				if (sequenceControlSetPtr->staticConfig.lookAheadDistance != 0){
 
@@ -1032,7 +1326,7 @@ void* InitialRateControlKernel(void *inputPtr)
 					else
 						pictureControlSetPtr->endOfSequenceRegion = EB_FALSE;
 
-					if (sequenceControlSetPtr->staticConfig.rateControlMode)
+					if (sequenceControlSetPtr->rateStatisticsFlag && sequenceControlSetPtr->staticConfig.rcPass != 1)
 					{
 						// Determine offset from the Head Ptr for HLRC histogram queue and set the life count
 						if (sequenceControlSetPtr->staticConfig.lookAheadDistance != 0){
@@ -1077,6 +1371,14 @@ void* InitialRateControlKernel(void *inputPtr)
 							pictureControlSetPtr);
 					}
 
+					if (sequenceControlSetPtr->staticConfig.rateControlMode == 2) {
+						// Derive the CRF delta QPs from the temporal importance over the lookahead
+						EbHevcUpdatePropagateDeltaQp(
+							encodeContextPtr,
+							sequenceControlSetPtr,
+							pictureControlSetPtr);
+					}
+
 					// Use the temporal layer 0 isLcuMotionFieldNonUniform array for all the other layer pictures in the mini GOP
 					if (!pictureControlSetPtr->endOfSequenceFlag && sequenceControlSetPtr->staticConfig.lookAheadDistance != 0) {
 
@@ -1099,34 +1401,47 @@ void* InitialRateControlKernel(void *inputPtr)
 							pictureControlSetPtr);
 					}
 
-					// Get Empty Reference Picture Object
-					EbGetEmptyObject(
-						sequenceControlSetPtr->encodeContextPtr->referencePicturePoolFifoPtr,
-						&referencePictureWrapperPtr);
-					((PictureParentControlSet_t*)(queueEntryPtr->parentPcsWrapperPtr->objectPtr))->referencePictureWrapperPtr = referencePictureWrapperPtr;
-
-					// Give the new Reference a nominal liveCount of 1
-					EbObjectIncLiveCount(
-						((PictureParentControlSet_t*)(queueEntryPtr->parentPcsWrapperPtr->objectPtr))->referencePictureWrapperPtr,
-						1);
 					//OPTION 1:  get the buffer in resource coordination
-
 					EbGetEmptyObject(
 						sequenceControlSetPtr->encodeContextPtr->streamOutputFifoPtr,
 						&outputStreamWrapperPtr);
 
 					pictureControlSetPtr->outputStreamWrapperPtr = outputStreamWrapperPtr;
 
-                    // Get Empty Results Object
-					EbGetEmptyObject(
-						contextPtr->initialrateControlResultsOutputFifoPtr,
-						&outputResultsWrapperPtr);
-
-					outputResultsPtr = (InitialRateControlResults_t*)outputResultsWrapperPtr->objectPtr;
-					outputResultsPtr->pictureControlSetWrapperPtr = queueEntryPtr->parentPcsWrapperPtr;
-					/////////////////////////////
-					// Post the Full Results Object
-					EbPostFullObject(outputResultsWrapperPtr);
+					if (sequenceControlSetPtr->staticConfig.rcPass == 1) {
+						// The first pass only needs the analysis, the picture is not encoded
+						EbHevcReportRcPassStats(
+							sequenceControlSetPtr,
+							pictureControlSetPtr);
+
+						EbHevcCompleteRcPassPicture(
+							sequenceControlSetPtr,
+							pictureControlSetPtr);
+					}
+					else {
+						// Get Empty Reference Picture Object
+						EbGetEmptyObject(
+							sequenceControlSetPtr->encodeContextPtr->referencePicturePoolFifoPtr,
+							&referencePictureWrapperPtr);
+						pictureControlSetPtr->referencePictureWrapperPtr = referencePictureWrapperPtr;
+
+						// Give the new Reference a nominal liveCount of 1
+						EbObjectIncLiveCount(
+							pictureControlSetPtr->referencePictureWrapperPtr,
+							1);
+
+						// Get Empty Results Object
+						EbGetEmptyObject(
+							contextPtr->initialrateControlResultsOutputFifoPtr,
+							&outputResultsWrapperPtr);
+
+						outputResultsPtr = (InitialRateControlResults_t*)outputResultsWrapperPtr->objectPtr;
+						outputResultsPtr->pictureControlSetWrapperPtr = queueEntryPtr->parentPcsWrapperPtr;
+
+						/////////////////////////////
+						// Post the Full Results Object
+						EbPostFullObject(outputResultsWrapperPtr);
+					}
 #if LATENCY_PROFILE
         double latency = 0.0;
         EB_U64 finishTimeSeconds = 0;
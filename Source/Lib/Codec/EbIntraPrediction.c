@@ -3171,7 +3171,7 @@ static void IntraModeAngular16bit_27To33(
     EB_S32           intraPredAngle = intraModeAngularTable[mode - INTRA_VERTICAL_MODE];
     refSampMain    = refSamples + (size << 1);
 
-    IntraAngVertical_16bit_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](
+    IntraAngVertical_16bit_funcPtrArray[SSE2_AVX2_SLOT](
         size,
         refSampMain,
         predictionPtr,
@@ -3294,7 +3294,7 @@ static void IntraModeAngular16bit_19To25(
     }
 
 
-	IntraAngVertical_16bit_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](
+	IntraAngVertical_16bit_funcPtrArray[SSE2_AVX2_SLOT](
         size,
         refSampMain,
         predictionPtr,
@@ -4688,7 +4688,7 @@ EB_ERRORTYPE EncodePassIntraPrediction16bit(
         switch(lumaMode) {
 
         case EB_INTRA_PLANAR:
-        IntraPlanar_16bit_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](
+        IntraPlanar_16bit_funcPtrArray[SSE2_AVX2_SLOT](
                 puSize,
                 yIntraReferenceArrayReverse,
                 (EB_U16*)predictionPtr->bufferY + lumaOffset,
@@ -4787,14 +4787,14 @@ EB_ERRORTYPE EncodePassIntraPrediction16bit(
 
         switch(chromaModeAdj) {
         case EB_INTRA_PLANAR:
-             IntraPlanar_16bit_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](
+             IntraPlanar_16bit_funcPtrArray[SSE2_AVX2_SLOT](
                 puChromaSize,
                 cbIntraReferenceArrayReverse,
                 (EB_U16*)predictionPtr->bufferCb + chromaOffset,
                 predictionPtr->strideCb,
                 EB_FALSE);
 
-            IntraPlanar_16bit_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](
+            IntraPlanar_16bit_funcPtrArray[SSE2_AVX2_SLOT](
                 puChromaSize,
                 crIntraReferenceArrayReverse,
                 (EB_U16*)predictionPtr->bufferCr + chromaOffset,
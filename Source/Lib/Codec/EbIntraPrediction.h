@@ -571,11 +571,13 @@ static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraPlanar_funcPtrArray[EB_ASM_TYPE_TOTAL
     IntraModePlanar_AVX2_INTRIN,
 };
 
-static EB_INTRA_NOANG_16bit_TYPE FUNC_TABLE IntraPlanar_16bit_funcPtrArray[EB_ASM_TYPE_TOTAL] = {
+static EB_INTRA_NOANG_16bit_TYPE FUNC_TABLE IntraPlanar_16bit_funcPtrArray[EB_ASM_SSE2_AVX2_TYPE_TOTAL] = {
     // C_DEFAULT
     IntraModePlanar16bit,
-    // AVX2
+    // SSE2
     IntraModePlanar16bit_SSE2_INTRIN,
+    // AVX2
+    IntraModePlanar16bit_AVX2_INTRIN,
 };
 
 static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraAng34_funcPtrArray[EB_ASM_TYPE_TOTAL] = {
@@ -628,11 +630,13 @@ static EB_INTRA_ANG_TYPE FUNC_TABLE IntraAngVertical_funcPtrArray[EB_ASM_TYPE_TO
     IntraModeAngular_Vertical_Kernel_AVX2_INTRIN,
 };
 
-static EB_INTRA_ANG_16BIT_TYPE FUNC_TABLE IntraAngVertical_16bit_funcPtrArray[EB_ASM_TYPE_TOTAL] = {
+static EB_INTRA_ANG_16BIT_TYPE FUNC_TABLE IntraAngVertical_16bit_funcPtrArray[EB_ASM_SSE2_AVX2_TYPE_TOTAL] = {
     // C_DEFAULT
     IntraModeAngular16bit_Vertical_Kernel,
-    // AVX2
+    // SSE2
     IntraModeAngular16bit_Vertical_Kernel_SSE2_INTRIN,
+    // AVX2
+    IntraModeAngular16bit_Vertical_Kernel_AVX2_INTRIN,
 };
 
 static EB_INTRA_ANG_TYPE FUNC_TABLE IntraAngHorizontal_funcPtrArray[EB_ASM_TYPE_TOTAL] = {
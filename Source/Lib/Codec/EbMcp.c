@@ -128,7 +128,7 @@ void UniPredHevcInterpolationMd(
 		fracPosx = posX & 0x03;
 		fracPosy = posY & 0x03;
 
-		uniPredLumaIFFunctionPtrArrayNew[!!(ASM_TYPES & PREAVX2_MASK)][fracPosx + (fracPosy << 2)](
+		uniPredLumaIFFunctionPtrArrayNew[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][fracPosx + (fracPosy << 2)](
 			is16bit ? refPic->bufferY + 4 + 4 * refPic->strideY : refPic->bufferY + integPosx + integPosy*refPic->strideY,
 			refPic->strideY,
 			dst->bufferY + dstLumaIndex,
@@ -205,7 +205,7 @@ void EncodeUniPredInterpolation(
     fracPosx  = posX & 0x03;
     fracPosy  = posY & 0x03;
 
-	uniPredLumaIFFunctionPtrArrayNew[!!(ASM_TYPES & PREAVX2_MASK)][fracPosx + (fracPosy << 2)](
+	uniPredLumaIFFunctionPtrArrayNew[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][fracPosx + (fracPosy << 2)](
 		refPic->bufferY + integPosx + integPosy*refPic->strideY,
 		refPic->strideY,
 		dst->bufferY + dstLumaIndex,
@@ -393,7 +393,7 @@ void BiPredHevcInterpolationMd(
 			// Note: SSSE3 Interpolation can only be enabled if 
 			//       SSSE3 clipping functions are enabled
 			//doing the luma interpolation
-			biPredLumaIFFunctionPtrArrayNew[!!(ASM_TYPES & PREAVX2_MASK)][fracPosx + (fracPosy << 2)](
+			biPredLumaIFFunctionPtrArrayNew[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][fracPosx + (fracPosy << 2)](
 				is16Bit ? refPicList0->bufferY + 4 + 4 * refPicList0->strideY : refPicList0->bufferY + integPosx + integPosy*refPicList0->strideY,
 				refPicList0->strideY,
 				refList0TempDst,
@@ -409,7 +409,7 @@ void BiPredHevcInterpolationMd(
 			fracPosy = refList1PosY & 0x03;
 
 			//doing the luma interpolation
-			biPredLumaIFFunctionPtrArrayNew[!!(ASM_TYPES & PREAVX2_MASK)][fracPosx + (fracPosy << 2)](
+			biPredLumaIFFunctionPtrArrayNew[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][fracPosx + (fracPosy << 2)](
 				is16Bit ? refPicList1->bufferY + 4 + 4 * refPicList1->strideY : refPicList1->bufferY + integPosx + integPosy*refPicList1->strideY,
 				refPicList1->strideY,
 				refList1TempDst,
@@ -634,7 +634,7 @@ void EncodeBiPredInterpolation(
 		// Note: SSSE3 Interpolation can only be enabled if 
 		//       SSSE3 clipping functions are enabled
 		//doing the luma interpolation
-		biPredLumaIFFunctionPtrArrayNew[!!(ASM_TYPES & PREAVX2_MASK)][fracPosx + (fracPosy << 2)](
+		biPredLumaIFFunctionPtrArrayNew[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][fracPosx + (fracPosy << 2)](
 			refPicList0->bufferY + integPosx + integPosy*refPicList0->strideY,
 			refPicList0->strideY,
 			refList0TempDst,
@@ -650,7 +650,7 @@ void EncodeBiPredInterpolation(
 		fracPosy = refList1PosY & 0x03;
 
 		//doing the luma interpolation
-		biPredLumaIFFunctionPtrArrayNew[!!(ASM_TYPES & PREAVX2_MASK)][fracPosx + (fracPosy << 2)](
+		biPredLumaIFFunctionPtrArrayNew[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][fracPosx + (fracPosy << 2)](
 			refPicList1->bufferY + integPosx + integPosy*refPicList1->strideY,
 			refPicList1->strideY,
 			refList1TempDst,
@@ -1108,6 +1108,110 @@ void GeneratePadding16Bit(
 }
 
 
+/** GeneratePaddingLines()
+        pads the lines [firstLine, firstLine + lineCount) of the target picture horizontally, then
+        adds the top/bottom padding when the range contains the first/last line of the picture.
+        Disjoint line ranges can be padded concurrently.
+ */
+void GeneratePaddingLines(
+    EB_BYTE  srcPic,                    //output paramter, pointer to the source picture to be padded.
+    EB_U32   srcStride,                 //input paramter, the stride of the source picture to be padded.
+    EB_U32   originalSrcWidth,          //input paramter, the width of the source picture which excludes the padding.
+    EB_U32   originalSrcHeight,         //input paramter, the height of the source picture which excludes the padding.
+    EB_U32   paddingWidth,              //input paramter, the padding width.
+    EB_U32   paddingHeight,             //input paramter, the padding height.
+    EB_U32   firstLine,                 //input paramter, the first line to pad.
+    EB_U32   lineCount)                 //input paramter, the number of lines to pad.
+{
+    EB_U32   verticalIdx = lineCount;
+    EB_BYTE  tempSrcPic0;
+    EB_BYTE  tempSrcPic1;
+
+    tempSrcPic0 = srcPic + paddingWidth + (paddingHeight + firstLine)*srcStride;
+    while(verticalIdx)
+    {
+        // horizontal padding
+        EB_MEMSET(tempSrcPic0-paddingWidth, *tempSrcPic0, paddingWidth);
+        EB_MEMSET(tempSrcPic0+originalSrcWidth, *(tempSrcPic0+originalSrcWidth-1), paddingWidth);
+
+        tempSrcPic0 += srcStride;
+        --verticalIdx;
+    }
+
+    // top part data copy
+    if (firstLine == 0) {
+        tempSrcPic0 = srcPic + paddingHeight*srcStride;
+        tempSrcPic1 = tempSrcPic0;
+        for (verticalIdx = paddingHeight; verticalIdx; --verticalIdx) {
+            tempSrcPic1 -= srcStride;
+            EB_MEMCPY(tempSrcPic1, tempSrcPic0, sizeof(EB_U8)*srcStride);
+        }
+    }
+
+    // bottom part data copy
+    if (firstLine + lineCount == originalSrcHeight) {
+        tempSrcPic0 = srcPic + (paddingHeight+originalSrcHeight-1)*srcStride;
+        tempSrcPic1 = tempSrcPic0;
+        for (verticalIdx = paddingHeight; verticalIdx; --verticalIdx) {
+            tempSrcPic1 += srcStride;
+            EB_MEMCPY(tempSrcPic1, tempSrcPic0, sizeof(EB_U8)*srcStride);
+        }
+    }
+
+    return;
+}
+/** GeneratePaddingLines16Bit()
+        16bit version of GeneratePaddingLines(); srcStride, originalSrcWidth and paddingWidth are in bytes.
+ */
+void GeneratePaddingLines16Bit(
+    EB_BYTE  srcPic,                    //output paramter, pointer to the source picture to be padded.
+    EB_U32   srcStride,                 //input paramter, the stride of the source picture to be padded.
+    EB_U32   originalSrcWidth,          //input paramter, the width of the source picture which excludes the padding.
+    EB_U32   originalSrcHeight,         //input paramter, the height of the source picture which excludes the padding.
+    EB_U32   paddingWidth,              //input paramter, the padding width.
+    EB_U32   paddingHeight,             //input paramter, the padding height.
+    EB_U32   firstLine,                 //input paramter, the first line to pad.
+    EB_U32   lineCount)                 //input paramter, the number of lines to pad.
+{
+    EB_U32   verticalIdx = lineCount;
+    EB_BYTE  tempSrcPic0;
+    EB_BYTE  tempSrcPic1;
+
+    tempSrcPic0 = srcPic + paddingWidth + (paddingHeight + firstLine)*srcStride;
+    while (verticalIdx)
+    {
+        // horizontal padding
+        memset16bit((EB_U16*)(tempSrcPic0 - paddingWidth), ((EB_U16*)(tempSrcPic0))[0], paddingWidth >> 1);
+        memset16bit((EB_U16*)(tempSrcPic0 + originalSrcWidth), ((EB_U16*)(tempSrcPic0 + originalSrcWidth - 2))[0], paddingWidth >> 1);
+
+        tempSrcPic0 += srcStride;
+        --verticalIdx;
+    }
+
+    // top part data copy
+    if (firstLine == 0) {
+        tempSrcPic0 = srcPic + paddingHeight*srcStride;
+        tempSrcPic1 = tempSrcPic0;
+        for (verticalIdx = paddingHeight; verticalIdx; --verticalIdx) {
+            tempSrcPic1 -= srcStride;
+            EB_MEMCPY(tempSrcPic1, tempSrcPic0, sizeof(EB_U8)*srcStride);
+        }
+    }
+
+    // bottom part data copy
+    if (firstLine + lineCount == originalSrcHeight) {
+        tempSrcPic0 = srcPic + (paddingHeight + originalSrcHeight - 1)*srcStride;
+        tempSrcPic1 = tempSrcPic0;
+        for (verticalIdx = paddingHeight; verticalIdx; --verticalIdx) {
+            tempSrcPic1 += srcStride;
+            EB_MEMCPY(tempSrcPic1, tempSrcPic0, sizeof(EB_U8)*srcStride);
+        }
+    }
+
+    return;
+}
+
+
 /** PadInputPicture()
 is used to pad the input picture in order to get . The horizontal padding happens first and then the vertical padding.
 */
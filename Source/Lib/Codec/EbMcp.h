@@ -366,6 +366,24 @@ extern void GeneratePadding16Bit(
 	EB_U32   originalSrcHeight,
 	EB_U32   paddingWidth,
 	EB_U32   paddingHeight);
+extern void GeneratePaddingLines(
+    EB_BYTE  srcPic,
+    EB_U32   srcStride,
+    EB_U32   originalSrcWidth,
+    EB_U32   originalSrcHeight,
+    EB_U32   paddingWidth,
+    EB_U32   paddingHeight,
+    EB_U32   firstLine,
+    EB_U32   lineCount);
+extern void GeneratePaddingLines16Bit(
+    EB_BYTE  srcPic,
+    EB_U32   srcStride,
+    EB_U32   originalSrcWidth,
+    EB_U32   originalSrcHeight,
+    EB_U32   paddingWidth,
+    EB_U32   paddingHeight,
+    EB_U32   firstLine,
+    EB_U32   lineCount);
 extern void PadInputPicture(
     EB_BYTE  srcPic,
     EB_U32   srcStride,
@@ -657,8 +675,8 @@ extern const InterpolationFilterOutRaw16bit biPredLumaIFFunctionPtrArrayNew16bit
 extern const ChromaFilterOutRaw16bit biPredChromaIFFunctionPtrArrayNew16bit[EB_ASM_TYPE_TOTAL][64];
 extern const sampleBiPredClipping biPredClippingFuncPtrArray[EB_ASM_TYPE_TOTAL];
 
-extern const InterpolationFilterNew     uniPredLumaIFFunctionPtrArrayNew[EB_ASM_TYPE_TOTAL][16];
-extern const InterpolationFilterOutRaw  biPredLumaIFFunctionPtrArrayNew[EB_ASM_TYPE_TOTAL][16];
+extern const InterpolationFilterNew     uniPredLumaIFFunctionPtrArrayNew[EB_ASM_AVX512_TYPE_TOTAL][16];
+extern const InterpolationFilterOutRaw  biPredLumaIFFunctionPtrArrayNew[EB_ASM_AVX512_TYPE_TOTAL][16];
 extern const ChromaFilterNew            uniPredChromaIFFunctionPtrArrayNew[EB_ASM_TYPE_TOTAL][64];
 extern const ChromaFilterOutRaw         biPredChromaIFFunctionPtrArrayNew[EB_ASM_TYPE_TOTAL][64];
 extern const sampleBiPredClipping16bit biPredClipping16bitFuncPtrArray[EB_ASM_TYPE_TOTAL];
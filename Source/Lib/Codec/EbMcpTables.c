@@ -6,6 +6,7 @@
 #include "EbMcp.h"
 #include "EbMcp_C.h"
 #include "EbMcp_AVX2.h"
+#include "EbMcp_AVX512.h"
 
 /**************************************************
 * Function Pointer Tables
@@ -25,7 +26,7 @@ const sampleBiPredClipping16bit biPredClipping16bitFuncPtrArray[EB_ASM_TYPE_TOTA
 };
 
 // Luma
-const InterpolationFilterNew uniPredLumaIFFunctionPtrArrayNew[EB_ASM_TYPE_TOTAL][16] = {     //[ASM type][Interpolation position]
+const InterpolationFilterNew uniPredLumaIFFunctionPtrArrayNew[EB_ASM_AVX512_TYPE_TOTAL][16] = {     //[ASM type][Interpolation position]
     // C_DEFAULT
     {
         LumaInterpolationCopy,                             //A
@@ -64,6 +65,27 @@ const InterpolationFilterNew uniPredLumaIFFunctionPtrArrayNew[EB_ASM_TYPE_TOTAL]
         LumaInterpolationFilterPosq_SSSE3,                  //q
         LumaInterpolationFilterPosr_SSSE3,                  //r
     },
+#ifndef NON_AVX512_SUPPORT
+    // AVX512
+    {
+        LumaInterpolationCopy_SSSE3,                        //A
+        LumaInterpolationFilterPosa_AVX512,                 //a
+        LumaInterpolationFilterPosb_AVX512,                 //b
+        LumaInterpolationFilterPosc_AVX512,                 //c
+        LumaInterpolationFilterPosd_AVX512,                 //d
+        LumaInterpolationFilterPose_AVX512,                 //e
+        LumaInterpolationFilterPosf_AVX512,                 //f
+        LumaInterpolationFilterPosg_AVX512,                 //g
+        LumaInterpolationFilterPosh_AVX512,                 //h
+        LumaInterpolationFilterPosi_AVX512,                 //i
+        LumaInterpolationFilterPosj_AVX512,                 //j
+        LumaInterpolationFilterPosk_AVX512,                 //k
+        LumaInterpolationFilterPosn_AVX512,                 //n
+        LumaInterpolationFilterPosp_AVX512,                 //p
+        LumaInterpolationFilterPosq_AVX512,                 //q
+        LumaInterpolationFilterPosr_AVX512,                 //r
+    },
+#endif
 };
 
 // Luma
@@ -109,7 +131,7 @@ const InterpolationFilterNew16bit uniPredLuma16bitIFFunctionPtrArray[EB_ASM_TYPE
 };
 
 
-const InterpolationFilterOutRaw biPredLumaIFFunctionPtrArrayNew[EB_ASM_TYPE_TOTAL][16] = {     //[ASM type][Interpolation position]
+const InterpolationFilterOutRaw biPredLumaIFFunctionPtrArrayNew[EB_ASM_AVX512_TYPE_TOTAL][16] = {     //[ASM type][Interpolation position]
         // C_DEFAULT
         {
             LumaInterpolationCopyOutRaw,                        //A
@@ -148,6 +170,27 @@ const InterpolationFilterOutRaw biPredLumaIFFunctionPtrArrayNew[EB_ASM_TYPE_TOTA
             LumaInterpolationFilterPosqOutRaw_SSSE3,             //q
             LumaInterpolationFilterPosrOutRaw_SSSE3,             //r
         },
+#ifndef NON_AVX512_SUPPORT
+        // AVX512
+        {
+            LumaInterpolationCopyOutRaw_SSSE3,                   //A
+            LumaInterpolationFilterPosaOutRaw_AVX512,        //a
+            LumaInterpolationFilterPosbOutRaw_AVX512,        //b
+            LumaInterpolationFilterPoscOutRaw_AVX512,        //c
+            LumaInterpolationFilterPosdOutRaw_SSSE3,         //d
+            LumaInterpolationFilterPoseOutRaw_AVX512,        //e
+            LumaInterpolationFilterPosfOutRaw_AVX512,        //f
+            LumaInterpolationFilterPosgOutRaw_AVX512,        //g
+            LumaInterpolationFilterPoshOutRaw_SSSE3,         //h
+            LumaInterpolationFilterPosiOutRaw_AVX512,        //i
+            LumaInterpolationFilterPosjOutRaw_AVX512,        //j
+            LumaInterpolationFilterPoskOutRaw_AVX512,        //k
+            LumaInterpolationFilterPosnOutRaw_SSSE3,         //n
+            LumaInterpolationFilterPospOutRaw_AVX512,        //p
+            LumaInterpolationFilterPosqOutRaw_AVX512,        //q
+            LumaInterpolationFilterPosrOutRaw_AVX512,        //r
+        },
+#endif
 };
 
 const InterpolationFilterOutRaw16bit biPredLumaIFFunctionPtrArrayNew16bit[EB_ASM_TYPE_TOTAL][16] = {
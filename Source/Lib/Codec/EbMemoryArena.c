@@ -0,0 +1,225 @@
+/*
+* Copyright(c) 2018 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// Summary:
+// EbMemoryArena backs the EB_MALLOC family of one encoder
+// instance. Objects are carved out of large zeroed blocks;
+// only the blocks are recorded in the memory map, so the
+// instance is released block by block at EbDeinitEncoder.
+// Allocations are made while the instance is constructed
+// and from the API calls that return a buffer, such as the
+// stream header and the EOS NAL, which the application does
+// not make concurrently. Data copied with every picture,
+// such as the SEI and RPU payloads, is malloc'd and freed
+// instead so the arena does not grow while encoding. When the
+// context asks for huge pages, dedicated blocks of 2MB or
+// more are mapped on them instead (Linux only).
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "EbDefinitions.h"
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#define EB_ARENA_MIN_ALIGNMENT      16  // malloc alignment
+
+static const char *EbMemorySubsystemName[EB_MEMORY_SUBSYSTEM_COUNT] = {
+    "Encoder Handle",
+    "Sequence Control Set",
+    "Picture Control Set",
+    "Picture Buffers",
+    "System Resources",
+    "Process Contexts"
+};
+
+/***************************************
+ * EbArenaNewBlock
+ *   Obtains a zeroed block from the system
+ *   and records it in the memory map
+ ***************************************/
+static EB_U8* EbArenaNewBlock(
+    EbMemoryContext_t *contextPtr,
+    EB_U64             blockSize)
+{
+    EB_U8 *blockPtr;
+
+    if (contextPtr->memoryMapIndex >= MAX_NUM_PTR) {
+        return (EB_U8*)EB_NULL;
+    }
+
+    blockPtr = (EB_U8*)calloc(1, (size_t)blockSize);
+    if (blockPtr == (EB_U8*)EB_NULL) {
+        return (EB_U8*)EB_NULL;
+    }
+
+    contextPtr->memoryMap[contextPtr->memoryMapIndex].ptrType = EB_N_PTR;
+    contextPtr->memoryMap[contextPtr->memoryMapIndex++].ptr = blockPtr;
+    contextPtr->arenaReservedMemory += blockSize;
+    contextPtr->arenaBlockCount++;
+
+    return blockPtr;
+}
+
+// Mapping of a huge page block, what the memory map records
+typedef struct EbArenaHugeBlock_s {
+    void   *mapPtr;
+    size_t  mapSize;
+} EbArenaHugeBlock_t;
+
+/***************************************
+ * EbArenaNewHugeBlock
+ *   Maps a zeroed block that starts on a huge page, on
+ *   explicit huge pages when asked for and available, else
+ *   advised to transparent huge pages. Returns NULL when
+ *   the block cannot be mapped, the caller falls back to
+ *   EbArenaNewBlock.
+ ***************************************/
+static EB_U8* EbArenaNewHugeBlock(
+    EbMemoryContext_t *contextPtr,
+    EB_U64             blockSize)
+{
+#if defined(__linux__)
+    EbArenaHugeBlock_t *hugeBlockPtr;
+    EB_U8              *mapPtr = (EB_U8*)MAP_FAILED;
+    EB_U8              *blockPtr;
+    size_t              mapSize = ((size_t)blockSize + EB_ARENA_HUGE_PAGE_SIZE - 1) & ~((size_t)EB_ARENA_HUGE_PAGE_SIZE - 1);
+
+    if (contextPtr->memoryMapIndex >= MAX_NUM_PTR) {
+        return (EB_U8*)EB_NULL;
+    }
+    hugeBlockPtr = (EbArenaHugeBlock_t*)malloc(sizeof(EbArenaHugeBlock_t));
+    if (hugeBlockPtr == (EbArenaHugeBlock_t*)EB_NULL) {
+        return (EB_U8*)EB_NULL;
+    }
+
+#ifdef MAP_HUGETLB
+    if (contextPtr->hugePages == EB_HUGE_PAGES_EXPLICIT) {
+        mapPtr = (EB_U8*)mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapPtr != (EB_U8*)MAP_FAILED) {
+            contextPtr->arenaExplicitHugeMemory += mapSize;
+        }
+    }
+#endif
+    if (mapPtr != (EB_U8*)MAP_FAILED) {
+        blockPtr = mapPtr;
+    }
+    else {
+        // One more huge page to start the block on a huge page boundary,
+        // the pages of the slack are never touched
+        mapSize += EB_ARENA_HUGE_PAGE_SIZE;
+        mapPtr = (EB_U8*)mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapPtr == (EB_U8*)MAP_FAILED) {
+            free(hugeBlockPtr);
+            return (EB_U8*)EB_NULL;
+        }
+        blockPtr = (EB_U8*)(((size_t)mapPtr + EB_ARENA_HUGE_PAGE_SIZE - 1) & ~((size_t)EB_ARENA_HUGE_PAGE_SIZE - 1));
+#ifdef MADV_HUGEPAGE
+        if (madvise(blockPtr, mapSize - EB_ARENA_HUGE_PAGE_SIZE, MADV_HUGEPAGE) == 0) {
+            contextPtr->arenaTransparentHugeMemory += mapSize - EB_ARENA_HUGE_PAGE_SIZE;
+        }
+#endif
+    }
+
+    hugeBlockPtr->mapPtr  = mapPtr;
+    hugeBlockPtr->mapSize = mapSize;
+
+    contextPtr->memoryMap[contextPtr->memoryMapIndex].ptrType = EB_HUGE_PTR;
+    contextPtr->memoryMap[contextPtr->memoryMapIndex++].ptr = hugeBlockPtr;
+    contextPtr->arenaReservedMemory += mapSize;
+    contextPtr->arenaBlockCount++;
+
+    return blockPtr;
+#else
+    (void)contextPtr;
+    (void)blockSize;
+    return (EB_U8*)EB_NULL;
+#endif
+}
+
+/***************************************
+ * EbArenaFreeHugeBlock
+ *   Unmaps a block of EbArenaNewHugeBlock given its
+ *   memory map entry
+ ***************************************/
+void EbArenaFreeHugeBlock(
+    EB_PTR hugeBlockPtr)
+{
+#if defined(__linux__)
+    munmap(((EbArenaHugeBlock_t*)hugeBlockPtr)->mapPtr, ((EbArenaHugeBlock_t*)hugeBlockPtr)->mapSize);
+#endif
+    free(hugeBlockPtr);
+}
+
+/***************************************
+ * EbArenaAlloc
+ *   Returns zeroed memory that lives until the memory map
+ *   of contextPtr is released. Allocations of a cache line
+ *   or more start on a cache line, dedicated blocks start on
+ *   a page.
+ ***************************************/
+void* EbArenaAlloc(
+    EbMemoryContext_t *contextPtr,
+    EB_U64             size,
+    EB_U64             alignment)
+{
+    EB_U8  *blockPtr;
+    size_t  address;
+
+    if (alignment < EB_ARENA_MIN_ALIGNMENT) {
+        alignment = EB_ARENA_MIN_ALIGNMENT;
+    }
+    if (size >= EB_ARENA_CACHE_LINE_SIZE && alignment < EB_ARENA_CACHE_LINE_SIZE) {
+        alignment = EB_ARENA_CACHE_LINE_SIZE;
+    }
+
+    if (size >= EB_ARENA_HUGE_PAGE_SIZE && contextPtr->hugePages != EB_HUGE_PAGES_OFF &&
+        (blockPtr = EbArenaNewHugeBlock(contextPtr, size)) != (EB_U8*)EB_NULL) {
+        address = (size_t)blockPtr;
+    }
+    else if (size >= EB_ARENA_DEDICATED_SIZE) {
+        blockPtr = EbArenaNewBlock(contextPtr, size + EB_ARENA_PAGE_SIZE);
+        if (blockPtr == (EB_U8*)EB_NULL) {
+            return EB_NULL;
+        }
+        address = ((size_t)blockPtr + EB_ARENA_PAGE_SIZE - 1) & ~((size_t)EB_ARENA_PAGE_SIZE - 1);
+    }
+    else {
+        address = ((size_t)contextPtr->arenaBlockPtr + (size_t)contextPtr->arenaBlockOffset + (size_t)alignment - 1) & ~((size_t)alignment - 1);
+
+        if (contextPtr->arenaBlockPtr == (EB_U8*)EB_NULL ||
+            address + size > (size_t)contextPtr->arenaBlockPtr + EB_ARENA_BLOCK_SIZE) {
+
+            blockPtr = EbArenaNewBlock(contextPtr, EB_ARENA_BLOCK_SIZE);
+            if (blockPtr == (EB_U8*)EB_NULL) {
+                return EB_NULL;
+            }
+            contextPtr->arenaBlockPtr = blockPtr;
+            address = ((size_t)blockPtr + (size_t)alignment - 1) & ~((size_t)alignment - 1);
+        }
+        contextPtr->arenaBlockOffset = address + size - (size_t)contextPtr->arenaBlockPtr;
+    }
+
+    contextPtr->totalLibMemory += (size + 7) & ~7ULL;
+    contextPtr->subsystemMemory[contextPtr->subsystem] += size;
+
+    return (void*)address;
+}
+
+/***************************************
+ * EbArenaPrintUsage
+ ***************************************/
+void EbArenaPrintUsage(
+    EbMemoryContext_t *contextPtr)
+{
+    EB_U32 subsystemIndex;
+
+    SVT_LOG("Arena Blocks: %d, Reserved: %.2lf KB\n", contextPtr->arenaBlockCount, contextPtr->arenaReservedMemory / (double)1024);
+    SVT_LOG("Huge Pages: Explicit %.2lf KB, Transparent %.2lf KB\n", contextPtr->arenaExplicitHugeMemory / (double)1024, contextPtr->arenaTransparentHugeMemory / (double)1024);
+    for (subsystemIndex = 0; subsystemIndex < EB_MEMORY_SUBSYSTEM_COUNT; ++subsystemIndex) {
+        SVT_LOG("  %-24s %.2lf KB\n", EbMemorySubsystemName[subsystemIndex], contextPtr->subsystemMemory[subsystemIndex] / (double)1024);
+    }
+    SVT_LOG("\n");
+}
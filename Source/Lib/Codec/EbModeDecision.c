@@ -397,6 +397,24 @@ EB_ERRORTYPE PreModeDecision(
 	return return_error;
 }
 
+/***************************************
+* Returns the bottom MV bound in quarter pel. In sub-picture reference mode
+* the bound is limited to the reference LCU rows that are guaranteed to be
+* reconstructed when the current LCU row starts.
+***************************************/
+static EB_S32 GetMvBoundEndY(
+    const LargestCodingUnit_t *lcuPtr)
+{
+    SequenceControlSet_t *sequenceControlSetPtr = (SequenceControlSet_t*)lcuPtr->pictureControlSetPtr->sequenceControlSetWrapperPtr->objectPtr;
+    EB_S32 endY = lcuPtr->tileInfoPtr->tilePxlEndY;
+
+    if (sequenceControlSetPtr->staticConfig.subPictureReference) {
+        endY = MIN(endY, (EB_S32)(lcuPtr->originY + (1 + SUB_PICTURE_REF_LCU_ROW_MARGIN) * lcuPtr->size));
+    }
+
+    return endY << 2;
+}
+
 static void LimitMvOverBound(
     EB_S16 *mvx,
     EB_S16 *mvy,
@@ -415,7 +433,7 @@ static void LimitMvOverBound(
     EB_S32 startX = lcuPtr->tileInfoPtr->tilePxlOriginX << 2;
     EB_S32 startY = lcuPtr->tileInfoPtr->tilePxlOriginY << 2;
     EB_S32 endX   = lcuPtr->tileInfoPtr->tilePxlEndX << 2;
-    EB_S32 endY   = lcuPtr->tileInfoPtr->tilePxlEndY << 2;
+    EB_S32 endY   = GetMvBoundEndY(lcuPtr);
     EB_S32 cuSize = (EB_S32)ctxtPtr->cuStats->size << 2;
     EB_S32 pad = (4 << 2);
     EB_S32 mvxFL = mvxF;
@@ -1568,7 +1586,7 @@ static EB_BOOL CheckForMvOverBound(
     EB_S32 startX = lcuPtr->tileInfoPtr->tilePxlOriginX << 2;
     EB_S32 startY = lcuPtr->tileInfoPtr->tilePxlOriginY << 2;
     EB_S32 endX   = lcuPtr->tileInfoPtr->tilePxlEndX << 2;
-    EB_S32 endY   = lcuPtr->tileInfoPtr->tilePxlEndY << 2;
+    EB_S32 endY   = GetMvBoundEndY(lcuPtr);
     EB_S32 cuSize = (EB_S32)ctxtPtr->cuStats->size << 2;
     EB_S32 pad = (4 << 2);
 
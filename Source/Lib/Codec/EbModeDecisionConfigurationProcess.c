@@ -1597,6 +1597,7 @@ static void DeriveLcuScore(
     PictureControlSet_t                *pictureControlSetPtr,
     ModeDecisionConfigurationContext_t *contextPtr)
 {
+    PictureParentControlSet_t *parentPcsPtr = pictureControlSetPtr->ParentPcsPtr;
     EB_U32  lcuIndex;
     EB_U32  lcuScore;
     EB_U32  distortion;
@@ -1607,6 +1608,10 @@ static void DeriveLcuScore(
     for (lcuIndex = 0; lcuIndex < pictureControlSetPtr->lcuTotalCount; lcuIndex++) {
 
         LcuParams_t *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
+        // Walk the contiguous per-LCU statistics
+        const MeCuResults_t *meResults = &parentPcsPtr->meResultsBuffer[lcuIndex * LCU_ME_RESULTS_STRIDE];
+        const OisCu32Cu16Results_t *oisCu32Cu16Results = &parentPcsPtr->oisCu32Cu16ResultsBuffer[lcuIndex * LCU_OIS_CU32_CU16_STRIDE];
+        const OisCu8Results_t *oisCu8Results = &parentPcsPtr->oisCu8ResultsBuffer[lcuIndex * LCU_OIS_CU8_STRIDE];
 
         if (pictureControlSetPtr->sliceType == EB_I_PICTURE) {
             if (lcuParams->rasterScanCuValidity[RASTER_SCAN_CU_INDEX_64x64] == EB_FALSE) {
@@ -1616,18 +1621,18 @@ static void DeriveLcuScore(
                 distortion = 0;
                 for (cu8x8Index = RASTER_SCAN_CU_INDEX_8x8_0; cu8x8Index <= RASTER_SCAN_CU_INDEX_8x8_63; cu8x8Index++) {
                     if (lcuParams->rasterScanCuValidity[cu8x8Index]) {
-                        distortion += pictureControlSetPtr->ParentPcsPtr->oisCu8Results[lcuIndex]->sortedOisCandidate[cu8x8Index - RASTER_SCAN_CU_INDEX_8x8_0][0].distortion;
+                        distortion += oisCu8Results->sortedOisCandidate[cu8x8Index - RASTER_SCAN_CU_INDEX_8x8_0][0].distortion;
                         validCu8x8Count++;
                     }
                 }
                 if (validCu8x8Count > 0)
-                    distortion = CLIP3(pictureControlSetPtr->ParentPcsPtr->intraComplexityMinPre, pictureControlSetPtr->ParentPcsPtr->intraComplexityMaxPre, (distortion / validCu8x8Count) * 64);
+                    distortion = CLIP3(parentPcsPtr->intraComplexityMinPre, parentPcsPtr->intraComplexityMaxPre, (distortion / validCu8x8Count) * 64);
             }
             else {
-                distortion = pictureControlSetPtr->ParentPcsPtr->oisCu32Cu16Results[lcuIndex]->sortedOisCandidate[RASTER_SCAN_CU_INDEX_32x32_0][0].distortion +
-                    pictureControlSetPtr->ParentPcsPtr->oisCu32Cu16Results[lcuIndex]->sortedOisCandidate[RASTER_SCAN_CU_INDEX_32x32_1][0].distortion +
-                    pictureControlSetPtr->ParentPcsPtr->oisCu32Cu16Results[lcuIndex]->sortedOisCandidate[RASTER_SCAN_CU_INDEX_32x32_2][0].distortion +
-                    pictureControlSetPtr->ParentPcsPtr->oisCu32Cu16Results[lcuIndex]->sortedOisCandidate[RASTER_SCAN_CU_INDEX_32x32_3][0].distortion;
+                distortion = oisCu32Cu16Results->sortedOisCandidate[RASTER_SCAN_CU_INDEX_32x32_0][0].distortion +
+                    oisCu32Cu16Results->sortedOisCandidate[RASTER_SCAN_CU_INDEX_32x32_1][0].distortion +
+                    oisCu32Cu16Results->sortedOisCandidate[RASTER_SCAN_CU_INDEX_32x32_2][0].distortion +
+                    oisCu32Cu16Results->sortedOisCandidate[RASTER_SCAN_CU_INDEX_32x32_3][0].distortion;
             }
             lcuScore = distortion;
 
@@ -1640,64 +1645,64 @@ static void DeriveLcuScore(
                 distortion = 0;
                 for (cu8x8Index = RASTER_SCAN_CU_INDEX_8x8_0; cu8x8Index <= RASTER_SCAN_CU_INDEX_8x8_63; cu8x8Index++) {
                     if (lcuParams->rasterScanCuValidity[cu8x8Index]) {
-                        distortion += pictureControlSetPtr->ParentPcsPtr->meResults[lcuIndex][cu8x8Index].distortionDirection[0].distortion;
+                        distortion += meResults[cu8x8Index].distortionDirection[0].distortion;
                         validCu8x8Count++;
                     }
                 }
                 if (validCu8x8Count > 0)
-                    distortion = CLIP3(pictureControlSetPtr->ParentPcsPtr->interComplexityMinPre, pictureControlSetPtr->ParentPcsPtr->interComplexityMaxPre, (distortion / validCu8x8Count) * 64);
+                    distortion = CLIP3(parentPcsPtr->interComplexityMinPre, parentPcsPtr->interComplexityMaxPre, (distortion / validCu8x8Count) * 64);
 
                 // Do not perform LCU score manipulation for incomplete LCUs as not valid signals
                 lcuScore   = distortion;
 
             }
             else {
-                distortion = pictureControlSetPtr->ParentPcsPtr->meResults[lcuIndex][RASTER_SCAN_CU_INDEX_64x64].distortionDirection[0].distortion;
+                distortion = meResults[RASTER_SCAN_CU_INDEX_64x64].distortionDirection[0].distortion;
 
                 lcuScore = distortion;
 
                 // Use uncovered area
-                if (pictureControlSetPtr->ParentPcsPtr->failingMotionLcuFlag[lcuIndex]) {
-                    lcuScore = pictureControlSetPtr->ParentPcsPtr->interComplexityMaxPre;
+                if (parentPcsPtr->failingMotionLcuFlag[lcuIndex]) {
+                    lcuScore = parentPcsPtr->interComplexityMaxPre;
 
                 }
                 // Active LCUs @ picture boundaries
                 else if (
                     // LCU @ a picture boundary
                     lcuParams->isEdgeLcu
-                    && pictureControlSetPtr->ParentPcsPtr->nonMovingIndexArray[lcuIndex] != INVALID_ZZ_COST
-                    && pictureControlSetPtr->ParentPcsPtr->nonMovingIndexAverage         != INVALID_ZZ_COST
+                    && parentPcsPtr->nonMovingIndexArray[lcuIndex] != INVALID_ZZ_COST
+                    && parentPcsPtr->nonMovingIndexAverage         != INVALID_ZZ_COST
                     // Active LCU
-                    && pictureControlSetPtr->ParentPcsPtr->nonMovingIndexArray[lcuIndex] >= ADP_CLASS_NON_MOVING_INDEX_TH_0
+                    && parentPcsPtr->nonMovingIndexArray[lcuIndex] >= ADP_CLASS_NON_MOVING_INDEX_TH_0
                     // Active Picture or LCU belongs to the most active LCUs
-                    && (pictureControlSetPtr->ParentPcsPtr->nonMovingIndexArray[lcuIndex] >= pictureControlSetPtr->ParentPcsPtr->nonMovingIndexAverage || pictureControlSetPtr->ParentPcsPtr->nonMovingIndexAverage > ADP_CLASS_NON_MOVING_INDEX_TH_1)
+                    && (parentPcsPtr->nonMovingIndexArray[lcuIndex] >= parentPcsPtr->nonMovingIndexAverage || parentPcsPtr->nonMovingIndexAverage > ADP_CLASS_NON_MOVING_INDEX_TH_1)
                     // Off for sub-4K (causes instability as % of picture boundary LCUs is 2x higher for 1080p than for 4K (9% vs. 18% ) => might hurt the non-boundary LCUs)
                     && sequenceControlSetPtr->inputResolution == INPUT_SIZE_4K_RANGE) {
 
-                    lcuScore += (((pictureControlSetPtr->ParentPcsPtr->interComplexityMaxPre - lcuScore) * ADP_CLASS_SHIFT_DIST_1) / 100);
+                    lcuScore += (((parentPcsPtr->interComplexityMaxPre - lcuScore) * ADP_CLASS_SHIFT_DIST_1) / 100);
 
                 }
                 else {
 
                     // Use LCU variance & activity
-                    if (pictureControlSetPtr->ParentPcsPtr->nonMovingIndexArray[lcuIndex] == ADP_CLASS_NON_MOVING_INDEX_TH_2 && pictureControlSetPtr->ParentPcsPtr->variance[lcuIndex][RASTER_SCAN_CU_INDEX_64x64] > IS_COMPLEX_LCU_VARIANCE_TH && (sequenceControlSetPtr->staticConfig.frameRate >> 16) > 30)
+                    if (parentPcsPtr->nonMovingIndexArray[lcuIndex] == ADP_CLASS_NON_MOVING_INDEX_TH_2 && parentPcsPtr->varianceBuffer[lcuIndex * LCU_VARIANCE_STRIDE + RASTER_SCAN_CU_INDEX_64x64] > IS_COMPLEX_LCU_VARIANCE_TH && (sequenceControlSetPtr->staticConfig.frameRate >> 16) > 30)
 
-                        lcuScore -= (((lcuScore - pictureControlSetPtr->ParentPcsPtr->interComplexityMinPre) * ADP_CLASS_SHIFT_DIST_0) / 100);
+                        lcuScore -= (((lcuScore - parentPcsPtr->interComplexityMinPre) * ADP_CLASS_SHIFT_DIST_0) / 100);
                     // Use LCU luminosity
                     if (sequenceControlSetPtr->inputResolution == INPUT_SIZE_4K_RANGE){
                         // Shift to the left dark LCUs & shift to the right otherwise ONLY if a high dark area is present
-                        if (pictureControlSetPtr->ParentPcsPtr->blackAreaPercentage > ADP_BLACK_AREA_PERCENTAGE) {
-                            if (pictureControlSetPtr->ParentPcsPtr->yMean[lcuIndex][RASTER_SCAN_CU_INDEX_64x64] < ADP_DARK_LCU_TH)
-                                lcuScore -= (((lcuScore - pictureControlSetPtr->ParentPcsPtr->interComplexityMinPre) * ADP_CLASS_SHIFT_DIST_0) / 100);
+                        if (parentPcsPtr->blackAreaPercentage > ADP_BLACK_AREA_PERCENTAGE) {
+                            if (parentPcsPtr->yMeanBuffer[lcuIndex * LCU_Y_MEAN_STRIDE + RASTER_SCAN_CU_INDEX_64x64] < ADP_DARK_LCU_TH)
+                                lcuScore -= (((lcuScore - parentPcsPtr->interComplexityMinPre) * ADP_CLASS_SHIFT_DIST_0) / 100);
                             else
-                                lcuScore += (((pictureControlSetPtr->ParentPcsPtr->interComplexityMaxPre - lcuScore) * ADP_CLASS_SHIFT_DIST_0) / 100);
+                                lcuScore += (((parentPcsPtr->interComplexityMaxPre - lcuScore) * ADP_CLASS_SHIFT_DIST_0) / 100);
                         }
                     } else {
                         // Shift to the left dark LCUs & shift to the right otherwise
-                        if (pictureControlSetPtr->ParentPcsPtr->yMean[lcuIndex][RASTER_SCAN_CU_INDEX_64x64] < ADP_DARK_LCU_TH )
-                            lcuScore -= (((lcuScore - pictureControlSetPtr->ParentPcsPtr->interComplexityMinPre) * ADP_CLASS_SHIFT_DIST_0) / 100);
+                        if (parentPcsPtr->yMeanBuffer[lcuIndex * LCU_Y_MEAN_STRIDE + RASTER_SCAN_CU_INDEX_64x64] < ADP_DARK_LCU_TH )
+                            lcuScore -= (((lcuScore - parentPcsPtr->interComplexityMinPre) * ADP_CLASS_SHIFT_DIST_0) / 100);
                         else
-                            lcuScore += (((pictureControlSetPtr->ParentPcsPtr->interComplexityMaxPre - lcuScore) * ADP_CLASS_SHIFT_DIST_0) / 100);
+                            lcuScore += (((parentPcsPtr->interComplexityMaxPre - lcuScore) * ADP_CLASS_SHIFT_DIST_0) / 100);
                     }
 
                 }
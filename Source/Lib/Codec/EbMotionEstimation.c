@@ -288,7 +288,6 @@ static void GetEightHorizontalSearchPointResultsAll85PUs_C(
 
 }
 
-#ifdef NON_AVX512_SUPPORT
 /*******************************************
 * GetEightHorizontalSearchPointResultsAll85CUs
 *******************************************/
@@ -424,25 +423,26 @@ static void GetEightHorizontalSearchPointResultsAll85PUs_AVX2_INTRIN(
     GetEightHorizontalSearchPointResults_32x32_64x64_funcPtrArray[!!(ASM_TYPES & AVX2_MASK)](pSad16x16, pBestSad32x32, pBestSad64x64, pBestMV32x32, pBestMV64x64, currMV);
 
 }
-#endif
-
-typedef void(*EB_FPSEARCH_FUNC)(
-	MeContext_t             *contextPtr,
-	EB_U32                   listIndex,
-	EB_U32                   searchRegionIndex,
-	EB_U32                   xSearchIndex,
-	EB_U32                   ySearchIndex);
 
 /*****************************
 * Function Tables
 *****************************/
-static EB_FPSEARCH_FUNC FUNC_TABLE GetEightHorizontalSearchPointResultsAll85PUs_funcPtrArray[EB_ASM_TYPE_TOTAL] =
+const EB_FPSEARCH_FUNC FUNC_TABLE GetEightHorizontalSearchPointResultsAll85PUs_funcPtrArray[EB_ASM_AVX512_TYPE_TOTAL] =
 {
 	GetEightHorizontalSearchPointResultsAll85PUs_C,
+    GetEightHorizontalSearchPointResultsAll85PUs_AVX2_INTRIN,
 #ifndef NON_AVX512_SUPPORT
 	GetEightHorizontalSearchPointResultsAll85PUs_AVX512_INTRIN
-#else
-    GetEightHorizontalSearchPointResultsAll85PUs_AVX2_INTRIN
+#endif
+};
+
+// HME level 0 search kernels, for search areas of a multiple of 16 wide
+static EB_SADLOOPKERNELNxM_TYPE FUNC_TABLE SadLoopKernelHmeL0_funcPtrArray[EB_ASM_AVX512_TYPE_TOTAL] =
+{
+    SadLoopKernel,
+    SadLoopKernel_AVX2_HmeL0_INTRIN,
+#ifndef NON_AVX512_SUPPORT
+    SadLoopKernel_AVX512_HmeL0_INTRIN
 #endif
 };
 
@@ -603,11 +603,7 @@ static void FullPelSearch_LCU(
 		for (xSearchIndex = 0; xSearchIndex < searchAreaWidthMult8; xSearchIndex += 8){
 
 			//this function will do:  xSearchIndex, +1, +2, ..., +7
-#ifndef NON_AVX512_SUPPORT
-			GetEightHorizontalSearchPointResultsAll85PUs_funcPtrArray[ !!(ASM_TYPES & AVX512_MASK) ](
-#else
-            GetEightHorizontalSearchPointResultsAll85PUs_funcPtrArray[!!(ASM_TYPES & AVX2_MASK)](
-#endif
+			GetEightHorizontalSearchPointResultsAll85PUs_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & AVX2_MASK))](
 				contextPtr,
 				listIndex,
 				xSearchIndex + ySearchIndex * contextPtr->interpolatedFullStride[listIndex][0],
@@ -1934,14 +1930,9 @@ void EbHevcHmeOneQuadrantLevel0(
 		{
 			searchAreaWidth = (EB_S16)((double)((searchAreaWidth >> 4) << 4));
 		}
-#ifndef NON_AVX512_SUPPORT
-	    if (((searchAreaWidth & 15) == 0) && (!!(ASM_TYPES & AVX512_MASK)))
-#else
-        if (((searchAreaWidth & 15) == 0) && (!!(ASM_TYPES & AVX2_MASK)))
-#endif
+	    if (((searchAreaWidth & 15) == 0) && (!!(ASM_TYPES & AVX2_MASK)))
 	    {
-#ifndef NON_AVX512_SUPPORT
-		    SadLoopKernel_AVX512_HmeL0_INTRIN(
+		    SadLoopKernelHmeL0_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & AVX2_MASK))](
 			    &contextPtr->sixteenthLcuBuffer[0],
 			    contextPtr->sixteenthLcuBufferStride,
 			    &sixteenthRefPicPtr->bufferY[searchRegionIndex],
@@ -1956,23 +1947,6 @@ void EbHevcHmeOneQuadrantLevel0(
 			    searchAreaWidth,
 			    searchAreaHeight
 			    );
-#else
-            SadLoopKernel_AVX2_HmeL0_INTRIN(
-                &contextPtr->sixteenthLcuBuffer[0],
-                contextPtr->sixteenthLcuBufferStride,
-                &sixteenthRefPicPtr->bufferY[searchRegionIndex],
-                sixteenthRefPicPtr->strideY * 2,
-                lcuHeight >> 1, lcuWidth,
-                // results
-                level0BestSad,
-                xLevel0SearchCenter,
-                yLevel0SearchCenter,
-                // range
-                sixteenthRefPicPtr->strideY,
-                searchAreaWidth,
-                searchAreaHeight
-            );
-#endif
 
         }
         else {
@@ -2103,14 +2077,9 @@ void EbHevcHmeLevel0(
 
 	if (((lcuWidth  & 7) == 0) || (lcuWidth == 4))
 	{
-#ifndef NON_AVX512_SUPPORT
-        if (((searchAreaWidth & 15) == 0) && (!!(ASM_TYPES & AVX512_MASK)))
-#else
         if (((searchAreaWidth & 15) == 0) && (!!(ASM_TYPES & AVX2_MASK)))
-#endif
 		{
-#ifndef NON_AVX512_SUPPORT
-		    SadLoopKernel_AVX512_HmeL0_INTRIN(
+		    SadLoopKernelHmeL0_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & AVX2_MASK))](
 				&contextPtr->sixteenthLcuBuffer[0],
 				contextPtr->sixteenthLcuBufferStride,
 				&sixteenthRefPicPtr->bufferY[searchRegionIndex],
@@ -2125,23 +2094,6 @@ void EbHevcHmeLevel0(
 				searchAreaWidth,
 				searchAreaHeight
 				);
-#else
-            SadLoopKernel_AVX2_HmeL0_INTRIN(
-                &contextPtr->sixteenthLcuBuffer[0],
-                contextPtr->sixteenthLcuBufferStride,
-                &sixteenthRefPicPtr->bufferY[searchRegionIndex],
-                sixteenthRefPicPtr->strideY * 2,
-                lcuHeight >> 1, lcuWidth,
-                // results
-                level0BestSad,
-                xLevel0SearchCenter,
-                yLevel0SearchCenter,
-                // range
-                sixteenthRefPicPtr->strideY,
-                searchAreaWidth,
-                searchAreaHeight
-            );
-#endif
         }
 		else
 		    {
@@ -4441,7 +4393,7 @@ EB_ERRORTYPE MotionEstimateLcu(
 		// Compute the sum of the distortion of all 16 16x16 (best) blocks in the LCU
 		pictureControlSetPtr->rcMEdistortion[lcuIndex] = 0;
 		for (i = 0; i < 16; i++) {
-			pictureControlSetPtr->rcMEdistortion[lcuIndex] += pictureControlSetPtr->meResults[lcuIndex][5 + i].distortionDirection[0].distortion;
+			pictureControlSetPtr->rcMEdistortion[lcuIndex] += pictureControlSetPtr->meResultsBuffer[lcuIndex * LCU_ME_RESULTS_STRIDE + 5 + i].distortionDirection[0].distortion;
 		}
 
 	}
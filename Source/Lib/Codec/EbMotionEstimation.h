@@ -18,6 +18,16 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+typedef void(*EB_FPSEARCH_FUNC)(
+	MeContext_t             *contextPtr,
+	EB_U32                   listIndex,
+	EB_U32                   searchRegionIndex,
+	EB_U32                   xSearchIndex,
+	EB_U32                   ySearchIndex);
+
+// Integer full pel search of 8 horizontal positions for all 85 PUs
+extern const EB_FPSEARCH_FUNC GetEightHorizontalSearchPointResultsAll85PUs_funcPtrArray[EB_ASM_AVX512_TYPE_TOTAL];
+
 extern EB_ERRORTYPE MotionEstimateLcu(
     PictureParentControlSet_t   *pictureControlSetPtr,
     EB_U32                       lcuIndex,
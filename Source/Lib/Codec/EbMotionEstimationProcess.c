@@ -155,6 +155,8 @@ EB_ERRORTYPE MotionEstimationContextCtor(
 
 	contextPtr->pictureDecisionResultsInputFifoPtr = pictureDecisionResultsInputFifoPtr;
 	contextPtr->motionEstimationResultsOutputFifoPtr = motionEstimationResultsOutputFifoPtr;
+	EB_MEMSET(&contextPtr->numaState, 0, sizeof(EbNumaThreadState_t));
+	contextPtr->numaState.partition = EB_NUMA_NO_PARTITION;
 	return_error = IntraOpenLoopReferenceSamplesCtor(&contextPtr->intraRefPtr);
 	if (return_error == EB_ErrorInsufficientResources){
 		return EB_ErrorInsufficientResources;
@@ -699,6 +701,14 @@ void* MotionEstimationKernel(void *inputPtr)
             contextPtr->meContextPtr->lambda = lambdaModeDecisionRaSadNonRef[pictureControlSetPtr->pictureQp];
         }
 
+        // Work on the node of the middle row of the segment
+        if (sequenceControlSetPtr->encodeContextPtr->numaTopology.nodeCount) {
+            EbNumaEnterPartition(
+                &sequenceControlSetPtr->encodeContextPtr->numaTopology,
+                &contextPtr->numaState,
+                EbNumaRowPartition(&sequenceControlSetPtr->encodeContextPtr->numaTopology, (yLcuStartIndex + yLcuEndIndex - 1) >> 1, pictureHeightInLcu));
+        }
+
         // Motion Estimation
         if (pictureControlSetPtr->sliceType != EB_I_PICTURE) {
 
@@ -838,7 +848,7 @@ void* MotionEstimationKernel(void *inputPtr)
 
 		// Calculate the ME Distortion and OIS Historgrams
         EbBlockOnMutex(pictureControlSetPtr->rcDistortionHistogramMutex);
-		if (sequenceControlSetPtr->staticConfig.rateControlMode){
+		if (sequenceControlSetPtr->rateStatisticsFlag){
 			if (pictureControlSetPtr->sliceType != EB_I_PICTURE){
 				EB_U16 sadIntervalIndex;
 				for (yLcuIndex = yLcuStartIndex; yLcuIndex < yLcuEndIndex; ++yLcuIndex) {
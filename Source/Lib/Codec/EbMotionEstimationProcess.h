@@ -32,6 +32,8 @@ typedef struct MotionEstimationContext_s
     EB_U8                            oisThSet;                      // used by P/B Slices
     EB_BOOL                          setBestOisDistortionToValid;   // used by I/P/B Slices
 
+    EbNumaThreadState_t              numaState;
+
 } MotionEstimationContext_t;
 
 /***************************************
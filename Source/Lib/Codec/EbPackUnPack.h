@@ -77,24 +77,27 @@ typedef void(*EB_ENC_UnPack2D_TYPE)(
     EB_U32       width,
     EB_U32       height);
 
-EB_ENC_UnPack2D_TYPE UnPack2D_funcPtrArray_16Bit[2][EB_ASM_TYPE_TOTAL] =
+EB_ENC_UnPack2D_TYPE UnPack2D_funcPtrArray_16Bit[2][EB_ASM_AVX512_TYPE_TOTAL] =
 {
     {
         // C_DEFAULT
 		EB_ENC_msbUnPack2D,
         // AVX2
 		EB_ENC_msbUnPack2D,
+#ifndef NON_AVX512_SUPPORT
+        // AVX512
+		EB_ENC_msbUnPack2D,
+#endif
     },
     {
         // C_DEFAULT
 		EB_ENC_msbUnPack2D,
-        // AVX512
+        // AVX2
+        EB_ENC_msbUnPack2D_AVX2_INTRIN,
 #ifndef NON_AVX512_SUPPORT
+        // AVX512
         EB_ENC_msbUnPack2D_AVX512_INTRIN,
-#else
-        EB_ENC_msbUnPack2D_AVX2_INTRIN,
 #endif
-
     }
 };
 
@@ -74,7 +74,7 @@ static void InitHRD(SequenceControlSet_t *scsPtr)
             {
                 hrd->bitRateValueMinus1[i][j][k] = (scsPtr->staticConfig.vbvMaxrate >> (hrd->bitRateScale + BR_SHIFT))-1;
                 hrd->cpbSizeValueMinus1[i][j][k] = (scsPtr->staticConfig.vbvBufsize >> (hrd->cpbSizeScale + CPB_SHIFT))-1;
-                if (scsPtr->staticConfig.vbvMaxrate == scsPtr->staticConfig.targetBitRate)
+                if (scsPtr->staticConfig.rateControlMode == 1 && scsPtr->staticConfig.vbvMaxrate == scsPtr->staticConfig.targetBitRate)
                     hrd->cbrFlag[i][j][k] = 1;
             }
     EB_U32 bitRateUnscale = ((scsPtr->staticConfig.vbvMaxrate >> (hrd->bitRateScale + BR_SHIFT)) << (hrd->bitRateScale + BR_SHIFT));
@@ -212,7 +212,7 @@ void* PacketizationKernel(void *inputPtr)
         rateControlTasksPtr->pictureControlSetWrapperPtr    = pictureControlSetPtr->PictureParentControlSetWrapperPtr;
         rateControlTasksPtr->taskType                       = RC_PACKETIZATION_FEEDBACK_RESULT;
 
-        if (sequenceControlSetPtr->staticConfig.rateControlMode) {
+        if (sequenceControlSetPtr->staticConfig.rateControlMode == 1) {
             // Get Empty Results Object
             EbGetEmptyObject(
                 contextPtr->pictureManagerOutputFifoPtr,
@@ -247,7 +247,7 @@ void* PacketizationKernel(void *inputPtr)
             toInsertHeaders = EB_TRUE;
         } else if ((pictureControlSetPtr->sliceType == EB_I_PICTURE) &&
                    (sequenceControlSetPtr->intraRefreshType >= IDR_REFRESH)) {
-            if (sequenceControlSetPtr->staticConfig.rateControlMode) {
+            if (sequenceControlSetPtr->staticConfig.rateControlMode == 1) {
                 EB_U32 idrCount = pictureControlSetPtr->pictureNumber /
                                   (sequenceControlSetPtr->intraPeriodLength + 1);
                 if ((idrCount % (sequenceControlSetPtr->intraRefreshType + 1)) == 0)
@@ -351,7 +351,7 @@ void* PacketizationKernel(void *inputPtr)
             lcuTotalCount               = pictureControlSetPtr->lcuTotalCount;
 
             // LCU Loop
-            if (sequenceControlSetPtr->staticConfig.rateControlMode > 0){
+            if (sequenceControlSetPtr->rateStatisticsFlag){
                 EB_U64  sadBits[NUMBER_OF_SAD_INTERVALS]= {0};
                 EB_U32  count[NUMBER_OF_SAD_INTERVALS] = {0};
 
@@ -680,21 +680,41 @@ void* PacketizationKernel(void *inputPtr)
             }
 
             // Write the slice data into the bitstream
-            bitstream.outputBitstreamPtr = EntropyCoderGetBitstreamPtr(pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCoderPtr);
+            if (sequenceControlSetPtr->staticConfig.enableWppFlag) {
+                // WPP: concatenate the LCU row substreams
+                EB_U32 rowIdx;
+                for (rowIdx = 0; rowIdx < pictureControlSetPtr->ParentPcsPtr->pictureHeightInLcu; rowIdx++) {
+                    bitstream.outputBitstreamPtr = EntropyCoderGetBitstreamPtr(pictureControlSetPtr->wppEntropyCoderPtrArray[rowIdx]);
 
-            FlushBitstream(bitstream.outputBitstreamPtr);
+                    FlushBitstream(bitstream.outputBitstreamPtr);
 
-            CopyRbspBitstreamToPayload(
-                &bitstream,
-                outputStreamPtr->pBuffer,
-                (EB_U32*) &(outputStreamPtr->nFilledLen),
-                (EB_U32*) &(outputStreamPtr->nAllocLen),
-			    encodeContextPtr,
-			    NAL_UNIT_INVALID);
+                    CopyRbspBitstreamToPayload(
+                        &bitstream,
+                        outputStreamPtr->pBuffer,
+                        (EB_U32*) &(outputStreamPtr->nFilledLen),
+                        (EB_U32*) &(outputStreamPtr->nAllocLen),
+                        encodeContextPtr,
+                        NAL_UNIT_INVALID);
+                }
+            }
+            else {
+                bitstream.outputBitstreamPtr = EntropyCoderGetBitstreamPtr(pictureControlSetPtr->entropyCodingInfo[tileIdx]->entropyCoderPtr);
+
+                FlushBitstream(bitstream.outputBitstreamPtr);
+
+                CopyRbspBitstreamToPayload(
+                    &bitstream,
+                    outputStreamPtr->pBuffer,
+                    (EB_U32*) &(outputStreamPtr->nFilledLen),
+                    (EB_U32*) &(outputStreamPtr->nAllocLen),
+                    encodeContextPtr,
+                    NAL_UNIT_INVALID);
+            }
 
             bufferRate = encodeContextPtr->vbvMaxrate / (sequenceControlSetPtr->staticConfig.frameRate >> 16);
             queueEntryPtr->fillerBitsSent = 0;
-            if ((sequenceControlSetPtr->staticConfig.vbvBufsize && sequenceControlSetPtr->staticConfig.vbvMaxrate) && (sequenceControlSetPtr->staticConfig.vbvMaxrate == sequenceControlSetPtr->staticConfig.targetBitRate))
+            // CBR pads with filler data, the target bit rate does not apply to CRF
+            if ((sequenceControlSetPtr->staticConfig.vbvBufsize && sequenceControlSetPtr->staticConfig.vbvMaxrate) && sequenceControlSetPtr->staticConfig.rateControlMode == 1 && (sequenceControlSetPtr->staticConfig.vbvMaxrate == sequenceControlSetPtr->staticConfig.targetBitRate))
             {
                 pictureControlSetPtr->ParentPcsPtr->totalNumBits = outputStreamPtr->nFilledLen << 3;
                 EB_S64 buffer = (EB_S64)(encodeContextPtr->bufferFill);
@@ -774,7 +794,7 @@ void* PacketizationKernel(void *inputPtr)
         // Post Rate Control Taks
         EbPostFullObject(rateControlTasksWrapperPtr);
 
-        if (sequenceControlSetPtr->staticConfig.rateControlMode) {
+        if (sequenceControlSetPtr->staticConfig.rateControlMode == 1) {
             // Post the Full Results Object
             EbPostFullObject(pictureManagerResultsWrapperPtr);
         }
@@ -811,6 +831,20 @@ void* PacketizationKernel(void *inputPtr)
                 finishTimeSeconds,
                 finishTimeuSeconds,
                 &latency);
+
+            {
+                EB_U64 latencyMs = (EB_U64)latency;
+                EB_U32 binIndex = 0;
+
+                // Bin of the power of two above the latency
+                while (binIndex < EB_ENC_LATENCY_BIN_COUNT - 1 && (latencyMs >> binIndex) != 0) {
+                    binIndex++;
+                }
+                encodeContextPtr->latencyHistogram[binIndex]++;
+                encodeContextPtr->latencySumMs += latencyMs;
+                encodeContextPtr->latencyMaxMs = MAX(encodeContextPtr->latencyMaxMs, latencyMs);
+                encodeContextPtr->picturesOut++;
+            }
 #if LATENCY_PROFILE
             SVT_LOG("POC %lu (decoder order %lu) PAK OUT, slice type %d, used as reference %d, latency %3.3f\n",
                     outputStreamPtr->pts,
@@ -875,7 +909,7 @@ void* PacketizationKernel(void *inputPtr)
                 queueEntryPtr->fillerBitsFinal = 0;
                 EB_U64 buffer=bufferfill_temp = (EB_S64)(bufferfill_temp + (encodeContextPtr->vbvMaxrate * (1.0 / (sequenceControlSetPtr->frameRate >> RC_PRECISION))));
                 //Block to write filler data to prevent cpb overflow
-                if ((sequenceControlSetPtr->staticConfig.vbvMaxrate == sequenceControlSetPtr->staticConfig.targetBitRate)&& !(outputStreamPtr->nFlags & EB_BUFFERFLAG_EOS))
+                if (sequenceControlSetPtr->staticConfig.rateControlMode == 1 && (sequenceControlSetPtr->staticConfig.vbvMaxrate == sequenceControlSetPtr->staticConfig.targetBitRate)&& !(outputStreamPtr->nFlags & EB_BUFFERFLAG_EOS))
                 {
                     if (buffer > encodeContextPtr->vbvBufsize)
                     {
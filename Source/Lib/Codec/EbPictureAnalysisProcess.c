@@ -202,37 +202,6 @@ void Decimation2D(
 	return;
 }
 
-/********************************************
-* CalculateHistogram
-*      creates n-bins histogram for the input
-********************************************/
-static void CalculateHistogram(
-	EB_U8 *  inputSamples,      // input parameter, input samples Ptr
-	EB_U32   inputAreaWidth,    // input parameter, input area width
-	EB_U32   inputAreaHeight,   // input parameter, input area height
-	EB_U32   stride,            // input parameter, input stride
-    EB_U8    decimStep,         // input parameter, area height
-	EB_U32  *histogram,			// output parameter, output histogram
-	EB_U64  *sum)
-
-{
-
-	EB_U32 horizontalIndex;
-	EB_U32 verticalIndex;
-	*sum = 0;
-
-	for (verticalIndex = 0; verticalIndex < inputAreaHeight; verticalIndex += decimStep) {
-		for (horizontalIndex = 0; horizontalIndex < inputAreaWidth; horizontalIndex += decimStep) {
-			++(histogram[inputSamples[horizontalIndex]]);
-			*sum += inputSamples[horizontalIndex];
-		}
-        inputSamples += (stride << (decimStep >> 1));
-	}
-
-	return;
-}
-
-
 static EB_U64 ComputeVariance32x32(
 	EbPictureBufferDesc_t       *inputPaddedPicturePtr,         // input parameter, Input Padded Picture
 	EB_U32                       inputLumaOriginIndex,          // input parameter, LCU index, used to point to source/reference samples
@@ -3239,7 +3208,7 @@ static EB_ERRORTYPE QuarterSampleDenoise(
 	if (denoiseFlag == EB_TRUE) {
 
         // Turn OFF the de-noiser for Class 2 at QP=29 and lower (for Fixed_QP) and at the target rate of 14Mbps and higher (for RC=ON)
-		if ((pictureControlSetPtr->picNoiseClass == PIC_NOISE_CLASS_3_1) || ((pictureControlSetPtr->picNoiseClass == PIC_NOISE_CLASS_2) && ((sequenceControlSetPtr->staticConfig.rateControlMode == 0 && sequenceControlSetPtr->qp > DENOISER_QP_TH) || (sequenceControlSetPtr->staticConfig.rateControlMode != 0 && sequenceControlSetPtr->staticConfig.targetBitRate < DENOISER_BITRATE_TH)))) {
+		if ((pictureControlSetPtr->picNoiseClass == PIC_NOISE_CLASS_3_1) || ((pictureControlSetPtr->picNoiseClass == PIC_NOISE_CLASS_2) && ((sequenceControlSetPtr->staticConfig.rateControlMode != 1 && sequenceControlSetPtr->qp > DENOISER_QP_TH) || (sequenceControlSetPtr->staticConfig.rateControlMode == 1 && sequenceControlSetPtr->staticConfig.targetBitRate < DENOISER_BITRATE_TH)))) {
 
 			SubSampleFilterNoise(
 				sequenceControlSetPtr,
@@ -3300,7 +3269,7 @@ static EB_ERRORTYPE HalfSampleDenoise(
 	if (denoiseFlag == EB_TRUE) {
 
 		// Turn OFF the de-noiser for Class 2 at QP=29 and lower (for Fixed_QP) and at the target rate of 14Mbps and higher (for RC=ON)
-		if ((pictureControlSetPtr->picNoiseClass == PIC_NOISE_CLASS_3_1) || ((pictureControlSetPtr->picNoiseClass == PIC_NOISE_CLASS_2) && ((sequenceControlSetPtr->staticConfig.rateControlMode == 0 && sequenceControlSetPtr->qp > DENOISER_QP_TH) || (sequenceControlSetPtr->staticConfig.rateControlMode != 0 && sequenceControlSetPtr->staticConfig.targetBitRate < DENOISER_BITRATE_TH)))) {
+		if ((pictureControlSetPtr->picNoiseClass == PIC_NOISE_CLASS_3_1) || ((pictureControlSetPtr->picNoiseClass == PIC_NOISE_CLASS_2) && ((sequenceControlSetPtr->staticConfig.rateControlMode != 1 && sequenceControlSetPtr->qp > DENOISER_QP_TH) || (sequenceControlSetPtr->staticConfig.rateControlMode == 1 && sequenceControlSetPtr->staticConfig.targetBitRate < DENOISER_BITRATE_TH)))) {
 
 			SubSampleFilterNoise(
 				sequenceControlSetPtr,
@@ -3382,9 +3351,72 @@ static void PicturePreProcessingOperations(
 
 }
 
+/**************************************************************
+* Accumulate the histogram bins of the buffer rows [rowBegin, rowEnd)
+* Samples are binned per region with the sampling of a whole-picture pass:
+* the regions of the width x height picture grid start at
+* (originX + regionX) >> subSampleShift, (originY + regionY) >> subSampleShift
+* and every decimStep-th sample of every decimStep-th row is binned
+**************************************************************/
+static void AccumulateRegionHistogramRows(
+	SequenceControlSet_t            *sequenceControlSetPtr,
+	PictureAnalysisContext_t        *contextPtr,
+	EB_U8                           *bufferPtr,
+	EB_U32                           stride,
+	EB_U32                           originX,
+	EB_U32                           originY,
+	EB_U32                           width,
+	EB_U32                           height,
+	EB_U32                           subSampleShift,
+	EB_U32                           decimStep,
+	EB_U32                           component,
+	EB_U32                           rowBegin,
+	EB_U32                           rowEnd)
+{
+	EB_U32 regionsPerWidth = sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerWidth;
+	EB_U32 regionsPerHeight = sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerHeight;
+	EB_U32 regionWidth = width / regionsPerWidth;
+	EB_U32 regionHeight = height / regionsPerHeight;
+	EB_U32 regionInPictureWidthIndex;
+	EB_U32 regionInPictureHeightIndex;
+
+	for (regionInPictureHeightIndex = 0; regionInPictureHeightIndex < regionsPerHeight; regionInPictureHeightIndex++) {
+		EB_U32 regionHeightOffset = (regionInPictureHeightIndex == regionsPerHeight - 1) ? height - (regionsPerHeight * regionHeight) : 0;
+		EB_U32 regionRowStart = (originY + regionInPictureHeightIndex * regionHeight) >> subSampleShift;
+		EB_U32 regionRowEnd = MIN(regionRowStart + ((regionHeight + regionHeightOffset) >> subSampleShift), rowEnd);
+		EB_U32 rowIndex = regionRowStart;
+
+		// First sampled row of the region inside the range
+		if (rowBegin > regionRowStart) {
+			rowIndex += ((rowBegin - regionRowStart + decimStep - 1) / decimStep) * decimStep;
+		}
+
+		for (; rowIndex < regionRowEnd; rowIndex += decimStep) {
+			for (regionInPictureWidthIndex = 0; regionInPictureWidthIndex < regionsPerWidth; regionInPictureWidthIndex++) {
+				EB_U32 regionWidthOffset = (regionInPictureWidthIndex == regionsPerWidth - 1) ? width - (regionsPerWidth * regionWidth) : 0;
+				EB_U32 sampleCount = (regionWidth + regionWidthOffset) >> subSampleShift;
+				EB_U8 *samplePtr = bufferPtr + rowIndex * stride + ((originX + regionInPictureWidthIndex * regionWidth) >> subSampleShift);
+				EB_U32 *histogram = contextPtr->regionHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][component];
+				EB_U64 sum = 0;
+				EB_U32 sampleIndex;
+
+				for (sampleIndex = 0; sampleIndex < sampleCount; sampleIndex += decimStep) {
+					++(histogram[samplePtr[sampleIndex]]);
+					sum += samplePtr[sampleIndex];
+				}
+				contextPtr->regionSum[regionInPictureWidthIndex][regionInPictureHeightIndex][component] += sum;
+			}
+		}
+	}
+
+	return;
+}
+
 /**************************************************************
 * Generate picture histogram bins for YUV pixel intensity *
 * Calculation is done on a region based (Set previously, resolution dependent)
+* The segments have binned the samples and left the sum of each region
+* in averageIntensityPerRegion, which is turned into the region average here
 **************************************************************/
 static void SubSampleLumaGeneratePixelIntensityHistogramBins(
 	SequenceControlSet_t            *sequenceControlSetPtr,
@@ -3408,10 +3440,6 @@ static void SubSampleLumaGeneratePixelIntensityHistogramBins(
 	for (regionInPictureWidthIndex = 0; regionInPictureWidthIndex < sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerWidth; regionInPictureWidthIndex++){  // loop over horizontal regions
 		for (regionInPictureHeightIndex = 0; regionInPictureHeightIndex < sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerHeight; regionInPictureHeightIndex++){ // loop over vertical regions
 
-
-			// Initialize bins to 1
-			InitializeBuffer_32bits_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](pictureControlSetPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][0], 64, 0, 1);
-
 			regionWidthOffset = (regionInPictureWidthIndex == sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerWidth - 1) ?
 				inputPicturePtr->width - (sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerWidth * regionWidth) :
 				0;
@@ -3421,14 +3449,7 @@ static void SubSampleLumaGeneratePixelIntensityHistogramBins(
 				0;
 
 			// Y Histogram
-			CalculateHistogram(
-				&inputPicturePtr->bufferY[(inputPicturePtr->originX + regionInPictureWidthIndex * regionWidth) + ((inputPicturePtr->originY + regionInPictureHeightIndex * regionHeight) * inputPicturePtr->strideY)],
-				regionWidth + regionWidthOffset,
-				regionHeight + regionHeightOffset,
-				inputPicturePtr->strideY,
-                1,
-                pictureControlSetPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][0],
-				&sum);
+			sum = pictureControlSetPtr->averageIntensityPerRegion[regionInPictureWidthIndex][regionInPictureHeightIndex][0];
 
 			pictureControlSetPtr->averageIntensityPerRegion[regionInPictureWidthIndex][regionInPictureHeightIndex][0] = (EB_U8)((sum + (((regionWidth + regionWidthOffset)*(regionHeight + regionHeightOffset)) >> 1)) / ((regionWidth + regionWidthOffset)*(regionHeight + regionHeightOffset)));
             (*sumAverageIntensityTotalRegionsLuma) += (sum << 4);
@@ -3467,11 +3488,6 @@ static void SubSampleChromaGeneratePixelIntensityHistogramBins(
     for (regionInPictureWidthIndex = 0; regionInPictureWidthIndex < sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerWidth; regionInPictureWidthIndex++){  // loop over horizontal regions
         for (regionInPictureHeightIndex = 0; regionInPictureHeightIndex < sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerHeight; regionInPictureHeightIndex++){ // loop over vertical regions
 
-
-            // Initialize bins to 1
-			InitializeBuffer_32bits_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](pictureControlSetPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][1], 64, 0, 1);
-			InitializeBuffer_32bits_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](pictureControlSetPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][2], 64, 0, 1);
-
             regionWidthOffset = (regionInPictureWidthIndex == sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerWidth - 1) ?
                 inputPicturePtr->width - (sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerWidth * regionWidth) :
                 0;
@@ -3482,14 +3498,7 @@ static void SubSampleChromaGeneratePixelIntensityHistogramBins(
 
 
             // U Histogram
-            CalculateHistogram(
-                &inputPicturePtr->bufferCb[((inputPicturePtr->originX + regionInPictureWidthIndex * regionWidth) >> 1) + (((inputPicturePtr->originY + regionInPictureHeightIndex * regionHeight) >> 1) * inputPicturePtr->strideCb)],
-                (regionWidth + regionWidthOffset) >> 1,
-                (regionHeight + regionHeightOffset) >> 1,
-                inputPicturePtr->strideCb,
-                decimStep,
-                pictureControlSetPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][1],
-                &sum);
+            sum = pictureControlSetPtr->averageIntensityPerRegion[regionInPictureWidthIndex][regionInPictureHeightIndex][1];
 
             sum = (sum << decimStep);
             *sumAverageIntensityTotalRegionsCb += sum;
@@ -3501,14 +3510,7 @@ static void SubSampleChromaGeneratePixelIntensityHistogramBins(
             }
 
             // V Histogram
-            CalculateHistogram(
-                &inputPicturePtr->bufferCr[((inputPicturePtr->originX + regionInPictureWidthIndex * regionWidth) >> 1) + (((inputPicturePtr->originY + regionInPictureHeightIndex * regionHeight) >> 1) * inputPicturePtr->strideCr)],
-                (regionWidth + regionWidthOffset) >> 1,
-                (regionHeight + regionHeightOffset) >> 1,
-                inputPicturePtr->strideCr,
-                decimStep,
-                pictureControlSetPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][2],
-                &sum);
+            sum = pictureControlSetPtr->averageIntensityPerRegion[regionInPictureWidthIndex][regionInPictureHeightIndex][2];
 
             sum = (sum << decimStep);
             *sumAverageIntensityTotalRegionsCr += sum;
@@ -3876,18 +3878,17 @@ static inline void DetermineHomogeneousRegionInPicture(
 }
 
 /************************************************
- * ComputePictureSpatialStatistics
+ * ComputeSegmentSpatialStatistics
  ** Compute Block Variance
- ** Compute Picture Variance
- ** Compute Block Mean for all blocks in the picture
+ ** Compute Block Mean for the LCUs of one segment
  ************************************************/
-static void ComputePictureSpatialStatistics(
+static void ComputeSegmentSpatialStatistics(
 	SequenceControlSet_t            *sequenceControlSetPtr,
 	PictureParentControlSet_t       *pictureControlSetPtr,
-    PictureAnalysisContext_t        *contextPtr,
 	EbPictureBufferDesc_t           *inputPicturePtr,
 	EbPictureBufferDesc_t           *inputPaddedPicturePtr,
-	EB_U32                           lcuTotalCount)
+	EB_U32                           lcuStartIndex,
+	EB_U32                           lcuEndIndex)
 {
 	EB_U32 lcuIndex;
 	EB_U32 lcuOriginX;        // to avoid using child PCS
@@ -3895,12 +3896,8 @@ static void ComputePictureSpatialStatistics(
 	EB_U32 inputLumaOriginIndex;
 	EB_U32 inputCbOriginIndex;
 	EB_U32 inputCrOriginIndex;
-	EB_U64 picTotVariance;
-
-	// Variance
-	picTotVariance = 0;
 
-	for (lcuIndex = 0; lcuIndex < pictureControlSetPtr->lcuTotalCount; ++lcuIndex) {
+	for (lcuIndex = lcuStartIndex; lcuIndex < lcuEndIndex; ++lcuIndex) {
         LcuParams_t   *lcuParams = &sequenceControlSetPtr->lcuParamsArray[lcuIndex];
 
 		lcuOriginX = lcuParams->originX;
@@ -3931,7 +3928,30 @@ static void ComputePictureSpatialStatistics(
 				pictureControlSetPtr,
 				lcuIndex);
 		}
+	}
+
+	return;
+}
 
+/************************************************
+ * ComputePictureSpatialStatistics
+ ** Compute Picture Variance
+ ** Derive the homogeneous regions and the edge map
+ *  from the block statistics of all the segments
+ ************************************************/
+static void ComputePictureSpatialStatistics(
+	SequenceControlSet_t            *sequenceControlSetPtr,
+	PictureParentControlSet_t       *pictureControlSetPtr,
+    PictureAnalysisContext_t        *contextPtr,
+	EB_U32                           lcuTotalCount)
+{
+	EB_U32 lcuIndex;
+	EB_U64 picTotVariance;
+
+	// Variance
+	picTotVariance = 0;
+
+	for (lcuIndex = 0; lcuIndex < pictureControlSetPtr->lcuTotalCount; ++lcuIndex) {
 		picTotVariance += (pictureControlSetPtr->variance[lcuIndex][RASTER_SCAN_CU_INDEX_64x64]);
 	}
 
@@ -4002,7 +4022,6 @@ static void GatheringPictureStatistics(
 	PictureParentControlSet_t       *pictureControlSetPtr,
     PictureAnalysisContext_t        *contextPtr,
 	EbPictureBufferDesc_t           *inputPicturePtr,
-	EbPictureBufferDesc_t           *inputPaddedPicturePtr,
 	EbPictureBufferDesc_t			*sixteenthDecimatedPicturePtr,
 	EB_U32                           lcuTotalCount)
 {
@@ -4012,16 +4031,14 @@ static void GatheringPictureStatistics(
 	EB_U64                          sumAverageIntensityTotalRegionsCr = 0;
 
 	// Histogram bins
-   // Use 1/16 Luma for Histogram generation
-   // 1/16 input ready
+   // The segments have binned the 1/16 Luma
    SubSampleLumaGeneratePixelIntensityHistogramBins(
        sequenceControlSetPtr,
        pictureControlSetPtr,
        sixteenthDecimatedPicturePtr,
        &sumAverageIntensityTotalRegionsLuma);
 
-   // Use 1/4 Chroma for Histogram generation
-   // 1/4 input not ready => perform operation on the fly
+   // The segments have binned the 1/4 Chroma
    SubSampleChromaGeneratePixelIntensityHistogramBins(
        sequenceControlSetPtr,
        pictureControlSetPtr,
@@ -4042,8 +4059,6 @@ static void GatheringPictureStatistics(
 		sequenceControlSetPtr,
 		pictureControlSetPtr,
         contextPtr,
-		inputPicturePtr,
-		inputPaddedPicturePtr,
 		lcuTotalCount);
 
 	return;
@@ -4118,88 +4133,236 @@ static void PadPictureToMultipleOfMinCuSizeDimensions(
 }
 
 /************************************************
- * Pad Picture at the right and bottom sides
- ** To complete border LCU smaller than LCU size
- ************************************************/
-static void PadPictureToMultipleOfLcuDimensions(
-	EbPictureBufferDesc_t           *inputPaddedPicturePtr
-        )
+* Whether the 1/4 input picture is needed
+************************************************/
+static EB_BOOL QuarterDecimationEnabled(
+    SequenceControlSet_t            *sequenceControlSetPtr,
+	PictureParentControlSet_t       *pictureControlSetPtr)
 {
+    // Decimate input picture for HME L1
+    if (sequenceControlSetPtr->staticConfig.speedControlFlag){
+        return EB_TRUE;
+    }
+    return (pictureControlSetPtr->enableHmeLevel1Flag == 1) ? EB_TRUE : EB_FALSE;
+}
 
-	// Generate Padding
-	GeneratePadding(
-		&inputPaddedPicturePtr->bufferY[0],
-		inputPaddedPicturePtr->strideY,
-		inputPaddedPicturePtr->width,
-		inputPaddedPicturePtr->height,
-		inputPaddedPicturePtr->originX,
-		inputPaddedPicturePtr->originY);
+/************************************************
+* Reset the picture histogram
+** Bins start at 1 and the region sums at 0 before
+** the segments merge their samples in
+************************************************/
+static void ResetPictureHistogram(
+    SequenceControlSet_t            *sequenceControlSetPtr,
+	PictureParentControlSet_t       *pictureControlSetPtr)
+{
+	EB_U32 regionInPictureWidthIndex;
+	EB_U32 regionInPictureHeightIndex;
+	EB_U32 component;
+
+	for (regionInPictureWidthIndex = 0; regionInPictureWidthIndex < sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerWidth; regionInPictureWidthIndex++){
+		for (regionInPictureHeightIndex = 0; regionInPictureHeightIndex < sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerHeight; regionInPictureHeightIndex++){
+			for (component = 0; component < 3; component++){
+				// Initialize bins to 1
+				InitializeBuffer_32bits_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](pictureControlSetPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][component], 64, 0, 1);
+				pictureControlSetPtr->averageIntensityPerRegion[regionInPictureWidthIndex][regionInPictureHeightIndex][component] = 0;
+			}
+		}
+	}
 
 	return;
 }
 
 /************************************************
-* 1/4 & 1/16 input picture decimation
+* Add the histogram bins and region sums of the
+* segment to the picture histogram
 ************************************************/
-static void DecimateInputPicture(
+static void MergeSegmentHistogram(
     SequenceControlSet_t            *sequenceControlSetPtr,
 	PictureParentControlSet_t       *pictureControlSetPtr,
-	EbPictureBufferDesc_t           *inputPaddedPicturePtr,
-	EbPictureBufferDesc_t           *quarterDecimatedPicturePtr,
-	EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr) {
+	PictureAnalysisContext_t        *contextPtr)
+{
+	EB_U32 regionInPictureWidthIndex;
+	EB_U32 regionInPictureHeightIndex;
+	EB_U32 component;
+	EB_U32 histogramBin;
+
+	for (regionInPictureWidthIndex = 0; regionInPictureWidthIndex < sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerWidth; regionInPictureWidthIndex++){
+		for (regionInPictureHeightIndex = 0; regionInPictureHeightIndex < sequenceControlSetPtr->pictureAnalysisNumberOfRegionsPerHeight; regionInPictureHeightIndex++){
+			for (component = 0; component < 3; component++){
+				EB_U32 *pictureBins = pictureControlSetPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][component];
+				EB_U32 *segmentBins = contextPtr->regionHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][component];
+
+				for (histogramBin = 0; histogramBin < HISTOGRAM_NUMBER_OF_BINS; histogramBin++){
+					pictureBins[histogramBin] += segmentBins[histogramBin];
+				}
+				pictureControlSetPtr->averageIntensityPerRegion[regionInPictureWidthIndex][regionInPictureHeightIndex][component] +=
+					contextPtr->regionSum[regionInPictureWidthIndex][regionInPictureHeightIndex][component];
+			}
+		}
+	}
 
-    // Decimate input picture for HME L1
-    EB_BOOL  preformQuarterPellDecimationFlag;
-    if (sequenceControlSetPtr->staticConfig.speedControlFlag){
-        preformQuarterPellDecimationFlag = EB_TRUE;
-    }
-    else{
-        if (pictureControlSetPtr->enableHmeLevel1Flag == 1){
-            preformQuarterPellDecimationFlag = EB_TRUE;
-        }
-        else{
-            preformQuarterPellDecimationFlag = EB_FALSE;
-        }
-    }
+	return;
+}
+
+/************************************************
+* Pre-analysis sweep of the LCU rows of a segment
+** Each LCU row is padded, decimated to 1/4 & 1/16,
+** binned into the segment histogram and has the block
+** mean & variance of its LCUs computed while its
+** samples are still in cache
+************************************************/
+static void AnalyzeSegmentLcuRows(
+    SequenceControlSet_t            *sequenceControlSetPtr,
+	PictureParentControlSet_t       *pictureControlSetPtr,
+	PictureAnalysisContext_t        *contextPtr,
+	EbPaReferenceObject_t           *paReferenceObject,
+	EbPictureBufferDesc_t           *inputPicturePtr,
+	EB_U32                           yLcuStartIndex,
+	EB_U32                           yLcuEndIndex,
+	EB_U32                           pictureWidthInLcu,
+	EB_U32                           pictureHeightInLcu)
+{
+	EbPictureBufferDesc_t *inputPaddedPicturePtr = (EbPictureBufferDesc_t*)paReferenceObject->inputPaddedPicturePtr;
+	EbPictureBufferDesc_t *quarterDecimatedPicturePtr = (EbPictureBufferDesc_t*)paReferenceObject->quarterDecimatedPicturePtr;
+	EbPictureBufferDesc_t *sixteenthDecimatedPicturePtr = (EbPictureBufferDesc_t*)paReferenceObject->sixteenthDecimatedPicturePtr;
+	EB_BOOL quarterDecimationFlag = QuarterDecimationEnabled(sequenceControlSetPtr, pictureControlSetPtr);
+	EB_U32 yLcuIndex;
+	EB_U32 lcuIndex;
 
-    if (preformQuarterPellDecimationFlag) {
-        Decimation2D(
-		        &inputPaddedPicturePtr->bufferY[inputPaddedPicturePtr->originX + inputPaddedPicturePtr->originY * inputPaddedPicturePtr->strideY],
-		        inputPaddedPicturePtr->strideY,
-		        inputPaddedPicturePtr->width ,
-		        inputPaddedPicturePtr->height,
-		        &quarterDecimatedPicturePtr->bufferY[quarterDecimatedPicturePtr->originX+quarterDecimatedPicturePtr->originY*quarterDecimatedPicturePtr->strideY],
-		        quarterDecimatedPicturePtr->strideY,
-		        2);
-
-            GeneratePadding(
-		        &quarterDecimatedPicturePtr->bufferY[0],
-		        quarterDecimatedPicturePtr->strideY,
-		        quarterDecimatedPicturePtr->width,
-		        quarterDecimatedPicturePtr->height,
-		        quarterDecimatedPicturePtr->originX,
-		        quarterDecimatedPicturePtr->originY);
+	EB_MEMSET(contextPtr->regionHistogram, 0, sizeof(contextPtr->regionHistogram));
+	EB_MEMSET(contextPtr->regionSum, 0, sizeof(contextPtr->regionSum));
+
+	for (yLcuIndex = yLcuStartIndex; yLcuIndex < yLcuEndIndex; ++yLcuIndex) {
+		// The last LCU row also takes the rows left below the last complete LCU
+		EB_BOOL lastRowFlag = (yLcuIndex == pictureHeightInLcu - 1) ? EB_TRUE : EB_FALSE;
+		EB_U32 lumaRowStart = yLcuIndex * sequenceControlSetPtr->lcuSize;
+		EB_U32 lumaRowEnd = lastRowFlag ?
+			inputPaddedPicturePtr->height :
+			MIN(lumaRowStart + sequenceControlSetPtr->lcuSize, inputPaddedPicturePtr->height);
+		EB_U32 sixteenthRowStart = lumaRowStart >> 2;
+		EB_U32 sixteenthRowEnd = lastRowFlag ? sixteenthDecimatedPicturePtr->height : lumaRowEnd >> 2;
+		EB_U8 *inputPtr = &inputPaddedPicturePtr->bufferY[inputPaddedPicturePtr->originX + (inputPaddedPicturePtr->originY + lumaRowStart) * inputPaddedPicturePtr->strideY];
+
+		// Pad the rows to complete the border LCUs
+		GeneratePaddingLines(
+			&inputPaddedPicturePtr->bufferY[0],
+			inputPaddedPicturePtr->strideY,
+			inputPaddedPicturePtr->width,
+			inputPaddedPicturePtr->height,
+			inputPaddedPicturePtr->originX,
+			inputPaddedPicturePtr->originY,
+			lumaRowStart,
+			lumaRowEnd - lumaRowStart);
+
+		// Decimate input picture for HME L1
+		if (quarterDecimationFlag) {
+			EB_U32 quarterRowStart = lumaRowStart >> 1;
+			EB_U32 quarterRowEnd = lastRowFlag ? quarterDecimatedPicturePtr->height : lumaRowEnd >> 1;
+
+			Decimation2D_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](
+				inputPtr,
+				inputPaddedPicturePtr->strideY,
+				inputPaddedPicturePtr->width,
+				lumaRowEnd - lumaRowStart,
+				&quarterDecimatedPicturePtr->bufferY[quarterDecimatedPicturePtr->originX + (quarterDecimatedPicturePtr->originY + quarterRowStart) * quarterDecimatedPicturePtr->strideY],
+				quarterDecimatedPicturePtr->strideY,
+				2);
+
+			GeneratePaddingLines(
+				&quarterDecimatedPicturePtr->bufferY[0],
+				quarterDecimatedPicturePtr->strideY,
+				quarterDecimatedPicturePtr->width,
+				quarterDecimatedPicturePtr->height,
+				quarterDecimatedPicturePtr->originX,
+				quarterDecimatedPicturePtr->originY,
+				quarterRowStart,
+				quarterRowEnd - quarterRowStart);
+		}
 
+		// Decimate input picture for HME L0
+		Decimation2D_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)](
+			inputPtr,
+			inputPaddedPicturePtr->strideY,
+			inputPaddedPicturePtr->width,
+			lumaRowEnd - lumaRowStart,
+			&sixteenthDecimatedPicturePtr->bufferY[sixteenthDecimatedPicturePtr->originX + (sixteenthDecimatedPicturePtr->originY + sixteenthRowStart) * sixteenthDecimatedPicturePtr->strideY],
+			sixteenthDecimatedPicturePtr->strideY,
+			4);
+
+		GeneratePaddingLines(
+			&sixteenthDecimatedPicturePtr->bufferY[0],
+			sixteenthDecimatedPicturePtr->strideY,
+			sixteenthDecimatedPicturePtr->width,
+			sixteenthDecimatedPicturePtr->height,
+			sixteenthDecimatedPicturePtr->originX,
+			sixteenthDecimatedPicturePtr->originY,
+			sixteenthRowStart,
+			sixteenthRowEnd - sixteenthRowStart);
+
+		// Use 1/16 Luma for Histogram generation
+		AccumulateRegionHistogramRows(
+			sequenceControlSetPtr,
+			contextPtr,
+			sixteenthDecimatedPicturePtr->bufferY,
+			sixteenthDecimatedPicturePtr->strideY,
+			sixteenthDecimatedPicturePtr->originX,
+			sixteenthDecimatedPicturePtr->originY,
+			sixteenthDecimatedPicturePtr->width,
+			sixteenthDecimatedPicturePtr->height,
+			0,
+			1,
+			0,
+			sixteenthDecimatedPicturePtr->originY + sixteenthRowStart,
+			sixteenthDecimatedPicturePtr->originY + sixteenthRowEnd);
+
+		// Use 1/4 Chroma for Histogram generation
+		AccumulateRegionHistogramRows(
+			sequenceControlSetPtr,
+			contextPtr,
+			inputPicturePtr->bufferCb,
+			inputPicturePtr->strideCb,
+			inputPicturePtr->originX,
+			inputPicturePtr->originY,
+			inputPicturePtr->width,
+			inputPicturePtr->height,
+			1,
+			4,
+			1,
+			(inputPicturePtr->originY + lumaRowStart) >> 1,
+			lastRowFlag ? (EB_U32)~0 : (inputPicturePtr->originY + lumaRowEnd) >> 1);
+
+		AccumulateRegionHistogramRows(
+			sequenceControlSetPtr,
+			contextPtr,
+			inputPicturePtr->bufferCr,
+			inputPicturePtr->strideCr,
+			inputPicturePtr->originX,
+			inputPicturePtr->originY,
+			inputPicturePtr->width,
+			inputPicturePtr->height,
+			1,
+			4,
+			2,
+			(inputPicturePtr->originY + lumaRowStart) >> 1,
+			lastRowFlag ? (EB_U32)~0 : (inputPicturePtr->originY + lumaRowEnd) >> 1);
+
+		// Variance and mean of the row LCUs
+		ComputeSegmentSpatialStatistics(
+			sequenceControlSetPtr,
+			pictureControlSetPtr,
+			inputPicturePtr,
+			inputPaddedPicturePtr,
+			yLcuIndex * pictureWidthInLcu,
+			(yLcuIndex + 1) * pictureWidthInLcu);
+
+		// Hold the 64x64 variance and mean in the reference frame
+		for (lcuIndex = yLcuIndex * pictureWidthInLcu; lcuIndex < (yLcuIndex + 1) * pictureWidthInLcu; ++lcuIndex){
+			paReferenceObject->variance[lcuIndex] = pictureControlSetPtr->variance[lcuIndex][ME_TIER_ZERO_PU_64x64];
+			paReferenceObject->yMean[lcuIndex] = pictureControlSetPtr->yMean[lcuIndex][ME_TIER_ZERO_PU_64x64];
+		}
 	}
 
-    // Decimate input picture for HME L0
-	// Sixteenth Input Picture Decimation
-    Decimation2D(
-		&inputPaddedPicturePtr->bufferY[inputPaddedPicturePtr->originX + inputPaddedPicturePtr->originY * inputPaddedPicturePtr->strideY],
-		inputPaddedPicturePtr->strideY,
-		inputPaddedPicturePtr->width ,
-		inputPaddedPicturePtr->height ,
-		&sixteenthDecimatedPicturePtr->bufferY[sixteenthDecimatedPicturePtr->originX+sixteenthDecimatedPicturePtr->originY*sixteenthDecimatedPicturePtr->strideY],
-		sixteenthDecimatedPicturePtr->strideY,
-		4);
-
-    GeneratePadding(
-		&sixteenthDecimatedPicturePtr->bufferY[0],
-		sixteenthDecimatedPicturePtr->strideY,
-		sixteenthDecimatedPicturePtr->width,
-		sixteenthDecimatedPicturePtr->height,
-		sixteenthDecimatedPicturePtr->originX,
-		sixteenthDecimatedPicturePtr->originY);
+	return;
 }
 
 /************************************************
@@ -4210,6 +4373,12 @@ static void DecimateInputPicture(
  * which are used to compute variance.
  * The Picture Analysis process is multithreaded, so pictures can be
  * processed out of order as long as all inputs are available.
+ * A picture is split into segments of LCU rows: the first segment
+ * task to start runs the picture pre-processing while the others
+ * wait for it, every segment sweeps its LCU rows once to pad,
+ * decimate, bin and compute the statistics of its LCUs, and the
+ * last segment to complete gathers the picture statistics and
+ * posts the picture.
  ************************************************/
 void* PictureAnalysisKernel(void *inputPtr)
 {
@@ -4223,7 +4392,6 @@ void* PictureAnalysisKernel(void *inputPtr)
 	PictureAnalysisResults_t        *outputResultsPtr;
 	EbPaReferenceObject_t           *paReferenceObject;
 
-	EbPictureBufferDesc_t           *inputPaddedPicturePtr;
 	EbPictureBufferDesc_t           *quarterDecimatedPicturePtr;
 	EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr;
 	EbPictureBufferDesc_t           *inputPicturePtr;
@@ -4233,6 +4401,14 @@ void* PictureAnalysisKernel(void *inputPtr)
 	EB_U32                          pictureHeighInLcu;
 	EB_U32                          lcuTotalCount;
 
+	// Segments
+	EB_U32                          segmentIndex;
+	EB_U32                          yLcuStartIndex;
+	EB_U32                          yLcuEndIndex;
+	EB_BOOL                         firstSegmentFlag;
+	EB_BOOL                         lastSegmentFlag;
+	EB_U32                          waitingSegmentCount;
+
 	for (;;) {
 
 		// Get Input Full Object
@@ -4249,7 +4425,6 @@ void* PictureAnalysisKernel(void *inputPtr)
         SVT_LOG("POC %lld PA IN \n", pictureControlSetPtr->pictureNumber);
 #endif
 		paReferenceObject = (EbPaReferenceObject_t*)pictureControlSetPtr->paReferencePictureWrapperPtr->objectPtr;
-		inputPaddedPicturePtr = (EbPictureBufferDesc_t*)paReferenceObject->inputPaddedPicturePtr;
 		quarterDecimatedPicturePtr = (EbPictureBufferDesc_t*)paReferenceObject->quarterDecimatedPicturePtr;
 		sixteenthDecimatedPicturePtr = (EbPictureBufferDesc_t*)paReferenceObject->sixteenthDecimatedPicturePtr;
 
@@ -4258,47 +4433,87 @@ void* PictureAnalysisKernel(void *inputPtr)
 		pictureHeighInLcu = (sequenceControlSetPtr->lumaHeight + sequenceControlSetPtr->lcuSize - 1) / sequenceControlSetPtr->lcuSize;
 		lcuTotalCount = pictureWidthInLcu * pictureHeighInLcu;
 
-        // Set picture parameters to account for subpicture, picture scantype, and set regions by resolutions
-		SetPictureParametersForStatisticsGathering(
-			sequenceControlSetPtr);
+		segmentIndex = inputResultsPtr->segmentIndex;
+		yLcuStartIndex = SEGMENT_START_IDX(segmentIndex, pictureHeighInLcu, pictureControlSetPtr->paSegmentsTotalCount);
+		yLcuEndIndex = SEGMENT_END_IDX(segmentIndex, pictureHeighInLcu, pictureControlSetPtr->paSegmentsTotalCount);
 
-		// Pad pictures to multiple min cu size
-		PadPictureToMultipleOfMinCuSizeDimensions(
-			sequenceControlSetPtr,
-			inputPicturePtr);
+		EbBlockOnMutex(pictureControlSetPtr->paSegmentsMutex);
+		firstSegmentFlag = (pictureControlSetPtr->paSegmentsStartedFlag == EB_FALSE);
+		pictureControlSetPtr->paSegmentsStartedFlag = EB_TRUE;
+		EbReleaseMutex(pictureControlSetPtr->paSegmentsMutex);
 
-		// Pre processing operations performed on the input picture
-        PicturePreProcessingOperations(
-            pictureControlSetPtr,
-            contextPtr,
-            sequenceControlSetPtr,
-            quarterDecimatedPicturePtr,
-            sixteenthDecimatedPicturePtr,
-            lcuTotalCount,
-            pictureWidthInLcu);
-
-        if (inputPicturePtr->colorFormat >= EB_YUV422) {
-            // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
-            //       Reuse the Y, only add cb/cr in the newly created buffer desc
-            //       NOTE: since denoise may change the src, so this part is after PicturePreProcessingOperations()
-            pictureControlSetPtr->chromaDownSamplePicturePtr->bufferY = inputPicturePtr->bufferY;
-            DownSampleChroma(inputPicturePtr, pictureControlSetPtr->chromaDownSamplePicturePtr);
-        } else {
-            pictureControlSetPtr->chromaDownSamplePicturePtr = inputPicturePtr;
-        }
+		if (firstSegmentFlag) {
 
-		// Pad input picture to complete border LCUs
-		PadPictureToMultipleOfLcuDimensions(
-			inputPaddedPicturePtr
-        );
+	        // Set picture parameters to account for subpicture, picture scantype, and set regions by resolutions
+			SetPictureParametersForStatisticsGathering(
+				sequenceControlSetPtr);
 
-		// 1/4 & 1/16 input picture decimation
-		DecimateInputPicture(
-            sequenceControlSetPtr,
+			ResetPictureHistogram(
+				sequenceControlSetPtr,
+				pictureControlSetPtr);
+
+			// Pad pictures to multiple min cu size
+			PadPictureToMultipleOfMinCuSizeDimensions(
+				sequenceControlSetPtr,
+				inputPicturePtr);
+
+			// Pre processing operations performed on the input picture
+	        PicturePreProcessingOperations(
+	            pictureControlSetPtr,
+	            contextPtr,
+	            sequenceControlSetPtr,
+	            quarterDecimatedPicturePtr,
+	            sixteenthDecimatedPicturePtr,
+	            lcuTotalCount,
+	            pictureWidthInLcu);
+
+	        if (inputPicturePtr->colorFormat >= EB_YUV422) {
+	            // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
+	            //       Reuse the Y, only add cb/cr in the newly created buffer desc
+	            //       NOTE: since denoise may change the src, so this part is after PicturePreProcessingOperations()
+	            pictureControlSetPtr->chromaDownSamplePicturePtr->bufferY = inputPicturePtr->bufferY;
+	            DownSampleChroma(inputPicturePtr, pictureControlSetPtr->chromaDownSamplePicturePtr);
+	        } else {
+	            pictureControlSetPtr->chromaDownSamplePicturePtr = inputPicturePtr;
+	        }
+
+			// Release the other segments of the picture
+			for (waitingSegmentCount = 1; waitingSegmentCount < pictureControlSetPtr->paSegmentsTotalCount; ++waitingSegmentCount) {
+				EbPostSemaphore(pictureControlSetPtr->paSegmentsReadySemaphore);
+			}
+		}
+		else {
+			// Wait for the picture pre-processing
+			EbSuspendTask();
+			EbBlockOnSemaphore(pictureControlSetPtr->paSegmentsReadySemaphore);
+			EbResumeTask();
+		}
+
+		// Pad, decimate, bin and compute the block statistics of the segment rows
+		AnalyzeSegmentLcuRows(
+			sequenceControlSetPtr,
 			pictureControlSetPtr,
-			inputPaddedPicturePtr,
-			quarterDecimatedPicturePtr,
-			sixteenthDecimatedPicturePtr);
+			contextPtr,
+			paReferenceObject,
+			pictureControlSetPtr->chromaDownSamplePicturePtr, //420 inputPicturePtr
+			yLcuStartIndex,
+			yLcuEndIndex,
+			pictureWidthInLcu,
+			pictureHeighInLcu);
+
+		EbBlockOnMutex(pictureControlSetPtr->paSegmentsMutex);
+		MergeSegmentHistogram(
+			sequenceControlSetPtr,
+			pictureControlSetPtr,
+			contextPtr);
+		lastSegmentFlag = (++pictureControlSetPtr->paSegmentsCompletionCount == pictureControlSetPtr->paSegmentsTotalCount);
+		EbReleaseMutex(pictureControlSetPtr->paSegmentsMutex);
+
+		if (!lastSegmentFlag) {
+			// Release the Input Results
+			EbReleaseObject(inputResultsWrapperPtr);
+			continue;
+		}
 
 		// Gathering statistics of input picture, including Variance Calculation, Histogram Bins
 		GatheringPictureStatistics(
@@ -4306,19 +4521,9 @@ void* PictureAnalysisKernel(void *inputPtr)
 			pictureControlSetPtr,
             contextPtr,
 			pictureControlSetPtr->chromaDownSamplePicturePtr, //420 inputPicturePtr
-			inputPaddedPicturePtr,
 			sixteenthDecimatedPicturePtr,
 			lcuTotalCount);
 
-
-		// Hold the 64x64 variance and mean in the reference frame
-		EB_U32 lcuIndex;
-		for (lcuIndex = 0; lcuIndex < pictureControlSetPtr->lcuTotalCount; ++lcuIndex){
-			paReferenceObject->variance[lcuIndex] = pictureControlSetPtr->variance[lcuIndex][ME_TIER_ZERO_PU_64x64];
-			paReferenceObject->yMean[lcuIndex] = pictureControlSetPtr->yMean[lcuIndex][ME_TIER_ZERO_PU_64x64];
-
-		}
-
 		// Get Empty Results Object
 		EbGetEmptyObject(
 			contextPtr->pictureAnalysisResultsOutputFifoPtr,
@@ -8,6 +8,7 @@
 
 #include "EbDefinitions.h"
 #include "EbSystemResourceManager.h"
+#include "EbPictureControlSet.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +26,10 @@ typedef struct PictureAnalysisContext_s
 	EbPictureBufferDesc_t        *noisePicturePtr;
 	double						  picNoiseVarianceFloat;
     EB_U16		                **grad;
+
+    // Histogram bins and sample sums of the current segment, per region
+    EB_U32                        regionHistogram[MAX_NUMBER_OF_REGIONS_IN_WIDTH][MAX_NUMBER_OF_REGIONS_IN_HEIGHT][3][HISTOGRAM_NUMBER_OF_BINS];
+    EB_U64                        regionSum[MAX_NUMBER_OF_REGIONS_IN_WIDTH][MAX_NUMBER_OF_REGIONS_IN_HEIGHT][3];
 } PictureAnalysisContext_t;
 
 /***************************************
@@ -175,3 +175,75 @@ EB_ERRORTYPE EbReconPictureBufferDescCtor(
 
     return EB_ErrorNone;
 }
+
+/*****************************************
+ * EbPictureBufferPlaneBindNuma
+ *   Binds the rows of one plane band by band, the first
+ *   and last bands take the padding rows
+ *****************************************/
+static void EbPictureBufferPlaneBindNuma(
+    EbNumaTopology_t   *topologyPtr,
+    EB_BYTE             bufferPtr,
+    EB_U64              planeSize,
+    EB_U64              rowSize,
+    EB_U32              originRow,
+    EB_U32              lcuRowCount,
+    EB_U32              pictureHeightInLcu)
+{
+    EB_U32 partition;
+    EB_U64 startRow;
+    EB_U64 endRow = 0;
+
+    for (partition = 0; partition < topologyPtr->nodeCount; ++partition) {
+        startRow = endRow;
+        endRow = (partition + 1 == topologyPtr->nodeCount) ?
+            planeSize / rowSize :
+            originRow + (EB_U64)lcuRowCount * (((partition + 1) * pictureHeightInLcu + topologyPtr->nodeCount - 1) / topologyPtr->nodeCount);
+        EbNumaBindMemory(topologyPtr, bufferPtr + startRow * rowSize, (endRow - startRow) * rowSize, partition);
+    }
+}
+
+/*****************************************
+ * EbPictureBufferDescBindNuma
+ *   Places each band of LCU rows on the node that
+ *   processes it, see EbNumaRowPartition. lcuSize is
+ *   the LCU height in luma rows of this picture.
+ *****************************************/
+void EbPictureBufferDescBindNuma(
+    EbPictureBufferDesc_t  *pictureBufferDescPtr,
+    EbNumaTopology_t       *topologyPtr,
+    EB_U32                  lcuSize)
+{
+    EB_U32 bytesPerPixel = (pictureBufferDescPtr->bitDepth == EB_8BIT) ? 1 : 2;
+    EB_U32 subHeightCMinus1 = (pictureBufferDescPtr->colorFormat == EB_YUV420) ? 1 : 0;
+    EB_U32 pictureHeightInLcu = (pictureBufferDescPtr->maxHeight + lcuSize - 1) / lcuSize;
+
+    if (topologyPtr->nodeCount == 0) {
+        return;
+    }
+
+    if (pictureBufferDescPtr->bufferY) {
+        EbPictureBufferPlaneBindNuma(topologyPtr, pictureBufferDescPtr->bufferY, (EB_U64)pictureBufferDescPtr->lumaSize * bytesPerPixel,
+            (EB_U64)pictureBufferDescPtr->strideY * bytesPerPixel, pictureBufferDescPtr->originY, lcuSize, pictureHeightInLcu);
+    }
+    if (pictureBufferDescPtr->bufferBitIncY) {
+        EbPictureBufferPlaneBindNuma(topologyPtr, pictureBufferDescPtr->bufferBitIncY, (EB_U64)pictureBufferDescPtr->lumaSize * bytesPerPixel,
+            (EB_U64)pictureBufferDescPtr->strideBitIncY * bytesPerPixel, pictureBufferDescPtr->originY, lcuSize, pictureHeightInLcu);
+    }
+    if (pictureBufferDescPtr->bufferCb) {
+        EbPictureBufferPlaneBindNuma(topologyPtr, pictureBufferDescPtr->bufferCb, (EB_U64)pictureBufferDescPtr->chromaSize * bytesPerPixel,
+            (EB_U64)pictureBufferDescPtr->strideCb * bytesPerPixel, pictureBufferDescPtr->originY >> subHeightCMinus1, lcuSize >> subHeightCMinus1, pictureHeightInLcu);
+    }
+    if (pictureBufferDescPtr->bufferCr) {
+        EbPictureBufferPlaneBindNuma(topologyPtr, pictureBufferDescPtr->bufferCr, (EB_U64)pictureBufferDescPtr->chromaSize * bytesPerPixel,
+            (EB_U64)pictureBufferDescPtr->strideCr * bytesPerPixel, pictureBufferDescPtr->originY >> subHeightCMinus1, lcuSize >> subHeightCMinus1, pictureHeightInLcu);
+    }
+    if (pictureBufferDescPtr->bufferBitIncCb) {
+        EbPictureBufferPlaneBindNuma(topologyPtr, pictureBufferDescPtr->bufferBitIncCb, (EB_U64)pictureBufferDescPtr->chromaSize * bytesPerPixel,
+            (EB_U64)pictureBufferDescPtr->strideBitIncCb * bytesPerPixel, pictureBufferDescPtr->originY >> subHeightCMinus1, lcuSize >> subHeightCMinus1, pictureHeightInLcu);
+    }
+    if (pictureBufferDescPtr->bufferBitIncCr) {
+        EbPictureBufferPlaneBindNuma(topologyPtr, pictureBufferDescPtr->bufferBitIncCr, (EB_U64)pictureBufferDescPtr->chromaSize * bytesPerPixel,
+            (EB_U64)pictureBufferDescPtr->strideBitIncCr * bytesPerPixel, pictureBufferDescPtr->originY >> subHeightCMinus1, lcuSize >> subHeightCMinus1, pictureHeightInLcu);
+    }
+}
@@ -9,6 +9,7 @@
 #include <stdio.h> 
 
 #include "EbDefinitions.h"
+#include "EbThreads.h"
 
 
 #ifdef __cplusplus
@@ -61,6 +62,9 @@ typedef struct EbPictureBufferDesc_s
 	EB_SEI_MESSAGE    dolbyVisionRpu;
 	EB_SEI_MESSAGE    userSeiMsg;
 
+	EB_PTR          appBufferPtr;   // Application buffer header whose planes are referenced (zero-copy input)
+	EB_U32          parameterUpdateCount; // EbH265EncUpdateParameter calls made before the input was sent
+
 } EbPictureBufferDesc_t;
 
 /************************************
@@ -92,6 +96,11 @@ extern EB_ERRORTYPE EbReconPictureBufferDescCtor(
     EB_PTR *objectDblPtr, 
     EB_PTR objectInitDataPtr);
 
+extern void EbPictureBufferDescBindNuma(
+    EbPictureBufferDesc_t  *pictureBufferDescPtr,
+    EbNumaTopology_t       *topologyPtr,
+    EB_U32                  lcuSize);
+
 #ifdef __cplusplus
 }
 #endif
@@ -659,11 +659,54 @@ EB_ERRORTYPE PictureControlSetCtor(
     // Entropy picture level mutex
     EB_CREATEMUTEX(EB_HANDLE, objectPtr->entropyCodingPicMutex, sizeof(EB_HANDLE), EB_MUTEX);
 
+    // Wavefront substreams, row 0 uses the (single) tile entropy coder
+    objectPtr->wppEntropyCoderPtrArray = (EntropyCoder_t**)EB_NULL;
+    objectPtr->wppContextModelArray = (ContextModelEncContext_t*)EB_NULL;
+    objectPtr->wppRowProgressSemaphoreArray = (EB_HANDLE*)EB_NULL;
+    if (initDataPtr->enableWppFlag) {
+        // A row buffer holds 5/3 of the raw LCU row size, the coding_tree_unit() limit of A.4.2
+        const EB_U32 rowSampleCountX2 = pictureWidthInLcu * initDataPtr->lcuSize * initDataPtr->lcuSize *
+            (initDataPtr->colorFormat == EB_YUV444 ? 6 : initDataPtr->colorFormat == EB_YUV422 ? 4 : 3);
+        const EB_U32 wppRowBufferSize = (rowSampleCountX2 * (is16bit ? 2 : 1) * 5) / 6;
+        EB_U16 rowIndex;
+
+        EB_MALLOC(EntropyCoder_t**, objectPtr->wppEntropyCoderPtrArray, sizeof(EntropyCoder_t*) * pictureHeightInLcu, EB_N_PTR);
+        EB_MALLOC(ContextModelEncContext_t*, objectPtr->wppContextModelArray, sizeof(ContextModelEncContext_t) * pictureHeightInLcu, EB_N_PTR);
+        EB_MALLOC(EB_HANDLE*, objectPtr->wppRowProgressSemaphoreArray, sizeof(EB_HANDLE) * pictureHeightInLcu, EB_N_PTR);
+
+        objectPtr->wppEntropyCoderPtrArray[0] = objectPtr->entropyCodingInfo[0]->entropyCoderPtr;
+        for (rowIndex = 1; rowIndex < pictureHeightInLcu; ++rowIndex) {
+            return_error = EntropyCoderCtor(
+                &objectPtr->wppEntropyCoderPtrArray[rowIndex],
+                wppRowBufferSize);
+            if (return_error == EB_ErrorInsufficientResources){
+                return EB_ErrorInsufficientResources;
+            }
+        }
+        for (rowIndex = 0; rowIndex < pictureHeightInLcu; ++rowIndex) {
+            EB_CREATESEMAPHORE(EB_HANDLE, objectPtr->wppRowProgressSemaphoreArray[rowIndex], sizeof(EB_HANDLE), EB_SEMAPHORE, 0, pictureWidthInLcu);
+        }
+    }
+
     EB_CREATEMUTEX(EB_HANDLE, objectPtr->intraMutex, sizeof(EB_HANDLE), EB_MUTEX);
 
     objectPtr->encDecCodedLcuCount = 0;
     objectPtr->resetDone = EB_FALSE;
 
+    // Post-filter row tasks
+    objectPtr->postFilterSaoFlag = EB_FALSE;
+    objectPtr->postFilterNextRow = 0;
+    objectPtr->postFilterBusyFlag = EB_FALSE;
+    EB_MALLOC(EB_U32*, objectPtr->lcuRowCodedCountArray, sizeof(EB_U32) * pictureHeightInLcu, EB_N_PTR);
+    {
+        const EB_U32 saoRowLineSize = initDataPtr->pictureWidth * (is16bit ? sizeof(EB_U16) : sizeof(EB_U8));
+        EB_U32 componentIndex;
+
+        for (componentIndex = 0; componentIndex < 3; ++componentIndex) {
+            EB_MALLOC(EB_U8*, objectPtr->saoRowLastLineArray[componentIndex], saoRowLineSize, EB_N_PTR);
+        }
+    }
+
     return EB_ErrorNone;
 }
 
@@ -743,15 +786,21 @@ EB_ERRORTYPE PictureParentControlSetCtor(
     objectPtr->lastIdrPicture = 0;
     objectPtr->lcuTotalCount            = pictureLcuWidth * pictureLcuHeight;
 
+	// Per-LCU statistics are held in one cache aligned buffer each, one cache line multiple per LCU
+	EB_ALLIGN_MALLOC(EB_U16*, objectPtr->varianceBuffer, sizeof(EB_U16) * LCU_VARIANCE_STRIDE * objectPtr->lcuTotalCount, EB_A_PTR);
+	EB_ALLIGN_MALLOC(EB_U8*, objectPtr->yMeanBuffer, sizeof(EB_U8) * LCU_Y_MEAN_STRIDE * objectPtr->lcuTotalCount, EB_A_PTR);
+	EB_ALLIGN_MALLOC(EB_U8*, objectPtr->cbMeanBuffer, sizeof(EB_U8) * LCU_CHROMA_MEAN_STRIDE * objectPtr->lcuTotalCount, EB_A_PTR);
+	EB_ALLIGN_MALLOC(EB_U8*, objectPtr->crMeanBuffer, sizeof(EB_U8) * LCU_CHROMA_MEAN_STRIDE * objectPtr->lcuTotalCount, EB_A_PTR);
+
 	EB_MALLOC(EB_U16**, objectPtr->variance, sizeof(EB_U16*) * objectPtr->lcuTotalCount, EB_N_PTR);
 	EB_MALLOC(EB_U8**, objectPtr->yMean, sizeof(EB_U8*) * objectPtr->lcuTotalCount, EB_N_PTR);
 	EB_MALLOC(EB_U8**, objectPtr->cbMean, sizeof(EB_U8*) * objectPtr->lcuTotalCount, EB_N_PTR);
 	EB_MALLOC(EB_U8**, objectPtr->crMean, sizeof(EB_U8*) * objectPtr->lcuTotalCount, EB_N_PTR);
 	for (lcuIndex = 0; lcuIndex < objectPtr->lcuTotalCount; ++lcuIndex) {
-		EB_MALLOC(EB_U16*, objectPtr->variance[lcuIndex], sizeof(EB_U16) * MAX_ME_PU_COUNT, EB_N_PTR);
-		EB_MALLOC(EB_U8*, objectPtr->yMean[lcuIndex], sizeof(EB_U8) * MAX_ME_PU_COUNT, EB_N_PTR);
-		EB_MALLOC(EB_U8*, objectPtr->cbMean[lcuIndex], sizeof(EB_U8) * 21, EB_N_PTR);
-		EB_MALLOC(EB_U8*, objectPtr->crMean[lcuIndex], sizeof(EB_U8) * 21, EB_N_PTR);
+		objectPtr->variance[lcuIndex] = &objectPtr->varianceBuffer[lcuIndex * LCU_VARIANCE_STRIDE];
+		objectPtr->yMean[lcuIndex] = &objectPtr->yMeanBuffer[lcuIndex * LCU_Y_MEAN_STRIDE];
+		objectPtr->cbMean[lcuIndex] = &objectPtr->cbMeanBuffer[lcuIndex * LCU_CHROMA_MEAN_STRIDE];
+		objectPtr->crMean[lcuIndex] = &objectPtr->crMeanBuffer[lcuIndex * LCU_CHROMA_MEAN_STRIDE];
 	}
 
     //LCU edge info
@@ -761,6 +810,7 @@ EB_ERRORTYPE PictureParentControlSetCtor(
     // Histograms
     EB_U32 videoComponent;
 
+    EB_ALLIGN_MALLOC(EB_U32*, objectPtr->pictureHistogramBuffer, sizeof(EB_U32) * MAX_NUMBER_OF_REGIONS_IN_WIDTH * MAX_NUMBER_OF_REGIONS_IN_HEIGHT * 3 * HISTOGRAM_NUMBER_OF_BINS, EB_A_PTR);
     EB_MALLOC(EB_U32****, objectPtr->pictureHistogram, sizeof(EB_U32***) * MAX_NUMBER_OF_REGIONS_IN_WIDTH, EB_N_PTR);
 
 	for (regionInPictureWidthIndex = 0; regionInPictureWidthIndex < MAX_NUMBER_OF_REGIONS_IN_WIDTH; regionInPictureWidthIndex++){  // loop over horizontal regions
@@ -777,40 +827,46 @@ EB_ERRORTYPE PictureParentControlSetCtor(
 	for (regionInPictureWidthIndex = 0; regionInPictureWidthIndex < MAX_NUMBER_OF_REGIONS_IN_WIDTH; regionInPictureWidthIndex++){  // loop over horizontal regions
 		for (regionInPictureHeightIndex = 0; regionInPictureHeightIndex < MAX_NUMBER_OF_REGIONS_IN_HEIGHT; regionInPictureHeightIndex++){ // loop over vertical regions
 			for (videoComponent = 0; videoComponent < 3; ++videoComponent) {
-                EB_MALLOC(EB_U32*, objectPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][videoComponent], sizeof(EB_U32) * HISTOGRAM_NUMBER_OF_BINS, EB_N_PTR);
+                objectPtr->pictureHistogram[regionInPictureWidthIndex][regionInPictureHeightIndex][videoComponent] =
+                    &objectPtr->pictureHistogramBuffer[((regionInPictureWidthIndex * MAX_NUMBER_OF_REGIONS_IN_HEIGHT + regionInPictureHeightIndex) * 3 + videoComponent) * HISTOGRAM_NUMBER_OF_BINS];
 			}
 		}
 	}
 
     EB_U32 maxOisCand = MAX(MAX_OIS_0, MAX_OIS_2);
 
+	OisCandidate_t* contigousCand;
+	EB_U32 cuIdx;
+
+	EB_U32 candStride = LCU_STATS_STRIDE(21 * maxOisCand, OisCandidate_t);
+
+	EB_ALLIGN_MALLOC(OisCu32Cu16Results_t*, objectPtr->oisCu32Cu16ResultsBuffer, sizeof(OisCu32Cu16Results_t) * LCU_OIS_CU32_CU16_STRIDE * objectPtr->lcuTotalCount, EB_A_PTR);
+	EB_ALLIGN_MALLOC(OisCandidate_t*, contigousCand, sizeof(OisCandidate_t) * candStride * objectPtr->lcuTotalCount, EB_A_PTR);
 	EB_MALLOC(OisCu32Cu16Results_t**, objectPtr->oisCu32Cu16Results, sizeof(OisCu32Cu16Results_t*) * objectPtr->lcuTotalCount, EB_N_PTR);
 
 	for (lcuIndex = 0; lcuIndex < objectPtr->lcuTotalCount; ++lcuIndex){
 
-		EB_MALLOC(OisCu32Cu16Results_t*, objectPtr->oisCu32Cu16Results[lcuIndex], sizeof(OisCu32Cu16Results_t), EB_N_PTR);
+		OisCu32Cu16Results_t *oisCu32Cu16Results = &objectPtr->oisCu32Cu16ResultsBuffer[lcuIndex * LCU_OIS_CU32_CU16_STRIDE];
 
-		OisCandidate_t* contigousCand;
-		EB_MALLOC(OisCandidate_t*, contigousCand, sizeof(OisCandidate_t) * maxOisCand * 21, EB_N_PTR);
-
-		EB_U32 cuIdx;
 		for (cuIdx = 0; cuIdx < 21; ++cuIdx){
-			objectPtr->oisCu32Cu16Results[lcuIndex]->sortedOisCandidate[cuIdx] = &contigousCand[cuIdx*maxOisCand];
+			oisCu32Cu16Results->sortedOisCandidate[cuIdx] = &contigousCand[lcuIndex * candStride + cuIdx * maxOisCand];
 		}
+		objectPtr->oisCu32Cu16Results[lcuIndex] = oisCu32Cu16Results;
 	}
 
+	candStride = LCU_STATS_STRIDE(64 * maxOisCand, OisCandidate_t);
+
+	EB_ALLIGN_MALLOC(OisCu8Results_t*, objectPtr->oisCu8ResultsBuffer, sizeof(OisCu8Results_t) * LCU_OIS_CU8_STRIDE * objectPtr->lcuTotalCount, EB_A_PTR);
+	EB_ALLIGN_MALLOC(OisCandidate_t*, contigousCand, sizeof(OisCandidate_t) * candStride * objectPtr->lcuTotalCount, EB_A_PTR);
 	EB_MALLOC(OisCu8Results_t**, objectPtr->oisCu8Results, sizeof(OisCu8Results_t*) * objectPtr->lcuTotalCount, EB_N_PTR);
 	for (lcuIndex = 0; lcuIndex < objectPtr->lcuTotalCount; ++lcuIndex){
 
-		EB_MALLOC(OisCu8Results_t*, objectPtr->oisCu8Results[lcuIndex], sizeof(OisCu8Results_t), EB_N_PTR);
+		OisCu8Results_t *oisCu8Results = &objectPtr->oisCu8ResultsBuffer[lcuIndex * LCU_OIS_CU8_STRIDE];
 
-		OisCandidate_t* contigousCand;
-		EB_MALLOC(OisCandidate_t*, contigousCand, sizeof(OisCandidate_t) * maxOisCand * 64, EB_N_PTR);
-
-		EB_U32 cuIdx;
 		for (cuIdx = 0; cuIdx < 64; ++cuIdx){
-			objectPtr->oisCu8Results[lcuIndex]->sortedOisCandidate[cuIdx] = &contigousCand[cuIdx*maxOisCand];
+			oisCu8Results->sortedOisCandidate[cuIdx] = &contigousCand[lcuIndex * candStride + cuIdx * maxOisCand];
 		}
+		objectPtr->oisCu8Results[lcuIndex] = oisCu8Results;
 	}
 
 
@@ -819,9 +875,10 @@ EB_ERRORTYPE PictureParentControlSetCtor(
     objectPtr->maxNumberOfMeCandidatesPerPU =   3;
    
 
+	EB_ALLIGN_MALLOC(MeCuResults_t*, objectPtr->meResultsBuffer, sizeof(MeCuResults_t) * LCU_ME_RESULTS_STRIDE * objectPtr->lcuTotalCount, EB_A_PTR);
 	EB_MALLOC(MeCuResults_t**, objectPtr->meResults, sizeof(MeCuResults_t*) * objectPtr->lcuTotalCount, EB_N_PTR);
 	for (lcuIndex = 0; lcuIndex < objectPtr->lcuTotalCount; ++lcuIndex) {
-		EB_MALLOC(MeCuResults_t*, objectPtr->meResults[lcuIndex], sizeof(MeCuResults_t) * 85, EB_N_PTR);
+		objectPtr->meResults[lcuIndex] = &objectPtr->meResultsBuffer[lcuIndex * LCU_ME_RESULTS_STRIDE];
 	}
 
 	EB_MALLOC(EB_U32*, objectPtr->rcMEdistortion, sizeof(EB_U32) * objectPtr->lcuTotalCount, EB_N_PTR);
@@ -843,6 +900,9 @@ EB_ERRORTYPE PictureParentControlSetCtor(
 
     EB_MALLOC(EB_U8*, objectPtr->nonMovingIndexArray, sizeof(EB_U8) * objectPtr->lcuTotalCount, EB_N_PTR);
 
+    // CRF temporal importance delta QP array
+    EB_MALLOC(EB_S8*, objectPtr->propagateDeltaQpArray, sizeof(EB_S8) * objectPtr->lcuTotalCount, EB_N_PTR);
+
     // similar Colocated Lcu array
     EB_MALLOC(EB_BOOL*, objectPtr->similarColocatedLcuArray, sizeof(EB_BOOL) * objectPtr->lcuTotalCount, EB_N_PTR);
 
@@ -861,9 +921,10 @@ EB_ERRORTYPE PictureParentControlSetCtor(
 	EB_MALLOC(EB_BOOL*, objectPtr->uncoveredAreaLcuFlag, sizeof(EB_BOOL) * objectPtr->lcuTotalCount, EB_N_PTR);
     EB_MALLOC(EB_BOOL*, objectPtr->lcuHomogeneousAreaArray, sizeof(EB_BOOL) * objectPtr->lcuTotalCount, EB_N_PTR);
     
+    EB_ALLIGN_MALLOC(EB_U64*, objectPtr->varOfVar32x32BasedLcuBuffer, sizeof(EB_U64) * LCU_VAR_OF_VAR_STRIDE * objectPtr->lcuTotalCount, EB_A_PTR);
     EB_MALLOC(EB_U64**, objectPtr->varOfVar32x32BasedLcuArray, sizeof(EB_U64*) * objectPtr->lcuTotalCount, EB_N_PTR);
     for(lcuIndex = 0; lcuIndex < objectPtr->lcuTotalCount; ++lcuIndex) {       
-        EB_MALLOC(EB_U64*, objectPtr->varOfVar32x32BasedLcuArray[lcuIndex], sizeof(EB_U64) * 4, EB_N_PTR);
+        objectPtr->varOfVar32x32BasedLcuArray[lcuIndex] = &objectPtr->varOfVar32x32BasedLcuBuffer[lcuIndex * LCU_VAR_OF_VAR_STRIDE];
     }
     EB_MALLOC(EB_U8*, objectPtr->cmplxStatusLcu, sizeof(EB_U8) * objectPtr->lcuTotalCount, EB_N_PTR); 
     EB_MALLOC(EB_BOOL*, objectPtr->lcuIsolatedNonHomogeneousAreaArray, sizeof(EB_BOOL) * objectPtr->lcuTotalCount, EB_N_PTR);
@@ -885,6 +946,8 @@ EB_ERRORTYPE PictureParentControlSetCtor(
     EB_MALLOC(EB_LCU_COMPLEXITY_STATUS*, objectPtr->complexLcuArray, sizeof(EB_LCU_COMPLEXITY_STATUS) * objectPtr->lcuTotalCount, EB_N_PTR);
 
     EB_CREATEMUTEX(EB_HANDLE, objectPtr->rcDistortionHistogramMutex, sizeof(EB_HANDLE), EB_MUTEX);
+    EB_CREATEMUTEX(EB_HANDLE, objectPtr->paSegmentsMutex, sizeof(EB_HANDLE), EB_MUTEX);
+    EB_CREATESEMAPHORE(EB_HANDLE, objectPtr->paSegmentsReadySemaphore, sizeof(EB_HANDLE), EB_SEMAPHORE, 0, objectPtr->lcuTotalCount);
     
 
     EB_MALLOC(EB_LCU_DEPTH_MODE*, objectPtr->lcuMdModeArray, sizeof(EB_LCU_DEPTH_MODE) * objectPtr->lcuTotalCount, EB_N_PTR);
@@ -32,6 +32,20 @@ extern "C" {
 #define MAX_NUMBER_OF_REGIONS_IN_WIDTH		4
 #define MAX_NUMBER_OF_REGIONS_IN_HEIGHT		4
 
+// Per-LCU statistics strides (in elements), rounded up to a whole number of cache lines.
+// The stride is a multiple of the element count that fills a whole number of lines,
+// 64 / gcd(sizeof(type), 64), so it holds for types whose size does not divide a line
+#define LCU_STATS_SIZE_ALIGN(type)          ((sizeof(type) & (0 - sizeof(type))) < EB_ARENA_CACHE_LINE_SIZE ? (sizeof(type) & (0 - sizeof(type))) : EB_ARENA_CACHE_LINE_SIZE)
+#define LCU_STATS_LINE_ELEMENTS(type)       (EB_ARENA_CACHE_LINE_SIZE / LCU_STATS_SIZE_ALIGN(type))
+#define LCU_STATS_STRIDE(count, type)       ((((count) + LCU_STATS_LINE_ELEMENTS(type) - 1) / LCU_STATS_LINE_ELEMENTS(type)) * LCU_STATS_LINE_ELEMENTS(type))
+#define LCU_VARIANCE_STRIDE                 LCU_STATS_STRIDE(MAX_ME_PU_COUNT, EB_U16)
+#define LCU_Y_MEAN_STRIDE                   LCU_STATS_STRIDE(MAX_ME_PU_COUNT, EB_U8)
+#define LCU_CHROMA_MEAN_STRIDE              LCU_STATS_STRIDE(21, EB_U8)
+#define LCU_VAR_OF_VAR_STRIDE               LCU_STATS_STRIDE(4, EB_U64)
+#define LCU_ME_RESULTS_STRIDE               LCU_STATS_STRIDE(MAX_ME_PU_COUNT, MeCuResults_t)
+#define LCU_OIS_CU32_CU16_STRIDE            LCU_STATS_STRIDE(1, OisCu32Cu16Results_t)
+#define LCU_OIS_CU8_STRIDE                  LCU_STATS_STRIDE(1, OisCu8Results_t)
+
 #define MAX_REF_QP_NUM                      52
 
 // Segment Macros
@@ -173,11 +187,25 @@ typedef struct PictureControlSet_s
     EB_HANDLE                             entropyCodingPicMutex;
     EB_BOOL                               entropyCodingPicResetFlag;
 
+    // Wavefront Parallel Processing (one entropy substream per LCU row)
+    EntropyCoder_t                      **wppEntropyCoderPtrArray;
+    ContextModelEncContext_t             *wppContextModelArray;         // CABAC contexts stored after the 2nd LCU of each row
+    EB_HANDLE                            *wppRowProgressSemaphoreArray; // posted once per entropy coded LCU of each row
+    EB_U8                                 wppPrevCodedQp[MAX_LCU_ROWS];
+    EB_U8                                 wppPrevQuantGroupCodedQp[MAX_LCU_ROWS];
+
     EB_HANDLE                             intraMutex;
     EB_U32                                intraCodedArea;
     EB_BOOL                               resetDone;
     EB_U32                                encDecCodedLcuCount;
 
+    // Post-filter (SAO application and reference padding) LCU row tasks
+    EB_BOOL                               postFilterSaoFlag;
+    EB_U16                                postFilterNextRow;            // LCU rows post-filtered from the top of the picture
+    EB_BOOL                               postFilterBusyFlag;           // a row task of the picture is queued or running
+    EB_U32                               *lcuRowCodedCountArray;        // LCUs coded (and deblocked) per LCU row
+    EB_U8                                *saoRowLastLineArray[3];       // unfiltered last line of the last filtered LCU row, per component
+
     // Mode Decision Config
     MdcLcuData_t                         *mdcLcuArray;
 
@@ -459,10 +487,18 @@ typedef struct PictureParentControlSet_s
 	EB_U8                               **cbMean;
 	EB_U8                               **crMean;
 
+    // Contiguous per-LCU statistics, lcuIndex * LCU_xxx_STRIDE. The per-LCU pointer
+    // tables above are aliases into them, kept for the kernels that take one LCU's row
+    EB_U16                               *varianceBuffer;
+    EB_U8                                *yMeanBuffer;
+    EB_U8                                *cbMeanBuffer;
+    EB_U8                                *crMeanBuffer;
+
 	EB_U16                                picAvgVariance;
 
     // Histograms
 	EB_U32                            ****pictureHistogram;
+    EB_U32                               *pictureHistogramBuffer;                    // [width region][height region][component][bin]
 
 	EB_U64								  averageIntensityPerRegion[MAX_NUMBER_OF_REGIONS_IN_WIDTH][MAX_NUMBER_OF_REGIONS_IN_HEIGHT][3];
     
@@ -472,12 +508,21 @@ typedef struct PictureParentControlSet_s
     EB_U8                                 meSegmentsRowCount;
     EB_U64                                meSegmentsCompletionMask;
 
+    // Picture Analysis segments; the first segment task runs the picture
+    // pre-processing, the last one to complete gathers the picture statistics
+    EB_U16                                paSegmentsTotalCount;
+    EB_U16                                paSegmentsCompletionCount;
+    EB_BOOL                               paSegmentsStartedFlag;
+    EB_HANDLE                             paSegmentsMutex;
+    EB_HANDLE                             paSegmentsReadySemaphore;
+
     // Motion Estimation Results
     EB_U8                                 maxNumberOfPusPerLcu;
     EB_U8                                 maxNumberOfMeCandidatesPerPU;
 
 
-	MeCuResults_t						**meResults;
+	MeCuResults_t						**meResults;                                 // alias of meResultsBuffer per LCU
+    MeCuResults_t                        *meResultsBuffer;                           // lcuIndex * LCU_ME_RESULTS_STRIDE
 	EB_U32								 *rcMEdistortion;
 
     // Motion Estimation Distortion and OIS Historgram 
@@ -493,8 +538,10 @@ typedef struct PictureParentControlSet_s
 
     // Open loop Intra candidate Search Results
 
-	OisCu32Cu16Results_t                **oisCu32Cu16Results;
-	OisCu8Results_t                     **oisCu8Results;
+	OisCu32Cu16Results_t                **oisCu32Cu16Results;                        // alias of oisCu32Cu16ResultsBuffer per LCU
+	OisCu8Results_t                     **oisCu8Results;                             // alias of oisCu8ResultsBuffer per LCU
+    OisCu32Cu16Results_t                 *oisCu32Cu16ResultsBuffer;                  // lcuIndex * LCU_OIS_CU32_CU16_STRIDE
+    OisCu8Results_t                      *oisCu8ResultsBuffer;                       // lcuIndex * LCU_OIS_CU8_STRIDE
 
     // Dynamic GOP
     EB_PRED                               predStructure;
@@ -515,6 +562,9 @@ typedef struct PictureParentControlSet_s
 	EB_U8                                *zzCostArray; 
 	// Non moving index array
 	EB_U8                                *nonMovingIndexArray; 
+	// CRF temporal importance: picture delta QP, and LCU delta QPs around it
+	EB_S8                                 propagateDeltaQp;
+	EB_S8                                *propagateDeltaQpArray;
 
 	EB_BOOL								  isPan;
 	EB_BOOL								  isTilt;
@@ -539,6 +589,7 @@ typedef struct PictureParentControlSet_s
     EB_BOOL                              *lcuHomogeneousAreaArray;		                // used by EncDecProcess()  
     EB_BOOL                               logoPicFlag;				                    // used by EncDecProcess()  
     EB_U64                              **varOfVar32x32BasedLcuArray;	                // used by ModeDecisionConfigurationProcess()- the variance of 8x8 block variances for each 32x32 block	 	 
+    EB_U64                               *varOfVar32x32BasedLcuBuffer;               // lcuIndex * LCU_VAR_OF_VAR_STRIDE
     EB_BOOL                              *lcuCmplxContrastArray;			            // used by EncDecProcess()
                                        
                                        
@@ -636,6 +687,7 @@ typedef struct PictureControlSetInitData_s
     EB_U16                           tileColumnCount;
 
     EB_BOOL                          segmentOvEnabled;
+    EB_BOOL                          enableWppFlag;
 } PictureControlSetInitData_t;
 
 /**************************************
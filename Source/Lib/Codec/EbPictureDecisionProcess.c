@@ -763,7 +763,7 @@ void* PictureDecisionKernel(void *inputPtr)
             encodeContextPtr->preAssignmentBufferIdrCount           += pictureControlSetPtr->idrFlag;
             encodeContextPtr->preAssignmentBufferCount              += 1;
 
-            if (sequenceControlSetPtr->staticConfig.rateControlMode)
+            if (sequenceControlSetPtr->staticConfig.rateControlMode == 1)
             {
                 // Increment the Intra Period Position
                 encodeContextPtr->intraPeriodPosition = (encodeContextPtr->intraPeriodPosition == (EB_U32)sequenceControlSetPtr->intraPeriodLength) ?
@@ -349,7 +349,7 @@ EB_ERRORTYPE PictureFullDistortion_R(
     // Y
     if (componentMask & PICTURE_BUFFER_DESC_Y_FLAG) {
 
-		FullDistortionIntrinsic_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)][countNonZeroCoeffs[0] != 0][mode == INTRA_MODE][areaSize>>3](
+		FullDistortionIntrinsic_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][countNonZeroCoeffs[0] != 0][mode == INTRA_MODE][areaSize>>3](
             &(((EB_S16*) coeff->bufferY)[coeffLumaOriginIndex]),
             coeff->strideY,
             &(((EB_S16*) reconCoeff->bufferY)[coeffLumaOriginIndex]),
@@ -362,7 +362,7 @@ EB_ERRORTYPE PictureFullDistortion_R(
     // Cb
     if (componentMask & PICTURE_BUFFER_DESC_Cb_FLAG) {
 
-		FullDistortionIntrinsic_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)][countNonZeroCoeffs[1] != 0][mode == INTRA_MODE][chromaAreaSize >> 3](
+		FullDistortionIntrinsic_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][countNonZeroCoeffs[1] != 0][mode == INTRA_MODE][chromaAreaSize >> 3](
             &(((EB_S16*) coeff->bufferCb)[coeffChromaOriginIndex]),
             coeff->strideCb,
             &(((EB_S16*) reconCoeff->bufferCb)[coeffChromaOriginIndex]),
@@ -375,7 +375,7 @@ EB_ERRORTYPE PictureFullDistortion_R(
     // Cr
     if (componentMask & PICTURE_BUFFER_DESC_Cr_FLAG) {
 
-		FullDistortionIntrinsic_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)][countNonZeroCoeffs[2] != 0][mode == INTRA_MODE][chromaAreaSize >> 3](
+		FullDistortionIntrinsic_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][countNonZeroCoeffs[2] != 0][mode == INTRA_MODE][chromaAreaSize >> 3](
             &(((EB_S16*) coeff->bufferCr)[coeffChromaOriginIndex]),
             coeff->strideCr,
             &(((EB_S16*) reconCoeff->bufferCr)[coeffChromaOriginIndex]),
@@ -411,7 +411,7 @@ EB_ERRORTYPE PictureFullDistortionLuma(
     lumaDistortion[1]   = 0;
 
     // Y
-	FullDistortionIntrinsic_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)][countNonZeroCoeffsY != 0][mode == INTRA_MODE][areaSize >> 3](
+	FullDistortionIntrinsic_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][countNonZeroCoeffsY != 0][mode == INTRA_MODE][areaSize >> 3](
         &(((EB_S16*) coeff->bufferY)[coeffLumaOriginIndex]),
         coeff->strideY,
         &(((EB_S16*) reconCoeff->bufferY)[reconCoeffLumaOriginIndex]),
@@ -520,11 +520,7 @@ void UnPack2D(
     EB_U32       height
     )
 {
-#ifndef NON_AVX512_SUPPORT
-    UnPack2D_funcPtrArray_16Bit[((width & 3) == 0) && ((height & 1)== 0)][!!(ASM_TYPES & AVX512_MASK)](
-#else
-    UnPack2D_funcPtrArray_16Bit[((width & 3) == 0) && ((height & 1) == 0)][!!(ASM_TYPES & AVX2_MASK)](
-#endif
+    UnPack2D_funcPtrArray_16Bit[((width & 3) == 0) && ((height & 1) == 0)][AVX512_SLOT(!!(ASM_TYPES & AVX2_MASK))](
         in16BitBuffer,
         inStride,
         out8BitBuffer,
@@ -10,6 +10,7 @@
 #include "EbPictureOperators_SSE2.h"
 #include "EbPictureOperators_SSE4_1.h"
 #include "EbPictureOperators_AVX2.h"
+#include "EbPictureOperators_AVX512.h"
 #include "EbHmCode.h"
 #include "EbDefinitions.h"
 #include "EbPictureBufferDesc.h"
@@ -506,7 +507,7 @@ static EB_ZEROCOEFF_TYPE FUNC_TABLE PicZeroOutCoef_funcPtrArray[EB_ASM_TYPE_TOTA
         },
 };
 
-static EB_FULLDIST_TYPE FUNC_TABLE FullDistortionIntrinsic_funcPtrArray[EB_ASM_TYPE_TOTAL][2][2][9] = {
+static EB_FULLDIST_TYPE FUNC_TABLE FullDistortionIntrinsic_funcPtrArray[EB_ASM_AVX512_TYPE_TOTAL][2][2][9] = {
     // C_DEFAULT
     // It was found that the SSE2 intrinsic code is much faster (~2x) than the SSE4.1 code
     {
@@ -612,6 +613,59 @@ static EB_FULLDIST_TYPE FUNC_TABLE FullDistortionIntrinsic_funcPtrArray[EB_ASM_T
             }
         }
     },
+#ifndef NON_AVX512_SUPPORT
+    // AVX512
+    {
+        {
+            {
+                /*0 4x4   */    FullDistortionKernelCbfZero4x4_32bit_BT_SSE2,
+                /*1 8x8   */    FullDistortionKernelCbfZero8x8_32bit_BT_SSE2,
+                /*2 16x16 */    FullDistortionKernelCbfZero16MxN_32bit_BT_SSE2,
+                /*3       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*4 32x32 */    FullDistortionKernelCbfZero32MxN_32bit_AVX512,
+                /*5       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*6       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*7       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*8 64x64 */    FullDistortionKernelCbfZero32MxN_32bit_AVX512,
+            },
+            {
+                /*0 4x4   */    FullDistortionKernelCbfZero4x4_32bit_BT_SSE2,
+                /*1 8x8   */    FullDistortionKernelCbfZero8x8_32bit_BT_SSE2,
+                /*2 16x16 */    FullDistortionKernelCbfZero16MxN_32bit_BT_SSE2,
+                /*3       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*4 32x32 */    FullDistortionKernelCbfZero32MxN_32bit_AVX512,
+                /*5       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*6       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*7       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*8 64x64 */    FullDistortionKernelCbfZero32MxN_32bit_AVX512,
+            }
+        },
+        {
+            {
+                /*0 4x4   */    FullDistortionKernel4x4_32bit_BT_SSE2,
+                /*1 8x8   */    FullDistortionKernel8x8_32bit_BT_SSE2,
+                /*2 16x16 */    FullDistortionKernel16MxN_32bit_BT_SSE2,
+                /*3       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*4 32x32 */    FullDistortionKernel32MxN_32bit_AVX512,
+                /*5       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*6       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*7       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*8 64x64 */    FullDistortionKernel32MxN_32bit_AVX512,
+            },
+            {
+                /*0 4x4   */    FullDistortionKernelIntra4x4_32bit_BT_SSE2,
+                /*1 8x8   */    FullDistortionKernelIntra8x8_32bit_BT_SSE2,
+                /*2 16x16 */    FullDistortionKernelIntra16MxN_32bit_BT_SSE2,
+                /*3       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*4 32x32 */    FullDistortionKernelIntra32MxN_32bit_AVX512,
+                /*5       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*6       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*7       */    (EB_FULLDIST_TYPE)FullDistortionVoidFunc,
+                /*8 64x64 */    FullDistortionKernelIntra32MxN_32bit_AVX512,
+            }
+        }
+    },
+#endif
 };
 
 static EB_SATD_TYPE FUNC_TABLE Compute8x8Satd_funcPtrArray[EB_ASM_TYPE_TOTAL] = {
@@ -665,6 +719,30 @@ static EB_SPATIALFULLDIST_TYPE FUNC_TABLE SpatialFullDistortionKernel_funcPtrArr
     },
 };
 
+extern void Decimation2D(
+    EB_U8   *inputSamples,
+    EB_U32   inputStride,
+    EB_U32   inputAreaWidth,
+    EB_U32   inputAreaHeight,
+    EB_U8   *decimSamples,
+    EB_U32   decimStride,
+    EB_U32   decimStep);
+
+typedef void(*EB_DECIMATION2D_TYPE)(
+    EB_U8   *inputSamples,
+    EB_U32   inputStride,
+    EB_U32   inputAreaWidth,
+    EB_U32   inputAreaHeight,
+    EB_U8   *decimSamples,
+    EB_U32   decimStride,
+    EB_U32   decimStep);
+
+static EB_DECIMATION2D_TYPE FUNC_TABLE Decimation2D_funcPtrArray[EB_ASM_TYPE_TOTAL] = {
+    // C_DEFAULT
+    Decimation2D,
+    // ASM_AVX2
+    Decimation2D_SSE2_INTRIN
+};
 
 
 
@@ -4,6 +4,7 @@
 */
 
 #include <stdlib.h>
+#include <math.h>
 
 #include "EbDefinitions.h"
 #include "EbRateControlProcess.h"
@@ -189,16 +190,148 @@ static void RateControlLayerResetPart2(
     
 }
 
+/*****************************************************
+* RcPassPictureBits
+*   Bits the first pass predicts for one picture when the
+*   base layer is coded at baseQp, with the QP offsets of
+*   the high level rate control
+*****************************************************/
+static EB_U64 RcPassPictureBits(
+    const EB_H265_ENC_CONFIGURATION *config,
+    const EB_H265_RC_STATS          *statsPtr,
+    EB_U32                           baseQp)
+{
+    EB_S32 qp = (EB_S32)baseQp + QP_OFFSET_LAYER_ARRAY[config->hierarchicalLevels][statsPtr->temporalLayerIndex];
+
+    if (statsPtr->sliceType == EB_I_PICTURE) {
+        qp = MAX(qp + RC_INTRA_QP_OFFSET, 0);
+    }
+    qp = CLIP3((EB_S32)config->minQpAllowed, (EB_S32)config->maxQpAllowed, qp);
+
+    return (EB_U64)statsPtr->predictedBits[qp] + 1;
+}
+
+/*****************************************************
+* RcPassTitleQp
+*   Base layer QP at which the predicted bits of the whole
+*   title come closest to the target rate
+*****************************************************/
+static EB_U32 RcPassTitleQp(
+    const EB_H265_ENC_CONFIGURATION *config)
+{
+    EB_U64 targetBits = (EB_U64)((double)config->targetBitRate * config->rcStatsInCount * (1 << 16) / MAX(config->frameRate, 1));
+    EB_U64 minBitDistance = ~0ull;
+    EB_U32 titleQp = config->minQpAllowed;
+    EB_U32 baseQp;
+    EB_U32 pictureIndex;
+
+    for (baseQp = config->minQpAllowed; baseQp <= config->maxQpAllowed; ++baseQp) {
+        EB_U64 titleBits = 0;
+
+        for (pictureIndex = 0; pictureIndex < config->rcStatsInCount; ++pictureIndex) {
+            titleBits += RcPassPictureBits(config, &config->rcStatsIn[pictureIndex], baseQp);
+        }
+        if ((EB_U64)ABS((EB_S64)titleBits - (EB_S64)targetBits) < minBitDistance) {
+            minBitDistance = (EB_U64)ABS((EB_S64)titleBits - (EB_S64)targetBits);
+            titleQp = baseQp;
+        }
+    }
+
+    return titleQp;
+}
+
+/*****************************************************
+* RcPassPeriodWeight
+*   Weight of the pictures firstPicture to lastPicture - 1.
+*   A period gets bits in inverse proportion to how fast its
+*   predicted bits fall with the QP above the title QP, so
+*   that a bit buys the same PSNR everywhere when the PSNR
+*   falls linearly with the QP
+*****************************************************/
+static double RcPassPeriodWeight(
+    const EB_H265_ENC_CONFIGURATION *config,
+    EB_U32                           firstPicture,
+    EB_U32                           lastPicture,
+    EB_U32                           titleQp)
+{
+    EB_U32 highQp = MIN(titleQp + RC_PASS_SLOPE_QP_RANGE, config->maxQpAllowed);
+    EB_U32 lowQp = MAX(highQp, config->minQpAllowed + RC_PASS_SLOPE_QP_RANGE) - RC_PASS_SLOPE_QP_RANGE;
+    EB_U64 lowQpBits = 0;
+    EB_U64 highQpBits = 0;
+    EB_U32 pictureIndex;
+    double bitSlope;
+
+    for (pictureIndex = firstPicture; pictureIndex < lastPicture; ++pictureIndex) {
+        lowQpBits += RcPassPictureBits(config, &config->rcStatsIn[pictureIndex], lowQp);
+        highQpBits += RcPassPictureBits(config, &config->rcStatsIn[pictureIndex], highQp);
+    }
+    bitSlope = log((double)lowQpBits / (double)highQpBits);
+
+    // The QP range collapses on the allowed QP bounds, every period then weighs the same
+    return bitSlope > 0 ? 1 / bitSlope : 1;
+}
+
 static EB_ERRORTYPE HighLevelRateControlContextCtor(
-    HighLevelRateControlContext_t   **entryDblPtr){
+    HighLevelRateControlContext_t   **entryDblPtr,
+    const EB_H265_ENC_CONFIGURATION  *config){
 
     HighLevelRateControlContext_t *entryPtr;
+    EB_U32 pictureIndex;
     EB_MALLOC(HighLevelRateControlContext_t*, entryPtr, sizeof(HighLevelRateControlContext_t), EB_N_PTR);
     *entryDblPtr = entryPtr;
 
+    // The first pass statistics are only read here, the application may free them after EbInitEncoder
+    entryPtr->passWeightCount = 0;
+    entryPtr->passWeightPrefix = (EB_U64*)EB_NULL;
+    if (config->rcPass == 2) {
+        // The pictures of one intra period share its weight
+        EB_U32 titleQp = RcPassTitleQp(config);
+        EB_U32 periodLength = config->intraPeriodLength >= 0 ? (EB_U32)config->intraPeriodLength + 1 : config->lookAheadDistance + 1;
+        EB_U32 firstPicture;
+
+        EB_MALLOC(EB_U64*, entryPtr->passWeightPrefix, sizeof(EB_U64) * (config->rcStatsInCount + 1), EB_N_PTR);
+        entryPtr->passWeightPrefix[0] = 0;
+        for (firstPicture = 0; firstPicture < config->rcStatsInCount; firstPicture += periodLength) {
+            EB_U32 lastPicture = MIN(firstPicture + periodLength, config->rcStatsInCount);
+            EB_U64 pictureWeight = (EB_U64)(RcPassPeriodWeight(config, firstPicture, lastPicture, titleQp) * (1 << 20));
+
+            for (pictureIndex = firstPicture; pictureIndex < lastPicture; ++pictureIndex) {
+                entryPtr->passWeightPrefix[pictureIndex + 1] = entryPtr->passWeightPrefix[pictureIndex] + pictureWeight;
+            }
+        }
+        entryPtr->passWeightCount = config->rcStatsInCount;
+    }
+
     return EB_ErrorNone;
 }
 
+/*****************************************************
+* RcPassBitConstraintPerSw
+*   Splits the channel rate by the first pass weights: the
+*   sliding window gets its share of the average picture
+*   weight. Pictures past the statistics count as average.
+*****************************************************/
+static EB_U64 RcPassBitConstraintPerSw(
+    HighLevelRateControlContext_t   *highLevelRateControlPtr,
+    EB_U64                           firstPicture,
+    EB_U64                           frameCount)
+{
+    EB_U64 *prefix = highLevelRateControlPtr->passWeightPrefix;
+    EB_U64  count = highLevelRateControlPtr->passWeightCount;
+    EB_U64  lastPicture = firstPicture + frameCount;
+    double  averageWeight = (double)prefix[count] / count;
+    double  windowWeight = 0;
+
+    if (firstPicture < count) {
+        windowWeight += (double)(prefix[MIN(lastPicture, count)] - prefix[firstPicture]);
+    }
+    if (lastPicture > count) {
+        windowWeight += (double)(lastPicture - MAX(firstPicture, count)) * averageWeight;
+    }
+
+    return (EB_U64)((double)highLevelRateControlPtr->channelBitRatePerFrame * windowWeight / averageWeight);
+}
+
 
 EB_ERRORTYPE RateControlLayerContextCtor(
     RateControlLayerContext_t   **entryDblPtr){
@@ -276,7 +409,8 @@ EB_ERRORTYPE RateControlContextCtor(
     RateControlContext_t   **contextDblPtr,
     EbFifo_t                *rateControlInputTasksFifoPtr,
     EbFifo_t                *rateControlOutputResultsFifoPtr,
-    EB_S32                   intraPeriodLength)
+    EB_S32                   intraPeriodLength,
+    const EB_H265_ENC_CONFIGURATION *config)
 {
     EB_U32 temporalIndex;
     EB_U32 intervalIndex;
@@ -296,7 +430,8 @@ EB_ERRORTYPE RateControlContextCtor(
 
     // High level RC
     return_error = HighLevelRateControlContextCtor(
-        &contextPtr->highLevelRateControlPtr);
+        &contextPtr->highLevelRateControlPtr,
+        config);
     if (return_error == EB_ErrorInsufficientResources){
         return EB_ErrorInsufficientResources;
     }
@@ -343,6 +478,7 @@ EB_ERRORTYPE RateControlContextCtor(
     contextPtr->extraBits = 0;
     contextPtr->extraBitsGen = 0;
     contextPtr->maxRateAdjustDeltaQP = 0;
+    contextPtr->parameterUpdateCount = 0;
 
     return EB_ErrorNone;
 }
@@ -542,7 +678,15 @@ static void HighLevelRcInputPictureMode2(
                 highLevelRateControlPtr->predBitsRefQpPerSw[refQpTableIndex] = 0;
             }
 
-            bitConstraintPerSw = highLevelRateControlPtr->bitConstraintPerSw * pictureControlSetPtr->framesInSw / (sequenceControlSetPtr->staticConfig.lookAheadDistance + 1);
+            if (highLevelRateControlPtr->passWeightCount) {
+                bitConstraintPerSw = RcPassBitConstraintPerSw(
+                    highLevelRateControlPtr,
+                    pictureControlSetPtr->pictureNumber,
+                    pictureControlSetPtr->framesInSw);
+            }
+            else {
+                bitConstraintPerSw = highLevelRateControlPtr->bitConstraintPerSw * pictureControlSetPtr->framesInSw / (sequenceControlSetPtr->staticConfig.lookAheadDistance + 1);
+            }
 
             // Update the target rate for the sliding window based on the status of RC    
             if ((contextPtr->extraBitsGen >(EB_S64)(contextPtr->virtualBufferSize * 10))){
@@ -2172,6 +2316,62 @@ static void HighLevelRcFeedBackPicture(
     }
 }
 
+/*****************************************************
+* VbvHistogramQueueUpdate
+*   Keeps the histogram queue of the lookahead when the high level rate
+*   control does not run, i.e. the VBV model of CRF. Retires the entries
+*   out of every sliding window, then releases the window of the picture.
+*****************************************************/
+static void VbvHistogramQueueUpdate(
+    PictureParentControlSet_t         *pictureControlSetPtr,
+    SequenceControlSet_t              *sequenceControlSetPtr,
+    EncodeContext_t                   *encodeContextPtr)
+{
+    HlRateControlHistogramEntry_t      *hlRateControlHistogramPtrTemp;
+    EB_U32                             queueEntryIndexHeadTemp;
+    EB_U32                             queueEntryIndexTemp;
+    EB_U32                             queueEntryIndexTemp2;
+    EB_BOOL                            endOfSequenceFlag = EB_FALSE;
+
+    EbBlockOnMutex(encodeContextPtr->hlRateControlHistorgramQueueMutex);
+
+    hlRateControlHistogramPtrTemp = encodeContextPtr->hlRateControlHistorgramQueue[encodeContextPtr->hlRateControlHistorgramQueueHeadIndex];
+    while ((hlRateControlHistogramPtrTemp->lifeCount == 0) && hlRateControlHistogramPtrTemp->passedToHlrc){
+
+        // Reset the Reorder Queue Entry
+        hlRateControlHistogramPtrTemp->pictureNumber += INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH;
+        hlRateControlHistogramPtrTemp->lifeCount = -1;
+        hlRateControlHistogramPtrTemp->passedToHlrc = EB_FALSE;
+        hlRateControlHistogramPtrTemp->isCoded = EB_FALSE;
+        hlRateControlHistogramPtrTemp->totalNumBitsCoded = 0;
+
+        // Increment the Reorder Queue head Ptr
+        encodeContextPtr->hlRateControlHistorgramQueueHeadIndex =
+            (encodeContextPtr->hlRateControlHistorgramQueueHeadIndex == HIGH_LEVEL_RATE_CONTROL_HISTOGRAM_QUEUE_MAX_DEPTH - 1) ? 0 : encodeContextPtr->hlRateControlHistorgramQueueHeadIndex + 1;
+        hlRateControlHistogramPtrTemp = encodeContextPtr->hlRateControlHistorgramQueue[encodeContextPtr->hlRateControlHistorgramQueueHeadIndex];
+    }
+
+    queueEntryIndexHeadTemp = (EB_S32)(pictureControlSetPtr->pictureNumber - encodeContextPtr->hlRateControlHistorgramQueue[encodeContextPtr->hlRateControlHistorgramQueueHeadIndex]->pictureNumber);
+    queueEntryIndexHeadTemp += encodeContextPtr->hlRateControlHistorgramQueueHeadIndex;
+    queueEntryIndexHeadTemp = (queueEntryIndexHeadTemp > HIGH_LEVEL_RATE_CONTROL_HISTOGRAM_QUEUE_MAX_DEPTH - 1) ?
+        queueEntryIndexHeadTemp - HIGH_LEVEL_RATE_CONTROL_HISTOGRAM_QUEUE_MAX_DEPTH :
+        queueEntryIndexHeadTemp;
+
+    queueEntryIndexTemp = queueEntryIndexHeadTemp;
+    while (!endOfSequenceFlag &&
+        queueEntryIndexTemp <= queueEntryIndexHeadTemp + sequenceControlSetPtr->staticConfig.lookAheadDistance){
+
+        queueEntryIndexTemp2 = (queueEntryIndexTemp > HIGH_LEVEL_RATE_CONTROL_HISTOGRAM_QUEUE_MAX_DEPTH - 1) ? queueEntryIndexTemp - HIGH_LEVEL_RATE_CONTROL_HISTOGRAM_QUEUE_MAX_DEPTH : queueEntryIndexTemp;
+        hlRateControlHistogramPtrTemp = encodeContextPtr->hlRateControlHistorgramQueue[queueEntryIndexTemp2];
+        hlRateControlHistogramPtrTemp->lifeCount--;
+
+        endOfSequenceFlag = hlRateControlHistogramPtrTemp->endOfSequenceFlag;
+        queueEntryIndexTemp++;
+    }
+
+    EbReleaseMutex(encodeContextPtr->hlRateControlHistorgramQueueMutex);
+}
+
 static EB_U64 predictBits(SequenceControlSet_t *sequenceControlSetPtr,
         EncodeContext_t *encodeContextPtr,
         HlRateControlHistogramEntry_t *hlRateControlHistogramPtrTemp, EB_U32 qp)
@@ -2317,6 +2517,66 @@ static EB_U8 Vbv_Buf_Calc(PictureControlSet_t *pictureControlSetPtr,
 	return (EB_U8)q;
 }
 
+/*****************************************************
+* RateControlUpdateTargets
+*   Moves the rate targets to the bit rate and VBV of a sequence control set
+*   updated with EbH265EncUpdateParameter. The virtual buffer levels and the
+*   layer bit constraints of the intervals are scaled with the bit rate so
+*   the buffer keeps its fullness; the VBV fill is clipped to the new size.
+*   The intervals not started yet are reset from the new rate anyway.
+*****************************************************/
+static void RateControlUpdateTargets(
+    RateControlContext_t    *contextPtr,
+    SequenceControlSet_t    *sequenceControlSetPtr,
+    EncodeContext_t         *encodeContextPtr)
+{
+    HighLevelRateControlContext_t *highLevelRateControlPtr = contextPtr->highLevelRateControlPtr;
+    double                         rateRatio = (double)sequenceControlSetPtr->staticConfig.targetBitRate / (double)MAX(1, highLevelRateControlPtr->targetBitRate);
+    EB_U32                         intervalIndex;
+    EB_U32                         temporalLayerIndex;
+
+    highLevelRateControlPtr->targetBitRate          = sequenceControlSetPtr->staticConfig.targetBitRate;
+    highLevelRateControlPtr->channelBitRatePerFrame = (EB_U64)MAX((EB_S64)1, (EB_S64)((highLevelRateControlPtr->targetBitRate << RC_PRECISION) / highLevelRateControlPtr->frameRate));
+    highLevelRateControlPtr->channelBitRatePerSw    = highLevelRateControlPtr->channelBitRatePerFrame * (sequenceControlSetPtr->staticConfig.lookAheadDistance + 1);
+    highLevelRateControlPtr->bitConstraintPerSw     = highLevelRateControlPtr->channelBitRatePerSw;
+#if RC_UPDATE_TARGET_RATE
+    highLevelRateControlPtr->previousUpdatedBitConstraintPerSw = highLevelRateControlPtr->channelBitRatePerSw;
+#endif
+
+    contextPtr->virtualBufferSize               = (((EB_U64)sequenceControlSetPtr->staticConfig.targetBitRate * 3) << RC_PRECISION) / (contextPtr->frameRate);
+    contextPtr->virtualBufferLevelInitialValue  = contextPtr->virtualBufferSize >> 1;
+    contextPtr->virtualBufferLevel              = (EB_S64)(contextPtr->virtualBufferLevel * rateRatio);
+    contextPtr->previousVirtualBufferLevel      = (EB_S64)(contextPtr->previousVirtualBufferLevel * rateRatio);
+    contextPtr->vbFillThreshold1                = (contextPtr->virtualBufferSize * 6) >> 3;
+    contextPtr->vbFillThreshold2                = (contextPtr->virtualBufferSize << 3) >> 3;
+    contextPtr->extraBits                       = (EB_S64)(contextPtr->extraBits * rateRatio);
+
+    for (intervalIndex = 0; intervalIndex < PARALLEL_GOP_MAX_NUMBER; ++intervalIndex) {
+        RateControlIntervalParamContext_t *rateControlParamPtr = contextPtr->rateControlParamQueue[intervalIndex];
+        rateControlParamPtr->virtualBufferLevel         = (EB_S64)(rateControlParamPtr->virtualBufferLevel * rateRatio);
+        rateControlParamPtr->previousVirtualBufferLevel = (EB_S64)(rateControlParamPtr->previousVirtualBufferLevel * rateRatio);
+        for (temporalLayerIndex = 0; temporalLayerIndex < EB_MAX_TEMPORAL_LAYERS; ++temporalLayerIndex) {
+            RateControlLayerContext_t *rateControlLayerPtr = rateControlParamPtr->rateControlLayerArray[temporalLayerIndex];
+            rateControlLayerPtr->targetBitRate          = (EB_U64)(rateControlLayerPtr->targetBitRate * rateRatio);
+            rateControlLayerPtr->channelBitRate         = (EB_U64)MAX(1, (EB_S64)(rateControlLayerPtr->channelBitRate * rateRatio));
+            rateControlLayerPtr->previousBitConstraint  = (EB_U64)(rateControlLayerPtr->previousBitConstraint * rateRatio);
+            rateControlLayerPtr->bitConstraint          = (EB_U64)(rateControlLayerPtr->bitConstraint * rateRatio);
+            rateControlLayerPtr->ecBitConstraint        = (EB_U64)MAX(1, (EB_S64)(rateControlLayerPtr->ecBitConstraint * rateRatio));
+        }
+    }
+
+    EbBlockOnMutex(encodeContextPtr->bufferFillMutex);
+    if (encodeContextPtr->vbvBufsize == 0) {
+        encodeContextPtr->bufferFill = (EB_U64)(sequenceControlSetPtr->staticConfig.vbvBufsize * sequenceControlSetPtr->staticConfig.vbvBufInit / 100);
+    }
+    encodeContextPtr->vbvMaxrate = sequenceControlSetPtr->staticConfig.vbvMaxrate;
+    encodeContextPtr->vbvBufsize = sequenceControlSetPtr->staticConfig.vbvBufsize;
+    encodeContextPtr->bufferFill = MIN(encodeContextPtr->bufferFill, (EB_U64)encodeContextPtr->vbvBufsize);
+    EbReleaseMutex(encodeContextPtr->bufferFillMutex);
+
+    contextPtr->parameterUpdateCount = sequenceControlSetPtr->parameterUpdateCount;
+}
+
 void* RateControlKernel(void *inputPtr)
 {
     // Context
@@ -2419,8 +2679,17 @@ void* RateControlKernel(void *inputPtr)
                 contextPtr->baseLayerIntraFramesAvgQp       = sequenceControlSetPtr->qp;
                 encodeContextPtr->vbvMaxrate                = sequenceControlSetPtr->staticConfig.vbvMaxrate;
                 encodeContextPtr->vbvBufsize                = sequenceControlSetPtr->staticConfig.vbvBufsize;
+                contextPtr->parameterUpdateCount            = sequenceControlSetPtr->parameterUpdateCount;
             }
-            if (sequenceControlSetPtr->staticConfig.rateControlMode)
+            // Pictures reach rate control in decode order, the first one coded
+            // with an updated sequence control set moves the targets
+            else if (sequenceControlSetPtr->parameterUpdateCount > contextPtr->parameterUpdateCount) {
+                RateControlUpdateTargets(
+                    contextPtr,
+                    sequenceControlSetPtr,
+                    encodeContextPtr);
+            }
+            if (sequenceControlSetPtr->staticConfig.rateControlMode == 1)
             {
                 pictureControlSetPtr->ParentPcsPtr->intraSelectedOrgQp = 0;
                 HighLevelRcInputPictureMode2(
@@ -2431,9 +2700,15 @@ void* RateControlKernel(void *inputPtr)
                     contextPtr->highLevelRateControlPtr);
 
 			}
+            else if (sequenceControlSetPtr->rateStatisticsFlag && sequenceControlSetPtr->staticConfig.lookAheadDistance != 0) {
+                VbvHistogramQueueUpdate(
+                    pictureControlSetPtr->ParentPcsPtr,
+                    sequenceControlSetPtr,
+                    encodeContextPtr);
+            }
 			
             // Frame level RC
-            if (sequenceControlSetPtr->intraPeriodLength == -1 || sequenceControlSetPtr->staticConfig.rateControlMode == 0){
+            if (sequenceControlSetPtr->intraPeriodLength == -1 || sequenceControlSetPtr->staticConfig.rateControlMode != 1){
                 rateControlParamPtr = contextPtr->rateControlParamQueue[0];
                 prevGopRateControlParamPtr = contextPtr->rateControlParamQueue[0];
                 nextGopRateControlParamPtr = contextPtr->rateControlParamQueue[0];
@@ -2472,8 +2747,9 @@ void* RateControlKernel(void *inputPtr)
 
             // ***Rate Control***
             //SVT_LOG("\nRate Control Thread %d\n", (int)  pictureControlSetPtr->ParentPcsPtr->pictureNumber);
-            if (sequenceControlSetPtr->staticConfig.rateControlMode == 0){
+            if (sequenceControlSetPtr->staticConfig.rateControlMode != 1){
                 // if RC mode is 0,  fixed QP is used                   
+                // if RC mode is 2,  the CRF is used as the fixed QP and moved by the temporal importance
                 // QP scaling based on POC number for Flat IPPP structure
 
                 if (sequenceControlSetPtr->enableQpScalingFlag && pictureControlSetPtr->ParentPcsPtr->qpOnTheFly == EB_FALSE){
@@ -2494,6 +2770,11 @@ void* RateControlKernel(void *inputPtr)
                     pictureControlSetPtr->pictureQp = (EB_U8)CLIP3((EB_S32)sequenceControlSetPtr->staticConfig.minQpAllowed, (EB_S32)sequenceControlSetPtr->staticConfig.maxQpAllowed,pictureControlSetPtr->ParentPcsPtr->pictureQp);
                 }
 
+                if (sequenceControlSetPtr->staticConfig.rateControlMode == 2 && pictureControlSetPtr->ParentPcsPtr->qpOnTheFly == EB_FALSE) {
+                    pictureControlSetPtr->pictureQp = (EB_U8)CLIP3((EB_S32)sequenceControlSetPtr->staticConfig.minQpAllowed,
+                        (EB_S32)sequenceControlSetPtr->staticConfig.maxQpAllowed,
+                        (EB_S32)pictureControlSetPtr->pictureQp + pictureControlSetPtr->ParentPcsPtr->propagateDeltaQp);
+                }
             }
             else{
                     FrameLevelRcInputPictureMode2(
@@ -2601,7 +2882,11 @@ void* RateControlKernel(void *inputPtr)
             if (encodeContextPtr->vbvMaxrate && encodeContextPtr->vbvBufsize && sequenceControlSetPtr->staticConfig.lookAheadDistance > 0)
             {
                 EbBlockOnMutex(encodeContextPtr->bufferFillMutex);
-                pictureControlSetPtr->pictureQp = (EB_U8)Vbv_Buf_Calc(pictureControlSetPtr, sequenceControlSetPtr, encodeContextPtr);
+                // The VBV only caps CRF, it never lowers the QP below the CRF one
+                if (sequenceControlSetPtr->staticConfig.rateControlMode == 2)
+                    pictureControlSetPtr->pictureQp = MAX(pictureControlSetPtr->pictureQp, Vbv_Buf_Calc(pictureControlSetPtr, sequenceControlSetPtr, encodeContextPtr));
+                else
+                    pictureControlSetPtr->pictureQp = (EB_U8)Vbv_Buf_Calc(pictureControlSetPtr, sequenceControlSetPtr, encodeContextPtr);
 
                 EbReleaseMutex(encodeContextPtr->bufferFillMutex);
             }
@@ -2636,6 +2921,11 @@ void* RateControlKernel(void *inputPtr)
 
                 lcuPtr = pictureControlSetPtr->lcuPtrArray[lcuCodingOrder];
                 lcuPtr->qp = (EB_U8)pictureControlSetPtr->pictureQp;
+                if (sequenceControlSetPtr->staticConfig.rateControlMode == 2) {
+                    lcuPtr->qp = (EB_U8)CLIP3((EB_S32)sequenceControlSetPtr->staticConfig.minQpAllowed,
+                        (EB_S32)sequenceControlSetPtr->staticConfig.maxQpAllowed,
+                        (EB_S32)pictureControlSetPtr->pictureQp + pictureControlSetPtr->ParentPcsPtr->propagateDeltaQpArray[lcuCodingOrder]);
+                }
                 pictureControlSetPtr->ParentPcsPtr->averageQp += lcuPtr->qp;
             }
             pictureControlSetPtr->ParentPcsPtr->averageQp = pictureControlSetPtr->ParentPcsPtr->averageQp / lcuTotalCount;
@@ -2667,7 +2957,7 @@ void* RateControlKernel(void *inputPtr)
             sequenceControlSetPtr = (SequenceControlSet_t*)parentPictureControlSetPtr->sequenceControlSetWrapperPtr->objectPtr;
 
             // Frame level RC
-            if (sequenceControlSetPtr->intraPeriodLength == -1 || sequenceControlSetPtr->staticConfig.rateControlMode == 0){
+            if (sequenceControlSetPtr->intraPeriodLength == -1 || sequenceControlSetPtr->staticConfig.rateControlMode != 1){
                 rateControlParamPtr = contextPtr->rateControlParamQueue[0];
                 prevGopRateControlParamPtr = contextPtr->rateControlParamQueue[0];
                 if (parentPictureControlSetPtr->sliceType == EB_I_PICTURE){
@@ -2707,7 +2997,7 @@ void* RateControlKernel(void *inputPtr)
                     contextPtr->rateControlParamQueue[intervalIndexTemp - 1];
 
             }
-            if (sequenceControlSetPtr->staticConfig.rateControlMode != 0){
+            if (sequenceControlSetPtr->staticConfig.rateControlMode == 1){
 
                 contextPtr->previousVirtualBufferLevel = contextPtr->virtualBufferLevel;
 
@@ -2737,6 +3027,12 @@ void* RateControlKernel(void *inputPtr)
                 }
 
             }
+            else if (sequenceControlSetPtr->rateStatisticsFlag) {
+                // The VBV model of CRF predicts the coded pictures with their actual rate
+                HighLevelRcFeedBackPicture(
+                    parentPictureControlSetPtr,
+                    sequenceControlSetPtr);
+            }
 
             // Queue variables
 #if OVERSHOOT_STAT_PRINT
@@ -2857,6 +3153,11 @@ void* RateControlKernel(void *inputPtr)
 
 			// Release the SequenceControlSet
 			EbReleaseObject(parentPictureControlSetPtr->sequenceControlSetWrapperPtr);
+            // Hand zero-copy planes back to the application
+            if (sequenceControlSetPtr->staticConfig.zeroCopyInput && parentPictureControlSetPtr->enhancedPicturePtr->appBufferPtr) {
+                sequenceControlSetPtr->staticConfig.inputReleaseCallback((EB_BUFFERHEADERTYPE*)parentPictureControlSetPtr->enhancedPicturePtr->appBufferPtr);
+                parentPictureControlSetPtr->enhancedPicturePtr->appBufferPtr = EB_NULL;
+            }
             // Release the input buffer
             EbReleaseObject(parentPictureControlSetPtr->ebInputWrapperPtr);
             // Release the ParentPictureControlSet
@@ -30,6 +30,7 @@ extern "C" {
 
 #define ADAPTIVE_PERCENTAGE 1
 #define     RC_INTRA_QP_OFFSET              (-1)
+#define     RC_PASS_SLOPE_QP_RANGE          6
 
 #define     RC_DISABLE_FLRC                 0
 #define     RC_DISABLE_FLRC_RATE_UPDATE     0
@@ -231,6 +232,10 @@ typedef struct HighLevelRateControlContext_s
     EB_U32                       prevIntraOrgSelectedRefQp;
     EB_U64                       previousUpdatedBitConstraintPerSw;
 #endif
+
+    // Second rate control pass: running sum of the first pass picture weights
+    EB_U64                      *passWeightPrefix;
+    EB_U64                       passWeightCount;
     
 
 } HighLevelRateControlContext_t;
@@ -285,7 +290,9 @@ typedef struct RateControlContext_s
     EB_S64                       extraBits;  
     EB_S64                       extraBitsGen;
     EB_S16                      maxRateAdjustDeltaQP;
-   
+
+    // Sequence control set parameterUpdateCount the rate targets were derived from
+    EB_U32                       parameterUpdateCount;
    
 } RateControlContext_t;
 
@@ -314,7 +321,8 @@ extern EB_ERRORTYPE RateControlContextCtor(
     RateControlContext_t   **contextDblPtr,
     EbFifo_t                *rateControlInputTasksFifoPtr,
     EbFifo_t                *rateControlOutputResultsFifoPtr,
-    EB_S32                   intraPeriodLength);
+    EB_S32                   intraPeriodLength,
+    const EB_H265_ENC_CONFIGURATION *config);
     
    
     
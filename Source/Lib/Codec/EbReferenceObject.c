@@ -8,6 +8,7 @@
 
 #include "EbPictureBufferDesc.h"
 #include "EbReferenceObject.h"
+#include "EbThreads.h"
 
 void EbHevcInitializeSamplesNeighboringReferencePicture16Bit(
     EB_BYTE  reconSamplesBufferPtr,
@@ -187,6 +188,14 @@ EB_ERRORTYPE EbReferenceObjectCtor(
     // Allocate LCU based TMVP map
     EB_MALLOC(TmvpUnit_t *, referenceObject->tmvpMap, (sizeof(TmvpUnit_t) * (((pictureBufferDescInitDataPtr->maxWidth + (64 - 1)) >> 6) * ((pictureBufferDescInitDataPtr->maxHeight + (64 - 1)) >> 6))), EB_N_PTR);
 
+    // LCU based statistics, sized for the configured resolution
+    {
+        EB_U32 lcuTotalCount = ((pictureBufferDescInitDataPtr->maxWidth + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE) *
+                               ((pictureBufferDescInitDataPtr->maxHeight + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE);
+        EB_MALLOC(EB_U8*, referenceObject->intraCodedAreaLCU, sizeof(EB_U8) * lcuTotalCount, EB_N_PTR);
+        EB_MALLOC(EB_U8*, referenceObject->nonMovingIndexArray, sizeof(EB_U8) * lcuTotalCount, EB_N_PTR);
+    }
+
     //RESTRICT THIS TO M4
     {
         EbPictureBufferDescInitData_t bufDesc;
@@ -209,9 +218,87 @@ EB_ERRORTYPE EbReferenceObjectCtor(
             return EB_ErrorInsufficientResources;
     }
 
+    // Sub-picture reference row progress
+    referenceObject->availableLcuRowCount = 0;
+    referenceObject->lcuRowTotalCount = (EB_U16)((pictureBufferDescInitDataPtr->maxHeight + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE);
+    EB_MALLOC(EB_U32*, referenceObject->rowWaiterCountArray, sizeof(EB_U32) * referenceObject->lcuRowTotalCount, EB_N_PTR);
+    EB_MALLOC(EB_HANDLE*, referenceObject->rowSemaphoreArray, sizeof(EB_HANDLE) * referenceObject->lcuRowTotalCount, EB_N_PTR);
+    for (EB_U16 rowIndex = 0; rowIndex < referenceObject->lcuRowTotalCount; ++rowIndex) {
+        referenceObject->rowWaiterCountArray[rowIndex] = 0;
+        EB_CREATESEMAPHORE(EB_HANDLE, referenceObject->rowSemaphoreArray[rowIndex], sizeof(EB_HANDLE), EB_SEMAPHORE, 0, 0x7FFFFFFF);
+    }
+    EB_CREATEMUTEX(EB_HANDLE, referenceObject->rowProgressMutex, sizeof(EB_HANDLE), EB_MUTEX);
+
     return EB_ErrorNone;
 }
 
+/*****************************************
+ * Sub-picture reference row progress
+ *   The encoder of the reference picture posts the number of
+ *   LCU rows that are final (reconstructed, filtered and padded);
+ *   dependent pictures check or wait for the rows their MVs can reach.
+ *   Waiters block on the semaphore of the row they need, so every
+ *   post only wakes threads whose requirement is met.
+ *****************************************/
+void EbReferenceObjectResetRowProgress(
+    EbReferenceObject_t *referenceObject)
+{
+    EbBlockOnMutex(referenceObject->rowProgressMutex);
+    referenceObject->availableLcuRowCount = 0;
+    EbReleaseMutex(referenceObject->rowProgressMutex);
+}
+
+void EbReferenceObjectPostRowProgress(
+    EbReferenceObject_t *referenceObject,
+    EB_U16               availableLcuRowCount)
+{
+    EB_U16 rowIndex;
+
+    availableLcuRowCount = MIN(availableLcuRowCount, referenceObject->lcuRowTotalCount);
+
+    EbBlockOnMutex(referenceObject->rowProgressMutex);
+    for (rowIndex = referenceObject->availableLcuRowCount; rowIndex < availableLcuRowCount; ++rowIndex) {
+        while (referenceObject->rowWaiterCountArray[rowIndex]) {
+            --referenceObject->rowWaiterCountArray[rowIndex];
+            EbPostSemaphore(referenceObject->rowSemaphoreArray[rowIndex]);
+        }
+    }
+    if (availableLcuRowCount > referenceObject->availableLcuRowCount) {
+        referenceObject->availableLcuRowCount = availableLcuRowCount;
+    }
+    EbReleaseMutex(referenceObject->rowProgressMutex);
+}
+
+EB_BOOL EbReferenceObjectRowsAvailable(
+    EbReferenceObject_t *referenceObject,
+    EB_U16               lcuRowCount)
+{
+    EB_BOOL available;
+
+    EbBlockOnMutex(referenceObject->rowProgressMutex);
+    available = (referenceObject->availableLcuRowCount >= lcuRowCount) ? EB_TRUE : EB_FALSE;
+    EbReleaseMutex(referenceObject->rowProgressMutex);
+
+    return available;
+}
+
+void EbReferenceObjectWaitRowProgress(
+    EbReferenceObject_t *referenceObject,
+    EB_U16               lcuRowCount)
+{
+    lcuRowCount = MIN(lcuRowCount, referenceObject->lcuRowTotalCount);
+
+    EbBlockOnMutex(referenceObject->rowProgressMutex);
+    if (lcuRowCount == 0 || referenceObject->availableLcuRowCount >= lcuRowCount) {
+        EbReleaseMutex(referenceObject->rowProgressMutex);
+        return;
+    }
+    ++referenceObject->rowWaiterCountArray[lcuRowCount - 1];
+    EbReleaseMutex(referenceObject->rowProgressMutex);
+
+    EbBlockOnSemaphore(referenceObject->rowSemaphoreArray[lcuRowCount - 1]);
+}
+
 /*****************************************
  * EbPaReferenceObjectCtor
  *  Initializes the Buffer Descriptor's
@@ -255,5 +342,13 @@ EB_ERRORTYPE EbPaReferenceObjectCtor(
             return EB_ErrorInsufficientResources;
         }
 
+    // LCU based statistics, sized for the configured resolution
+    {
+        EB_U32 lcuTotalCount = ((pictureBufferDescInitDataPtr->maxWidth + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE) *
+                               ((pictureBufferDescInitDataPtr->maxHeight + MAX_LCU_SIZE - 1) / MAX_LCU_SIZE);
+        EB_MALLOC(EB_U16*, paReferenceObject->variance, sizeof(EB_U16) * lcuTotalCount, EB_N_PTR);
+        EB_MALLOC(EB_U8*, paReferenceObject->yMean, sizeof(EB_U8) * lcuTotalCount, EB_N_PTR);
+    }
+
     return EB_ErrorNone;
 }
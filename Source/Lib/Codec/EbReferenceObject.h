@@ -26,8 +26,8 @@ typedef struct EbReferenceObject_s {
 
 	EB_U8                          intraCodedArea;//percentage of intra coded area 0-100%
 
-	EB_U8                          intraCodedAreaLCU[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//percentage of intra coded area 0-100%
-	EB_U32                         nonMovingIndexArray[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//array to hold non-moving blocks in reference frames
+	EB_U8                         *intraCodedAreaLCU;//percentage of intra coded area 0-100%, one per LCU of the picture
+	EB_U8                         *nonMovingIndexArray;//array to hold non-moving blocks in reference frames, one per LCU of the picture
 	EB_U32                         picSampleValue[MAX_NUMBER_OF_REGIONS_IN_WIDTH][MAX_NUMBER_OF_REGIONS_IN_HEIGHT][3];// [Y U V];
 
 	EB_BOOL                        penalizeSkipflag;
@@ -37,6 +37,13 @@ typedef struct EbReferenceObject_s {
 	EB_U16                         picAvgVariance;
     EB_U8                          averageIntensity;
 
+    // Sub-picture reference availability
+    EB_U16                         availableLcuRowCount;   // LCU rows reconstructed, filtered and padded
+    EB_U16                         lcuRowTotalCount;
+    EB_U32                        *rowWaiterCountArray;    // threads waiting for rowIndex + 1 rows
+    EB_HANDLE                     *rowSemaphoreArray;
+    EB_HANDLE                      rowProgressMutex;
+
 } EbReferenceObject_t;
 
 typedef struct EbReferenceObjectDescInitData_s {
@@ -47,8 +54,8 @@ typedef struct EbPaReferenceObject_s {
     EbPictureBufferDesc_t          *inputPaddedPicturePtr;
     EbPictureBufferDesc_t          *quarterDecimatedPicturePtr; 
     EbPictureBufferDesc_t          *sixteenthDecimatedPicturePtr;
-	EB_U16                         variance[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
-	EB_U8                          yMean[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
+	EB_U16                        *variance;    // 64x64 variance, one per LCU of the picture
+	EB_U8                         *yMean;       // 64x64 luma mean, one per LCU of the picture
 	EB_PICTURE                       sliceType;
 
 	EB_U32 dependentPicturesCount; //number of pic using this reference frame  
@@ -72,6 +79,21 @@ extern EB_ERRORTYPE EbPaReferenceObjectCtor(
     EB_PTR *objectDblPtr, 
     EB_PTR objectInitDataPtr);
 
+extern void EbReferenceObjectResetRowProgress(
+    EbReferenceObject_t *referenceObject);
+
+extern void EbReferenceObjectPostRowProgress(
+    EbReferenceObject_t *referenceObject,
+    EB_U16               availableLcuRowCount);
+
+extern EB_BOOL EbReferenceObjectRowsAvailable(
+    EbReferenceObject_t *referenceObject,
+    EB_U16               lcuRowCount);
+
+extern void EbReferenceObjectWaitRowProgress(
+    EbReferenceObject_t *referenceObject,
+    EB_U16               lcuRowCount);
+
 #ifdef __cplusplus
 }
 #endif
@@ -85,6 +85,55 @@ EB_ERRORTYPE ResourceCoordinationContextCtor(
     return EB_ErrorNone;
 }
 
+/************************************************
+ * Switch the Active Sequence Control Set
+ *   Moves the instance to a copy of the active sequence control set that
+ *   carries the parameters of EbH265EncUpdateParameter the input was sent
+ *   with. The pictures already taken keep the previous set, it goes back to
+ *   the pool once they are done.
+ ************************************************/
+static void SwitchSequenceControlSet(
+    ResourceCoordinationContext_t   *contextPtr,
+    EB_U32                           instanceIndex,
+    EB_U32                           parameterUpdateCount)
+{
+    EbObjectWrapper_t       *previousWrapperPtr = contextPtr->sequenceControlSetActiveArray[instanceIndex];
+    SequenceControlSet_t    *previousPtr        = (SequenceControlSet_t*)previousWrapperPtr->objectPtr;
+    SequenceControlSet_t    *activePtr;
+
+    // Get empty SequenceControlSet [BLOCKING]
+    EbGetEmptyObject(
+        contextPtr->sequenceControlSetEmptyFifoPtr,
+        &contextPtr->sequenceControlSetActiveArray[instanceIndex]);
+
+    // Held as long as the set is the active one
+    EbObjectIncLiveCount(
+        contextPtr->sequenceControlSetActiveArray[instanceIndex],
+        1);
+
+    activePtr = (SequenceControlSet_t*)contextPtr->sequenceControlSetActiveArray[instanceIndex]->objectPtr;
+
+    // Same copy as for the first picture, plus the state derived from it.
+    // The LCU parameters are read only once set, the first set keeps them
+    CopySequenceControlSet(
+        activePtr,
+        previousPtr);
+    activePtr->lcuParamsArray  = previousPtr->lcuParamsArray;
+    activePtr->inputResolution = previousPtr->inputResolution;
+
+    LoadDynamicParameters(
+        activePtr,
+        contextPtr->sequenceControlSetInstanceArray[instanceIndex],
+        parameterUpdateCount);
+
+    // Speed control starts over from the new preset
+    if (activePtr->staticConfig.speedControlFlag && activePtr->staticConfig.encMode != previousPtr->staticConfig.encMode) {
+        activePtr->encodeContextPtr->encMode = (EB_ENC_MODE)activePtr->staticConfig.encMode;
+    }
+
+    EbReleaseObject(previousWrapperPtr);
+}
+
 //******************************************************************************//
 // Modify the Enc mode based on the buffer Status
 // Inputs: TargetSpeed, Status of the SCbuffer
@@ -365,6 +414,9 @@ void* ResourceCoordinationKernel(void *inputPtr)
     EB_BUFFERHEADERTYPE             *ebInputPtr;
     EbObjectWrapper_t               *outputWrapperPtr;
     ResourceCoordinationResults_t   *outputResultsPtr;
+    EbObjectWrapper_t               *analysisPictureWrapperPtr;
+    PictureParentControlSet_t       *analysisPicturePtr;
+    EB_U32                           segmentIndex;
 
     EbObjectWrapper_t               *inputPictureWrapperPtr;
     EbPictureBufferDesc_t           *inputPicturePtr;
@@ -453,21 +505,39 @@ void* ResourceCoordinationKernel(void *inputPtr)
                 (SequenceControlSet_t*) contextPtr->sequenceControlSetActiveArray[instanceIndex]->objectPtr,
                 sequenceControlSetPtr);
 
+            // The input may have been sent before EbH265EncUpdateParameter calls
+            LoadDynamicParameters(
+                (SequenceControlSet_t*) contextPtr->sequenceControlSetActiveArray[instanceIndex]->objectPtr,
+                contextPtr->sequenceControlSetInstanceArray[instanceIndex],
+                ((EbPictureBufferDesc_t*)ebInputPtr->pBuffer)->parameterUpdateCount);
+
+            // Held as long as the set is the active one
+            EbObjectIncLiveCount(
+                contextPtr->sequenceControlSetActiveArray[instanceIndex],
+                1);
+        }
+        // Inputs sent after an EbH265EncUpdateParameter call carry its count
+        else if (((EbPictureBufferDesc_t*)ebInputPtr->pBuffer)->parameterUpdateCount > ((SequenceControlSet_t*)contextPtr->sequenceControlSetActiveArray[instanceIndex]->objectPtr)->parameterUpdateCount) {
+            SwitchSequenceControlSet(
+                contextPtr,
+                instanceIndex,
+                ((EbPictureBufferDesc_t*)ebInputPtr->pBuffer)->parameterUpdateCount);
         }
         EbReleaseMutex(contextPtr->sequenceControlSetInstanceArray[instanceIndex]->configMutex);
-        if (sequenceControlSetPtr->staticConfig.rateControlMode) {
+        // The count released in the PictureManager after receiving the reference is added by the
+        //   PictureManager itself, for reference pictures only
+        if (sequenceControlSetPtr->staticConfig.rateControlMode == 1) {
             // Sequence Control Set is released by Rate Control after passing through MDC->MD->ENCDEC->Packetization->RateControl
-            //   ,in the PictureManager after receiving the reference and in PictureManager after receiving the feedback
+            //   and in PictureManager after receiving the feedback
             EbObjectIncLiveCount(
                 contextPtr->sequenceControlSetActiveArray[instanceIndex],
-                3);
+                2);
         }
         else {
             // Sequence Control Set is released by Rate Control after passing through MDC->MD->ENCDEC->Packetization->RateControl
-            //   and in the PictureManager
             EbObjectIncLiveCount(
                 contextPtr->sequenceControlSetActiveArray[instanceIndex],
-                2);
+                1);
 
         }
         // Set the current SequenceControlSet
@@ -588,7 +658,7 @@ void* ResourceCoordinationKernel(void *inputPtr)
 
 	    // Rate Control
 		// Set the ME Distortion and OIS Historgrams to zero
-        if (sequenceControlSetPtr->staticConfig.rateControlMode){
+        if (sequenceControlSetPtr->staticConfig.rateControlMode == 1){
 	            EB_MEMSET(pictureControlSetPtr->meDistortionHistogram, 0, NUMBER_OF_SAD_INTERVALS*sizeof(EB_U16));
 	            EB_MEMSET(pictureControlSetPtr->oisDistortionHistogram, 0, NUMBER_OF_INTRA_SAD_INTERVALS*sizeof(EB_U16));
         }
@@ -649,18 +719,32 @@ void* ResourceCoordinationKernel(void *inputPtr)
             if (prevPictureControlSetWrapperPtr && prevPictureControlSetWrapperPtr->objectPtr)
                 ((PictureParentControlSet_t *)prevPictureControlSetWrapperPtr->objectPtr)->endOfSequenceFlag = endOfSequenceFlag;
 
-            EbGetEmptyObject(
-                    contextPtr->resourceCoordinationResultsOutputFifoPtr,
-                    &outputWrapperPtr);
-            outputResultsPtr = (ResourceCoordinationResults_t *)outputWrapperPtr->objectPtr;
             if (endOfSequenceFlag && (pictureControlSetPtr->pictureNumber == 0)) {
                 ((PictureParentControlSet_t *)pictureControlSetWrapperPtr->objectPtr)->endOfSequenceFlag = endOfSequenceFlag;
-                outputResultsPtr->pictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
+                analysisPictureWrapperPtr = pictureControlSetWrapperPtr;
             } else
-                outputResultsPtr->pictureControlSetWrapperPtr = prevPictureControlSetWrapperPtr;
-
-            // Post the finished Results Object
-            EbPostFullObject(outputWrapperPtr);
+                analysisPictureWrapperPtr = prevPictureControlSetWrapperPtr;
+
+            // Initialize Picture Analysis segments
+            analysisPicturePtr = (PictureParentControlSet_t *)analysisPictureWrapperPtr->objectPtr;
+            analysisPicturePtr->paSegmentsTotalCount      = (EB_U16)MIN(sequenceControlSetPtr->paSegmentRowCount, sequenceControlSetPtr->pictureHeightInLcu);
+            analysisPicturePtr->paSegmentsCompletionCount = 0;
+            analysisPicturePtr->paSegmentsStartedFlag     = EB_FALSE;
+
+            sequenceControlSetPtr->encodeContextPtr->picturesIn++;
+
+            // Post the results to the Picture Analysis processes
+            for (segmentIndex = 0; segmentIndex < analysisPicturePtr->paSegmentsTotalCount; ++segmentIndex) {
+                EbGetEmptyObject(
+                        contextPtr->resourceCoordinationResultsOutputFifoPtr,
+                        &outputWrapperPtr);
+                outputResultsPtr = (ResourceCoordinationResults_t *)outputWrapperPtr->objectPtr;
+                outputResultsPtr->pictureControlSetWrapperPtr = analysisPictureWrapperPtr;
+                outputResultsPtr->segmentIndex = segmentIndex;
+
+                // Post the finished Results Object
+                EbPostFullObject(outputWrapperPtr);
+            }
         }
 
         prevPictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
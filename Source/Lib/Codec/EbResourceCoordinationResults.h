@@ -17,6 +17,7 @@ extern "C" {
 typedef struct ResourceCoordinationResults_s
 {
     EbObjectWrapper_t *pictureControlSetWrapperPtr;
+    EB_U32             segmentIndex;
     
 } ResourceCoordinationResults_t;
 
@@ -8,6 +8,7 @@
 
 #include "EbSampleAdaptiveOffset_C.h"
 #include "EbSampleAdaptiveOffset_SSE2.h"
+#include "EbSampleAdaptiveOffset_AVX2.h"
 #include "EbSaoApplication_SSSE3.h"
 
 #include "EbDefinitions.h"
@@ -169,12 +170,22 @@ typedef EB_ERRORTYPE(*EB_SAOGATHER_16bit_FUNC)(
 	EB_S32                   eoDiff[SAO_EO_TYPES][SAO_EO_CATEGORIES + 1],		// output parameter, used to store Edge Offset diff, eoDiff[SAO_EO_TYPES] [SAO_EO_CATEGORIES]
 	EB_U16                   eoCount[SAO_EO_TYPES][SAO_EO_CATEGORIES + 1]);		// output parameter, used to store Edge Offset count, eoCount[SAO_EO_TYPES] [SAO_EO_CATEGORIES]
 
-static const EB_SAOGATHER_16bit_FUNC SaoGatherFunctionTabl_16bit[EB_ASM_TYPE_TOTAL] = {
+static const EB_SAOGATHER_16bit_FUNC SaoGatherFunctionTabl_16bit[EB_ASM_SSE2_AVX2_TYPE_TOTAL][2] = {
 	// C_DEFAULT
-	GatherSaoStatisticsLcu_62x62_16bit,
-	// AVX2 
-	GatherSaoStatisticsLcu16bit_SSE2,
-
+	{
+		GatherSaoStatisticsLcu_62x62_16bit,
+		GatherSaoStatisticsLcu_62x62_16bit,
+	},
+	// SSE2
+	{
+		GatherSaoStatisticsLcu_62x62_16bit,
+		GatherSaoStatisticsLcu16bit_SSE2,
+	},
+	// AVX2
+	{
+		GatherSaoStatisticsLcu16bit_AVX2_INTRIN,
+		GatherSaoStatisticsLcu16bit_AVX2_INTRIN,
+	},
 };
 
 
@@ -193,17 +204,22 @@ static const EB_SAOGATHER_90_45_135_FUNC SaoGatherFunctionTableLossy_90_45_135[E
 	GatherSaoStatisticsLcu_OnlyEo_90_45_135_BT_SSE2,
 };
 
-static const EB_SAOGATHER_90_45_135_16bit_SSE2_FUNC SaoGatherFunctionTable_90_45_135_16bit_SSE2[EB_ASM_TYPE_TOTAL][2] = {
+static const EB_SAOGATHER_90_45_135_16bit_SSE2_FUNC SaoGatherFunctionTable_90_45_135_16bit_SSE2[EB_ASM_SSE2_AVX2_TYPE_TOTAL][2] = {
 	// C_DEFAULT
 	{
         GatherSaoStatisticsLcu_62x62_OnlyEo_90_45_135_16bit,
         GatherSaoStatisticsLcu_62x62_OnlyEo_90_45_135_16bit,
 	},
-	// AVX2
+	// SSE2
 	{
 		GatherSaoStatisticsLcu_62x62_OnlyEo_90_45_135_16bit,
 		GatherSaoStatisticsLcu_OnlyEo_90_45_135_16bit_SSE2_INTRIN,
 	},
+	// AVX2
+	{
+		GatherSaoStatisticsLcu_OnlyEo_90_45_135_16bit_AVX2_INTRIN,
+		GatherSaoStatisticsLcu_OnlyEo_90_45_135_16bit_AVX2_INTRIN,
+	},
 };
 
 
@@ -295,20 +311,25 @@ static const EB_SAOAPPLY_EO_135_45_FUNC SaoFunctionTableEO_135_45[EB_ASM_TYPE_TO
     },
 };
 
-static const EB_SAOAPPLY_BO_16bit_FUNC SaoFunctionTableBo_16bit[EB_ASM_TYPE_TOTAL][2] = { 
+static const EB_SAOAPPLY_BO_16bit_FUNC SaoFunctionTableBo_16bit[EB_ASM_SSE2_AVX2_TYPE_TOTAL][2] = { 
 	// C_DEFAULT
 	{
         SAOApplyBO16bit,
         SAOApplyBO16bit
 	},
-	// AVX2
+	// SSE2
 	{
 		SAOApplyBO16bit,
 		SAOApplyBO16bit_SSE2_INTRIN
 	},
+	// AVX2
+	{
+		SAOApplyBO16bit,
+		SAOApplyBO16bit_AVX2_INTRIN
+	},
 };
 
-static const EB_SAOAPPLY_EO_0_90_16bit_FUNC SaoFunctionTableEO_0_90_16bit[EB_ASM_TYPE_TOTAL][2][2] = {
+static const EB_SAOAPPLY_EO_0_90_16bit_FUNC SaoFunctionTableEO_0_90_16bit[EB_ASM_SSE2_AVX2_TYPE_TOTAL][2][2] = {
 	// C_DEFAULT
     {
         {
@@ -320,7 +341,7 @@ static const EB_SAOAPPLY_EO_0_90_16bit_FUNC SaoFunctionTableEO_0_90_16bit[EB_ASM
          SAOApplyEO_90_16bit
         }
     },
-	// AVX2
+	// SSE2
     {
         {
          SAOApplyEO_0_16bit,
@@ -331,9 +352,20 @@ static const EB_SAOAPPLY_EO_0_90_16bit_FUNC SaoFunctionTableEO_0_90_16bit[EB_ASM
          SAOApplyEO_90_16bit_SSE2_INTRIN
         }
     },
+	// AVX2
+    {
+        {
+         SAOApplyEO_0_16bit,
+         SAOApplyEO_0_16bit_AVX2_INTRIN
+        },
+        {
+         SAOApplyEO_90_16bit,
+         SAOApplyEO_90_16bit_AVX2_INTRIN
+        }
+    },
 };
 
-static const EB_SAOAPPLY_EO_135_45_16bit_FUNC SaoFunctionTableEO_135_45_16bit[EB_ASM_TYPE_TOTAL][2][2] = {
+static const EB_SAOAPPLY_EO_135_45_16bit_FUNC SaoFunctionTableEO_135_45_16bit[EB_ASM_SSE2_AVX2_TYPE_TOTAL][2][2] = {
 	// C_DEFAULT
     {
         {
@@ -345,7 +377,7 @@ static const EB_SAOAPPLY_EO_135_45_16bit_FUNC SaoFunctionTableEO_135_45_16bit[EB
             SAOApplyEO_45_16bit
         }
     },
-	// AVX2
+	// SSE2
     {
         {
 			SAOApplyEO_135_16bit,
@@ -356,6 +388,17 @@ static const EB_SAOAPPLY_EO_135_45_16bit_FUNC SaoFunctionTableEO_135_45_16bit[EB
 			SAOApplyEO_45_16bit_SSE2_INTRIN
         }
     },
+	// AVX2
+    {
+        {
+			SAOApplyEO_135_16bit,
+            SAOApplyEO_135_16bit_AVX2_INTRIN
+        },
+        {
+			SAOApplyEO_45_16bit,
+			SAOApplyEO_45_16bit_AVX2_INTRIN
+        }
+    },
 };
 
 #ifdef __cplusplus
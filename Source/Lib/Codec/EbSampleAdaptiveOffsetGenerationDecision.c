@@ -991,7 +991,7 @@ EB_ERRORTYPE SaoGenerationDecision16bit(
 		// Requirement: lcuHeight > 2
 
 		// This function is only written in C. To be implemented in ASM
-		SaoGatherFunctionTabl_16bit[((lcuWidth & 15) == 0) || (lcuWidth == 28) || (lcuWidth == 56)](
+		SaoGatherFunctionTabl_16bit[SSE2_AVX2_SLOT][((lcuWidth & 15) == 0) || (lcuWidth == 28) || (lcuWidth == 56)](
 			(EB_U16*)inputLcuPtr->bufferY,
 			inputLcuPtr->strideY,
 			(EB_U16*)(recon16->bufferY) + (recon16->originY + tbOriginY)*recon16->strideY + (recon16->originX + tbOriginX),
@@ -1004,7 +1004,7 @@ EB_ERRORTYPE SaoGenerationDecision16bit(
 			saoStats->eoCount[0]);
 
 		// U
-		SaoGatherFunctionTabl_16bit[((lcuChromaWidth & 15) == 0) || (lcuChromaWidth == 28) || (lcuChromaWidth == 56)](
+		SaoGatherFunctionTabl_16bit[SSE2_AVX2_SLOT][((lcuChromaWidth & 15) == 0) || (lcuChromaWidth == 28) || (lcuChromaWidth == 56)](
 			(EB_U16*)inputLcuPtr->bufferCb,
 			inputLcuPtr->strideCb,
 			(EB_U16*)(recon16->bufferCb) + ((((recon16->originY + tbOriginY) * recon16->strideCb) >> subHeightCMinus1) + ((recon16->originX + tbOriginX) >> subWidthCMinus1)),
@@ -1017,7 +1017,7 @@ EB_ERRORTYPE SaoGenerationDecision16bit(
 			saoStats->eoCount[1]);
 
 		// V
-		SaoGatherFunctionTabl_16bit[((lcuChromaWidth & 15) == 0) || (lcuChromaWidth == 28) || (lcuChromaWidth == 56)](
+		SaoGatherFunctionTabl_16bit[SSE2_AVX2_SLOT][((lcuChromaWidth & 15) == 0) || (lcuChromaWidth == 28) || (lcuChromaWidth == 56)](
 			(EB_U16*)inputLcuPtr->bufferCr,
 			inputLcuPtr->strideCr,
 			(EB_U16*)(recon16->bufferCr) + ((((recon16->originY + tbOriginY) * recon16->strideCb) >> subHeightCMinus1) + ((recon16->originX + tbOriginX) >> subWidthCMinus1)),
@@ -1069,7 +1069,7 @@ EB_ERRORTYPE SaoGenerationDecision16bit(
 			//; Requirement: lcuHeight > 2
 
 			{
-                SaoGatherFunctionTable_90_45_135_16bit_SSE2[!!(ASM_TYPES & PREAVX2_MASK)][((lcuWidth & 15) == 0) || (lcuWidth == 28) || (lcuWidth == 56)](
+                SaoGatherFunctionTable_90_45_135_16bit_SSE2[SSE2_AVX2_SLOT][((lcuWidth & 15) == 0) || (lcuWidth == 28) || (lcuWidth == 56)](
                     (EB_U16*)inputLcuPtr->bufferY,
                     inputLcuPtr->strideY,
                     (EB_U16*)(recon16->bufferY) + (recon16->originY + tbOriginY)*recon16->strideY + (recon16->originX + tbOriginX),
@@ -1082,7 +1082,7 @@ EB_ERRORTYPE SaoGenerationDecision16bit(
 		}
 
 		if (pictureControlSetPtr->temporalLayerIndex == 1) {
-            SaoGatherFunctionTable_90_45_135_16bit_SSE2[!!(ASM_TYPES & PREAVX2_MASK)][((lcuWidth & 15) == 0) || (lcuWidth == 28) || (lcuWidth == 56)](
+            SaoGatherFunctionTable_90_45_135_16bit_SSE2[SSE2_AVX2_SLOT][((lcuWidth & 15) == 0) || (lcuWidth == 28) || (lcuWidth == 56)](
                 (EB_U16*)inputLcuPtr->bufferY,
                 inputLcuPtr->strideY,
                 (EB_U16*)(recon16->bufferY) + (recon16->originY + tbOriginY)*recon16->strideY + (recon16->originX + tbOriginX),
@@ -56,6 +56,7 @@ EB_ERRORTYPE EbSequenceControlSetCtor(
         sequenceControlSetPtr->tileGroupColCountArray[layerIndex] = 1;
         sequenceControlSetPtr->tileGroupRowCountArray[layerIndex] = 1;
     }
+    sequenceControlSetPtr->paSegmentRowCount = 1;
     
     // Encode Context
     if(scsInitData != EB_NULL) {
@@ -168,6 +169,8 @@ EB_ERRORTYPE EbSequenceControlSetCtor(
         &sequenceControlSetPtr->unRegUserDataSeiPtr);
 
     sequenceControlSetPtr->maxDpbSize	= 0;
+
+    sequenceControlSetPtr->parameterUpdateCount = 0;
     
     return EB_ErrorNone;
 }
@@ -193,12 +196,55 @@ EB_ERRORTYPE CopySequenceControlSet(
 
     dst->enableDenoiseFlag = src->enableDenoiseFlag;
     dst->maxEncMode        = src->maxEncMode;
+    dst->parameterUpdateCount = src->parameterUpdateCount;
 
     EB_MEMCPY(&dst->activeParameterSet, &src->activeParameterSet, sizeof(AppActiveparameterSetSei_t));
 
     return EB_ErrorNone;
 }
     
+/************************************************
+ * Dynamic Parameters
+ ************************************************/
+void GetDynamicParameters(
+    DynamicParameters_t  *dst,
+    SequenceControlSet_t *src)
+{
+    dst->targetBitRate  = src->staticConfig.targetBitRate;
+    dst->vbvMaxrate     = src->staticConfig.vbvMaxrate;
+    dst->vbvBufsize     = src->staticConfig.vbvBufsize;
+    dst->maxQpAllowed   = src->staticConfig.maxQpAllowed;
+    dst->minQpAllowed   = src->staticConfig.minQpAllowed;
+    dst->encMode        = src->staticConfig.encMode;
+}
+
+// Sets dst to the parameters an input sent at parameterUpdateCount was
+// meant for. The instance set holds the current ones, the history those
+// of the previous calls; the last ones are used past the history.
+void LoadDynamicParameters(
+    SequenceControlSet_t           *dst,
+    EbSequenceControlSetInstance_t *instancePtr,
+    EB_U32                          parameterUpdateCount)
+{
+    EB_U32               currentCount = instancePtr->sequenceControlSetPtr->parameterUpdateCount;
+    DynamicParameters_t  parameters;
+
+    if (parameterUpdateCount < currentCount && currentCount - parameterUpdateCount <= PARAMETER_UPDATE_HISTORY_COUNT) {
+        parameters = instancePtr->parameterUpdateHistory[parameterUpdateCount % PARAMETER_UPDATE_HISTORY_COUNT];
+    }
+    else {
+        GetDynamicParameters(&parameters, instancePtr->sequenceControlSetPtr);
+    }
+
+    dst->staticConfig.targetBitRate = parameters.targetBitRate;
+    dst->staticConfig.vbvMaxrate    = parameters.vbvMaxrate;
+    dst->staticConfig.vbvBufsize    = parameters.vbvBufsize;
+    dst->staticConfig.maxQpAllowed  = parameters.maxQpAllowed;
+    dst->staticConfig.minQpAllowed  = parameters.minQpAllowed;
+    dst->staticConfig.encMode       = parameters.encMode;
+    dst->parameterUpdateCount       = parameterUpdateCount;
+}
+
 EB_ERRORTYPE EbSequenceControlSetInstanceCtor(
     EbSequenceControlSetInstance_t **objectDblPtr)
 {
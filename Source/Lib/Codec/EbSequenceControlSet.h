@@ -18,6 +18,25 @@ extern "C" {
 #endif
 
 
+// Parameter sets of the last EbH265EncUpdateParameter calls kept for the
+// inputs still waiting in the input queue
+#define PARAMETER_UPDATE_HISTORY_COUNT                  64
+
+/************************************
+ * Dynamic Parameters
+ *   The part of the configuration
+ *   EbH265EncUpdateParameter changes
+ ************************************/
+typedef struct DynamicParameters_s
+{
+    EB_U32                      targetBitRate;
+    EB_U32                      vbvMaxrate;
+    EB_U32                      vbvBufsize;
+    EB_U32                      maxQpAllowed;
+    EB_U32                      minQpAllowed;
+    EB_U8                       encMode;
+} DynamicParameters_t;
+
 /************************************
  * Sequence Control Set
  ************************************/
@@ -95,6 +114,8 @@ typedef struct SequenceControlSet_s
     EB_U32                      rateControlMode;
     EB_U32                      targetBitrate;
     EB_U32                      availableBandwidth;          
+    // The lookahead rate statistics, gathered for VBR and for the VBV cap of CRF
+    EB_BOOL                     rateStatisticsFlag;
     
     // Quantization
     EB_U32                      qp;
@@ -151,6 +172,7 @@ typedef struct SequenceControlSet_s
     EB_U16                     meSegmentRowCountArray[MAX_TEMPORAL_LAYERS];
     EB_U16                     encDecSegmentColCountArray[MAX_TEMPORAL_LAYERS];
     EB_U16                     encDecSegmentRowCountArray[MAX_TEMPORAL_LAYERS];
+    EB_U16                     paSegmentRowCount;
 
     // Tile Group
     EB_U16                     tileGroupColCountArray[MAX_TEMPORAL_LAYERS];
@@ -184,6 +206,9 @@ typedef struct SequenceControlSet_s
 
     EB_U32                      totalProcessInitCount;
 
+    // Cores the encoder may keep busy: affinity, cgroup CPU quota and -lp
+    EB_U32                      coreCount;
+
     LcuParams_t                *lcuParamsArray;
     EB_U8                       pictureWidthInLcu;
     EB_U8                       pictureHeightInLcu;
@@ -197,6 +222,10 @@ typedef struct SequenceControlSet_s
 
     EB_U8                       maxEncMode;
 
+    // EbH265EncUpdateParameter calls applied, resource coordination switches
+    // to a new set when the count of the instance set moves past the active one
+    EB_U32                      parameterUpdateCount;
+
     //Active parameter Set Sei
     AppActiveparameterSetSei_t  activeParameterSet;
 
@@ -212,6 +241,10 @@ typedef struct EbSequenceControlSetInstance_s
     EncodeContext_t            *encodeContextPtr;
     SequenceControlSet_t       *sequenceControlSetPtr;
     EB_HANDLE                   configMutex;
+
+    // parameterUpdateHistory[n % PARAMETER_UPDATE_HISTORY_COUNT] holds the
+    // parameters in effect while parameterUpdateCount was n
+    DynamicParameters_t         parameterUpdateHistory[PARAMETER_UPDATE_HISTORY_COUNT];
       
 } EbSequenceControlSetInstance_t;
 
@@ -231,6 +264,15 @@ extern EB_ERRORTYPE CopySequenceControlSet(
 extern EB_ERRORTYPE EbSequenceControlSetInstanceCtor(
     EbSequenceControlSetInstance_t **objectDblPtr);
 
+extern void GetDynamicParameters(
+    DynamicParameters_t             *dst,
+    SequenceControlSet_t            *src);
+
+extern void LoadDynamicParameters(
+    SequenceControlSet_t            *dst,
+    EbSequenceControlSetInstance_t  *instancePtr,
+    EB_U32                           parameterUpdateCount);
+
 extern EB_ERRORTYPE LcuParamsInit(
     SequenceControlSet_t *sequenceControlSetPtr);
 extern EB_ERRORTYPE DeriveInputResolution(
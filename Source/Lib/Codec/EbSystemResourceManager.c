@@ -7,6 +7,14 @@
 
 #include "EbSystemResourceManager.h"
 
+// Consumer fifo of the task the calling thread works on, see EbGetFullObject.
+// The thread holds a concurrency slot of its queue unless the task is suspended.
+static EB_THREAD_LOCAL EbFifo_t *taskFifoPtr;
+static EB_THREAD_LOCAL EB_U64    taskSuspendTime;
+
+// Fifos of the SystemResources the calling thread constructs, see EbSetLockFreeFifo
+static EB_THREAD_LOCAL EB_BOOL   lockFreeFifo = LOCK_FREE_FIFO;
+
 /**************************************
  * EbFifoCtor
  **************************************/
@@ -18,11 +26,18 @@ static EB_ERRORTYPE EbFifoCtor(
     EbObjectWrapper_t  *lastWrapperPtr,
     EbMuxingQueue_t    *queuePtr)
 {
-    // Create Counting Semaphore
-    EB_CREATESEMAPHORE(EB_HANDLE, fifoPtr->countingSemaphore, sizeof(EB_HANDLE), EB_SEMAPHORE, initialCount, maxCount);
+    if (queuePtr->lockFree) {
+        // The process fifos share the MuxingQueue ring and semaphore
+        fifoPtr->countingSemaphore  = (EB_HANDLE)EB_NULL;
+        fifoPtr->lockoutMutex       = (EB_HANDLE)EB_NULL;
+    }
+    else {
+        // Create Counting Semaphore
+        EB_CREATESEMAPHORE(EB_HANDLE, fifoPtr->countingSemaphore, sizeof(EB_HANDLE), EB_SEMAPHORE, initialCount, maxCount);
 
-    // Create Buffer Pool Mutex
-    EB_CREATEMUTEX(EB_HANDLE, fifoPtr->lockoutMutex, sizeof(EB_HANDLE), EB_MUTEX);
+        // Create Buffer Pool Mutex
+        EB_CREATEMUTEX(EB_HANDLE, fifoPtr->lockoutMutex, sizeof(EB_HANDLE), EB_MUTEX);
+    }
 
     // Initialize Fifo First & Last ptrs
     fifoPtr->firstPtr           = firstWrapperPtr;
@@ -201,6 +216,241 @@ static EB_ERRORTYPE EbCircularBufferPushFront(
     return return_error;
 }
 
+/**************************************
+ * EbRingBufferCtor
+ **************************************/
+static EB_ERRORTYPE EbRingBufferCtor(
+    EbRingBuffer_t      **ringDblPtr,
+    EB_U32                objectTotalCount)
+{
+    EbRingBuffer_t *ringPtr;
+    EB_U32 cellTotalCount = 1;
+    EB_U32 cellIndex;
+
+    // Round up to a power of two so that cell indices wrap with a mask
+    while (cellTotalCount < objectTotalCount) {
+        cellTotalCount <<= 1;
+    }
+
+    EB_MALLOC(EbRingBuffer_t*, ringPtr, sizeof(EbRingBuffer_t), EB_N_PTR);
+    *ringDblPtr = ringPtr;
+
+    EB_MALLOC(EbRingBufferCell_t*, ringPtr->cellArray, sizeof(EbRingBufferCell_t) * cellTotalCount, EB_N_PTR);
+
+    for (cellIndex = 0; cellIndex < cellTotalCount; ++cellIndex) {
+        ringPtr->cellArray[cellIndex].sequence  = cellIndex;
+        ringPtr->cellArray[cellIndex].objectPtr = EB_NULL;
+    }
+
+    ringPtr->cellMask       = cellTotalCount - 1;
+    ringPtr->enqueueIndex   = 0;
+    ringPtr->dequeueIndex   = 0;
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * EbRingBufferPush
+ *   The ring holds at least every object of the SystemResource, so a
+ *   producer only waits on a cell whose previous-lap consumer is still
+ *   reading it.
+ **************************************/
+static void EbRingBufferPush(
+    EbRingBuffer_t       *ringPtr,
+    EB_PTR                objectPtr)
+{
+    EbRingBufferCell_t *cellPtr;
+    EB_U32 index = EbAtomicLoad32(&ringPtr->enqueueIndex);
+    EB_S32 lapDiff;
+
+    for (;;) {
+        cellPtr = &ringPtr->cellArray[index & ringPtr->cellMask];
+        lapDiff = (EB_S32)(EbAtomicLoad32(&cellPtr->sequence) - index);
+
+        if (lapDiff == 0) {
+            if (EbAtomicCompareExchange32(&ringPtr->enqueueIndex, index, index + 1)) {
+                break;
+            }
+        }
+        else if (lapDiff < 0) {
+            EbCpuRelax();
+        }
+        index = EbAtomicLoad32(&ringPtr->enqueueIndex);
+    }
+
+    cellPtr->objectPtr = objectPtr;
+
+    // Publish the cell to the consumers
+    EbAtomicStore32(&cellPtr->sequence, index + 1);
+}
+
+/**************************************
+ * EbRingBufferPop
+ *   Returns EB_FALSE if the head cell has not been published yet.
+ **************************************/
+static EB_BOOL EbRingBufferPop(
+    EbRingBuffer_t       *ringPtr,
+    EB_PTR               *objectPtr)
+{
+    EbRingBufferCell_t *cellPtr;
+    EB_U32 index = EbAtomicLoad32(&ringPtr->dequeueIndex);
+    EB_S32 lapDiff;
+
+    for (;;) {
+        cellPtr = &ringPtr->cellArray[index & ringPtr->cellMask];
+        lapDiff = (EB_S32)(EbAtomicLoad32(&cellPtr->sequence) - (index + 1));
+
+        if (lapDiff == 0) {
+            if (EbAtomicCompareExchange32(&ringPtr->dequeueIndex, index, index + 1)) {
+                break;
+            }
+        }
+        else if (lapDiff < 0) {
+            return EB_FALSE;
+        }
+        index = EbAtomicLoad32(&ringPtr->dequeueIndex);
+    }
+
+    *objectPtr = cellPtr->objectPtr;
+
+    // Hand the cell back to the producers for the next lap
+    EbAtomicStore32(&cellPtr->sequence, index + ringPtr->cellMask + 1);
+
+    return EB_TRUE;
+}
+
+/**************************************
+ * EbMuxingQueuePost
+ *   Pushes an object on the ring and wakes a parked consumer, if any.
+ **************************************/
+static void EbMuxingQueuePost(
+    EbMuxingQueue_t      *queuePtr,
+    EbObjectWrapper_t    *wrapperPtr)
+{
+    EbRingBufferPush(
+        queuePtr->objectRing,
+        wrapperPtr);
+
+    if (EbAtomicFetchAdd32(&queuePtr->availableCount, 1) < 0) {
+        EbPostSemaphore(queuePtr->waitSemaphore);
+    }
+}
+
+/**************************************
+ * EbMuxingQueueTryClaim
+ *   Reserves one of the available objects without parking.
+ **************************************/
+static EB_BOOL EbMuxingQueueTryClaim(
+    EbMuxingQueue_t      *queuePtr)
+{
+    EB_S32 availableCount = EbAtomicLoad32(&queuePtr->availableCount);
+
+    while (availableCount > 0) {
+        if (EbAtomicCompareExchange32(&queuePtr->availableCount, availableCount, availableCount - 1)) {
+            return EB_TRUE;
+        }
+        availableCount = EbAtomicLoad32(&queuePtr->availableCount);
+    }
+
+    return EB_FALSE;
+}
+
+/**************************************
+ * EbMuxingQueueGet
+ *   Spins on the ring for EB_FIFO_SPIN_COUNT polls, then parks on the
+ *   queue semaphore until a producer hands over an object.
+ **************************************/
+static EbObjectWrapper_t* EbMuxingQueueGet(
+    EbMuxingQueue_t      *queuePtr)
+{
+    EB_PTR  objectPtr;
+    EB_BOOL claimed = EbMuxingQueueTryClaim(queuePtr);
+    EB_U32  spinCount;
+
+    for (spinCount = 0; spinCount < EB_FIFO_SPIN_COUNT && claimed == EB_FALSE; ++spinCount) {
+        EbCpuRelax();
+        claimed = EbMuxingQueueTryClaim(queuePtr);
+    }
+
+    if (claimed == EB_FALSE && EbAtomicFetchAdd32(&queuePtr->availableCount, -1) <= 0) {
+        EbBlockOnSemaphore(queuePtr->waitSemaphore);
+    }
+
+    // The claim guarantees an object has been pushed, but the head cell
+    // may belong to a producer that has not published it yet
+    while (EbRingBufferPop(queuePtr->objectRing, &objectPtr) == EB_FALSE) {
+        EbCpuRelax();
+    }
+
+    return (EbObjectWrapper_t*)objectPtr;
+}
+
+/**************************************
+ * EbMuxingQueueWakeParked
+ *   Wakes up to wakeCount parked consumers, which then retry for a slot.
+ **************************************/
+static void EbMuxingQueueWakeParked(
+    EbMuxingQueue_t      *queuePtr,
+    EB_U32                wakeCount)
+{
+    if (EbAtomicLoad32(&queuePtr->parkedCount) == 0) {
+        return;
+    }
+
+    EbBlockOnMutex(queuePtr->parkMutex);
+    while (wakeCount > 0 && queuePtr->parkedCount > 0) {
+        EbAtomicFetchAdd32(&queuePtr->parkedCount, -1);
+        EbPostSemaphore(queuePtr->parkSemaphore);
+        --wakeCount;
+    }
+    EbReleaseMutex(queuePtr->parkMutex);
+}
+
+/**************************************
+ * EbMuxingQueueAcquireSlot
+ *   Parks the consumer until fewer than activeLimit consumers hold a slot.
+ *   parkedCount is raised before activeCount is read again, and
+ *   EbMuxingQueueReleaseSlot lowers activeCount before it reads
+ *   parkedCount, so either the consumer sees the free slot or the
+ *   releaser sees the parked consumer.
+ **************************************/
+static void EbMuxingQueueAcquireSlot(
+    EbMuxingQueue_t      *queuePtr)
+{
+    EB_U32 activeCount;
+
+    for (;;) {
+        activeCount = EbAtomicLoad32(&queuePtr->activeCount);
+        if (activeCount < EbAtomicLoad32(&queuePtr->activeLimit)) {
+            if (EbAtomicCompareExchange32(&queuePtr->activeCount, activeCount, activeCount + 1)) {
+                return;
+            }
+            continue;
+        }
+
+        EbBlockOnMutex(queuePtr->parkMutex);
+        EbAtomicFetchAdd32(&queuePtr->parkedCount, 1);
+        if (EbAtomicLoad32(&queuePtr->activeCount) < EbAtomicLoad32(&queuePtr->activeLimit)) {
+            EbAtomicFetchAdd32(&queuePtr->parkedCount, -1);
+            EbReleaseMutex(queuePtr->parkMutex);
+            continue;
+        }
+        EbReleaseMutex(queuePtr->parkMutex);
+
+        EbBlockOnSemaphore(queuePtr->parkSemaphore);
+    }
+}
+
+/**************************************
+ * EbMuxingQueueReleaseSlot
+ **************************************/
+static void EbMuxingQueueReleaseSlot(
+    EbMuxingQueue_t      *queuePtr)
+{
+    EbAtomicFetchAdd32(&queuePtr->activeCount, -1);
+    EbMuxingQueueWakeParked(queuePtr, 1);
+}
+
 /**************************************
  * EbMuxingQueueCtor
  **************************************/
@@ -218,24 +468,54 @@ static EB_ERRORTYPE EbMuxingQueueCtor(
     *queueDblPtr = queuePtr;
 
     queuePtr->processTotalCount = processTotalCount;
+    queuePtr->lockFree          = lockFreeFifo;
+    queuePtr->availableCount    = 0;
+
+    if (queuePtr->lockFree) {
+        queuePtr->lockoutMutex  = (EB_HANDLE)EB_NULL;
+        queuePtr->objectQueue   = (EbCircularBuffer_t*)EB_NULL;
+        queuePtr->processQueue  = (EbCircularBuffer_t*)EB_NULL;
+
+        // Construct the Object Ring
+        return_error = EbRingBufferCtor(
+            &queuePtr->objectRing,
+            objectTotalCount);
+        if (return_error == EB_ErrorInsufficientResources){
+            return EB_ErrorInsufficientResources;
+        }
 
-    // Lockout Mutex
-    EB_CREATEMUTEX(EB_HANDLE, queuePtr->lockoutMutex, sizeof(EB_HANDLE), EB_MUTEX);
-
-    // Construct Object Circular Buffer
-    return_error = EbCircularBufferCtor(
-        &queuePtr->objectQueue,
-        objectTotalCount);
-    if (return_error == EB_ErrorInsufficientResources){
-        return EB_ErrorInsufficientResources;
+        // Parked consumers wait here
+        EB_CREATESEMAPHORE(EB_HANDLE, queuePtr->waitSemaphore, sizeof(EB_HANDLE), EB_SEMAPHORE, 0, objectTotalCount + processTotalCount);
     }
-    // Construct Process Circular Buffer
-    return_error = EbCircularBufferCtor(
-        &queuePtr->processQueue,
-        queuePtr->processTotalCount);
-    if (return_error == EB_ErrorInsufficientResources){
-        return EB_ErrorInsufficientResources;
+    else {
+        queuePtr->objectRing    = (EbRingBuffer_t*)EB_NULL;
+        queuePtr->waitSemaphore = (EB_HANDLE)EB_NULL;
+
+        // Lockout Mutex
+        EB_CREATEMUTEX(EB_HANDLE, queuePtr->lockoutMutex, sizeof(EB_HANDLE), EB_MUTEX);
+
+        // Construct Object Circular Buffer
+        return_error = EbCircularBufferCtor(
+            &queuePtr->objectQueue,
+            objectTotalCount);
+        if (return_error == EB_ErrorInsufficientResources){
+            return EB_ErrorInsufficientResources;
+        }
+        // Construct Process Circular Buffer
+        return_error = EbCircularBufferCtor(
+            &queuePtr->processQueue,
+            queuePtr->processTotalCount);
+        if (return_error == EB_ErrorInsufficientResources){
+            return EB_ErrorInsufficientResources;
+        }
     }
+    // No concurrency cap until EbSetFullObjectConcurrency
+    queuePtr->activeLimit   = processTotalCount;
+    queuePtr->activeCount   = 0;
+    queuePtr->parkedCount   = 0;
+    EB_CREATEMUTEX(EB_HANDLE, queuePtr->parkMutex, sizeof(EB_HANDLE), EB_MUTEX);
+    EB_CREATESEMAPHORE(EB_HANDLE, queuePtr->parkSemaphore, sizeof(EB_HANDLE), EB_SEMAPHORE, 0, processTotalCount);
+
     // Construct the Process Fifos
     EB_MALLOC(EbFifo_t**, queuePtr->processFifoPtrArray, sizeof(EbFifo_t*) * queuePtr->processTotalCount, EB_N_PTR);
 
@@ -354,11 +634,16 @@ EB_ERRORTYPE EbObjectReleaseEnable(
 {
     EB_ERRORTYPE return_error = EB_ErrorNone;
 
-    EbBlockOnMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+    if (wrapperPtr->systemResourcePtr->emptyQueue->lockFree) {
+        EbAtomicStore32(&wrapperPtr->releaseEnable, EB_TRUE);
+    }
+    else {
+        EbBlockOnMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
 
-    wrapperPtr->releaseEnable = EB_TRUE;
+        wrapperPtr->releaseEnable = EB_TRUE;
 
-    EbReleaseMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+        EbReleaseMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+    }
 
     return return_error;
 }
@@ -382,11 +667,16 @@ EB_ERRORTYPE EbObjectReleaseDisable(
 {
     EB_ERRORTYPE return_error = EB_ErrorNone;
 
-    EbBlockOnMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+    if (wrapperPtr->systemResourcePtr->emptyQueue->lockFree) {
+        EbAtomicStore32(&wrapperPtr->releaseEnable, EB_FALSE);
+    }
+    else {
+        EbBlockOnMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
 
-    wrapperPtr->releaseEnable = EB_FALSE;
+        wrapperPtr->releaseEnable = EB_FALSE;
 
-    EbReleaseMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+        EbReleaseMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+    }
 
     return return_error;
 }
@@ -411,11 +701,16 @@ EB_ERRORTYPE EbObjectIncLiveCount(
 {
     EB_ERRORTYPE return_error = EB_ErrorNone;
 
-    EbBlockOnMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+    if (wrapperPtr->systemResourcePtr->emptyQueue->lockFree) {
+        EbAtomicFetchAdd32(&wrapperPtr->liveCount, incrementNumber);
+    }
+    else {
+        EbBlockOnMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
 
-    wrapperPtr->liveCount += incrementNumber;
+        wrapperPtr->liveCount += incrementNumber;
 
-    EbReleaseMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+        EbReleaseMutex(wrapperPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+    }
 
     return return_error;
 }
@@ -501,9 +796,16 @@ EB_ERRORTYPE EbSystemResourceCtor(
     }
     // Fill the Empty Fifo with every ObjectWrapper
     for (wrapperIndex=0; wrapperIndex < resourcePtr->objectTotalCount; ++wrapperIndex) {
-        EbMuxingQueueObjectPushBack(
-            resourcePtr->emptyQueue,
-            resourcePtr->wrapperPtrPool[wrapperIndex]);
+        if (resourcePtr->emptyQueue->lockFree) {
+            EbMuxingQueuePost(
+                resourcePtr->emptyQueue,
+                resourcePtr->wrapperPtrPool[wrapperIndex]);
+        }
+        else {
+            EbMuxingQueueObjectPushBack(
+                resourcePtr->emptyQueue,
+                resourcePtr->wrapperPtrPool[wrapperIndex]);
+        }
     }
 
     // Initialize the Full Queue
@@ -566,13 +868,20 @@ EB_ERRORTYPE EbPostFullObject(
 {
     EB_ERRORTYPE return_error = EB_ErrorNone;
 
-    EbBlockOnMutex(objectPtr->systemResourcePtr->fullQueue->lockoutMutex);
+    if (objectPtr->systemResourcePtr->fullQueue->lockFree) {
+        EbMuxingQueuePost(
+            objectPtr->systemResourcePtr->fullQueue,
+            objectPtr);
+    }
+    else {
+        EbBlockOnMutex(objectPtr->systemResourcePtr->fullQueue->lockoutMutex);
 
-    EbMuxingQueueObjectPushBack(
-        objectPtr->systemResourcePtr->fullQueue,
-        objectPtr);
+        EbMuxingQueueObjectPushBack(
+            objectPtr->systemResourcePtr->fullQueue,
+            objectPtr);
 
-    EbReleaseMutex(objectPtr->systemResourcePtr->fullQueue->lockoutMutex);
+        EbReleaseMutex(objectPtr->systemResourcePtr->fullQueue->lockoutMutex);
+    }
 
     return return_error;
 }
@@ -591,24 +900,45 @@ EB_ERRORTYPE EbReleaseObject(
     EbObjectWrapper_t   *objectPtr)
 {
     EB_ERRORTYPE return_error = EB_ErrorNone;
+    EB_U32       liveCount;
 
-    EbBlockOnMutex(objectPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+    if (objectPtr->systemResourcePtr->emptyQueue->lockFree) {
+        liveCount = EbAtomicLoad32(&objectPtr->liveCount);
 
-    // Decrement liveCount
-    objectPtr->liveCount = (objectPtr->liveCount == 0) ? objectPtr->liveCount : objectPtr->liveCount - 1;
+        // Decrement liveCount
+        while (liveCount != 0 && !EbAtomicCompareExchange32(&objectPtr->liveCount, liveCount, liveCount - 1)) {
+            liveCount = EbAtomicLoad32(&objectPtr->liveCount);
+        }
 
-    if((objectPtr->releaseEnable == EB_TRUE) && (objectPtr->liveCount == 0)) {
+        // Only the release that takes liveCount from 0 to
+        // EB_ObjectWrapperReleasedValue returns the object to the empty queue
+        if ((EbAtomicLoad32(&objectPtr->releaseEnable) == EB_TRUE) && (liveCount <= 1) &&
+            EbAtomicCompareExchange32(&objectPtr->liveCount, 0, EB_ObjectWrapperReleasedValue)) {
 
-        // Set liveCount to EB_ObjectWrapperReleasedValue
-        objectPtr->liveCount = EB_ObjectWrapperReleasedValue;
+            EbMuxingQueuePost(
+                objectPtr->systemResourcePtr->emptyQueue,
+                objectPtr);
+        }
+    }
+    else {
+        EbBlockOnMutex(objectPtr->systemResourcePtr->emptyQueue->lockoutMutex);
 
-		EbMuxingQueueObjectPushFront(
-			objectPtr->systemResourcePtr->emptyQueue,
-			objectPtr);
+        // Decrement liveCount
+        objectPtr->liveCount = (objectPtr->liveCount == 0) ? objectPtr->liveCount : objectPtr->liveCount - 1;
 
-    }
+        if((objectPtr->releaseEnable == EB_TRUE) && (objectPtr->liveCount == 0)) {
+
+            // Set liveCount to EB_ObjectWrapperReleasedValue
+            objectPtr->liveCount = EB_ObjectWrapperReleasedValue;
+
+            EbMuxingQueueObjectPushFront(
+                objectPtr->systemResourcePtr->emptyQueue,
+                objectPtr);
 
-    EbReleaseMutex(objectPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+        }
+
+        EbReleaseMutex(objectPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+    }
 
     return return_error;
 }
@@ -634,28 +964,45 @@ EB_ERRORTYPE EbGetEmptyObject(
 {
     EB_ERRORTYPE return_error = EB_ErrorNone;
 
-    // Queue the Fifo requesting the empty fifo
-    EbReleaseProcess(emptyFifoPtr);
+    // Waiting for the next stage to free an object is backpressure on the task
+    EbSuspendTask();
 
-    // Block on the counting Semaphore until an empty buffer is available
-    EbBlockOnSemaphore(emptyFifoPtr->countingSemaphore);
+    if (emptyFifoPtr->queuePtr->lockFree) {
+        *wrapperDblPtr = EbMuxingQueueGet(emptyFifoPtr->queuePtr);
 
-    // Acquire lockout Mutex
-    EbBlockOnMutex(emptyFifoPtr->lockoutMutex);
+        // Reset the wrapper's liveCount, other threads may still hold the
+        // wrapper of a previous use and release it concurrently
+        EbAtomicStore32(&(*wrapperDblPtr)->liveCount, 0);
 
-    // Get the empty object
-    EbFifoPopFront(
-        emptyFifoPtr,
-        wrapperDblPtr);
+        // Object release enable
+        EbAtomicStore32(&(*wrapperDblPtr)->releaseEnable, EB_TRUE);
+    }
+    else {
+        // Queue the Fifo requesting the empty fifo
+        EbReleaseProcess(emptyFifoPtr);
 
-    // Reset the wrapper's liveCount
-    (*wrapperDblPtr)->liveCount = 0;
+        // Block on the counting Semaphore until an empty buffer is available
+        EbBlockOnSemaphore(emptyFifoPtr->countingSemaphore);
 
-    // Object release enable
-    (*wrapperDblPtr)->releaseEnable = EB_TRUE;
+        // Acquire lockout Mutex
+        EbBlockOnMutex(emptyFifoPtr->lockoutMutex);
+
+        // Get the empty object
+        EbFifoPopFront(
+            emptyFifoPtr,
+            wrapperDblPtr);
 
-    // Release Mutex
-    EbReleaseMutex(emptyFifoPtr->lockoutMutex);
+        // Reset the wrapper's liveCount
+        (*wrapperDblPtr)->liveCount = 0;
+
+        // Object release enable
+        (*wrapperDblPtr)->releaseEnable = EB_TRUE;
+
+        // Release Mutex
+        EbReleaseMutex(emptyFifoPtr->lockoutMutex);
+    }
+
+    EbResumeTask();
 
     return return_error;
 }
@@ -680,22 +1027,48 @@ EB_ERRORTYPE EbGetFullObject(
     EbObjectWrapper_t **wrapperDblPtr)
 {
     EB_ERRORTYPE return_error = EB_ErrorNone;
+    EB_U64       waitStartTime = EbMonotonicTimeUs();
 
-    // Queue the process requesting the full fifo
-    EbReleaseProcess(fullFifoPtr);
+    // The previous task ends when the process comes back for the next one
+    if (fullFifoPtr->taskStartTime != 0) {
+        fullFifoPtr->busyTime       += waitStartTime - fullFifoPtr->taskStartTime - fullFifoPtr->taskStallTime;
+        fullFifoPtr->stallTime      += fullFifoPtr->taskStallTime;
+        fullFifoPtr->taskStallTime   = 0;
+    }
 
-    // Block on the counting Semaphore until an empty buffer is available
-    EbBlockOnSemaphore(fullFifoPtr->countingSemaphore);
+    // An idle process holds no slot: a process waiting for its input could
+    // otherwise keep the slot from the one that produces the input
+    if (taskFifoPtr != (EbFifo_t*)EB_NULL) {
+        EbMuxingQueueReleaseSlot(taskFifoPtr->queuePtr);
+        taskFifoPtr = (EbFifo_t*)EB_NULL;
+    }
 
-    // Acquire lockout Mutex
-    EbBlockOnMutex(fullFifoPtr->lockoutMutex);
+    if (fullFifoPtr->queuePtr->lockFree) {
+        *wrapperDblPtr = EbMuxingQueueGet(fullFifoPtr->queuePtr);
+    }
+    else {
+        // Queue the process requesting the full fifo
+        EbReleaseProcess(fullFifoPtr);
 
-    EbFifoPopFront(
-        fullFifoPtr,
-        wrapperDblPtr);
+        // Block on the counting Semaphore until an empty buffer is available
+        EbBlockOnSemaphore(fullFifoPtr->countingSemaphore);
 
-    // Release Mutex
-    EbReleaseMutex(fullFifoPtr->lockoutMutex);
+        // Acquire lockout Mutex
+        EbBlockOnMutex(fullFifoPtr->lockoutMutex);
+
+        EbFifoPopFront(
+            fullFifoPtr,
+            wrapperDblPtr);
+
+        // Release Mutex
+        EbReleaseMutex(fullFifoPtr->lockoutMutex);
+    }
+
+    EbMuxingQueueAcquireSlot(fullFifoPtr->queuePtr);
+
+    fullFifoPtr->taskStartTime = EbMonotonicTimeUs();
+    fullFifoPtr->taskCount++;
+    taskFifoPtr = fullFifoPtr;
 
     return return_error;
 }
@@ -721,24 +1094,109 @@ EB_ERRORTYPE EbGetFullObjectNonBlocking(
 {
     EB_ERRORTYPE return_error = EB_ErrorNone;
     EB_BOOL      fifoEmpty;
-    // Queue the Fifo requesting the full fifo
-    EbReleaseProcess(fullFifoPtr);
 
-    // Acquire lockout Mutex
-    EbBlockOnMutex(fullFifoPtr->lockoutMutex);
+    if (fullFifoPtr->queuePtr->lockFree) {
+        if (EbMuxingQueueTryClaim(fullFifoPtr->queuePtr) == EB_TRUE) {
+            while (EbRingBufferPop(fullFifoPtr->queuePtr->objectRing, (EB_PTR*)wrapperDblPtr) == EB_FALSE) {
+                EbCpuRelax();
+            }
+        }
+        else {
+            *wrapperDblPtr = (EbObjectWrapper_t*)EB_NULL;
+        }
+    }
+    else {
+        // Queue the Fifo requesting the full fifo
+        EbReleaseProcess(fullFifoPtr);
 
-    fifoEmpty = EbFifoPeakFront(
-                        fullFifoPtr);
+        // Acquire lockout Mutex
+        EbBlockOnMutex(fullFifoPtr->lockoutMutex);
 
-    // Release Mutex
-    EbReleaseMutex(fullFifoPtr->lockoutMutex);
+        fifoEmpty = EbFifoPeakFront(
+                            fullFifoPtr);
 
-    if (fifoEmpty == EB_FALSE)
-        EbGetFullObject(
-            fullFifoPtr,
-            wrapperDblPtr);
-    else
-        *wrapperDblPtr = (EbObjectWrapper_t*)EB_NULL;
+        // Release Mutex
+        EbReleaseMutex(fullFifoPtr->lockoutMutex);
+
+        if (fifoEmpty == EB_FALSE)
+            EbGetFullObject(
+                fullFifoPtr,
+                wrapperDblPtr);
+        else
+            *wrapperDblPtr = (EbObjectWrapper_t*)EB_NULL;
+    }
 
     return return_error;
-}
\ No newline at end of file
+}
+
+/*********************************************************************
+ * EbGetFullObjectCount
+ *********************************************************************/
+EB_U32 EbGetFullObjectCount(
+    EbSystemResource_t  *resourcePtr)
+{
+    EB_S32 availableCount;
+
+    if (resourcePtr->fullQueue->lockFree) {
+        // Parked consumers take availableCount below zero
+        availableCount = EbAtomicLoad32(&resourcePtr->fullQueue->availableCount);
+
+        return (availableCount > 0) ? (EB_U32)availableCount : 0;
+    }
+
+    return resourcePtr->fullQueue->objectQueue->currentCount;
+}
+
+/*********************************************************************
+ * EbSetLockFreeFifo
+ *********************************************************************/
+void EbSetLockFreeFifo(
+    EB_BOOL              lockFree)
+{
+    lockFreeFifo = lockFree;
+}
+
+/*********************************************************************
+ * EbSetFullObjectConcurrency
+ *********************************************************************/
+void EbSetFullObjectConcurrency(
+    EbSystemResource_t  *resourcePtr,
+    EB_U32               activeLimit)
+{
+    EbMuxingQueue_t *queuePtr = resourcePtr->fullQueue;
+    EB_U32           previousLimit = EbAtomicLoad32(&queuePtr->activeLimit);
+
+    activeLimit = (activeLimit == 0) ? 1 : (activeLimit > queuePtr->processTotalCount) ? queuePtr->processTotalCount : activeLimit;
+    EbAtomicStore32(&queuePtr->activeLimit, activeLimit);
+
+    // Parked consumers retry for the new slots
+    if (activeLimit > previousLimit) {
+        EbMuxingQueueWakeParked(queuePtr, queuePtr->processTotalCount);
+    }
+}
+
+/*********************************************************************
+ * EbSuspendTask
+ *********************************************************************/
+void EbSuspendTask(void)
+{
+    if (taskFifoPtr == (EbFifo_t*)EB_NULL) {
+        return;
+    }
+
+    taskSuspendTime = EbMonotonicTimeUs();
+    EbMuxingQueueReleaseSlot(taskFifoPtr->queuePtr);
+}
+
+/*********************************************************************
+ * EbResumeTask
+ *********************************************************************/
+void EbResumeTask(void)
+{
+    if (taskFifoPtr == (EbFifo_t*)EB_NULL) {
+        return;
+    }
+
+    EbMuxingQueueAcquireSlot(taskFifoPtr->queuePtr);
+    taskFifoPtr->taskStallTime += EbMonotonicTimeUs() - taskSuspendTime;
+}
@@ -16,6 +16,8 @@ extern "C" {
  * Defines
  *********************************/
 #define EB_ObjectWrapperReleasedValue   ~0u
+#define EB_FIFO_CACHE_LINE_SIZE         64
+#define EB_FIFO_SPIN_COUNT              1024    // ring polls before a consumer parks
 
 /*********************************************************************
  * Object Wrapper
@@ -34,8 +36,9 @@ typedef struct EbObjectWrapper_s {
 
     // releaseEnable - a flag that enables the release of
     //   EbObjectWrapper for reuse in the encoding of subsequent
-    //   pictures in the encoder pipeline.
-    EB_BOOL                   releaseEnable;
+    //   pictures in the encoder pipeline.  32 bits wide so the
+    //   lock free fifos can access it with the 32 bit atomics.
+    EB_U32                    releaseEnable;
 
     // systemResourcePtr - a pointer to the SystemResourceManager
     //   that the object belongs to.
@@ -75,6 +78,18 @@ typedef struct EbFifo_s {
     //   associated with.
     struct EbMuxingQueue_s *queuePtr;
 
+    // taskCount, busyTime, stallTime - number of full objects taken by
+    //   the process and the microseconds it spent on them, from the
+    //   return of EbGetFullObject to its next call.  The time blocked in
+    //   EbGetEmptyObject meanwhile is stallTime rather than busyTime.
+    //   Only the process that owns the EbFifo writes them, readers get
+    //   a snapshot.
+    EB_U64 taskCount;
+    EB_U64 busyTime;
+    EB_U64 stallTime;
+    EB_U64 taskStartTime;
+    EB_U64 taskStallTime;
+
 } EbFifo_t;
 
 /*********************************************************************
@@ -89,8 +104,39 @@ typedef struct EbCircularBuffer_s {
 
 } EbCircularBuffer_t;
 
+/*********************************************************************
+ * RingBuffer
+ *   Bounded multi-producer/multi-consumer ring of object pointers.
+ *   Each cell carries a sequence number that tells producers and
+ *   consumers whether the cell is free or published for the current
+ *   lap, so pushes and pops only contend on a single atomic index.
+ *   The indices are kept on separate cache lines.
+ *********************************************************************/
+typedef struct EbRingBufferCell_s {
+    EB_U32  sequence;
+    EB_PTR  objectPtr;
+
+} EbRingBufferCell_t;
+
+typedef struct EbRingBuffer_s {
+    EbRingBufferCell_t *cellArray;
+    EB_U32              cellMask;
+    EB_U8               pad0[EB_FIFO_CACHE_LINE_SIZE];
+    EB_U32              enqueueIndex;
+    EB_U8               pad1[EB_FIFO_CACHE_LINE_SIZE];
+    EB_U32              dequeueIndex;
+    EB_U8               pad2[EB_FIFO_CACHE_LINE_SIZE];
+
+} EbRingBuffer_t;
+
 /*********************************************************************
  * MuxingQueue
+ *   With lockFree, all of the process fifos of a queue share
+ *   objectRing. availableCount is the number of objects in the ring
+ *   minus the number of consumers parked on waitSemaphore.  Consumers
+ *   spin on the ring first and only park once it stays empty.
+ *   Otherwise the lockoutMutex protects objectQueue and processQueue,
+ *   which hand the objects to the process fifos one at a time.
  *********************************************************************/
 typedef struct EbMuxingQueue_s {
     EB_HANDLE           lockoutMutex;
@@ -99,6 +145,20 @@ typedef struct EbMuxingQueue_s {
     EB_U32              processTotalCount;
     EbFifo_t          **processFifoPtrArray;
 
+    EB_BOOL             lockFree;
+    EbRingBuffer_t     *objectRing;
+    EB_HANDLE           waitSemaphore;
+    EB_S32              availableCount;
+
+    // activeLimit - at most activeLimit of the consumer processes hold
+    //   a slot of the queue, the others park on parkSemaphore.  A
+    //   process holds its slot while it runs a task, not while it waits
+    //   for one or while its task is suspended, see EbSuspendTask.
+    EB_U32              activeLimit;
+    EB_U32              activeCount;
+    EB_U32              parkedCount;
+    EB_HANDLE           parkMutex;
+    EB_HANDLE           parkSemaphore;
 } EbMuxingQueue_t;
 
 /*********************************************************************
@@ -327,6 +387,48 @@ extern EB_ERRORTYPE EbGetFullObjectNonBlocking(
  *********************************************************************/
 extern EB_ERRORTYPE EbReleaseObject(
     EbObjectWrapper_t   *objectPtr);
+
+/*********************************************************************
+ * EbGetFullObjectCount
+ *   Returns the number of full EbObjectWrappers waiting for a process
+ *   in the SystemResource.  The count is read without the lockout
+ *   mutex, it is a snapshot for monitoring only.
+ *
+ *   resourcePtr
+ *      Pointer to the SystemResource.
+ *********************************************************************/
+extern EB_U32 EbGetFullObjectCount(
+    EbSystemResource_t  *resourcePtr);
+
+/*********************************************************************
+ * EbSetLockFreeFifo
+ *   Selects the fifos of the SystemResources that the calling thread
+ *   constructs next: the lock-free ring buffers or the mutex protected
+ *   queues.  The default is the LOCK_FREE_FIFO build option.
+ *********************************************************************/
+extern void EbSetLockFreeFifo(
+    EB_BOOL              lockFree);
+
+/*********************************************************************
+ * EbSetFullObjectConcurrency
+ *   Caps the number of consumer processes of the SystemResource that
+ *   run a task at the same time.  Processes above the cap park in
+ *   EbGetFullObject with their task; lowering the cap takes effect as
+ *   running tasks end.
+ *********************************************************************/
+extern void EbSetFullObjectConcurrency(
+    EbSystemResource_t  *resourcePtr,
+    EB_U32               activeLimit);
+
+/*********************************************************************
+ * EbSuspendTask / EbResumeTask
+ *   Bracket a wait of the calling process on another task.  The
+ *   process gives up its concurrency slot meanwhile, so that the task
+ *   it waits on can run, and the wait counts as stall time.
+ *********************************************************************/
+extern void EbSuspendTask(void);
+
+extern void EbResumeTask(void);
 #ifdef __cplusplus
 }
 #endif
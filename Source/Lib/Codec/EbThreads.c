@@ -29,6 +29,14 @@
 #include <stdio.h>
 #include <unistd.h>
 #endif // _WIN32
+#if defined(__linux__)
+#include <sys/syscall.h>
+
+// mbind policy and flag, from linux/mempolicy.h
+#define EB_MPOL_PREFERRED       1
+#define EB_MPOL_MF_MOVE         (1 << 1)
+#define EB_NUMA_NODE_SCAN_COUNT 64
+#endif
 #if PRINTF_TIME
 #ifdef _WIN32
 #include <time.h>
@@ -42,6 +50,44 @@ void printfTime(const char *fmt, ...)
 }
 #endif
 #endif
+/****************************************
+ * Per-thread encoder instance binding
+ ****************************************/
+EB_HIDDEN EB_THREAD_LOCAL EB_U32        ASM_TYPES;
+EB_HIDDEN EB_THREAD_LOCAL EbMemoryContext_t *memoryContextPtr;
+
+typedef struct EbThreadStart_s {
+    void                 *(*threadFunction)(void *);
+    void                   *threadContext;
+    EB_U32                  asmTypes;
+    EbMemoryContext_t      *memoryContextPtr;
+} EbThreadStart_t;
+
+/****************************************
+ * EbThreadTrampoline
+ *   Binds the new thread to the encoder
+ *   instance of the thread that created it
+ ****************************************/
+#ifdef _WIN32
+static DWORD WINAPI EbThreadTrampoline(LPVOID startPtr)
+#else
+static void* EbThreadTrampoline(void *startPtr)
+#endif
+{
+    EbThreadStart_t start = *(EbThreadStart_t*)startPtr;
+    free(startPtr);
+
+    ASM_TYPES           = start.asmTypes;
+    memoryContextPtr    = start.memoryContextPtr;
+
+#ifdef _WIN32
+    start.threadFunction(start.threadContext);
+    return 0;
+#else
+    return start.threadFunction(start.threadContext);
+#endif
+}
+
 /****************************************
  * EbCreateThread
  ****************************************/
@@ -50,16 +96,29 @@ EB_HANDLE EbCreateThread(
     void *threadContext)
 {
     EB_HANDLE threadHandle = NULL;
+    EbThreadStart_t *startPtr = (EbThreadStart_t*) malloc(sizeof(EbThreadStart_t));
+
+    if (startPtr == NULL) {
+        return NULL;
+    }
+    startPtr->threadFunction    = threadFunction;
+    startPtr->threadContext     = threadContext;
+    startPtr->asmTypes          = ASM_TYPES;
+    startPtr->memoryContextPtr  = memoryContextPtr;
 
 #ifdef _WIN32
     threadHandle = (EB_HANDLE) CreateThread(
                        NULL,                           // default security attributes
                        0,                              // default stack size
-                       (LPTHREAD_START_ROUTINE) threadFunction, // function to be tied to the new thread
-                       threadContext,                  // context to be tied to the new thread
+                       EbThreadTrampoline,             // function to be tied to the new thread
+                       startPtr,                       // context to be tied to the new thread
                        0,                              // thread active when created
                        NULL);                          // new thread ID
+    if (threadHandle == NULL) {
+        free(startPtr);
+    }
 #else
+    int ret = 0;
     pthread_attr_t attr;
     struct sched_param param = {
         .sched_priority = 99
@@ -72,11 +131,11 @@ EB_HANDLE EbCreateThread(
 
     threadHandle = (pthread_t*) malloc(sizeof(pthread_t));
     if (threadHandle != NULL) {
-        int ret = pthread_create(
+        ret = pthread_create(
             (pthread_t*)threadHandle,      // Thread handle
             &attr,                       // attributes
-            threadFunction,                 // function to be run by new thread
-            threadContext);
+            EbThreadTrampoline,             // function to be run by new thread
+            startPtr);
 
         if (ret != 0) {
             if (ret == EPERM) {
@@ -86,15 +145,19 @@ EB_HANDLE EbCreateThread(
 
                 threadHandle = (pthread_t*)malloc(sizeof(pthread_t));
                 if (threadHandle != NULL) {
-                    pthread_create(
+                    ret = pthread_create(
                         (pthread_t*)threadHandle,      // Thread handle
                         (const pthread_attr_t*)EB_NULL,                        // attributes
-                        threadFunction,                 // function to be run by new thread
-                        threadContext);
+                        EbThreadTrampoline,             // function to be run by new thread
+                        startPtr);
                 }
             }
         }
     }
+    // The start record is owned by the new thread once it has been created
+    if (threadHandle == NULL || ret != 0) {
+        free(startPtr);
+    }
     pthread_attr_destroy(&attr);
 #endif // _WIN32
 
@@ -317,3 +380,112 @@ EB_ERRORTYPE EbDestroyMutex(
 
     return return_error;
 }
+
+/***************************************
+ * EbMonotonicTimeUs
+ *   Microseconds of a clock that never goes back,
+ *   from an arbitrary origin
+ ***************************************/
+EB_U64 EbMonotonicTimeUs(
+    void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return (EB_U64)(counter.QuadPart / frequency.QuadPart) * 1000000 + (EB_U64)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (EB_U64)now.tv_sec * 1000000 + (EB_U64)now.tv_nsec / 1000;
+#endif // _WIN32
+}
+
+/***************************************
+ * EbNumaGetNodeOfCpu
+ *   NUMA node of a logical processor, 0 when the
+ *   system does not expose it
+ ***************************************/
+EB_U32 EbNumaGetNodeOfCpu(
+    EB_U32 cpu)
+{
+#if defined(__linux__)
+    char   path[64];
+    EB_U32 node;
+
+    for (node = 0; node < EB_NUMA_NODE_SCAN_COUNT; ++node) {
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/node%u", cpu, node);
+        if (access(path, F_OK) == 0) {
+            return node;
+        }
+    }
+#else
+    (void)cpu;
+#endif
+    return 0;
+}
+
+/***************************************
+ * EbNumaBindMemory
+ *   Asks the kernel to place the pages of [ptr, ptr + size)
+ *   on the node of partition, moving those already touched.
+ *   Partial pages at either end are left alone.
+ ***************************************/
+void EbNumaBindMemory(
+    EbNumaTopology_t *topologyPtr,
+    void             *ptr,
+    EB_U64            size,
+    EB_U32            partition)
+{
+#if defined(__linux__)
+    size_t          pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t          start = ((size_t)ptr + pageSize - 1) & ~(pageSize - 1);
+    size_t          end = ((size_t)ptr + (size_t)size) & ~(pageSize - 1);
+    unsigned long   nodeMask;
+
+    if (end <= start || topologyPtr->nodeId[partition] >= sizeof(nodeMask) * 8) {
+        return;
+    }
+    nodeMask = 1UL << topologyPtr->nodeId[partition];
+
+    // The kernel drops the last bit of maxnode
+    if (syscall(SYS_mbind, start, end - start, EB_MPOL_PREFERRED, &nodeMask, sizeof(nodeMask) * 8 + 1, EB_MPOL_MF_MOVE) == 0) {
+        topologyPtr->placedBytes[partition] += end - start;
+    }
+#else
+    (void)topologyPtr;
+    (void)ptr;
+    (void)size;
+    (void)partition;
+#endif
+}
+
+/***************************************
+ * EbNumaEnterPartition
+ *   Moves the calling thread onto the processors of
+ *   partition before it works on rows of that partition.
+ *   The thread stays where it is, without a system call,
+ *   while its segments keep to the same partition
+ ***************************************/
+void EbNumaEnterPartition(
+    EbNumaTopology_t    *topologyPtr,
+    EbNumaThreadState_t *statePtr,
+    EB_U32               partition)
+{
+#if defined(__linux__)
+    if (statePtr->partition != partition) {
+        statePtr->remote = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &topologyPtr->nodeAffinity[partition]) != 0;
+        statePtr->partition = partition;
+        statePtr->migrationCount[partition] += !statePtr->remote;
+    }
+    statePtr->remoteSegmentCount[partition] += statePtr->remote;
+#else
+    (void)topologyPtr;
+#endif
+    statePtr->segmentCount[partition]++;
+}
@@ -54,92 +54,174 @@ extern EB_ERRORTYPE EbBlockOnMutexTimeout(
     EB_U32 timeout);
 extern EB_ERRORTYPE EbDestroyMutex(
     EB_HANDLE mutexHandle);
+/**************************************
+ * Clock
+ **************************************/
+extern EB_U64 EbMonotonicTimeUs(
+    void);
+
+// Sequentially consistent 32-bit atomics and a spin-wait hint, used by
+// the lock-free fifos of the system resource manager.
+#ifdef _WIN32
+#define EbAtomicLoad32(ptr)                                 InterlockedCompareExchange((volatile LONG*)(ptr), 0, 0)
+#define EbAtomicStore32(ptr, value)                         (void)InterlockedExchange((volatile LONG*)(ptr), (LONG)(value))
+#define EbAtomicFetchAdd32(ptr, value)                      InterlockedExchangeAdd((volatile LONG*)(ptr), (LONG)(value))
+#define EbAtomicCompareExchange32(ptr, expected, desired)   (InterlockedCompareExchange((volatile LONG*)(ptr), (LONG)(desired), (LONG)(expected)) == (LONG)(expected))
+#define EbCpuRelax()                                        YieldProcessor()
+#else
+#define EbAtomicLoad32(ptr)                                 __atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+#define EbAtomicStore32(ptr, value)                         __atomic_store_n((ptr), (value), __ATOMIC_SEQ_CST)
+#define EbAtomicFetchAdd32(ptr, value)                      __atomic_fetch_add((ptr), (value), __ATOMIC_SEQ_CST)
+#define EbAtomicCompareExchange32(ptr, expected, desired)   __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#define EbCpuRelax()                                        __builtin_ia32_pause()
+#endif
+
+#if defined(__linux__)
+#ifndef __cplusplus
+#define __USE_GNU
+#define _GNU_SOURCE
+#endif
+#include <sched.h>
+#include <pthread.h>
+typedef struct logicalProcessorGroup {
+    uint32_t num;
+    uint32_t group[1024];
+}processorGroup;
+#define INITIAL_PROCESSOR_GROUP 16
+#endif
+
+/**************************************
+ * EbThreadAffinity_t
+ *   Processor topology and the affinity applied to the threads of one
+ *   encoder instance.
+ **************************************/
+typedef struct EbThreadAffinity_s {
+    EB_U8                       numGroups;
+#ifdef _WIN32
+    GROUP_AFFINITY              groupAffinity;
+    EB_BOOL                     alternateGroups;
+#elif defined(__linux__)
+    cpu_set_t                   groupAffinity;
+    processorGroup             *lpGroup;
+#endif
+} EbThreadAffinity_t;
+
+/**************************************
+ * NUMA
+ *   The LCU rows of every picture are split in nodeCount bands, band p
+ *   lives on node nodeId[p] and is processed by threads moved onto the
+ *   processors of that node. nodeCount is 0 when the instance is not
+ *   partitioned.
+ **************************************/
+#define EB_NUMA_MAX_NODES       8
+#define EB_NUMA_NO_PARTITION    (~0u)
+
+typedef struct EbNumaTopology_s {
+    EB_U32                      nodeCount;
+    EB_U32                      nodeId[EB_NUMA_MAX_NODES];
+    EB_U64                      placedBytes[EB_NUMA_MAX_NODES];
+#if defined(__linux__)
+    cpu_set_t                   nodeAffinity[EB_NUMA_MAX_NODES];
+#endif
+} EbNumaTopology_t;
 
-extern    EbMemoryMapEntry        *memoryMap;               // library Memory table
-extern    EB_U32                  *memoryMapIndex;          // library memory index
-extern    EB_U64                  *totalLibMemory;          // library Memory malloc'd
+// Partition the thread runs on and the segments it processed per partition,
+// remoteSegmentCount are those it could not be moved onto the node for and
+// migrationCount the times it moved onto the node
+typedef struct EbNumaThreadState_s {
+    EB_U32                      partition;
+    EB_BOOL                     remote;
+    EB_U64                      segmentCount[EB_NUMA_MAX_NODES];
+    EB_U64                      remoteSegmentCount[EB_NUMA_MAX_NODES];
+    EB_U64                      migrationCount[EB_NUMA_MAX_NODES];
+} EbNumaThreadState_t;
+
+#define EbNumaRowPartition(topologyPtr, row, rowCount) ((EB_U32)((row) * (topologyPtr)->nodeCount / (rowCount)))
+
+extern EB_U32 EbNumaGetNodeOfCpu(
+    EB_U32 cpu);
+extern void EbNumaBindMemory(
+    EbNumaTopology_t *topologyPtr,
+    void             *ptr,
+    EB_U64            size,
+    EB_U32            partition);
+extern void EbNumaEnterPartition(
+    EbNumaTopology_t    *topologyPtr,
+    EbNumaThreadState_t *statePtr,
+    EB_U32               partition);
 
 #ifdef _WIN32
-extern    GROUP_AFFINITY           groupAffinity;
-extern    EB_U8                    numGroups;
-extern    EB_BOOL                  alternateGroups;
-#define EB_CREATETHREAD(type, pointer, nElements, pointerClass, threadFunction, threadContext) \
+#define EB_CREATETHREAD(type, pointer, nElements, pointerClass, threadFunction, threadContext, affinityPtr) \
     pointer = EbCreateThread(threadFunction, threadContext); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
     else { \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = pointerClass; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = pointer; \
         if (nElements % 8 == 0) { \
-            *totalLibMemory += (nElements); \
+            memoryContextPtr->totalLibMemory += (nElements); \
         } \
         else { \
-            *totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
+            memoryContextPtr->totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
         } \
-        if(numGroups == 1) {\
-            SetThreadAffinityMask(pointer, groupAffinity.Mask);\
+        if((affinityPtr)->numGroups == 1) {\
+            SetThreadAffinityMask(pointer, (affinityPtr)->groupAffinity.Mask);\
         }\
-        else if (numGroups == 2 && alternateGroups){ \
-            groupAffinity.Group = 1 - groupAffinity.Group; \
-            SetThreadGroupAffinity(pointer,&groupAffinity,NULL); \
+        else if ((affinityPtr)->numGroups == 2 && (affinityPtr)->alternateGroups){ \
+            (affinityPtr)->groupAffinity.Group = 1 - (affinityPtr)->groupAffinity.Group; \
+            SetThreadGroupAffinity(pointer,&(affinityPtr)->groupAffinity,NULL); \
         } \
-        else if (numGroups == 2 && !alternateGroups){ \
-            SetThreadGroupAffinity(pointer,&groupAffinity,NULL); \
+        else if ((affinityPtr)->numGroups == 2 && !(affinityPtr)->alternateGroups){ \
+            SetThreadGroupAffinity(pointer,&(affinityPtr)->groupAffinity,NULL); \
         } \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) { \
         return EB_ErrorInsufficientResources; \
     } \
-    libThreadCount++;
+    memoryContextPtr->libThreadCount++;
 #elif defined(__linux__)
-#ifndef __cplusplus
-#define __USE_GNU
-#define _GNU_SOURCE
-#endif
-#include <sched.h>
-#include <pthread.h>
-extern    cpu_set_t                   groupAffinity;
-#define EB_CREATETHREAD(type, pointer, nElements, pointerClass, threadFunction, threadContext) \
+#define EB_CREATETHREAD(type, pointer, nElements, pointerClass, threadFunction, threadContext, affinityPtr) \
     pointer = EbCreateThread(threadFunction, threadContext); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
     else { \
-        pthread_setaffinity_np(*((pthread_t*)pointer),sizeof(cpu_set_t),&groupAffinity); \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
+        pthread_setaffinity_np(*((pthread_t*)pointer),sizeof(cpu_set_t),&(affinityPtr)->groupAffinity); \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = pointerClass; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = pointer; \
 		if (nElements % 8 == 0) { \
-			*totalLibMemory += (nElements); \
+			memoryContextPtr->totalLibMemory += (nElements); \
 		} \
 		else { \
-			*totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
+			memoryContextPtr->totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
 		} \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) { \
         return EB_ErrorInsufficientResources; \
     } \
-    libThreadCount++;
+    memoryContextPtr->libThreadCount++;
 #else
-#define EB_CREATETHREAD(type, pointer, nElements, pointerClass, threadFunction, threadContext) \
+#define EB_CREATETHREAD(type, pointer, nElements, pointerClass, threadFunction, threadContext, affinityPtr) \
     pointer = EbCreateThread(threadFunction, threadContext); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
     else { \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
+        (void)(affinityPtr); \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex].ptrType = pointerClass; \
+        memoryContextPtr->memoryMap[memoryContextPtr->memoryMapIndex++].ptr = pointer; \
 		if (nElements % 8 == 0) { \
-			*totalLibMemory += (nElements); \
+			memoryContextPtr->totalLibMemory += (nElements); \
 		} \
 		else { \
-			*totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
+			memoryContextPtr->totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
 		} \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (memoryContextPtr->memoryMapIndex >= MAX_NUM_PTR) { \
         return EB_ErrorInsufficientResources; \
     } \
-    libThreadCount++;
+    memoryContextPtr->libThreadCount++;
 #endif
 
 
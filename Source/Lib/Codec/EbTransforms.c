@@ -2547,7 +2547,7 @@ void PerformTwoStagePm(
 						EB_U64 sse[2];
                         EB_U64 coeffBits = 0;
 
-						FullDistortionIntrinsic_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)][pmCand->nzCoeff != 0][1][blkAreaSize >> 3](
+						FullDistortionIntrinsic_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][pmCand->nzCoeff != 0][1][blkAreaSize >> 3](
                             &coeff[blkOffset],
                             coeffStride,
                             pmCand->iqCoeff,
@@ -2887,7 +2887,7 @@ void DecoupledQuantizeInvQuantizeLoops(
 						EB_U64 sse[2];
 						EB_U64 coeffBits = 0;
 
-						FullDistortionIntrinsic_funcPtrArray[!!(ASM_TYPES & PREAVX2_MASK)][pmCand->nzCoeff != 0][1][blkAreaSize >> 3](
+						FullDistortionIntrinsic_funcPtrArray[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][pmCand->nzCoeff != 0][1][blkAreaSize >> 3](
 							&coeff[blkOffset],
 							coeffStride,
 							pmCand->iqCoeff,
@@ -3282,7 +3282,7 @@ EB_ERRORTYPE EstimateTransform(
     EB_U32 transformSizeFlag = Log2f(TRANSFORM_MAX_SIZE) - Log2f(transformSize);
 
     if (transCoeffShape == DEFAULT_SHAPE) {
-		(*transformFunctionTableEstimate[!!(ASM_TYPES & AVX2_MASK)][transformSizeFlag + dstTansformFlag])(
+		(*transformFunctionTableEstimate[AVX512_SLOT(!!(ASM_TYPES & AVX2_MASK))][transformSizeFlag + dstTansformFlag])(
             residualBuffer,
             residualStride,
             coeffBuffer,
@@ -3367,7 +3367,7 @@ EB_ERRORTYPE EncodeTransform(
                 );
         }
         else {
-            (*transformFunctionTableEncode1[/*ASM_TYPES*/((bitIncrement & BIT_INCREMENT_10BIT) ? EB_ASM_C : (!!(ASM_TYPES & PREAVX2_MASK)))][transformSizeFlag + dstTransformFlag])(
+            (*transformFunctionTableEncode1[/*ASM_TYPES*/((bitIncrement & BIT_INCREMENT_10BIT) ? EB_ASM_C : AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK)))][transformSizeFlag + dstTransformFlag])(
                 residualBuffer,
                 residualStride,
                 coeffBuffer,
@@ -3472,7 +3472,7 @@ EB_ERRORTYPE EstimateInvTransform(
     //   but in order to avoid extra copying, it is overwritten in place. The
     //   input(residualBuffer) is the LCU residual buffer
     if (partialFrequencyN2Flag == EB_FALSE) {
-		(*invTransformFunctionTableEstimate[!!(ASM_TYPES & PREAVX2_MASK)][transformSizeFlag + dstTransformFlag])(
+		(*invTransformFunctionTableEstimate[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][transformSizeFlag + dstTransformFlag])(
             coeffBuffer,
             coeffStride,
             reconBuffer,
@@ -3542,7 +3542,7 @@ EB_ERRORTYPE EncodeInvTransform(
         // The input of this function is the quantized_inversequantized transformed residual
         //   but in order to avoid extra copying, it is overwritten in place. The
         //   input(residualBuffer) is the LCU residual buffer
-		(*invTransformFunctionTableEncode[!!(ASM_TYPES & PREAVX2_MASK)][transformSizeFlag + dstTransformFlag])(
+		(*invTransformFunctionTableEncode[AVX512_SLOT(!!(ASM_TYPES & PREAVX2_MASK))][transformSizeFlag + dstTransformFlag])(
             coeffBuffer,
             coeffStride,
             reconBuffer,
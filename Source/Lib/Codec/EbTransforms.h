@@ -336,7 +336,7 @@ static EB_MAT_MUL_TYPE FUNC_TABLE MatMul_funcPtrArray[EB_ASM_TYPE_TOTAL][5] = {
 
 };
 
-static const EB_TRANSFORM_FUNC transformFunctionTableEstimate[EB_ASM_TYPE_TOTAL][5] = {
+static const EB_TRANSFORM_FUNC transformFunctionTableEstimate[EB_ASM_AVX512_TYPE_TOTAL][5] = {
         // C_DEFAULT
         {
 	    	Transform32x32Estimate,
@@ -353,6 +353,16 @@ static const EB_TRANSFORM_FUNC transformFunctionTableEstimate[EB_ASM_TYPE_TOTAL]
             Transform4x4_SSE2_INTRIN,
             DstTransform4x4_SSE2_INTRIN
         },
+#ifndef NON_AVX512_SUPPORT
+        // AVX512
+        {
+            lowPrecisionTransform32x32_AVX512_INTRIN,
+            lowPrecisionTransform16x16_AVX2_INTRIN,
+            Transform8x8_SSE4_1_INTRIN,
+            Transform4x4_SSE2_INTRIN,
+            DstTransform4x4_SSE2_INTRIN
+        },
+#endif
 };
 
 static const EB_TRANSFORM_FUNC PfreqN2TransformTable0[EB_ASM_TYPE_TOTAL][5] = {
@@ -452,7 +462,7 @@ static const EB_TRANSFORM_FUNC transformFunctionTableEncode0[EB_ASM_TYPE_TOTAL][
     },
 };
 
-static const EB_TRANSFORM_FUNC transformFunctionTableEncode1[EB_ASM_TYPE_TOTAL][5] = {
+static const EB_TRANSFORM_FUNC transformFunctionTableEncode1[EB_ASM_AVX512_TYPE_TOTAL][5] = {
     // NON_AVX2
     {
         Transform32x32_SSE2,
@@ -469,9 +479,19 @@ static const EB_TRANSFORM_FUNC transformFunctionTableEncode1[EB_ASM_TYPE_TOTAL][
         Transform4x4_SSE2_INTRIN,
         DstTransform4x4_SSE2_INTRIN
     },
+#ifndef NON_AVX512_SUPPORT
+    // AVX512, Transform32x32_SSE2 computes the same low precision transform
+    {
+        lowPrecisionTransform32x32_AVX512_INTRIN,
+        Transform16x16_SSE2,
+        Transform8x8_SSE4_1_INTRIN,
+        Transform4x4_SSE2_INTRIN,
+        DstTransform4x4_SSE2_INTRIN
+    },
+#endif
 };
 
-static const EB_INVTRANSFORM_FUNC invTransformFunctionTableEstimate[EB_ASM_TYPE_TOTAL][5] = {
+static const EB_INVTRANSFORM_FUNC invTransformFunctionTableEstimate[EB_ASM_AVX512_TYPE_TOTAL][5] = {
         // C_DEFAULT
         {
             InvTransform32x32,
@@ -488,9 +508,19 @@ static const EB_INVTRANSFORM_FUNC invTransformFunctionTableEstimate[EB_ASM_TYPE_
             InvTransform4x4_SSE2_INTRIN,
             InvDstTransform4x4_SSE2_INTRIN
         },
+#ifndef NON_AVX512_SUPPORT
+        // AVX512
+        {
+            InvTransform32x32_AVX512_INTRIN,
+            EstimateInvTransform16x16_SSE2,
+            InvTransform8x8_SSE2_INTRIN,
+            InvTransform4x4_SSE2_INTRIN,
+            InvDstTransform4x4_SSE2_INTRIN
+        },
+#endif
 };
 
-static const EB_INVTRANSFORM_FUNC invTransformFunctionTableEncode[EB_ASM_TYPE_TOTAL][5] = {
+static const EB_INVTRANSFORM_FUNC invTransformFunctionTableEncode[EB_ASM_AVX512_TYPE_TOTAL][5] = {
         // C_DEFAULT
         {
             InvTransform32x32,
@@ -507,6 +537,16 @@ static const EB_INVTRANSFORM_FUNC invTransformFunctionTableEncode[EB_ASM_TYPE_TO
             InvTransform4x4_SSE2_INTRIN,
             InvDstTransform4x4_SSE2_INTRIN
         },
+#ifndef NON_AVX512_SUPPORT
+        // AVX512
+        {
+            InvTransform32x32_AVX512_INTRIN,
+            PFinvTransform16x16_SSSE3,
+            InvTransform8x8_SSE2_INTRIN,
+            InvTransform4x4_SSE2_INTRIN,
+            InvDstTransform4x4_SSE2_INTRIN
+        },
+#endif
 };
 
 #ifdef __cplusplus